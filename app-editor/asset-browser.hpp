@@ -13,11 +13,16 @@
 #include "gl-texture-view.hpp"
 #include "win32.hpp"
 #include "asset-import.hpp"
+#include "asset-thumbnails.hpp"
 
 struct asset_browser_window final : public glfw_window
 {
     std::unique_ptr<gui::imgui_instance> auxImgui;
 
+    // Thumbs are rendered and displayed on this window's context (vertex array
+    // objects are not shared between contexts, texture objects are).
+    asset_thumbnail_cache thumbnails;
+
     asset_browser_window(gl_context * context,
         int w, int h,
         const std::string & title,
@@ -72,8 +77,45 @@ struct asset_browser_window final : public glfw_window
             glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+            thumbnails.update(); // disk-cache uploads + a budgeted number of preview renders
+
             auxImgui->begin_frame();
             gui::imgui_fixed_window_begin("asset-browser", { { 0, 0 },{ width, height } });
+
+            const int columns = std::max(1, width / 140);
+            int cell = 0;
+
+            if (ImGui::CollapsingHeader("Meshes", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                for (auto & handle : cpu_mesh_handle::list())
+                {
+                    if (!handle.assigned()) continue;
+                    if (cell++ % columns != 0) ImGui::SameLine();
+
+                    ImGui::BeginGroup();
+                    const GLuint thumb = thumbnails.get_mesh_thumbnail(handle.name);
+                    if (thumb) gui::Img(thumb, handle.name.c_str(), { 128, 128 });
+                    else ImGui::Button("loading...", { 128, 128 });
+                    ImGui::TextWrapped("%s", handle.name.c_str());
+                    ImGui::EndGroup();
+                }
+            }
+
+            cell = 0;
+            if (ImGui::CollapsingHeader("Textures", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                for (auto & handle : texture_handle::list())
+                {
+                    if (!handle.assigned()) continue;
+                    if (cell++ % columns != 0) ImGui::SameLine();
+
+                    ImGui::BeginGroup();
+                    gui::Img(handle.get(), handle.name.c_str(), { 128, 128 });
+                    ImGui::TextWrapped("%s", handle.name.c_str());
+                    ImGui::EndGroup();
+                }
+            }
+
             gui::imgui_fixed_window_end();
             auxImgui->end_frame();
 
@@ -0,0 +1,257 @@
+#pragma once
+
+#ifndef asset_thumbnails_hpp
+#define asset_thumbnails_hpp
+
+#include "asset-handle-utils.hpp"
+#include "gl-loaders.hpp"
+#include "gl-mesh-util.hpp"
+#include "gl-render-target-pool.hpp"
+#include "queue-mpsc-bounded.hpp"
+#include "thread-pool.hpp"
+#include "stb/stb_image_write.h"
+
+#if defined(POLYMER_PLATFORM_WINDOWS)
+    #include <direct.h>
+#else
+    #include <sys/stat.h>
+#endif
+
+#include <unordered_map>
+
+using namespace polymer;
+
+///////////////////////////////
+//   asset_thumbnail_cache   //
+///////////////////////////////
+
+// Async thumbnail previews for the asset browser. Disk-cache lookups (stb_image
+// decode of previously rendered thumbs) run on thread-pool workers and hand their
+// pixels back through a bounded queue, mirroring gl_asset_loader. Cache misses are
+// rendered on the asset browser window's own GL context - a budgeted count per
+// frame - because vertex array objects are not shared between contexts, so preview
+// meshes must be built and drawn on the context that displays them. Freshly
+// rendered thumbs are written back to disk (worker-side png encode) keyed by the
+// interned hash of the asset name, so subsequent editor launches hit the cache.
+class asset_thumbnail_cache
+{
+    static constexpr int32_t thumb_size = 128;
+
+    enum class thumb_state : uint32_t
+    {
+        pending_disk,   // worker is checking the disk cache
+        needs_render,   // cache miss - awaiting a budgeted render on the gl thread
+        ready,
+        failed
+    };
+
+    struct thumbnail
+    {
+        gl_texture_2d texture;
+        thumb_state state{ thumb_state::pending_disk };
+    };
+
+    struct decoded_thumb
+    {
+        std::string key;
+        std::vector<uint8_t> pixels; // rgb8, thumb_size^2 on a cache hit, empty on a miss
+        bool cache_hit{ false };
+    };
+
+    std::unordered_map<std::string, thumbnail> thumbnails;
+    mpsc_queue_bounded<std::shared_ptr<decoded_thumb>, 256> decoded_queue;
+
+    std::string cache_directory{ "../cache/thumbnails/" };
+    uint32_t render_budget_per_frame{ 2 };
+
+    // Offscreen state is created lazily so construction is legal before the
+    // browser's context exists. Color/depth attachments come from the target pool
+    // per frame (they only live for the duration of a preview render), so idle
+    // periods hold no preview VRAM and the pool can alias them elsewhere.
+    gl_framebuffer previewFramebuffer;
+    gl_render_target_pool targetPool; // bound to the browser context
+    std::unique_ptr<gl_shader> previewShader;
+    bool offscreenReady{ false };
+
+    std::string cache_path_for(const std::string & key) const
+    {
+        return cache_directory + std::to_string(asset_id(key).value) + ".png";
+    }
+
+    void ensure_cache_directory()
+    {
+        #if defined(POLYMER_PLATFORM_WINDOWS)
+            _mkdir("../cache");
+            _mkdir(cache_directory.c_str());
+        #else
+            mkdir("../cache", 0755);
+            mkdir(cache_directory.c_str(), 0755);
+        #endif
+    }
+
+    void ensure_offscreen_target()
+    {
+        if (offscreenReady) return;
+
+        constexpr const char preview_vert[] = R"(#version 330
+            layout(location = 0) in vec3 inPosition;
+            layout(location = 1) in vec3 inNormal;
+            uniform mat4 u_mvp;
+            out vec3 v_normal;
+            void main()
+            {
+                gl_Position = u_mvp * vec4(inPosition, 1);
+                v_normal = inNormal;
+            }
+        )";
+
+        constexpr const char preview_frag[] = R"(#version 330
+            in vec3 v_normal;
+            out vec4 f_color;
+            void main()
+            {
+                float ndotl = max(dot(normalize(v_normal), normalize(vec3(0.5, 0.8, 0.4))), 0.0) * 0.8 + 0.2;
+                f_color = vec4(vec3(0.45, 0.55, 0.65) * ndotl, 1);
+            }
+        )";
+
+        previewShader.reset(new gl_shader(preview_vert, preview_frag));
+        offscreenReady = true;
+    }
+
+    // Looks for a previously rendered thumb on disk from a worker thread.
+    void lookup_async(const std::string & key)
+    {
+        get_task_scheduler().submit([this, key]()
+        {
+            auto result = std::make_shared<decoded_thumb>();
+            result->key = key;
+
+            int width, height, nBytes;
+            stbi_uc * data = stbi_load(cache_path_for(key).c_str(), &width, &height, &nBytes, 3);
+            if (data && width == thumb_size && height == thumb_size)
+            {
+                result->cache_hit = true;
+                result->pixels.assign(data, data + (size_t(thumb_size) * size_t(thumb_size) * 3));
+            }
+            if (data) stbi_image_free(data);
+
+            while (!decoded_queue.emplace_back(result)) std::this_thread::yield();
+        });
+    }
+
+    // Renders a single mesh preview into the offscreen target, uploads the result
+    // as the thumb texture and queues a worker-side png encode into the disk cache.
+    bool render_mesh_preview(const std::string & key, thumbnail & thumb)
+    {
+        cpu_mesh_handle geomHandle(key);
+        if (!geomHandle.assigned()) return false; // cpu geometry may still be importing - retry next frame
+
+        ensure_offscreen_target();
+
+        const geometry & geom = geomHandle.get();
+        gl_mesh previewMesh = make_mesh_from_geometry(geom); // vao belongs to this (browser) context
+
+        const aabb_3d bounds = compute_bounds(geom);
+        const float3 center = bounds.center();
+        const float radius = std::max(length(bounds.size()) * 0.5f, 0.001f);
+        const float3 eye = center + normalize(float3(1.f, 0.75f, 1.f)) * (radius * 2.25f);
+
+        const float4x4 viewMatrix = lookat_rh(eye, center).view_matrix();
+        const float4x4 projMatrix = make_projection_matrix(to_radians(45.f), 1.f, radius * 0.05f, radius * 10.f);
+        const float4x4 mvp = mul(projMatrix, viewMatrix);
+
+        // Transient attachments: pooled across the renders in this frame and aliased
+        // (or eventually evicted) by the pool once previews go idle
+        gl_texture_2d & previewColor = targetPool.acquire_texture(thumb_size, thumb_size, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE);
+        gl_texture_2d & previewDepth = targetPool.acquire_texture(thumb_size, thumb_size, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT);
+        glNamedFramebufferTexture2DEXT(previewFramebuffer, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, previewColor, 0);
+        glNamedFramebufferTexture2DEXT(previewFramebuffer, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, previewDepth, 0);
+        previewFramebuffer.check_complete();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, previewFramebuffer);
+        glViewport(0, 0, thumb_size, thumb_size);
+        glEnable(GL_DEPTH_TEST);
+        glClearColor(0.11f, 0.11f, 0.12f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        previewShader->bind();
+        previewShader->uniform("u_mvp", mvp);
+        previewMesh.draw_elements();
+        previewShader->unbind();
+
+        auto pixels = std::make_shared<decoded_thumb>();
+        pixels->key = key;
+        pixels->pixels.resize(size_t(thumb_size) * size_t(thumb_size) * 3);
+        glReadPixels(0, 0, thumb_size, thumb_size, GL_RGB, GL_UNSIGNED_BYTE, pixels->pixels.data());
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        // Released immediately so the next preview this frame aliases the same targets
+        targetPool.release(previewColor);
+        targetPool.release(previewDepth);
+
+        flip_image_inplace(pixels->pixels.data(), thumb_size, thumb_size, 3);
+
+        thumb.texture.setup(thumb_size, thumb_size, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, pixels->pixels.data());
+        thumb.state = thumb_state::ready;
+
+        get_task_scheduler().submit([this, pixels]()
+        {
+            stbi_write_png(cache_path_for(pixels->key).c_str(), thumb_size, thumb_size, 3, pixels->pixels.data(), thumb_size * 3);
+        });
+
+        return true;
+    }
+
+    asset_thumbnail_cache(const asset_thumbnail_cache &) = delete;
+    asset_thumbnail_cache & operator = (const asset_thumbnail_cache &) = delete;
+
+public:
+
+    asset_thumbnail_cache() { ensure_cache_directory(); }
+
+    // Returns the thumb texture for a mesh asset, or 0 while it is pending. The
+    // first call for a given name kicks off the disk lookup.
+    GLuint get_mesh_thumbnail(const std::string & name)
+    {
+        auto itr = thumbnails.find(name);
+        if (itr == thumbnails.end())
+        {
+            thumbnails[name]; // inserts in pending_disk state
+            lookup_async(name);
+            return 0;
+        }
+        return (itr->second.state == thumb_state::ready) ? (GLuint) itr->second.texture : 0;
+    }
+
+    // Drains finished disk lookups and renders a budgeted number of cache misses.
+    // Must be called once per frame with the asset browser's context current.
+    void update()
+    {
+        targetPool.next_frame();
+
+        while (true)
+        {
+            auto decoded = decoded_queue.pop_front();
+            if (!decoded.first) break;
+
+            auto & thumb = thumbnails[decoded.second->key];
+            if (decoded.second->cache_hit)
+            {
+                thumb.texture.setup(thumb_size, thumb_size, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, decoded.second->pixels.data());
+                thumb.state = thumb_state::ready;
+            }
+            else thumb.state = thumb_state::needs_render;
+        }
+
+        uint32_t rendered = 0;
+        for (auto & entry : thumbnails)
+        {
+            if (rendered >= render_budget_per_frame) break;
+            if (entry.second.state != thumb_state::needs_render) continue;
+            if (render_mesh_preview(entry.first, entry.second)) ++rendered;
+        }
+    }
+};
+
+#endif // end asset_thumbnails_hpp
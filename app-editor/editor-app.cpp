@@ -44,18 +44,45 @@ scene_editor_app::scene_editor_app() : polymer_app(1920, 1080, "Polymer Editor")
 
     log::get()->replace_sink(std::make_shared<ImGui::spdlog_editor_sink>(log));
 
-    auto droidSansTTFBytes = read_file_binary("../assets/fonts/droid_sans.ttf");
+    auto boot_span = startup_profiler::get().phase("editor-boot");
 
-    igm.reset(new gui::imgui_instance(window));
-    gui::make_light_theme();
-    igm->add_font(droidSansTTFBytes);
+    // Kick the IBL cubemap decodes onto workers right away: the dds reads and
+    // gli decodes are pure CPU work that overlaps everything below, and only
+    // the GL upload at the join point needs this thread.
+    // @fixme - to be resolved rather than hard-coded
+    auto radianceDecode = spawn(get_task_scheduler(), []() -> gli::texture_cube
+    {
+        auto span = startup_profiler::get().phase("ibl-radiance-decode");
+        auto binary = read_file_binary("../assets/textures/envmaps/studio_radiance.dds");
+        return gli::texture_cube(gli::load_dds((char *)binary.data(), binary.size()));
+    });
+
+    auto irradianceDecode = spawn(get_task_scheduler(), []() -> gli::texture_cube
+    {
+        auto span = startup_profiler::get().phase("ibl-irradiance-decode");
+        auto binary = read_file_binary("../assets/textures/envmaps/studio_irradiance.dds");
+        return gli::texture_cube(gli::load_dds((char *)binary.data(), binary.size()));
+    });
+
+    {
+        auto span = startup_profiler::get().phase("imgui-init");
+        auto droidSansTTFBytes = read_file_binary("../assets/fonts/droid_sans.ttf");
+        igm.reset(new gui::imgui_instance(window));
+        gui::make_light_theme();
+        igm->add_font(droidSansTTFBytes);
+    }
 
     cam.look_at({ 0, 9.5f, -6.0f }, { 0, 0.1f, 0 });
     cam.farclip = 256;
     flycam.set_camera(&cam);
+    session.register_camera(&cam.pose); // record/replay captures the editor camera per frame
 
-    load_editor_intrinsic_assets("../assets/models/runtime/");
-    load_required_renderer_assets("../assets", shaderMonitor);
+    {
+        // Warm starts pull most of these shaders from the program binary cache
+        auto span = startup_profiler::get().phase("editor-assets");
+        load_editor_intrinsic_assets("../assets/models/runtime/");
+        load_required_renderer_assets("../assets", shaderMonitor);
+    }
 
     shaderMonitor.watch("wireframe",
        "../assets/shaders/wireframe_vert.glsl",
@@ -65,12 +92,19 @@ scene_editor_app::scene_editor_app() : polymer_app(1920, 1080, "Polymer Editor")
 
     fullscreen_surface.reset(new simple_texture_view());
 
-    renderer_settings initialSettings;
-    initialSettings.renderSize = int2(width, height);
-    scene.collision_system = orchestrator.create_system<collision_system>(&orchestrator);
-    scene.xform_system = orchestrator.create_system<transform_system>(&orchestrator);
-    scene.identifier_system = orchestrator.create_system<identifier_system>(&orchestrator);
-    scene.render_system = orchestrator.create_system<render_system>(initialSettings, &orchestrator);
+    // Static world overlays: built once, re-uploaded only if the batch changes
+    overlays.add_grid(1.f, 512, 512, float4(1, 1, 1, 0.25f));
+    overlays.add_axes(1.f);
+
+    {
+        auto span = startup_profiler::get().phase("ecs-systems");
+        renderer_settings initialSettings;
+        initialSettings.renderSize = int2(width, height);
+        scene.collision_system = orchestrator.create_system<collision_system>(&orchestrator);
+        scene.xform_system = orchestrator.create_system<transform_system>(&orchestrator);
+        scene.identifier_system = orchestrator.create_system<identifier_system>(&orchestrator);
+        scene.render_system = orchestrator.create_system<render_system>(initialSettings, &orchestrator);
+    }
 
     gizmo.reset(new gizmo_controller(scene.xform_system));
 
@@ -78,20 +112,43 @@ scene_editor_app::scene_editor_app() : polymer_app(1920, 1080, "Polymer Editor")
     renderer_payload.skybox = scene.render_system->get_skybox();
     renderer_payload.sunlight = scene.render_system->get_implicit_sunlight();
 
-    // @fixme - to be resolved rather than hard-coded
-    auto radianceBinary = read_file_binary("../assets/textures/envmaps/studio_radiance.dds");
-    auto irradianceBinary = read_file_binary("../assets/textures/envmaps/studio_irradiance.dds");
-    gli::texture_cube radianceHandle(gli::load_dds((char *)radianceBinary.data(), radianceBinary.size()));
-    gli::texture_cube irradianceHandle(gli::load_dds((char *)irradianceBinary.data(), irradianceBinary.size()));
-    create_handle_for_asset("wells-radiance-cubemap", load_cubemap(radianceHandle));
-    create_handle_for_asset("wells-irradiance-cubemap", load_cubemap(irradianceHandle));
+    {
+        // Join point for the worker-side decodes; only the upload runs here
+        auto span = startup_profiler::get().phase("ibl-upload");
+        create_handle_for_asset("wells-radiance-cubemap", load_cubemap(radianceDecode.get()));
+        create_handle_for_asset("wells-irradiance-cubemap", load_cubemap(irradianceDecode.get()));
+    }
 
     renderer_payload.ibl_irradianceCubemap = texture_handle("wells-irradiance-cubemap");
     renderer_payload.ibl_radianceCubemap = texture_handle("wells-radiance-cubemap");
 
-    scene.mat_library.reset(new polymer::material_library("../assets/materials/")); // must include trailing slash
+    {
+        auto span = startup_profiler::get().phase("material-library");
+        scene.mat_library.reset(new polymer::material_library("../assets/materials/")); // must include trailing slash
+    }
 
     resolver.reset(new asset_resolver());
+
+    // Per-frame update graph: the GL-bound maintenance stages must run on this
+    // thread (they create and swap GL objects), but neither touches component
+    // data, so the collision system's spatial index rebuild overlaps them on a
+    // worker instead of extending the serial section of the frame.
+    updateScheduler.add_stage("shader-recompile", {}, {},
+        [this]() { shaderMonitor.handle_recompile(); }, true);
+    updateScheduler.add_stage("asset-resolve", {}, {},
+        [this]() { if (resolver) resolver->update(); }, true); // picks up assets changed on disk since the last resolve
+    updateScheduler.add_stage("async-continuations", {}, {},
+        []() { main_thread_executor::get().drain(); }, true); // then_on_main continuations land here, on the GL thread
+    updateScheduler.add_stage("collision-spatial-index",
+        { get_typeid<geometry_component>(), get_typeid<local_transform_component>() }, {},
+        [this]() { scene.collision_system->update_spatial_index(); }); // one refresh shared by raycasts and culling
+    updateScheduler.add_stage("activity-advance",
+        { get_typeid<local_transform_component>() }, {},
+        [this]() { orchestrator.get_activity_tracker().advance(); }); // demote entities untouched for the threshold
+
+    // Incremental systems draw their per-frame time from a shared allotment; the
+    // scheduler shrinks each slice proportionally when the registrations oversubscribe it
+    budgetScheduler.register_system("asset-uploads", 2.0);
 }
 
 void scene_editor_app::on_drop(std::vector<std::string> filepaths)
@@ -103,6 +160,12 @@ void scene_editor_app::on_drop(std::vector<std::string> filepaths)
         {
             import_scene(path);
         }
+        else if (ext == "png" || ext == "tga" || ext == "jpg")
+        {
+            // Decode on a worker and upload over subsequent frames, so dropping a
+            // folder of large textures doesn't stall the editor.
+            asset_loader.load_texture_async(get_filename_without_extension(path), path);
+        }
         else
         {
             import_asset_runtime(path, scene, orchestrator);
@@ -168,6 +231,66 @@ void scene_editor_app::on_input(const app_input_event & event)
             if (event.value[0] == GLFW_KEY_SPACE && event.action == GLFW_RELEASE) {}
         }
 
+        // Rubber-band selection begins on shift + left-press and resolves on release
+        // through a cropped sub-frustum query against the shared spatial index
+        if (event.type == app_input_event::MOUSE && event.action == GLFW_PRESS && event.value[0] == GLFW_MOUSE_BUTTON_LEFT && event.using_shift_key() && !gizmo->active())
+        {
+            marquee_active = true;
+            marquee_begin = marquee_end = event.cursor;
+        }
+
+        if (event.type == app_input_event::CURSOR && marquee_active)
+        {
+            marquee_end = event.cursor;
+        }
+
+        if (event.type == app_input_event::MOUSE && event.action == GLFW_RELEASE && event.value[0] == GLFW_MOUSE_BUTTON_LEFT && marquee_active)
+        {
+            marquee_active = false;
+
+            int width, height;
+            glfwGetWindowSize(window, &width, &height);
+
+            const float2 rect_min = min(marquee_begin, marquee_end);
+            const float2 rect_max = max(marquee_begin, marquee_end);
+
+            // A sub-pixel drag is a click; fall through to the single-entity raycast below
+            if (rect_max[0] - rect_min[0] > 3.f && rect_max[1] - rect_min[1] > 3.f)
+            {
+                // Map the screen rect into ndc and build a crop matrix that stretches it
+                // over the full clip volume; the cropped view-projection yields a frustum
+                // covering exactly the banded region.
+                const float x0 = (rect_min[0] / static_cast<float>(width)) * 2.f - 1.f;
+                const float x1 = (rect_max[0] / static_cast<float>(width)) * 2.f - 1.f;
+                const float y0 = 1.f - (rect_max[1] / static_cast<float>(height)) * 2.f; // screen y runs downward
+                const float y1 = 1.f - (rect_min[1] / static_cast<float>(height)) * 2.f;
+
+                const float sx = 2.f / (x1 - x0), sy = 2.f / (y1 - y0);
+                const float4x4 crop = {
+                    { sx, 0, 0, 0 },
+                    { 0, sy, 0, 0 },
+                    { 0, 0, 1, 0 },
+                    { -(x0 + x1) * sx * 0.5f, -(y0 + y1) * sy * 0.5f, 0, 1 }
+                };
+
+                const float aspect = static_cast<float>(width) / static_cast<float>(height);
+                const float4x4 viewProj = cam.get_projection_matrix(aspect) * cam.get_view_matrix();
+
+                std::vector<entity> banded;
+                scene.collision_system->query_frustum(frustum(crop * viewProj), banded);
+
+                if (event.mods & GLFW_MOD_CONTROL)
+                {
+                    auto existingSelection = gizmo->get_selection();
+                    for (auto s : banded) if (!gizmo->selected(s)) existingSelection.push_back(s);
+                    gizmo->set_selection(existingSelection);
+                }
+                else gizmo->set_selection(banded);
+
+                return;
+            }
+        }
+
         // Raycast for editor/gizmo selection on mouse up
         if (event.type == app_input_event::MOUSE && event.action == GLFW_RELEASE && event.value[0] == GLFW_MOUSE_BUTTON_LEFT)
         {
@@ -214,8 +337,29 @@ void scene_editor_app::import_scene(const std::string & path)
         scene.destroy(kAllEntities);
         gizmo->clear();
         renderer_payload.render_components.clear();
-        scene.import_environment(path, orchestrator);
-        resolver->resolve("../assets/", &scene, scene.mat_library.get());
+
+        {
+            auto span = startup_profiler::get().phase("scene-import");
+            scene.import_environment(path, orchestrator);
+        }
+
+        {
+            // Indexes and prioritizes only; the per-frame "asset-resolve" stage drains
+            // the queue nearest-first, so the view around the camera becomes correct
+            // within a few frames instead of the window freezing on the full directory
+            auto span = startup_profiler::get().phase("asset-resolve");
+            resolver->resolve_incremental("../assets/", &scene, scene.mat_library.get(), cam.get_eye_point());
+        }
+
+        // Prefilter reflection probes once; chains are cached beside the scene file so
+        // subsequent opens of this scene skip the convolution entirely
+        const size_t last_separator = path.find_last_of("/\\");
+        const std::string scene_dir = (last_separator == std::string::npos) ? "." : path.substr(0, last_separator);
+        {
+            auto span = startup_profiler::get().phase("probe-bake");
+            scene.render_system->bake_reflection_probes(scene_dir);
+        }
+
         glfwSetWindowTitle(window, path.c_str());
     }
     else
@@ -260,10 +404,42 @@ void scene_editor_app::on_update(const app_update_event & e)
 
     set_working_directory(working_dir_on_launch);
 
+    // One-shot startup phase table, logged once the first frame is reached
+    for (const auto & line : startup_profiler::get().report_once())
+    {
+        log::get()->engine_log->info("[startup] {}", line);
+    }
+
+    // Autosave: the GL thread only pays for the reflection snapshot; json
+    // serialization and the atomic file replace happen on a worker.
+    if (e.elapsed_s - lastAutosaveTime > autosave_interval_seconds)
+    {
+        lastAutosaveTime = e.elapsed_s;
+        scene.export_environment_async("../assets/scenes/editor-autosave.json");
+    }
+
     editorProfiler.begin("on_update");
     flycam.update(e.timestep_ms);
-    shaderMonitor.handle_recompile();
+    updateScheduler.execute(); // shader recompiles + asset resolve on this thread, spatial index rebuild on a worker
     gizmo->on_update(cam, float2(static_cast<float>(width), static_cast<float>(height)));
+
+    // Journal gizmo drags as a single undo step: snapshot the selection when the
+    // drag begins, commit the pre-captured delta when it ends.
+    const bool gizmo_is_active = gizmo->active();
+    if (gizmo_is_active && !gizmo_was_active)
+    {
+        gizmo_drag_journal.clear();
+        for (const entity e : gizmo->get_selection()) gizmo_drag_journal.push_back(capture_entity_snapshot(scene, e));
+    }
+    else if (!gizmo_is_active && gizmo_was_active && !gizmo_drag_journal.empty())
+    {
+        std::vector<entity_snapshot> after;
+        for (const auto & snap : gizmo_drag_journal) after.push_back(capture_entity_snapshot(scene, snap.e));
+        undo_mgr.execute(make_action<action_edit_entities>("transform entity", scene, std::move(gizmo_drag_journal), std::move(after)));
+        gizmo_drag_journal.clear();
+    }
+    gizmo_was_active = gizmo_is_active;
+
     editorProfiler.end("on_update");
 }
 
@@ -325,6 +501,14 @@ void scene_editor_app::on_draw()
 {
     glfwMakeContextCurrent(window);
 
+    // Budgeted uploads of any background-decoded assets: stop when the byte budget
+    // or this system's time slice is spent, whichever comes first; leftover time
+    // (or overshoot) carries into the next frame's slice
+    budgetScheduler.begin_frame();
+    budgetScheduler.begin("asset-uploads");
+    asset_loader.update([this]() { return budgetScheduler.over_slice("asset-uploads"); });
+    budgetScheduler.end("asset-uploads");
+
     glEnable(GL_CULL_FACE);
     glEnable(GL_DEPTH_TEST);
 
@@ -345,46 +529,12 @@ void scene_editor_app::on_draw()
     {
         editorProfiler.begin("gather-scene");
 
-        // Clear out transient scene payload data
         renderer_payload.views.clear();
-        renderer_payload.render_components.clear();
-        renderer_payload.point_lights.clear();
-        renderer_payload.sunlight = nullptr;
-
-        // Does the entity have a material? If so, we can render it. 
-        for (const auto e : scene.entity_list())
-        {
-            if (material_component * mat_c = scene.render_system->get_material_component(e))
-            {
-                auto mesh_c = scene.render_system->get_mesh_component(e);
-                if (!mesh_c) continue; // for the case that we just created a material component and haven't set a mesh yet
-
-                auto xform_c = scene.xform_system->get_world_transform(e);
-                assert(xform_c != nullptr); // we did something bad if this entity doesn't also have a world transform component
 
-                auto scale_c = scene.xform_system->get_local_transform(e);
-                assert(scale_c != nullptr); 
-
-                render_component r = assemble_render_component(scene, e);
-                renderer_payload.render_components.push_back(r);
-            }
-        }
-
-        // Gather directional light. The sunlight is an implicit directional light created
-        // on the renderer (it is not tracked by the orchestrator so isn't in the scene.entity_list())
-        if (auto implicit_sun = scene.render_system->get_implicit_sunlight())
-        {
-            renderer_payload.sunlight = implicit_sun;
-        }
-
-        // Gather point lights
-        for (const auto e : scene.entity_list())
-        {
-            if (auto pt_light_c = scene.render_system->get_point_light_component(e))
-            {
-                renderer_payload.point_lights.push_back(pt_light_c);
-            }
-        }
+        // Parallel gather: distance-aware assembly (which resolves each entity's lod
+        // chain and tags impostors) is chunked over the task scheduler, and lights,
+        // probes, skybox and the implicit sunlight are collected in the same call
+        scene.render_system->gather_render_payload(scene, cam.pose.position, renderer_payload);
 
         // Add single-viewport camera
         renderer_payload.views.push_back(view_data(0, cam.pose, projectionMatrix));
@@ -404,7 +554,7 @@ void scene_editor_app::on_draw()
 
         if (show_grid)
         {
-            grid.draw(viewProjectionMatrix, Identity4x4, float4(1, 1, 1, 0.25f));
+            overlays.draw(viewProjectionMatrix);
         }
         gl_check_error(__FILE__, __LINE__);
     }
@@ -459,7 +609,7 @@ void scene_editor_app::on_draw()
             {
                 gizmo->clear();
                 renderer_payload.render_components.clear();
-                scene.export_environment(export_path);
+                scene.export_environment_async(export_path); // snapshot here, serialize + replace off-thread
                 glfwSetWindowTitle(window, export_path.c_str());
             }
         }
@@ -481,21 +631,43 @@ void scene_editor_app::on_draw()
         menu.end();
 
         menu.begin("Edit");
-        if (menu.item("Clone", GLFW_MOD_CONTROL, GLFW_KEY_D)) 
+        if (menu.item("Undo", GLFW_MOD_CONTROL, GLFW_KEY_Z))
+        {
+            if (undo_mgr.can_undo()) { undo_mgr.undo(); gizmo->clear(); } // selection may reference a reverted entity
+        }
+        if (menu.item("Redo", GLFW_MOD_CONTROL, GLFW_KEY_Y))
+        {
+            if (undo_mgr.can_redo()) { undo_mgr.redo(); gizmo->clear(); }
+        }
+        if (menu.item("Clone", GLFW_MOD_CONTROL, GLFW_KEY_D))
         {
             const auto selection_list = gizmo->get_selection();
             if (!selection_list.empty() && selection_list[0] != kInvalidEntity)
             {
-                const entity the_copy = scene.track_entity(orchestrator.create_entity());
-                scene.copy(selection_list[0], the_copy);
+                const entity src = selection_list[0];
+                entity the_copy = kInvalidEntity;
+                undo_mgr.execute(make_action<action_edit_entities>("clone entity", scene, std::vector<entity>{}, [this, src, &the_copy]()
+                {
+                    the_copy = scene.track_entity(orchestrator.create_entity());
+                    scene.copy(src, the_copy);
+                    return std::vector<entity>{ the_copy };
+                }));
                 std::vector<entity> new_selection_list = { the_copy };
                 gizmo->set_selection(new_selection_list);
             }
         }
-        if (menu.item("Delete", 0, GLFW_KEY_DELETE)) 
+        if (menu.item("Delete", 0, GLFW_KEY_DELETE))
         {
             const auto selection_list = gizmo->get_selection();
-            if (!selection_list.empty() && selection_list[0] != kInvalidEntity) scene.destroy(selection_list[0]);
+            if (!selection_list.empty() && selection_list[0] != kInvalidEntity)
+            {
+                const entity doomed = selection_list[0];
+                undo_mgr.execute(make_action<action_edit_entities>("delete entity", scene, std::vector<entity>{ doomed }, [this, doomed]()
+                {
+                    scene.destroy(doomed);
+                    return std::vector<entity>{};
+                }));
+            }
             gizmo->clear();
         }
         if (menu.item("Select All", GLFW_MOD_CONTROL, GLFW_KEY_A)) 
@@ -505,11 +677,17 @@ void scene_editor_app::on_draw()
         menu.end();
 
         menu.begin("Create");
-        if (menu.item("entity")) 
+        if (menu.item("entity"))
         {
-            std::vector<entity> list = { scene.track_entity(orchestrator.create_entity()) };
-            scene.xform_system->create(list[0], transform());
-            scene.identifier_system->create(list[0], "new entity (" + std::to_string(list[0]) + ")");
+            entity spawned = kInvalidEntity;
+            undo_mgr.execute(make_action<action_edit_entities>("create entity", scene, std::vector<entity>{}, [this, &spawned]()
+            {
+                spawned = scene.track_entity(orchestrator.create_entity());
+                scene.xform_system->create(spawned, transform());
+                scene.identifier_system->create(spawned, "new entity (" + std::to_string(spawned) + ")");
+                return std::vector<entity>{ spawned };
+            }));
+            std::vector<entity> list = { spawned };
             gizmo->set_selection(list); // Newly spawned objects are selected by default
         }
         menu.end();
@@ -523,6 +701,10 @@ void scene_editor_app::on_draw()
         {
             should_open_asset_browser = true;
         }
+        else if (menu.item("Frame Budget HUD", GLFW_MOD_CONTROL, GLFW_KEY_P))
+        {
+            perfHUD.visible = !perfHUD.visible;
+        }
         menu.end();
     }
 
@@ -581,6 +763,7 @@ void scene_editor_app::on_draw()
                             if      (type_name == get_typename<identifier_component>()) system_pointer->create(selection, get_typeid<identifier_component>(), &identifier_component(selection));
                             else if (type_name == get_typename<local_transform_component>()) system_pointer->create(selection, get_typeid<local_transform_component>(), &local_transform_component(selection));
                             else if (type_name == get_typename<mesh_component>()) system_pointer->create(selection, get_typeid<mesh_component>(), &mesh_component(selection));
+                            else if (type_name == get_typename<lod_component>()) system_pointer->create(selection, get_typeid<lod_component>(), &lod_component(selection));
                             else if (type_name == get_typename<material_component>()) system_pointer->create(selection, get_typeid<material_component>(), &material_component(selection));
                             else if (type_name == get_typename<geometry_component>()) system_pointer->create(selection, get_typeid<geometry_component>(), &geometry_component(selection));
                             else if (type_name == get_typename<point_light_component>()) system_pointer->create(selection, get_typeid<point_light_component>(), &point_light_component(selection));
@@ -691,9 +874,70 @@ void scene_editor_app::on_draw()
                 for (auto & t : scene.render_system->get_renderer()->cpuProfiler.get_data()) ImGui::Text("[Renderer CPU] %s %f ms", t.first.c_str(), t.second);
             }
 
+            if (ImGui::TreeNode("Pass Statistics"))
+            {
+                ImGui::Text("%-20s %6s %6s %6s %6s %10s", "pass", "draws", "progs", "texes", "ubos", "tris");
+                for (const auto & pass : scene.render_system->get_renderer()->get_pass_stats())
+                {
+                    const gl_submission_stats_snapshot & s = pass.second;
+                    ImGui::Text("%-20s %6llu %6llu %6llu %6llu %10llu", pass.first.c_str(),
+                        (unsigned long long) s.drawCalls, (unsigned long long) s.programBinds,
+                        (unsigned long long) s.textureBinds, (unsigned long long) s.uboUpdates,
+                        (unsigned long long) s.triangles);
+                }
+                ImGui::Checkbox("Log to polymer-pass-stats.csv", &log_pass_stats_csv);
+                ImGui::TreePop();
+            }
+
+            ImGui::Dummy({ 0, 10 });
+
+            if (ImGui::TreeNode("GPU Memory"))
+            {
+                const auto & tracker = gl_memory_tracker::get();
+                for (uint32_t c = 0; c < static_cast<uint32_t>(gl_memory_category::count); ++c)
+                {
+                    const gl_memory_category category = static_cast<gl_memory_category>(c);
+                    ImGui::Text("%-16s %8.2f MB (%lld allocations)", to_string(category),
+                        tracker.get_bytes(category) / (1024.0 * 1024.0),
+                        static_cast<long long>(tracker.get_allocation_count(category)));
+                }
+                ImGui::Separator();
+                ImGui::Text("%-16s %8.2f MB", "total", tracker.get_total_bytes() / (1024.0 * 1024.0));
+                ImGui::TreePop();
+            }
+
             ImGui::Dummy({ 0, 10 });
 
             for (auto & t : editorProfiler.get_data()) ImGui::Text("[Editor] %s %f ms", t.first.c_str(), t.second);
+
+            ImGui::Dummy({ 0, 10 });
+
+            if (trace_capture::get().is_active()) ImGui::TextDisabled("capturing trace...");
+            else if (ImGui::Button("Capture Trace (120 frames)")) trace_capture::get().begin(120);
+
+            ImGui::Dummy({ 0, 10 });
+
+            // Deterministic session record/replay for A/B benchmarking (see app_session);
+            // pair a replay with the pass statistics CSV to compare renderer builds
+            if (session.is_recording())
+            {
+                ImGui::Text("recording session... %d frames", int(session.get_frame_count()));
+                if (ImGui::Button("Stop Recording")) { session.stop(); log.Update("session written to polymer-session.bin"); }
+            }
+            else if (session.is_replaying())
+            {
+                ImGui::Text("replaying session... %d / %d", int(session.get_playhead()), int(session.get_frame_count()));
+                if (ImGui::Button("Stop Replay")) session.stop();
+            }
+            else
+            {
+                if (ImGui::Button("Record Session")) session.start_recording("polymer-session.bin");
+                ImGui::SameLine();
+                if (ImGui::Button("Replay Session"))
+                {
+                    if (!session.start_replay("polymer-session.bin")) log.Update("could not load polymer-session.bin");
+                }
+            }
         }
         gui::imgui_fixed_window_end();
 
@@ -704,6 +948,21 @@ void scene_editor_app::on_draw()
         gui::imgui_fixed_window_end();
     }
 
+    // Rubber-band selection rectangle, drawn over everything while the band is dragged
+    if (marquee_active)
+    {
+        const ImVec2 a{ std::min(marquee_begin[0], marquee_end[0]), std::min(marquee_begin[1], marquee_end[1]) };
+        const ImVec2 b{ std::max(marquee_begin[0], marquee_end[0]), std::max(marquee_begin[1], marquee_end[1]) };
+        ImDrawList * overlay = ImGui::GetOverlayDrawList();
+        overlay->AddRectFilled(a, b, IM_COL32(64, 128, 255, 32));
+        overlay->AddRect(a, b, IM_COL32(64, 128, 255, 200));
+    }
+
+    // Overlay - draws independently of the editor panels so it works in fullscreen preview too
+    perfHUD.draw("Frame Budget",
+        scene.render_system->get_renderer()->gpuProfiler,
+        scene.render_system->get_renderer()->cpuProfiler);
+
     igm->end_frame();
     editorProfiler.end("imgui-editor");
 
@@ -735,6 +994,38 @@ void scene_editor_app::on_draw()
     if (material_editor && material_editor->get_window()) material_editor->run();
     if (asset_browser && asset_browser->get_window()) asset_browser->run();
 
+    // One frame marker per swap; exports when the capture burst completes
+    if (trace_capture::get().signal_frame())
+    {
+        trace_capture::get().export_to_file("polymer-trace.json");
+        log.Update("exported profiler capture to polymer-trace.json");
+    }
+
+    // Frame boundary for the hitch flight recorder; dumps its history on a hitch
+    const std::string hitchDump = flight_recorder::get().end_frame();
+    if (!hitchDump.empty()) log.Update("frame hitch detected, dumped " + hitchDump);
+
+    // Stream per-pass submission statistics while the settings pane checkbox is enabled
+    if (log_pass_stats_csv)
+    {
+        if (!pass_stats_csv.is_open())
+        {
+            pass_stats_csv.open("polymer-pass-stats.csv", std::ios::trunc);
+            pass_stats_csv << "frame,pass,draw_calls,program_binds,texture_binds,ubo_updates,triangles\n";
+        }
+        for (const auto & pass : scene.render_system->get_renderer()->get_pass_stats())
+        {
+            const gl_submission_stats_snapshot & s = pass.second;
+            pass_stats_csv << pass_stats_frame << "," << pass.first << "," << s.drawCalls << "," << s.programBinds
+                           << "," << s.textureBinds << "," << s.uboUpdates << "," << s.triangles << "\n";
+        }
+        pass_stats_frame++;
+    }
+    else if (pass_stats_csv.is_open())
+    {
+        pass_stats_csv.close();
+    }
+
     glfwSwapBuffers(window);
 }
 
@@ -17,44 +17,72 @@
 
 #include "material.hpp"
 #include "uniforms.hpp"
+#include "frame-scheduler.hpp"
 #include "asset-handle-utils.hpp"
 #include "environment.hpp"
 #include "arcball.hpp"
 #include "asset-resolver.hpp"
+#include "asset-loader.hpp"
 #include "ui-actions.hpp"
+#include "scene-journal.hpp"
 
+#include "system-util.hpp"
 #include "material-editor.hpp"
 #include "asset-browser.hpp"
 #include "gizmo-controller.hpp"
+#include "profiling-hud.hpp"
 
 struct scene_editor_app final : public polymer_app
 {
     perspective_camera cam;
     fps_camera_controller flycam;
     profiler<simple_cpu_timer> editorProfiler;
+    profiler_hud perfHUD;
     gl_shader_monitor shaderMonitor { "../assets/" };
-    gl_renderable_grid grid{ 1.f, 512, 512 };
+    gl_static_overlay overlays; // grid + world axes, retained and drawn in one batch
 
     imgui_ui_context im_ui_ctx;
     undo_manager undo_mgr;
 
+    // Journals gizmo drags as one undo step: selection state is snapshotted when the
+    // gizmo becomes active and the delta is committed when the drag ends.
+    std::vector<entity_snapshot> gizmo_drag_journal;
+    bool gizmo_was_active = false;
+
+    // Rubber-band (shift+drag) selection; resolved through the collision system's
+    // shared spatial index rather than testing every entity against the frustum
+    bool marquee_active = false;
+    float2 marquee_begin, marquee_end;
+
     ImGui::editor_app_log log;
     bool show_imgui = true;
     bool show_grid = true;
     bool should_open_material_window = false;
     bool should_open_asset_browser = false;
+    bool log_pass_stats_csv = false;
+    std::ofstream pass_stats_csv;
+    uint64_t pass_stats_frame = 0;
     std::string working_dir_on_launch;
 
     shader_handle wireframeHandle{ "wireframe" };
 
     std::unique_ptr<gui::imgui_instance> igm;
     std::unique_ptr<asset_resolver> resolver;
+    frame_scheduler updateScheduler; // overlaps GL-bound maintenance with CPU-side update stages
+
+    double lastAutosaveTime{ 0.0 };
+    static constexpr double autosave_interval_seconds = 120.0;
+    gl_asset_loader asset_loader; // dropped textures decode on workers and upload on a per-frame budget
+    frame_budget_scheduler budgetScheduler; // time-slices the incremental systems above a shared per-frame allotment
     std::unique_ptr<material_editor_window> material_editor;
     std::unique_ptr<asset_browser_window> asset_browser;
     std::unique_ptr<simple_texture_view> fullscreen_surface;
     std::shared_ptr<gizmo_controller> gizmo;
 
-    render_payload renderer_payload;
+    // The payload's vectors are cleared and re-gathered each frame; backing them with the
+    // arena means they bump-allocate during warm-up and make no heap allocations after.
+    linear_arena frame_arena{ 2 * 1024 * 1024 };
+    render_payload renderer_payload{ frame_arena };
     entity_orchestrator orchestrator;
     environment scene;
 
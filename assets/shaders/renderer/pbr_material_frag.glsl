@@ -7,6 +7,10 @@
 // [4] https://www.cs.virginia.edu/~jdl/bib/appearance/analytic%20models/schlick94b.pdf
 // [5] https://developer.nvidia.com/gpugems/GPUGems/gpugems_ch19.html
 
+#ifdef USE_BINDLESS_TEXTURE
+#extension GL_ARB_bindless_texture : require
+#endif
+
 #include "renderer_common.glsl"
 #include "colorspace_conversions.glsl"
 #include "cascaded_shadows.glsl"
@@ -23,6 +27,30 @@ uniform float u_roughness = 1;
 uniform float u_metallic = 1;
 uniform float u_opacity = 1;
 
+#ifdef USE_BINDLESS_TEXTURE
+
+// Resident handles uploaded by the material (see uniforms.hpp). The HAS_*_MAP
+// defines still gate which handles are ever constructed and sampled, so
+// unassigned slots simply stay zero.
+layout(binding = 8, std140) uniform PerBindlessMaterial
+{
+    uvec2 bt_albedo;
+    uvec2 bt_normal;
+    uvec2 bt_roughness;
+    uvec2 bt_metallic;
+    uvec2 bt_emissive;
+    uvec2 bt_occlusion;
+};
+
+#define s_albedo sampler2D(bt_albedo)
+#define s_normal sampler2D(bt_normal)
+#define s_roughness sampler2D(bt_roughness)
+#define s_metallic sampler2D(bt_metallic)
+#define s_emissive sampler2D(bt_emissive)
+#define s_occlusion sampler2D(bt_occlusion)
+
+#else
+
 #ifdef HAS_ALBEDO_MAP
     uniform sampler2D s_albedo;
 #endif
@@ -47,6 +75,8 @@ uniform float u_opacity = 1;
     uniform sampler2D s_occlusion;
 #endif
 
+#endif // USE_BINDLESS_TEXTURE
+
 // Lighting & Shadowing Uniforms
 uniform float u_pointLightAttenuation = 1.0;
 uniform float u_shadowOpacity = 1.0;
@@ -67,6 +97,9 @@ uniform float u_emissiveStrength = 1.0;
 #ifdef USE_IMAGE_BASED_LIGHTING
     uniform samplerCube sc_irradiance;
     uniform samplerCube sc_radiance;
+    uniform samplerCube sc_radiance_blend; // second-nearest reflection probe
+    uniform float u_probeBlend = 0.0;      // 0 = sc_radiance only
+    uniform sampler2D s_brdfLut;           // precomputed split-sum BRDF terms, indexed by (NdotV, roughness)
 #endif
 
 out vec4 f_color;
@@ -142,8 +175,8 @@ void compute_ibl(LightingInfo data, vec3 n, vec3 refl)
 
 void main()
 {   
-    // Surface properties
-    vec3 albedo = u_albedo;
+    // Surface properties (the per-instance property block tints the shared material)
+    vec3 albedo = u_albedo * u_propertyTint.rgb;
     vec3 N = normalize(v_normal);
 
     float roughness = clamp(u_roughness, 0.04, 1.0);
@@ -233,11 +266,25 @@ void main()
         Lo += NdotL * u_directionalLight.color * (diffuseContrib + specContrib);
     }
 
-    // Compute point lights
+    // Compute point lights. With clustered shading only the lights binned into this
+    // fragment's froxel are walked; the legacy path iterates the fixed uniform array.
+#ifdef USE_CLUSTERED_SHADING
+    uvec2 clusterSpan = u_clusterTable[compute_cluster_index(v_view_space_position, gl_FragCoord.xy)];
+    for (uint c = 0u; c < clusterSpan.y; ++c)
+    {
+        uint lightIdx = u_clusterIndices[clusterSpan.x + c];
+        vec3 lightColor = u_clusterLightData[2u * lightIdx].rgb;
+        float lightRadius = u_clusterLightData[2u * lightIdx].a;
+        vec3 lightPosition = u_clusterLightData[2u * lightIdx + 1u].xyz;
+#else
     for (int i = 0; i < u_activePointLights; ++i)
     {
-        vec3 L = normalize(u_pointLights[i].position - v_world_position); 
-        vec3 H = normalize(L + V);  
+        vec3 lightColor = u_pointLights[i].color;
+        float lightRadius = u_pointLights[i].radius;
+        vec3 lightPosition = u_pointLights[i].position;
+#endif
+        vec3 L = normalize(lightPosition - v_world_position);
+        vec3 H = normalize(L + V);
 
         float NdotL = clamp(dot(N, L), 0.001, 1.0);
         float NdotH = clamp(dot(N, H), 0.0, 1.0);
@@ -250,13 +297,13 @@ void main()
             diffuseColor, specularColor
         );
 
-        float dist = length(u_pointLights[i].position - v_world_position);
-        float attenuation = point_light_attenuation(u_pointLights[i].radius, 2.0, 0.1, dist); // reasonable intensity is 0.01 to 8
+        float dist = length(lightPosition - v_world_position);
+        float attenuation = point_light_attenuation(lightRadius, 2.0, 0.1, dist); // reasonable intensity is 0.01 to 8
 
         vec3 diffuseContrib, specContrib;
         compute_cook_torrance(data, attenuation, diffuseContrib, specContrib);
 
-        Lo += NdotL * u_pointLights[i].color * (diffuseContrib + specContrib) * attenuation;
+        Lo += NdotL * lightColor * (diffuseContrib + specContrib) * attenuation;
     }
 
     #ifdef USE_IMAGE_BASED_LIGHTING
@@ -268,7 +315,16 @@ void main()
         vec3 irradiance = sRGBToLinear(texture(sc_irradiance, N).rgb, DEFAULT_GAMMA) * u_ambientStrength;
         vec3 radiance = sRGBToLinear(textureLod(sc_radiance, cubemapLookup, mipLevel).rgb, DEFAULT_GAMMA) * u_ambientStrength;
 
-        vec3 environment_reflectance = env_brdf_approx(specularColor, pow(roughness, 4.0), NdotV);
+        // Blend toward the second-nearest reflection probe when the renderer bound one
+        if (u_probeBlend > 0.0)
+        {
+            vec3 radianceBlend = sRGBToLinear(textureLod(sc_radiance_blend, cubemapLookup, mipLevel).rgb, DEFAULT_GAMMA) * u_ambientStrength;
+            radiance = mix(radiance, radianceBlend, u_probeBlend);
+        }
+
+        // Split-sum BRDF terms from the baked LUT (env_brdf_approx remains the analytic fallback)
+        vec2 envBrdf = texture(s_brdfLut, vec2(NdotV, roughness)).rg;
+        vec3 environment_reflectance = specularColor * envBrdf.x + envBrdf.y;
 
         vec3 iblDiffuse = (diffuseColor * irradiance);
         vec3 iblSpecular = (environment_reflectance * radiance);
@@ -278,7 +334,7 @@ void main()
     #endif
 
     #ifdef HAS_EMISSIVE_MAP
-        Lo += texture(s_emissive, v_texcoord).rgb * u_emissiveStrength; 
+        Lo += texture(s_emissive, v_texcoord).rgb * u_emissiveStrength * u_propertyEmissiveScale;
     #endif
 
     #ifdef HAS_OCCLUSION_MAP
@@ -286,7 +342,7 @@ void main()
         Lo = mix(Lo, Lo * ao, u_occlusionStrength);
     #endif
 
-    Lo += (u_emissive * u_emissiveStrength);
+    Lo += (u_emissive * u_emissiveStrength * u_propertyEmissiveScale);
 
     // Debugging
     //f_color = vec4(vec3(debugShadowColor), 1.0);
@@ -298,5 +354,5 @@ void main()
     //f_color = vec4(specularEnvironmentR90, 1.0);
 
     // Combine direct lighting, IBL, and shadow visbility
-    f_color = vec4(Lo * shadowVisibility, u_opacity); 
+    f_color = vec4(Lo * shadowVisibility, u_opacity * u_propertyTint.a); 
 }
@@ -77,20 +77,34 @@ void main()
         Lo += (diffuseContrib + specContrib);
     }
 
-    // Compute point lights
+    // Compute point lights. With clustered shading only the lights binned into this
+    // fragment's froxel are walked; the legacy path iterates the fixed uniform array.
+#ifdef USE_CLUSTERED_SHADING
+    uvec2 clusterSpan = u_clusterTable[compute_cluster_index(v_view_space_position, gl_FragCoord.xy)];
+    for (uint c = 0u; c < clusterSpan.y; ++c)
+    {
+        uint lightIdx = u_clusterIndices[clusterSpan.x + c];
+        vec3 lightColor = u_clusterLightData[2u * lightIdx].rgb;
+        float lightRadius = u_clusterLightData[2u * lightIdx].a;
+        vec3 lightPosition = u_clusterLightData[2u * lightIdx + 1u].xyz;
+#else
     for (int i = 0; i < u_activePointLights; ++i)
     {
-        vec3 L = normalize(u_pointLights[i].position - v_world_position); 
-        vec3 H = normalize(L + V);  
+        vec3 lightColor = u_pointLights[i].color;
+        float lightRadius = u_pointLights[i].radius;
+        vec3 lightPosition = u_pointLights[i].position;
+#endif
+        vec3 L = normalize(lightPosition - v_world_position);
+        vec3 H = normalize(L + V);
 
         float NdotL = clamp(dot(N, L), 0.001, 1.0);
         float NdotH = clamp(dot(N, H), 0.0, 1.0);
         float LdotH = clamp(dot(L, H), 0.0, 1.0);
 
-        float dist = length(u_pointLights[i].position - v_world_position);
-        float attenuation = point_light_attenuation(u_pointLights[i].radius, 2.0, 0.1, dist); // reasonable intensity is 0.01 to 8
+        float dist = length(lightPosition - v_world_position);
+        float attenuation = point_light_attenuation(lightRadius, 2.0, 0.1, dist); // reasonable intensity is 0.01 to 8
 
-        const vec3 irradiance = NdotL * u_pointLights[i].color;
+        const vec3 irradiance = NdotL * lightColor;
 
         vec3 diffuseContrib, specContrib;
         diffuseContrib += irradiance * lambert_diffuse(diffuseColor);
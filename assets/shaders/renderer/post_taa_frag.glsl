@@ -0,0 +1,55 @@
+#version 330
+
+// Temporal antialiasing / upsampling resolve. The geometry passes render with a
+// sub-pixel jittered projection (and optionally at reduced resolution - the MSAA
+// resolve blit has already stretched the frame back to full size by the time we
+// run). History is reprojected through the depth buffer with last frame's
+// view-projection, clamped to the 3x3 neighborhood min/max of the current frame
+// to reject disocclusions and ghosting, and blended with u_feedback weight.
+
+uniform sampler2D s_current; // resolved HDR color, this frame
+uniform sampler2D s_history; // accumulated output, last frame
+uniform sampler2D s_depth;   // resolved depth, this frame
+
+uniform mat4 u_reprojection; // previousViewProj * inverse(currentViewProj), both unjittered
+uniform float u_feedback;    // history weight; 0 on the first frame after a reset
+
+in vec2 v_texcoord0;
+
+out vec4 f_color;
+
+void main()
+{
+    vec3 current = texture(s_current, v_texcoord0).rgb;
+
+    // Reconstruct this pixel's clip position from depth and carry it into last frame
+    float depth = texture(s_depth, v_texcoord0).r;
+    vec4 clip = vec4(vec3(v_texcoord0, depth) * 2.0 - 1.0, 1.0);
+    vec4 reprojected = u_reprojection * clip;
+    vec2 historyUV = (reprojected.xy / reprojected.w) * 0.5 + 0.5;
+
+    if (any(lessThan(historyUV, vec2(0.0))) || any(greaterThan(historyUV, vec2(1.0))))
+    {
+        f_color = vec4(current, 1.0);
+        return;
+    }
+
+    vec3 history = texture(s_history, historyUV).rgb;
+
+    // Neighborhood clamp: constrain history to the local color bounds of the new frame
+    vec2 texel = 1.0 / vec2(textureSize(s_current, 0));
+    vec3 boxMin = current;
+    vec3 boxMax = current;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            vec3 s = texture(s_current, v_texcoord0 + vec2(x, y) * texel).rgb;
+            boxMin = min(boxMin, s);
+            boxMax = max(boxMax, s);
+        }
+    }
+    history = clamp(history, boxMin, boxMax);
+
+    f_color = vec4(mix(current, history, u_feedback), 1.0);
+}
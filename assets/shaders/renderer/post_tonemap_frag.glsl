@@ -1,5 +1,11 @@
 #version 330
 
+#ifdef USE_AUTO_EXPOSURE
+#extension GL_ARB_shader_storage_buffer_object : require
+// Written by the auto-exposure compute reduction (see renderer-exposure.hpp)
+layout(std430, binding = 7) readonly buffer ExposureData { float exposure; float adaptedLuminance; };
+#endif
+
 uniform sampler2D s_texColor;
 
 in vec2 v_texcoord0;
@@ -7,7 +13,9 @@ in vec2 v_texcoord0;
 out vec4 f_color;
 
 const float gamma     = 2.2;
+#ifndef USE_AUTO_EXPOSURE
 const float exposure  = 1.0;
+#endif
 const float pureWhite = 1.0;
 
 vec3 uncharted2_tonemap(in vec3 x) 
@@ -1,5 +1,9 @@
 #version 450
 
+#ifdef USE_STEREO_SINGLE_PASS
+#extension GL_ARB_shader_viewport_layer_array : require
+#endif
+
 #define saturate(x) clamp(x, 0.0, 1.0)
 #define PI 3.1415926535897932384626433832795
 #define INV_PI 1.0 / PI
@@ -45,14 +49,42 @@ layout(binding = 1, std140) uniform PerView
     mat4 u_viewMatrix;
     mat4 u_viewProjMatrix;
     vec4 u_eyePos;
+    vec4 u_nearFarClip; // x = near, y = far
+    mat4 u_viewMatrixStereo[2];     // single-pass stereo, per-eye
+    mat4 u_viewProjMatrixStereo[2];
+    vec4 u_eyePosStereo[2];
 };
 
+#ifdef USE_CLUSTERED_SHADING
+
+const ivec3 CLUSTER_GRID = ivec3(16, 8, 24);
+
+layout(std430, binding = 3) readonly buffer ClusterLightData { vec4 u_clusterLightData[]; }; // 2 x vec4 per light: [color.rgb, radius], [position.xyz, 0]
+layout(std430, binding = 4) readonly buffer ClusterTable { uvec2 u_clusterTable[]; };        // (offset, count) per froxel
+layout(std430, binding = 5) readonly buffer ClusterIndices { uint u_clusterIndices[]; };
+
+// Froxel index for a fragment: screen-space tile in xy, exponential slice in view z
+int compute_cluster_index(vec3 view_space_position, vec2 frag_coord)
+{
+    frag_coord = mod(frag_coord, resolution); // side-by-side stereo renders the right eye at x >= resolution.x
+    ivec2 tile = clamp(ivec2(frag_coord * invResolution * vec2(CLUSTER_GRID.xy)), ivec2(0), CLUSTER_GRID.xy - 1);
+    float viewZ = max(-view_space_position.z, u_nearFarClip.x);
+    float sliceF = log(viewZ / u_nearFarClip.x) / log(u_nearFarClip.y / u_nearFarClip.x);
+    int slice = clamp(int(sliceF * float(CLUSTER_GRID.z)), 0, CLUSTER_GRID.z - 1);
+    return (slice * CLUSTER_GRID.y + tile.y) * CLUSTER_GRID.x + tile.x;
+}
+
+#endif
+
 layout(binding = 2, std140) uniform PerObject
 {
     mat4 u_modelMatrix;
     mat4 u_modelMatrixIT;
     mat4 u_modelViewMatrix;
+    mat4 u_modelMatrixPrevious; // last frame's model matrix, for per-object motion vectors
     float u_receiveShadow;
+    vec4 u_propertyTint;           // per-instance albedo/opacity multiplier over the shared material
+    float u_propertyEmissiveScale; // per-instance emissive multiplier
 };
 
 vec2 get_shadow_offsets(vec3 N, vec3 L) 
@@ -7,6 +7,25 @@ layout(location = 3) in vec2 inTexCoord;
 layout(location = 4) in vec3 inTangent;
 layout(location = 5) in vec3 inBitangent;
 
+#ifdef USE_INSTANCING
+// Four vec4 columns of the per-instance model matrix, advanced once per instance
+layout(location = 6) in vec4 inInstanceModelCol0;
+layout(location = 7) in vec4 inInstanceModelCol1;
+layout(location = 8) in vec4 inInstanceModelCol2;
+layout(location = 9) in vec4 inInstanceModelCol3;
+#endif
+
+#ifdef USE_SKINNING
+// Bone indices ride as float4 to keep the attribute stream uniform; weights are pre-normalized
+layout(location = 10) in vec4 inBoneIndices;
+layout(location = 11) in vec4 inBoneWeights;
+
+layout(binding = 7, std140) uniform PerSkin
+{
+    mat4 u_bonePalette[256];
+};
+#endif
+
 out vec3 v_normal;
 out vec3 v_world_position;
 out vec3 v_view_space_position;
@@ -19,13 +38,50 @@ uniform vec2 u_texCoordScale = vec2(1, 1);
 
 void main()
 {
-    vec4 worldPosition = u_modelMatrix * vec4(inPosition, 1.0);
+#ifdef USE_INSTANCING
+    mat4 modelMatrix = mat4(inInstanceModelCol0, inInstanceModelCol1, inInstanceModelCol2, inInstanceModelCol3);
+    mat4 modelMatrixIT = transpose(inverse(modelMatrix));
+    mat4 modelViewMatrix = u_viewMatrix * modelMatrix;
+#else
+    mat4 modelMatrix = u_modelMatrix;
+    mat4 modelMatrixIT = u_modelMatrixIT;
+    mat4 modelViewMatrix = u_modelViewMatrix;
+#endif
+
+    vec3 position = inPosition;
+    vec3 normal = inNormal;
+    vec3 tangent = inTangent;
+    vec3 bitangent = inBitangent;
+
+#ifdef USE_SKINNING
+    // Weighted bone palette blend, applied in mesh space before the model matrix
+    mat4 skinMatrix = inBoneWeights.x * u_bonePalette[int(inBoneIndices.x)]
+                    + inBoneWeights.y * u_bonePalette[int(inBoneIndices.y)]
+                    + inBoneWeights.z * u_bonePalette[int(inBoneIndices.z)]
+                    + inBoneWeights.w * u_bonePalette[int(inBoneIndices.w)];
+    position = (skinMatrix * vec4(position, 1.0)).xyz;
+    normal = (skinMatrix * vec4(normal, 0.0)).xyz;
+    tangent = (skinMatrix * vec4(tangent, 0.0)).xyz;
+    bitangent = (skinMatrix * vec4(bitangent, 0.0)).xyz;
+#endif
+
+    vec4 worldPosition = modelMatrix * vec4(position, 1.0);
+
+#ifdef USE_STEREO_SINGLE_PASS
+    // Instances are duplicated per eye; parity selects the viewport and the eye matrices
+    const int eye = gl_InstanceID & 1;
+    gl_ViewportIndex = eye;
+    gl_Position = u_viewProjMatrixStereo[eye] * worldPosition;
+    v_view_space_position = (u_viewMatrixStereo[eye] * worldPosition).xyz;
+#else
     gl_Position = u_viewProjMatrix * worldPosition;
-    v_view_space_position = (u_modelViewMatrix * vec4(inPosition, 1.0)).xyz;
-    v_normal = normalize((u_modelMatrixIT * vec4(inNormal, 0)).xyz);
+    v_view_space_position = (modelViewMatrix * vec4(position, 1.0)).xyz;
+#endif
+
+    v_normal = normalize((modelMatrixIT * vec4(normal, 0)).xyz);
     v_world_position = worldPosition.xyz;
     v_texcoord = inTexCoord * u_texCoordScale;
-    v_tangent = (u_modelMatrixIT * vec4(inTangent, 0)).xyz;
-    v_bitangent = (u_modelMatrixIT * vec4(inBitangent, 0)).xyz;
+    v_tangent = (modelMatrixIT * vec4(tangent, 0)).xyz;
+    v_bitangent = (modelMatrixIT * vec4(bitangent, 0)).xyz;
     v_color = inColor;
 }
\ No newline at end of file
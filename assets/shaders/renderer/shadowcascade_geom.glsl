@@ -5,13 +5,16 @@ layout(triangle_strip, max_vertices = 3) out;
 
 uniform mat4 u_cascadeViewMatrixArray[NUM_CASCADES];
 uniform mat4 u_cascadeProjMatrixArray[NUM_CASCADES];
+uniform int u_cascadeMask = 0xF; // round-robin refresh: skip cascades held over from a previous frame
 
 out float g_layer;
 out vec3 vs_position;
 
-void main() 
+void main()
 {
-    for (int i = 0; i < gl_in.length(); ++i) 
+    if ((u_cascadeMask & (1 << gl_InvocationID)) == 0) return;
+
+    for (int i = 0; i < gl_in.length(); ++i)
     {
         vec4 pos = (u_cascadeViewMatrixArray[gl_InvocationID] * gl_in[i].gl_Position);
         gl_Position = u_cascadeProjMatrixArray[gl_InvocationID] * pos;
@@ -8,11 +8,35 @@
 #include "gl-api.hpp"
 #include "geometry.hpp"
 #include "logging.hpp"
-#include <unordered_map>
+#include "ecs/typeid.hpp"
+#include "flat_hash_map.hpp"
+#include <assert.h>
 
 namespace polymer
 {
 
+    //////////////////
+    //   asset_id   //
+    //////////////////
+
+    // Interned 64-bit identifier for an asset name. The FNV-1a hash is computed
+    // once when a handle is constructed, so table lookups on the per-frame path
+    // (mesh/material resolution during draw submission) compare a single integer
+    // instead of hashing and comparing a std::string every get(). The original
+    // name is retained on the stored asset for listing, serialization and debug
+    // collision checks.
+    struct asset_id
+    {
+        uint64_t value{ 0 };
+        asset_id() = default;
+        explicit asset_id(const std::string & name) : value(hash(name.c_str(), name.size())) {}
+        bool operator == (const asset_id & r) const { return value == r.value; }
+        bool operator != (const asset_id & r) const { return value != r.value; }
+    };
+
+    // The id is already a well-mixed hash; feed it through unchanged.
+    struct asset_id_hash { size_t operator()(const asset_id & id) const { return static_cast<size_t>(id.value); } };
+
     // Note that the asset of `polymer_unique_asset` must be default constructable.
     template<typename T>
     struct polymer_unique_asset : public non_copyable
@@ -20,6 +44,7 @@ namespace polymer
         T asset;
         bool assigned{ false };
         uint64_t timestamp;
+        std::string name; // reverse mapping from the interned id, set on first intern
     };
 
     // An asset handle contains static table of string <=> asset mappings. Although unique assets
@@ -30,14 +55,17 @@ namespace polymer
     template<typename T>
     class asset_handle
     {
-        static std::unordered_map<std::string, std::shared_ptr<polymer_unique_asset<T>>> table;
+        static flat_hash_map<asset_id, std::shared_ptr<polymer_unique_asset<T>>, asset_id_hash> table;
+        static uint32_t resolution_budget;   // table probes get_or() may spend per frame, across all handles of this type
+        static uint32_t resolution_attempts; // probes spent since begin_resolution_frame()
         mutable std::shared_ptr<polymer_unique_asset<T>> handle{ nullptr };
         // Private constructor for the static list() method below.
-        asset_handle(const::std::string & id, std::shared_ptr<polymer_unique_asset<T>> h) : name(id), handle(h) {}
+        asset_handle(const::std::string & asset_name, std::shared_ptr<polymer_unique_asset<T>> h) : name(asset_name), id(asset_name), handle(h) {}
 
     public:
 
         std::string name;
+        asset_id id; // interned hash of `name`, computed once here and used for all table lookups
 
         asset_handle() : asset_handle("") {}
         asset_handle(const std::string & asset_id, T && asset) : asset_handle(asset_id.c_str()) { assign(std::move(asset)); }
@@ -46,12 +74,14 @@ namespace polymer
         {
             name = asset_id;
             if (name.empty()) { name = "empty"; }
+            id = polymer::asset_id(name);
         }
 
         asset_handle(const asset_handle & r)
         {
             handle = r.handle;
             name = r.name;
+            id = r.id;
         }
 
         // Return reference to underlying resource. 
@@ -66,7 +96,7 @@ namespace polymer
             else
             {
                 // If not, this is a virgin handle and we should lookup from the static table.
-                auto & a = table[name];
+                auto & a = table[id];
 
                 // If there's no loaded asset in the table for this identifier, default construct one. 
                 // This behavior might be changed in the future. Previously we were throwing a runtime_exception,
@@ -78,24 +108,60 @@ namespace polymer
                     a = std::make_shared<polymer_unique_asset<T>>();
                     a->timestamp = system_time_ns();
                     a->assigned = false;
+                    a->name = name;
                     log::get()->engine_log->info("asset type {} ({}) was default constructed", typeid(T).name(), name);
                 }
+                assert(a->name == name); // distinct names hashing to the same asset_id would silently alias
                 handle = a;
 
                 return handle->asset;
             }
         }
 
+        // Residency-aware resolution for the draw-submission path. Returns the
+        // real asset once it is assigned; until then it serves `fallback` without
+        // default constructing a table entry or logging. A handle whose table
+        // entry does not exist yet (the loader has not landed) would otherwise
+        // re-probe the table every call, so unresolved probes are rationed by the
+        // per-frame resolution budget - once the budget is spent, remaining
+        // unresolved handles go straight to the fallback until the next frame.
+        // Once a probe finds the entry, assignment is observed through the shared
+        // state with no further lookups.
+        T & get_or(const asset_handle & fallback) const
+        {
+            if (handle) return handle->assigned ? handle->asset : fallback.get();
+
+            if (resolution_attempts < resolution_budget)
+            {
+                ++resolution_attempts;
+                auto itr = table.find(id);
+                if (itr != table.end())
+                {
+                    assert(itr->second->name == name); // distinct names hashing to the same asset_id would silently alias
+                    handle = itr->second;
+                    return handle->assigned ? handle->asset : fallback.get();
+                }
+            }
+
+            return fallback.get();
+        }
+
+        // Call once per frame (the renderer does this at the top of render_frame)
+        static void begin_resolution_frame() { resolution_attempts = 0; }
+        static void set_resolution_budget(const uint32_t attempts_per_frame) { resolution_budget = attempts_per_frame; }
+
         T & assign(T && asset)
         {
-            auto & a = table[name];
+            auto & a = table[id];
 
             // New asset
             if (!a)
             {
                 a = std::make_shared<polymer_unique_asset<T>>();
                 a->timestamp = system_time_ns();
+                a->name = name;
             }
+            assert(a->name == name);
 
             handle = a;
             handle->asset = std::move(asset);
@@ -112,7 +178,7 @@ namespace polymer
             if (handle && handle->assigned) return true;
 
             // Search for it, but don't default construct
-            auto itr = table.find(name);
+            auto itr = table.find(id);
             if (itr != table.end())
             {
                 handle = itr->second;
@@ -127,17 +193,17 @@ namespace polymer
             std::vector<asset_handle> results;
             for (const auto & a : table)
             {
-                results.push_back(asset_handle<T>(a.first, a.second));
+                results.push_back(asset_handle<T>(a.second->name, a.second));
             }
             return results;
         }
 
         static bool destroy(const std::string & asset_id)
         {
-            auto iter = table.find(asset_id);
+            auto iter = table.find(polymer::asset_id(asset_id));
             if (iter != table.end())
             {
-                log::get()->engine_log->info("asset type {} with id {} was destroyed", typeid(T).name(), iter->first);
+                log::get()->engine_log->info("asset type {} with id {} was destroyed", typeid(T).name(), iter->second->name);
                 table.erase(iter);
                 return true;
             }
@@ -146,7 +212,10 @@ namespace polymer
     };
 
     template<class T>
-    std::unordered_map<std::string, std::shared_ptr<polymer_unique_asset<T>>> asset_handle<T>::table;
+    flat_hash_map<asset_id, std::shared_ptr<polymer_unique_asset<T>>, asset_id_hash> asset_handle<T>::table;
+
+    template<class T> uint32_t asset_handle<T>::resolution_budget{ 64 };
+    template<class T> uint32_t asset_handle<T>::resolution_attempts{ 0 };
 
 } // end namespace polymer
 
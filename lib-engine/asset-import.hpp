@@ -5,6 +5,7 @@
 
 #include "environment.hpp"
 #include "asset-resolver.hpp"
+#include "gfx/gl/gl-texture-transcode.hpp"
 
 namespace polymer
 {
@@ -48,10 +49,19 @@ namespace polymer
         const std::string ext = get_extension(path);
         const std::string name_no_ext = get_filename_without_extension(path);
 
-        // Handle image/texture types. No entities are directly created.
+        // Handle compressed texture containers: block payloads upload directly,
+        // no CPU decode. No entities are directly created.
+        if (ext == "dds" || ext == "ktx")
+        {
+            create_handle_for_asset(name_no_ext.c_str(), load_compressed_texture(path));
+            return {};
+        }
+
+        // Handle image/texture types, transcoding to a cached block-compressed
+        // DDS on first import. No entities are directly created.
         if (ext == "png" || ext == "tga" || ext == "jpg")
         {
-            create_handle_for_asset(name_no_ext.c_str(), load_image(path, false));
+            create_handle_for_asset(name_no_ext.c_str(), load_texture_cached(path));
             return {};
         }
 
@@ -67,11 +77,37 @@ namespace polymer
 
             const std::string handle_id = name_no_ext + "/" + m.first;
 
+            // Heavy meshes get an automatic decimation chain, persisted beside the
+            // source (*_lod<N>.mesh) so re-importing loads instead of re-simplifying
+            std::vector<std::string> lod_handles;
+            if (mesh.faces.size() >= 65536)
+            {
+                const std::string lod_base = path.substr(0, path.find_last_of('.')) + (num_models > 1 ? "_" + m.first : "");
+                std::vector<runtime_mesh> lod_meshes = generate_mesh_lods(lod_base, mesh, true);
+                for (size_t i = 0; i < lod_meshes.size(); ++i)
+                {
+                    const std::string lod_id = handle_id + "_lod" + std::to_string(i + 1);
+                    create_handle_for_asset(lod_id.c_str(), make_mesh_from_geometry(lod_meshes[i]));
+                    lod_handles.push_back(lod_id);
+                }
+            }
+
             create_handle_for_asset(handle_id.c_str(), make_mesh_from_geometry(mesh));
             create_handle_for_asset(handle_id.c_str(), std::move(mesh));
 
-            if (num_models == 1) created_entities.push_back(create_model(handle_id, handle_id, env, orch));
-            else children.push_back(create_model(handle_id, handle_id, env, orch));
+            const entity e = create_model(handle_id, handle_id, env, orch);
+
+            if (!lod_handles.empty())
+            {
+                polymer::lod_component model_lod(e);
+                model_lod.lod1 = gpu_mesh_handle(lod_handles[0]);
+                if (lod_handles.size() > 1) model_lod.lod2 = gpu_mesh_handle(lod_handles[1]);
+                if (lod_handles.size() > 2) model_lod.lod3 = gpu_mesh_handle(lod_handles[2]);
+                env.render_system->create(e, std::move(model_lod));
+            }
+
+            if (num_models == 1) created_entities.push_back(e);
+            else children.push_back(e);
         }
 
         if (children.size())
@@ -0,0 +1,242 @@
+#pragma once
+
+#ifndef polymer_asset_loader_hpp
+#define polymer_asset_loader_hpp
+
+#include "asset-handle-utils.hpp"
+#include "gl-loaders.hpp"
+#include "gl-mesh-util.hpp"
+#include "queue-mpsc-bounded.hpp"
+#include "thread-pool.hpp"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace polymer
+{
+    //////////////////////////
+    //   gl_asset_loader    //
+    //////////////////////////
+
+    // Asynchronous asset pipeline. File IO and decode (stb_image, mesh import)
+    // run on thread-pool workers; the decoded bytes are handed to the GL thread
+    // through bounded lock-free queues. update() must be called once per frame
+    // from the thread that owns the GL context - it uploads a budgeted number of
+    // bytes per frame through a streaming pixel-unpack buffer, so importing a
+    // folder of 4k textures amortizes across frames instead of stalling one.
+    // Because asset_handles resolve lazily, entities and materials may reference
+    // an in-flight asset immediately; they observe the default-constructed asset
+    // until its upload lands, at which point the shared table entry is assigned.
+    class gl_asset_loader
+    {
+        struct decoded_texture
+        {
+            std::string handle_id;
+            std::vector<uint8_t> pixels;
+            std::vector<std::vector<uint8_t>> mips; // worker-generated chain; empty falls back to driver mips
+            int32_t width{ 0 }, height{ 0 }, channels{ 0 };
+        };
+
+        struct decoded_geometry
+        {
+            std::string handle_id;
+            geometry geom;
+            bool make_gpu_mesh{ true };
+        };
+
+        // shared_ptr payloads keep the (potentially large) decode results off the
+        // queue's inline storage; the ring only shuffles pointers.
+        mpsc_queue_bounded<std::shared_ptr<decoded_texture>, 1024> texture_queue;
+        mpsc_queue_bounded<std::shared_ptr<decoded_geometry>, 1024> geometry_queue;
+
+        std::atomic<int32_t> in_flight{ 0 };
+
+        gl_buffer staging_pbo; // streaming pixel-unpack buffer, orphaned per upload
+        size_t upload_budget_bytes{ 32 * 1024 * 1024 };
+
+        void upload_texture(decoded_texture & t)
+        {
+            GLenum format{ 0 };
+            GLenum type{ GL_UNSIGNED_BYTE };
+            switch (t.channels)
+            {
+                case 1: format = GL_RED; break;
+                case 2: format = GL_RED; type = GL_UNSIGNED_SHORT; break;
+                case 3: format = GL_RGB; break;
+                case 4: format = GL_RGBA; break;
+                default: log::get()->engine_log->error("[gl_asset_loader] {} has an unsupported number of channels ({})", t.handle_id, t.channels); return;
+            }
+
+            // Stage through the pixel-unpack buffer. GL_STREAM_DRAW re-specification
+            // orphans the previous frame's staging memory, so the driver can overlap
+            // the transfer with rendering instead of blocking on it.
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging_pbo);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(t.pixels.size()), t.pixels.data(), GL_STREAM_DRAW);
+
+            gl_texture_2d tex;
+            tex.setup(t.width, t.height, format, format, type, nullptr, t.mips.empty()); // null pointer == offset 0 into the bound PBO
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            // Lower levels were filtered on the worker that decoded the image, so the
+            // GL thread only pays for the uploads - no glGenerateMipmap stall here
+            if (!t.mips.empty()) upload_cpu_mips(tex, t.mips, t.width, t.height, format, format, type);
+
+            glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+            create_handle_for_asset(t.handle_id.c_str(), std::move(tex));
+        }
+
+        void upload_geometry(decoded_geometry & d)
+        {
+            if (d.make_gpu_mesh) create_handle_for_asset(d.handle_id.c_str(), make_mesh_from_geometry(d.geom));
+            create_handle_for_asset(d.handle_id.c_str(), std::move(d.geom));
+        }
+
+        static size_t approximate_geometry_bytes(const geometry & g)
+        {
+            return g.vertices.size() * sizeof(float3)
+                 + g.normals.size() * sizeof(float3)
+                 + g.colors.size() * sizeof(float4)
+                 + g.texcoord0.size() * sizeof(float2)
+                 + g.faces.size() * sizeof(uint3);
+        }
+
+        gl_asset_loader(const gl_asset_loader &) = delete;
+        gl_asset_loader & operator = (const gl_asset_loader &) = delete;
+
+    public:
+
+        gl_asset_loader() = default;
+
+        void set_upload_budget_bytes(const size_t bytes) { upload_budget_bytes = bytes; }
+
+        // Number of assets decoded or decoding but not yet uploaded.
+        int32_t pending() const { return in_flight.load(); }
+
+        // Decodes the image at |path| on a worker, generates its mip chain there, and
+        // queues the levels for upload under the given handle id. |srgb| filters the
+        // chain in linear space - right for color maps, wrong for normal maps and
+        // masks. Safe to call from any thread.
+        void load_texture_async(const std::string & handle_id, const std::string & path, const bool flip = false, const bool srgb = true)
+        {
+            ++in_flight;
+            get_task_scheduler().submit([this, handle_id, path, flip, srgb]()
+            {
+                auto result = std::make_shared<decoded_texture>();
+                result->handle_id = handle_id;
+
+                try
+                {
+                    mapped_file binaryFile(path);
+
+                    // stbi_load_from_memory is re-entrant but the global vertical-flip
+                    // flag is not, so flipping is done on our copy after decode.
+                    int width, height, nBytes;
+                    stbi_uc * data = stbi_load_from_memory(binaryFile.data(), (int) binaryFile.size(), &width, &height, &nBytes, 0);
+                    if (!data)
+                    {
+                        log::get()->engine_log->error("[gl_asset_loader] failed to decode {}", path);
+                        --in_flight;
+                        return;
+                    }
+
+                    result->width = width;
+                    result->height = height;
+                    result->channels = nBytes;
+                    result->pixels.assign(data, data + (size_t(width) * size_t(height) * size_t(nBytes)));
+                    stbi_image_free(data);
+
+                    if (flip) flip_image_inplace(result->pixels.data(), width, height, nBytes);
+
+                    // Mip filtering happens here on the worker (rows fanned out through
+                    // parallel_for), overlapping other decodes and the GL thread's
+                    // uploads; the 16-bit two-channel path keeps driver mips.
+                    if (nBytes != 2) result->mips = generate_cpu_mips(result->pixels.data(), width, height, nBytes, srgb);
+                }
+                catch (const std::exception & e)
+                {
+                    log::get()->engine_log->error("[gl_asset_loader] failed to load {}: {}", path, e.what());
+                    --in_flight;
+                    return;
+                }
+
+                // Bounded queue provides backpressure if the GL thread falls behind
+                while (!texture_queue.emplace_back(result)) std::this_thread::yield();
+            });
+        }
+
+        // Runs |decode| (any callable returning a `geometry`) on a worker and queues
+        // the result for handle creation. Mesh importers plug in here so file parsing
+        // never happens on the render thread. Safe to call from any thread.
+        template <typename DecodeFn>
+        void load_geometry_async(const std::string & handle_id, DecodeFn && decode, const bool make_gpu_mesh = true)
+        {
+            ++in_flight;
+            auto fn = std::make_shared<typename std::decay<DecodeFn>::type>(std::forward<DecodeFn>(decode));
+            get_task_scheduler().submit([this, handle_id, fn, make_gpu_mesh]()
+            {
+                auto result = std::make_shared<decoded_geometry>();
+                result->handle_id = handle_id;
+                result->make_gpu_mesh = make_gpu_mesh;
+
+                try
+                {
+                    result->geom = (*fn)();
+                }
+                catch (const std::exception & e)
+                {
+                    log::get()->engine_log->error("[gl_asset_loader] failed to decode geometry {}: {}", handle_id, e.what());
+                    --in_flight;
+                    return;
+                }
+
+                while (!geometry_queue.emplace_back(result)) std::this_thread::yield();
+            });
+        }
+
+        // Drains the upload queues until the per-frame byte budget is spent, or until the
+        // optional `out_of_time` predicate reports the caller's time slice is exhausted
+        // (checked between uploads, so a frame budget scheduler can throttle this system).
+        // Must be called from the GL thread. At least one pending asset is uploaded per
+        // call so progress is guaranteed even with a tiny budget. Returns uploads performed.
+        uint32_t update(const std::function<bool()> & out_of_time = {})
+        {
+            uint32_t uploaded = 0;
+            size_t bytes_this_frame = 0;
+
+            while (bytes_this_frame < upload_budget_bytes)
+            {
+                if (uploaded && out_of_time && out_of_time()) return uploaded;
+
+                auto tex = texture_queue.pop_front();
+                if (!tex.first) break;
+
+                bytes_this_frame += tex.second->pixels.size();
+                for (const auto & mip : tex.second->mips) bytes_this_frame += mip.size();
+                upload_texture(*tex.second);
+                --in_flight;
+                ++uploaded;
+            }
+
+            while (bytes_this_frame < upload_budget_bytes)
+            {
+                if (uploaded && out_of_time && out_of_time()) return uploaded;
+
+                auto geo = geometry_queue.pop_front();
+                if (!geo.first) break;
+
+                bytes_this_frame += approximate_geometry_bytes(geo.second->geom);
+                upload_geometry(*geo.second);
+                --in_flight;
+                ++uploaded;
+            }
+
+            return uploaded;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_asset_loader_hpp
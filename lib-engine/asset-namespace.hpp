@@ -0,0 +1,99 @@
+/*
+ * File: lib-engine/asset-namespace.hpp
+ * The asset_handle<T> tables are global statics: every environment interns into the
+ * same store, which is exactly what makes shared immutable GPU resources work (two
+ * scenes referencing "marble_floor" hit one gl_texture_2d, deduplicated by the
+ * interned name hash). What the global tables cannot answer is ownership - which
+ * environment loaded what, and when an entry is safe to destroy. An asset_namespace
+ * records the names an environment resolved and keeps a registry-wide reference
+ * count per (type, id); releasing a namespace destroys only the table entries no
+ * other live namespace still claims. This is what allows a second environment to be
+ * preloaded in the background and swapped in by flipping a pointer: shared assets
+ * survive the old scene's teardown, exclusive ones are reclaimed.
+ */
+
+#pragma once
+
+#ifndef polymer_asset_namespace_hpp
+#define polymer_asset_namespace_hpp
+
+#include "asset-handle.hpp"
+#include "asset-handle-utils.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace polymer
+{
+
+    // Registry-wide claim counts for one asset type, shared by all live namespaces
+    template<typename T>
+    class asset_namespace_registry
+    {
+        static flat_hash_map<asset_id, uint32_t, asset_id_hash> counts;
+
+    public:
+
+        static void claim(const asset_id & id) { counts[id]++; }
+
+        // Destroys the table entry when the last claim is dropped. Names never claimed
+        // by any namespace (app-lifetime assets like debug meshes) are left untouched.
+        static void release(const std::string & name)
+        {
+            const asset_id id(name);
+            auto iter = counts.find(id);
+            if (iter == counts.end()) return;
+            if (--iter->second == 0)
+            {
+                counts.erase(iter);
+                asset_handle<T>::destroy(name);
+            }
+        }
+    };
+
+    template<typename T>
+    flat_hash_map<asset_id, uint32_t, asset_id_hash> asset_namespace_registry<T>::counts;
+
+    class asset_namespace : public non_copyable
+    {
+        struct claim_record
+        {
+            std::string name;
+            void (* release_fn)(const std::string &); // type-erased registry release
+        };
+
+        std::vector<claim_record> claims;
+        std::unordered_map<poly_typeid, std::unordered_set<std::string>> claimed; // per-type dedup
+
+    public:
+
+        asset_namespace() = default;
+        ~asset_namespace() { release_all(); }
+
+        // Records that this namespace references `name`. Claiming the same name twice
+        // from one namespace is a no-op; claims from different namespaces stack.
+        template<typename T>
+        void claim(const std::string & name)
+        {
+            if (name.empty() || name == "empty") return;
+            if (!claimed[get_typeid<T>()].insert(name).second) return;
+            asset_namespace_registry<T>::claim(asset_id(name));
+            claims.push_back({ name, [](const std::string & n) { asset_namespace_registry<T>::release(n); } });
+        }
+
+        // Drops every claim this namespace holds, destroying table entries whose
+        // count reaches zero. Idempotent; also run by the destructor, so an
+        // environment going out of scope reclaims exactly its exclusive assets.
+        void release_all()
+        {
+            for (auto & c : claims) c.release_fn(c.name);
+            claims.clear();
+            claimed.clear();
+        }
+
+        size_t claim_count() const { return claims.size(); }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_asset_namespace_hpp
@@ -22,6 +22,7 @@
 
 #include "asset-handle.hpp"
 #include "asset-handle-utils.hpp"
+#include "file_watcher.hpp"
 #include "string_utils.hpp"
 #include "renderer-pbr.hpp"
 #include "system-collision.hpp"
@@ -31,6 +32,8 @@
 #include "../lib-model-io/model-io.hpp"
 #include "json.hpp"
 
+#include <chrono>
+
 namespace polymer
 {
 
@@ -60,73 +63,205 @@ namespace polymer
         std::vector<std::string> material_names;
         std::vector<std::string> texture_names;
 
-        // fixme - what to do if we find multiples? 
-        void walk_directory(path root)
+        // Watches the asset directory after the first resolve so that files
+        // created or modified later are matched incrementally via update().
+        std::unique_ptr<file_watcher> watcher;
+
+        // Kept from resolve() so that texture (re)loads can invalidate any
+        // material command lists baked against the old gl texture.
+        material_library * library{ nullptr };
+
+        // Matches a single file on disk against the unresolved handle names
+        // fixme - what to do if we find multiples?
+        // `skip_assigned` is set during the initial walk so that preloading a second
+        // environment reuses assets an earlier resolve already uploaded (dedup through
+        // the shared handle tables); watcher-driven reloads pass false so hot-reload
+        // still replaces assigned entries.
+        void resolve_file(const std::string & file_path, const bool skip_assigned = false)
         {
-            scoped_timer t("load + resolve");
+            std::string path = file_path;
+            for (auto & chr : path) if (chr == '\\') chr = '/';
 
-            for (auto & entry : recursive_directory_iterator(root))
-            {
-                const size_t root_len = root.string().length(), ext_len = entry.path().extension().string().length();
-                auto path = entry.path().string(), name = path.substr(root_len + 1, path.size() - root_len - ext_len - 1);
-                for (auto & chr : path) if (chr == '\\') chr = '/';
-
-                std::string ext = get_extension(path);
-                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            std::string ext = get_extension(path);
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
-                std::string filename_no_ext = get_filename_without_extension(path);
-                std::transform(filename_no_ext.begin(), filename_no_ext.end(), filename_no_ext.begin(), ::tolower);
+            std::string filename_no_ext = get_filename_without_extension(path);
+            std::transform(filename_no_ext.begin(), filename_no_ext.end(), filename_no_ext.begin(), ::tolower);
 
-                if (ext == "png" || ext == "tga" || ext == "jpg" || ext == "jpeg")
+            if (ext == "png" || ext == "tga" || ext == "jpg" || ext == "jpeg")
+            {
+                for (const auto & name : texture_names)
                 {
-                    for (const auto & name : texture_names)
+                    if (name == filename_no_ext)
                     {
-                        if (name == filename_no_ext)
+                        if (skip_assigned && texture_handle(name).assigned()) continue;
+
+                        create_handle_for_asset(name.c_str(), load_image(path, false));
+                        log::get()->engine_log->info("resolved {} ({})", name, typeid(gl_texture_2d).name());
+
+                        // The handle now points at a new gl texture, so baked
+                        // material bindings referencing the old one are stale
+                        if (library)
                         {
-                            create_handle_for_asset(name.c_str(), load_image(path, false));
-                            log::get()->engine_log->info("resolved {} ({})", name, typeid(gl_texture_2d).name());
+                            for (auto & mat : library->instances) mat.second->invalidate_command_lists();
                         }
                     }
                 }
-                else if (ext == "obj" || ext == "fbx")
+            }
+            else if (ext == "obj" || ext == "fbx")
+            {
+                // Name could either be something like "my_mesh" or "my_mesh/sub_component"
+                // `mesh_names` contains both CPU and GPU geometry handle ids
+                for (const auto & name : mesh_names)
                 {
-                    // Name could either be something like "my_mesh" or "my_mesh/sub_component"
-                    // `mesh_names` contains both CPU and GPU geometry handle ids
-                    for (const auto & name : mesh_names)
+                    std::cout << "Looking for: " << name << std::endl;
+
+                    // "my_mesh/sub_component" should match to "my_mesh.obj" or similar
+                    if (find_root(name) == filename_no_ext)
                     {
-                        std::cout << "Looking for: " << name << std::endl;
+                        if (skip_assigned && gpu_mesh_handle(name).assigned() && cpu_mesh_handle(name).assigned()) continue;
 
-                        // "my_mesh/sub_component" should match to "my_mesh.obj" or similar
-                        if (find_root(name) == filename_no_ext)
-                        {
-                            std::unordered_map<std::string, runtime_mesh> imported_models = import_model(path);
+                        std::unordered_map<std::string, runtime_mesh> imported_models = import_model(path);
 
-                            for (auto & m : imported_models)
-                            {
-                                auto & mesh = m.second;
-                                rescale_geometry(mesh, 1.f);
+                        for (auto & m : imported_models)
+                        {
+                            auto & mesh = m.second;
+                            rescale_geometry(mesh, 1.f);
 
-                                const std::string handle_id = filename_no_ext + "/" + m.first;
+                            const std::string handle_id = filename_no_ext + "/" + m.first;
 
-                                create_handle_for_asset(handle_id.c_str(), make_mesh_from_geometry(mesh));
-                                create_handle_for_asset(handle_id.c_str(), std::move(mesh));
+                            // Packed attributes: scene meshes are static and dominate
+                            // vertex fetch, and the formats decode transparently
+                            create_handle_for_asset(handle_id.c_str(), make_mesh_from_geometry_packed(mesh));
+                            create_handle_for_asset(handle_id.c_str(), std::move(mesh));
 
-                                log::get()->engine_log->info("resolved {} ({})", handle_id, typeid(gl_mesh).name());
-                            }
+                            log::get()->engine_log->info("resolved {} ({})", handle_id, typeid(gl_mesh).name());
                         }
                     }
                 }
             }
         }
 
-    public:
+        void walk_directory(path root)
+        {
+            scoped_timer t("load + resolve");
 
-        void resolve(const std::string & asset_dir, environment * scene, material_library * library)
+            for (auto & entry : recursive_directory_iterator(root))
+            {
+                resolve_file(entry.path().string(), true);
+            }
+        }
+
+        // Deferred work built by resolve_incremental(): files matched against the
+        // unresolved names, ordered nearest-referencing-entity first
+        struct pending_resolve
         {
-            assert(scene != nullptr);
-            assert(library != nullptr);
-            assert(asset_dir.size() > 1);
+            std::string path;
+            float priority;
+        };
+        std::vector<pending_resolve> pending;
+
+        // Nearest-referencing-entity distance for every unresolved handle name. Mesh
+        // names take the distance of the entities that carry them; texture and shader
+        // names inherit the best distance among the materials that use them.
+        std::unordered_map<std::string, float> compute_name_priorities(environment * scene, material_library * library, const float3 & viewpoint)
+        {
+            std::unordered_map<std::string, float> priorities;
+
+            auto consider = [&priorities](const std::string & name, const float d)
+            {
+                auto it = priorities.find(name);
+                if (it == priorities.end() || d < it->second) priorities[name] = d;
+            };
+
+            auto entity_distance = [&](const entity e) -> float
+            {
+                if (const auto * wt = scene->xform_system->get_world_transform(e)) return distance(viewpoint, wt->world_pose.position);
+                return std::numeric_limits<float>::max();
+            };
+
+            for (auto & m : scene->render_system->meshes) consider(m.second.mesh.name, entity_distance(m.first));
+            for (auto & m : scene->collision_system->meshes) consider(m.second.geom.name, entity_distance(m.first));
+            for (auto & m : scene->render_system->lods)
+            {
+                const float d = entity_distance(m.first);
+                consider(m.second.lod1.name, d);
+                consider(m.second.lod2.name, d);
+                consider(m.second.lod3.name, d);
+            }
+
+            std::unordered_map<std::string, float> materialDistance;
+            for (auto & m : scene->render_system->materials)
+            {
+                const float d = entity_distance(m.first);
+                auto it = materialDistance.find(m.second.material.name);
+                if (it == materialDistance.end() || d < it->second) materialDistance[m.second.material.name] = d;
+            }
+
+            for (auto & mat : library->instances)
+            {
+                const auto found = materialDistance.find(mat.first);
+                const float d = (found != materialDistance.end()) ? found->second : std::numeric_limits<float>::max();
+
+                if (auto * pbr = dynamic_cast<polymer_pbr_standard*>(mat.second.get()))
+                {
+                    consider(pbr->albedo.name, d);
+                    consider(pbr->normal.name, d);
+                    consider(pbr->metallic.name, d);
+                    consider(pbr->roughness.name, d);
+                    consider(pbr->emissive.name, d);
+                    consider(pbr->height.name, d);
+                    consider(pbr->occlusion.name, d);
+                }
+
+                if (auto * phong = dynamic_cast<polymer_blinn_phong_standard*>(mat.second.get()))
+                {
+                    consider(phong->diffuse.name, d);
+                    consider(phong->normal.name, d);
+                }
+            }
+
+            return priorities;
+        }
+
+        // Best (smallest) priority among the unresolved names this file could match,
+        // using the same matching rules as resolve_file; negative for files with an
+        // extension resolve_file would never consume (those are not queued at all).
+        float file_priority(const std::string & file_path, const std::unordered_map<std::string, float> & name_priorities) const
+        {
+            std::string path = file_path;
+            for (auto & chr : path) if (chr == '\\') chr = '/';
 
+            std::string ext = get_extension(path);
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+            std::string filename_no_ext = get_filename_without_extension(path);
+            std::transform(filename_no_ext.begin(), filename_no_ext.end(), filename_no_ext.begin(), ::tolower);
+
+            float best = std::numeric_limits<float>::max();
+
+            if (ext == "png" || ext == "tga" || ext == "jpg" || ext == "jpeg")
+            {
+                const auto it = name_priorities.find(filename_no_ext);
+                if (it != name_priorities.end()) best = it->second;
+            }
+            else if (ext == "obj" || ext == "fbx")
+            {
+                for (const auto & name : mesh_names)
+                {
+                    if (find_root(name) != filename_no_ext) continue;
+                    const auto it = name_priorities.find(name);
+                    if (it != name_priorities.end()) best = std::min(best, it->second);
+                }
+            }
+            else return -1.f;
+
+            return best;
+        }
+
+        // Name gathering + asset claims shared by both resolve entry points
+        void gather_unresolved(environment * scene, material_library * library)
+        {
             // Material Names
             for (auto & m : scene->render_system->materials)
                 material_names.push_back(m.second.material.name);
@@ -135,6 +270,14 @@ namespace polymer
             for (auto & m : scene->render_system->meshes)
                 mesh_names.push_back(m.second.mesh.name);
 
+            // GPU LOD chains
+            for (auto & m : scene->render_system->lods)
+            {
+                mesh_names.push_back(m.second.lod1.name);
+                mesh_names.push_back(m.second.lod2.name);
+                mesh_names.push_back(m.second.lod3.name);
+            }
+
             // CPU Geometry (same list as GPU)
             for (auto & m : scene->collision_system->meshes)
                 mesh_names.push_back(m.second.geom.name);
@@ -142,6 +285,11 @@ namespace polymer
             remove_duplicates(material_names);
             remove_duplicates(mesh_names);
 
+            // Materials deserialize lazily: only the names actually referenced by a
+            // material_component are instantiated here, so only those go on to pull
+            // their shader and texture handles below.
+            for (const auto & name : material_names) library->instantiate(name);
+
             for (auto & mat : library->instances)
             {
                 if (auto * pbr = dynamic_cast<polymer_pbr_standard*>(mat.second.get()))
@@ -169,8 +317,91 @@ namespace polymer
             remove_duplicates(shader_names);
             remove_duplicates(texture_names);
 
+            // Register this environment's claims on the shared tables. Claims are
+            // refcounted across environments, so tearing this scene down later only
+            // destroys assets no other live scene references.
+            for (const auto & name : texture_names) scene->assets.claim<gl_texture_2d>(name);
+            for (const auto & name : mesh_names)
+            {
+                scene->assets.claim<gl_mesh>(name);
+                scene->assets.claim<geometry>(name);
+            }
+        }
+
+    public:
+
+        void resolve(const std::string & asset_dir, environment * scene, material_library * library)
+        {
+            assert(scene != nullptr);
+            assert(library != nullptr);
+            assert(asset_dir.size() > 1);
+
+            this->library = library;
+
+            gather_unresolved(scene, library);
             walk_directory(asset_dir);
+
+            // Subsequent changes under the asset directory are picked up
+            // incrementally rather than by re-walking the tree.
+            if (!watcher) watcher.reset(new file_watcher(asset_dir));
         }
+
+        // Incremental alternative to resolve(): indexes the tree without loading
+        // anything and queues each matching file keyed by the camera distance of the
+        // nearest entity that references it. The visible set then resolves during the
+        // first few update() budgets and distant assets trickle in behind it, instead
+        // of the whole directory loading synchronously before the first frame.
+        void resolve_incremental(const std::string & asset_dir, environment * scene, material_library * library, const float3 & viewpoint)
+        {
+            assert(scene != nullptr);
+            assert(library != nullptr);
+            assert(asset_dir.size() > 1);
+
+            this->library = library;
+
+            gather_unresolved(scene, library);
+
+            const auto priorities = compute_name_priorities(scene, library, viewpoint);
+
+            pending.clear();
+            for (auto & entry : recursive_directory_iterator(path(asset_dir)))
+            {
+                const std::string file = entry.path().string();
+                const float p = file_priority(file, priorities);
+                if (p >= 0.f) pending.push_back({ file, p });
+            }
+
+            std::sort(pending.begin(), pending.end(), [](const pending_resolve & a, const pending_resolve & b) { return a.priority < b.priority; });
+
+            if (!watcher) watcher.reset(new file_watcher(asset_dir));
+        }
+
+        // Call once per frame after resolve() or resolve_incremental(). Drains the
+        // prioritized queue within `budget_ms` of wall time (nearest assets first; a
+        // single large import can still overshoot one budget), then matches any files
+        // the OS reported as changed - that cost is proportional to the number of
+        // changes, not the tree size.
+        void update(const float budget_ms = 5.f)
+        {
+            if (!pending.empty())
+            {
+                const auto start = std::chrono::high_resolution_clock::now();
+                size_t drained = 0;
+                while (drained < pending.size())
+                {
+                    resolve_file(pending[drained].path, true);
+                    ++drained;
+                    const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+                    if (elapsed >= budget_ms) break;
+                }
+                pending.erase(pending.begin(), pending.begin() + drained);
+            }
+
+            if (!watcher) return;
+            for (auto & changed : watcher->drain_changes()) resolve_file(changed);
+        }
+
+        size_t pending_count() const { return pending.size(); }
     };
 
 } // end namespace polymer
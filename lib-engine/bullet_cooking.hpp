@@ -0,0 +1,609 @@
+#pragma once
+
+#ifndef polymer_bullet_cooking_hpp
+#define polymer_bullet_cooking_hpp
+
+#include "btBulletCollisionCommon.h"
+#include "BulletCollision/CollisionShapes/btShapeHull.h"
+
+#include "math-core.hpp"
+#include "geometry.hpp"
+#include "bullet_utils.hpp"
+#include "file_io.hpp"
+#include "thread-pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace polymer
+{
+
+    //////////////////////////////
+    //   physics shape cooking  //
+    //////////////////////////////
+
+    // Cooking a btBvhTriangleMeshShape for a large static mesh is an expensive,
+    // fully deterministic function of the mesh data, so the cooker runs it on the
+    // task scheduler and caches the result on disk keyed by a hash of the mesh.
+    // Warm loads deserialize the optimized bvh instead of rebuilding it, and cold
+    // loads cook in the background while the scene activates against a cheap
+    // placeholder shape (see async_physics_shape).
+
+    // Owns everything a cooked collision shape aliases: the shape itself, the mesh
+    // snapshot the triangle interface points into, and (on cache hits) the block
+    // the deserialized bvh lives inside. Destroy only after the shape has been
+    // detached from every body.
+    struct cooked_physics_shape
+    {
+        std::unique_ptr<btCollisionShape> shape;
+
+        std::unique_ptr<btTriangleIndexVertexArray> meshInterface;
+        std::vector<float3> vertices;
+        std::vector<uint3> faces;
+
+        unsigned char * bvhBlock{ nullptr }; // btOptimizedBvh::deSerializeInPlace aliases this
+
+        // Child hulls of a compound decomposition; `shape` is the btCompoundShape
+        // pointing at these
+        std::vector<std::unique_ptr<btConvexHullShape>> compoundChildren;
+
+        cooked_physics_shape() = default;
+        ~cooked_physics_shape()
+        {
+            shape.reset(); // the shape may point at a bvh inside bvhBlock
+            if (bvhBlock) btAlignedFree(bvhBlock);
+        }
+
+        cooked_physics_shape(const cooked_physics_shape &) = delete;
+        cooked_physics_shape & operator = (const cooked_physics_shape &) = delete;
+    };
+
+    // Handle for a shape cooking in the background. placeholder_shape() (a box of
+    // the mesh's local bounds) lets a body enter the world immediately; poll
+    // upgrade() from the owning thread - between physics steps - to swap in the
+    // cooked shape once it lands. The handle owns both shapes, so keep it alive
+    // as long as the body uses either.
+    class async_physics_shape
+    {
+        friend class physics_shape_cooker;
+
+        struct state_t
+        {
+            std::atomic<bool> ready{ false };
+            std::unique_ptr<cooked_physics_shape> cooked;
+        };
+
+        std::shared_ptr<state_t> state{ new state_t() };
+        std::unique_ptr<btBoxShape> placeholder;
+        bool upgraded{ false };
+
+    public:
+
+        btCollisionShape * placeholder_shape() { return placeholder.get(); }
+
+        bool ready() const { return state->ready; }
+
+        // Null until cooking completes
+        btCollisionShape * cooked_shape() { return state->ready ? state->cooked->shape.get() : nullptr; }
+
+        // Swaps a live body's placeholder for the cooked shape. Returns true once the
+        // body carries the cooked shape; pass the world so the broadphase aabb is
+        // refreshed for the new extents.
+        bool upgrade(btRigidBody & body, btDiscreteDynamicsWorld * world = nullptr)
+        {
+            if (upgraded) return true;
+            if (!state->ready) return false;
+            body.setCollisionShape(state->cooked->shape.get());
+            if (world) world->updateSingleAabb(&body);
+            upgraded = true;
+            return true;
+        }
+    };
+
+    // Budgets for approximate convex decomposition. A concave prop cooked this way
+    // simulates as a compound of convex hulls: contacts come from well-fitting
+    // convex pieces instead of a single over-inflated hull or a (static-only,
+    // expensive) triangle mesh. Splitting stops once every piece is convex enough
+    // (`concavity_threshold`, as a fraction of the piece's hull volume), too small
+    // to split (`min_triangles`), or the piece budget is spent.
+    struct convex_decomposition_settings
+    {
+        uint32_t max_pieces{ 16 };
+        float concavity_threshold{ 0.04f };
+        uint32_t min_triangles{ 64 };
+    };
+
+    class physics_shape_cooker
+    {
+        std::string cache_dir;
+
+        struct cache_header
+        {
+            uint32_t magic{ 0x6b6f6f63 }; // 'cook'
+            uint32_t version{ 1 };        // serialized bvh layout is build-specific; bump with bullet upgrades
+            uint64_t meshHash{ 0 };
+            uint64_t payloadBytes{ 0 };
+        };
+
+        static uint64_t fnv1a_bytes(const void * data, const size_t bytes, uint64_t hash)
+        {
+            const unsigned char * p = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < bytes; ++i) { hash ^= p[i]; hash *= 0x100000001b3ull; }
+            return hash;
+        }
+
+        static std::string cache_path(const std::string & dir, const uint64_t hash, const char * kind)
+        {
+            char name[64];
+            std::snprintf(name, sizeof(name), "%016llx-%s.btcooked", static_cast<unsigned long long>(hash), kind);
+            return dir + "/" + name;
+        }
+
+        // Payload bytes from a cache file whose header matches, or empty
+        static std::vector<uint8_t> load_cached(const std::string & path, const uint64_t hash)
+        {
+            std::ifstream probe(path, std::ios::binary);
+            if (!probe.good()) return {};
+            probe.close();
+
+            std::vector<uint8_t> bytes = read_file_binary(path);
+            if (bytes.size() < sizeof(cache_header)) return {};
+
+            cache_header header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            if (header.magic != cache_header().magic || header.version != cache_header().version) return {};
+            if (header.meshHash != hash || header.payloadBytes != bytes.size() - sizeof(header)) return {};
+
+            return { bytes.begin() + sizeof(header), bytes.end() };
+        }
+
+        static void store_cached(const std::string & path, const uint64_t hash, const void * payload, const size_t payloadBytes)
+        {
+            cache_header header;
+            header.meshHash = hash;
+            header.payloadBytes = payloadBytes;
+
+            std::vector<uint8_t> bytes(sizeof(header) + payloadBytes);
+            std::memcpy(bytes.data(), &header, sizeof(header));
+            std::memcpy(bytes.data() + sizeof(header), payload, payloadBytes);
+            try { write_file_binary(path, bytes); }
+            catch (const std::exception &) { } // a missing cache dir just means cold cooks
+        }
+
+        static std::unique_ptr<cooked_physics_shape> cook_triangle_mesh_arrays(const std::vector<float3> & vertices, const std::vector<uint3> & faces, const std::string & dir)
+        {
+            std::unique_ptr<cooked_physics_shape> cooked(new cooked_physics_shape());
+            cooked->vertices = vertices;
+            cooked->faces = faces;
+
+            cooked->meshInterface.reset(new btTriangleIndexVertexArray(
+                static_cast<int>(cooked->faces.size()), reinterpret_cast<int *>(cooked->faces.data()), sizeof(uint3),
+                static_cast<int>(cooked->vertices.size()), reinterpret_cast<btScalar *>(cooked->vertices.data()), sizeof(float3)));
+
+            const uint64_t hash = hash_arrays(vertices, faces);
+            const std::string path = cache_path(dir, hash, "trimesh");
+
+            std::vector<uint8_t> cachedBvh = load_cached(path, hash);
+            if (!cachedBvh.empty())
+            {
+                // deSerializeInPlace rebuilds the tree inside our aligned block, so the
+                // expensive bvh construction never runs on a warm cache
+                std::unique_ptr<btBvhTriangleMeshShape> shape(new btBvhTriangleMeshShape(cooked->meshInterface.get(), true, false));
+                cooked->bvhBlock = static_cast<unsigned char *>(btAlignedAlloc(cachedBvh.size(), 16));
+                std::memcpy(cooked->bvhBlock, cachedBvh.data(), cachedBvh.size());
+
+                btOptimizedBvh * bvh = btOptimizedBvh::deSerializeInPlace(cooked->bvhBlock, static_cast<unsigned int>(cachedBvh.size()), false);
+                if (bvh)
+                {
+                    shape->setOptimizedBvh(bvh);
+                    cooked->shape = std::move(shape);
+                    return cooked;
+                }
+
+                btAlignedFree(cooked->bvhBlock); // corrupt cache: fall through and re-cook
+                cooked->bvhBlock = nullptr;
+            }
+
+            std::unique_ptr<btBvhTriangleMeshShape> shape(new btBvhTriangleMeshShape(cooked->meshInterface.get(), true, true));
+
+            btOptimizedBvh * bvh = shape->getOptimizedBvh();
+            const unsigned int serializedBytes = bvh->calculateSerializeBufferSize();
+            void * buffer = btAlignedAlloc(serializedBytes, 16);
+            if (bvh->serialize(buffer, serializedBytes, false)) store_cached(path, hash, buffer, serializedBytes);
+            btAlignedFree(buffer);
+
+            cooked->shape = std::move(shape);
+            return cooked;
+        }
+
+        static std::unique_ptr<cooked_physics_shape> cook_convex_hull_arrays(const std::vector<float3> & vertices, const std::string & dir)
+        {
+            std::unique_ptr<cooked_physics_shape> cooked(new cooked_physics_shape());
+
+            const uint64_t hash = fnv1a_bytes(vertices.data(), vertices.size() * sizeof(float3), 0xcbf29ce484222325ull);
+            const std::string path = cache_path(dir, hash, "hull");
+
+            std::vector<uint8_t> cachedPoints = load_cached(path, hash);
+            if (!cachedPoints.empty() && (cachedPoints.size() % sizeof(float3)) == 0)
+            {
+                cooked->vertices.resize(cachedPoints.size() / sizeof(float3));
+                std::memcpy(cooked->vertices.data(), cachedPoints.data(), cachedPoints.size());
+                cooked->shape.reset(new btConvexHullShape(reinterpret_cast<const btScalar *>(cooked->vertices.data()),
+                    static_cast<int>(cooked->vertices.size()), sizeof(float3)));
+                return cooked;
+            }
+
+            // Hull reduction (btShapeHull) is the expensive half of a convex cook; the
+            // cache stores the reduced point set
+            btConvexHullShape raw(reinterpret_cast<const btScalar *>(vertices.data()), static_cast<int>(vertices.size()), sizeof(float3));
+            btShapeHull reducer(&raw);
+            reducer.buildHull(raw.getMargin());
+
+            cooked->vertices.resize(reducer.numVertices());
+            for (int i = 0; i < reducer.numVertices(); ++i) cooked->vertices[i] = from_bt(reducer.getVertexPointer()[i]);
+
+            store_cached(path, hash, cooked->vertices.data(), cooked->vertices.size() * sizeof(float3));
+
+            cooked->shape.reset(new btConvexHullShape(reinterpret_cast<const btScalar *>(cooked->vertices.data()),
+                static_cast<int>(cooked->vertices.size()), sizeof(float3)));
+            return cooked;
+        }
+
+        ///////////////////////////////////////////
+        //   approximate convex decomposition    //
+        ///////////////////////////////////////////
+
+        struct decomp_piece
+        {
+            std::vector<uint3> tris;
+            float concavity{ 0.f };
+            bool open{ true }; // false once the piece can't or needn't split further
+        };
+
+        // Reduces a point cloud through btShapeHull (same reduction the single-hull
+        // cook uses), returns the reduced hull's volume and its point set
+        static float reduce_hull(const std::vector<float3> & points, std::vector<float3> & hullPoints)
+        {
+            hullPoints.clear();
+            if (points.size() < 4) return 0.f;
+
+            btConvexHullShape raw(reinterpret_cast<const btScalar *>(points.data()), static_cast<int>(points.size()), sizeof(float3));
+            btShapeHull reducer(&raw);
+            reducer.buildHull(raw.getMargin());
+
+            hullPoints.resize(reducer.numVertices());
+            for (int i = 0; i < reducer.numVertices(); ++i) hullPoints[i] = from_bt(reducer.getVertexPointer()[i]);
+            if (hullPoints.empty() || reducer.numTriangles() == 0) return 0.f;
+
+            float3 centroid(0.f);
+            for (const float3 & p : hullPoints) centroid += p;
+            centroid /= static_cast<float>(hullPoints.size());
+
+            const unsigned int * indices = reducer.getIndexPointer();
+            double volume = 0.0;
+            for (int t = 0; t < reducer.numTriangles(); ++t)
+            {
+                const float3 a = hullPoints[indices[3 * t + 0]] - centroid;
+                const float3 b = hullPoints[indices[3 * t + 1]] - centroid;
+                const float3 c = hullPoints[indices[3 * t + 2]] - centroid;
+                volume += dot(a, cross(b, c));
+            }
+            return static_cast<float>(std::fabs(volume) / 6.0);
+        }
+
+        static void gather_piece_points(const std::vector<float3> & vertices, const std::vector<uint3> & tris, std::vector<float3> & points)
+        {
+            points.clear();
+            std::vector<uint8_t> referenced(vertices.size(), 0);
+            for (const uint3 & t : tris) { referenced[t.x] = 1; referenced[t.y] = 1; referenced[t.z] = 1; }
+            for (size_t i = 0; i < vertices.size(); ++i) if (referenced[i]) points.push_back(vertices[i]);
+        }
+
+        // Concavity proxy: how much of the piece's convex hull the mesh itself does
+        // not fill, as a fraction of the hull volume. The mesh volume comes from a
+        // signed tetrahedron fan around the piece centroid, so open sheets read as
+        // highly concave and keep splitting until a finer budget or size limit -
+        // over-splitting is the safe failure mode here.
+        static float piece_concavity(const std::vector<float3> & vertices, const std::vector<uint3> & tris)
+        {
+            std::vector<float3> points, hullPoints;
+            gather_piece_points(vertices, tris, points);
+            if (points.size() < 4) return 0.f;
+
+            const float hullVolume = reduce_hull(points, hullPoints);
+            if (hullVolume <= 1e-9f) return 0.f;
+
+            float3 centroid(0.f);
+            for (const float3 & p : points) centroid += p;
+            centroid /= static_cast<float>(points.size());
+
+            double volume = 0.0;
+            for (const uint3 & t : tris)
+            {
+                const float3 a = vertices[t.x] - centroid;
+                const float3 b = vertices[t.y] - centroid;
+                const float3 c = vertices[t.z] - centroid;
+                volume += dot(a, cross(b, c));
+            }
+            const float meshVolume = static_cast<float>(std::fabs(volume) / 6.0);
+
+            return clamp((hullVolume - meshVolume) / hullVolume, 0.f, 1.f);
+        }
+
+        // Splits along the longest axis of the triangle-centroid bounds at the
+        // midpoint, falling back to the median when one side comes up empty
+        static bool split_piece(const std::vector<float3> & vertices, const decomp_piece & piece, decomp_piece & a, decomp_piece & b)
+        {
+            if (piece.tris.size() < 2) return false;
+
+            std::vector<float3> centroids(piece.tris.size());
+            aabb_3d bounds(float3(std::numeric_limits<float>::max()), float3(std::numeric_limits<float>::lowest()));
+            for (size_t i = 0; i < piece.tris.size(); ++i)
+            {
+                const uint3 & t = piece.tris[i];
+                centroids[i] = (vertices[t.x] + vertices[t.y] + vertices[t.z]) / 3.f;
+                bounds._min = linalg::min(bounds._min, centroids[i]);
+                bounds._max = linalg::max(bounds._max, centroids[i]);
+            }
+
+            const float3 extents = bounds.size();
+            int axis = 0;
+            if (extents.y > extents[axis]) axis = 1;
+            if (extents.z > extents[axis]) axis = 2;
+
+            const float mid = bounds.center()[axis];
+            for (size_t i = 0; i < piece.tris.size(); ++i)
+            {
+                if (centroids[i][axis] < mid) a.tris.push_back(piece.tris[i]);
+                else b.tris.push_back(piece.tris[i]);
+            }
+
+            if (a.tris.empty() || b.tris.empty())
+            {
+                a.tris.clear();
+                b.tris.clear();
+
+                std::vector<uint32_t> order(piece.tris.size());
+                for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+                std::sort(order.begin(), order.end(), [&](const uint32_t lhs, const uint32_t rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+
+                const size_t half = order.size() / 2;
+                for (size_t i = 0; i < order.size(); ++i) ((i < half) ? a : b).tris.push_back(piece.tris[order[i]]);
+            }
+
+            return !a.tris.empty() && !b.tris.empty();
+        }
+
+        // Builds the compound from per-piece hull point sets; a single-piece result
+        // still comes back as a compound so callers handle one shape type
+        static void build_compound(cooked_physics_shape & cooked, const std::vector<std::vector<float3>> & hulls)
+        {
+            std::unique_ptr<btCompoundShape> compound(new btCompoundShape(true, static_cast<int>(hulls.size())));
+            btTransform identity;
+            identity.setIdentity();
+
+            for (const std::vector<float3> & points : hulls)
+            {
+                std::unique_ptr<btConvexHullShape> child(new btConvexHullShape(
+                    reinterpret_cast<const btScalar *>(points.data()), static_cast<int>(points.size()), sizeof(float3)));
+                compound->addChildShape(identity, child.get());
+                cooked.compoundChildren.push_back(std::move(child));
+            }
+
+            cooked.shape = std::move(compound);
+        }
+
+        static std::unique_ptr<cooked_physics_shape> cook_convex_decomposition_arrays(
+            const std::vector<float3> & vertices, const std::vector<uint3> & faces,
+            const convex_decomposition_settings & settings, const std::string & dir)
+        {
+            if (faces.empty()) return cook_convex_hull_arrays(vertices, dir); // a point cloud has nothing to split on
+
+            uint64_t hash = hash_arrays(vertices, faces);
+            hash = fnv1a_bytes(&settings.max_pieces, sizeof(settings.max_pieces), hash);
+            hash = fnv1a_bytes(&settings.concavity_threshold, sizeof(settings.concavity_threshold), hash);
+            hash = fnv1a_bytes(&settings.min_triangles, sizeof(settings.min_triangles), hash);
+
+            const std::string path = cache_path(dir, hash, "compound");
+
+            // Warm cache: the payload is the per-piece reduced point sets, so the
+            // split search and hull reduction never rerun
+            std::vector<uint8_t> cached = load_cached(path, hash);
+            if (cached.size() >= sizeof(uint32_t))
+            {
+                std::vector<std::vector<float3>> hulls;
+                size_t cursor = 0;
+                auto read_u32 = [&](uint32_t & out) {
+                    if (cursor + sizeof(uint32_t) > cached.size()) return false;
+                    std::memcpy(&out, cached.data() + cursor, sizeof(uint32_t));
+                    cursor += sizeof(uint32_t);
+                    return true;
+                };
+
+                uint32_t pieceCount = 0;
+                bool valid = read_u32(pieceCount) && pieceCount > 0;
+                for (uint32_t p = 0; valid && p < pieceCount; ++p)
+                {
+                    uint32_t pointCount = 0;
+                    valid = read_u32(pointCount) && pointCount >= 4 && cursor + pointCount * sizeof(float3) <= cached.size();
+                    if (!valid) break;
+                    hulls.emplace_back(pointCount);
+                    std::memcpy(hulls.back().data(), cached.data() + cursor, pointCount * sizeof(float3));
+                    cursor += pointCount * sizeof(float3);
+                }
+
+                if (valid && cursor == cached.size())
+                {
+                    std::unique_ptr<cooked_physics_shape> cooked(new cooked_physics_shape());
+                    build_compound(*cooked, hulls);
+                    return cooked;
+                }
+                // corrupt cache: fall through and re-cook
+            }
+
+            // Greedy split search: always split the worst remaining piece, so a tight
+            // piece budget goes where the fit is worst
+            std::vector<decomp_piece> pieces(1);
+            pieces[0].tris = faces;
+            pieces[0].concavity = piece_concavity(vertices, pieces[0].tris);
+
+            while (pieces.size() < settings.max_pieces)
+            {
+                int worst = -1;
+                for (size_t i = 0; i < pieces.size(); ++i)
+                {
+                    if (!pieces[i].open) continue;
+                    if (pieces[i].concavity <= settings.concavity_threshold) { pieces[i].open = false; continue; }
+                    if (pieces[i].tris.size() <= settings.min_triangles) { pieces[i].open = false; continue; }
+                    if (worst < 0 || pieces[i].concavity > pieces[worst].concavity) worst = static_cast<int>(i);
+                }
+                if (worst < 0) break;
+
+                decomp_piece a, b;
+                if (!split_piece(vertices, pieces[worst], a, b)) { pieces[worst].open = false; continue; }
+
+                a.concavity = piece_concavity(vertices, a.tris);
+                b.concavity = piece_concavity(vertices, b.tris);
+                pieces[worst] = std::move(a);
+                pieces.push_back(std::move(b));
+            }
+
+            // Reduce each piece to its hull point set; degenerate slivers (under 4
+            // unique points) fold into the output only if nothing else survived
+            std::vector<std::vector<float3>> hulls;
+            for (const decomp_piece & piece : pieces)
+            {
+                std::vector<float3> points, hullPoints;
+                gather_piece_points(vertices, piece.tris, points);
+                reduce_hull(points, hullPoints);
+                if (hullPoints.size() >= 4) hulls.push_back(std::move(hullPoints));
+            }
+            if (hulls.empty()) return cook_convex_hull_arrays(vertices, dir);
+
+            std::vector<uint8_t> payload;
+            const uint32_t pieceCount = static_cast<uint32_t>(hulls.size());
+            auto append = [&payload](const void * data, const size_t bytes) {
+                const uint8_t * p = static_cast<const uint8_t *>(data);
+                payload.insert(payload.end(), p, p + bytes);
+            };
+            append(&pieceCount, sizeof(pieceCount));
+            for (const std::vector<float3> & hull : hulls)
+            {
+                const uint32_t pointCount = static_cast<uint32_t>(hull.size());
+                append(&pointCount, sizeof(pointCount));
+                append(hull.data(), hull.size() * sizeof(float3));
+            }
+            store_cached(path, hash, payload.data(), payload.size());
+
+            std::unique_ptr<cooked_physics_shape> cooked(new cooked_physics_shape());
+            build_compound(*cooked, hulls);
+            return cooked;
+        }
+
+    public:
+
+        // `cache_dir` conventionally sits beside the scene file, like the reflection
+        // probe cache; it must already exist for caching to engage
+        explicit physics_shape_cooker(const std::string & cache_dir) : cache_dir(cache_dir) { }
+
+        static uint64_t hash_arrays(const std::vector<float3> & vertices, const std::vector<uint3> & faces)
+        {
+            uint64_t hash = fnv1a_bytes(vertices.data(), vertices.size() * sizeof(float3), 0xcbf29ce484222325ull);
+            return fnv1a_bytes(faces.data(), faces.size() * sizeof(uint3), hash);
+        }
+
+        static uint64_t mesh_hash(const runtime_mesh & mesh) { return hash_arrays(mesh.vertices, mesh.faces); }
+
+        // Synchronous cooks: cache-loaded when warm, cooked and cached when cold
+        std::unique_ptr<cooked_physics_shape> cook_triangle_mesh(const runtime_mesh & mesh) const
+        {
+            return cook_triangle_mesh_arrays(mesh.vertices, mesh.faces, cache_dir);
+        }
+
+        std::unique_ptr<cooked_physics_shape> cook_convex_hull(const runtime_mesh & mesh) const
+        {
+            return cook_convex_hull_arrays(mesh.vertices, cache_dir);
+        }
+
+        // Approximate convex decomposition: a btCompoundShape of reduced convex
+        // hulls that follows the concave surface within the settings' budgets.
+        // Suitable for dynamic bodies, unlike the triangle-mesh cook.
+        std::unique_ptr<cooked_physics_shape> cook_convex_decomposition(const runtime_mesh & mesh, const convex_decomposition_settings & settings = {}) const
+        {
+            return cook_convex_decomposition_arrays(mesh.vertices, mesh.faces, settings, cache_dir);
+        }
+
+        // Background cooks on the task scheduler. The mesh arrays are snapshotted on
+        // the calling thread, so the live mesh can be edited or freed immediately.
+        std::shared_ptr<async_physics_shape> cook_triangle_mesh_async(const runtime_mesh & mesh) const
+        {
+            std::shared_ptr<async_physics_shape> handle(new async_physics_shape());
+
+            const aabb_3d bounds = compute_bounds(mesh);
+            handle->placeholder.reset(new btBoxShape(to_bt(bounds.size() * 0.5f)));
+
+            auto state = handle->state;
+            auto vertices = std::make_shared<std::vector<float3>>(mesh.vertices);
+            auto faces = std::make_shared<std::vector<uint3>>(mesh.faces);
+            const std::string dir = cache_dir;
+
+            get_task_scheduler().submit([state, vertices, faces, dir]()
+            {
+                state->cooked = cook_triangle_mesh_arrays(*vertices, *faces, dir);
+                state->ready = true;
+            });
+
+            return handle;
+        }
+
+        std::shared_ptr<async_physics_shape> cook_convex_hull_async(const runtime_mesh & mesh) const
+        {
+            std::shared_ptr<async_physics_shape> handle(new async_physics_shape());
+
+            const aabb_3d bounds = compute_bounds(mesh);
+            handle->placeholder.reset(new btBoxShape(to_bt(bounds.size() * 0.5f)));
+
+            auto state = handle->state;
+            auto vertices = std::make_shared<std::vector<float3>>(mesh.vertices);
+            const std::string dir = cache_dir;
+
+            get_task_scheduler().submit([state, vertices, dir]()
+            {
+                state->cooked = cook_convex_hull_arrays(*vertices, dir);
+                state->ready = true;
+            });
+
+            return handle;
+        }
+
+        std::shared_ptr<async_physics_shape> cook_convex_decomposition_async(const runtime_mesh & mesh, const convex_decomposition_settings & settings = {}) const
+        {
+            std::shared_ptr<async_physics_shape> handle(new async_physics_shape());
+
+            const aabb_3d bounds = compute_bounds(mesh);
+            handle->placeholder.reset(new btBoxShape(to_bt(bounds.size() * 0.5f)));
+
+            auto state = handle->state;
+            auto vertices = std::make_shared<std::vector<float3>>(mesh.vertices);
+            auto faces = std::make_shared<std::vector<uint3>>(mesh.faces);
+            const std::string dir = cache_dir;
+
+            get_task_scheduler().submit([state, vertices, faces, settings, dir]()
+            {
+                state->cooked = cook_convex_decomposition_arrays(*vertices, *faces, settings, dir);
+                state->ready = true;
+            });
+
+            return handle;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_bullet_cooking_hpp
@@ -10,11 +10,60 @@
 #include "geometry.hpp"
 #include "bullet_utils.hpp"
 #include "bullet_object.hpp"
+#include "ecs/core-events.hpp"
+#include "system-transform.hpp"
+#include "thread-pool.hpp"
+#include "memory-pool.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace polymer
 {
 
+    enum class contact_phase : uint32_t
+    {
+        began,      // pair gained contact this step
+        persisted,  // pair was in contact last step and still is
+        ended       // pair lost contact this step (point/normal/depth are zero)
+    };
+
+    struct physics_contact
+    {
+        const btCollisionObject * a{ nullptr };
+        const btCollisionObject * b{ nullptr };
+        contact_phase phase{ contact_phase::began };
+        float3 point;   // deepest manifold point on b, world space
+        float3 normal;  // world normal on b
+        float depth{ 0.f };
+    };
+
+    // Published once per physics step as a single batch. Handlers iterate the
+    // packed array, so N contacts cost one event dispatch, not N.
+    struct physics_contact_batch_event
+    {
+        std::vector<physics_contact> contacts;
+    };
+
+    // Tiered simulation fidelity by distance from the active camera. Tier 0 (near)
+    // simulates normally; tier 1 (mid) raises damping and sleeping thresholds so
+    // distant islands settle and deactivate quickly (bullet's solver iteration
+    // count is per-world, so per-body iteration reduction isn't available); tier 2
+    // (far) freezes bodies out of the simulation entirely, with a periodic one-step
+    // probe wake so a body whose support vanished still falls. Tier boundaries
+    // carry a hysteresis band so a body straddling one doesn't pop between tiers.
+    struct physics_lod_settings
+    {
+        bool enabled{ false };
+        float near_distance{ 20.f };          // inside: full simulation
+        float far_distance{ 60.f };           // outside: frozen with periodic wake probes
+        float hysteresis{ 5.f };              // extra distance required to demote a tier
+        uint32_t freeze_check_interval{ 60 }; // calls between probe wakes of a frozen body
+    };
+
     class bullet_engine
     {
         using tick_callback_t = std::function<void(float, bullet_engine *)>;
@@ -27,6 +76,122 @@ namespace polymer
 
         std::vector<tick_callback_t> bulletTicks;
 
+        // Async stepping state (update_async/sync)
+        std::mutex step_mutex;
+        std::condition_variable step_cv;
+        bool step_in_flight{ false }; // guarded by step_mutex
+
+        // Fixed-step scheduling state (update_fixed)
+        std::vector<physics_object *> objects;
+        std::map<physics_object *, entity> attachments;
+
+        // Slots for create_object/destroy_object; lives here so it outlives every body
+        object_pool<physics_object> physics_pool;
+        float fixed_timestep{ 1.f / 60.f };
+        float accumulator{ 0.f };
+        float alpha{ 0.f };
+
+        // Contact harvest state. Pair keys are canonically ordered so a
+        // manifold reports the same key regardless of body order, and the
+        // sorted previous/current vectors (plus the reused batch event) are
+        // swapped each step - no per-contact allocation in steady state.
+        typedef std::pair<const btCollisionObject *, const btCollisionObject *> contact_key;
+        std::vector<contact_key> previous_pairs;
+        std::vector<contact_key> current_pairs;
+        physics_contact_batch_event contact_batch;
+        event_manager_sync * contact_sink{ nullptr };
+
+        // Walks the dispatcher's manifolds after a step, classifies each pair as
+        // began/persisted/ended against the previous step, and publishes the
+        // whole batch through the sink in one send.
+        void harvest_contacts()
+        {
+            if (!contact_sink) return;
+
+            current_pairs.clear();
+            contact_batch.contacts.clear();
+
+            btDispatcher * dispatcher = dynamicsWorld->getDispatcher();
+            const int manifoldCount = dispatcher->getNumManifolds();
+            for (int i = 0; i < manifoldCount; ++i)
+            {
+                const btPersistentManifold * manifold = dispatcher->getManifoldByIndexInternal(i);
+                if (manifold->getNumContacts() == 0) continue;
+
+                contact_key key(static_cast<const btCollisionObject *>(manifold->getBody0()),
+                                static_cast<const btCollisionObject *>(manifold->getBody1()));
+                if (key.second < key.first) std::swap(key.first, key.second);
+                current_pairs.push_back(key);
+
+                int deepest = 0;
+                for (int p = 1; p < manifold->getNumContacts(); ++p)
+                {
+                    if (manifold->getContactPoint(p).getDistance() < manifold->getContactPoint(deepest).getDistance()) deepest = p;
+                }
+                const btManifoldPoint & pt = manifold->getContactPoint(deepest);
+
+                physics_contact c;
+                c.a = key.first;
+                c.b = key.second;
+                c.point = from_bt(pt.getPositionWorldOnB());
+                c.normal = from_bt(pt.m_normalWorldOnB);
+                c.depth = std::fabs(pt.getDistance());
+                contact_batch.contacts.push_back(c);
+            }
+
+            std::sort(current_pairs.begin(), current_pairs.end());
+
+            for (auto & c : contact_batch.contacts)
+            {
+                const contact_key key(c.a, c.b);
+                c.phase = std::binary_search(previous_pairs.begin(), previous_pairs.end(), key) ? contact_phase::persisted : contact_phase::began;
+            }
+
+            // Present last step, gone now
+            for (const contact_key & key : previous_pairs)
+            {
+                if (!std::binary_search(current_pairs.begin(), current_pairs.end(), key))
+                {
+                    physics_contact c;
+                    c.a = key.first;
+                    c.b = key.second;
+                    c.phase = contact_phase::ended;
+                    contact_batch.contacts.push_back(c);
+                }
+            }
+
+            previous_pairs.swap(current_pairs);
+
+            if (!contact_batch.contacts.empty()) contact_sink->send(contact_batch);
+        }
+
+        // Applies a tier's solver configuration to a body. Promotion out of the
+        // frozen tier re-activates; demotion into it disables simulation outright.
+        void apply_lod_tier(physics_object * obj, const uint32_t tier)
+        {
+            btRigidBody * body = obj->body.get();
+            switch (tier)
+            {
+                case 0:
+                    body->forceActivationState(ACTIVE_TAG);
+                    body->activate(true);
+                    body->setDamping(0.3f, 0.5f); // the defaults add_object applies
+                    body->setSleepingThresholds(0.8f, 1.0f);
+                    break;
+                case 1:
+                    body->forceActivationState(ACTIVE_TAG);
+                    body->activate(true);
+                    body->setDamping(0.6f, 0.8f);
+                    body->setSleepingThresholds(1.6f, 2.0f); // settle and deactivate sooner
+                    break;
+                case 2:
+                    body->forceActivationState(DISABLE_SIMULATION);
+                    obj->freeze_counter = 0;
+                    break;
+            }
+            obj->lod_tier = tier;
+        }
+
         static void tick_callback(btDynamicsWorld * world, btScalar time)
         {
             bullet_engine * ctx = static_cast<bullet_engine *>(world->getWorldUserInfo());
@@ -49,22 +214,51 @@ namespace polymer
             dynamicsWorld->setInternalTickCallback(tick_callback, static_cast<void *>(this), true);
         }
 
+        // A worker step must not outlive the world it is stepping
+        ~bullet_engine() { sync(); }
+
         std::shared_ptr<btDiscreteDynamicsWorld> get_world()
         {
             return dynamicsWorld;
         }
 
-        // Add a new rigid body based on physics_object wrapper
-        void add_object(physics_object * object)
+        // Pool-backed construction for physics objects. Spawning waves of bodies
+        // (or destroying them) recycles fixed-size slots through per-thread caches
+        // instead of contending on the global heap; pair with destroy_object().
+        // Objects allocated elsewhere can still go through add/remove_object.
+        template<typename... Args>
+        physics_object * create_object(Args &&... args)
+        {
+            return physics_pool.construct(std::forward<Args>(args)...);
+        }
+
+        // Detaches the body from the world (if still present) and recycles its slot.
+        // Only valid for objects that came from create_object().
+        void destroy_object(physics_object * object)
+        {
+            if (!object) return;
+            if (std::find(objects.begin(), objects.end(), object) != objects.end()) remove_object(object);
+            physics_pool.destroy(object);
+        }
+
+        // Add a new rigid body based on physics_object wrapper. Passing an entity
+        // attaches it: sync_transforms() will write the object's interpolated pose
+        // to that entity's local transform each rendered frame.
+        void add_object(physics_object * object, const entity attach_to = kInvalidEntity)
         {
             object->body->setDamping(0.3f, 0.5f);
+            object->reset_states();
             dynamicsWorld->addRigidBody(object->body.get());
+            objects.push_back(object);
+            if (attach_to != kInvalidEntity) attachments[object] = attach_to;
         }
 
         // Remove an existing rigid body based on physics_object wrapper
         void remove_object(physics_object * object)
         {
             object->get_world()->removeRigidBody(object->body.get());
+            objects.erase(std::remove(objects.begin(), objects.end(), object), objects.end());
+            attachments.erase(object);
         }
 
         void add_task(const tick_callback_t & f)
@@ -72,13 +266,146 @@ namespace polymer
             bulletTicks.push_back({ f });
         }
 
+        // Begin publishing per-step contact batches through `manager`. With
+        // update_async() the batch is sent from the worker thread, so the
+        // manager must be a queueing variant (async/deferred), not sync.
+        void publish_contacts(event_manager_sync * manager) { contact_sink = manager; }
+
         void update(const float dt = 0.0f)
         {
             const int result = dynamicsWorld->stepSimulation(dt);
+            harvest_contacts();
+        }
+
+        // Steps the simulation on a worker thread so the step overlaps with
+        // render submission instead of serializing with it. Tick callbacks run
+        // on the worker. Call sync() before reading body transforms or
+        // mutating the world (add/remove objects, apply forces).
+        void update_async(const float dt = 0.0f)
+        {
+            sync(); // at most one step in flight
+
+            { std::lock_guard<std::mutex> lk(step_mutex); step_in_flight = true; }
+            get_task_scheduler().submit([this, dt]()
+            {
+                dynamicsWorld->stepSimulation(dt);
+                harvest_contacts();
+
+                // Clear and notify under the mutex: a waiter woken by the flag alone
+                // could destroy the engine while the worker still touches members
+                std::lock_guard<std::mutex> lk(step_mutex);
+                step_in_flight = false;
+                step_cv.notify_all();
+            });
+        }
+
+        // Blocks until any in-flight update_async() step has completed; the calling
+        // thread sleeps on a condition variable rather than spinning
+        void sync()
+        {
+            std::unique_lock<std::mutex> lk(step_mutex);
+            step_cv.wait(lk, [this] { return !step_in_flight; });
+        }
+
+        void set_fixed_timestep(const float seconds) { fixed_timestep = seconds; }
+
+        physics_lod_settings lod_settings;
+
+        // Re-tiers every dynamic body by distance to the active camera (callers
+        // pass the eye position from its world_transform_component). Call once per
+        // rendered frame before update_fixed(); the probe-refreeze logic reads the
+        // states captured by the fixed-step path.
+        void update_lod_tiers(const float3 & view_position)
+        {
+            if (!lod_settings.enabled) return;
+
+            for (auto * obj : objects)
+            {
+                btRigidBody * body = obj->body.get();
+                if (body->isStaticOrKinematicObject()) continue;
+
+                const float d = length(from_bt(body->getWorldTransform().getOrigin()) - view_position);
+
+                // Promotion happens as soon as the body is inside a boundary; demotion
+                // only once it clears the boundary by the hysteresis margin
+                const float exitNear = lod_settings.near_distance + lod_settings.hysteresis;
+                const float enterFar = lod_settings.far_distance + lod_settings.hysteresis;
+
+                uint32_t tier = obj->lod_tier;
+                switch (tier)
+                {
+                    case 0: if (d > exitNear) tier = (d > enterFar) ? 2 : 1; break;
+                    case 1: if (d < lod_settings.near_distance) tier = 0; else if (d > enterFar) tier = 2; break;
+                    case 2: if (d < lod_settings.far_distance) tier = (d < lod_settings.near_distance) ? 0 : 1; break;
+                }
+
+                if (tier != obj->lod_tier)
+                {
+                    apply_lod_tier(obj, tier);
+                    continue;
+                }
+
+                if (tier == 2)
+                {
+                    if (++obj->freeze_counter >= lod_settings.freeze_check_interval)
+                    {
+                        // Probe wake: one active interval lets bullet notice lost
+                        // support; an undisturbed body refreezes below
+                        obj->freeze_counter = 0;
+                        body->forceActivationState(ACTIVE_TAG);
+                        body->activate(true);
+                    }
+                    else if (body->getActivationState() == ACTIVE_TAG)
+                    {
+                        // Probation: refreeze once the probe step stopped moving it,
+                        // so a body knocked loose falls until it resettles
+                        const float moved = length(obj->current_state.position - obj->previous_state.position);
+                        if (moved < 1e-4f) body->forceActivationState(DISABLE_SIMULATION);
+                    }
+                }
+            }
+        }
+
+        // Blend factor between the previous and current fixed steps for the
+        // frame most recently passed to update_fixed()
+        float interpolation_alpha() const { return alpha; }
+
+        // Accumulator-based fixed stepping: physics advances in fixed_timestep
+        // increments independent of the render rate, and the leftover fraction
+        // becomes the alpha used to interpolate object states for the rendered
+        // frame. Lets a 90Hz render loop run over 60Hz physics without jitter.
+        void update_fixed(const float frame_dt)
+        {
+            // Clamp so a long hitch doesn't trigger a catch-up spiral
+            accumulator = std::min(accumulator + frame_dt, fixed_timestep * 8.f);
+
+            while (accumulator >= fixed_timestep)
+            {
+                dynamicsWorld->stepSimulation(fixed_timestep, 0, fixed_timestep);
+                harvest_contacts();
+                for (auto * obj : objects) obj->capture_state();
+                accumulator -= fixed_timestep;
+            }
+
+            alpha = accumulator / fixed_timestep;
+        }
+
+        // Writes interpolated poses for entity-attached objects into the
+        // transform system. Call once per rendered frame after update_fixed();
+        // propagation batches through the system's deferred path.
+        void sync_transforms(transform_system * system)
+        {
+            for (auto & attached : attachments)
+            {
+                system->set_local_transform_deferred(attached.second, attached.first->interpolated_pose(alpha));
+            }
+            system->flush();
         }
 
     };
 
 } // end namespace polymer
 
+POLYMER_SETUP_TYPEID(polymer::physics_contact_batch_event);
+
 #endif // end polymer_bullet_engine_hpp
@@ -61,6 +61,15 @@ namespace polymer
         btMotionState * state = { nullptr };
         std::unique_ptr<btRigidBody> body = { nullptr };
 
+        // Previous/current fixed-step states, captured by bullet_engine around each
+        // fixed step and blended by interpolated_pose() for the rendered frame
+        transform previous_state;
+        transform current_state;
+
+        // Physics LOD bookkeeping, owned by bullet_engine::update_lod_tiers
+        uint32_t lod_tier{ 0 };
+        uint32_t freeze_counter{ 0 };
+
         physics_object(btMotionState * state, btCollisionShape * collisionShape, std::shared_ptr<btDiscreteDynamicsWorld> world, float mass = 1.0f)
             : state(state), world(world)
         {
@@ -93,6 +102,31 @@ namespace polymer
             return world.get();
         }
 
+        // Seeds both states from the body's present transform (on add or teleport,
+        // so interpolation doesn't sweep across the discontinuity)
+        void reset_states()
+        {
+            current_state = make_pose(body->getWorldTransform());
+            previous_state = current_state;
+        }
+
+        // Rolls current into previous and captures the post-step transform
+        void capture_state()
+        {
+            previous_state = current_state;
+            current_state = make_pose(body->getWorldTransform());
+        }
+
+        // Blends the previous and current fixed-step states; alpha comes from
+        // bullet_engine::interpolation_alpha()
+        transform interpolated_pose(const float alpha) const
+        {
+            const quatf & a = previous_state.orientation;
+            quatf b = current_state.orientation;
+            if (linalg::dot(a, b) < 0.f) b = quatf(-b.x, -b.y, -b.z, -b.w); // take the shortest arc
+            return transform(linalg::slerp(a, b, alpha), linalg::lerp(previous_state.position, current_state.position, alpha));
+        }
+
         std::vector<bt_contact_point> collide_world() const
         {
             struct CollideCallbackWorld : public contact_result_callback
@@ -6,6 +6,7 @@
 #include "math-core.hpp"
 #include "bullet_utils.hpp"
 #include "gl-api.hpp"
+#include "renderer-debug.hpp"
 
 #include "stb/stb_easy_font.h"
 #include "btBulletCollisionCommon.h"
@@ -44,6 +45,26 @@ namespace polymer
         int debugMode = 0;
         bool hasNewInfo{ false };
 
+        renderer_debug * accumulator{ nullptr };
+
+        frustum viewFrustum;
+        float3 eyePosition;
+        bool viewValid{ false };
+        float wireframeRange{ 25.f };       // beyond this, shapes collapse to their AABB
+        uint32_t categoryMask{ 0xffffffff }; // tested against broadphase collision filter groups
+
+        // Conservative segment rejection: a line is dropped only when both endpoints
+        // sit behind the same frustum plane, so anything crossing the view survives.
+        bool segment_outside_view(const float3 & a, const float3 & b) const
+        {
+            if (!viewValid) return false;
+            for (int i = 0; i < 6; ++i)
+            {
+                if (viewFrustum.planes[i].distance_to(a) < 0.f && viewFrustum.planes[i].distance_to(b) < 0.f) return true;
+            }
+            return false;
+        }
+
     public:
 
         physics_visualizer()
@@ -51,8 +72,75 @@ namespace polymer
             debugShader = gl_shader(debugVertexShader, debugFragmentShader);
         }
 
+        // When set, bullet's line spam is appended to the shared frame accumulator and
+        // batched with everything else instead of issuing a separate upload + draw here.
+        void set_accumulator(renderer_debug * accum) { accumulator = accum; }
+
+        // Call once per frame before draw_world(). Without a view, everything is
+        // submitted (the pre-existing behavior).
+        void set_view(const frustum & f, const float3 & eye)
+        {
+            viewFrustum = f;
+            eyePosition = eye;
+            viewValid = true;
+        }
+
+        // Distance beyond which wireframes degrade to AABBs
+        void set_wireframe_range(const float range) { wireframeRange = range; }
+
+        // Only objects whose broadphase collision filter group intersects the mask
+        // are drawn; per-segment geometry (contacts, constraints) is unaffected.
+        void set_category_mask(const uint32_t mask) { categoryMask = mask; }
+
+        // Frustum-aware replacement for btCollisionWorld::debugDrawWorld(). Objects
+        // whose world bounds fail the view test are skipped entirely; objects beyond
+        // the wireframe range collapse to their AABB, which reads fine at distance
+        // and costs 12 lines instead of a full shape tessellation.
+        void draw_world(btCollisionWorld * world)
+        {
+            if (!(debugMode & (DBG_DrawWireframe | DBG_DrawAabb))) return;
+
+            const DefaultColors colors = getDefaultColors();
+            const btCollisionObjectArray & objects = world->getCollisionObjectArray();
+
+            for (int i = 0; i < objects.size(); ++i)
+            {
+                const btCollisionObject * object = objects[i];
+
+                const btBroadphaseProxy * proxy = object->getBroadphaseHandle();
+                if (proxy && (static_cast<uint32_t>(proxy->m_collisionFilterGroup) & categoryMask) == 0) continue;
+
+                btVector3 aabbMin, aabbMax;
+                object->getCollisionShape()->getAabb(object->getWorldTransform(), aabbMin, aabbMax);
+
+                if (viewValid)
+                {
+                    const float3 center = from_bt((aabbMin + aabbMax) * 0.5f);
+                    const float3 half = from_bt((aabbMax - aabbMin) * 0.5f);
+                    if (!viewFrustum.intersects_aabb(center, half)) continue;
+                }
+
+                btVector3 color(1, 1, 1);
+                switch (object->getActivationState())
+                {
+                case ACTIVE_TAG: color = colors.m_activeObject; break;
+                case ISLAND_SLEEPING: color = colors.m_deactivatedObject; break;
+                case WANTS_DEACTIVATION: color = colors.m_wantsDeactivationObject; break;
+                case DISABLE_DEACTIVATION: color = colors.m_disabledDeactivationObject; break;
+                case DISABLE_SIMULATION: color = colors.m_disabledSimulationObject; break;
+                }
+
+                const bool simplified = viewValid && distance(eyePosition, from_bt(object->getWorldTransform().getOrigin())) > wireframeRange;
+
+                if ((debugMode & DBG_DrawWireframe) && !simplified) world->debugDrawObject(object->getWorldTransform(), object->getCollisionShape(), color);
+                else drawAabb(aabbMin, aabbMax, colors.m_aabb);
+            }
+        }
+
         void draw(const float4x4 & viewProj)
         {
+            if (accumulator) return; // lines were already forwarded; the accumulator draws them
+
             debugMesh.set_vertices(vertices.size(), vertices.data(), GL_DYNAMIC_DRAW);
             debugMesh.set_attribute(0, &Vertex::position);
             debugMesh.set_attribute(1, &Vertex::color);
@@ -77,6 +165,12 @@ namespace polymer
 
         void drawLine(const btVector3 & from, const btVector3 & to, const btVector3 & color)
         {
+            if (segment_outside_view(from_bt(from), from_bt(to))) return;
+            if (accumulator)
+            {
+                accumulator->draw_line(from_bt(from), from_bt(to), from_bt(color));
+                return;
+            }
             vertices.push_back({ from_bt(from), from_bt(color) });
             vertices.push_back({ from_bt(to), from_bt(color) });
         }
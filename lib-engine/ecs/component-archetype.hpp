@@ -0,0 +1,215 @@
+#pragma once
+
+#ifndef polymer_component_archetype_hpp
+#define polymer_component_archetype_hpp
+
+#include <assert.h>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core-ecs.hpp"
+#include "typeid.hpp"
+
+namespace polymer
+{
+    /// An archetype-style companion to `polymer_component_pool`. Where the pool keeps
+    /// each component type in its own container (so gathering N components for one
+    /// entity costs N hash lookups), this storage groups entities by their component
+    /// *signature* - the exact set of component types they carry - and lays each
+    /// group out as parallel, contiguous per-type arrays (structure-of-arrays).
+    ///
+    /// The set of storable component types is fixed at compile time by the template
+    /// parameter pack; the signature of an individual entity is determined at
+    /// insertion time by which components are passed to insert(). All entities
+    /// sharing a signature live in the same archetype, so a typed for_each<A, B, C>()
+    /// walks flat arrays with zero per-entity lookups.
+    ///
+    /// Like `unordered_vector_map`, removal is swap-and-pop and no ordering or
+    /// pointer stability is guaranteed: pointers returned by get() are invalidated
+    /// by any insert or destroy. Column storage grows in |chunk_size| element
+    /// increments to bound reallocation frequency. Not thread safe, and for_each()
+    /// is not re-entrant: do not insert or destroy during iteration.
+
+    template <typename... ComponentTypes>
+    class archetype_storage
+    {
+        static_assert(sizeof...(ComponentTypes) <= 64, "signature mask is 64 bits wide");
+
+        using signature_mask = uint64_t;
+
+        // Index of component type C within the ComponentTypes pack.
+        template <typename C, typename First, typename... Rest>
+        struct type_index_impl : std::integral_constant<size_t, 1 + type_index_impl<C, Rest...>::value> {};
+        template <typename C, typename... Rest>
+        struct type_index_impl<C, C, Rest...> : std::integral_constant<size_t, 0> {};
+        template <typename C> using type_index = type_index_impl<C, ComponentTypes...>;
+
+        template <typename... Cs>
+        static signature_mask mask_for()
+        {
+            const signature_mask bits[] = { 0, (signature_mask(1) << type_index<Cs>::value)... };
+            signature_mask m = 0;
+            for (auto b : bits) m |= b;
+            return m;
+        }
+
+        // One archetype holds every entity with an identical component signature.
+        // Columns for types outside the signature simply remain empty.
+        struct archetype
+        {
+            signature_mask mask{ 0 };
+            std::vector<entity> entities;
+            std::tuple<std::vector<ComponentTypes>...> columns;
+        };
+
+        struct entity_record
+        {
+            uint32_t archetype_index;
+            uint32_t row;
+        };
+
+        std::vector<std::unique_ptr<archetype>> archetypes;
+        std::unordered_map<signature_mask, uint32_t> archetype_lookup; // signature -> index into `archetypes`
+        std::unordered_map<entity, entity_record> records;
+        size_t chunk_size;
+
+        template <typename C>
+        void reserve_chunked(std::vector<C> & column)
+        {
+            if (column.size() == column.capacity()) column.reserve(column.capacity() + chunk_size);
+        }
+
+        archetype & get_or_create_archetype(const signature_mask mask)
+        {
+            auto iter = archetype_lookup.find(mask);
+            if (iter != archetype_lookup.end()) return *archetypes[iter->second];
+
+            archetypes.emplace_back(new archetype());
+            archetypes.back()->mask = mask;
+            archetype_lookup[mask] = static_cast<uint32_t>(archetypes.size() - 1);
+            return *archetypes.back();
+        }
+
+        // Swap-and-pop row |row| out of every column present in |a|'s signature.
+        template <size_t... Is>
+        void erase_row(archetype & a, const uint32_t row, std::index_sequence<Is...>)
+        {
+            const int unused[] = { 0, (erase_column<Is>(a, row), 0)... };
+            (void) unused;
+        }
+
+        template <size_t I>
+        void erase_column(archetype & a, const uint32_t row)
+        {
+            if ((a.mask & (signature_mask(1) << I)) == 0) return;
+            auto & column = std::get<I>(a.columns);
+            if (row != column.size() - 1) std::swap(column[row], column.back());
+            column.pop_back();
+        }
+
+    public:
+
+        // |chunk_size| is the column growth increment, in elements (by analogy
+        // with the page_size of unordered_vector_map).
+        explicit archetype_storage(size_t chunk_size = 1024) : chunk_size(chunk_size) {}
+
+        archetype_storage(const archetype_storage & rhs) = delete;
+        archetype_storage & operator = (const archetype_storage & rhs) = delete;
+
+        // Inserts |e| with exactly the components passed, defining its signature.
+        // Returns false if the entity is already stored (use destroy() first to
+        // re-insert with a different signature).
+        template <typename... Cs>
+        bool insert(entity e, Cs &&... components)
+        {
+            if (records.count(e)) return false;
+
+            const signature_mask mask = mask_for<typename std::decay<Cs>::type...>();
+            archetype & a = get_or_create_archetype(mask);
+
+            const int unused[] = { 0, (reserve_chunked(std::get<std::vector<typename std::decay<Cs>::type>>(a.columns)),
+                std::get<std::vector<typename std::decay<Cs>::type>>(a.columns).push_back(std::forward<Cs>(components)), 0)... };
+            (void) unused;
+
+            reserve_chunked(a.entities);
+            a.entities.push_back(e);
+
+            records[e] = { archetype_lookup[mask], static_cast<uint32_t>(a.entities.size() - 1) };
+            return true;
+        }
+
+        // Removes |e| and all of its components via swap-and-pop.
+        void destroy(entity e)
+        {
+            auto iter = records.find(e);
+            if (iter == records.end()) return;
+
+            const entity_record rec = iter->second;
+            archetype & a = *archetypes[rec.archetype_index];
+
+            erase_row(a, rec.row, std::make_index_sequence<sizeof...(ComponentTypes)>());
+
+            if (rec.row != a.entities.size() - 1)
+            {
+                std::swap(a.entities[rec.row], a.entities.back());
+                records[a.entities[rec.row]].row = rec.row;
+            }
+            a.entities.pop_back();
+            records.erase(iter);
+        }
+
+        bool contains(entity e) const { return records.count(e) > 0; }
+
+        // Returns a pointer to |e|'s component of type C, or nullptr if the entity
+        // is absent or its signature does not include C. Invalidated by mutation.
+        template <typename C>
+        C * get(entity e)
+        {
+            auto iter = records.find(e);
+            if (iter == records.end()) return nullptr;
+
+            archetype & a = *archetypes[iter->second.archetype_index];
+            if ((a.mask & (signature_mask(1) << type_index<C>::value)) == 0) return nullptr;
+            return &std::get<std::vector<C>>(a.columns)[iter->second.row];
+        }
+
+        size_t size() const { return records.size(); }
+
+        void clear()
+        {
+            archetypes.clear();
+            archetype_lookup.clear();
+            records.clear();
+        }
+
+        // Visits every entity whose signature includes all of Cs, in SoA order:
+        // |func| is invoked as func(entity, Cs & ...). Entities carrying additional
+        // components beyond Cs are still visited (their extra columns are skipped).
+        template <typename... Cs, typename Fn>
+        void for_each(Fn && func)
+        {
+            const signature_mask wanted = mask_for<Cs...>();
+            for (auto & a : archetypes)
+            {
+                if ((a->mask & wanted) != wanted) continue;
+
+                const size_t count = a->entities.size();
+                const entity * entities = a->entities.data();
+
+                // Hoist the column base pointers so the inner loop is pure linear traversal.
+                const std::tuple<Cs *...> column_ptrs(std::get<std::vector<Cs>>(a->columns).data()...);
+                for (size_t row = 0; row < count; ++row)
+                {
+                    func(entities[row], std::get<Cs *>(column_ptrs)[row]...);
+                }
+            }
+        }
+    };
+
+} // end namespace polymer
+
+#endif // polymer_component_archetype_hpp
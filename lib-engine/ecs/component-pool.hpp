@@ -10,9 +10,11 @@
 #define polymer_component_pool_hpp
 
 #include <assert.h>
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "core-ecs.hpp"
@@ -80,7 +82,13 @@ namespace polymer
             const auto & key = key_fn(obj);
             const Index index(objects.size() - 1, back_page.size() - 1);
 
-            if (lookup_table.emplace(key, index).second) return &obj;
+            if (lookup_table.emplace(key, index).second)
+            {
+                // New members join the sort index with key 0 and migrate into place
+                // on the next refresh
+                if (sort_index_enabled) sort_index.push_back({ 0, key });
+                return &obj;
+            }
             else
             {
                 destroy(index);
@@ -97,6 +105,74 @@ namespace polymer
             if (iter == lookup_table.end()) return;
             destroy(iter->second);
             lookup_table.erase(iter);
+
+            // Keep the sort index an exact mirror of membership (swap-remove; the hole
+            // in the ordering heals on the next refresh pass)
+            if (sort_index_enabled)
+            {
+                for (size_t i = 0; i < sort_index.size(); ++i)
+                {
+                    if (sort_index[i].second == key)
+                    {
+                        sort_index[i] = sort_index.back();
+                        sort_index.pop_back();
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Destroys every object whose key appears in |keys| in one pass, returning the
+        // number destroyed. destroy() pays a hash erase and a swap per element; for a
+        // large batch (a scene chunk unload) it is cheaper to build the doomed set once,
+        // sweep the survivors into compact storage, and rebuild the lookup table.
+        // Invalidates all outstanding pointers and iterators into the container.
+        size_t destroy_bulk(const Key * keys, const size_t count)
+        {
+            if (count == 0) return 0;
+
+            std::unordered_set<Key> doomed;
+            doomed.reserve(count);
+            for (size_t i = 0; i < count; ++i) doomed.insert(keys[i]);
+
+            ArrayVector compacted;
+            LookupTable surviving;
+            surviving.reserve(lookup_table.size());
+
+            size_t destroyed = 0;
+            for (const auto & entry : lookup_table)
+            {
+                if (doomed.count(entry.first)) { ++destroyed; continue; }
+
+                if (compacted.empty() || compacted.back().size() == page_size)
+                {
+                    compacted.emplace_back();
+                    compacted.back().reserve(page_size);
+                }
+                compacted.back().push_back(std::move(objects[entry.second.first][entry.second.second]));
+                surviving[entry.first] = Index(compacted.size() - 1, compacted.back().size() - 1);
+            }
+
+            objects = std::move(compacted);
+            lookup_table = std::move(surviving);
+
+            if (sort_index_enabled)
+            {
+                sort_index.erase(std::remove_if(sort_index.begin(), sort_index.end(),
+                    [&doomed](const std::pair<uint64_t, Key> & e) { return doomed.count(e.second) != 0; }), sort_index.end());
+            }
+            return destroyed;
+        }
+
+        // Releases the slack a large unload leaves behind: trims page capacity and
+        // rehashes the lookup table down to its population. Invalidates all
+        // outstanding pointers and iterators into the container.
+        void shrink_to_fit()
+        {
+            for (auto & page : objects) page.shrink_to_fit();
+            objects.shrink_to_fit();
+            lookup_table.rehash(0);
+            sort_index.shrink_to_fit();
         }
 
         // Returns true if an Object is associated with the |key|.
@@ -138,15 +214,104 @@ namespace polymer
             for (T & object : *this) func(object);
         }
 
+        // Optional maintained iteration order. The container's native order is
+        // insertion-with-swap-removal, which decorrelates from every useful order; an
+        // enabled sort index lets callers iterate by a caller-provided key instead
+        // (Morton code for spatial passes, material id for the render gather, tree
+        // depth for the transform flush). refresh_sort_index() recomputes keys and,
+        // when given an op budget, performs a bounded insertion pass that resumes
+        // across calls - temporally coherent keys converge in a pass or two, so the
+        // re-sort amortizes over frames instead of spiking one. The index mirrors
+        // membership exactly (emplace appends, destroy swap-removes), so
+        // for_each_sorted() is always safe, merely unordered until the next refresh.
+        void enable_sort_index()
+        {
+            if (sort_index_enabled) return;
+            sort_index_enabled = true;
+            sort_index.clear();
+            sort_index.reserve(lookup_table.size());
+            for (const auto & entry : lookup_table) sort_index.push_back({ 0, entry.first });
+        }
+
+        bool sort_index_active() const { return sort_index_enabled; }
+
+        // |sort_key| is invoked with a const T & and returns the object's ordering key.
+        // A |max_sort_ops| of zero sorts fully; a non-zero budget bounds the number of
+        // element moves performed this call.
+        template<typename SortKeyFn>
+        void refresh_sort_index(SortKeyFn && sort_key, const size_t max_sort_ops = 0)
+        {
+            if (!sort_index_enabled) return;
+
+            for (auto & entry : sort_index)
+            {
+                const Index & idx = lookup_table.find(entry.second)->second;
+                entry.first = sort_key(static_cast<const T &>(objects[idx.first][idx.second]));
+            }
+
+            if (max_sort_ops == 0)
+            {
+                std::sort(sort_index.begin(), sort_index.end(),
+                    [](const std::pair<uint64_t, Key> & a, const std::pair<uint64_t, Key> & b) { return a.first < b.first; });
+                sort_cursor = 1;
+                return;
+            }
+
+            // Bounded adaptive pass, resuming where the previous call stopped. Every
+            // prefix of moves leaves a valid permutation, so stopping mid-pass is safe.
+            size_t ops = 0;
+            size_t i = (sort_cursor < 1 || sort_cursor > sort_index.size()) ? 1 : sort_cursor;
+            for (; i < sort_index.size() && ops < max_sort_ops; ++i)
+            {
+                const std::pair<uint64_t, Key> entry = sort_index[i];
+                size_t j = i;
+                while (j > 0 && sort_index[j - 1].first > entry.first && ops < max_sort_ops)
+                {
+                    sort_index[j] = sort_index[j - 1];
+                    --j;
+                    ++ops;
+                }
+                sort_index[j] = entry;
+            }
+            sort_cursor = (i >= sort_index.size()) ? 1 : i;
+        }
+
+        // Iterates in sort-index order (falling back to native order when the index is
+        // disabled). One hash lookup per element; worth it when the callback feeds an
+        // order-sensitive consumer downstream.
+        template<typename Fn> void for_each_sorted(Fn && func)
+        {
+            if (!sort_index_enabled)
+            {
+                for_each(std::forward<Fn>(func));
+                return;
+            }
+            for (const auto & entry : sort_index)
+            {
+                const Index & idx = lookup_table.find(entry.second)->second;
+                func(objects[idx.first][idx.second]);
+            }
+        }
+
         size_t size() const
         {
             return lookup_table.size();
         }
 
+        // Pre-sizes the container for |count| additional objects so a bulk insert
+        // does not rehash the lookup table or regrow the page vector mid-burst.
+        void reserve(const size_t count)
+        {
+            lookup_table.reserve(lookup_table.size() + count);
+            objects.reserve(objects.size() + (count + page_size - 1) / page_size);
+        }
+
         void clear()
         {
             objects.clear();
             lookup_table.clear();
+            sort_index.clear();
+            sort_cursor = 1;
         }
 
         iterator begin() { return iterator(objects.begin(), objects.end()); }
@@ -196,6 +361,12 @@ namespace polymer
         // The maximum size of the internal array in the ArrayVector.
         size_t page_size;
 
+        // The optional maintained iteration order: (sort key, object key) pairs, plus
+        // the resume point for the amortized re-sort pass.
+        bool sort_index_enabled{ false };
+        std::vector<std::pair<uint64_t, Key>> sort_index;
+        size_t sort_cursor{ 1 };
+
         // An STL style iterator for accessing the elements of an unordered_vector_map.
         // This class provides both the const and non-const implementation. If the
         // container is modified at any point during the iteration then the iterator
@@ -9,9 +9,13 @@
 #ifndef polymer_base_ecs_hpp
 #define polymer_base_ecs_hpp
 
-#include <unordered_map>
+#include <assert.h>
+#include <algorithm>
+#include <vector>
 #include <limits>
+#include <unordered_map>
 #include "typeid.hpp"
+#include "flat_hash_map.hpp"
 
 namespace polymer
 {
@@ -24,6 +28,16 @@ namespace polymer
     constexpr entity kInvalidEntity = 0;
     constexpr entity kAllEntities = std::numeric_limits<uint64_t>::max();
 
+    // Entities pack a slot index (low 32 bits) and a generation (high 32 bits).
+    // The generation increments whenever a slot is recycled, so any stale copy of
+    // a destroyed id can be rejected with one array compare on the orchestrator
+    // (see entity_orchestrator::is_alive) instead of a hash lookup per system.
+    // First-generation ids have zero high bits, so they print and serialize
+    // exactly like the plain sequential ids they replace.
+    constexpr uint32_t entity_index(const entity e) { return static_cast<uint32_t>(e & 0xffffffffull); }
+    constexpr uint32_t entity_generation(const entity e) { return static_cast<uint32_t>(e >> 32); }
+    constexpr entity make_entity(const uint32_t index, const uint32_t generation) { return (static_cast<entity>(generation) << 32) | index; }
+
     ////////////////////////
     //   Base Component   //
     ////////////////////////
@@ -57,19 +71,126 @@ namespace polymer
         explicit base_system(entity_orchestrator * o) : orchestrator(o) {}
         virtual ~base_system() {}
 
-        // Associates component with the entity using serialized data. The void pointer 
-        // and hash type is to subvert the need for a heavily templated component system. 
+        // Associates component with the entity using serialized data. The void pointer
+        // and hash type is to subvert the need for a heavily templated component system.
         virtual bool create(entity e, poly_typeid hash, void * data) { return false; };
 
+        // Associates |count| components (a contiguous array of |stride|-byte elements in
+        // |data|, one per entity) in a single call. The default implementation simply
+        // loops over create(); systems with bulk-friendly storage may override to
+        // reserve their pools up front. Returns true only if every create succeeded.
+        virtual bool create_bulk(const entity * entities, const size_t count, poly_typeid hash, void * data, const size_t stride)
+        {
+            bool result = true;
+            for (size_t i = 0; i < count; ++i)
+            {
+                result &= create(entities[i], hash, static_cast<char *>(data) + (i * stride));
+            }
+            return result;
+        }
+
         // Destroys all of an entity's associated components
         virtual void destroy(entity e) {};
 
+        // Destroys the associated components of every entity in |entities|. The default
+        // implementation loops destroy(); pool-backed systems should override to remove
+        // the whole batch in one pass (hash erases and swap-removals per entity are what
+        // make large scene unloads hitch).
+        virtual void destroy_entities(const entity * entities, const size_t count)
+        {
+            for (size_t i = 0; i < count; ++i) destroy(entities[i]);
+        }
+
         // Helper function to signal to the entity orchestrator that this system operates on these types of components
         template <typename S>
         void register_system_for_type(S * system, poly_typeid component_type) { register_system_for_type(get_typeid<S>(), component_type); }
         void register_system_for_type(poly_typeid system_type, poly_typeid component_type);
     };
 
+    ////////////////////////////////////////
+    //   Compile-Time Component Binding   //
+    ////////////////////////////////////////
+
+    // Maps a component type to the system that stores it, resolved at compile time.
+    // Systems opt in with POLYMER_REGISTER_COMPONENT_SYSTEM alongside their
+    // POLYMER_SETUP_TYPEID, which lets entity_orchestrator::attach() bind a
+    // component to its pool statically (one typed call, no hash compare chain)
+    // instead of routing through the virtual create(entity, poly_typeid, void *)
+    // path. The type-erased path remains for serialization, where the component
+    // type is only known as a hash at runtime.
+    template <typename C> struct system_for_component;
+
+    #define POLYMER_REGISTER_COMPONENT_SYSTEM(ComponentType, SystemType) \
+    template <> struct system_for_component<ComponentType> { using type = SystemType; };
+
+    //////////////////////////////////
+    //   Entity Activity Tracking   //
+    //////////////////////////////////
+
+    // Engine-wide activity tier over entities: anything that mutates an entity
+    // (transform writes, physics activation, editor edits, animation) routes
+    // through touch(), and advance() - called once per frame - demotes entries
+    // untouched for the configured number of frames to a sleeping tier. Per-frame
+    // system work can then test is_awake() or walk awake_entities() instead of a
+    // full pool, which is the difference between iterating a handful of moving
+    // objects and iterating a scene that is mostly static set-dressing. Untracked
+    // entities report awake, so systems outside the scheme are unaffected.
+    class entity_activity_tracker
+    {
+        std::unordered_map<entity, uint32_t> lastTouch; // frame of the most recent change
+        std::vector<entity> awakeList;                  // entities inside the activity window
+        uint32_t frame{ 0 };
+        uint32_t sleepAfterFrames{ 120 };               // ~2 seconds at 60hz
+
+        bool stale(const uint32_t touchFrame) const { return (frame - touchFrame) > sleepAfterFrames; }
+
+    public:
+
+        void set_sleep_threshold(const uint32_t frames) { sleepAfterFrames = std::max(1u, frames); }
+
+        // Marks an entity changed this frame, enrolling or waking it as needed
+        void touch(const entity e)
+        {
+            if (e == kInvalidEntity) return;
+            auto iter = lastTouch.find(e);
+            if (iter == lastTouch.end()) { lastTouch[e] = frame; awakeList.push_back(e); return; }
+            const bool wasAsleep = stale(iter->second);
+            iter->second = frame;
+            if (wasAsleep) awakeList.push_back(e); // advance() removed it from the list when it slept
+        }
+
+        void forget(const entity e)
+        {
+            auto iter = lastTouch.find(e);
+            if (iter == lastTouch.end()) return;
+            lastTouch.erase(iter);
+            awakeList.erase(std::remove(awakeList.begin(), awakeList.end(), e), awakeList.end());
+        }
+
+        // Call once per frame to age the awake set and demote entries past the threshold
+        void advance()
+        {
+            ++frame;
+            awakeList.erase(std::remove_if(awakeList.begin(), awakeList.end(), [this](const entity e)
+            {
+                auto iter = lastTouch.find(e);
+                return iter == lastTouch.end() || stale(iter->second);
+            }), awakeList.end());
+        }
+
+        bool is_tracked(const entity e) const { return lastTouch.find(e) != lastTouch.end(); }
+
+        bool is_awake(const entity e) const
+        {
+            auto iter = lastTouch.find(e);
+            if (iter == lastTouch.end()) return true; // untracked: conservatively awake
+            return !stale(iter->second);
+        }
+
+        const std::vector<entity> & awake_entities() const { return awakeList; }
+        size_t tracked_count() const { return lastTouch.size(); }
+    };
+
     /////////////////////////////
     //   Entity Orchestrator   //
     /////////////////////////////
@@ -77,12 +198,20 @@ namespace polymer
     class entity_orchestrator
     {
         std::mutex createMutex;
-        std::unordered_map<poly_typeid, poly_typeid> system_type_map; // system-to-component-type
-        std::unordered_map<poly_typeid, std::unique_ptr<base_system>> systems;
-        entity entity_counter{ 0 }; // an autoincrementing value to generate unique ids
+        flat_hash_map<poly_typeid, poly_typeid> system_type_map; // system-to-component-type
+        flat_hash_map<poly_typeid, std::unique_ptr<base_system>> systems;
+        std::vector<uint32_t> generations{ 0 }; // per-slot generation, indexed by entity_index; slot 0 is kInvalidEntity
+        std::vector<uint32_t> free_indices;     // retired slots awaiting reuse (generation already bumped)
+        std::vector<entity> pending_destroys;   // batch accumulated by queue_destroy(), drained by flush_destroyed()
+        entity_activity_tracker activity;       // shared activity tier (see entity_activity_tracker)
 
     public:
 
+        // Systems reach the shared activity tier through the orchestrator they
+        // already hold; component attachment and retirement enroll and forget
+        // entities automatically
+        entity_activity_tracker & get_activity_tracker() { return activity; }
+
         template <typename T, typename... Args>
         T * create_system(Args &&... args)
         {
@@ -100,8 +229,114 @@ namespace polymer
         entity create_entity()
         {
             std::lock_guard<std::mutex> guard(createMutex);
-            const entity e = ++entity_counter;
-            return e;
+            if (!free_indices.empty())
+            {
+                const uint32_t index = free_indices.back();
+                free_indices.pop_back();
+                return make_entity(index, generations[index]);
+            }
+            const uint32_t index = static_cast<uint32_t>(generations.size());
+            generations.push_back(0);
+            return make_entity(index, 0);
+        }
+
+        // Reserves a contiguous range of |count| entity ids under a single lock.
+        // Spawning a large burst (particles, a streamed scene chunk) through
+        // create_entity() pays one mutex acquisition per id; this pays one total.
+        // Always allocates fresh slots (never the free list) so the returned
+        // indices are genuinely contiguous.
+        std::vector<entity> create_entities(const size_t count)
+        {
+            std::vector<entity> out(count);
+            {
+                std::lock_guard<std::mutex> guard(createMutex);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const uint32_t index = static_cast<uint32_t>(generations.size());
+                    generations.push_back(0);
+                    out[i] = make_entity(index, 0);
+                }
+            }
+            return out;
+        }
+
+        // O(1) liveness: true only for ids minted by create_entity()/create_entities()
+        // whose slot hasn't been recycled since. This is what lets systems cache
+        // component pointers across frames (unordered_map storage is node-stable)
+        // and validate them with an array compare instead of a hash lookup.
+        bool is_alive(const entity e) const
+        {
+            const uint32_t index = entity_index(e);
+            return index != 0 && index < generations.size() && generations[index] == entity_generation(e);
+        }
+
+        // Retires an id: bumps the slot generation (invalidating every outstanding
+        // copy) and queues the index for reuse. Component destruction is the
+        // caller's business (see environment::destroy / destroy_entities).
+        void retire_entity(const entity e)
+        {
+            std::lock_guard<std::mutex> guard(createMutex);
+            const uint32_t index = entity_index(e);
+            if (index == 0 || index >= generations.size() || generations[index] != entity_generation(e)) return;
+            ++generations[index];
+            free_indices.push_back(index);
+            activity.forget(e);
+        }
+
+        // Routes a contiguous array of |count| serialized components of type |hash|
+        // (one per entity, |stride| bytes apart) to the system registered for that
+        // component type, resolving the system once instead of per component.
+        bool create_components(const entity * entities, const size_t count, poly_typeid hash, void * data, const size_t stride)
+        {
+            auto itr = system_type_map.find(hash);
+            if (itr == system_type_map.end()) return false;
+
+            base_system * system = get_system(itr->second);
+            if (!system) return false;
+
+            for (size_t i = 0; i < count; ++i) activity.touch(entities[i]);
+            return system->create_bulk(entities, count, hash, data, stride);
+        }
+
+        // Typed convenience overload for the above.
+        template <typename C>
+        bool create_components(const entity * entities, const size_t count, C * components)
+        {
+            return create_components(entities, count, get_typeid<C>(), components, sizeof(C));
+        }
+
+        // Destroys all components for each entity in |entities|, handing the whole
+        // batch to every system once so pool-backed systems can compact in one pass.
+        void destroy_entities(const entity * entities, const size_t count)
+        {
+            for (auto & s : systems)
+            {
+                s.second->destroy_entities(entities, count);
+            }
+            for (size_t i = 0; i < count; ++i) retire_entity(entities[i]);
+        }
+
+        // Deferred destruction: unload requests raised mid-frame (streaming, gameplay)
+        // queue here and the accumulated batch executes at the frame boundary via
+        // flush_destroyed(), so no system sees components vanish underneath an
+        // in-progress update and each system still pays a single bulk pass.
+        void queue_destroy(const entity * entities, const size_t count)
+        {
+            std::lock_guard<std::mutex> guard(createMutex);
+            pending_destroys.insert(pending_destroys.end(), entities, entities + count);
+        }
+
+        // Call at a frame boundary; returns the number of entities destroyed.
+        size_t flush_destroyed()
+        {
+            std::vector<entity> batch;
+            {
+                std::lock_guard<std::mutex> guard(createMutex);
+                batch.swap(pending_destroys);
+            }
+            if (batch.empty()) return 0;
+            destroy_entities(batch.data(), batch.size());
+            return batch.size();
         }
 
         void add_system(const poly_typeid system_type, std::unique_ptr<base_system> system)
@@ -118,6 +353,26 @@ namespace polymer
             if (itr != systems.end()) return itr->second.get();
             else return nullptr;
         }
+
+        // Typed accessor for the above.
+        template <typename S>
+        S * get_system() { return static_cast<S *>(get_system(get_typeid<S>())); }
+
+        // Attaches |component| through the system registered for its type via the
+        // system_for_component trait. The binding resolves at compile time, so this
+        // is a single typed call into the owning system's create() overload with no
+        // virtual dispatch and no typeid comparison chain. Forwards that overload's
+        // return value (bool or a pointer to the stored component, system-dependent).
+        template <typename C>
+        auto attach(entity e, C && component)
+            -> decltype(std::declval<typename system_for_component<typename std::decay<C>::type>::type &>().create(e, std::forward<C>(component)))
+        {
+            using system_t = typename system_for_component<typename std::decay<C>::type>::type;
+            system_t * system = get_system<system_t>();
+            assert(system != nullptr);
+            activity.touch(e); // new components start in the awake tier
+            return system->create(e, std::forward<C>(component));
+        }
     };
 
     inline void base_system::register_system_for_type(poly_typeid system_type, poly_typeid component_type) 
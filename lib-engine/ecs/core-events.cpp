@@ -5,6 +5,8 @@
  */
 
 #include "core-events.hpp"
+#include <algorithm>
+#include <atomic>
 #include <unordered_map>
 
 namespace polymer
@@ -18,7 +20,7 @@ namespace polymer
         if (life == lifetime::concrete)
         {
             pointer_op(op::destruct, data, nullptr);
-            polymer_aligned_free(data);
+            if (store == storage::external) polymer_aligned_free(data);
         }
     }
 
@@ -27,7 +29,17 @@ namespace polymer
     {
         if (rhs.data)
         {
-            data = polymer_aligned_alloc(size, align);
+            // Small payloads (the overwhelmingly common case) are captured inline;
+            // only oversized or over-aligned events pay for a heap allocation.
+            if (size <= inline_payload_capacity && align <= alignof(std::max_align_t))
+            {
+                store = storage::inlined;
+                data = &local;
+            }
+            else
+            {
+                data = polymer_aligned_alloc(size, align);
+            }
             pointer_op(op::copy, data, rhs.data);
         }
     }
@@ -57,6 +69,16 @@ namespace polymer
         std::vector<std::pair<poly_typeid, tagged_event_handler>> command_queue;
         std::unordered_multimap<poly_typeid, tagged_event_handler> map;
 
+        // Counting filter over handler types. Unlike `map`, it is safe to read
+        // from producer threads without a lock: slot collisions and stale counts
+        // only ever over-approximate ("might have handlers"), never under.
+        static constexpr size_t filter_slots = 256;
+        std::atomic<int32_t> filter_counts[filter_slots]{};
+
+        static size_t filter_slot(poly_typeid type) { return static_cast<size_t>((type * 0x9e3779b97f4a7c15ull) >> 56) & (filter_slots - 1); }
+        void filter_add(poly_typeid type) { filter_counts[filter_slot(type)].fetch_add(1, std::memory_order_relaxed); }
+        void filter_remove(poly_typeid type) { filter_counts[filter_slot(type)].fetch_sub(1, std::memory_order_relaxed); }
+
         void remove_impl(poly_typeid type, tagged_event_handler handler)
         {
             assert(handler.fn == nullptr);
@@ -69,14 +91,14 @@ namespace polymer
             {
                 for (auto it = range.first; it != range.second; ++it)
                 {
-                    if (it->second.id == handler.id) map.erase(it); return;
+                    if (it->second.id == handler.id) { filter_remove(it->first); map.erase(it); } return;
                 }
             }
             else if (handler.owner)
             {
                 for (auto it = range.first; it != range.second;)
                 {
-                    if (it->second.owner == handler.owner) it = map.erase(it);
+                    if (it->second.owner == handler.owner) { filter_remove(it->first); it = map.erase(it); }
                     else ++it;
                 }
             }
@@ -92,6 +114,7 @@ namespace polymer
             {
                 assert(handler.id != 0);
                 assert(handler.fn != nullptr);
+                filter_add(type);
                 map.emplace(type, std::move(handler));
             }
         }
@@ -123,7 +146,7 @@ namespace polymer
             {
                 for (auto & cmd : command_queue)
                 {
-                    if (cmd.second.fn) map.emplace(cmd.first, std::move(cmd.second)); // queue a remove operation
+                    if (cmd.second.fn) { filter_add(cmd.first); map.emplace(cmd.first, std::move(cmd.second)); } // queue a remove operation
                     else remove_impl(cmd.first, std::move(cmd.second)); // execute remove
                 }
                 command_queue.clear();
@@ -134,6 +157,13 @@ namespace polymer
 
         size_t size() const { return map.size(); }
         size_t handler_count(poly_typeid type) { return map.count(type); }
+
+        // Approximate and lock-free; consulted by queued managers at post time
+        bool maybe_has_handlers(poly_typeid type) const
+        {
+            return filter_counts[filter_slot(type)].load(std::memory_order_relaxed) > 0
+                || filter_counts[filter_slot(0)].load(std::memory_order_relaxed) > 0; // connect_all handlers key on 0
+        }
     };
 
     ///////////////////////////////////////////
@@ -157,6 +187,52 @@ namespace polymer
         return handlers->dispatch(event_w);
     }
 
+    void event_manager_sync::set_coalesce_policy(poly_typeid type, coalesce_policy policy)
+    {
+        if (policy == coalesce_policy::none) coalesce_rules.erase(type);
+        else coalesce_rules[type].policy = policy;
+    }
+
+    bool event_manager_sync::dispatch_batch(std::vector<event_wrapper *> & batch)
+    {
+        // Group events of the same type together so each handler list is walked
+        // once per batch rather than re-fetched per event. stable_sort preserves
+        // the arrival order of same-type events.
+        std::stable_sort(batch.begin(), batch.end(),
+            [](const event_wrapper * a, const event_wrapper * b) { return a->get_type() < b->get_type(); });
+
+        bool handled = false;
+
+        size_t begin = 0;
+        while (begin < batch.size())
+        {
+            const poly_typeid type = batch[begin]->get_type();
+            size_t end = begin + 1;
+            while (end < batch.size() && batch[end]->get_type() == type) ++end;
+
+            const auto rule = coalesce_rules.find(type);
+            const coalesce_policy policy = (rule != coalesce_rules.end()) ? rule->second.policy : coalesce_policy::none;
+
+            if (policy == coalesce_policy::keep_latest)
+            {
+                handled |= event_manager_sync::send_internal(*batch[end - 1]); // newest instance only
+            }
+            else if (policy == coalesce_policy::accumulate && rule->second.combine)
+            {
+                for (size_t i = begin + 1; i < end; ++i) rule->second.combine(*batch[begin], *batch[i]);
+                handled |= event_manager_sync::send_internal(*batch[begin]);
+            }
+            else
+            {
+                for (size_t i = begin; i < end; ++i) handled |= event_manager_sync::send_internal(*batch[i]);
+            }
+
+            begin = end;
+        }
+
+        return handled;
+    }
+
     void event_manager_sync::connection::disconnect()
     {
         if (auto handler = handlers.lock())
@@ -182,10 +258,19 @@ namespace polymer
     //   event_manager_async implementation   //
     ////////////////////////////////////////////
 
+    event_manager_async::~event_manager_async()
+    {
+        // Anything still queued at teardown was never dispatched; recycle so the
+        // pool's leak accounting stays clean
+        event_wrapper * event = nullptr;
+        while (queue.try_consume(event)) wrapper_pool.destroy(event);
+    }
+
     bool event_manager_async::send_internal(const event_wrapper & event_w)
     {
-        std::unique_ptr<event_wrapper> event_copy(new event_wrapper(event_w));
-        queue.produce(std::move(event_copy));
+        if (post_filter_enabled && !handlers->maybe_has_handlers(event_w.get_type())) return false;
+        event_wrapper * event_copy = wrapper_pool.construct(event_w);
+        queue.produce(event_copy);
         return true;
     }
 
@@ -196,11 +281,54 @@ namespace polymer
 
     void event_manager_async::process()
     {
-        std::unique_ptr<event_wrapper> event;
-        while (queue.try_consume(event))
+        // With no coalescing configured, dispatch in strict arrival order
+        if (coalesce_rules.empty())
         {
-            event_manager_sync::send_internal(*event);
+            event_wrapper * event = nullptr;
+            while (queue.try_consume(event))
+            {
+                event_manager_sync::send_internal(*event);
+                wrapper_pool.destroy(event);
+            }
+            return;
         }
+
+        std::vector<event_wrapper *> batch;
+
+        event_wrapper * event = nullptr;
+        while (queue.try_consume(event)) batch.push_back(event);
+
+        if (!batch.empty()) dispatch_batch(batch);
+
+        for (event_wrapper * w : batch) wrapper_pool.destroy(w);
+    }
+
+    ///////////////////////////////////////////////
+    //   event_manager_deferred implementation   //
+    ///////////////////////////////////////////////
+
+    bool event_manager_deferred::send_internal(const event_wrapper & event_w)
+    {
+        if (post_filter_enabled && !handlers->maybe_has_handlers(event_w.get_type())) return false;
+
+        // The arena copy-constructs a concrete wrapper into a recycled slot,
+        // keeping the payload alive until the consumer dispatches it.
+        arena.post(event_w);
+        return true;
+    }
+
+    void event_manager_deferred::process()
+    {
+        drain_buffer.clear();
+        arena.drain(drain_buffer);
+        if (drain_buffer.empty()) return;
+
+        // dispatch_batch sorts by type so each handler list is walked once per
+        // batch, and applies any coalescing policies to same-type runs.
+        dispatch_batch(drain_buffer);
+
+        for (event_wrapper * e : drain_buffer) arena.release(e);
+        drain_buffer.clear();
     }
 
 } // end namespace polymer
@@ -12,6 +12,8 @@
 #include "typeid.hpp"
 #include "core-ecs.hpp"
 #include "queue-mpmc-blocking.hpp"
+#include "queue-mpmc-bounded.hpp"
+#include "memory-pool.hpp"
 
 namespace polymer
 {
@@ -23,10 +25,18 @@ namespace polymer
     /// It was changed to only support the notion of a "concrete" event, a compile-time
     /// event definition (as separate from a potential future runtime-definable events
     /// using a variant type). The wrapper idea persists in Polymer as a point of future extension. 
-    /// An `event_wrapper` by default does not own an event, however a copy operation 
-    /// fully copies the underlying event and assumes ownership. 
+    /// An `event_wrapper` by default does not own an event, however a copy operation
+    /// fully copies the underlying event and assumes ownership. Owned payloads at or
+    /// under `inline_payload_capacity` bytes are captured in storage inside the wrapper
+    /// itself, so copying a typical small event performs no heap allocation.
     class event_wrapper
     {
+    public:
+
+        static constexpr size_t inline_payload_capacity = 64;
+
+    private:
+
         enum op : uint32_t
         {
             copy,
@@ -39,6 +49,12 @@ namespace polymer
             concrete,
         };
 
+        enum storage : uint32_t
+        {
+            external, // payload lives outside the wrapper (caller-owned or heap)
+            inlined,  // payload was copied into `local` below
+        };
+
         using pointer_fn = void(*)(op, void *, const void *);
         mutable pointer_fn pointer_op{ nullptr };
 
@@ -57,6 +73,9 @@ namespace polymer
         mutable size_t align{ 0 };          // alignof() the wrapped event.
         mutable void * data{ nullptr };     // pointer to the wrapped event.
         mutable lifetime life{ transient }; // ownership of the wrapped event
+        mutable storage store{ external };  // where an owned payload resides
+
+        mutable typename std::aligned_storage<inline_payload_capacity, alignof(std::max_align_t)>::type local;
 
     public:
 
@@ -82,6 +101,17 @@ namespace polymer
     typedef uint32_t connection_id; // unique id per event
     typedef std::function<void(const event_wrapper & evt)> event_handler;
 
+    // How a queued event manager treats multiple instances of the same event type
+    // found in one drain. High-frequency sources (per-entity transform-changed
+    // notifications, tracked-controller input) can post thousands of instances per
+    // frame that a handler only needs the net effect of.
+    enum class coalesce_policy : uint32_t
+    {
+        none,        // dispatch every queued instance (default)
+        keep_latest, // only the newest instance of the type survives the drain
+        accumulate   // fold all instances into one via a user-provided combiner
+    };
+
     ////////////////////////////
     //   event_manager_sync   //
     ////////////////////////////
@@ -130,6 +160,19 @@ namespace polymer
         connection_id id{ 0 }; // autoincrementing counter
         std::shared_ptr<event_handler_map> handlers;
 
+        struct coalesce_rule
+        {
+            coalesce_policy policy{ coalesce_policy::none };
+            std::function<void(const event_wrapper & into, const event_wrapper & next)> combine; // accumulate only
+        };
+
+        std::unordered_map<poly_typeid, coalesce_rule> coalesce_rules; // configured at setup, read during drains
+
+        // Dispatches a drained batch of owned wrappers, applying any per-type
+        // coalescing policies. Sorts the batch by type in-place; used by the
+        // queued managers from process().
+        bool dispatch_batch(std::vector<event_wrapper *> & batch);
+
         // Function declaration that is used to extract a type from the event handler
         template <typename Fn, typename Arg> Arg connect_helper(void (Fn::*)(const Arg &) const);
         template <typename Fn, typename Arg> Arg connect_helper(void (Fn::*)(const Arg &));
@@ -156,6 +199,35 @@ namespace polymer
             return send_internal(event_wrapper(event));
         }
 
+        // Registers how queued managers treat a burst of same-type events within
+        // one process() drain. The sync manager dispatches immediately and never
+        // coalesces. `accumulate` requires a combiner (see set_accumulator).
+        void set_coalesce_policy(poly_typeid type, coalesce_policy policy);
+
+        template <typename E>
+        void set_coalesce_policy(const coalesce_policy policy) { set_coalesce_policy(get_typeid<E>(), policy); }
+
+        // Installs the accumulate policy for E: `combine(into, next)` folds each
+        // superseded event into the survivor, which is then dispatched once.
+        template <typename E>
+        void set_accumulator(std::function<void(E & into, const E & next)> combine)
+        {
+            coalesce_rule rule;
+            rule.policy = coalesce_policy::accumulate;
+            rule.combine = [combine](const event_wrapper & into, const event_wrapper & next)
+            {
+                combine(*const_cast<E *>(into.get<E>()), *next.get<E>());
+            };
+            coalesce_rules[get_typeid<E>()] = std::move(rule);
+        }
+
+        // When enabled, the queued managers consult an approximate per-type handler
+        // count at post time and drop events with provably no subscriber instead of
+        // copying them into the queue. Connections made concurrently with posting
+        // may transiently read as absent, so enable this only for fire-and-forget
+        // notification traffic (e.g. per-entity transform-changed floods).
+        bool post_filter_enabled{ false };
+
         // A connection that must be manually disconnected. If a non-null
         // owner is specified, the pointer can be used by users of the
         // event handler as an additional way to disconnect beyond calling
@@ -213,14 +285,18 @@ namespace polymer
     // they are sent and handled (otherwise we'd run into lifetime issues). 
     class event_manager_async : public event_manager_sync
     {
-        mpmc_queue_blocking<std::unique_ptr<event_wrapper>> queue;
+        // Queued copies recycle through a pool instead of one heap round-trip per
+        // send; producers on worker threads hit their thread-local cache, not the
+        // global allocator.
+        mpmc_queue_blocking<event_wrapper *> queue;
+        object_pool<event_wrapper> wrapper_pool;
         virtual bool send_internal(const event_wrapper & event_w) override final;
         event_manager_async(const event_manager_async &) = delete;
         event_manager_async & operator=(const event_manager_async &) = delete;
     public:
 
         event_manager_async() = default;
-        ~event_manager_async() = default;
+        ~event_manager_async();
 
         // Call this regularly to pump the message queue. 
         // Event processing will happen on the calling thread. It's required that 
@@ -230,6 +306,115 @@ namespace polymer
         bool empty() const;
     };
 
+    /////////////////////
+    //   event_arena   //
+    /////////////////////
+
+    // Fixed slab of recyclable event slots. A slot holds the wrapper (whose small
+    // payloads are captured inline) and doubles as the queue link, so posting an
+    // event in steady state performs zero heap allocations: the wrapper is
+    // constructed into a recycled slot and the slot itself is the pending-list
+    // node. Slots return to a lock-free free list after dispatch rather than the
+    // arena resetting wholesale, because producers may post concurrently with the
+    // consumer's drain. Exhaustion (a frame spike with more than `count` events
+    // in flight) spills to the heap and heals itself once the spike passes.
+    class event_arena
+    {
+        struct slot
+        {
+            // Storage must stay the first member: a wrapper pointer handed out by
+            // drain() is cast back to its owning slot in release().
+            typename std::aligned_storage<sizeof(event_wrapper), alignof(event_wrapper)>::type storage;
+            std::atomic<slot *> next{ nullptr };
+            bool pooled{ true };
+        };
+
+        std::unique_ptr<slot[]> slots;
+        mpmc_queue_bounded<slot *> free_list;
+        std::atomic<slot *> pending{ nullptr }; // CAS-pushed stack; push-only, so no ABA
+
+        event_arena(const event_arena &) = delete;
+        event_arena & operator=(const event_arena &) = delete;
+
+    public:
+
+        // `count` must be a power of two (free list requirement)
+        explicit event_arena(const size_t count = 1024) : slots(new slot[count]), free_list(count)
+        {
+            for (size_t i = 0; i < count; ++i) free_list.mp_produce(&slots[i]);
+        }
+
+        ~event_arena()
+        {
+            // Anything still pending at teardown was never dispatched
+            std::vector<event_wrapper *> remaining;
+            drain(remaining);
+            for (event_wrapper * w : remaining) release(w);
+        }
+
+        // Copies `e` into a slot and publishes it. Lock-free; any thread.
+        void post(const event_wrapper & e)
+        {
+            slot * s = nullptr;
+            if (!free_list.consume(s)) { s = new slot(); s->pooled = false; } // spike past the slab
+            new (&s->storage) event_wrapper(e);
+
+            slot * expected = pending.load(std::memory_order_relaxed);
+            do { s->next.store(expected, std::memory_order_relaxed); }
+            while (!pending.compare_exchange_weak(expected, s, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Steals every published slot and appends the wrappers to `out` in
+        // arrival order. Single consumer thread only.
+        void drain(std::vector<event_wrapper *> & out)
+        {
+            slot * s = pending.exchange(nullptr, std::memory_order_acquire);
+            const size_t first = out.size();
+            while (s) { out.push_back(reinterpret_cast<event_wrapper *>(&s->storage)); s = s->next.load(std::memory_order_relaxed); }
+            std::reverse(out.begin() + first, out.end()); // the stolen stack is newest-first
+        }
+
+        // Destroys a drained wrapper and recycles its slot
+        void release(event_wrapper * w)
+        {
+            slot * s = reinterpret_cast<slot *>(w);
+            w->~event_wrapper();
+            if (s->pooled) free_list.mp_produce(s);
+            else delete s;
+        }
+    };
+
+    ////////////////////////////////
+    //   event_manager_deferred   //
+    ////////////////////////////////
+
+    // A lock-free variant of the async manager for publishers on worker threads.
+    // send() copies the event into a recycled `event_arena` slot, so a producer
+    // (for instance a physics contact callback running on Bullet's thread) never
+    // takes a mutex, never runs handlers inline, and in steady state never touches
+    // the heap. process() drains the arena at a defined frame point on a single
+    // consumer thread, stable-sorts the drained batch by event type, and
+    // dispatches each group back-to-back so the handler list for a given type
+    // stays hot in cache. Ordering between different event types is therefore not
+    // preserved across a drain; ordering of same-type events from a single
+    // producer is.
+    class event_manager_deferred : public event_manager_sync
+    {
+        event_arena arena;
+        std::vector<event_wrapper *> drain_buffer; // scratch used by process() only
+        virtual bool send_internal(const event_wrapper & event_w) override final;
+        event_manager_deferred(const event_manager_deferred &) = delete;
+        event_manager_deferred & operator=(const event_manager_deferred &) = delete;
+    public:
+
+        event_manager_deferred() = default;
+        ~event_manager_deferred() = default;
+
+        // Drains and dispatches all queued events on the calling thread. It's
+        // required that this function is only invoked from a single thread.
+        virtual void process() override final;
+    };
+
 } // end namespace polymer
 
 #endif // end polymer_core_events_hpp
@@ -87,11 +87,36 @@ namespace polymer
         return T::TYPEID_NOT_SETUP;
     }
 
+    // Constexpr so that ids resolved from a type (rather than a serialized name) fold
+    // to integer constants at compile time and are usable as switch case labels.
     template <typename T>
-    poly_typeid get_typeid() { return T::TYPEID_NOT_SETUP; }
+    constexpr poly_typeid get_typeid() { return T::TYPEID_NOT_SETUP; }
 
     inline poly_typeid get_typeid(const char * name) { return polymer::hash(name); }
 
+    // A poly_typeid is a 64-bit name hash: stable across builds and runs, which is what
+    // serialization needs, but useless as an array subscript. get_type_index<T>() assigns
+    // each type a small dense index the first time it is queried, so hot dispatch tables
+    // can be flat arrays indexed directly instead of hash maps. Indices depend on
+    // first-touch order and are only stable for the lifetime of the process — anything
+    // persisted must keep using poly_typeid.
+    constexpr uint32_t max_poly_type_indices = 256;
+
+    inline uint32_t allocate_type_index()
+    {
+        static std::atomic<uint32_t> next_index{ 0 };
+        const uint32_t index = next_index++;
+        assert(index < max_poly_type_indices);
+        return index;
+    }
+
+    template <typename T>
+    uint32_t get_type_index()
+    {
+        static const uint32_t index = allocate_type_index();
+        return index;
+    }
+
     template <typename T>
     struct typeid_traits { static constexpr bool kHasTypeId = false; };
 
@@ -105,9 +130,9 @@ namespace polymer
         return #X;                                      \
     }                                                   \
     template <>                                         \
-        inline poly_typeid get_typeid<X>() {            \
+        constexpr poly_typeid get_typeid<X>() {         \
         return polymer::const_hash(#X);                 \
-    }                                          
+    }
 
     //////////////////////////////
     //   poly_typeid registry   //
@@ -8,6 +8,10 @@
 #include "file_io.hpp"
 #include "serialization.hpp"
 
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+
 using namespace polymer;
 
 render_component polymer::assemble_render_component(environment & env, const entity e)
@@ -17,6 +21,67 @@ render_component polymer::assemble_render_component(environment & env, const ent
     r.mesh = env.render_system->get_mesh_component(e);
     r.world_transform = env.xform_system->get_world_transform(e);
     r.local_transform = env.xform_system->get_local_transform(e);
+
+    // Derive a world-space bounding sphere from the entity's cpu-side geometry, if it has any.
+    // The renderer's occlusion culling stage treats a zero radius as "always visible".
+    if (geometry_component * gc = env.collision_system->get_component(e))
+    {
+        if (gc->geom.assigned() && r.world_transform && r.local_transform)
+        {
+            const aabb_3d & bounds = gc->get_local_bounds();
+            const float3 scale = r.local_transform->local_scale;
+            const float3 world_center = r.world_transform->world_pose.transform_coord(bounds.center() * scale);
+            const float radius = 0.5f * length(bounds.size() * scale);
+            r.world_bounding_sphere = float4(world_center, radius);
+        }
+    }
+
+    // Skinned entities carry their current bone palette into the renderer
+    if (skinned_mesh_state * skin = env.render_system->get_skinned_mesh_state(e))
+    {
+        if (!skin->skeleton.palette.empty()) r.bone_palette = &skin->skeleton.palette;
+    }
+
+    r.lod = env.render_system->get_lod_component(e);
+
+    return r;
+}
+
+render_component polymer::assemble_render_component(environment & env, const entity e, const float3 & view_position)
+{
+    render_component r = assemble_render_component(env, e);
+
+    if (r.lod && r.mesh)
+    {
+        // Distance to the same bounds the cull works with: surface of the world
+        // bounding sphere when geometry gave us one, the pivot otherwise
+        float view_distance = 0.f;
+        if (r.world_bounding_sphere.w > 0.f)
+        {
+            view_distance = std::max(0.f, length(r.world_bounding_sphere.xyz() - view_position) - r.world_bounding_sphere.w);
+        }
+        else if (r.world_transform)
+        {
+            view_distance = length(r.world_transform->world_pose.position - view_position);
+        }
+
+        r.mesh = r.lod->select(r.mesh, view_distance);
+    }
+
+    // Past its transition distance an entity with a baked impostor leaves the mesh
+    // path entirely; the renderer routes it into the instanced impostor batch
+    if (impostor_state * imp = env.render_system->get_impostor_state(e))
+    {
+        if (imp->atlas.ready() && r.world_transform)
+        {
+            const float view_distance = (r.world_bounding_sphere.w > 0.f)
+                ? length(r.world_bounding_sphere.xyz() - view_position)
+                : length(r.world_transform->world_pose.position - view_position);
+
+            if (view_distance >= imp->transition_distance) r.impostor = &imp->atlas;
+        }
+    }
+
     return r;
 }
 
@@ -64,6 +129,9 @@ void environment::destroy(entity e)
             {
                 if (system_pointer) system_pointer->destroy(active);
             });
+
+            // Retire the id so any stale copy of it fails is_alive()
+            if (xform_system) xform_system->orchestrator->retire_entity(active);
         }
         active_entities.clear();
         log::get()->engine_log->info("[environment] destroyed all entities");
@@ -78,10 +146,35 @@ void environment::destroy(entity e)
             if (system_pointer) system_pointer->destroy(e);
         });
 
+        // Retire the id so any stale copy of it fails is_alive()
+        if (xform_system) xform_system->orchestrator->retire_entity(e);
+
         log::get()->engine_log->info("[environment] destroyed single entity {}", e);
     }
 }
 
+void environment::destroy_entities(const std::vector<entity> & entities)
+{
+    if (entities.empty()) return;
+
+    // One batch call per system; pool-backed systems compact in a single sweep
+    // instead of paying a hash erase and swap-removal per entity
+    visit_systems(this, [&entities](const char * name, auto * system_pointer)
+    {
+        if (system_pointer) system_pointer->destroy_entities(entities.data(), entities.size());
+    });
+
+    // Remove from the active list in one sweep, then retire every id so any stale
+    // copies fail is_alive()
+    std::unordered_set<entity> doomed(entities.begin(), entities.end());
+    active_entities.erase(std::remove_if(active_entities.begin(), active_entities.end(),
+        [&doomed](const entity e) { return doomed.count(e) != 0; }), active_entities.end());
+
+    if (xform_system) for (const entity e : entities) xform_system->orchestrator->retire_entity(e);
+
+    log::get()->engine_log->info("[environment] destroyed {} entities", entities.size());
+}
+
 void environment::import_environment(const std::string & import_path, entity_orchestrator & o)
 {
     manual_timer t;
@@ -135,6 +228,12 @@ void environment::import_environment(const std::string & import_path, entity_orc
                             c.e = new_entity;
                             if (system_pointer->create(new_entity, id, &c)) std::cout << "Created " << type_name << " on " << system_name << std::endl;
                         }
+                        else if (type_name == get_typename<lod_component>())
+                        {
+                            lod_component c = componentIterator.value();
+                            c.e = new_entity;
+                            if (system_pointer->create(new_entity, id, &c)) std::cout << "Created " << type_name << " on " << system_name << std::endl;
+                        }
                         else if (type_name == get_typename<material_component>())
                         {
                             material_component c = componentIterator.value();
@@ -159,6 +258,12 @@ void environment::import_environment(const std::string & import_path, entity_orc
                             c.e = new_entity;
                             if (system_pointer->create(new_entity, id, &c)) std::cout << "Created " << type_name << " on " << system_name << std::endl;
                         }
+                        else if (type_name == get_typename<reflection_probe_component>())
+                        {
+                            reflection_probe_component c = componentIterator.value();
+                            c.e = new_entity;
+                            if (system_pointer->create(new_entity, id, &c)) std::cout << "Created " << type_name << " on " << system_name << std::endl;
+                        }
                         else if (type_name == get_typename<local_transform_component>())
                         {
                             // Create a new graph component
@@ -198,11 +303,526 @@ void environment::import_environment(const std::string & import_path, entity_orc
     log::get()->engine_log->info("importing {} took {}ms", import_path, t.get());
 }
 
-void environment::export_environment(const std::string & export_path) 
+//////////////////////////////////////
+//   binary environment container   //
+//////////////////////////////////////
+
+// Layout (all little-endian, version 1):
+//   uint32 magic 'PLYB' | uint32 version
+//   string table: uint32 count, then per string uint32 length + bytes (index 0 is always "")
+//   entity list:  uint64 count, then raw uint64 ids (remapped on import)
+//   component blocks, until EOF: uint32 block tag | uint64 record count | records
+// Records are raw POD fields; strings (handle names, identifiers) are stored as
+// uint32 indices into the string table so repeated asset names cost 4 bytes.
+
+namespace
+{
+    constexpr uint32_t polymer_binary_magic = 0x42594c50; // 'PLYB'
+    constexpr uint32_t polymer_binary_version = 1;
+
+    enum class binary_block : uint32_t
+    {
+        identifier = 1,
+        mesh = 2,
+        material = 3,
+        geometry = 4,
+        point_light = 5,
+        directional_light = 6,
+        reflection_probe = 7,
+        local_transform = 8,
+        lod = 9
+    };
+
+    struct binary_writer
+    {
+        std::vector<uint8_t> buffer;
+
+        template <typename T>
+        void write(const T & value)
+        {
+            // Not is_trivially_copyable: linalg::vec has a user-provided copy-assignment
+            // operator, which disqualifies it per the standard even though its bytes are
+            // memcpy-safe. Destructibility plus standard layout covers what raw io needs.
+            static_assert(std::is_trivially_destructible<T>::value && std::is_standard_layout<T>::value,
+                "raw write requires a standard-layout, trivially destructible type");
+            const uint8_t * bytes = reinterpret_cast<const uint8_t *>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+    };
+
+    struct binary_reader
+    {
+        const uint8_t * cursor{ nullptr };
+        const uint8_t * end{ nullptr };
+
+        binary_reader(const std::vector<uint8_t> & data) : cursor(data.data()), end(data.data() + data.size()) {}
+
+        bool eof() const { return cursor == end; }
+
+        template <typename T>
+        T read()
+        {
+            static_assert(std::is_trivially_destructible<T>::value && std::is_standard_layout<T>::value,
+                "raw read requires a standard-layout, trivially destructible type");
+            if (cursor + sizeof(T) > end) throw std::runtime_error("binary environment: unexpected end of file");
+            T value;
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+    };
+
+    // Deduplicates strings on export; index 0 is reserved for the empty string so
+    // unassigned handles ("empty") round-trip the same way the JSON path writes them.
+    struct binary_string_table
+    {
+        std::vector<std::string> strings{ "" };
+        std::unordered_map<std::string, uint32_t> index{ { "", 0 } };
+
+        uint32_t intern(const std::string & s)
+        {
+            auto iter = index.find(s);
+            if (iter != index.end()) return iter->second;
+            const uint32_t idx = static_cast<uint32_t>(strings.size());
+            strings.push_back(s);
+            index[s] = idx;
+            return idx;
+        }
+    };
+
+    // Handle names serialize as "" when unassigned, mirroring the to_json adapters.
+    template <typename HandleT>
+    uint32_t intern_handle(binary_string_table & table, const HandleT & handle)
+    {
+        return table.intern(handle.name == "empty" ? "" : handle.name);
+    }
+}
+
+// Serializes a subset of the tracked entities into the binary container layout
+// described above. Shared by the whole-scene export and the chunked export.
+std::vector<uint8_t> environment::serialize_entities_binary(const std::vector<entity> & entities)
+{
+    binary_string_table strings;
+    binary_writer body; // everything after the string table; the table is only complete once all strings are interned
+
+    // Entity list
+    body.write<uint64_t>(entities.size());
+    for (const entity e : entities) body.write<uint64_t>(e);
+
+    // Component blocks. Each block gathers its records up front so the count
+    // prefix can be written before the raw data.
+    {
+        std::vector<std::pair<entity, std::string>> identifiers;
+        for (const entity e : entities)
+        {
+            const std::string name = identifier_system->get_name(e);
+            if (!name.empty()) identifiers.emplace_back(e, name);
+        }
+        body.write(binary_block::identifier);
+        body.write<uint64_t>(identifiers.size());
+        for (auto & pair : identifiers)
+        {
+            body.write<uint64_t>(pair.first);
+            body.write<uint32_t>(strings.intern(pair.second));
+        }
+    }
+
+    {
+        std::vector<mesh_component *> components;
+        for (const entity e : entities) if (auto * c = render_system->get_mesh_component(e)) components.push_back(c);
+        body.write(binary_block::mesh);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write<uint32_t>(intern_handle(strings, c->mesh));
+        }
+    }
+
+    {
+        std::vector<lod_component *> components;
+        for (const entity e : entities) if (auto * c = render_system->get_lod_component(e)) components.push_back(c);
+        body.write(binary_block::lod);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write<uint32_t>(intern_handle(strings, c->lod1));
+            body.write<uint32_t>(intern_handle(strings, c->lod2));
+            body.write<uint32_t>(intern_handle(strings, c->lod3));
+            body.write<float>(c->lod1_distance);
+            body.write<float>(c->lod2_distance);
+            body.write<float>(c->lod3_distance);
+        }
+    }
+
+    {
+        std::vector<material_component *> components;
+        for (const entity e : entities) if (auto * c = render_system->get_material_component(e)) components.push_back(c);
+        body.write(binary_block::material);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write<uint32_t>(intern_handle(strings, c->material));
+            body.write<uint8_t>(c->receive_shadow ? 1 : 0);
+            body.write<uint8_t>(c->cast_shadow ? 1 : 0);
+        }
+    }
+
+    {
+        std::vector<geometry_component *> components;
+        for (const entity e : entities) if (auto * c = collision_system->get_component(e)) components.push_back(c);
+        body.write(binary_block::geometry);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write<uint32_t>(intern_handle(strings, c->geom));
+        }
+    }
+
+    {
+        std::vector<point_light_component *> components;
+        for (const entity e : entities) if (auto * c = render_system->get_point_light_component(e)) components.push_back(c);
+        body.write(binary_block::point_light);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write<uint8_t>(c->enabled ? 1 : 0);
+            body.write(c->data.position);
+            body.write(c->data.color);
+            body.write(c->data.radius);
+        }
+    }
+
+    {
+        std::vector<directional_light_component *> components;
+        for (const entity e : entities) if (auto * c = render_system->get_directional_light_component(e)) components.push_back(c);
+        body.write(binary_block::directional_light);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write<uint8_t>(c->enabled ? 1 : 0);
+            body.write(c->data.direction);
+            body.write(c->data.color);
+            body.write(c->data.amount);
+        }
+    }
+
+    {
+        std::vector<reflection_probe_component *> components;
+        for (const entity e : entities) if (auto * c = render_system->get_reflection_probe_component(e)) components.push_back(c);
+        body.write(binary_block::reflection_probe);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write<uint8_t>(c->enabled ? 1 : 0);
+            body.write<uint32_t>(intern_handle(strings, c->source));
+            body.write(c->radius);
+            body.write(c->position);
+        }
+    }
+
+    {
+        std::vector<const local_transform_component *> components;
+        for (const entity e : entities) if (auto * c = xform_system->get_local_transform(e)) components.push_back(c);
+        body.write(binary_block::local_transform);
+        body.write<uint64_t>(components.size());
+        for (auto * c : components)
+        {
+            body.write<uint64_t>(c->get_entity());
+            body.write(c->local_pose.position);
+            body.write(c->local_pose.orientation);
+            body.write(c->local_scale);
+            body.write<uint64_t>(c->parent);
+            body.write<uint64_t>(c->children.size());
+            for (const entity child : c->children) body.write<uint64_t>(child);
+        }
+    }
+
+    // Assemble the final file: header, string table, body
+    binary_writer file;
+    file.write<uint32_t>(polymer_binary_magic);
+    file.write<uint32_t>(polymer_binary_version);
+    file.write<uint32_t>(static_cast<uint32_t>(strings.strings.size()));
+    for (const auto & s : strings.strings)
+    {
+        file.write<uint32_t>(static_cast<uint32_t>(s.size()));
+        file.buffer.insert(file.buffer.end(), s.begin(), s.end());
+    }
+    file.buffer.insert(file.buffer.end(), body.buffer.begin(), body.buffer.end());
+
+    return file.buffer;
+}
+
+void environment::export_environment_binary(const std::string & export_path)
+{
+    manual_timer t;
+    t.start();
+
+    write_file_binary(export_path, serialize_entities_binary(active_entities));
+
+    t.stop();
+    log::get()->engine_log->info("exporting binary {} took {}ms", export_path, t.get());
+}
+
+void environment::export_environment_chunks(const std::string & export_dir, const float cell_size)
 {
     manual_timer t;
     t.start();
 
+    // An entity travels with its transform root so parent/child references never
+    // cross a chunk boundary (the chunk importer rejects unknown entities).
+    const auto find_transform_root = [this](entity e)
+    {
+        while (true)
+        {
+            auto * lt = xform_system->get_local_transform(e);
+            if (!lt || lt->parent == kInvalidEntity) return e;
+            e = lt->parent;
+        }
+    };
+
+    std::map<std::pair<int32_t, int32_t>, std::vector<entity>> cells;
+    for (const entity e : active_entities)
+    {
+        float3 position{ 0, 0, 0 };
+        if (auto * wt = xform_system->get_world_transform(find_transform_root(e))) position = wt->world_pose.position;
+        const int32_t cx = static_cast<int32_t>(std::floor(position.x / cell_size));
+        const int32_t cy = static_cast<int32_t>(std::floor(position.z / cell_size));
+        cells[std::make_pair(cx, cy)].push_back(e);
+    }
+
+    json manifest;
+    manifest["cell_size"] = cell_size;
+    manifest["chunks"] = json::array();
+
+    for (auto & cell : cells)
+    {
+        const int32_t cx = cell.first.first;
+        const int32_t cy = cell.first.second;
+        const std::string file = "chunk_" + std::to_string(cx) + "_" + std::to_string(cy) + ".bin";
+
+        write_file_binary(export_dir + "/" + file, serialize_entities_binary(cell.second));
+
+        json entry;
+        entry["x"] = cx;
+        entry["y"] = cy;
+        entry["file"] = file;
+        entry["count"] = cell.second.size();
+        manifest["chunks"].push_back(entry);
+    }
+
+    write_file_text(export_dir + "/chunks.json", manifest.dump(4));
+
+    t.stop();
+    log::get()->engine_log->info("exporting {} scene chunks to {} took {}ms", cells.size(), export_dir, t.get());
+}
+
+void environment::import_environment_binary(const std::string & import_path, entity_orchestrator & o)
+{
+    manual_timer t;
+    t.start();
+
+    destroy(kAllEntities);
+    import_environment_binary_chunk(read_file_binary(import_path), o);
+
+    t.stop();
+    log::get()->engine_log->info("importing binary {} took {}ms", import_path, t.get());
+}
+
+// Additive import: the buffer's entities are created alongside whatever is already
+// tracked (nothing is destroyed) and returned so a streamer can unload exactly
+// this set later. The whole-scene import above is this preceded by destroy(kAllEntities).
+std::vector<entity> environment::import_environment_binary_chunk(const std::vector<uint8_t> & data, entity_orchestrator & o)
+{
+    binary_reader reader(data);
+
+    if (reader.read<uint32_t>() != polymer_binary_magic) throw std::runtime_error("binary environment: bad magic (not a polymer binary scene?)");
+    const uint32_t version = reader.read<uint32_t>();
+    if (version != polymer_binary_version) throw std::runtime_error("binary environment: unsupported version " + std::to_string(version));
+
+    // String table
+    std::vector<std::string> strings(reader.read<uint32_t>());
+    for (auto & s : strings)
+    {
+        const uint32_t length = reader.read<uint32_t>();
+        s.resize(length);
+        for (uint32_t i = 0; i < length; ++i) s[i] = static_cast<char>(reader.read<uint8_t>());
+    }
+
+    const auto lookup = [&strings](const uint32_t index) -> const std::string &
+    {
+        if (index >= strings.size()) throw std::runtime_error("binary environment: string index out of range");
+        return strings[index];
+    };
+
+    // Entity list; ids from the file are remapped onto freshly created entities
+    std::unordered_map<entity, entity> remap_table;
+    std::vector<entity> created;
+    const uint64_t entity_count = reader.read<uint64_t>();
+    created.reserve(entity_count);
+    for (uint64_t i = 0; i < entity_count; ++i)
+    {
+        const entity parsed_entity = reader.read<uint64_t>();
+        const entity fresh = track_entity(o.create_entity());
+        remap_table[parsed_entity] = fresh;
+        created.push_back(fresh);
+    }
+
+    const auto remap = [&remap_table](const entity e) -> entity
+    {
+        if (e == kInvalidEntity) return kInvalidEntity;
+        auto iter = remap_table.find(e);
+        if (iter == remap_table.end()) throw std::runtime_error("binary environment: unknown entity reference");
+        return iter->second;
+    };
+
+    // Component blocks
+    while (!reader.eof())
+    {
+        const binary_block block = reader.read<binary_block>();
+        const uint64_t count = reader.read<uint64_t>();
+
+        switch (block)
+        {
+            case binary_block::identifier:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    identifier_system->create(e, lookup(reader.read<uint32_t>()));
+                }
+                break;
+            }
+            case binary_block::mesh:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    mesh_component c(e);
+                    c.mesh = gpu_mesh_handle(lookup(reader.read<uint32_t>()));
+                    render_system->create(e, std::move(c));
+                }
+                break;
+            }
+            case binary_block::lod:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    lod_component c(e);
+                    c.lod1 = gpu_mesh_handle(lookup(reader.read<uint32_t>()));
+                    c.lod2 = gpu_mesh_handle(lookup(reader.read<uint32_t>()));
+                    c.lod3 = gpu_mesh_handle(lookup(reader.read<uint32_t>()));
+                    c.lod1_distance = reader.read<float>();
+                    c.lod2_distance = reader.read<float>();
+                    c.lod3_distance = reader.read<float>();
+                    render_system->create(e, std::move(c));
+                }
+                break;
+            }
+            case binary_block::material:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    material_component c(e);
+                    c.material = material_handle(lookup(reader.read<uint32_t>()));
+                    c.receive_shadow = (reader.read<uint8_t>() != 0);
+                    c.cast_shadow = (reader.read<uint8_t>() != 0);
+                    render_system->create(e, std::move(c));
+                }
+                break;
+            }
+            case binary_block::geometry:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    geometry_component c(e);
+                    c.geom = cpu_mesh_handle(lookup(reader.read<uint32_t>()));
+                    collision_system->create(e, std::move(c));
+                }
+                break;
+            }
+            case binary_block::point_light:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    point_light_component c(e);
+                    c.enabled = (reader.read<uint8_t>() != 0);
+                    c.data.position = reader.read<float3>();
+                    c.data.color = reader.read<float3>();
+                    c.data.radius = reader.read<float>();
+                    render_system->create(e, std::move(c));
+                }
+                break;
+            }
+            case binary_block::directional_light:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    directional_light_component c(e);
+                    c.enabled = (reader.read<uint8_t>() != 0);
+                    c.data.direction = reader.read<float3>();
+                    c.data.color = reader.read<float3>();
+                    c.data.amount = reader.read<float>();
+                    render_system->create(e, std::move(c));
+                }
+                break;
+            }
+            case binary_block::reflection_probe:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+                    reflection_probe_component c(e);
+                    c.enabled = (reader.read<uint8_t>() != 0);
+                    c.source = texture_handle(lookup(reader.read<uint32_t>()));
+                    c.radius = reader.read<float>();
+                    c.position = reader.read<float3>();
+                    render_system->create(e, std::move(c));
+                }
+                break;
+            }
+            case binary_block::local_transform:
+            {
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    const entity e = remap(reader.read<uint64_t>());
+
+                    transform local_pose;
+                    local_pose.position = reader.read<float3>();
+                    local_pose.orientation = reader.read<quatf>();
+                    const float3 local_scale = reader.read<float3>();
+                    const entity parent = remap(reader.read<uint64_t>());
+
+                    std::vector<entity> children(reader.read<uint64_t>());
+                    for (auto & child : children) child = remap(reader.read<uint64_t>());
+
+                    xform_system->create(e, local_pose, local_scale, parent, children);
+                }
+                break;
+            }
+            default: throw std::runtime_error("binary environment: unknown block tag");
+        }
+    }
+
+    // Finalize the transform system by refreshing the scene graph
+    xform_system->refresh();
+
+    return created;
+}
+
+json environment::serialize_environment()
+{
     json environment;
 
     // foreach entity (array)
@@ -237,8 +857,49 @@ void environment::export_environment(const std::string & export_path)
         environment[std::to_string(e)] = entity;
     }
 
+    return environment;
+}
+
+void environment::export_environment(const std::string & export_path)
+{
+    manual_timer t;
+    t.start();
+
+    const json environment = serialize_environment();
     write_file_text(export_path, environment.dump(4));
 
     t.stop();
     log::get()->engine_log->info("exporting {} took {}ms", export_path, t.get());
+}
+
+void environment::export_environment_async(const std::string & export_path)
+{
+    // The reflection walk is the copy-on-write boundary: component state is copied by
+    // value into the json document on this thread, so the worker never touches live
+    // systems and editing continues while it serializes.
+    manual_timer t;
+    t.start();
+    auto snapshot = std::make_shared<json>(serialize_environment());
+    t.stop();
+    log::get()->engine_log->info("snapshotting scene for async export took {}ms", t.get());
+
+    async_spawn([snapshot, export_path]()
+    {
+        manual_timer write_timer;
+        write_timer.start();
+
+        // Write beside the destination, then swap the finished file into place so a
+        // crash mid-write can never truncate the previous save.
+        const std::string temp_path = export_path + ".tmp";
+        write_file_text(temp_path, snapshot->dump(4));
+        std::remove(export_path.c_str());
+        if (std::rename(temp_path.c_str(), export_path.c_str()) != 0)
+        {
+            log::get()->engine_log->info("async export could not replace {}", export_path);
+            return;
+        }
+
+        write_timer.stop();
+        log::get()->engine_log->info("async export of {} took {}ms off-thread", export_path, write_timer.get());
+    });
 }
\ No newline at end of file
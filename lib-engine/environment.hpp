@@ -14,6 +14,7 @@
 #include "material.hpp"
 #include "material-library.hpp"
 #include "asset-handle-utils.hpp"
+#include "asset-namespace.hpp"
 
 #include "ecs/typeid.hpp"
 #include "ecs/core-ecs.hpp"
@@ -169,6 +170,68 @@ namespace polymer
         });
     };
 
+    ///////////////////////
+    //   lod_component   //
+    ///////////////////////
+
+    // Distance-ranked level-of-detail chain. Level zero is the entity's own
+    // mesh_component; each populated handle here takes over once the view distance
+    // to the entity's bounds passes its switch distance. Selection retargets the
+    // per-frame render_component, never the serialized mesh_component.
+    struct lod_component : public base_component
+    {
+        gpu_mesh_handle lod1, lod2, lod3;
+        float lod1_distance{ 15.f };
+        float lod2_distance{ 40.f };
+        float lod3_distance{ 100.f };
+
+        lod_component() {};
+        lod_component(entity e) : base_component(e) {}
+
+        // Returns the mesh to submit at `distance`, falling back to `base` (the
+        // entity's own mesh_component) inside the first switch distance. Shadow
+        // components hold the retargeted handles so callers get a stable
+        // mesh_component pointer without this chain touching the real one.
+        mesh_component * select(mesh_component * base, const float distance)
+        {
+            const gpu_mesh_handle * handles[3] = { &lod1, &lod2, &lod3 };
+            const float distances[3] = { lod1_distance, lod2_distance, lod3_distance };
+
+            mesh_component * result = base;
+            for (int level = 0; level < 3; ++level)
+            {
+                if (!handles[level]->assigned() || distance < distances[level]) break;
+                shadows[level] = mesh_component(get_entity(), *handles[level]);
+                result = &shadows[level];
+            }
+            return result;
+        }
+
+    private:
+
+        mesh_component shadows[3]; // runtime-only, rebuilt by select()
+    };
+    POLYMER_SETUP_TYPEID(lod_component);
+
+    template<class F> void visit_fields(lod_component & o, F f) {
+        f("lod1", o.lod1);
+        f("lod2", o.lod2);
+        f("lod3", o.lod3);
+        f("lod1_distance", o.lod1_distance);
+        f("lod2_distance", o.lod2_distance);
+        f("lod3_distance", o.lod3_distance);
+    }
+
+    inline void to_json(json & j, const lod_component & p) {
+        visit_fields(const_cast<lod_component&>(p), [&j](const char * name, auto & field, auto... metadata) { j.push_back({ name, field }); });
+    }
+
+    inline void from_json(const json & archive, lod_component & m) {
+        visit_fields(m, [&archive](const char * name, auto & field, auto... metadata) {
+            field = archive.at(name).get<std::remove_reference_t<decltype(field)>>();
+        });
+    };
+
     ////////////////////////////
     //   material_component   //
     ////////////////////////////
@@ -178,6 +241,14 @@ namespace polymer
         material_handle material{ material_library::kDefaultMaterialId };
         bool receive_shadow{ true };
         bool cast_shadow{ true };
+
+        // Per-instance property block: overrides applied on top of the shared material
+        // through the per-object uniform ring, so entities that differ only by a tint
+        // or an emissive level share one material (and one draw-key program/material
+        // bucket) instead of each duplicating it in the material library.
+        float4 tint{ 1.f, 1.f, 1.f, 1.f }; // multiplies albedo (a multiplies opacity)
+        float emissive_strength{ 1.f };    // multiplies emissive strength
+
         material_component() {};
         material_component(entity e) : base_component(e) {}
         material_component(entity e, material_handle handle) : base_component(e), material(handle) {}
@@ -188,6 +259,8 @@ namespace polymer
         f("material_handle", o.material);
         f("receive_shadow", o.receive_shadow);
         f("cast_shadow", o.cast_shadow);
+        f("tint", o.tint);
+        f("emissive_strength", o.emissive_strength);
     }
 
     inline void to_json(json & j, const material_component & p) {
@@ -211,6 +284,36 @@ namespace polymer
         geometry_component() {};
         geometry_component(entity e) : base_component(e) {}
         geometry_component(entity e, cpu_mesh_handle handle) : base_component(e), geom(handle) {}
+
+        // Object-space bounds, computed on first request and cached for subsequent frames
+        const aabb_3d & get_local_bounds() const
+        {
+            if (!bounds_cached) { local_bounds = compute_bounds(geom.get()); bounds_cached = true; }
+            return local_bounds;
+        }
+
+        // Animated entities push approximate per-frame bounds here (e.g. from
+        // skinned_mesh_state::approximate_local_bounds) so the spatial index and
+        // render bounds track the pose instead of the bind-pose mesh
+        void set_local_bounds_override(const aabb_3d & bounds)
+        {
+            local_bounds = bounds;
+            bounds_cached = true;
+            bounds_overridden = true;
+        }
+
+        // Back to mesh-derived bounds, recomputed on the next get_local_bounds()
+        void clear_local_bounds_override()
+        {
+            if (!bounds_overridden) return;
+            bounds_overridden = false;
+            bounds_cached = false;
+        }
+
+    private:
+        mutable aabb_3d local_bounds;
+        mutable bool bounds_cached{ false };
+        bool bounds_overridden{ false };
     };
     POLYMER_SETUP_TYPEID(geometry_component);
 
@@ -289,6 +392,43 @@ namespace polymer
         });
     };
 
+    ////////////////////////////////////
+    //   reflection_probe_component   //
+    ////////////////////////////////////
+
+    // A localized specular IBL probe. `source` is the environment cubemap captured or authored
+    // for this location; the render system prefilters its GGX mip chain once at bake time and
+    // the forward pass blends the nearest probes per-object, falling back to the scene-level
+    // IBL outside any probe's influence radius.
+    struct reflection_probe_component : public base_component
+    {
+        bool enabled{ true };
+        texture_handle source;
+        float radius{ 5.f };           // influence radius; blend weight falls off linearly to the edge
+        float3 position{ 0, 0, 0 };    // refreshed from the entity's world transform
+        uint32_t bakedCubemap{ 0 };    // prefiltered chain, owned by the render system (not serialized)
+        reflection_probe_component() {};
+        reflection_probe_component(entity e) : base_component(e) {}
+    };
+    POLYMER_SETUP_TYPEID(reflection_probe_component);
+
+    template<class F> void visit_fields(reflection_probe_component & o, F f) {
+        f("enabled", o.enabled);
+        f("source_cubemap", o.source);
+        f("radius", o.radius);
+        f("position", o.position);
+    }
+
+    inline void to_json(json & j, const reflection_probe_component & p) {
+        visit_fields(const_cast<reflection_probe_component&>(p), [&j](const char * name, auto & field, auto... metadata) { j.push_back({ name, field }); });
+    }
+
+    inline void from_json(const json & archive, reflection_probe_component & m) {
+        visit_fields(m, [&archive](const char * name, auto & field, auto... metadata) {
+            field = archive.at(name).get<std::remove_reference_t<decltype(field)>>();
+        });
+    };
+
     ///////////////////////////////////////////////////////////
     //   local_transform_component & world_transform_component   //
     ///////////////////////////////////////////////////////////
@@ -334,6 +474,8 @@ namespace polymer
     //   environment   //
     /////////////////////
 
+    struct impostor_atlas; // renderer-impostor.hpp
+
     /// @todo - render_component submission groups
     /// @todo - render_component sort order
     struct render_component : public base_component
@@ -344,6 +486,10 @@ namespace polymer
         polymer::mesh_component * mesh{ nullptr };
         const polymer::world_transform_component * world_transform{ nullptr };
         const polymer::local_transform_component * local_transform{ nullptr };
+        float4 world_bounding_sphere{ 0, 0, 0, 0 }; // xyz world-space center, w radius; zero radius means unknown (never culled)
+        const std::vector<float4x4> * bone_palette{ nullptr }; // non-null selects the gpu palette-skinned submission path
+        polymer::lod_component * lod{ nullptr }; // non-null when the entity carries a lod chain; resolved by the distance-aware assemble overload
+        const polymer::impostor_atlas * impostor{ nullptr }; // non-null routes this component into the renderer's instanced impostor batch
     };
     POLYMER_SETUP_TYPEID(render_component);
 
@@ -370,6 +516,12 @@ namespace polymer
         std::unique_ptr<polymer::material_library> mat_library;
         std::unique_ptr<polymer::event_manager_async> event_manager;
 
+        // Claims on the global asset tables held by this environment. Filled by the
+        // asset_resolver; releasing (or destroying the environment) reclaims assets
+        // no other live environment shares, so two scenes can coexist for preloading
+        // and A/B swaps without clobbering each other's GPU resources.
+        polymer::asset_namespace assets;
+
         polymer::render_system * render_system;
         polymer::collision_system * collision_system;
         polymer::transform_system * xform_system; 
@@ -378,10 +530,41 @@ namespace polymer
         void import_environment(const std::string & path, entity_orchestrator & o);
         void export_environment(const std::string & path);
 
+        // Asynchronous variant for autosave: the reflection walk copies component state
+        // into a json snapshot on the calling thread (the only part that reads live
+        // systems); a worker then serializes it and swaps the finished file into place
+        // through a temp-file rename, so the previous save is never left truncated.
+        void export_environment_async(const std::string & path);
+        json serialize_environment();
+
+        // Versioned binary alternative to the JSON path above. Asset handle names,
+        // identifiers and other strings are deduplicated through a string table and
+        // component arrays are stored as raw field blocks, so loading is a linear
+        // scan with no text parsing. JSON remains the authoring/diffable format.
+        void import_environment_binary(const std::string & path, entity_orchestrator & o);
+        void export_environment_binary(const std::string & path);
+
+        // Chunked variant of the binary container for streamed open-world scenes.
+        // export_environment_chunks partitions tracked entities into ground-plane
+        // grid cells (an entity travels with its transform root, so hierarchies
+        // stay within one chunk) and writes one binary chunk per occupied cell
+        // plus a `chunks.json` manifest consumed by scene_streamer.
+        // import_environment_binary_chunk additively imports one chunk from an
+        // in-memory buffer (read on a worker thread) and returns the created
+        // entities so the streamer can destroy exactly those on unload.
+        void export_environment_chunks(const std::string & export_dir, const float cell_size);
+        std::vector<entity> import_environment_binary_chunk(const std::vector<uint8_t> & data, entity_orchestrator & o);
+        std::vector<uint8_t> serialize_entities_binary(const std::vector<entity> & entities);
+
         entity track_entity(entity e);        
         const std::vector<entity> & entity_list();
         void copy(entity src, entity dest);
         void destroy(entity e);
+
+        // Destroys a batch of entities with one pass per system (pool-backed systems
+        // compact in a single sweep); preferred over per-entity destroy() for scene
+        // chunk unloads.
+        void destroy_entities(const std::vector<entity> & entities);
     };
 
     template<class F> void visit_systems(environment * p, F f)
@@ -394,6 +577,10 @@ namespace polymer
 
     render_component assemble_render_component(environment & env, const entity e);
 
+    // Distance-aware overload: additionally resolves the entity's lod chain (if any)
+    // against `view_position`, using the same bounds the culling stage works with.
+    render_component assemble_render_component(environment & env, const entity e, const float3 & view_position);
+
 } // end namespace polymer
 
 #endif // end polymer_environment_hpp
@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef polymer_frame_pipeline_hpp
+#define polymer_frame_pipeline_hpp
+
+#include "renderer-pbr.hpp"
+#include "thread-pool.hpp"
+
+#include <future>
+
+namespace polymer
+{
+
+    ////////////////////////
+    //   frame_pipeline   //
+    ////////////////////////
+
+    // Optional two-stage frame pipeline: simulation for frame N+1 runs on a worker
+    // while the GL thread submits frame N from an immutable snapshot. The pipeline
+    // owns two render_payloads; kick_simulation() hands the back payload to a
+    // user-supplied gather on the task scheduler, then seals it — the hot,
+    // simulation-mutated component data (transforms, bone palettes, lights) is
+    // copied into payload-owned storage and the render_components repointed at the
+    // copies, so later simulation ticks can't bleed into the frame being drawn.
+    // Pointers that only the GL thread mutates (materials, meshes, skybox) are
+    // shared, not copied.
+    //
+    // Contract: structural scene changes (entity create/destroy, component
+    // add/remove) must happen on the calling thread between flip() and the next
+    // kick_simulation(), while no simulation is in flight. View data is
+    // render-thread state — write it into presentation() as late as possible
+    // (e.g. freshly-predicted eye poses) just before render_frame.
+    class frame_pipeline
+    {
+        // Value copies backing a sealed payload; pointer-stable between seals
+        // because each array is reserved up front and only appended to.
+        struct snapshot_storage
+        {
+            std::vector<world_transform_component> world_transforms;
+            std::vector<local_transform_component> local_transforms;
+            std::vector<std::vector<float4x4>> bone_palettes;
+            std::vector<point_light_component> point_lights;
+            std::vector<reflection_probe_component> reflection_probes;
+            directional_light_component sunlight;
+        };
+
+        render_payload payloads[2];
+        snapshot_storage storage[2];
+        uint32_t sim_index{ 0 };
+        std::future<void> in_flight;
+
+        void seal(const uint32_t index)
+        {
+            render_payload & p = payloads[index];
+            snapshot_storage & s = storage[index];
+
+            s.world_transforms.clear();
+            s.local_transforms.clear();
+            s.bone_palettes.clear();
+            s.point_lights.clear();
+            s.reflection_probes.clear();
+            s.world_transforms.reserve(p.render_components.size());
+            s.local_transforms.reserve(p.render_components.size());
+            s.bone_palettes.reserve(p.render_components.size());
+            s.point_lights.reserve(p.point_lights.size());
+            s.reflection_probes.reserve(p.reflection_probes.size());
+
+            for (render_component & r : p.render_components)
+            {
+                if (r.world_transform) { s.world_transforms.push_back(*r.world_transform); r.world_transform = &s.world_transforms.back(); }
+                if (r.local_transform) { s.local_transforms.push_back(*r.local_transform); r.local_transform = &s.local_transforms.back(); }
+                if (r.bone_palette)    { s.bone_palettes.push_back(*r.bone_palette);       r.bone_palette = &s.bone_palettes.back(); }
+            }
+            for (point_light_component *& l : p.point_lights)            { s.point_lights.push_back(*l); l = &s.point_lights.back(); }
+            for (reflection_probe_component *& probe : p.reflection_probes) { s.reflection_probes.push_back(*probe); probe = &s.reflection_probes.back(); }
+            if (p.sunlight) { s.sunlight = *p.sunlight; p.sunlight = &s.sunlight; }
+        }
+
+    public:
+
+        // One-time setup of state shared across frames (skybox, IBL handles);
+        // apply to both buffers before entering the pipelined loop.
+        render_payload & payload(const uint32_t index) { return payloads[index & 1]; }
+
+        // The sealed snapshot for the frame being submitted. Empty until the
+        // first kick_simulation()/flip() pair has completed.
+        render_payload & presentation() { return payloads[sim_index ^ 1]; }
+
+        // Runs `simulate(render_payload &)` on a worker against the back payload,
+        // then seals it. Call at the top of the frame, before submitting
+        // presentation(), so simulation N+1 overlaps the GL submission of frame N.
+        template<class F>
+        void kick_simulation(F && simulate)
+        {
+            const uint32_t index = sim_index;
+            auto fn = std::make_shared<typename std::decay<F>::type>(std::forward<F>(simulate));
+            in_flight = get_task_scheduler().enqueue([this, index, fn]()
+            {
+                (*fn)(payloads[index]);
+                seal(index);
+            });
+        }
+
+        // Blocks until the in-flight simulation has sealed, then promotes it to
+        // the presentation slot. Call once per frame, after GL submission.
+        void flip()
+        {
+            if (in_flight.valid()) in_flight.get();
+            sim_index ^= 1;
+        }
+
+        bool simulation_in_flight() const { return in_flight.valid(); }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_frame_pipeline_hpp
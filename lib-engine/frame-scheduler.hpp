@@ -0,0 +1,127 @@
+#pragma once
+
+#ifndef polymer_frame_scheduler_hpp
+#define polymer_frame_scheduler_hpp
+
+#include "ecs/typeid.hpp"
+#include "thread-pool.hpp"
+
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace polymer
+{
+
+    /////////////////////////
+    //   frame_scheduler   //
+    /////////////////////////
+
+    // Small job graph for the per-frame update stages that main loops otherwise run
+    // strictly serially. Each stage declares the component types it reads and writes;
+    // a stage depends on any earlier stage whose writes overlap its reads or writes
+    // (or whose reads overlap its writes), so declaration order remains the tie-break
+    // for genuinely conflicting work. Independent stages execute concurrently on the
+    // task scheduler in topological waves with a barrier between waves. Stages that
+    // touch the GL context (asset resolution, shader recompiles) must be flagged
+    // `main_thread` — they run on the thread calling execute(), overlapping any
+    // worker-side stages in the same wave.
+    class frame_scheduler
+    {
+        struct stage
+        {
+            std::string name;
+            std::vector<poly_typeid> reads;
+            std::vector<poly_typeid> writes;
+            std::function<void()> work;
+            bool main_thread{ false };
+            std::vector<size_t> dependencies; // indices of earlier stages this one must follow
+        };
+
+        std::vector<stage> stages;
+
+        static bool overlaps(const std::vector<poly_typeid> & a, const std::vector<poly_typeid> & b)
+        {
+            for (const poly_typeid t : a) if (std::find(b.begin(), b.end(), t) != b.end()) return true;
+            return false;
+        }
+
+    public:
+
+        // Stages must be added in the order the serial loop would have run them;
+        // dependency edges against earlier stages are derived here, once.
+        void add_stage(const std::string & name,
+                       std::vector<poly_typeid> reads,
+                       std::vector<poly_typeid> writes,
+                       std::function<void()> work,
+                       const bool main_thread = false)
+        {
+            stage s;
+            s.name = name;
+            s.reads = std::move(reads);
+            s.writes = std::move(writes);
+            s.work = std::move(work);
+            s.main_thread = main_thread;
+
+            for (size_t i = 0; i < stages.size(); ++i)
+            {
+                const stage & earlier = stages[i];
+                if (overlaps(earlier.writes, s.reads) ||    // read-after-write
+                    overlaps(earlier.writes, s.writes) ||   // write-after-write
+                    overlaps(earlier.reads, s.writes))      // write-after-read
+                {
+                    s.dependencies.push_back(i);
+                }
+            }
+
+            stages.push_back(std::move(s));
+        }
+
+        // Runs every stage once, respecting dependencies. Main-thread stages execute
+        // on the calling thread while the rest of the wave runs on workers. Blocks
+        // until the whole frame graph has drained.
+        void execute()
+        {
+            std::vector<bool> done(stages.size(), false);
+            size_t completed = 0;
+
+            while (completed < stages.size())
+            {
+                // Collect the wave: every not-yet-run stage whose dependencies have all completed.
+                // Dependencies only reference earlier stages, so the graph is acyclic and
+                // every iteration makes progress.
+                std::vector<size_t> wave;
+                for (size_t i = 0; i < stages.size(); ++i)
+                {
+                    if (done[i]) continue;
+                    bool satisfied = true;
+                    for (const size_t dep : stages[i].dependencies) if (!done[dep]) { satisfied = false; break; }
+                    if (satisfied) wave.push_back(i);
+                }
+
+                task_group group;
+                for (const size_t i : wave)
+                {
+                    if (stages[i].main_thread) continue;
+                    const std::function<void()> & work = stages[i].work;
+                    group.run(get_task_scheduler(), [&work]() { work(); });
+                }
+                for (const size_t i : wave) if (stages[i].main_thread) stages[i].work();
+                group.wait();
+
+                for (const size_t i : wave) done[i] = true;
+                completed += wave.size();
+            }
+        }
+
+        void clear() { stages.clear(); }
+
+        size_t stage_count() const { return stages.size(); }
+
+        const std::vector<size_t> & dependencies_of(const size_t index) const { return stages[index].dependencies; }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_frame_scheduler_hpp
@@ -9,6 +9,10 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <cstring>
+#include <atomic>
+#include <functional>
+#include <memory>
 
 namespace
 {
@@ -133,6 +137,24 @@ namespace
         default: throw std::logic_error("unknown element type"); break;
         }
     }
+
+    // Bytes per texel for the sized internal formats the engine actually allocates.
+    // Unknown formats estimate four bytes rather than throwing - this feeds accounting,
+    // not uploads, so a rough number beats an exception.
+    inline size_t gl_internal_format_size_bytes(GLenum internal_fmt)
+    {
+        switch (internal_fmt)
+        {
+        case GL_R8: case GL_RED: return 1;
+        case GL_RG8: case GL_RG: case GL_R16F: case GL_DEPTH_COMPONENT16: return 2;
+        case GL_RGB8: case GL_SRGB8: case GL_RGB: return 3;
+        case GL_RGB16F: return 6;
+        case GL_RGBA16F: case GL_RG32F: return 8;
+        case GL_RGB32F: return 12;
+        case GL_RGBA32F: return 16;
+        default: return 4; // GL_RGBA8, GL_SRGB8_ALPHA8, GL_R11F_G11F_B10F, GL_R32F, depth/stencil formats, etc.
+        }
+    }
 }
 
 template<typename factory_t>
@@ -169,6 +191,229 @@ typedef gl_handle<gl_query_factory> gl_query_object;
 typedef gl_handle<gl_sampler_factory> gl_sampler_object;
 typedef gl_handle<gl_transform_feedback_factory> gl_transform_feedback_object;
 
+////////////////////////////
+//   gpu memory tracking  //
+////////////////////////////
+
+enum class gl_memory_category : uint32_t
+{
+    meshes,
+    textures,
+    render_targets,
+    uniform_buffers,
+    other,
+    count
+};
+
+inline const char * to_string(const gl_memory_category category)
+{
+    switch (category)
+    {
+    case gl_memory_category::meshes: return "meshes";
+    case gl_memory_category::textures: return "textures";
+    case gl_memory_category::render_targets: return "render targets";
+    case gl_memory_category::uniform_buffers: return "uniform buffers";
+    default: return "other";
+    }
+}
+
+// Process-wide running totals of the bytes handed to the GL through the wrapper types
+// below (set_buffer_data / setup / set_commands know their byte sizes). These are
+// client-side estimates of what was requested, not driver residency, but they track
+// closely enough to diagnose VRAM pressure and to drive budget decisions at runtime.
+class gl_memory_tracker
+{
+    std::atomic<int64_t> byteTotals[static_cast<size_t>(gl_memory_category::count)];
+    std::atomic<int64_t> allocationTotals[static_cast<size_t>(gl_memory_category::count)];
+    gl_memory_tracker()
+    {
+        for (size_t i = 0; i < static_cast<size_t>(gl_memory_category::count); ++i)
+        {
+            byteTotals[i].store(0);
+            allocationTotals[i].store(0);
+        }
+    }
+public:
+    static gl_memory_tracker & get() { static gl_memory_tracker tracker; return tracker; }
+    void add(const gl_memory_category c, const int64_t bytes) { byteTotals[static_cast<size_t>(c)] += bytes; allocationTotals[static_cast<size_t>(c)]++; }
+    void remove(const gl_memory_category c, const int64_t bytes) { byteTotals[static_cast<size_t>(c)] -= bytes; allocationTotals[static_cast<size_t>(c)]--; }
+    int64_t get_bytes(const gl_memory_category c) const { return byteTotals[static_cast<size_t>(c)].load(); }
+    int64_t get_allocation_count(const gl_memory_category c) const { return allocationTotals[static_cast<size_t>(c)].load(); }
+    int64_t get_total_bytes() const
+    {
+        int64_t total = 0;
+        for (size_t i = 0; i < static_cast<size_t>(gl_memory_category::count); ++i) total += byteTotals[i].load();
+        return total;
+    }
+};
+
+// A point-in-time copy of the gl_submission_stats counters. Subtracting two snapshots
+// (operator-) yields the work submitted between them, e.g. over one pass or one frame.
+struct gl_submission_stats_snapshot
+{
+    uint64_t drawCalls{ 0 };
+    uint64_t programBinds{ 0 };
+    uint64_t textureBinds{ 0 };
+    uint64_t uboUpdates{ 0 };
+    uint64_t triangles{ 0 };
+
+    gl_submission_stats_snapshot operator - (const gl_submission_stats_snapshot & r) const
+    {
+        return { drawCalls - r.drawCalls, programBinds - r.programBinds, textureBinds - r.textureBinds, uboUpdates - r.uboUpdates, triangles - r.triangles };
+    }
+};
+
+// Process-wide counts of the work submitted through the wrappers below: draw calls and
+// triangles from gl_mesh, program binds from gl_shader::bind, texture binds from
+// gl_shader::texture, and uniform buffer updates from gl_buffer / the mapped ring.
+// Consumers (HUDs, the flight recorder, per-pass reporting) snapshot and difference.
+class gl_submission_stats
+{
+    std::atomic<uint64_t> drawCalls{ 0 };
+    std::atomic<uint64_t> programBinds{ 0 };
+    std::atomic<uint64_t> textureBinds{ 0 };
+    std::atomic<uint64_t> uboUpdates{ 0 };
+    std::atomic<uint64_t> triangles{ 0 };
+    gl_submission_stats() = default;
+public:
+    static gl_submission_stats & get() { static gl_submission_stats stats; return stats; }
+    void add_draw_call(const uint64_t tris) { drawCalls++; triangles += tris; }
+    void add_program_bind() { programBinds++; }
+    void add_texture_bind() { textureBinds++; }
+    void add_ubo_update() { uboUpdates++; }
+    uint64_t total_draw_calls() const { return drawCalls.load(); }
+    gl_submission_stats_snapshot capture() const
+    {
+        return { drawCalls.load(), programBinds.load(), textureBinds.load(), uboUpdates.load(), triangles.load() };
+    }
+};
+
+// Wrapper-level command capture for regression benchmarking. While recording, the
+// same sites that feed gl_submission_stats also append one fixed-size record per
+// submission (program binds, texture binds, uniform buffer writes, draws), and
+// end_frame() writes the sequence to disk. Captures describe the *shape* of a frame -
+// object identities, state-change ordering, batch sizes - not resource contents, so a
+// replayer re-executes them against proxy resources to get driver-level A/B timings
+// for batching and ordering changes without a full scene setup. GL-thread only, like
+// the wrappers that feed it.
+enum class gl_capture_op : uint32_t { program_bind = 0, texture_bind = 1, ubo_update = 2, draw = 3 };
+
+struct gl_capture_command
+{
+    uint32_t op{ 0 };        // gl_capture_op
+    uint32_t handle{ 0 };    // program or texture object name; 0 when inapplicable
+    uint32_t mode{ 0 };      // draw mode, texture unit, or unused
+    uint32_t count{ 0 };     // vertices submitted, bytes written, or unused
+    uint32_t instances{ 0 }; // instance count (0 = non-instanced), indirect command count
+};
+
+class gl_command_capture
+{
+    std::vector<gl_capture_command> commands;
+    std::string path;
+    bool active{ false };
+    gl_command_capture() = default;
+
+    void record(const gl_capture_op op, const uint32_t handle, const uint32_t mode, const uint32_t count, const uint32_t instances)
+    {
+        commands.push_back({ static_cast<uint32_t>(op), handle, mode, count, instances });
+    }
+
+public:
+
+    static gl_command_capture & get() { static gl_command_capture capture; return capture; }
+
+    bool recording() const { return active; }
+
+    void begin_frame(const std::string & capture_path)
+    {
+        commands.clear();
+        path = capture_path;
+        active = true;
+    }
+
+    void end_frame()
+    {
+        if (!active) return;
+        active = false;
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.good()) throw std::runtime_error("gl_command_capture: could not open " + path);
+
+        const uint32_t magic = 0x50434150; // 'PCAP'
+        const uint32_t version = 1;
+        const uint64_t count = commands.size();
+        file.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+        file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char *>(commands.data()), count * sizeof(gl_capture_command));
+    }
+
+    void record_program_bind(const GLuint program) { if (active) record(gl_capture_op::program_bind, program, 0, 0, 0); }
+    void record_texture_bind(const GLuint tex, const uint32_t unit) { if (active) record(gl_capture_op::texture_bind, tex, unit, 0, 0); }
+    void record_ubo_update(const uint32_t bytes) { if (active) record(gl_capture_op::ubo_update, 0, 0, bytes, 0); }
+    void record_draw(const uint32_t mode, const uint32_t verts, const uint32_t instances) { if (active) record(gl_capture_op::draw, 0, mode, verts, instances); }
+
+    static std::vector<gl_capture_command> load(const std::string & capture_path)
+    {
+        std::ifstream file(capture_path, std::ios::binary);
+        if (!file.good()) throw std::runtime_error("gl_command_capture: could not open " + capture_path);
+
+        uint32_t magic = 0, version = 0;
+        uint64_t count = 0;
+        file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char *>(&version), sizeof(version));
+        file.read(reinterpret_cast<char *>(&count), sizeof(count));
+        if (magic != 0x50434150 || version != 1) throw std::runtime_error("gl_command_capture: not a capture file: " + capture_path);
+
+        std::vector<gl_capture_command> commands(count);
+        file.read(reinterpret_cast<char *>(commands.data()), count * sizeof(gl_capture_command));
+        if (!file.good()) throw std::runtime_error("gl_command_capture: truncated capture: " + capture_path);
+        return commands;
+    }
+};
+
+// Remembers what a wrapper last charged to the tracker so re-uploads replace the old
+// charge instead of double-counting, and destruction returns it. Move-only, like the
+// gl_handle wrappers that embed it.
+struct gl_memory_record
+{
+    gl_memory_category category{ gl_memory_category::other };
+    int64_t recordedBytes{ 0 };
+
+    gl_memory_record() = default;
+    gl_memory_record(const gl_memory_category c) : category(c) {}
+    ~gl_memory_record() { release(); }
+    gl_memory_record(const gl_memory_record & r) = delete;
+    gl_memory_record & operator = (const gl_memory_record & r) = delete;
+    gl_memory_record(gl_memory_record && r) noexcept { *this = std::move(r); }
+    gl_memory_record & operator = (gl_memory_record && r) noexcept { std::swap(category, r.category); std::swap(recordedBytes, r.recordedBytes); return *this; }
+
+    void record(const int64_t sizeBytes)
+    {
+        release();
+        recordedBytes = sizeBytes;
+        if (recordedBytes) gl_memory_tracker::get().add(category, recordedBytes);
+    }
+
+    void set_category(const gl_memory_category c)
+    {
+        if (c == category) return;
+        if (recordedBytes)
+        {
+            gl_memory_tracker::get().remove(category, recordedBytes);
+            gl_memory_tracker::get().add(c, recordedBytes);
+        }
+        category = c;
+    }
+
+    void release()
+    {
+        if (recordedBytes) gl_memory_tracker::get().remove(category, recordedBytes);
+        recordedBytes = 0;
+    }
+};
+
 //////////////////////
 //   buffer types   //
 //////////////////////
@@ -176,18 +421,379 @@ typedef gl_handle<gl_transform_feedback_factory> gl_transform_feedback_object;
 struct gl_buffer : public gl_buffer_object
 {
     GLsizeiptr size{ 0 };
+    gl_memory_record memory;
     gl_buffer() = default;
-    void set_buffer_data(const GLsizeiptr s, const GLvoid * data, const GLenum usage) { this->size = s; glNamedBufferDataEXT(*this, size, data, usage);  }
+    void set_buffer_data(const GLsizeiptr s, const GLvoid * data, const GLenum usage)
+    {
+        this->size = s;
+        memory.record(s);
+        if (memory.category == gl_memory_category::uniform_buffers)
+        {
+            gl_submission_stats::get().add_ubo_update();
+            gl_command_capture::get().record_ubo_update(static_cast<uint32_t>(s));
+        }
+        glNamedBufferDataEXT(*this, size, data, usage);
+    }
     void set_buffer_data(const std::vector<GLubyte> & bytes, const GLenum usage) { set_buffer_data(bytes.size(), bytes.data(), usage); }
     void set_buffer_sub_data(const GLsizeiptr s, const GLintptr offset, const GLvoid * data) { glNamedBufferSubDataEXT(*this, offset, s, data);  }
     void set_buffer_sub_data(const std::vector<GLubyte> & bytes, const GLintptr offset, const GLenum usage) { set_buffer_sub_data(bytes.size(), offset, bytes.data()); }
 };
 
+// A persistently-mapped, triple-buffered ring for streaming uniform data (GL_ARB_buffer_storage).
+// Writes bump an offset within the current section; sections rotate once per frame and are guarded
+// with fences so the CPU never overwrites data the GPU is still consuming. Typical use is thousands
+// of small per-object blocks bound with glBindBufferRange instead of one glBufferSubData per draw.
+struct gl_mapped_ring_buffer : public gl_buffer_object
+{
+    static const int NUM_SECTIONS = 3;
+
+    uint8_t * mapped{ nullptr };
+    gl_memory_record memory{ gl_memory_category::uniform_buffers };
+    GLsizeiptr sectionSize{ 0 };
+    GLintptr head{ 0 };
+    int sectionIndex{ 0 };
+    GLsync sectionFences[NUM_SECTIONS] = { nullptr, nullptr, nullptr };
+    GLint offsetAlignment{ 256 };
+
+    gl_mapped_ring_buffer() = default;
+
+    ~gl_mapped_ring_buffer()
+    {
+        for (int i = 0; i < NUM_SECTIONS; ++i) if (sectionFences[i]) glDeleteSync(sectionFences[i]);
+        if (mapped) glUnmapNamedBufferEXT(*this);
+    }
+
+    void setup(const GLsizeiptr section_size_bytes)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        sectionSize = section_size_bytes;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+        memory.record(sectionSize * NUM_SECTIONS);
+        glNamedBufferStorageEXT(*this, sectionSize * NUM_SECTIONS, nullptr, flags);
+        mapped = reinterpret_cast<uint8_t *>(glMapNamedBufferRangeEXT(*this, 0, sectionSize * NUM_SECTIONS, flags));
+        if (!mapped) throw std::runtime_error("glMapNamedBufferRangeEXT failed (persistent mapping unsupported?)");
+    }
+
+    // Rotate to the next section, waiting on its fence if the GPU is still behind
+    void begin_frame()
+    {
+        sectionIndex = (sectionIndex + 1) % NUM_SECTIONS;
+        if (sectionFences[sectionIndex])
+        {
+            while (true)
+            {
+                const GLenum wait = glClientWaitSync(sectionFences[sectionIndex], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+                if (wait == GL_ALREADY_SIGNALED || wait == GL_CONDITION_SATISFIED) break;
+            }
+            glDeleteSync(sectionFences[sectionIndex]);
+            sectionFences[sectionIndex] = nullptr;
+        }
+        head = sectionIndex * sectionSize;
+    }
+
+    // Fence the section we just finished writing so begin_frame() can guard against overwrite
+    void end_frame()
+    {
+        sectionFences[sectionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    // Bump-allocate and copy `size` bytes into the current section, returning the buffer
+    // offset, or -1 when the section is exhausted. Exhaustion is a valid outcome on a
+    // heavy frame (more writes than the ring was sized for), so callers spill to their
+    // non-mapped path for the remaining writes instead of crashing mid-frame.
+    GLintptr write(const void * data, const GLsizeiptr size)
+    {
+        head = (head + offsetAlignment - 1) & ~(static_cast<GLintptr>(offsetAlignment) - 1);
+        if (head + size > (sectionIndex + 1) * sectionSize) return -1;
+        gl_submission_stats::get().add_ubo_update();
+        gl_command_capture::get().record_ubo_update(static_cast<uint32_t>(size));
+        std::memcpy(mapped + head, data, size);
+        const GLintptr offset = head;
+        head += size;
+        return offset;
+    }
+
+    void bind_range(const GLuint binding, const GLintptr offset, const GLsizeiptr size)
+    {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, *this, offset, size);
+    }
+};
+
+// Tight size of one readback pixel for the format/type pairs polymer actually reads back
+inline size_t gl_readback_pixel_bytes(const GLenum format, const GLenum type)
+{
+    size_t components = 4;
+    switch (format)
+    {
+    case GL_RED: case GL_DEPTH_COMPONENT: components = 1; break;
+    case GL_RG: components = 2; break;
+    case GL_RGB: case GL_BGR: components = 3; break;
+    default: break; // GL_RGBA / GL_BGRA
+    }
+
+    size_t bytes = 1;
+    switch (type)
+    {
+    case GL_HALF_FLOAT: case GL_UNSIGNED_SHORT: case GL_SHORT: bytes = 2; break;
+    case GL_FLOAT: case GL_UNSIGNED_INT: case GL_INT: bytes = 4; break;
+    default: break; // GL_UNSIGNED_BYTE / GL_BYTE
+    }
+    return components * bytes;
+}
+
+// Asynchronous readback: each request copies into a pixel-pack buffer and drops a
+// fence behind it, so the producing pass never stalls. poll() once per frame; a
+// request's callback fires (with the mapped bytes) on the first poll after its
+// fence signals, typically one to two frames later. Idle buffers are recycled.
+class gl_async_readback
+{
+public:
+
+    using completion_callback = std::function<void(const void * data, const size_t size_bytes)>;
+
+private:
+
+    struct transfer
+    {
+        gl_buffer_object pbo;
+        size_t capacity{ 0 };
+        size_t bytes{ 0 };
+        GLsync fence{ nullptr };
+        completion_callback on_complete;
+    };
+
+    std::vector<std::unique_ptr<transfer>> transfers; // unique_ptr keeps handles stable across growth
+    gl_memory_record memory{ gl_memory_category::other };
+
+    transfer & acquire(const size_t bytes)
+    {
+        for (auto & t : transfers)
+        {
+            if (t->fence) continue;
+            if (t->capacity < bytes)
+            {
+                glNamedBufferDataEXT(t->pbo, bytes, nullptr, GL_STREAM_READ);
+                memory.record(bytes - t->capacity);
+                t->capacity = bytes;
+            }
+            t->bytes = bytes;
+            return *t;
+        }
+
+        transfers.push_back(std::unique_ptr<transfer>(new transfer()));
+        transfer & t = *transfers.back();
+        glNamedBufferDataEXT(t.pbo, bytes, nullptr, GL_STREAM_READ);
+        memory.record(bytes);
+        t.capacity = bytes;
+        t.bytes = bytes;
+        return t;
+    }
+
+public:
+
+    gl_async_readback() = default;
+    gl_async_readback(const gl_async_readback &) = delete;
+    gl_async_readback & operator = (const gl_async_readback &) = delete;
+
+    ~gl_async_readback()
+    {
+        for (auto & t : transfers) if (t->fence) glDeleteSync(t->fence);
+    }
+
+    // Queues a copy of a rect of the currently bound read framebuffer
+    void readback_pixels(const int x, const int y, const int width, const int height,
+        const GLenum format, const GLenum type, completion_callback callback)
+    {
+        const size_t bytes = size_t(width) * size_t(height) * gl_readback_pixel_bytes(format, type);
+        transfer & t = acquire(bytes);
+        t.on_complete = std::move(callback);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, t.pbo);
+        glReadPixels(x, y, width, height, format, type, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        t.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    // Queues a copy of a full texture level
+    void readback_texture(const GLuint texture, const GLenum target, const int level,
+        const int width, const int height, const GLenum format, const GLenum type, completion_callback callback)
+    {
+        const size_t bytes = size_t(width) * size_t(height) * gl_readback_pixel_bytes(format, type);
+        transfer & t = acquire(bytes);
+        t.on_complete = std::move(callback);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, t.pbo);
+        glGetTextureImageEXT(texture, target, level, format, type, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        t.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    // Fires callbacks for every transfer whose fence has signaled. Call once per
+    // frame; never blocks (timeout zero).
+    void poll()
+    {
+        for (auto & t : transfers)
+        {
+            if (!t->fence) continue;
+
+            const GLenum wait = glClientWaitSync(t->fence, 0, 0);
+            if (wait != GL_ALREADY_SIGNALED && wait != GL_CONDITION_SATISFIED) continue;
+
+            glDeleteSync(t->fence);
+            t->fence = nullptr;
+
+            if (const void * mapped = glMapNamedBufferEXT(t->pbo, GL_READ_ONLY))
+            {
+                if (t->on_complete) t->on_complete(mapped, t->bytes);
+                glUnmapNamedBufferEXT(t->pbo);
+            }
+            t->on_complete = nullptr;
+        }
+    }
+
+    size_t in_flight_count() const
+    {
+        size_t count = 0;
+        for (const auto & t : transfers) if (t->fence) ++count;
+        return count;
+    }
+};
+
+// Continuous-capture flavor: capture() every frame rotates through three pixel-pack
+// buffers (one being written, one in flight, one complete) and latest_available()
+// hands back the newest signaled grab without ever blocking. Frames whose slot is
+// still in flight when the ring wraps are dropped, which is the correct behavior
+// for recording - a late frame is worthless.
+class gl_latest_readback
+{
+    static const int NUM_SLOTS = 3;
+
+    struct slot
+    {
+        gl_buffer_object pbo;
+        size_t capacity{ 0 };
+        size_t bytes{ 0 };
+        GLsync fence{ nullptr };
+        uint64_t sequence{ 0 };
+    };
+
+    slot slots[NUM_SLOTS];
+    uint64_t nextSequence{ 1 };
+    int writeIndex{ 0 };
+    gl_memory_record memory{ gl_memory_category::other };
+
+public:
+
+    gl_latest_readback() = default;
+    gl_latest_readback(const gl_latest_readback &) = delete;
+    gl_latest_readback & operator = (const gl_latest_readback &) = delete;
+
+    ~gl_latest_readback()
+    {
+        for (auto & s : slots) if (s.fence) glDeleteSync(s.fence);
+    }
+
+    // Grabs a rect of the currently bound read framebuffer into the next slot.
+    // Returns false (and skips the grab) if every slot is still in flight.
+    bool capture(const int x, const int y, const int width, const int height, const GLenum format, const GLenum type)
+    {
+        slot & s = slots[writeIndex];
+
+        if (s.fence)
+        {
+            const GLenum wait = glClientWaitSync(s.fence, 0, 0);
+            if (wait != GL_ALREADY_SIGNALED && wait != GL_CONDITION_SATISFIED) return false; // gpu is > NUM_SLOTS frames behind
+            glDeleteSync(s.fence);
+            s.fence = nullptr;
+        }
+
+        const size_t bytes = size_t(width) * size_t(height) * gl_readback_pixel_bytes(format, type);
+        if (s.capacity < bytes)
+        {
+            glNamedBufferDataEXT(s.pbo, bytes, nullptr, GL_STREAM_READ);
+            memory.record(bytes - s.capacity);
+            s.capacity = bytes;
+        }
+        s.bytes = bytes;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        glReadPixels(x, y, width, height, format, type, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        s.sequence = nextSequence++;
+
+        writeIndex = (writeIndex + 1) % NUM_SLOTS;
+        return true;
+    }
+
+    // Copies the newest completed grab into `out`. Returns false when nothing has
+    // finished since the last consume.
+    bool latest_available(std::vector<uint8_t> & out)
+    {
+        slot * newest = nullptr;
+        for (auto & s : slots)
+        {
+            if (!s.fence || (newest && s.sequence < newest->sequence)) continue;
+            const GLenum wait = glClientWaitSync(s.fence, 0, 0);
+            if (wait == GL_ALREADY_SIGNALED || wait == GL_CONDITION_SATISFIED) newest = &s;
+        }
+
+        if (!newest) return false;
+
+        out.resize(newest->bytes);
+        if (const void * mapped = glMapNamedBufferEXT(newest->pbo, GL_READ_ONLY))
+        {
+            std::memcpy(out.data(), mapped, newest->bytes);
+            glUnmapNamedBufferEXT(newest->pbo);
+        }
+
+        glDeleteSync(newest->fence);
+        newest->fence = nullptr;
+        return true;
+    }
+};
+
+// Command layout consumed by glDrawElementsIndirect / glMultiDrawElementsIndirect
+struct draw_elements_indirect_command
+{
+    GLuint count{ 0 };          // number of indices to source
+    GLuint instanceCount{ 0 };
+    GLuint firstIndex{ 0 };
+    GLuint baseVertex{ 0 };
+    GLuint baseInstance{ 0 };
+};
+
+// A tightly-packed array of draw_elements_indirect_command, bound to GL_DRAW_INDIRECT_BUFFER at draw time
+struct gl_indirect_buffer : public gl_buffer_object
+{
+    GLsizei commandCount{ 0 };
+    uint64_t totalIndices{ 0 }; // indices across all commands (x instances), for triangle statistics
+    gl_memory_record memory;
+    gl_indirect_buffer() = default;
+    void set_commands(const std::vector<draw_elements_indirect_command> & commands, const GLenum usage)
+    {
+        commandCount = static_cast<GLsizei>(commands.size());
+        totalIndices = 0;
+        for (const auto & cmd : commands) totalIndices += static_cast<uint64_t>(cmd.count) * cmd.instanceCount;
+        memory.record(commandCount * sizeof(draw_elements_indirect_command));
+        glNamedBufferDataEXT(*this, commandCount * sizeof(draw_elements_indirect_command), commands.data(), usage);
+    }
+};
+
 struct gl_renderbuffer : public gl_renderbuffer_object
 {
     float width{ 0 }, height{ 0 };
+    gl_memory_record memory{ gl_memory_category::render_targets };
     gl_renderbuffer() {}
     gl_renderbuffer(float width, float height) : width(width), height(height) {}
+
+    // Storage is allocated by callers through glNamedRenderbufferStorage* directly, so the
+    // wrapper cannot observe the size - charge it explicitly after allocating
+    void record_storage(const GLenum internal_fmt, const GLsizei w, const GLsizei h, const GLsizei samples = 1)
+    {
+        memory.record(static_cast<int64_t>(gl_internal_format_size_bytes(internal_fmt)) * w * h * (samples > 1 ? samples : 1));
+    }
 };
 
 struct gl_framebuffer : public gl_framebuffer_object
@@ -206,6 +812,7 @@ struct gl_framebuffer : public gl_framebuffer_object
 struct gl_texture_2d : public gl_texture_object
 {
     float width{ 0 }, height{ 0 };
+    gl_memory_record memory{ gl_memory_category::textures };
     gl_texture_2d() = default;
     gl_texture_2d(GLuint id) : gl_texture_object(id) { }
     gl_texture_2d(float width, float height) : width(width), height(height) {}
@@ -218,6 +825,9 @@ struct gl_texture_2d : public gl_texture_object
         glTextureParameteriEXT(*this, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTextureParameteriEXT(*this, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
         if (createMipmap) glGenerateTextureMipmapEXT(*this, GL_TEXTURE_2D);
+        int64_t sizeBytes = static_cast<int64_t>(gl_internal_format_size_bytes(internal_fmt)) * width * height;
+        if (createMipmap) sizeBytes += sizeBytes / 3; // full chain converges to 4/3 of the base level
+        memory.record(sizeBytes);
         this->width = static_cast<float>(width);
         this->height = static_cast<float>(height);
     }
@@ -234,6 +844,9 @@ struct gl_texture_2d : public gl_texture_object
         glTextureParameteriEXT(*this, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
         glTextureParameteriEXT(*this, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
         glTextureParameteriEXT(*this, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);
+        int64_t sizeBytes = static_cast<int64_t>(gl_internal_format_size_bytes(internal_fmt)) * width * height * 6;
+        if (createMipmap) sizeBytes += sizeBytes / 3;
+        memory.record(sizeBytes);
         this->width = static_cast<float>(width);
         this->height = static_cast<float>(height);
     }
@@ -243,6 +856,7 @@ struct gl_texture_2d : public gl_texture_object
 struct gl_texture_3d : public gl_texture_object
 {
     float width{ 0 }, height{ 0 }, depth{ 0 };
+    gl_memory_record memory{ gl_memory_category::textures };
     gl_texture_3d() = default;
     gl_texture_3d(float width, float height, float depth) : width(width), height(height), depth(depth) {}
 
@@ -254,6 +868,7 @@ struct gl_texture_3d : public gl_texture_object
         glTextureParameteriEXT(*this, target, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTextureParameteriEXT(*this, target, GL_TEXTURE_WRAP_T, GL_REPEAT);
         glTextureParameteriEXT(*this, target, GL_TEXTURE_WRAP_R, GL_REPEAT);
+        memory.record(static_cast<int64_t>(gl_internal_format_size_bytes(internal_fmt)) * width * height * depth);
         this->width = static_cast<float>(width);
         this->height = static_cast<float>(height);
         this->depth = static_cast<float>(depth);
@@ -269,6 +884,19 @@ class gl_shader
     GLuint program{ 0 };
     bool enabled{ false };
 
+    // Attach and kick off a stage compile without querying GL_COMPILE_STATUS - with
+    // GL_KHR_parallel_shader_compile the driver compiles on its own threads and any status
+    // query would force a wait. Errors surface through the link status instead.
+    void attach_shader_deferred(const GLenum type, const std::string & src)
+    {
+        const GLuint s = glCreateShader(type);
+        const GLchar * source = src.c_str();
+        glShaderSource(s, 1, &source, NULL);
+        glCompileShader(s);
+        glAttachShader(program, s);
+        glDeleteShader(s); // released once the program lets go of it
+    }
+
 protected:
 
     gl_shader(const gl_shader & r) = delete;
@@ -278,6 +906,51 @@ public:
 
     gl_shader() = default;
 
+    // Deferred-link construction for GL_KHR_parallel_shader_compile: the link is kicked off
+    // but no status query is issued. Callers poll is_ready() and then confirm_link() once
+    // before first use; until then the previous program can keep serving.
+    struct async_compile_tag {};
+
+    gl_shader(async_compile_tag, const std::string & vert, const std::string & frag, const std::string & geom = "")
+    {
+        program = glCreateProgram();
+
+        glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_FALSE);
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        attach_shader_deferred(GL_VERTEX_SHADER, vert);
+        attach_shader_deferred(GL_FRAGMENT_SHADER, frag);
+        if (geom.length() != 0) attach_shader_deferred(GL_GEOMETRY_SHADER, geom);
+
+        glLinkProgram(program);
+    }
+
+    // Non-blocking completion poll (GL_KHR_parallel_shader_compile)
+    bool is_ready() const
+    {
+        GLint status = GL_TRUE;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &status);
+        return status == GL_TRUE;
+    }
+
+    // Resolve a deferred link. Logs and returns false on failure rather than throwing, so
+    // a broken hot-reloaded shader leaves the last good program in place.
+    bool confirm_link() const
+    {
+        GLint status, length;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+        if (status == GL_FALSE)
+        {
+            glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+            std::vector<GLchar> buffer(length);
+            glGetProgramInfoLog(program, (GLsizei)buffer.size(), nullptr, buffer.data());
+            std::cerr << "GL Link Error: " << buffer.data() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
     gl_shader(const GLuint type, const std::string & src)
     {
         program = glCreateProgram();
@@ -300,11 +973,31 @@ public:
         }
     }
 
+    // Construct from a driver program binary previously retrieved with get_binary()
+    gl_shader(const GLenum binaryFormat, const std::vector<uint8_t> & binary)
+    {
+        program = glCreateProgram();
+        glProgramBinary(program, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        GLint status;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+        if (status == GL_FALSE)
+        {
+            // Not an error per se - the binary was produced by a different driver revision
+            // and the caller should fall back to compiling from source
+            glDeleteProgram(program);
+            program = 0;
+            throw std::runtime_error("driver rejected cached program binary");
+        }
+    }
+
     gl_shader(const std::string & vert, const std::string & frag, const std::string & geom = "")
     {
         program = glCreateProgram();
 
         glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_FALSE);
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
         ::compile_shader(program, GL_VERTEX_SHADER, vert.c_str());
         ::compile_shader(program, GL_FRAGMENT_SHADER, frag.c_str());
@@ -343,6 +1036,20 @@ public:
     GLuint handle() const { return program; }
     GLint get_uniform_location(const std::string & name) const { return glGetUniformLocation(program, name.c_str()); }
 
+    // Retrieve the linked program binary for disk caching. Returns false when the driver
+    // exposes no binary formats or the program was not linked with the retrievable hint.
+    bool get_binary(GLenum & format, std::vector<uint8_t> & binary) const
+    {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return false;
+        binary.resize(length);
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        binary.resize(written);
+        return written > 0;
+    }
+
     std::map<uint32_t, std::string> reflect()
     {
         std::map<uint32_t, std::string> locations;
@@ -377,13 +1084,15 @@ public:
 
     void texture(GLint loc, GLenum target, int unit, GLuint tex) const
     {
+        gl_submission_stats::get().add_texture_bind();
+        gl_command_capture::get().record_texture_bind(tex, unit);
         glBindMultiTextureEXT(GL_TEXTURE0 + unit, target, tex);
         glProgramUniform1i(program, loc, unit);
     }
 
     void texture(const char * name, int unit, GLuint tex, GLenum target) const { texture(get_uniform_location(name), target, unit, tex); }
 
-    void bind() { if (program > 0) enabled = true; glUseProgram(program); }
+    void bind() { if (program > 0) enabled = true; gl_submission_stats::get().add_program_bind(); gl_command_capture::get().record_program_bind(program); glUseProgram(program); }
     void unbind() { enabled = false; glUseProgram(0); }
 };
 
@@ -500,10 +1209,13 @@ public:
     void uniform(const std::string & name, float scalar) const {  glProgramUniform1f(program, get_uniform_location(name), scalar); }
     void uniform(const std::string & name, const linalg::aliases::float2 & vec) const { glProgramUniform2fv(program, get_uniform_location(name), 1, &vec.x); }
     void uniform(const std::string & name, const linalg::aliases::float4 & vec) const { glProgramUniform4fv(program, get_uniform_location(name), 1, &vec.x); }
+    void uniform(const std::string & name, const linalg::aliases::float4x4 & mat) const { glProgramUniformMatrix4fv(program, get_uniform_location(name), 1, GL_FALSE, mat.data()); }
     void uniform(const std::string & name, const int elements, const std::vector<linalg::aliases::float4> & vec) const { glProgramUniform4fv(program, get_uniform_location(name), elements, &vec[0].x); }
 
     void texture(GLint loc, GLenum target, int unit, GLuint tex) const
     {
+        gl_submission_stats::get().add_texture_bind();
+        gl_command_capture::get().record_texture_bind(tex, unit);
         glUseProgram(program);
         glBindMultiTextureEXT(GL_TEXTURE0 + unit, target, tex);
         glProgramUniform1i(program, loc, unit);
@@ -522,8 +1234,10 @@ public:
 class gl_mesh
 {
     gl_vertex_array_object vao;
+    gl_vertex_array_object depthVao; // attribute 0 + instance slots only, sourced from positionBuffer
 
     gl_buffer vertexBuffer;
+    gl_buffer positionBuffer;
     gl_buffer instanceBuffer;
 
     struct submesh
@@ -536,7 +1250,7 @@ class gl_mesh
 
     GLenum drawMode = GL_TRIANGLES;
     GLenum indexType = 0;
-    GLsizei vertexStride = 0, instanceStride = 0;
+    GLsizei vertexStride = 0, instanceStride = 0, positionStride = 0;
 
 public:
      
@@ -563,6 +1277,10 @@ public:
 
             submesh & idx = indexBuffers[submesh_index]; // note: will default construct
 
+            const uint64_t vertsSubmitted = (idx.count ? static_cast<uint64_t>(idx.count) : static_cast<uint64_t>(vertexBuffer.size / vertexStride)) * (instances ? instances : 1);
+            gl_submission_stats::get().add_draw_call(drawMode == GL_TRIANGLES ? vertsSubmitted / 3 : 0);
+            gl_command_capture::get().record_draw(drawMode, static_cast<uint32_t>(vertsSubmitted), static_cast<uint32_t>(instances));
+
             if (idx.count)
             {
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx.indexBuffer);
@@ -578,10 +1296,98 @@ public:
         }
     }
 
-    void set_vertex_data(GLsizeiptr size, const GLvoid * data, GLenum usage) { vertexBuffer.set_buffer_data(size, data, usage); }
+    // Submits every command in `indirect` against this mesh's vertex/index state with a single
+    // glMultiDrawElementsIndirect call. Requires GL_ARB_multi_draw_indirect (core in 4.3).
+    void draw_elements_indirect(const gl_indirect_buffer & indirect, int submesh_index = 0)
+    {
+        if (vertexBuffer.size && indirect.commandCount)
+        {
+            gl_submission_stats::get().add_draw_call(drawMode == GL_TRIANGLES ? indirect.totalIndices / 3 : 0);
+            gl_command_capture::get().record_draw(drawMode, static_cast<uint32_t>(indirect.totalIndices), static_cast<uint32_t>(indirect.commandCount));
+            glBindVertexArray(vao);
+            submesh & idx = indexBuffers[submesh_index];
+            if (idx.count)
+            {
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx.indexBuffer);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+                glMultiDrawElementsIndirect(drawMode, indexType, nullptr, indirect.commandCount, 0);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            }
+            glBindVertexArray(0);
+        }
+    }
+
+    GLsizei get_index_count(int submesh_index = 0) { return indexBuffers[submesh_index].count; }
+
+    void set_vertex_data(GLsizeiptr size, const GLvoid * data, GLenum usage) { vertexBuffer.memory.set_category(gl_memory_category::meshes); vertexBuffer.set_buffer_data(size, data, usage); }
     gl_buffer & get_vertex_data_buffer() { return vertexBuffer; };
 
-    void set_instance_data(GLsizeiptr size, const GLvoid * data, GLenum usage) { instanceBuffer.set_buffer_data(size, data, usage); }
+    // Optional second stream holding tightly-packed float3 positions. Depth-only passes
+    // (z-prepass, shadow cascades) draw through draw_elements_depth() and fetch 12 bytes
+    // per vertex instead of the full interleaved layout, at the cost of duplicating
+    // positions in GPU memory. Meshes without the stream fall back to the main vao.
+    void set_position_data(GLsizeiptr size, const GLvoid * data, GLenum usage)
+    {
+        positionBuffer.memory.set_category(gl_memory_category::meshes);
+        positionBuffer.set_buffer_data(size, data, usage);
+        positionStride = 3 * sizeof(float);
+        glEnableVertexArrayAttribEXT(depthVao, 0);
+        glVertexArrayVertexAttribOffsetEXT(depthVao, positionBuffer, 0, 3, GL_FLOAT, GL_FALSE, positionStride, 0);
+    }
+
+    bool has_position_stream() const { return positionStride != 0; }
+
+    // draw_elements against the position-only stream (falls back to the full layout
+    // when no stream was uploaded). Instance attributes are mirrored onto the depth
+    // vao by set_instance_attribute*, so the instanced prepass path works unchanged.
+    void draw_elements_depth(int instances = 0, int submesh_index = 0)
+    {
+        if (!has_position_stream()) return draw_elements(instances, submesh_index);
+
+        glBindVertexArray(depthVao);
+
+        submesh & idx = indexBuffers[submesh_index];
+
+        const uint64_t vertsSubmitted = (idx.count ? static_cast<uint64_t>(idx.count) : static_cast<uint64_t>(positionBuffer.size / positionStride)) * (instances ? instances : 1);
+        gl_submission_stats::get().add_draw_call(drawMode == GL_TRIANGLES ? vertsSubmitted / 3 : 0);
+        gl_command_capture::get().record_draw(drawMode, static_cast<uint32_t>(vertsSubmitted), static_cast<uint32_t>(instances));
+
+        if (idx.count)
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx.indexBuffer);
+            if (instances) glDrawElementsInstanced(drawMode, idx.count, indexType, 0, instances);
+            else glDrawElements(drawMode, idx.count, indexType, nullptr);
+        }
+        else
+        {
+            if (instances) glDrawArraysInstanced(drawMode, 0, static_cast<GLsizei>(positionBuffer.size / positionStride), instances);
+            else glDrawArrays(drawMode, 0, static_cast<GLsizei>(positionBuffer.size / positionStride));
+        }
+        glBindVertexArray(0);
+    }
+
+    void draw_elements_indirect_depth(const gl_indirect_buffer & indirect, int submesh_index = 0)
+    {
+        if (!has_position_stream()) return draw_elements_indirect(indirect, submesh_index);
+
+        if (indirect.commandCount)
+        {
+            gl_submission_stats::get().add_draw_call(drawMode == GL_TRIANGLES ? indirect.totalIndices / 3 : 0);
+            gl_command_capture::get().record_draw(drawMode, static_cast<uint32_t>(indirect.totalIndices), static_cast<uint32_t>(indirect.commandCount));
+            glBindVertexArray(depthVao);
+            submesh & idx = indexBuffers[submesh_index];
+            if (idx.count)
+            {
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx.indexBuffer);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+                glMultiDrawElementsIndirect(drawMode, indexType, nullptr, indirect.commandCount, 0);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            }
+            glBindVertexArray(0);
+        }
+    }
+
+    void set_instance_data(GLsizeiptr size, const GLvoid * data, GLenum usage) { instanceBuffer.memory.set_category(gl_memory_category::meshes); instanceBuffer.set_buffer_data(size, data, usage); }
 
     void set_index_data(GLenum mode, GLenum type, GLsizei count, const GLvoid * data, GLenum usage, int submesh_index = 0)
     {
@@ -592,6 +1398,7 @@ public:
         submesh & idx = indexBuffers[submesh_index];
         idx.count = count;
         idx.indexBuffer = {};
+        idx.indexBuffer.memory.set_category(gl_memory_category::meshes);
         idx.indexBuffer.set_buffer_data(size * count, data, usage);
     }
 
@@ -604,12 +1411,35 @@ public:
         vertexStride = stride;
     }
 
-    void set_instance_attribute(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * offset)
+    void set_instance_attribute(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * offset, GLuint divisor = 1)
     {
         glEnableVertexArrayAttribEXT(vao, index);
         glVertexArrayVertexAttribOffsetEXT(vao, instanceBuffer, index, size, type, normalized, stride, (GLintptr)offset);
-        glVertexArrayVertexAttribDivisorEXT(vao, index, 1);
+        glVertexArrayVertexAttribDivisorEXT(vao, index, divisor); // divisor > 1 repeats each element across consecutive instances (e.g. one per eye)
         instanceStride = stride;
+
+        if (has_position_stream())
+        {
+            glEnableVertexArrayAttribEXT(depthVao, index);
+            glVertexArrayVertexAttribOffsetEXT(depthVao, instanceBuffer, index, size, type, normalized, stride, (GLintptr)offset);
+            glVertexArrayVertexAttribDivisorEXT(depthVao, index, divisor);
+        }
+    }
+
+    // Variant sourcing the attribute from an external buffer instead of the mesh's own
+    // instance buffer (e.g. a GPU-compacted stream written by a culling compute pass)
+    void set_instance_attribute_buffer(GLuint buffer, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid * offset, GLuint divisor = 1)
+    {
+        glEnableVertexArrayAttribEXT(vao, index);
+        glVertexArrayVertexAttribOffsetEXT(vao, buffer, index, size, type, normalized, stride, (GLintptr)offset);
+        glVertexArrayVertexAttribDivisorEXT(vao, index, divisor);
+
+        if (has_position_stream())
+        {
+            glEnableVertexArrayAttribEXT(depthVao, index);
+            glVertexArrayVertexAttribOffsetEXT(depthVao, buffer, index, size, type, normalized, stride, (GLintptr)offset);
+            glVertexArrayVertexAttribDivisorEXT(depthVao, index, divisor);
+        }
     }
 
     void set_indices(GLenum mode, GLsizei count, const uint8_t * indices, GLenum usage) { set_index_data(mode, GL_UNSIGNED_BYTE, count, indices, usage); }
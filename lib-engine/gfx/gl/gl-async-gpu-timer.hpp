@@ -82,4 +82,68 @@ public:
 
 };
 
+// Frame-scoped variant built on GL_TIMESTAMP query pairs, so it can bracket a region that
+// already contains nested gl_gpu_timer scopes (GL_TIME_ELAPSED queries cannot nest).
+// Results are harvested without stalling; elapsed_ms() returns the most recent completed
+// frame, typically one or two frames behind.
+class gl_gpu_frame_timer
+{
+    struct stamp_pair { GLuint begin{ 0 }, end{ 0 }; bool pending{ false }; };
+
+    stamp_pair pairs[3];
+    int writeIdx{ 0 };
+    bool recording{ false };
+    double lastResultMs{ 0.0 };
+
+public:
+
+    ~gl_gpu_frame_timer()
+    {
+        for (auto & p : pairs)
+        {
+            if (p.begin) glDeleteQueries(1, &p.begin);
+            if (p.end) glDeleteQueries(1, &p.end);
+        }
+    }
+
+    void start()
+    {
+        stamp_pair & p = pairs[writeIdx];
+        if (!p.begin) { glCreateQueries(GL_TIMESTAMP, 1, &p.begin); glCreateQueries(GL_TIMESTAMP, 1, &p.end); }
+        if (p.pending) return; // all pairs in flight; skip recording this frame
+        glQueryCounter(p.begin, GL_TIMESTAMP);
+        recording = true;
+    }
+
+    void stop()
+    {
+        if (recording)
+        {
+            stamp_pair & p = pairs[writeIdx];
+            glQueryCounter(p.end, GL_TIMESTAMP);
+            p.pending = true;
+            writeIdx = (writeIdx + 1) % 3;
+            recording = false;
+        }
+
+        // Harvest any frame whose end stamp has landed
+        for (auto & p : pairs)
+        {
+            if (!p.pending) continue;
+            GLuint available = 0;
+            glGetQueryObjectuiv(p.end, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available)
+            {
+                uint64_t t0 = 0, t1 = 0;
+                glGetQueryObjectui64v(p.begin, GL_QUERY_RESULT, &t0);
+                glGetQueryObjectui64v(p.end, GL_QUERY_RESULT, &t1);
+                lastResultMs = (t1 - t0) * 1E-6;
+                p.pending = false;
+            }
+        }
+    }
+
+    double elapsed_ms() const { return lastResultMs; }
+};
+
 #endif // end timer_gl_gpu_h
@@ -0,0 +1,192 @@
+#pragma once
+
+#ifndef polymer_gl_compute_scan_hpp
+#define polymer_gl_compute_scan_hpp
+
+#include "gl-api.hpp"
+
+#include <vector>
+
+namespace polymer
+{
+    ////////////////////////
+    //   gl_prefix_scan   //
+    ////////////////////////
+
+    // GPU prefix scan and stream compaction over uint SSBOs. Shared infrastructure for
+    // anything that needs a dense survivor list built on the GPU - frustum/occlusion
+    // culling, particle emission, light binning - so each feature does not grow its own
+    // scan kernels. The scan is a classic three-kernel scheme: per-workgroup shared-memory
+    // scans, a recursive scan of the per-block totals, then a uniform-add of the block
+    // offsets; 100k elements is two levels of recursion. compact() additionally scatters
+    // the indices of non-zero flags into a dense buffer and writes the survivor count
+    // alongside a ready-made dispatch-indirect command, so a consumer can launch over
+    // exactly the compacted range without any readback.
+
+    static const char * prefix_scan_block_source = R"(#version 450
+        layout(local_size_x = 256) in;
+        layout(std430, binding = 0) readonly buffer Input { uint inputs[]; };
+        layout(std430, binding = 1) writeonly buffer Output { uint outputs[]; };
+        layout(std430, binding = 2) writeonly buffer BlockSums { uint blockSums[]; };
+        uniform int u_count;
+        shared uint temp[256];
+        void main()
+        {
+            uint gi = gl_GlobalInvocationID.x;
+            uint li = gl_LocalInvocationID.x;
+            uint value = (gi < uint(u_count)) ? inputs[gi] : 0u;
+            temp[li] = value;
+            barrier();
+
+            // Hillis-Steele inclusive scan in shared memory (all lanes iterate uniformly)
+            for (uint offset = 1u; offset < 256u; offset <<= 1u)
+            {
+                uint partial = (li >= offset) ? temp[li - offset] : 0u;
+                barrier();
+                temp[li] += partial;
+                barrier();
+            }
+
+            if (gi < uint(u_count)) outputs[gi] = temp[li] - value; // exclusive
+            if (li == 255u) blockSums[gl_WorkGroupID.x] = temp[255u];
+        })";
+
+    static const char * prefix_scan_add_offsets_source = R"(#version 450
+        layout(local_size_x = 256) in;
+        layout(std430, binding = 0) buffer Data { uint data[]; };
+        layout(std430, binding = 1) readonly buffer BlockOffsets { uint blockOffsets[]; };
+        uniform int u_count;
+        void main()
+        {
+            uint gi = gl_GlobalInvocationID.x;
+            if (gi < uint(u_count)) data[gi] += blockOffsets[gl_WorkGroupID.x];
+        })";
+
+    static const char * prefix_scan_scatter_source = R"(#version 450
+        layout(local_size_x = 256) in;
+        layout(std430, binding = 0) readonly buffer Flags { uint flags[]; };
+        layout(std430, binding = 1) readonly buffer Offsets { uint offsets[]; };
+        layout(std430, binding = 2) writeonly buffer Indices { uint indices[]; };
+        layout(std430, binding = 3) writeonly buffer Count { uint survivorCount; uint groupsX; uint groupsY; uint groupsZ; };
+        uniform int u_count;
+        uniform int u_indirectGroupSize;
+        void main()
+        {
+            uint gi = gl_GlobalInvocationID.x;
+            if (gi >= uint(u_count)) return;
+            if (flags[gi] != 0u) indices[offsets[gi]] = gi;
+            if (gi == uint(u_count) - 1u)
+            {
+                uint total = offsets[gi] + (flags[gi] != 0u ? 1u : 0u);
+                survivorCount = total;
+                groupsX = (total + uint(u_indirectGroupSize) - 1u) / uint(u_indirectGroupSize);
+                groupsY = 1u;
+                groupsZ = 1u;
+            }
+        })";
+
+    class gl_prefix_scan
+    {
+        static constexpr uint32_t block_size = 256;
+
+        gl_shader_compute blockScanShader{ prefix_scan_block_source };
+        gl_shader_compute addOffsetsShader{ prefix_scan_add_offsets_source };
+        gl_shader_compute scatterShader{ prefix_scan_scatter_source };
+
+        // Per-recursion-level scratch for the block totals and their scanned offsets.
+        // The buffers only grow; level 0 holds count/256 entries, level 1 count/65536.
+        struct scan_level { gl_buffer sums, offsets; size_t capacity{ 0 }; };
+        std::vector<scan_level> levels;
+
+        gl_buffer compactOffsets; // scan scratch for compact()
+        size_t compactCapacity{ 0 };
+
+        bool computeSupported{ false };
+
+        scan_level & ensure_level(const uint32_t level, const size_t blocks)
+        {
+            if (level >= levels.size()) levels.resize(level + 1);
+            scan_level & l = levels[level];
+            if (blocks > l.capacity)
+            {
+                l.capacity = blocks;
+                glNamedBufferDataEXT(l.sums, l.capacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+                glNamedBufferDataEXT(l.offsets, l.capacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+            }
+            return l;
+        }
+
+        void scan_recursive(const GLuint input, const GLuint output, const uint32_t count, const uint32_t level)
+        {
+            const uint32_t blocks = (count + block_size - 1) / block_size;
+            scan_level & l = ensure_level(level, blocks);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, input);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, output);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, l.sums);
+            blockScanShader.uniform("u_count", static_cast<int>(count));
+            blockScanShader.dispatch(blocks, 1, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+            if (blocks > 1)
+            {
+                scan_recursive(l.sums, l.offsets, blocks, level + 1);
+
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, output);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, l.offsets);
+                addOffsetsShader.uniform("u_count", static_cast<int>(count));
+                addOffsetsShader.dispatch(blocks, 1, 1);
+                glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            }
+        }
+
+    public:
+
+        gl_prefix_scan()
+        {
+            std::vector<std::pair<std::string, bool>> requiredExtensions = { { "GL_ARB_compute_shader", false } };
+            has_gl_extension(requiredExtensions);
+            computeSupported = requiredExtensions[0].second;
+        }
+
+        bool is_supported() const { return computeSupported; }
+
+        // Exclusive prefix sum of `count` uints from `input` into `output` (distinct buffers,
+        // both at least count * sizeof(uint32_t)). Entirely on-GPU; no readback.
+        void scan(const GLuint input, const GLuint output, const uint32_t count)
+        {
+            assert(count > 0);
+            scan_recursive(input, output, count, 0);
+        }
+
+        // Stream compaction: for every element whose flag is non-zero, its index is written
+        // densely into `indices` (survivor order preserved). `count_out` receives four uints:
+        // the survivor count, then a {x,1,1} dispatch-indirect command sized for workgroups
+        // of `indirect_group_size` - bind it at offset 4 for glDispatchComputeIndirect, or
+        // copy the count into an indirect draw's instanceCount. Flags must be 0 or 1.
+        void compact(const GLuint flags, const GLuint indices, const uint32_t count, const GLuint count_out, const uint32_t indirect_group_size = 128)
+        {
+            assert(count > 0);
+
+            if (count > compactCapacity)
+            {
+                compactCapacity = count;
+                glNamedBufferDataEXT(compactOffsets, compactCapacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+            }
+
+            scan_recursive(flags, compactOffsets, count, 0);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, flags);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, compactOffsets);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, indices);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, count_out);
+            scatterShader.uniform("u_count", static_cast<int>(count));
+            scatterShader.uniform("u_indirectGroupSize", static_cast<int>(indirect_group_size));
+            scatterShader.dispatch((count + block_size - 1) / block_size, 1, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_gl_compute_scan_hpp
@@ -0,0 +1,265 @@
+#pragma once
+
+#ifndef polymer_gl_compute_hpp
+#define polymer_gl_compute_hpp
+
+#include "gl-api.hpp"
+#include "gl-compute-scan.hpp"
+
+#include <string>
+#include <vector>
+
+namespace polymer
+{
+    // Reusable GPU compute primitives over SSBOs, shared by auto-exposure, SDSM
+    // depth reduction, particle sorting, and the light clusterer rather than each
+    // growing a bespoke kernel. Prefix scan and stream compaction live in
+    // gl-compute-scan.hpp (gl_prefix_scan); this header adds tree reduction with a
+    // caller-supplied combining operation, and a stable radix sort over uint keys.
+    // Scratch buffers are owned by the dispatcher and reused across calls; reuse is
+    // ordered by glMemoryBarrier within the command stream, so no fencing or
+    // round-robin is needed.
+
+    /////////////////////////////
+    //   gl_parallel_reduce    //
+    /////////////////////////////
+
+    // Two-level tree reduction whose element type, identity, and combining
+    // expression are injected into the kernel at construction, so one dispatcher
+    // serves sum/min/max over uint or float buffers:
+    //
+    //   gl_parallel_reduce max_reduce("float", "-3.4e38", "max(a, b)");
+    //   max_reduce.dispatch(luminanceBuffer, count, resultBuffer);
+
+    class gl_parallel_reduce
+    {
+        static constexpr uint32_t block_size = 256;
+
+        gl_shader_compute reduceShader;
+        gl_buffer scratch[2]; // ping-pong partials between levels
+        size_t scratchCapacity{ 0 };
+        size_t elementSize{ 4 };
+        bool computeSupported{ false };
+
+        static std::string kernel_source(const std::string & value_type, const std::string & identity, const std::string & combine)
+        {
+            return "#version 450\n"
+                "layout(local_size_x = 256) in;\n"
+                "layout(std430, binding = 0) readonly buffer Input { " + value_type + " inputs[]; };\n"
+                "layout(std430, binding = 1) writeonly buffer Output { " + value_type + " outputs[]; };\n"
+                "uniform int u_count;\n"
+                "shared " + value_type + " temp[256];\n"
+                + value_type + " combine_op(" + value_type + " a, " + value_type + " b) { return " + combine + "; }\n"
+                "void main()\n"
+                "{\n"
+                "    uint gi = gl_GlobalInvocationID.x;\n"
+                "    uint li = gl_LocalInvocationID.x;\n"
+                "    temp[li] = (gi < uint(u_count)) ? inputs[gi] : " + value_type + "(" + identity + ");\n"
+                "    barrier();\n"
+                "    for (uint s = 128u; s > 0u; s >>= 1u)\n"
+                "    {\n"
+                "        if (li < s) temp[li] = combine_op(temp[li], temp[li + s]);\n"
+                "        barrier();\n"
+                "    }\n"
+                "    if (li == 0u) outputs[gl_WorkGroupID.x] = temp[0];\n"
+                "}\n";
+        }
+
+    public:
+
+        // |value_type| is a GLSL scalar type ("uint", "float"), |identity| the
+        // operation's neutral element, and |combine| an expression over `a` and `b`.
+        gl_parallel_reduce(const std::string & value_type, const std::string & identity, const std::string & combine)
+            : reduceShader(kernel_source(value_type, identity, combine))
+        {
+            std::vector<std::pair<std::string, bool>> requiredExtensions = { { "GL_ARB_compute_shader", false } };
+            has_gl_extension(requiredExtensions);
+            computeSupported = requiredExtensions[0].second;
+        }
+
+        bool is_supported() const { return computeSupported; }
+
+        // Reduces |count| elements of |input| and copies the single-element result
+        // into |result| at |result_offset| bytes. Entirely on-GPU; no readback.
+        void dispatch(const GLuint input, const uint32_t count, const GLuint result, const GLintptr result_offset = 0)
+        {
+            assert(count > 0);
+
+            const size_t firstLevelBlocks = (count + block_size - 1) / block_size;
+            if (firstLevelBlocks > scratchCapacity)
+            {
+                scratchCapacity = firstLevelBlocks;
+                glNamedBufferDataEXT(scratch[0], scratchCapacity * elementSize, nullptr, GL_DYNAMIC_COPY);
+                glNamedBufferDataEXT(scratch[1], scratchCapacity * elementSize, nullptr, GL_DYNAMIC_COPY);
+            }
+
+            GLuint source = input;
+            uint32_t remaining = count;
+            uint32_t pingPong = 0;
+
+            while (true)
+            {
+                const uint32_t blocks = (remaining + block_size - 1) / block_size;
+                const GLuint destination = scratch[pingPong & 1];
+
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, source);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, destination);
+                reduceShader.uniform("u_count", static_cast<int>(remaining));
+                reduceShader.dispatch(blocks, 1, 1);
+                glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+                if (blocks == 1)
+                {
+                    glNamedCopyBufferSubDataEXT(destination, result, 0, result_offset, elementSize);
+                    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+                    return;
+                }
+
+                source = destination;
+                remaining = blocks;
+                ++pingPong;
+            }
+        }
+    };
+
+    ///////////////////////
+    //   gl_radix_sort   //
+    ///////////////////////
+
+    // Stable ascending radix sort over uint keys (8 passes of 4 bits), optionally
+    // permuting a parallel uint value buffer (indices, packed payloads). Per pass:
+    // a per-workgroup digit histogram, an exclusive scan of the digit-major
+    // histogram through gl_prefix_scan, then a stable scatter. The in-group rank
+    // loop is O(group size) per thread out of shared memory - simple and entirely
+    // adequate for the 10k-100k element sorts the engine performs per frame.
+
+    static const char * radix_histogram_source = R"(#version 450
+        layout(local_size_x = 256) in;
+        layout(std430, binding = 0) readonly buffer Keys { uint keys[]; };
+        layout(std430, binding = 1) writeonly buffer Histogram { uint histogram[]; };
+        uniform int u_count;
+        uniform int u_shift;
+        uniform int u_groupCount;
+        shared uint counts[16];
+        void main()
+        {
+            uint gi = gl_GlobalInvocationID.x;
+            uint li = gl_LocalInvocationID.x;
+            if (li < 16u) counts[li] = 0u;
+            barrier();
+            if (gi < uint(u_count)) atomicAdd(counts[(keys[gi] >> uint(u_shift)) & 15u], 1u);
+            barrier();
+            // digit-major layout so the scanned histogram yields global digit bases
+            if (li < 16u) histogram[li * uint(u_groupCount) + gl_WorkGroupID.x] = counts[li];
+        })";
+
+    static const char * radix_scatter_source = R"(#version 450
+        layout(local_size_x = 256) in;
+        layout(std430, binding = 0) readonly buffer Keys { uint keys[]; };
+        layout(std430, binding = 1) readonly buffer Offsets { uint offsets[]; };
+        layout(std430, binding = 2) writeonly buffer OutKeys { uint outKeys[]; };
+        layout(std430, binding = 3) readonly buffer Values { uint values[]; };
+        layout(std430, binding = 4) writeonly buffer OutValues { uint outValues[]; };
+        uniform int u_count;
+        uniform int u_shift;
+        uniform int u_groupCount;
+        uniform int u_hasValues;
+        shared uint digits[256];
+        void main()
+        {
+            uint gi = gl_GlobalInvocationID.x;
+            uint li = gl_LocalInvocationID.x;
+            const bool valid = gi < uint(u_count);
+            uint key = valid ? keys[gi] : 0u;
+            uint digit = (key >> uint(u_shift)) & 15u;
+            digits[li] = valid ? digit : 0xffu; // sentinel never matches a real digit
+            barrier();
+
+            if (!valid) return;
+
+            // Stable in-group rank: earlier lanes with the same digit
+            uint rank = 0u;
+            for (uint i = 0u; i < li; ++i) if (digits[i] == digit) ++rank;
+
+            uint dest = offsets[digit * uint(u_groupCount) + gl_WorkGroupID.x] + rank;
+            outKeys[dest] = key;
+            if (u_hasValues != 0) outValues[dest] = values[gi];
+        })";
+
+    class gl_radix_sort
+    {
+        static constexpr uint32_t block_size = 256;
+
+        gl_prefix_scan scan;
+        gl_shader_compute histogramShader{ radix_histogram_source };
+        gl_shader_compute scatterShader{ radix_scatter_source };
+
+        gl_buffer scratchKeys, scratchValues;
+        gl_buffer histogram, histogramScanned;
+        size_t keyCapacity{ 0 };
+        size_t histogramCapacity{ 0 };
+
+    public:
+
+        bool is_supported() const { return scan.is_supported(); }
+
+        // Sorts |count| uint keys in |keys| ascending, in place; when |values| is
+        // non-zero its elements are permuted alongside the keys. Eight
+        // histogram/scan/scatter rounds ping-ponging against internal scratch, so
+        // the sorted data always lands back in the caller's buffers.
+        void sort(const GLuint keys, const uint32_t count, const GLuint values = 0)
+        {
+            assert(count > 0);
+
+            const uint32_t groups = (count + block_size - 1) / block_size;
+
+            if (count > keyCapacity)
+            {
+                keyCapacity = count;
+                glNamedBufferDataEXT(scratchKeys, keyCapacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+                glNamedBufferDataEXT(scratchValues, keyCapacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+            }
+            if (groups * 16 > histogramCapacity)
+            {
+                histogramCapacity = groups * 16;
+                glNamedBufferDataEXT(histogram, histogramCapacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+                glNamedBufferDataEXT(histogramScanned, histogramCapacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_COPY);
+            }
+
+            for (int pass = 0; pass < 8; ++pass)
+            {
+                const int shift = pass * 4;
+                const bool even = (pass & 1) == 0;
+                const GLuint srcKeys = even ? keys : GLuint(scratchKeys);
+                const GLuint dstKeys = even ? GLuint(scratchKeys) : keys;
+                const GLuint srcValues = even ? values : GLuint(scratchValues);
+                const GLuint dstValues = even ? GLuint(scratchValues) : values;
+
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, srcKeys);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, histogram);
+                histogramShader.uniform("u_count", static_cast<int>(count));
+                histogramShader.uniform("u_shift", shift);
+                histogramShader.uniform("u_groupCount", static_cast<int>(groups));
+                histogramShader.dispatch(groups, 1, 1);
+                glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+                scan.scan(histogram, histogramScanned, groups * 16);
+
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, srcKeys);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, histogramScanned);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, dstKeys);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, values ? srcValues : srcKeys);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, values ? dstValues : GLuint(scratchValues));
+                scatterShader.uniform("u_count", static_cast<int>(count));
+                scatterShader.uniform("u_shift", shift);
+                scatterShader.uniform("u_groupCount", static_cast<int>(groups));
+                scatterShader.uniform("u_hasValues", values ? 1 : 0);
+                scatterShader.dispatch(groups, 1, 1);
+                glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            }
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_gl_compute_hpp
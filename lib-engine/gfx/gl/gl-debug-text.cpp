@@ -0,0 +1,164 @@
+#include "gl-debug-text.hpp"
+
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#define STBTT_STATIC // nanovg.c compiles its own copy of stb_truetype; keep ours internal
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb/stb_truetype.h"
+#pragma warning(pop)
+
+#include <cstddef>
+
+using namespace polymer;
+
+static constexpr int32_t atlas_size = 512;
+static constexpr int32_t first_glyph = 32;
+static constexpr int32_t num_glyphs = 95; // ascii 32..126
+
+constexpr const char debug_text_vert[] = R"(#version 330
+    layout(location = 0) in vec2 corner;
+    layout(location = 1) in vec2 i_position;
+    layout(location = 2) in vec2 i_size;
+    layout(location = 3) in vec4 i_uv_rect;
+    layout(location = 4) in vec4 i_color;
+    uniform vec2 u_resolution;
+    out vec2 v_uv;
+    out vec4 v_color;
+    void main()
+    {
+        vec2 pixel = i_position + corner * i_size;
+        vec2 ndc = vec2(pixel.x / u_resolution.x * 2.0 - 1.0, 1.0 - pixel.y / u_resolution.y * 2.0);
+        v_uv = mix(i_uv_rect.xy, i_uv_rect.zw, corner);
+        v_color = i_color;
+        gl_Position = vec4(ndc, 0.0, 1.0);
+    }
+)";
+
+constexpr const char debug_text_frag[] = R"(#version 330
+    uniform sampler2D s_atlas;
+    in vec2 v_uv;
+    in vec4 v_color;
+    out vec4 f_color;
+    void main() { f_color = vec4(v_color.rgb, v_color.a * texture(s_atlas, v_uv).r); }
+)";
+
+gl_debug_text::gl_debug_text(const std::vector<uint8_t> & font_binary, const float pixel_height) : bakedHeight(pixel_height)
+{
+    shader = gl_shader(debug_text_vert, debug_text_frag);
+
+    // Bake the ascii range into a single-channel atlas, once
+    std::vector<uint8_t> bitmap(atlas_size * atlas_size);
+    std::vector<stbtt_bakedchar> baked(num_glyphs);
+    stbtt_BakeFontBitmap(font_binary.data(), 0, pixel_height, bitmap.data(), atlas_size, atlas_size, first_glyph, num_glyphs, baked.data());
+
+    atlas.setup(atlas_size, atlas_size, GL_R8, GL_RED, GL_UNSIGNED_BYTE, bitmap.data(), false);
+    glTextureParameteriEXT(atlas, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteriEXT(atlas, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteriEXT(atlas, GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    glyphs.resize(num_glyphs);
+    for (int32_t i = 0; i < num_glyphs; ++i)
+    {
+        const stbtt_bakedchar & c = baked[i];
+        baked_glyph & g = glyphs[i];
+        g.uv_rect = float4(c.x0 / float(atlas_size), c.y0 / float(atlas_size), c.x1 / float(atlas_size), c.y1 / float(atlas_size));
+        g.size = float2(float(c.x1 - c.x0), float(c.y1 - c.y0));
+        g.offset = float2(c.xoff, c.yoff);
+        g.xadvance = c.xadvance;
+    }
+
+    // Unit quad expanded per instance; all glyph state rides in the instance stream
+    const float2 corners[4] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
+    quadBuffer.set_buffer_data(sizeof(corners), corners, GL_STATIC_DRAW);
+
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quadBuffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float2), (GLvoid *)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(glyph_instance), (GLvoid *)offsetof(glyph_instance, position));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(glyph_instance), (GLvoid *)offsetof(glyph_instance, size));
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glyph_instance), (GLvoid *)offsetof(glyph_instance, uv_rect));
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(glyph_instance), (GLvoid *)offsetof(glyph_instance, color));
+    glVertexAttribDivisor(4, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+float gl_debug_text::add_text(const std::string & text, const float2 & position, const float4 & color)
+{
+    float penX = position.x;
+    for (const char ch : text)
+    {
+        if (ch < first_glyph || ch >= first_glyph + num_glyphs) continue;
+        const baked_glyph & g = glyphs[ch - first_glyph];
+        if (g.size.x > 0 && g.size.y > 0)
+        {
+            instances.push_back({ float2(penX + g.offset.x, position.y + g.offset.y), g.size, g.uv_rect, color });
+        }
+        penX += g.xadvance;
+    }
+    return penX - position.x;
+}
+
+float gl_debug_text::measure_text(const std::string & text) const
+{
+    float width = 0.f;
+    for (const char ch : text)
+    {
+        if (ch < first_glyph || ch >= first_glyph + num_glyphs) continue;
+        width += glyphs[ch - first_glyph].xadvance;
+    }
+    return width;
+}
+
+void gl_debug_text::add_label(const std::string & text, const float3 & world_position, const float4x4 & viewProjMatrix, const float2 & screen_dims, const float4 & color)
+{
+    const float4 clip = viewProjMatrix * float4(world_position, 1.f);
+    if (clip.w <= 0.f) return; // behind the camera
+
+    const float2 ndc = float2(clip.x / clip.w, clip.y / clip.w);
+    if (std::abs(ndc.x) > 1.1f || std::abs(ndc.y) > 1.1f) return;
+
+    const float2 screen = float2((ndc.x + 1.f) * 0.5f * screen_dims.x, (1.f - ndc.y) * 0.5f * screen_dims.y);
+    add_text(text, float2(screen.x - measure_text(text) * 0.5f, screen.y), color);
+}
+
+void gl_debug_text::draw(const float2 & screen_dims)
+{
+    if (instances.empty()) return;
+
+    // Stream and orphan; the accumulation is rebuilt from scratch every frame
+    instanceBuffer.set_buffer_data(instances.size() * sizeof(glyph_instance), instances.data(), GL_STREAM_DRAW);
+
+    GLboolean wasDepthTestingEnabled = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean wasBlendingEnabled = glIsEnabled(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    shader.bind();
+    shader.uniform("u_resolution", screen_dims);
+    shader.texture("s_atlas", 0, atlas, GL_TEXTURE_2D);
+
+    glBindVertexArray(vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instances.size()));
+    glBindVertexArray(0);
+
+    shader.unbind();
+
+    if (wasDepthTestingEnabled) glEnable(GL_DEPTH_TEST);
+    if (!wasBlendingEnabled) glDisable(GL_BLEND);
+
+    instances.clear();
+}
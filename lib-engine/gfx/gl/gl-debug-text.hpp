@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef polymer_gl_debug_text_hpp
+#define polymer_gl_debug_text_hpp
+
+#include "gl-api.hpp"
+
+#include <string>
+#include <vector>
+
+namespace polymer
+{
+
+    ///////////////////////
+    //   gl_debug_text   //
+    ///////////////////////
+
+    // Bitmap-font fast path for high-volume diagnostic text (per-entity labels,
+    // counters). A glyph atlas is baked once at construction from a ttf binary;
+    // after that, text accumulates as per-glyph instance records and the whole
+    // frame's worth submits as a single instanced draw against the atlas - no
+    // per-frame rasterization or tessellation like the nanovg path. Intended for
+    // thousands of labels per frame; use gl_nvg_surface when quality matters.
+    class gl_debug_text
+    {
+        struct glyph_instance
+        {
+            float2 position;    // screen-space pixels, top-left of the quad
+            float2 size;        // quad size in pixels
+            float4 uv_rect;     // atlas uvs: x0, y0, x1, y1
+            float4 color;
+        };
+
+        struct baked_glyph
+        {
+            float4 uv_rect;
+            float2 size;
+            float2 offset;      // pen-relative placement (y is relative to the baseline)
+            float xadvance;
+        };
+
+        gl_texture_2d atlas;
+        gl_shader shader;
+        gl_buffer quadBuffer;           // unit quad corners, static
+        gl_buffer instanceBuffer;       // per-glyph records, streamed per frame
+        gl_vertex_array_object vao;
+        std::vector<baked_glyph> glyphs; // ascii 32..126
+        std::vector<glyph_instance> instances;
+        float bakedHeight{ 0.f };
+
+    public:
+
+        gl_debug_text(const std::vector<uint8_t> & font_binary, const float pixel_height = 16.f);
+
+        // Accumulates a run of text with its baseline starting at `position`
+        // (screen-space pixels, origin top-left). Returns the advance in pixels.
+        float add_text(const std::string & text, const float2 & position, const float4 & color);
+
+        // Projects a world position through `viewProjMatrix` and accumulates a
+        // centered label there; positions behind the camera or far off-screen are
+        // skipped. This is the per-entity debug label path.
+        void add_label(const std::string & text, const float3 & world_position, const float4x4 & viewProjMatrix, const float2 & screen_dims, const float4 & color);
+
+        float measure_text(const std::string & text) const;
+
+        // Streams the accumulated glyphs and draws them in one instanced call,
+        // then clears the accumulation for the next frame.
+        void draw(const float2 & screen_dims);
+    };
+
+} // end namespace polymer
+
+#endif // polymer_gl_debug_text_hpp
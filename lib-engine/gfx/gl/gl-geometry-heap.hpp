@@ -0,0 +1,254 @@
+#pragma once
+
+#ifndef polymer_gl_geometry_heap_hpp
+#define polymer_gl_geometry_heap_hpp
+
+#include "gl-api.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace polymer
+{
+    /////////////////////////
+    //   gl_geometry_heap  //
+    /////////////////////////
+
+    // One VAO, one large vertex buffer, and one large index buffer shared by every
+    // mesh of a given vertex format. Meshes are suballocated as {baseVertex,
+    // firstIndex} ranges, so a frame's worth of heap-resident geometry binds state
+    // once and submits through a single glMultiDrawElementsIndirect regardless of
+    // how many distinct meshes it spans - the per-mesh VAO/VBO binds that dominate
+    // CPU submission with per-mesh gl_mesh objects disappear entirely.
+    //
+    // Allocation is first-fit over a free list (ranges merge with their neighbours
+    // on release) with a bump pointer behind it; fragmentation() reports how much
+    // of the used range is free holes, and defragment() compacts live ranges
+    // downward with GPU-side buffer copies, patching the stored offsets. Callers
+    // that cache allocation structs must re-query after defragment() - the heap
+    // hands out stable ids for exactly that reason.
+
+    class gl_geometry_heap
+    {
+    public:
+
+        struct allocation
+        {
+            uint32_t id{ 0 };
+            GLuint baseVertex{ 0 };
+            GLuint vertexCount{ 0 };
+            GLuint firstIndex{ 0 };
+            GLuint indexCount{ 0 };
+            bool valid() const { return id != 0; }
+        };
+
+    private:
+
+        struct free_range
+        {
+            GLuint offset{ 0 };
+            GLuint count{ 0 }; // in elements (vertices or indices)
+        };
+
+        gl_vertex_array_object vao;
+        gl_buffer vertexBuffer;
+        gl_buffer indexBuffer;
+
+        GLsizei vertexStride{ 0 };
+        GLuint vertexCapacity{ 0 }, indexCapacity{ 0 };
+        GLuint vertexHighWater{ 0 }, indexHighWater{ 0 };
+
+        std::vector<free_range> freeVertices, freeIndices;
+        std::vector<allocation> allocations; // live suballocations
+        uint32_t nextId{ 1 };
+
+        // First-fit from the free list, else bump the high-water mark. Returns the
+        // element offset, or ~0u when the heap is exhausted.
+        static GLuint take_range(std::vector<free_range> & freeList, GLuint & highWater, const GLuint capacity, const GLuint count)
+        {
+            for (size_t i = 0; i < freeList.size(); ++i)
+            {
+                if (freeList[i].count >= count)
+                {
+                    const GLuint offset = freeList[i].offset;
+                    freeList[i].offset += count;
+                    freeList[i].count -= count;
+                    if (freeList[i].count == 0) freeList.erase(freeList.begin() + i);
+                    return offset;
+                }
+            }
+            if (highWater + count > capacity) return ~0u;
+            const GLuint offset = highWater;
+            highWater += count;
+            return offset;
+        }
+
+        // Returns a range to the free list, merging with adjacent holes (and
+        // shrinking the high-water mark when the hole sits at the very top)
+        static void give_range(std::vector<free_range> & freeList, GLuint & highWater, const GLuint offset, const GLuint count)
+        {
+            if (offset + count == highWater) { highWater = offset; return; }
+
+            free_range released{ offset, count };
+            for (size_t i = 0; i < freeList.size();)
+            {
+                free_range & f = freeList[i];
+                if (f.offset + f.count == released.offset) { released.offset = f.offset; released.count += f.count; freeList.erase(freeList.begin() + i); continue; }
+                if (released.offset + released.count == f.offset) { released.count += f.count; freeList.erase(freeList.begin() + i); continue; }
+                ++i;
+            }
+            freeList.push_back(released);
+        }
+
+        gl_geometry_heap(const gl_geometry_heap &) = delete;
+        gl_geometry_heap & operator = (const gl_geometry_heap &) = delete;
+
+    public:
+
+        // Capacities are in elements, not bytes. The buffers are allocated up front
+        // and never reallocated, so recorded offsets stay valid for the heap's life.
+        gl_geometry_heap(const GLuint vertex_capacity, const GLuint index_capacity, const GLsizei vertex_stride)
+            : vertexStride(vertex_stride), vertexCapacity(vertex_capacity), indexCapacity(index_capacity)
+        {
+            vertexBuffer.memory.set_category(gl_memory_category::meshes);
+            indexBuffer.memory.set_category(gl_memory_category::meshes);
+            vertexBuffer.set_buffer_data(static_cast<GLsizeiptr>(vertex_capacity) * vertex_stride, nullptr, GL_STATIC_DRAW);
+            indexBuffer.set_buffer_data(static_cast<GLsizeiptr>(index_capacity) * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+        }
+
+        // Declares one attribute of the heap's vertex format; byte offsets are
+        // within the interleaved stride, mirroring gl_mesh::set_attribute.
+        void set_attribute(GLuint index, GLint size, GLenum type, GLboolean normalized, const GLvoid * offset)
+        {
+            glEnableVertexArrayAttribEXT(vao, index);
+            glVertexArrayVertexAttribOffsetEXT(vao, vertexBuffer, index, size, type, normalized, vertexStride, (GLintptr)offset);
+        }
+
+        // Uploads interleaved vertices (heap format) and 32-bit indices into
+        // suballocated ranges. Returns an invalid allocation when full.
+        allocation allocate(const GLuint vertex_count, const void * vertices, const GLuint index_count, const uint32_t * indices)
+        {
+            const GLuint baseVertex = take_range(freeVertices, vertexHighWater, vertexCapacity, vertex_count);
+            if (baseVertex == ~0u) return {};
+
+            const GLuint firstIndex = take_range(freeIndices, indexHighWater, indexCapacity, index_count);
+            if (firstIndex == ~0u)
+            {
+                give_range(freeVertices, vertexHighWater, baseVertex, vertex_count);
+                return {};
+            }
+
+            vertexBuffer.set_buffer_sub_data(static_cast<GLsizeiptr>(vertex_count) * vertexStride, static_cast<GLintptr>(baseVertex) * vertexStride, vertices);
+            indexBuffer.set_buffer_sub_data(static_cast<GLsizeiptr>(index_count) * sizeof(uint32_t), static_cast<GLintptr>(firstIndex) * sizeof(uint32_t), indices);
+
+            allocation a{ nextId++, baseVertex, vertex_count, firstIndex, index_count };
+            allocations.push_back(a);
+            return a;
+        }
+
+        void release(const uint32_t id)
+        {
+            for (size_t i = 0; i < allocations.size(); ++i)
+            {
+                if (allocations[i].id != id) continue;
+                give_range(freeVertices, vertexHighWater, allocations[i].baseVertex, allocations[i].vertexCount);
+                give_range(freeIndices, indexHighWater, allocations[i].firstIndex, allocations[i].indexCount);
+                allocations.erase(allocations.begin() + i);
+                return;
+            }
+        }
+
+        // Offsets move after defragment(); look allocations up by id instead of caching them
+        allocation find(const uint32_t id) const
+        {
+            for (const allocation & a : allocations) if (a.id == id) return a;
+            return {};
+        }
+
+        // Fraction of the used region (below the high-water marks) that is free holes
+        float fragmentation() const
+        {
+            GLuint holes = 0;
+            for (const free_range & f : freeVertices) holes += f.count;
+            return vertexHighWater ? static_cast<float>(holes) / static_cast<float>(vertexHighWater) : 0.f;
+        }
+
+        // Slides live ranges down over the holes with GPU-side copies (no CPU
+        // round-trip) and patches the recorded offsets. O(live allocations) buffer
+        // copies - intended for unload boundaries, not per-frame use.
+        void defragment()
+        {
+            std::sort(allocations.begin(), allocations.end(), [](const allocation & a, const allocation & b) { return a.baseVertex < b.baseVertex; });
+
+            GLuint vertexCursor = 0;
+            for (allocation & a : allocations)
+            {
+                if (a.baseVertex != vertexCursor)
+                {
+                    glNamedCopyBufferSubDataEXT(vertexBuffer, vertexBuffer,
+                        static_cast<GLintptr>(a.baseVertex) * vertexStride,
+                        static_cast<GLintptr>(vertexCursor) * vertexStride,
+                        static_cast<GLsizeiptr>(a.vertexCount) * vertexStride);
+                    a.baseVertex = vertexCursor;
+                }
+                vertexCursor += a.vertexCount;
+            }
+            vertexHighWater = vertexCursor;
+            freeVertices.clear();
+
+            std::sort(allocations.begin(), allocations.end(), [](const allocation & a, const allocation & b) { return a.firstIndex < b.firstIndex; });
+
+            GLuint indexCursor = 0;
+            for (allocation & a : allocations)
+            {
+                if (a.firstIndex != indexCursor)
+                {
+                    glNamedCopyBufferSubDataEXT(indexBuffer, indexBuffer,
+                        static_cast<GLintptr>(a.firstIndex) * sizeof(uint32_t),
+                        static_cast<GLintptr>(indexCursor) * sizeof(uint32_t),
+                        static_cast<GLsizeiptr>(a.indexCount) * sizeof(uint32_t));
+                    a.firstIndex = indexCursor;
+                }
+                indexCursor += a.indexCount;
+            }
+            indexHighWater = indexCursor;
+            freeIndices.clear();
+        }
+
+        // Submits one command per allocation in `batch` through a single
+        // glMultiDrawElementsIndirect - the cross-mesh MDI the heap exists for.
+        void draw_indirect(const std::vector<allocation> & batch, gl_indirect_buffer & indirect, const GLuint instances_per_mesh = 1)
+        {
+            if (batch.empty()) return;
+
+            std::vector<draw_elements_indirect_command> commands;
+            commands.reserve(batch.size());
+            for (const allocation & a : batch)
+            {
+                draw_elements_indirect_command cmd;
+                cmd.count = a.indexCount;
+                cmd.instanceCount = instances_per_mesh;
+                cmd.firstIndex = a.firstIndex;
+                cmd.baseVertex = a.baseVertex;
+                cmd.baseInstance = 0;
+                commands.push_back(cmd);
+            }
+            indirect.set_commands(commands, GL_STREAM_DRAW);
+
+            gl_submission_stats::get().add_draw_call(indirect.totalIndices / 3);
+            glBindVertexArray(vao);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, indirect.commandCount, 0);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            glBindVertexArray(0);
+        }
+
+        size_t live_allocations() const { return allocations.size(); }
+        GLuint vertices_used() const { return vertexHighWater; }
+        GLuint indices_used() const { return indexHighWater; }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_gl_geometry_heap_hpp
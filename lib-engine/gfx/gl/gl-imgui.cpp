@@ -5,6 +5,8 @@
 
 #include <functional>
 #include <memory>
+#include <algorithm>
+#include <cstring>
 #include "gl-imgui.hpp"
 #include "imgui/imgui_internal.h"
 #include "gl-api.hpp"
@@ -213,40 +215,97 @@ namespace gui
         data.AttribLocationUV = glGetAttribLocation(data.ShaderHandle, "UV");
         data.AttribLocationColor = glGetAttribLocation(data.ShaderHandle, "Color");
         
+        glGenVertexArrays(1, &data.VaoHandle);
+
+        // Initial ring allocation; this also records the attribute layout into the vao
+        ensure_ring_capacity(1, 1);
+
+        create_fonts_texture();
+        
+        // Restore modified GL state
+        glBindTexture(GL_TEXTURE_2D, last_texture);
+        glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+        glBindVertexArray(last_vertex_array);
+        
+        return true;
+    }
+
+    // (Re)allocates the persistently mapped vertex/index ring when a frame needs more
+    // room than a section holds. The ring is three sections deep and grow-only: steady
+    // state performs no allocation, no orphaning and no map/unmap - the cpu writes
+    // straight into coherent memory while the gpu consumes older sections.
+    void imgui_instance::ensure_ring_capacity(const ptrdiff_t vertices, const ptrdiff_t indices)
+    {
+        if (data.VtxMapped && vertices <= data.VtxSectionCapacity && indices <= data.IdxSectionCapacity) return;
+
+        // The whole ring is replaced, so every in-flight section must retire first
+        for (auto & fence : data.SectionFence)
+        {
+            if (!fence) continue;
+            while (true)
+            {
+                const GLenum wait = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+                if (wait == GL_ALREADY_SIGNALED || wait == GL_CONDITION_SATISFIED) break;
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        if (data.VboHandle) glDeleteBuffers(1, &data.VboHandle);           // deletion implicitly unmaps
+        if (data.ElementsHandle) glDeleteBuffers(1, &data.ElementsHandle);
+
+        data.VtxSectionCapacity = std::max({ vertices, data.VtxSectionCapacity * 2, ptrdiff_t(16384) });
+        data.IdxSectionCapacity = std::max({ indices, data.IdxSectionCapacity * 2, ptrdiff_t(32768) });
+
+        const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
         glGenBuffers(1, &data.VboHandle);
         glGenBuffers(1, &data.ElementsHandle);
-        
-        glGenVertexArrays(1, &data.VaoHandle);
+
         glBindVertexArray(data.VaoHandle);
+
         glBindBuffer(GL_ARRAY_BUFFER, data.VboHandle);
+        glBufferStorage(GL_ARRAY_BUFFER, 3 * data.VtxSectionCapacity * sizeof(ImDrawVert), nullptr, mapFlags);
+        data.VtxMapped = reinterpret_cast<ImDrawVert *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, 3 * data.VtxSectionCapacity * sizeof(ImDrawVert), mapFlags));
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.ElementsHandle); // recorded into the vao
+        glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, 3 * data.IdxSectionCapacity * sizeof(ImDrawIdx), nullptr, mapFlags);
+        data.IdxMapped = reinterpret_cast<ImDrawIdx *>(glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, 3 * data.IdxSectionCapacity * sizeof(ImDrawIdx), mapFlags));
+
+        // Re-point the attribute bindings at the new vertex buffer
         glEnableVertexAttribArray(data.AttribLocationPosition);
         glEnableVertexAttribArray(data.AttribLocationUV);
         glEnableVertexAttribArray(data.AttribLocationColor);
-        
+
         #define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
         glVertexAttribPointer(data.AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
         glVertexAttribPointer(data.AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
         glVertexAttribPointer(data.AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, col));
         #undef OFFSETOF
-        
-        create_fonts_texture();
-        
-        // Restore modified GL state
-        glBindTexture(GL_TEXTURE_2D, last_texture);
-        glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-        glBindVertexArray(last_vertex_array);
-        
-        return true;
+
+        glBindVertexArray(0);
+
+        data.RingSection = 0;
     }
-    
+
     void imgui_instance::destroy_render_objects()
     {
         ImGui::SetCurrentContext(data.context);
 
+        for (auto & fence : data.SectionFence)
+        {
+            if (fence) glDeleteSync(fence);
+            fence = nullptr;
+        }
+
         if (data.VaoHandle) glDeleteVertexArrays(1, &data.VaoHandle);
         if (data.VboHandle) glDeleteBuffers(1, &data.VboHandle);
         if (data.ElementsHandle) glDeleteBuffers(1, &data.ElementsHandle);
         data.VaoHandle = data.VboHandle = data.ElementsHandle = 0;
+        data.VtxMapped = nullptr;
+        data.IdxMapped = nullptr;
+        data.VtxSectionCapacity = data.IdxSectionCapacity = 0;
+        data.RingSection = 0;
         
         if (data.ShaderHandle && data.VertHandle) glDetachShader(data.ShaderHandle, data.VertHandle);
         if (data.VertHandle) glDeleteShader(data.VertHandle);
@@ -369,35 +428,80 @@ namespace gui
         glUseProgram(data.ShaderHandle);
         glUniform1i(data.AttribLocationTex, 0);
         glUniformMatrix4fv(data.AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+
+        ptrdiff_t totalVtx = 0, totalIdx = 0;
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            totalVtx += drawData->CmdLists[n]->VtxBuffer.size();
+            totalIdx += drawData->CmdLists[n]->IdxBuffer.size();
+        }
+        ensure_ring_capacity(totalVtx, totalIdx); // grow-only; a no-op in steady state
+
+        // Wait until the gpu has retired this ring section before writing into it.
+        // At three sections deep this only ever blocks when the gpu is more than two
+        // full frames behind.
+        const uint32_t section = data.RingSection;
+        if (data.SectionFence[section])
+        {
+            while (true)
+            {
+                const GLenum wait = glClientWaitSync(data.SectionFence[section], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+                if (wait == GL_ALREADY_SIGNALED || wait == GL_CONDITION_SATISFIED) break;
+            }
+            glDeleteSync(data.SectionFence[section]);
+            data.SectionFence[section] = nullptr;
+        }
+
         glBindVertexArray(data.VaoHandle);
 
+        const ptrdiff_t vtxBase = section * data.VtxSectionCapacity;
+        const ptrdiff_t idxBase = section * data.IdxSectionCapacity;
+        ptrdiff_t vtxOffset = 0, idxOffset = 0;
+
         for (int n = 0; n < drawData->CmdListsCount; n++)
         {
             const ImDrawList* cmd_list = drawData->CmdLists[n];
-            const ImDrawIdx* idx_buffer_offset = 0;
 
-            glBindBuffer(GL_ARRAY_BUFFER, data.VboHandle);
-            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.size() * sizeof(ImDrawVert), (GLvoid*)&cmd_list->VtxBuffer.front(), GL_STREAM_DRAW);
+            if (cmd_list->VtxBuffer.size()) std::memcpy(data.VtxMapped + vtxBase + vtxOffset, &cmd_list->VtxBuffer.front(), cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
+            if (cmd_list->IdxBuffer.size()) std::memcpy(data.IdxMapped + idxBase + idxOffset, &cmd_list->IdxBuffer.front(), cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
 
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.ElementsHandle);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx), (GLvoid*)&cmd_list->IdxBuffer.front(), GL_STREAM_DRAW);
+            ptrdiff_t listIdxOffset = idxBase + idxOffset;
 
-            for (const ImDrawCmd* pcmd = cmd_list->CmdBuffer.begin(); pcmd != cmd_list->CmdBuffer.end(); pcmd++)
+            for (int c = 0; c < cmd_list->CmdBuffer.size(); ++c)
             {
+                const ImDrawCmd * pcmd = &cmd_list->CmdBuffer[c];
+
                 if (pcmd->UserCallback)
                 {
                     pcmd->UserCallback(cmd_list, pcmd);
+                    listIdxOffset += pcmd->ElemCount;
+                    continue;
                 }
-                else
+
+                // Merge runs of commands that share texture and clip state into one draw
+                GLsizei elemCount = (GLsizei)pcmd->ElemCount;
+                while (c + 1 < cmd_list->CmdBuffer.size())
                 {
-                    glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
-                    glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-                    glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset);
+                    const ImDrawCmd * next = &cmd_list->CmdBuffer[c + 1];
+                    if (next->UserCallback || next->TextureId != pcmd->TextureId || std::memcmp(&next->ClipRect, &pcmd->ClipRect, sizeof(ImVec4)) != 0) break;
+                    elemCount += (GLsizei)next->ElemCount;
+                    ++c;
                 }
-                idx_buffer_offset += pcmd->ElemCount;
+
+                glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
+                glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
+                glDrawElementsBaseVertex(GL_TRIANGLES, elemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                    (GLvoid *)(listIdxOffset * sizeof(ImDrawIdx)), (GLint)(vtxBase + vtxOffset));
+                listIdxOffset += elemCount;
             }
+
+            vtxOffset += cmd_list->VtxBuffer.size();
+            idxOffset += cmd_list->IdxBuffer.size();
         }
 
+        data.SectionFence[section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        data.RingSection = (section + 1) % 3;
+
         // Restore modified GL state
         glUseProgram(last_program);
         glBindTexture(GL_TEXTURE_2D, last_texture);
@@ -61,6 +61,15 @@ namespace gui
         int          AttribLocationPosition = 0, AttribLocationUV = 0, AttribLocationColor = 0;
         unsigned int VboHandle = 0, VaoHandle = 0, ElementsHandle = 0;
         uint32_t     FontTexture = 0;
+
+        // Persistently mapped vertex/index ring: three frame-sized sections deep so
+        // cpu writes never stall on in-flight draws, grow-only, never orphaned
+        ImDrawVert * VtxMapped = nullptr;
+        ImDrawIdx  * IdxMapped = nullptr;
+        ptrdiff_t    VtxSectionCapacity = 0; // in vertices, per section
+        ptrdiff_t    IdxSectionCapacity = 0; // in indices, per section
+        uint32_t     RingSection = 0;
+        GLsync       SectionFence[3] = { nullptr, nullptr, nullptr };
     };
 
     class imgui_instance
@@ -68,6 +77,7 @@ namespace gui
         bool create_fonts_texture();
         bool create_render_objects();
         void destroy_render_objects();
+        void ensure_ring_capacity(const ptrdiff_t vertices, const ptrdiff_t indices);
         imgui_data data;
     public:
         imgui_instance(GLFWwindow * win, bool use_default_font = false);
@@ -5,11 +5,120 @@
 
 #include "file_io.hpp"
 #include "gl-api.hpp"
-#include "stb/stb_image.h" 
+#include "thread-pool.hpp"
+#include "stb/stb_image.h"
 #include "gli/gli.hpp"
 
 namespace polymer
 {
+    // CPU mip-chain generation. glGenerateMipmap runs on the GL thread and serializes
+    // a texture-set import behind the driver; computing the chain on workers instead
+    // lets mip filtering overlap decode and upload of other assets, and lets us filter
+    // sRGB-encoded color in linear space (the driver's box filter averages raw gamma
+    // values, which visibly darkens bright-on-dark detail in lower mips).
+
+    namespace detail
+    {
+        inline const float * srgb_decode_table()
+        {
+            static float table[256] = {};
+            static bool initialized = []() // magic-static init keeps this thread-safe for concurrent workers
+            {
+                for (int i = 0; i < 256; ++i)
+                {
+                    const float v = i / 255.f;
+                    table[i] = (v <= 0.04045f) ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+                }
+                return true;
+            }();
+            (void) initialized;
+            return table;
+        }
+
+        inline uint8_t srgb_encode(const float linear)
+        {
+            const float v = (linear <= 0.0031308f) ? linear * 12.92f : 1.055f * std::pow(linear, 1.f / 2.4f) - 0.055f;
+            return static_cast<uint8_t>(clamp(v, 0.f, 1.f) * 255.f + 0.5f);
+        }
+    }
+
+    // Generates the full mip chain below an 8-bit image with a 2x2 box filter, one
+    // vector of pixels per level (level 0 is not included). Rows of each level are
+    // filtered through parallel_for, so large levels fan out across the scheduler's
+    // workers. When |srgb| is set the first three channels are averaged in linear
+    // space and re-encoded; alpha and 1/2-channel data are always averaged linearly.
+    // Odd dimensions clamp the trailing source row/column, matching glGenerateMipmap.
+    inline std::vector<std::vector<uint8_t>> generate_cpu_mips(const uint8_t * pixels, const int32_t width, const int32_t height, const int32_t channels, const bool srgb)
+    {
+        std::vector<std::vector<uint8_t>> levels;
+        const float * toLinear = detail::srgb_decode_table();
+        const int32_t srgbChannels = srgb ? std::min(channels, 3) : 0;
+
+        const uint8_t * src = pixels;
+        int32_t srcW = width, srcH = height;
+
+        while (srcW > 1 || srcH > 1)
+        {
+            const int32_t dstW = std::max(srcW >> 1, 1);
+            const int32_t dstH = std::max(srcH >> 1, 1);
+
+            levels.emplace_back(size_t(dstW) * size_t(dstH) * size_t(channels));
+            uint8_t * dst = levels.back().data();
+
+            parallel_for(0, size_t(dstH), 16, [&](const size_t y)
+            {
+                const int32_t y0 = int32_t(y) * 2;
+                const int32_t y1 = std::min(y0 + 1, srcH - 1);
+                uint8_t * out = dst + y * size_t(dstW) * size_t(channels);
+
+                for (int32_t x = 0; x < dstW; ++x)
+                {
+                    const int32_t x0 = x * 2;
+                    const int32_t x1 = std::min(x0 + 1, srcW - 1);
+
+                    const uint8_t * p00 = src + (size_t(y0) * srcW + x0) * channels;
+                    const uint8_t * p01 = src + (size_t(y0) * srcW + x1) * channels;
+                    const uint8_t * p10 = src + (size_t(y1) * srcW + x0) * channels;
+                    const uint8_t * p11 = src + (size_t(y1) * srcW + x1) * channels;
+
+                    for (int32_t c = 0; c < channels; ++c)
+                    {
+                        if (c < srgbChannels)
+                        {
+                            const float avg = (toLinear[p00[c]] + toLinear[p01[c]] + toLinear[p10[c]] + toLinear[p11[c]]) * 0.25f;
+                            out[x * channels + c] = detail::srgb_encode(avg);
+                        }
+                        else
+                        {
+                            out[x * channels + c] = static_cast<uint8_t>((uint32_t(p00[c]) + p01[c] + p10[c] + p11[c] + 2) >> 2);
+                        }
+                    }
+                }
+            });
+
+            src = dst;
+            srcW = dstW;
+            srcH = dstH;
+        }
+
+        return levels;
+    }
+
+    // Uploads a chain produced by generate_cpu_mips into levels 1..N of |tex| and
+    // marks the chain complete, replacing glGenerateMipmap.
+    inline void upload_cpu_mips(gl_texture_2d & tex, const std::vector<std::vector<uint8_t>> & mips, const int32_t width, const int32_t height, const GLenum internal_fmt, const GLenum format, const GLenum type)
+    {
+        int32_t w = width, h = height;
+        GLint level = 0;
+        for (const std::vector<uint8_t> & mip : mips)
+        {
+            w = std::max(w >> 1, 1);
+            h = std::max(h >> 1, 1);
+            glTextureImage2DEXT(tex, GL_TEXTURE_2D, ++level, internal_fmt, w, h, 0, format, type, mip.data());
+        }
+        glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level);
+        glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
 
     inline void flip_image_inplace(unsigned char * pixels, const uint32_t width, const uint32_t height, const uint32_t bytes_per_pixel)
     {
@@ -28,7 +137,8 @@ namespace polymer
 
     inline std::vector<uint8_t> load_image_data(const std::string & path)
     {
-        auto binaryFile = read_file_binary(path);
+        // stbi parses straight out of the mapped view, skipping a full-file copy
+        mapped_file binaryFile(path);
 
         int width, height, nBytes;
         auto data = stbi_load_from_memory(binaryFile.data(), (int)binaryFile.size(), &width, &height, &nBytes, 0);
@@ -38,9 +148,11 @@ namespace polymer
         return d;
     }
 
-    inline gl_texture_2d load_image(const std::string & path, bool flip = false)
+    // When |srgb| is set the mip chain is filtered in linear space (albedo and other
+    // color maps); leave it false for data textures (normal maps, masks).
+    inline gl_texture_2d load_image(const std::string & path, bool flip = false, bool srgb = false)
     {
-        auto binaryFile = polymer::read_file_binary(path);
+        mapped_file binaryFile(path);
 
         if (flip) stbi_set_flip_vertically_on_load(1);
         else stbi_set_flip_vertically_on_load(0);
@@ -51,13 +163,22 @@ namespace polymer
         gl_texture_2d tex;
         switch (nBytes)
         {
-        case 1: tex.setup(width, height, GL_RED, GL_RED, GL_UNSIGNED_BYTE, data, true); break;
-        case 2: tex.setup(width, height, GL_RED, GL_RED, GL_UNSIGNED_SHORT, data, true); break;
-        case 3: tex.setup(width, height, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, data, true); break;
-        case 4: tex.setup(width, height, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, data, true); break;
+        case 1: tex.setup(width, height, GL_RED, GL_RED, GL_UNSIGNED_BYTE, data); break;
+        case 2: tex.setup(width, height, GL_RED, GL_RED, GL_UNSIGNED_SHORT, data, true); break; // 16-bit path keeps driver mips
+        case 3: tex.setup(width, height, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, data); break;
+        case 4: tex.setup(width, height, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, data); break;
         default: throw std::runtime_error("unsupported number of channels");
         }
 
+        // 8-bit formats take the CPU chain: filtering fans out across the scheduler's
+        // workers instead of serializing on the driver's GL-thread mip generation
+        if (nBytes != 2)
+        {
+            const GLenum format = (nBytes == 1) ? GL_RED : (nBytes == 3) ? GL_RGB : GL_RGBA;
+            const auto mips = generate_cpu_mips(data, width, height, nBytes, srgb);
+            upload_cpu_mips(tex, mips, width, height, format, format, GL_UNSIGNED_BYTE);
+        }
+
         glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 
@@ -65,6 +186,35 @@ namespace polymer
         return tex;
     }
 
+    // Decodes a Radiance *.hdr (or any stb float format) image into packed RGB
+    // float triplets. Pure CPU work - safe to run on a worker.
+    // Tiny constant-color texture, used for the streaming fallbacks a material
+    // samples while its real textures are still loading
+    inline gl_texture_2d make_solid_color_texture(const uint8_t r, const uint8_t g, const uint8_t b, const uint8_t a)
+    {
+        uint8_t pixels[4 * 4 * 4];
+        for (size_t i = 0; i < sizeof(pixels); i += 4) { pixels[i] = r; pixels[i + 1] = g; pixels[i + 2] = b; pixels[i + 3] = a; }
+        gl_texture_2d tex;
+        tex.setup(4, 4, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        return tex;
+    }
+
+    inline std::vector<float> load_hdr_image_data(const std::string & path, int32_t & width, int32_t & height)
+    {
+        mapped_file binaryFile(path);
+
+        int w, h, c;
+        float * data = stbi_loadf_from_memory(binaryFile.data(), (int) binaryFile.size(), &w, &h, &c, 3);
+        if (!data) throw std::runtime_error("failed to decode hdr image: " + path);
+
+        std::vector<float> pixels(data, data + size_t(w) * size_t(h) * 3);
+        stbi_image_free(data);
+
+        width = w;
+        height = h;
+        return pixels;
+    }
+
     inline gl_texture_2d load_cubemap(const gli::texture_cube & tex)
     {
         gl_texture_2d t;
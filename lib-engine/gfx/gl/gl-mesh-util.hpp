@@ -13,6 +13,7 @@
 #include <fstream>
 #include <algorithm>
 #include <assert.h>
+#include <string.h>
 
 #if defined(POLYMER_PLATFORM_WINDOWS)
 #pragma warning(push)
@@ -119,6 +120,137 @@ namespace polymer
             m.set_elements(geometry.faces, usage);
         }
 
+        // Position-only stream for depth/shadow passes
+        m.set_position_data(geometry.vertices.size() * sizeof(float3), geometry.vertices.data(), usage);
+
+        return m;
+    }
+
+    // IEEE 754 float -> half bits (round toward zero, denormals flushed, overflow to inf)
+    inline uint16_t float_to_half_bits(const float f)
+    {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        const uint32_t sign = (bits >> 16) & 0x8000;
+        const int32_t exponent = ((bits >> 23) & 0xff) - 127 + 15;
+        if (exponent <= 0) return static_cast<uint16_t>(sign);
+        if (exponent >= 31) return static_cast<uint16_t>(sign | 0x7c00);
+        return static_cast<uint16_t>(sign | (exponent << 10) | ((bits & 0x007fffff) >> 13));
+    }
+
+    // Unit vector -> GL_INT_2_10_10_10_REV signed-normalized (w unused)
+    inline uint32_t pack_snorm_2_10_10_10(const float3 & v)
+    {
+        auto pack = [](float f) -> uint32_t
+        {
+            f = std::max(-1.f, std::min(1.f, f));
+            const int32_t i = static_cast<int32_t>(f * 511.f + (f >= 0.f ? 0.5f : -0.5f));
+            return static_cast<uint32_t>(i) & 0x3ff;
+        };
+        return pack(v.x) | (pack(v.y) << 10) | (pack(v.z) << 20);
+    }
+
+    // Same attribute set as make_mesh_from_geometry, but packed: positions stay
+    // full float, while normals/tangents/bitangents drop to 10-bit signed-normalized
+    // (GL_INT_2_10_10_10_REV), colors to 8-bit, uvs to half float, and indices to
+    // 16-bit when the mesh has few enough vertices. Vertex fetch expands every
+    // format back to the float vec the shaders already declare, so the packed and
+    // full-fat paths are interchangeable per mesh - a fully-attributed vertex
+    // shrinks from 68 to 32 bytes, which matters most in the depth and shadow
+    // prepasses where position is the only attribute actually consumed.
+    inline gl_mesh make_mesh_from_geometry_packed(const geometry & geometry, const GLenum usage = GL_STATIC_DRAW)
+    {
+        assert(geometry.vertices.size() > 0);
+
+        gl_mesh m;
+
+        int normalOffset = 0;
+        int colorOffset = 0;
+        int texOffset = 0;
+        int tanOffset = 0;
+        int bitanOffset = 0;
+
+        int stride = 3 * sizeof(float); // position
+
+        if (geometry.normals.size() != 0)    { normalOffset = stride; stride += 4; }
+        if (geometry.colors.size() != 0)     { colorOffset = stride;  stride += 4; }
+        if (geometry.texcoord0.size() != 0)  { texOffset = stride;    stride += 4; }
+        if (geometry.tangents.size() != 0)   { tanOffset = stride;    stride += 4; }
+        if (geometry.bitangents.size() != 0) { bitanOffset = stride;  stride += 4; }
+
+        std::vector<uint8_t> buffer(geometry.vertices.size() * stride);
+
+        for (size_t i = 0; i < geometry.vertices.size(); ++i)
+        {
+            uint8_t * vertex = buffer.data() + i * stride;
+
+            memcpy(vertex, &geometry.vertices[i], 3 * sizeof(float));
+
+            if (normalOffset)
+            {
+                const uint32_t n = pack_snorm_2_10_10_10(geometry.normals[i]);
+                memcpy(vertex + normalOffset, &n, sizeof(n));
+            }
+
+            if (colorOffset)
+            {
+                const float4 & c = geometry.colors[i];
+                uint8_t rgba[4];
+                for (int ch = 0; ch < 3; ++ch) rgba[ch] = static_cast<uint8_t>(std::max(0.f, std::min(1.f, c[ch])) * 255.f + 0.5f);
+                rgba[3] = 255;
+                memcpy(vertex + colorOffset, rgba, sizeof(rgba));
+            }
+
+            if (texOffset)
+            {
+                const uint16_t uv[2] = { float_to_half_bits(geometry.texcoord0[i].x), float_to_half_bits(geometry.texcoord0[i].y) };
+                memcpy(vertex + texOffset, uv, sizeof(uv));
+            }
+
+            if (tanOffset)
+            {
+                const uint32_t t = pack_snorm_2_10_10_10(geometry.tangents[i]);
+                memcpy(vertex + tanOffset, &t, sizeof(t));
+            }
+
+            if (bitanOffset)
+            {
+                const uint32_t b = pack_snorm_2_10_10_10(geometry.bitangents[i]);
+                memcpy(vertex + bitanOffset, &b, sizeof(b));
+            }
+        }
+
+        m.set_vertex_data(buffer.size(), buffer.data(), usage);
+        m.set_attribute(0, 3, GL_FLOAT, GL_FALSE, stride, ((uint8_t *)0));
+        if (normalOffset) m.set_attribute(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, ((uint8_t *)0) + normalOffset);
+        if (colorOffset) m.set_attribute(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, ((uint8_t *)0) + colorOffset);
+        if (texOffset) m.set_attribute(3, 2, GL_HALF_FLOAT, GL_FALSE, stride, ((uint8_t *)0) + texOffset);
+        if (tanOffset) m.set_attribute(4, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, ((uint8_t *)0) + tanOffset);
+        if (bitanOffset) m.set_attribute(5, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, ((uint8_t *)0) + bitanOffset);
+
+        if (geometry.faces.size() > 0)
+        {
+            if (geometry.vertices.size() <= 0xffff)
+            {
+                std::vector<uint16_t> indices;
+                indices.reserve(geometry.faces.size() * 3);
+                for (const uint3 & face : geometry.faces)
+                {
+                    indices.push_back(static_cast<uint16_t>(face.x));
+                    indices.push_back(static_cast<uint16_t>(face.y));
+                    indices.push_back(static_cast<uint16_t>(face.z));
+                }
+                m.set_indices(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), indices.data(), usage);
+            }
+            else
+            {
+                m.set_elements(geometry.faces, usage);
+            }
+        }
+
+        // Position-only stream for depth/shadow passes
+        m.set_position_data(geometry.vertices.size() * sizeof(float3), geometry.vertices.data(), usage);
+
         return m;
     }
 
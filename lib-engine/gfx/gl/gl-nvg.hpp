@@ -7,6 +7,8 @@
 #include <vector>
 #include <string>
 #include <stdlib.h>
+#include <type_traits>
+#include <unordered_map>
 
 #include "gl-api.hpp"
 
@@ -18,6 +20,25 @@ namespace polymer
     NVGcontext * make_nanovg_context(int flags);
     void release_nanovg_context(NVGcontext * context);
 
+    // FNV-1a accumulator for building surface content hashes out of whatever state
+    // drives an overlay (label strings, values, colors). Used with pre_draw_cached
+    // below so a surface only re-tessellates when its content actually changed.
+    struct nvg_content_hash
+    {
+        uint64_t value{ 14695981039346656037ull };
+
+        void mix(const void * bytes, const size_t count)
+        {
+            const uint8_t * p = static_cast<const uint8_t *>(bytes);
+            for (size_t i = 0; i < count; ++i) { value ^= p[i]; value *= 1099511628211ull; }
+        }
+
+        template <typename T, typename std::enable_if<std::is_trivially_copyable<T>::value, int>::type = 0>
+        nvg_content_hash & add(const T & v) { mix(&v, sizeof(T)); return *this; }
+
+        nvg_content_hash & add(const std::string & s) { mix(s.data(), s.size()); return *this; }
+    };
+
     class nvg_font
     {
         std::vector<uint8_t> buffer;
@@ -45,6 +66,11 @@ namespace polymer
         std::vector<gl_framebuffer> framebuffer;
         std::vector<gl_texture_2d> texture;
 
+        // Retained-mode cache state: the content hash each surface was last rendered
+        // with, and shaped label widths so repeated text skips a full measure pass
+        std::vector<uint64_t> surface_content_hash;
+        std::unordered_map<uint64_t, float> label_width_cache;
+
     public:
 
         struct font_data
@@ -87,6 +113,8 @@ namespace polymer
                 glNamedFramebufferTexture2DEXT(framebuffer[i], GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture[i], 0);
                 framebuffer[i].check_complete();
             }
+
+            surface_content_hash.resize(num_surfaces, 0); // zero == never rendered
         }
 
         ~gl_nvg_surface() { release_nanovg_context(nvg); }
@@ -100,6 +128,21 @@ namespace polymer
             return nvg;
         }
 
+        // Retained-mode entry point: returns a context to draw into only when
+        // `content_hash` differs from what the surface already holds, otherwise
+        // nullptr - the framebuffer texture from the previous render is reused
+        // untouched, skipping tessellation and rasterization entirely. Build the
+        // hash from everything that drives the overlay with nvg_content_hash.
+        NVGcontext * pre_draw_cached(GLFWwindow * window, const uint32_t surface_idx, const uint64_t content_hash)
+        {
+            if (surface_content_hash[surface_idx] == content_hash) return nullptr;
+            surface_content_hash[surface_idx] = content_hash;
+            return pre_draw(window, surface_idx);
+        }
+
+        // Forces the next pre_draw_cached to re-render (e.g. after a gl context loss)
+        void invalidate(const uint32_t surface_idx) { surface_content_hash[surface_idx] = 0; }
+
         void post_draw()
         {
             nvgEndFrame(nvg);
@@ -118,9 +161,22 @@ namespace polymer
         {
             nvgFontFaceId(nvg, text_fontface->id);
             nvgFontSize(nvg, text_size);
-            float bounds[4];
-            const float w = nvgTextBounds(nvg, 0, 0, txt.c_str(), NULL, bounds); // xmin, ymin, xmax, ymax
-            const float width = (bounds[2] - bounds[0]) / 2.f;
+
+            // Labels are usually drawn with the same content for many frames; cache the
+            // shaped half-width so steady-state text costs one shaping pass, not two
+            nvg_content_hash key;
+            key.add(txt).add(text_size);
+
+            float width = 0.f;
+            auto cached = label_width_cache.find(key.value);
+            if (cached != label_width_cache.end()) width = cached->second;
+            else
+            {
+                float bounds[4];
+                nvgTextBounds(nvg, 0, 0, txt.c_str(), NULL, bounds); // xmin, ymin, xmax, ymax
+                width = (bounds[2] - bounds[0]) / 2.f;
+                label_width_cache[key.value] = width;
+            }
 
             const float textX = position.x - width, textY = position.y + 8;
             nvgTextAlign(nvg, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
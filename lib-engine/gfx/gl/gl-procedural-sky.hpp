@@ -12,6 +12,10 @@
 #include "../../serialization.hpp"
 
 #include <functional>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <cstring>
 
 #if defined(POLYMER_PLATFORM_WINDOWS)
 #pragma warning(push)
@@ -164,6 +168,104 @@ namespace detail
         return { A, B, C, D, E, Z };
     }
 
+    // Precomputed Hosek-Wilkie coefficient table over (sun elevation, turbidity), cached to
+    // disk. The analytic solve walks ~180 spline evaluations per recompute, which adds up
+    // when the sun animates every frame, while the coefficients vary smoothly enough that
+    // bilinear interpolation over a 64x10 table is visually identical. One table per albedo
+    // value (~75 kb); normalizedSunY scaling is applied after interpolation so it does not
+    // key the table.
+    struct hosek_sky_lut
+    {
+        static const int TURBIDITY_STEPS = 10; // dataset covers turbidity 1..10
+        static const int ELEVATION_STEPS = 64;
+
+        std::vector<HosekSkyRadianceData> table;
+        float tableAlbedo = -1.f;
+
+        static std::string cache_file(const float albedo)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &albedo, sizeof(bits));
+            std::ostringstream s;
+            s << "cache/sky/hosek-v1-" << std::hex << bits << ".lut";
+            return s.str();
+        }
+
+        void ensure(const float albedo)
+        {
+            if (!table.empty() && tableAlbedo == albedo) return;
+
+            const size_t tableBytes = ELEVATION_STEPS * TURBIDITY_STEPS * sizeof(HosekSkyRadianceData);
+            table.assign(ELEVATION_STEPS * TURBIDITY_STEPS, {});
+            tableAlbedo = albedo;
+
+            const std::string path = cache_file(albedo);
+
+            std::ifstream cached(path, std::ios::binary);
+            if (cached.good())
+            {
+                cached.read(reinterpret_cast<char *>(table.data()), tableBytes);
+                if (static_cast<size_t>(cached.gcount()) == tableBytes) return;
+            }
+
+            for (int e = 0; e < ELEVATION_STEPS; ++e)
+            {
+                const float sunTheta = (static_cast<float>(e) / (ELEVATION_STEPS - 1)) * (POLYMER_PI / 2.f);
+                const float3 sunDir = { 0.f, std::cos(sunTheta), std::sin(sunTheta) };
+                for (int t = 0; t < TURBIDITY_STEPS; ++t)
+                {
+                    table[e * TURBIDITY_STEPS + t] = HosekSkyRadianceData::compute(sunDir, static_cast<float>(t + 1), albedo, 0.f);
+                }
+            }
+
+            std::error_code ec;
+            std::experimental::filesystem::create_directories("cache/sky", ec); // best effort; the table still works uncached
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (out.good()) out.write(reinterpret_cast<const char *>(table.data()), tableBytes);
+        }
+
+        HosekSkyRadianceData sample(const float3 & sun_direction, float turbidity, float albedo, float normalizedSunY)
+        {
+            ensure(albedo);
+
+            const float sunTheta = std::acos(polymer::clamp(sun_direction.y, 0.f, 1.f));
+
+            const float eF = (sunTheta / (POLYMER_PI / 2.f)) * (ELEVATION_STEPS - 1);
+            const int e0 = polymer::clamp(static_cast<int>(eF), 0, ELEVATION_STEPS - 1);
+            const int e1 = std::min(e0 + 1, ELEVATION_STEPS - 1);
+            const float eK = polymer::clamp(eF - e0, 0.f, 1.f);
+
+            const float tF = polymer::clamp(turbidity, 1.f, 10.f) - 1.f;
+            const int t0 = polymer::clamp(static_cast<int>(tF), 0, TURBIDITY_STEPS - 1);
+            const int t1 = std::min(t0 + 1, TURBIDITY_STEPS - 1);
+            const float tK = polymer::clamp(tF - t0, 0.f, 1.f);
+
+            auto lerp_entry = [](const HosekSkyRadianceData & a, const HosekSkyRadianceData & b, const float k)
+            {
+                HosekSkyRadianceData r;
+                r.A = linalg::lerp(a.A, b.A, k); r.B = linalg::lerp(a.B, b.B, k); r.C = linalg::lerp(a.C, b.C, k);
+                r.D = linalg::lerp(a.D, b.D, k); r.E = linalg::lerp(a.E, b.E, k); r.F = linalg::lerp(a.F, b.F, k);
+                r.G = linalg::lerp(a.G, b.G, k); r.H = linalg::lerp(a.H, b.H, k); r.I = linalg::lerp(a.I, b.I, k);
+                r.Z = linalg::lerp(a.Z, b.Z, k);
+                return r;
+            };
+
+            HosekSkyRadianceData d = lerp_entry(
+                lerp_entry(table[e0 * TURBIDITY_STEPS + t0], table[e0 * TURBIDITY_STEPS + t1], tK),
+                lerp_entry(table[e1 * TURBIDITY_STEPS + t0], table[e1 * TURBIDITY_STEPS + t1], tK), eK);
+
+            // Same normalization the direct solve applies (see HosekSkyRadianceData::compute)
+            if (normalizedSunY)
+            {
+                const float3 S = hosek_wilkie(std::cos(sunTheta), 0.f, 1.f, d.A, d.B, d.C, d.D, d.E, d.F, d.G, d.H, d.I) * d.Z;
+                d.Z /= dot(S, float3(0.2126, 0.7152, 0.0722));
+                d.Z *= normalizedSunY;
+            }
+
+            return d;
+        }
+    };
+
 } // end namespace detail
 
 namespace polymer
@@ -239,6 +341,7 @@ namespace polymer
         shader_handle sky { "sky-hosek" };
 
         ::detail::HosekSkyRadianceData data;
+        ::detail::hosek_sky_lut lut;
     
         virtual void render_internal(const float4x4 & viewProjection, const float3 & sunDir, const float4x4 & modelToWorld) override
         {
@@ -268,7 +371,9 @@ namespace polymer
     
         virtual void recompute(float turbidity, float albedo, float normalizedSunY) override
         {
-            data = ::detail::HosekSkyRadianceData::compute(get_sun_direction(), turbidity, albedo, normalizedSunY);
+            // Interpolated out of the precomputed table so a continuously animated sun costs
+            // a lookup per frame; the direct solve remains what builds the table.
+            data = lut.sample(get_sun_direction(), turbidity, albedo, normalizedSunY);
             if (onParametersChanged) onParametersChanged();
         }
     };
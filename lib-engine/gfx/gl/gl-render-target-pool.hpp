@@ -0,0 +1,147 @@
+#pragma once
+
+#ifndef polymer_render_target_pool_hpp
+#define polymer_render_target_pool_hpp
+
+#include "gl-api.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace polymer
+{
+
+    ///////////////////////////////
+    //   gl_render_target_pool   //
+    ///////////////////////////////
+
+    // Hands out transient render-target attachments by (size, format) so offscreen
+    // passes and previews share allocations instead of each owning dedicated
+    // textures. Acquisitions are frame-scoped: next_frame() returns everything to
+    // the pool for aliasing (a target acquired in pass A can back pass B next
+    // frame - or the same frame after an explicit release), and entries that go
+    // unmatched for a while are freed, so reconfiguring sizes or counts drains the
+    // old allocations instead of doubling them. A pool is bound to the GL context
+    // that created its targets; own one per context, not one globally.
+    class gl_render_target_pool
+    {
+        static const uint64_t evict_after_frames = 120;
+
+        struct pooled_texture
+        {
+            gl_texture_2d texture;
+            uint32_t width{ 0 }, height{ 0 };
+            GLenum internal_format{ 0 };
+            bool in_use{ false };
+            uint64_t last_used_frame{ 0 };
+        };
+
+        struct pooled_renderbuffer
+        {
+            gl_renderbuffer renderbuffer;
+            uint32_t width{ 0 }, height{ 0 };
+            GLenum internal_format{ 0 };
+            uint32_t samples{ 0 };
+            bool in_use{ false };
+            uint64_t last_used_frame{ 0 };
+        };
+
+        std::vector<std::unique_ptr<pooled_texture>> textures;
+        std::vector<std::unique_ptr<pooled_renderbuffer>> renderbuffers;
+        uint64_t frame_index{ 0 };
+
+        gl_render_target_pool(const gl_render_target_pool &) = delete;
+        gl_render_target_pool & operator = (const gl_render_target_pool &) = delete;
+
+    public:
+
+        gl_render_target_pool() = default;
+
+        // Frame boundary: everything acquired last frame becomes eligible for aliasing
+        // again, and entries that haven't matched a request recently are freed.
+        void next_frame()
+        {
+            frame_index++;
+
+            for (auto & t : textures) t->in_use = false;
+            for (auto & r : renderbuffers) r->in_use = false;
+
+            textures.erase(std::remove_if(textures.begin(), textures.end(),
+                [this](const std::unique_ptr<pooled_texture> & t) { return (frame_index - t->last_used_frame) > evict_after_frames; }), textures.end());
+            renderbuffers.erase(std::remove_if(renderbuffers.begin(), renderbuffers.end(),
+                [this](const std::unique_ptr<pooled_renderbuffer> & r) { return (frame_index - r->last_used_frame) > evict_after_frames; }), renderbuffers.end());
+        }
+
+        // Returns a texture matching (width, height, internal_format) exactly,
+        // reusing a free pooled one when available. Contents are undefined; the
+        // caller is expected to clear or fully overwrite it.
+        gl_texture_2d & acquire_texture(const uint32_t width, const uint32_t height, const GLenum internal_format, const GLenum format, const GLenum type)
+        {
+            for (auto & t : textures)
+            {
+                if (!t->in_use && t->width == width && t->height == height && t->internal_format == internal_format)
+                {
+                    t->in_use = true;
+                    t->last_used_frame = frame_index;
+                    return t->texture;
+                }
+            }
+
+            std::unique_ptr<pooled_texture> t(new pooled_texture());
+            t->width = width;
+            t->height = height;
+            t->internal_format = internal_format;
+            t->in_use = true;
+            t->last_used_frame = frame_index;
+            t->texture.memory.set_category(gl_memory_category::render_targets);
+            t->texture.setup(width, height, internal_format, format, type, nullptr, false);
+            glTextureParameteriEXT(t->texture, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(t->texture, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(t->texture, GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+            textures.push_back(std::move(t));
+            return textures.back()->texture;
+        }
+
+        // Multisampled variant for MSAA color/depth attachments (samples == 0 means
+        // single-sampled storage).
+        gl_renderbuffer & acquire_renderbuffer(const uint32_t width, const uint32_t height, const GLenum internal_format, const uint32_t samples = 0)
+        {
+            for (auto & r : renderbuffers)
+            {
+                if (!r->in_use && r->width == width && r->height == height && r->internal_format == internal_format && r->samples == samples)
+                {
+                    r->in_use = true;
+                    r->last_used_frame = frame_index;
+                    return r->renderbuffer;
+                }
+            }
+
+            std::unique_ptr<pooled_renderbuffer> r(new pooled_renderbuffer());
+            r->width = width;
+            r->height = height;
+            r->internal_format = internal_format;
+            r->samples = samples;
+            r->in_use = true;
+            r->last_used_frame = frame_index;
+            glNamedRenderbufferStorageMultisampleEXT(r->renderbuffer, samples, internal_format, width, height);
+
+            renderbuffers.push_back(std::move(r));
+            return renderbuffers.back()->renderbuffer;
+        }
+
+        // Optional early release for intra-frame aliasing: a target a pass has
+        // finished reading can back a later pass within the same frame.
+        void release(const GLuint id)
+        {
+            for (auto & t : textures) if (t->texture == id) { t->in_use = false; return; }
+            for (auto & r : renderbuffers) if (r->renderbuffer == id) { r->in_use = false; return; }
+        }
+
+        size_t live_target_count() const { return textures.size() + renderbuffers.size(); }
+    };
+
+} // end namespace polymer
+
+#endif // polymer_render_target_pool_hpp
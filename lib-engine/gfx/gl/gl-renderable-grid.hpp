@@ -17,6 +17,20 @@ constexpr const char gl_grid_frag[] = R"(#version 330
     void main() { f_color = u_color; }
 )";
 
+constexpr const char gl_overlay_vert[] = R"(#version 330
+    layout(location = 0) in vec3 vertex;
+    layout(location = 1) in vec4 color;
+    uniform mat4 u_mvp;
+    out vec4 v_color;
+    void main() { v_color = color; gl_Position = u_mvp * vec4(vertex.xyz, 1); }
+)";
+
+constexpr const char gl_overlay_frag[] = R"(#version 330
+    in vec4 v_color;
+    out vec4 f_color;
+    void main() { f_color = v_color; }
+)";
+
 namespace polymer
 {
 
@@ -68,8 +82,98 @@ namespace polymer
             gridShader.unbind();
         }
 
-    }; 
-    
+    };
+
+    ///////////////////////////
+    //   gl_static_overlay   //
+    ///////////////////////////
+
+    // Retained batch for camera-independent editor/world overlays (grid, world axes,
+    // bounds boxes). Geometry is accumulated once with a per-vertex color, uploaded
+    // lazily on first draw (or after a rebuild), and the whole batch submits as a
+    // single line-list draw with one shader bind - instead of each overlay paying
+    // its own state setup per frame.
+    class gl_static_overlay
+    {
+        struct overlay_vertex { float3 position; float4 color; };
+
+        gl_shader overlayShader;
+        gl_mesh overlayMesh;
+        std::vector<overlay_vertex> vertices;
+        bool dirty{ false };
+
+    public:
+
+        gl_static_overlay()
+        {
+            overlayShader = gl_shader(gl_overlay_vert, gl_overlay_frag);
+        }
+
+        void clear()
+        {
+            vertices.clear();
+            dirty = true;
+        }
+
+        void add_line(const float3 & a, const float3 & b, const float4 & color)
+        {
+            vertices.push_back({ a, color });
+            vertices.push_back({ b, color });
+            dirty = true;
+        }
+
+        // Same layout as gl_renderable_grid, but accumulated into the shared batch
+        void add_grid(const float density, const uint32_t qx, const uint32_t qy, const float4 & color)
+        {
+            const float width = density * qx / 2;
+            const float height = density * qy / 2;
+            for (uint32_t i = 0; i <= qy; ++i) add_line({ -width, 0.0f, -height + i * density }, { width, 0.0f, -height + i * density }, color);
+            for (uint32_t i = 0; i <= qx; ++i) add_line({ -width + i * density, 0.0f, -height }, { -width + i * density, 0.0f, height }, color);
+        }
+
+        void add_axes(const float length = 1.f)
+        {
+            add_line({ 0, 0, 0 }, { length, 0, 0 }, { 1, 0, 0, 1 });
+            add_line({ 0, 0, 0 }, { 0, length, 0 }, { 0, 1, 0, 1 });
+            add_line({ 0, 0, 0 }, { 0, 0, length }, { 0, 0, 1, 1 });
+        }
+
+        void add_box(const aabb_3d & box, const float4 & color)
+        {
+            const float3 mn = box.min(), mx = box.max();
+            const float3 corners[8] = {
+                { mn.x, mn.y, mn.z }, { mx.x, mn.y, mn.z }, { mx.x, mx.y, mn.z }, { mn.x, mx.y, mn.z },
+                { mn.x, mn.y, mx.z }, { mx.x, mn.y, mx.z }, { mx.x, mx.y, mx.z }, { mn.x, mx.y, mx.z }
+            };
+            const uint2 edges[12] = {
+                { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+                { 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },
+                { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+            };
+            for (const uint2 & e : edges) add_line(corners[e.x], corners[e.y], color);
+        }
+
+        void draw(const float4x4 & viewProjectionMatrix, const float4x4 & modelMatrix = Identity4x4)
+        {
+            if (vertices.empty()) return;
+
+            if (dirty)
+            {
+                overlayMesh.set_vertices(vertices.size(), vertices.data(), GL_STATIC_DRAW);
+                overlayMesh.set_attribute(0, &overlay_vertex::position);
+                overlayMesh.set_attribute(1, &overlay_vertex::color);
+                overlayMesh.set_non_indexed(GL_LINES);
+                dirty = false;
+            }
+
+            overlayShader.bind();
+            overlayShader.uniform("u_mvp", (viewProjectionMatrix * modelMatrix));
+            overlayMesh.draw_elements();
+            overlayShader.unbind();
+        }
+
+    };
+
 } // end namespace polymer
 
 #endif // renderable_grid_h
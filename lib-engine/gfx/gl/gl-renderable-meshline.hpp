@@ -153,7 +153,197 @@ public:
     }
 
 };
-    
+
+///////////////////////////
+//   gl_meshline_batch   //
+///////////////////////////
+
+static const char * meshline_batch_vert = R"(#version 430
+    struct line_record
+    {
+        uint firstPoint;
+        uint pointCount;
+        vec2 padding;
+        vec4 color;
+    };
+
+    layout(std430, binding = 0) readonly buffer PointBuffer { vec4 points[]; }; // xyz position, w per-point width scale
+    layout(std430, binding = 1) readonly buffer LineBuffer { line_record lines[]; };
+
+    uniform mat4 u_projMat;
+    uniform mat4 u_modelViewMat;
+    uniform vec2 resolution;
+    uniform float lineWidth;
+
+    out vec4 v_color;
+
+    void main()
+    {
+        line_record li = lines[gl_InstanceID];
+
+        // Six vertices per segment, expanded from the raw polyline in-shader
+        uint seg = uint(gl_VertexID) / 6u;
+        uint corner = uint(gl_VertexID) % 6u;
+
+        // Instances are sized for the longest line; shorter ones emit degenerates
+        if (li.pointCount < 2u || seg >= li.pointCount - 1u)
+        {
+            gl_Position = vec4(0.0);
+            v_color = vec4(0.0);
+            return;
+        }
+
+        uint offs = (corner == 2u || corner == 3u || corner == 5u) ? 1u : 0u;
+        float side = (corner == 1u || corner == 4u || corner == 5u) ? -1.0 : 1.0;
+
+        uint i = li.firstPoint + seg + offs;
+        uint first = li.firstPoint;
+        uint last = li.firstPoint + li.pointCount - 1u;
+
+        vec4 p = points[i];
+        vec4 prev = points[max(int(i) - 1, int(first))];
+        vec4 next = points[min(i + 1u, last)];
+
+        vec4 currentClip = u_projMat * u_modelViewMat * vec4(p.xyz, 1.0);
+        vec4 prevClip = u_projMat * u_modelViewMat * vec4(prev.xyz, 1.0);
+        vec4 nextClip = u_projMat * u_modelViewMat * vec4(next.xyz, 1.0);
+
+        float aspect = resolution.x / resolution.y;
+        vec2 aspectCorrect = vec2(aspect, 1.0);
+
+        vec2 cs = currentClip.xy / currentClip.w * aspectCorrect;
+        vec2 ps = prevClip.xy / prevClip.w * aspectCorrect;
+        vec2 ns = nextClip.xy / nextClip.w * aspectCorrect;
+
+        // Average the directions into and out of the point for a cheap miter
+        vec2 dir = (cs - ps) + (ns - cs);
+        if (dot(dir, dir) < 1e-12) dir = vec2(1.0, 0.0);
+        dir = normalize(dir);
+
+        vec2 normal = vec2(-dir.y, dir.x);
+        normal.x /= aspect;
+        normal *= 0.5 * lineWidth * p.w / resolution.y;
+
+        v_color = li.color;
+        gl_Position = currentClip + vec4(normal * side * currentClip.w, 0.0, 0.0);
+    }
+)";
+
+static const char * meshline_batch_frag = R"(#version 430
+    in vec4 v_color;
+    out vec4 f_color;
+    void main() { f_color = v_color; }
+)";
+
+// Instanced batch path for rendering many polylines (e.g. motion trails) at once.
+// Raw points for every line live in a single storage buffer - vec4 of position plus
+// a per-point width scale - and quad expansion happens in the vertex shader, so a
+// point change costs one small sub-buffer write instead of a cpu re-expansion and
+// re-upload, and every line in the batch renders with one instanced draw (one
+// instance per line; instances are sized for the longest line and shorter lines
+// emit degenerate triangles for their tail segments).
+class gl_meshline_batch
+{
+    struct line_record // mirrors the std430 layout in the shader
+    {
+        uint32_t firstPoint{ 0 };
+        uint32_t pointCount{ 0 };
+        float padding[2] = { 0.f, 0.f };
+        float4 color{ 1, 1, 1, 1 };
+    };
+
+    gl_shader shader;
+    gl_buffer pointBuffer;
+    gl_buffer lineBuffer;
+    gl_vertex_array_object vao; // attribless draws still require a bound vertex array
+
+    std::vector<float4> points;
+    std::vector<line_record> lines;
+    uint32_t maxSegments{ 0 };
+    bool buffersDirty{ true };
+
+public:
+
+    gl_meshline_batch()
+    {
+        shader = gl_shader(meshline_batch_vert, meshline_batch_frag);
+    }
+
+    size_t line_count() const { return lines.size(); }
+
+    // Appends a polyline and returns its index. `width` is a per-line scale on top
+    // of the draw call's pixel lineWidth.
+    uint32_t add_line(const std::vector<float3> & vertices, const float4 & color, const float width = 1.f)
+    {
+        line_record record;
+        record.firstPoint = static_cast<uint32_t>(points.size());
+        record.pointCount = static_cast<uint32_t>(vertices.size());
+        record.color = color;
+        for (const float3 & v : vertices) points.push_back(float4(v, width));
+        lines.push_back(record);
+        if (record.pointCount > 1) maxSegments = std::max(maxSegments, record.pointCount - 1);
+        buffersDirty = true;
+        return static_cast<uint32_t>(lines.size() - 1);
+    }
+
+    // Moves the points of an existing line (same point count). This is the hot path
+    // for trails: a single glNamedBufferSubData over just this line's range.
+    void update_line(const uint32_t line, const std::vector<float3> & vertices)
+    {
+        line_record & record = lines[line];
+        assert(vertices.size() == record.pointCount);
+
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const float width = points[record.firstPoint + i].w;
+            points[record.firstPoint + i] = float4(vertices[i], width);
+        }
+
+        if (!buffersDirty)
+        {
+            pointBuffer.set_buffer_sub_data(record.pointCount * sizeof(float4), record.firstPoint * sizeof(float4), points.data() + record.firstPoint);
+        }
+    }
+
+    void clear()
+    {
+        points.clear();
+        lines.clear();
+        maxSegments = 0;
+        buffersDirty = true;
+    }
+
+    void draw(const perspective_camera & camera, const float4x4 & model, const float2 screenDims, const float lineWidth = 24.f)
+    {
+        if (lines.empty() || maxSegments == 0) return;
+
+        if (buffersDirty)
+        {
+            pointBuffer.set_buffer_data(points.size() * sizeof(float4), points.data(), GL_DYNAMIC_DRAW);
+            lineBuffer.set_buffer_data(lines.size() * sizeof(line_record), lines.data(), GL_DYNAMIC_DRAW);
+            buffersDirty = false;
+        }
+
+        shader.bind();
+        shader.uniform("u_projMat", camera.get_projection_matrix(screenDims.x / screenDims.y));
+        shader.uniform("u_modelViewMat", (camera.get_view_matrix() * model));
+        shader.uniform("resolution", screenDims);
+        shader.uniform("lineWidth", lineWidth);
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, pointBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, lineBuffer);
+
+        glBindVertexArray(vao);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, maxSegments * 6, static_cast<GLsizei>(lines.size()));
+        glBindVertexArray(0);
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+
+        shader.unbind();
+    }
+};
+
 }
 
 #endif // GlRenderableMeshline
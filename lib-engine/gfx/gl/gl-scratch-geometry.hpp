@@ -0,0 +1,173 @@
+#pragma once
+
+#ifndef polymer_gl_scratch_geometry_hpp
+#define polymer_gl_scratch_geometry_hpp
+
+#include "gl-api.hpp"
+
+namespace polymer
+{
+    /////////////////////////////
+    //   gl_scratch_geometry   //
+    /////////////////////////////
+
+    // Frame-scoped geometry for immediate-mode callers (gizmo handles, pointer
+    // arcs, debug overlays) that would otherwise rebuild a gl_mesh every update
+    // and pay buffer creation + upload + destruction each time. Vertices and
+    // indices bump-allocate out of persistently-mapped, triple-buffered rings
+    // (the gl_mapped_ring_buffer scheme applied to geometry): alloc() memcpys
+    // into the current section and returns a range, draw() submits that range
+    // with base-vertex offsets against one shared VAO, and begin_frame()
+    // invalidates everything wholesale by rotating sections - there is no
+    // per-range lifetime to manage and no GL object churn at all.
+    //
+    // One instance serves one interleaved vertex format (declared through
+    // set_attribute, as with gl_geometry_heap); ranges are only valid until the
+    // next begin_frame(). Requires GL_ARB_buffer_storage - setup() throws where
+    // persistent mapping is unavailable, matching gl_mapped_ring_buffer.
+
+    class gl_scratch_geometry
+    {
+    public:
+
+        struct range
+        {
+            GLuint firstVertex{ 0 };
+            GLuint vertexCount{ 0 };
+            GLuint firstIndex{ 0 };
+            GLuint indexCount{ 0 }; // zero for non-indexed ranges
+        };
+
+    private:
+
+        static const int NUM_SECTIONS = 3;
+
+        gl_vertex_array_object vao;
+        gl_buffer_object vertexBuffer, indexBuffer;
+        gl_memory_record memory{ gl_memory_category::meshes };
+
+        uint8_t * mappedVertices{ nullptr };
+        uint8_t * mappedIndices{ nullptr };
+
+        GLsizei vertexStride{ 0 };
+        GLuint vertexCapacity{ 0 }, indexCapacity{ 0 }; // per section, in elements
+        GLuint vertexHead{ 0 }, indexHead{ 0 };         // within the current section
+        int sectionIndex{ 0 };
+        GLsync sectionFences[NUM_SECTIONS] = { nullptr, nullptr, nullptr };
+
+        gl_scratch_geometry(const gl_scratch_geometry &) = delete;
+        gl_scratch_geometry & operator = (const gl_scratch_geometry &) = delete;
+
+    public:
+
+        gl_scratch_geometry() = default;
+
+        ~gl_scratch_geometry()
+        {
+            for (int i = 0; i < NUM_SECTIONS; ++i) if (sectionFences[i]) glDeleteSync(sectionFences[i]);
+            if (mappedVertices) glUnmapNamedBufferEXT(vertexBuffer);
+            if (mappedIndices) glUnmapNamedBufferEXT(indexBuffer);
+        }
+
+        // Capacities are per frame (one section), in elements. Three sections are
+        // allocated so the CPU writes a section the GPU finished two frames ago.
+        void setup(const GLuint vertex_capacity, const GLuint index_capacity, const GLsizei vertex_stride)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            vertexStride = vertex_stride;
+            vertexCapacity = vertex_capacity;
+            indexCapacity = index_capacity;
+
+            const GLsizeiptr vertexBytes = static_cast<GLsizeiptr>(vertex_capacity) * vertex_stride * NUM_SECTIONS;
+            const GLsizeiptr indexBytes = static_cast<GLsizeiptr>(index_capacity) * sizeof(uint32_t) * NUM_SECTIONS;
+            memory.record(vertexBytes + indexBytes);
+
+            glNamedBufferStorageEXT(vertexBuffer, vertexBytes, nullptr, flags);
+            glNamedBufferStorageEXT(indexBuffer, indexBytes, nullptr, flags);
+            mappedVertices = reinterpret_cast<uint8_t *>(glMapNamedBufferRangeEXT(vertexBuffer, 0, vertexBytes, flags));
+            mappedIndices = reinterpret_cast<uint8_t *>(glMapNamedBufferRangeEXT(indexBuffer, 0, indexBytes, flags));
+            if (!mappedVertices || !mappedIndices) throw std::runtime_error("glMapNamedBufferRangeEXT failed (persistent mapping unsupported?)");
+        }
+
+        bool ready() const { return mappedVertices != nullptr; }
+
+        // Declares one attribute of the scratch vertex format; byte offsets are
+        // within the interleaved stride, mirroring gl_geometry_heap::set_attribute.
+        void set_attribute(GLuint index, GLint size, GLenum type, GLboolean normalized, const GLvoid * offset)
+        {
+            glEnableVertexArrayAttribEXT(vao, index);
+            glVertexArrayVertexAttribOffsetEXT(vao, vertexBuffer, index, size, type, normalized, vertexStride, (GLintptr)offset);
+        }
+
+        // Rotate to the next section and invalidate every range handed out since the
+        // last rotation, waiting on the section's fence if the GPU is still behind
+        void begin_frame()
+        {
+            sectionIndex = (sectionIndex + 1) % NUM_SECTIONS;
+            if (sectionFences[sectionIndex])
+            {
+                while (true)
+                {
+                    const GLenum wait = glClientWaitSync(sectionFences[sectionIndex], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+                    if (wait == GL_ALREADY_SIGNALED || wait == GL_CONDITION_SATISFIED) break;
+                }
+                glDeleteSync(sectionFences[sectionIndex]);
+                sectionFences[sectionIndex] = nullptr;
+            }
+            vertexHead = 0;
+            indexHead = 0;
+        }
+
+        // Fence the section just written so begin_frame() can guard against overwrite
+        void end_frame()
+        {
+            sectionFences[sectionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        // Copy interleaved vertices (and optionally 32-bit indices) into the current
+        // section. The returned range is valid until the next begin_frame().
+        range alloc(const GLuint vertex_count, const void * vertices, const GLuint index_count = 0, const uint32_t * indices = nullptr)
+        {
+            if (vertexHead + vertex_count > vertexCapacity) throw std::runtime_error("gl_scratch_geometry vertex section overflow");
+            if (indexHead + index_count > indexCapacity) throw std::runtime_error("gl_scratch_geometry index section overflow");
+
+            range r;
+            r.firstVertex = sectionIndex * vertexCapacity + vertexHead;
+            r.vertexCount = vertex_count;
+            r.firstIndex = sectionIndex * indexCapacity + indexHead;
+            r.indexCount = index_count;
+
+            std::memcpy(mappedVertices + static_cast<size_t>(r.firstVertex) * vertexStride, vertices, static_cast<size_t>(vertex_count) * vertexStride);
+            if (index_count) std::memcpy(mappedIndices + static_cast<size_t>(r.firstIndex) * sizeof(uint32_t), indices, static_cast<size_t>(index_count) * sizeof(uint32_t));
+
+            vertexHead += vertex_count;
+            indexHead += index_count;
+            return r;
+        }
+
+        // Submits one range: indexed ranges draw with a base-vertex offset so index
+        // data never needs rebasing, non-indexed ranges draw the vertex span directly
+        void draw(const range & r, const GLenum mode)
+        {
+            const uint64_t vertsSubmitted = r.indexCount ? r.indexCount : r.vertexCount;
+            gl_submission_stats::get().add_draw_call(mode == GL_TRIANGLES ? vertsSubmitted / 3 : 0);
+            gl_command_capture::get().record_draw(mode, static_cast<uint32_t>(vertsSubmitted), 0);
+
+            glBindVertexArray(vao);
+            if (r.indexCount)
+            {
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+                glDrawElementsBaseVertex(mode, r.indexCount, GL_UNSIGNED_INT,
+                    (GLvoid *)(static_cast<uintptr_t>(r.firstIndex) * sizeof(uint32_t)), r.firstVertex);
+            }
+            else
+            {
+                glDrawArrays(mode, r.firstVertex, r.vertexCount);
+            }
+            glBindVertexArray(0);
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_gl_scratch_geometry_hpp
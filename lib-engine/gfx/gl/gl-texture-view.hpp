@@ -155,6 +155,130 @@ namespace polymer
         }
     };
 
+    // Composites every registered debug view in a single instanced draw: one program
+    // bind, one vao, no per-view state changes - so inspecting a dozen targets
+    // (cascade slices, intermediates) doesn't distort the frame being inspected.
+    // Standalone 2d textures bind to successive units and are indexed per-instance;
+    // slices of one texture array (e.g. the stable_cascaded_shadows depth array)
+    // share a single sampler2DArray binding and cost no extra units.
+    class gl_texture_view_composite : public non_copyable
+    {
+        static const int32_t max_texture_views = 12;
+
+        struct view_desc
+        {
+            GLuint texture;
+            float4 rect;        // x, y, w, h in window pixels
+            int32_t slice;      // >= 0 selects a layer of the shared array texture
+        };
+
+        gl_shader program;
+        gl_vertex_array_object vao; // attribless corners from gl_VertexID
+        std::vector<view_desc> views;
+        GLuint arrayTexture{ 0 };
+
+    public:
+
+        gl_texture_view_composite()
+        {
+            constexpr const char composite_vert[] = R"(#version 430
+                uniform vec2 u_resolution;
+                uniform vec4 u_rects[16];
+                out vec2 v_uv;
+                flat out int v_instance;
+                const vec2 corners[4] = vec2[](vec2(0, 0), vec2(1, 0), vec2(0, 1), vec2(1, 1));
+                void main()
+                {
+                    vec2 c = corners[gl_VertexID];
+                    vec4 r = u_rects[gl_InstanceID];
+                    vec2 pixel = r.xy + c * r.zw;
+                    v_uv = vec2(c.x, 1.0 - c.y);
+                    v_instance = gl_InstanceID;
+                    gl_Position = vec4(pixel.x / u_resolution.x * 2.0 - 1.0, 1.0 - pixel.y / u_resolution.y * 2.0, 0.0, 1.0);
+                }
+            )";
+
+            constexpr const char composite_frag[] = R"(#version 430
+                uniform vec4 u_params[16]; // x: sampler index, or -1 for the array; y: array slice
+                uniform sampler2D u_textures[12];
+                uniform sampler2DArray u_texture_array;
+                in vec2 v_uv;
+                flat in int v_instance;
+                out vec4 f_color;
+                void main()
+                {
+                    vec4 p = u_params[v_instance];
+                    if (p.x < 0.0) f_color = vec4(vec3(texture(u_texture_array, vec3(v_uv, p.y)).r), 1.0);
+                    else f_color = vec4(texture(u_textures[int(p.x)], v_uv).rgb, 1.0);
+                }
+            )";
+
+            program = gl_shader(composite_vert, composite_frag);
+        }
+
+        void add_view(const GLuint tex, const aabb_2d & rect)
+        {
+            views.push_back({ tex, float4(rect.min().x, rect.min().y, rect.width(), rect.height()), -1 });
+        }
+
+        void add_array_slice(const GLuint tex_array, const int32_t slice, const aabb_2d & rect)
+        {
+            assert(arrayTexture == 0 || arrayTexture == tex_array); // one array texture per composite draw
+            arrayTexture = tex_array;
+            views.push_back({ tex_array, float4(rect.min().x, rect.min().y, rect.width(), rect.height()), slice });
+        }
+
+        // Lays `num_slices` layers out left-to-right inside `rect` - the cascade strip
+        void add_array_strip(const GLuint tex_array, const int32_t num_slices, const aabb_2d & rect)
+        {
+            const float sliceWidth = rect.width() / num_slices;
+            for (int32_t s = 0; s < num_slices; ++s)
+            {
+                add_array_slice(tex_array, s, { { rect.min().x + s * sliceWidth, rect.min().y }, { rect.min().x + (s + 1) * sliceWidth, rect.max().y } });
+            }
+        }
+
+        // Submits all registered views in one instanced draw and clears the list
+        void draw(const float2 windowSize)
+        {
+            if (views.empty()) return;
+
+            GLboolean wasDepthTestingEnabled = glIsEnabled(GL_DEPTH_TEST);
+            glDisable(GL_DEPTH_TEST);
+
+            program.bind();
+            program.uniform("u_resolution", windowSize);
+
+            int32_t nextUnit = 0;
+            for (size_t i = 0; i < views.size() && i < 16; ++i)
+            {
+                program.uniform("u_rects[" + std::to_string(i) + "]", views[i].rect);
+                if (views[i].slice >= 0)
+                {
+                    program.uniform("u_params[" + std::to_string(i) + "]", float4(-1.f, float(views[i].slice), 0.f, 0.f));
+                }
+                else if (nextUnit < max_texture_views)
+                {
+                    program.texture(("u_textures[" + std::to_string(nextUnit) + "]").c_str(), nextUnit, views[i].texture, GL_TEXTURE_2D);
+                    program.uniform("u_params[" + std::to_string(i) + "]", float4(float(nextUnit), 0.f, 0.f, 0.f));
+                    nextUnit++;
+                }
+            }
+            if (arrayTexture) program.texture("u_texture_array", max_texture_views, arrayTexture, GL_TEXTURE_2D_ARRAY);
+
+            glBindVertexArray(vao);
+            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(std::min(views.size(), size_t(16))));
+            glBindVertexArray(0);
+
+            program.unbind();
+
+            if (wasDepthTestingEnabled) glEnable(GL_DEPTH_TEST);
+
+            views.clear();
+            arrayTexture = 0;
+        }
+    };
+
     struct simple_texture_view
     {
         gl_shader shader;
@@ -82,6 +82,210 @@ gl_context::~gl_context()
     glfwTerminate();
 }
 
+/////////////////////////////////
+//   headless_render_session   //
+/////////////////////////////////
+
+headless_render_session::headless_render_session()
+{
+    // gl_context leaves its hidden window current with GL loaded; just make sure
+    // nothing ever waits on a vertical blank for this context
+    glfwMakeContextCurrent(context.hidden_window);
+    glfwSwapInterval(0);
+    readbacks.reset(new gl_async_readback());
+}
+
+void headless_render_session::submit(const render_job & job)
+{
+    const GLuint texture = job.render();
+    const int2 size = job.size;
+    const std::string path = job.output_path;
+
+    ++pending;
+    uint32_t * remaining = &pending;
+
+    readbacks->readback_texture(texture, GL_TEXTURE_2D, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE,
+        [remaining, path, size](const void * data, const size_t size_bytes)
+    {
+        const uint8_t * pixels = static_cast<const uint8_t *>(data);
+        std::vector<uint8_t> flipped(size_bytes);
+        for (int y = 0; y < size.y; ++y) memcpy(flipped.data() + y * size.x * 4, pixels + (size.y - y - 1) * size.x * 4, size.x * 4);
+        stbi_write_png(path.c_str(), size.x, size.y, 4, flipped.data(), 4 * size.x);
+        --(*remaining);
+    });
+}
+
+void headless_render_session::finish()
+{
+    // The fences only need the GPU to drain; there is no present to wait behind
+    glFlush();
+    while (pending > 0)
+    {
+        readbacks->poll();
+        if (pending > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+/////////////////////
+//   app_session   //
+/////////////////////
+
+namespace
+{
+    constexpr uint32_t kSessionMagic = 0x504c5952;  // 'PLYR'
+    constexpr uint32_t kSessionVersion = 1;
+
+    // app_input_event minus the runtime-only window pointer, laid out for raw binary io
+    struct serialized_input_event
+    {
+        int32_t type, action, mods;
+        int32_t windowSize[2];
+        float cursor[2];
+        int32_t value[2];
+        uint8_t drag;
+    };
+}
+
+bool app_session::start_recording(const std::string & path)
+{
+    if (state != session_mode::idle) return false;
+    frames.clear();
+    pendingEvents.clear();
+    activePath = path;
+    state = session_mode::recording;
+    return true;
+}
+
+bool app_session::start_replay(const std::string & path)
+{
+    if (state != session_mode::idle) return false;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good()) return false;
+
+    uint32_t magic = 0, version = 0;
+    uint64_t frameCount = 0;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    file.read(reinterpret_cast<char *>(&frameCount), sizeof(frameCount));
+    if (!file.good() || magic != kSessionMagic || version != kSessionVersion) return false;
+
+    frames.clear();
+    frames.resize(frameCount);
+    for (auto & f : frames)
+    {
+        uint32_t eventCount = 0;
+        file.read(reinterpret_cast<char *>(&f.timestep_ms), sizeof(f.timestep_ms));
+        file.read(reinterpret_cast<char *>(&f.elapsed_s), sizeof(f.elapsed_s));
+        file.read(reinterpret_cast<char *>(&f.camera), sizeof(transform));
+        file.read(reinterpret_cast<char *>(&eventCount), sizeof(eventCount));
+        if (!file.good()) return false;
+
+        f.events.resize(eventCount);
+        for (auto & e : f.events)
+        {
+            serialized_input_event s;
+            file.read(reinterpret_cast<char *>(&s), sizeof(s));
+            if (!file.good()) return false;
+            e.window = nullptr; // filled in by the dispatching window
+            e.type = static_cast<app_input_event::Type>(s.type);
+            e.action = s.action;
+            e.mods = s.mods;
+            e.windowSize = { s.windowSize[0], s.windowSize[1] };
+            e.cursor = { s.cursor[0], s.cursor[1] };
+            e.value = { s.value[0], s.value[1] };
+            e.drag = !!s.drag;
+        }
+    }
+
+    playhead = 0;
+    state = session_mode::replaying;
+    return true;
+}
+
+void app_session::stop()
+{
+    if (state == session_mode::recording && !activePath.empty())
+    {
+        std::ofstream file(activePath, std::ios::binary | std::ios::trunc);
+        if (file.good())
+        {
+            const uint64_t frameCount = frames.size();
+            file.write(reinterpret_cast<const char *>(&kSessionMagic), sizeof(kSessionMagic));
+            file.write(reinterpret_cast<const char *>(&kSessionVersion), sizeof(kSessionVersion));
+            file.write(reinterpret_cast<const char *>(&frameCount), sizeof(frameCount));
+            for (const auto & f : frames)
+            {
+                const uint32_t eventCount = static_cast<uint32_t>(f.events.size());
+                file.write(reinterpret_cast<const char *>(&f.timestep_ms), sizeof(f.timestep_ms));
+                file.write(reinterpret_cast<const char *>(&f.elapsed_s), sizeof(f.elapsed_s));
+                file.write(reinterpret_cast<const char *>(&f.camera), sizeof(transform));
+                file.write(reinterpret_cast<const char *>(&eventCount), sizeof(eventCount));
+                for (const auto & e : f.events)
+                {
+                    serialized_input_event s;
+                    s.type = static_cast<int32_t>(e.type);
+                    s.action = e.action;
+                    s.mods = e.mods;
+                    s.windowSize[0] = e.windowSize.x; s.windowSize[1] = e.windowSize.y;
+                    s.cursor[0] = e.cursor.x; s.cursor[1] = e.cursor.y;
+                    s.value[0] = e.value.x; s.value[1] = e.value.y;
+                    s.drag = e.drag ? 1 : 0;
+                    file.write(reinterpret_cast<const char *>(&s), sizeof(s));
+                }
+            }
+        }
+    }
+
+    frames.clear();
+    pendingEvents.clear();
+    playhead = 0;
+    activePath.clear();
+    state = session_mode::idle;
+}
+
+void app_session::capture_input(const app_input_event & e)
+{
+    if (state == session_mode::recording) pendingEvents.push_back(e);
+}
+
+bool app_session::advance(app_update_event & e, std::vector<app_input_event> & replayedEvents)
+{
+    if (state == session_mode::recording)
+    {
+        session_frame f;
+        f.timestep_ms = e.timestep_ms;
+        f.elapsed_s = e.elapsed_s;
+        if (trackedCamera) f.camera = *trackedCamera;
+        f.events = std::move(pendingEvents);
+        pendingEvents.clear();
+        frames.push_back(std::move(f));
+    }
+    else if (state == session_mode::replaying)
+    {
+        if (playhead >= frames.size())
+        {
+            stop();
+            return false;
+        }
+        // The recorded clock replaces wall time so simulation-rate-dependent code sees
+        // exactly the sequence it saw during capture, regardless of present render speed
+        e.timestep_ms = frames[playhead].timestep_ms;
+        e.elapsed_s = frames[playhead].elapsed_s;
+        replayedEvents = frames[playhead].events;
+        playhead++;
+    }
+    return true;
+}
+
+void app_session::apply_replay_camera()
+{
+    if (state == session_mode::replaying && trackedCamera && playhead > 0 && playhead <= frames.size())
+    {
+        *trackedCamera = frames[playhead - 1].camera;
+    }
+}
+
 /////////////////////
 //   glfw_window   //
 /////////////////////
@@ -142,6 +346,14 @@ void glfw_window::preprocess_input(app_input_event & event)
         else if (event.is_up()) isDragging = false;
     }
     event.drag = isDragging;
+    inputSinceLastFrame = true;
+    if (session.is_recording()) session.capture_input(event);
+    if (session.is_replaying())
+    {
+        // Live input would corrupt a deterministic replay, so it is suppressed; escape aborts
+        if (event.type == app_input_event::KEY && event.value[0] == GLFW_KEY_ESCAPE && event.is_down()) session.stop();
+        return;
+    }
     on_input(event);
 }
 
@@ -206,14 +418,25 @@ void polymer_app::screenshot_impl()
 {
     int width, height;
     glfwGetWindowSize(window, &width, &height);
-    int2 size(width, height);
-    HumanTime t;
-    auto timestamp = t.make_timestamp();
-    std::vector<uint8_t> screenShot(size.x * size.y * 4);
-    glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, screenShot.data());
-    auto flipped = screenShot;
-    for (int y = 0; y < size.y; ++y) memcpy(flipped.data() + y * size.x * 4, screenShot.data() + (size.y - y - 1)*size.x * 4, size.x * 4);
-    stbi_write_png(std::string(screenshotPath + "-" + timestamp + ".png").c_str(), size.x, size.y, 4, flipped.data(), 4 * size.x);
+    const int2 size(width, height);
+    const std::string path = screenshotPath;
+
+    if (!readbacks) readbacks.reset(new gl_async_readback());
+
+    // Fence-based grab: the copy lands in a pixel-pack buffer and the png is
+    // written one or two frames later when poll() sees the fence signal, so a
+    // capture no longer stalls the pipeline behind glReadPixels.
+    readbacks->readback_pixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE,
+        [path, size](const void * data, const size_t size_bytes)
+    {
+        HumanTime t;
+        const auto timestamp = t.make_timestamp();
+        const uint8_t * pixels = static_cast<const uint8_t *>(data);
+        std::vector<uint8_t> flipped(size_bytes);
+        for (int y = 0; y < size.y; ++y) memcpy(flipped.data() + y * size.x * 4, pixels + (size.y - y - 1) * size.x * 4, size.x * 4);
+        stbi_write_png(std::string(path + "-" + timestamp + ".png").c_str(), size.x, size.y, 4, flipped.data(), 4 * size.x);
+    });
+
     screenshotPath.clear();
 }
 
@@ -225,7 +448,10 @@ void polymer_app::main_loop()
     {
         try
         {
-            glfwPollEvents();
+            // While undamaged, on-demand mode sleeps on the event queue instead of
+            // spinning the render loop for a static scene
+            if (renderOnDemandEnabled && damageFrames == 0 && !session.is_replaying()) glfwWaitEventsTimeout(idleRefreshSeconds);
+            else glfwPollEvents();
 
             auto t1 = std::chrono::high_resolution_clock::now();
             auto timestep = std::chrono::duration<float>(t1 - t0).count();
@@ -247,10 +473,37 @@ void polymer_app::main_loop()
             e.framesPerSecond = static_cast<float>(fps);
             e.elapsedFrames = elapsedFrames;
 
+            // Recording captures this frame; replaying substitutes the recorded clock and
+            // re-dispatches the recorded input events in their original frame
+            std::vector<app_input_event> replayedEvents;
+            if (!session.advance(e, replayedEvents)) continue; // replay just completed
+            for (auto & ev : replayedEvents)
+            {
+                ev.window = window;
+                on_input(ev);
+            }
+
+            if (inputSinceLastFrame) { invalidate(); inputSinceLastFrame = false; }
+
             on_update(e);
-            on_draw();
+            session.apply_replay_camera();
+
+            // on_update() had its chance to report damage; decide whether this
+            // frame actually draws
+            bool drawThisFrame = true;
+            if (renderOnDemandEnabled && !session.is_replaying())
+            {
+                if (screenshotPath.size() > 0) invalidate();
+                const double now = glfwGetTime();
+                if (damageFrames > 0) { --damageFrames; lastRenderTime = now; }
+                else if (now - lastRenderTime >= idleRefreshSeconds) lastRenderTime = now; // keep-alive repaint
+                else drawThisFrame = false;
+            }
+
+            if (drawThisFrame) on_draw();
 
-            if (screenshotPath.size() > 0) screenshot_impl();
+            if (drawThisFrame && screenshotPath.size() > 0) screenshot_impl();
+            if (readbacks) readbacks->poll();
         }
         catch(...)
         {
@@ -10,6 +10,8 @@
 #include <chrono>
 #include <codecvt>
 #include <string>
+#include <memory>
+#include <functional>
 
 #if defined(POLYMER_PLATFORM_WINDOWS)
     #define GL_GLEXT_PROTOTYPES
@@ -21,6 +23,8 @@
 #define GLFW_INCLUDE_GLU
 #include <GLFW/glfw3.h>
 
+class gl_async_readback; // gl-api.hpp
+
 namespace polymer
 {
 
@@ -66,6 +70,104 @@ namespace polymer
         ~gl_context();
     };
 
+    //////////////////////////////////
+    //   headless_render_session    //
+    //////////////////////////////////
+
+    // Offscreen rendering host for farm/CI batch jobs (thumbnails, validation
+    // renders). Only the shared hidden 1x1 context is created - no visible window,
+    // no swapchain, no vsync - so pbr_renderer and friends run in a batch process
+    // without a display server. A job renders into its own framebuffers and hands
+    // back the texture to encode; completed frames are read back asynchronously
+    // (fence + pixel-pack buffer) and written to disk as pngs, keeping several
+    // jobs in flight so the GPU never idles on a synchronous glReadPixels.
+    class headless_render_session
+    {
+    public:
+
+        struct render_job
+        {
+            std::string output_path; // written as png
+            int2 size;               // dimensions of the returned texture
+            std::function<GLuint()> render; // renders the frame, returns the texture to encode
+        };
+
+    private:
+
+        gl_context context; // hidden context only; never presents
+        std::unique_ptr<gl_async_readback> readbacks;
+        uint32_t pending{ 0 };
+
+    public:
+
+        headless_render_session();
+
+        gl_context * get_shared_gl_context() { return &context; }
+
+        // Renders one job and queues its readback (non-blocking)
+        void submit(const render_job & job);
+
+        // Drives poll() until every queued frame has landed on disk
+        void finish();
+
+        // Convenience for a whole batch
+        void run(const std::vector<render_job> & jobs) { for (auto & j : jobs) submit(j); finish(); }
+    };
+
+    /////////////////////
+    //   app_session   //
+    /////////////////////
+
+    // Deterministic record/replay of an application session for performance A/B testing:
+    // per-frame timesteps, every app_input_event, and (optionally) a registered camera
+    // transform are captured to a binary file and played back bit-identically, so two
+    // renderer builds can be compared on exactly the same input sequence. During replay
+    // live input is suppressed and the wall clock is replaced by the recorded timesteps.
+    class app_session
+    {
+    public:
+
+        enum class session_mode : uint32_t { idle, recording, replaying };
+
+    private:
+
+        struct session_frame
+        {
+            float timestep_ms{ 0.f };
+            double elapsed_s{ 0.0 };
+            transform camera;
+            std::vector<app_input_event> events;
+        };
+
+        session_mode state{ session_mode::idle };
+        std::vector<session_frame> frames;
+        std::vector<app_input_event> pendingEvents;
+        size_t playhead{ 0 };
+        transform * trackedCamera{ nullptr };
+        std::string activePath;
+
+    public:
+
+        // The registered transform is captured once per frame while recording and force-set
+        // after on_update() during replay (covers cameras not purely driven by input events)
+        void register_camera(transform * pose) { trackedCamera = pose; }
+
+        session_mode get_mode() const { return state; }
+        bool is_recording() const { return state == session_mode::recording; }
+        bool is_replaying() const { return state == session_mode::replaying; }
+        size_t get_frame_count() const { return frames.size(); }
+        size_t get_playhead() const { return playhead; }
+
+        bool start_recording(const std::string & path); // frames buffer in memory and are written on stop()
+        bool start_replay(const std::string & path);    // loads the whole session up front
+        void stop();                                    // finalizes a recording (writes the file) or aborts a replay
+
+        // Framework hooks, called by glfw_window / polymer_app::main_loop
+        void capture_input(const app_input_event & e);
+        bool advance(app_update_event & e, std::vector<app_input_event> & replayedEvents); // false once a replay is exhausted
+        void apply_replay_camera();
+    };
+
     class glfw_window
     {
         bool isDragging{ false };
@@ -80,9 +182,14 @@ namespace polymer
 
         GLFWwindow * window;
         gl_context * gl_ctx;
+        bool inputSinceLastFrame{ false }; // set by preprocess_input, read by on-demand rendering
 
     public:
 
+        // Record/replay of input + timestep for deterministic benchmarking (see app_session).
+        // Lives on the window so preprocess_input can capture and suppress events.
+        app_session session;
+
         glfw_window(gl_context * context, int w, int h, const std::string title, int samples = 1);
         virtual ~glfw_window();
 
@@ -105,11 +212,19 @@ namespace polymer
         double fpsTime{ 0 };
         bool fullscreenState{ false };
 
+        // Render-on-demand state for mostly-static deployments (see set_render_on_demand)
+        bool renderOnDemandEnabled{ false };
+        uint32_t settleFrames{ 3 };       // frames rendered per invalidation, letting temporal effects converge
+        uint32_t damageFrames{ 1 };       // frames still owed; starts at one so the first frame always draws
+        double idleRefreshSeconds{ 1.0 }; // keep-alive repaint cadence while undamaged
+        double lastRenderTime{ 0.0 };
+
         void screenshot_impl();
         static void enter_fullscreen(GLFWwindow * window, int2 & windowedSize, int2 & windowedPos);
         static void exit_fullscreen(GLFWwindow * window, const int2 & windowedSize, const int2 & windowedPos);
         int2 windowedSize, windowedPos;
         std::string screenshotPath;
+        std::unique_ptr<gl_async_readback> readbacks; // lazily created on the first capture
 
     public:
 
@@ -121,6 +236,18 @@ namespace polymer
         void set_fullscreen(bool state);
         bool get_fullscreen();
         void request_screenshot(const std::string & filename);
+
+        // When enabled, the loop renders only while damage is outstanding - input
+        // invalidates automatically, anything else (animation ticks, material
+        // edits, transform changes) reports through invalidate() - and otherwise
+        // sleeps on the event queue, waking every idleRefreshSeconds for a
+        // keep-alive repaint. on_update() still runs every iteration; replay
+        // sessions always render at full rate.
+        void set_render_on_demand(bool enable) { renderOnDemandEnabled = enable; if (enable) invalidate(); }
+        bool get_render_on_demand() const { return renderOnDemandEnabled; }
+
+        // Schedules settleFrames consecutive renders (call when anything visible changed)
+        void invalidate() { damageFrames = settleFrames; }
     };
         
     extern int Main(int argc, char * argv[]);
@@ -9,6 +9,8 @@
 #include "asset-handle.hpp"
 #include "asset-handle-utils.hpp"
 #include "asset-resolver.hpp"
+#include "asset-loader.hpp"
+#include "texture-streaming.hpp"
 
 #include "shader.hpp"
 #include "material.hpp"
@@ -22,16 +24,24 @@
 #include "ecs/core-ecs.hpp"
 #include "ecs/core-events.hpp"
 #include "ecs/component-pool.hpp"
+#include "ecs/component-archetype.hpp"
 #include "ecs/typeid.hpp"
 
+#include "spatial-index.hpp"
+
 #include "system-identifier.hpp"
 #include "system-transform.hpp"
 #include "system-collision.hpp"
 #include "system-render.hpp"
 
+#include "scene-streaming.hpp"
+#include "frame-scheduler.hpp"
+#include "frame-pipeline.hpp"
+
 #include "renderer-pbr.hpp"
 #include "renderer-debug.hpp"
 #include "renderer-util.hpp"
+#include "renderer-brdf.hpp"
 
 #include "gl-api.hpp"
 #include "gl-async-gpu-timer.hpp"
@@ -45,6 +55,7 @@
 #include "gl-procedural-sky.hpp"
 #include "gl-renderable-grid.hpp"
 #include "gl-renderable-meshline.hpp"
+#include "gl-texture-transcode.hpp"
 #include "gl-texture-view.hpp"
 
 #include "glfw-app.hpp"
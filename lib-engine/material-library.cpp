@@ -2,6 +2,7 @@
 #include "material-library.hpp"
 #include "serialization.hpp"
 #include "asset-handle-utils.hpp"
+#include "gl-loaders.hpp"
 #include "logging.hpp"
 #include "file_io.hpp"
 #include "json.hpp"
@@ -12,6 +13,9 @@ using namespace polymer;
 using json = nlohmann::json;
 
 const std::string material_library::kDefaultMaterialId = "default-material";
+const std::string material_library::kFallbackAlbedoId = "fallback-albedo";
+const std::string material_library::kFallbackNormalId = "fallback-normal";
+const std::string material_library::kFallbackMaskId = "fallback-mask";
 
 void material_library::search()
 {
@@ -30,22 +34,23 @@ void material_library::search()
 
 material_library::material_library(const std::string & search_path) : search_path(search_path)
 {
-    // Create an empty asset for textures. 
+    // Create an empty asset for textures.
     create_handle_for_asset("", gl_texture_2d());
 
+    // Streaming fallbacks, so a material whose textures are still loading samples
+    // something sensible instead of an invalid black texture
+    create_handle_for_asset(kFallbackAlbedoId.c_str(), make_solid_color_texture(128, 128, 128, 255));
+    create_handle_for_asset(kFallbackNormalId.c_str(), make_solid_color_texture(128, 128, 255, 255));
+    create_handle_for_asset(kFallbackMaskId.c_str(), make_solid_color_texture(255, 255, 255, 255));
+
     // Create a default material and create an asset handle for it (also add to local instances)
     std::shared_ptr<polymer_default_material> default = std::make_shared<polymer_default_material>();
     create_handle_for_asset(kDefaultMaterialId.c_str(), static_cast<std::shared_ptr<material_interface>>(default));
     instances[kDefaultMaterialId] = default; 
 
+    // Records serialized documents only - instances are deserialized and
+    // registered with the asset system by instantiate() on first use
     search();
-
-    // Register all material instances with the asset system. Since everything is handle-based,
-    // we can do this wherever, so long as it's before the first rendered frame
-    for (auto & instance : instances)
-    {
-        create_handle_for_asset(instance.first.c_str(), static_cast<std::shared_ptr<material_interface>>(instance.second));
-    }
 }
 
 material_library::~material_library()
@@ -62,14 +67,51 @@ void material_library::export_all()
     {
         export_material(instance.first, search_path);
     }
+
+    // Documents that were never instantiated this session round-trip verbatim
+    for (auto & doc : pending_docs)
+    {
+        if (instances.find(doc.first) == instances.end())
+        {
+            polymer::write_file_text(search_path + doc.first + ".material", doc.second);
+        }
+    }
 }
 
 void material_library::import_material(const std::string & path)
 {
-    const json instance_doc = json::parse(read_file_text(path));
     const std::string name = get_filename_without_extension(path);
     assert(!name.empty());
 
+    // Deferred: the document is parsed by instantiate() the first time the
+    // name is actually referenced
+    pending_docs[name] = read_file_text(path);
+}
+
+std::shared_ptr<material_interface> material_library::instantiate(const std::string & name)
+{
+    const auto existing = instances.find(name);
+    if (existing != instances.end()) return existing->second;
+
+    const auto doc = pending_docs.find(name);
+    if (doc == pending_docs.end()) return {};
+
+    const json instance_doc = json::parse(doc->second);
+
+    // Structurally identical materials share one instance (and therefore one
+    // uniform upload per run at draw time). nlohmann::json keeps keys sorted,
+    // so dump() of the parsed document is a canonical structural key.
+    const std::string structural_key = instance_doc.dump();
+    const auto duplicate = structural_index.find(structural_key);
+    if (duplicate != structural_index.end())
+    {
+        std::shared_ptr<material_interface> shared_instance = instances[duplicate->second];
+        instances[name] = shared_instance;
+        create_handle_for_asset(name.c_str(), static_cast<std::shared_ptr<material_interface>>(shared_instance));
+        log::get()->engine_log->info("material {} deduplicated against {}", name, duplicate->second);
+        return shared_instance;
+    }
+
     for (auto inst = instance_doc.begin(); inst != instance_doc.end(); ++inst)
     {
         if (starts_with(inst.key(), "@"))
@@ -92,6 +134,13 @@ void material_library::import_material(const std::string & path)
         }
         else throw std::runtime_error("type key mismatch!");
     }
+
+    const auto created = instances.find(name);
+    if (created == instances.end()) return {}; // document held no recognized material type
+
+    structural_index[structural_key] = name;
+    create_handle_for_asset(name.c_str(), static_cast<std::shared_ptr<material_interface>>(created->second));
+    return created->second;
 }
 
 void material_library::export_material(const std::string & name, const std::string & path)
@@ -119,6 +168,7 @@ void material_library::remove_material(const std::string & name)
     if (itr != instances.end())
     {
         instances.erase(itr);
+        pending_docs.erase(name);
         material_handle::destroy(name);
         log::get()->engine_log->info("removing {} from the material list", name);
     }
@@ -14,17 +14,32 @@ namespace polymer
     class polymer_pbr_standard;
     class polymer_blinn_phong_standard;
 
-    // Materials are serialized separately from a scene. 
+    // Materials are serialized separately from a scene.
     // All materials also live in the static table of asset_handles, but
     // this is where serialization/deserialization occurs.
+    // Serialized materials found by search() are held as documents and only
+    // deserialized by the first instantiate(...) for their name (typically
+    // triggered by a material_component via the asset_resolver), so a scene
+    // that serializes hundreds of materials only pays for the ones it uses.
+    // Structurally identical documents share a single instance.
     struct material_library
     {
         static const std::string kDefaultMaterialId;
+
+        // Streaming fallback textures, registered by the constructor and served by
+        // material binds (texture_handle::get_or) until the real asset lands:
+        // neutral gray for color maps, +z for normal maps, white for scalar masks
+        static const std::string kFallbackAlbedoId;
+        static const std::string kFallbackNormalId;
+        static const std::string kFallbackMaskId;
         std::map<std::string, std::shared_ptr<material_interface>> instances;
+        std::map<std::string, std::string> pending_docs;     // name to .material document, not yet deserialized
+        std::map<std::string, std::string> structural_index; // canonical document to the name first instantiated from it
         std::string search_path;
         material_library(const std::string & search_path);
         ~material_library();
         template<typename T> void create_material(const std::string & name, std::shared_ptr<T> mat);
+        std::shared_ptr<material_interface> instantiate(const std::string & name);
         void remove_material(const std::string & name);
         void import_material(const std::string & path);
         void export_material(const std::string & name, const std::string & path);
@@ -1,12 +1,39 @@
 #include "material.hpp"
 #include "renderer-pbr.hpp"
+#include "uniforms.hpp"
 #include "asset-handle.hpp"
 #include "asset-handle-utils.hpp"
 #include "shader.hpp"
 #include "shader-library.hpp"
+#include "material-library.hpp"
 
 using namespace polymer;
 
+// Streaming fallbacks sampled while a material's real textures load (registered
+// by the material_library constructor); get_or swaps the real texture in - via a
+// command-list rebake - once the loader assigns it. Function-local statics
+// because the ids live in another translation unit.
+static const texture_handle & fallback_albedo() { static const texture_handle h(material_library::kFallbackAlbedoId); return h; }
+static const texture_handle & fallback_normal() { static const texture_handle h(material_library::kFallbackNormalId); return h; }
+static const texture_handle & fallback_mask() { static const texture_handle h(material_library::kFallbackMaskId); return h; }
+
+// A texture slot participates in variant selection as soon as it names an asset,
+// not once that asset finishes loading - the variant samples the fallback in the
+// meantime, which avoids both an untextured pop and a variant recompile when the
+// loader lands.
+static bool slot_named(const texture_handle & t) { return !t.name.empty() && t.name != "empty"; }
+
+// Promotes a texture to a resident bindless handle (GL_ARB_bindless_texture).
+// Residency persists for the texture's lifetime; a reloaded texture gets a fresh
+// handle when the owning material re-bakes its command lists.
+static GLuint64 make_resident_handle(const GLuint texture)
+{
+    if (!texture) return 0;
+    const GLuint64 handle = glGetTextureHandleARB(texture);
+    if (handle && !glIsTextureHandleResidentARB(handle)) glMakeTextureHandleResidentARB(handle);
+    return handle;
+}
+
 //////////////////////////
 //   Default Material   //
 //////////////////////////
@@ -52,11 +79,20 @@ void polymer_fx_material::use()
 
 void polymer_fx_material::resolve_variants()
 {
-    if (!compiled_shader && shader.assigned())
-    {
-        std::shared_ptr<gl_shader_asset> asset = shader.get();
-        compiled_shader = asset->get_variant();
-    }
+    if (!shader.assigned()) return;
+
+    // FX materials draw in the transparency pass, which flips `oit` around
+    // submission when weighted-blended output is requested; that is the only
+    // flag that changes their variant, so the fast path keys on it alone.
+    const uint32_t flags = (oit ? 1u : 0u);
+    if (compiled_shader && flags == resolved_flags) return;
+
+    std::vector<std::string> processed_defines;
+    if (oit) processed_defines.push_back("USE_WEIGHTED_OIT");
+    resolved_flags = flags;
+
+    std::shared_ptr<gl_shader_asset> asset = shader.get();
+    compiled_shader = asset->get_variant(processed_defines);
 }
 
 uint32_t polymer_fx_material::id()
@@ -103,10 +139,17 @@ uint32_t polymer_wireframe_material::id()
 polymer_blinn_phong_standard::polymer_blinn_phong_standard()
 {
     shader = shader_handle("phong-forward-lighting");
+    instancing_supported = true;
 }
 
 void polymer_blinn_phong_standard::resolve_variants()
 {
+    // Fast path: same submission flags as the last resolve means the cached
+    // variant is still the right one, so skip rebuilding and hashing the define
+    // set. Property and handle edits reset resolved_flags via invalidate_command_lists().
+    const uint32_t flags = (instanced ? 1u : 0u) | (clustered ? 2u : 0u) | (stereo ? 4u : 0u) | (skinned ? 8u : 0u);
+    if (compiled_shader && flags == resolved_flags) return;
+
     std::vector<std::string> processed_defines;
 
     // Required Features
@@ -115,11 +158,24 @@ void polymer_blinn_phong_standard::resolve_variants()
     processed_defines.push_back("USE_PCF_3X3");
     processed_defines.push_back("USE_IMAGE_BASED_LIGHTING");
 
+    // Submission mode (toggled by the renderer when drawing a batched group)
+    if (instanced) processed_defines.push_back("USE_INSTANCING");
+
+    // Light culling mode (set by the renderer when a cluster grid is bound)
+    if (clustered) processed_defines.push_back("USE_CLUSTERED_SHADING");
+
+    // Single-pass stereo (both eyes in one submission via viewport arrays)
+    if (stereo) processed_defines.push_back("USE_STEREO_SINGLE_PASS");
+
+    // GPU palette skinning (toggled by the renderer around skinned submission)
+    if (skinned) processed_defines.push_back("USE_SKINNING");
+
     // Material slots
-    if (diffuse.assigned()) processed_defines.push_back("HAS_DIFFUSE_MAP");
-    if (normal.assigned()) processed_defines.push_back("HAS_NORMAL_MAP");
+    if (slot_named(diffuse)) processed_defines.push_back("HAS_DIFFUSE_MAP");
+    if (slot_named(normal)) processed_defines.push_back("HAS_NORMAL_MAP");
 
     const auto variant_hash = shader.get()->hash(processed_defines);
+    resolved_flags = flags;
 
     // First time
     if (!compiled_shader)
@@ -153,21 +209,30 @@ void polymer_blinn_phong_standard::update_uniforms()
 {
     resolve_variants();
     gl_shader & program = compiled_shader->shader;
-    program.bind();
 
-    program.uniform("u_diffuseColor", diffuseColor);
-    program.uniform("u_specularColor", specularColor);
-    program.uniform("u_specularShininess", specularShininess);
-    program.uniform("u_specularStrength", specularStrength);
+    // Rebake after an edit, a texture reload, or the first use of a new variant
+    material_command_list & cmds = get_command_list(program.handle());
 
-    program.uniform("u_texCoordScale", float2(texcoordScale));
+    if (!cmds.baked)
+    {
+        cmds.record(program, "u_diffuseColor", diffuseColor);
+        cmds.record(program, "u_specularColor", specularColor);
+        cmds.record(program, "u_specularShininess", specularShininess);
+        cmds.record(program, "u_specularStrength", specularStrength);
 
-    bindpoint = 0;
+        cmds.record(program, "u_texCoordScale", float2(texcoordScale));
 
-    if (compiled_shader->enabled("HAS_DIFFUSE_MAP")) program.texture("s_diffuse", bindpoint++, diffuse.get(), GL_TEXTURE_2D);
-    if (compiled_shader->enabled("HAS_NORMAL_MAP")) program.texture("s_normal", bindpoint++, normal.get(), GL_TEXTURE_2D);
+        bindpoint = 0;
 
-    program.unbind();
+        if (compiled_shader->enabled("HAS_DIFFUSE_MAP")) cmds.record(program, "s_diffuse", bindpoint++, diffuse.get_or(fallback_albedo()), GL_TEXTURE_2D);
+        if (compiled_shader->enabled("HAS_NORMAL_MAP")) cmds.record(program, "s_normal", bindpoint++, normal.get_or(fallback_normal()), GL_TEXTURE_2D);
+
+        cmds.next_bindpoint = bindpoint;
+        cmds.baked = true;
+    }
+
+    cmds.replay();
+    bindpoint = cmds.next_bindpoint;
 }
 
 //////////////////////////////////////////////////////
@@ -177,40 +242,51 @@ void polymer_blinn_phong_standard::update_uniforms()
 polymer_pbr_standard::polymer_pbr_standard()
 {
     shader = shader_handle("pbr-forward-lighting");
+    instancing_supported = true;
+    bindlessMaterialBuffer.memory.set_category(gl_memory_category::uniform_buffers);
 }
 
-void polymer_pbr_standard::resolve_variants() 
+void polymer_pbr_standard::resolve_variants()
 {
-    std::vector<std::string> processed_defines;
+    // Fast path: same submission flags as the last resolve means the cached
+    // variant is still the right one, so skip rebuilding and hashing the define
+    // set. Property and handle edits reset resolved_flags via invalidate_command_lists().
+    const uint32_t flags = (instanced ? 1u : 0u) | (clustered ? 2u : 0u) | (stereo ? 4u : 0u) | (skinned ? 8u : 0u) | (bindless ? 16u : 0u);
+    if (compiled_shader && flags == resolved_flags) return;
 
-    // Required Features
-    processed_defines.push_back("ENABLE_SHADOWS");
-    processed_defines.push_back("TWO_CASCADES");
-    processed_defines.push_back("USE_PCF_3X3");
-    processed_defines.push_back("USE_IMAGE_BASED_LIGHTING");
-
-    // Material slots
-    if (albedo.assigned()) processed_defines.push_back("HAS_ALBEDO_MAP");
-    if (roughness.assigned()) processed_defines.push_back("HAS_ROUGHNESS_MAP");
-    if (metallic.assigned()) processed_defines.push_back("HAS_METALNESS_MAP");
-    if (normal.assigned()) processed_defines.push_back("HAS_NORMAL_MAP");
-    if (occlusion.assigned()) processed_defines.push_back("HAS_OCCLUSION_MAP");
-    if (emissive.assigned()) processed_defines.push_back("HAS_EMISSIVE_MAP");
+    std::shared_ptr<gl_shader_asset> asset = shader.get();
 
-    const auto variant_hash = shader.get()->hash(processed_defines);
-
-    // First time
-    if (!compiled_shader)
+    // The family's feature bits, declared once against the shader asset. Variant
+    // selection below is a bitmask map lookup - no define vectors or string hashes.
+    if (asset->feature_count() == 0)
     {
-        compiled_shader = shader.get()->get_variant(processed_defines);
-        return;
-    }
-    else if (compiled_shader->hash != variant_hash)
-    {
-        // We updated the set of defines and need to recompile
-        compiled_shader = shader.get()->get_variant(processed_defines);
-        return;
+        asset->declare_features({
+            "ENABLE_SHADOWS", "TWO_CASCADES", "USE_PCF_3X3", "USE_IMAGE_BASED_LIGHTING", // required, always set
+            "USE_INSTANCING",          // submission mode (toggled by the renderer when drawing a batched group)
+            "USE_CLUSTERED_SHADING",   // light culling mode (set by the renderer when a cluster grid is bound)
+            "USE_STEREO_SINGLE_PASS",  // single-pass stereo (both eyes in one submission via viewport arrays)
+            "USE_SKINNING",            // gpu palette skinning (toggled by the renderer around skinned submission)
+            "USE_BINDLESS_TEXTURE",    // resident texture handles in a per-material ubo instead of per-draw sampler binds
+            "HAS_ALBEDO_MAP", "HAS_ROUGHNESS_MAP", "HAS_METALNESS_MAP", "HAS_NORMAL_MAP", "HAS_OCCLUSION_MAP", "HAS_EMISSIVE_MAP" });
     }
+
+    uint64_t mask = 0xf; // the four required features occupy the low bits
+
+    if (instanced) mask |= 1ull << 4;
+    if (clustered) mask |= 1ull << 5;
+    if (stereo)    mask |= 1ull << 6;
+    if (skinned)   mask |= 1ull << 7;
+    if (bindless)  mask |= 1ull << 8;
+
+    if (slot_named(albedo))    mask |= 1ull << 9;
+    if (slot_named(roughness)) mask |= 1ull << 10;
+    if (slot_named(metallic))  mask |= 1ull << 11;
+    if (slot_named(normal))    mask |= 1ull << 12;
+    if (slot_named(occlusion)) mask |= 1ull << 13;
+    if (slot_named(emissive))  mask |= 1ull << 14;
+
+    resolved_flags = flags;
+    compiled_shader = asset->get_variant(mask);
 }
 
 uint32_t polymer_pbr_standard::id()
@@ -223,34 +299,62 @@ void polymer_pbr_standard::update_uniforms()
 {
     resolve_variants();
     gl_shader & program = compiled_shader->shader;
-    program.bind();
 
-    program.uniform("u_roughness", roughnessFactor);
-    program.uniform("u_metallic", metallicFactor);
-    program.uniform("u_opacity", opacity);
-    program.uniform("u_albedo", baseAlbedo);
-    program.uniform("u_emissive", baseEmissive);
-    program.uniform("u_specularLevel", specularLevel);
-    program.uniform("u_occlusionStrength", occlusionStrength);
-    program.uniform("u_ambientStrength", ambientStrength);
-    program.uniform("u_emissiveStrength", emissiveStrength);
-    program.uniform("u_shadowOpacity", shadowOpacity);
-    program.uniform("u_texCoordScale", texcoordScale);
-
-    bindpoint = 0;
-
-    if (compiled_shader->enabled("HAS_ALBEDO_MAP")) program.texture("s_albedo", bindpoint++, albedo.get(), GL_TEXTURE_2D);
-    if (compiled_shader->enabled("HAS_NORMAL_MAP")) program.texture("s_normal", bindpoint++, normal.get(), GL_TEXTURE_2D);
-    if (compiled_shader->enabled("HAS_ROUGHNESS_MAP")) program.texture("s_roughness", bindpoint++, roughness.get(), GL_TEXTURE_2D);
-    if (compiled_shader->enabled("HAS_METALNESS_MAP")) program.texture("s_metallic", bindpoint++, metallic.get(), GL_TEXTURE_2D);
-    if (compiled_shader->enabled("HAS_EMISSIVE_MAP")) program.texture("s_emissive", bindpoint++, emissive.get(), GL_TEXTURE_2D);
-    if (compiled_shader->enabled("HAS_HEIGHT_MAP")) program.texture("s_height", bindpoint++, height.get(), GL_TEXTURE_2D);
-    if (compiled_shader->enabled("HAS_OCCLUSION_MAP")) program.texture("s_occlusion", bindpoint++, occlusion.get(), GL_TEXTURE_2D);
+    // Rebake after an edit, a texture reload, or the first use of a new variant
+    material_command_list & cmds = get_command_list(program.handle());
 
-    program.unbind();
+    if (!cmds.baked)
+    {
+        cmds.record(program, "u_roughness", roughnessFactor);
+        cmds.record(program, "u_metallic", metallicFactor);
+        cmds.record(program, "u_opacity", opacity);
+        cmds.record(program, "u_albedo", baseAlbedo);
+        cmds.record(program, "u_emissive", baseEmissive);
+        cmds.record(program, "u_specularLevel", specularLevel);
+        cmds.record(program, "u_occlusionStrength", occlusionStrength);
+        cmds.record(program, "u_ambientStrength", ambientStrength);
+        cmds.record(program, "u_emissiveStrength", emissiveStrength);
+        cmds.record(program, "u_shadowOpacity", shadowOpacity);
+        cmds.record(program, "u_texCoordScale", texcoordScale);
+
+        bindpoint = 0;
+
+        if (compiled_shader->enabled("USE_BINDLESS_TEXTURE"))
+        {
+            // Material textures live in a ubo of resident handles; only the
+            // ibl/shadow sets (which change per draw) still use texture units
+            uniforms::per_bindless_material block = {};
+            if (compiled_shader->enabled("HAS_ALBEDO_MAP")) block.albedo = make_resident_handle(albedo.get_or(fallback_albedo()));
+            if (compiled_shader->enabled("HAS_NORMAL_MAP")) block.normal = make_resident_handle(normal.get_or(fallback_normal()));
+            if (compiled_shader->enabled("HAS_ROUGHNESS_MAP")) block.roughness = make_resident_handle(roughness.get_or(fallback_mask()));
+            if (compiled_shader->enabled("HAS_METALNESS_MAP")) block.metallic = make_resident_handle(metallic.get_or(fallback_mask()));
+            if (compiled_shader->enabled("HAS_EMISSIVE_MAP")) block.emissive = make_resident_handle(emissive.get_or(fallback_mask()));
+            if (compiled_shader->enabled("HAS_OCCLUSION_MAP")) block.occlusion = make_resident_handle(occlusion.get_or(fallback_mask()));
+
+            bindlessMaterialBuffer.set_buffer_data(sizeof(block), &block, GL_STATIC_DRAW);
+            cmds.ubo = bindlessMaterialBuffer;
+            cmds.ubo_binding = uniforms::per_bindless_material::binding;
+        }
+        else
+        {
+            if (compiled_shader->enabled("HAS_ALBEDO_MAP")) cmds.record(program, "s_albedo", bindpoint++, albedo.get_or(fallback_albedo()), GL_TEXTURE_2D);
+            if (compiled_shader->enabled("HAS_NORMAL_MAP")) cmds.record(program, "s_normal", bindpoint++, normal.get_or(fallback_normal()), GL_TEXTURE_2D);
+            if (compiled_shader->enabled("HAS_ROUGHNESS_MAP")) cmds.record(program, "s_roughness", bindpoint++, roughness.get_or(fallback_mask()), GL_TEXTURE_2D);
+            if (compiled_shader->enabled("HAS_METALNESS_MAP")) cmds.record(program, "s_metallic", bindpoint++, metallic.get_or(fallback_mask()), GL_TEXTURE_2D);
+            if (compiled_shader->enabled("HAS_EMISSIVE_MAP")) cmds.record(program, "s_emissive", bindpoint++, emissive.get_or(fallback_mask()), GL_TEXTURE_2D);
+            if (compiled_shader->enabled("HAS_HEIGHT_MAP")) cmds.record(program, "s_height", bindpoint++, height.get_or(fallback_mask()), GL_TEXTURE_2D);
+            if (compiled_shader->enabled("HAS_OCCLUSION_MAP")) cmds.record(program, "s_occlusion", bindpoint++, occlusion.get_or(fallback_mask()), GL_TEXTURE_2D);
+        }
+
+        cmds.next_bindpoint = bindpoint;
+        cmds.baked = true;
+    }
+
+    cmds.replay();
+    bindpoint = cmds.next_bindpoint;
 }
 
-void polymer_pbr_standard::update_uniforms_ibl(GLuint irradiance, GLuint radiance)
+void polymer_pbr_standard::update_uniforms_ibl(GLuint irradiance, GLuint radiance, GLuint brdfLut, GLuint radianceBlend, float blendWeight)
 {
     resolve_variants();
     gl_shader & program = compiled_shader->shader;
@@ -259,6 +363,13 @@ void polymer_pbr_standard::update_uniforms_ibl(GLuint irradiance, GLuint radianc
     program.bind();
     program.texture("sc_irradiance", bindpoint++, irradiance, GL_TEXTURE_CUBE_MAP);
     program.texture("sc_radiance", bindpoint++, radiance, GL_TEXTURE_CUBE_MAP);
+    program.texture("s_brdfLut", bindpoint++, brdfLut, GL_TEXTURE_2D);
+
+    // Optional second radiance probe, blended in-shader so objects crossing probe
+    // boundaries transition smoothly instead of popping
+    if (radianceBlend) program.texture("sc_radiance_blend", bindpoint++, radianceBlend, GL_TEXTURE_CUBE_MAP);
+    program.uniform("u_probeBlend", radianceBlend ? blendWeight : 0.f);
+
     program.unbind();
 }
 
@@ -17,6 +17,77 @@ namespace polymer
 
     typedef std::shared_ptr<polymer::shader_variant> cached_variant;
 
+    ///////////////////////////////
+    //   material_command_list   //
+    ///////////////////////////////
+
+    // A flat list of baked bindings for one program variant of a material.
+    // Setting material state normally re-queries every uniform location by name
+    // and re-resolves every texture_handle on each bind; the command list
+    // captures those results once (uniform locations + values, texture unit
+    // assignments) and replays them with one gl call each until the material is
+    // edited or the variant recompiles.
+    struct material_command_list
+    {
+        struct uniform_command { GLint location; int components; float value[4]; };
+        struct texture_command { int unit; GLenum target; GLuint texture; };
+
+        GLuint program{ 0 };     // the variant program this list was baked against
+        std::vector<uniform_command> uniforms;
+        std::vector<texture_command> textures;
+        GLuint ubo{ 0 };         // optional per-material uniform buffer (bindless texture handles)
+        int ubo_binding{ -1 };
+        int next_bindpoint{ 0 }; // first free unit after the baked textures (ibl/shadow sets continue from here)
+        bool baked{ false };
+
+        void record(const gl_shader & s, const char * name, const float v) { push(s, name, 1, &v); }
+        void record(const gl_shader & s, const char * name, const float2 & v) { push(s, name, 2, v.data()); }
+        void record(const gl_shader & s, const char * name, const float3 & v) { push(s, name, 3, v.data()); }
+        void record(const gl_shader & s, const char * name, const float4 & v) { push(s, name, 4, v.data()); }
+
+        // The sampler uniform itself is program state and only needs to be set
+        // once here at bake time; replay just rebinds the unit.
+        void record(const gl_shader & s, const char * name, const int unit, GLuint tex, GLenum target)
+        {
+            s.texture(name, unit, tex, target);
+            textures.push_back({ unit, target, tex });
+        }
+
+        // Uniforms upload via dsa so no program needs to be bound
+        void replay() const
+        {
+            for (const auto & u : uniforms)
+            {
+                switch (u.components)
+                {
+                    case 1: glProgramUniform1fv(program, u.location, 1, u.value); break;
+                    case 2: glProgramUniform2fv(program, u.location, 1, u.value); break;
+                    case 3: glProgramUniform3fv(program, u.location, 1, u.value); break;
+                    case 4: glProgramUniform4fv(program, u.location, 1, u.value); break;
+                }
+            }
+
+            for (const auto & t : textures)
+            {
+                gl_submission_stats::get().add_texture_bind();
+                glBindMultiTextureEXT(GL_TEXTURE0 + t.unit, t.target, t.texture);
+            }
+
+            if (ubo_binding >= 0) glBindBufferBase(GL_UNIFORM_BUFFER, ubo_binding, ubo);
+        }
+
+    private:
+
+        void push(const gl_shader & s, const char * name, const int components, const float * v)
+        {
+            uniform_command u;
+            u.location = s.get_uniform_location(name);
+            u.components = components;
+            for (int i = 0; i < components; ++i) u.value[i] = v[i];
+            uniforms.push_back(u);
+        }
+    };
+
     ////////////////////////////
     //   material_interface   //
     ////////////////////////////
@@ -25,10 +96,46 @@ namespace polymer
     {
         mutable cached_variant compiled_shader{ nullptr };  // cached on first access (because needs to happen on GL thread)
         shader_handle shader;                               // typically set during object inflation / deserialization
+        bool instanced{ false };                            // toggled by the renderer around batched submission; adds USE_INSTANCING to the variant defines
+        bool clustered{ false };                            // set by the renderer when a cluster light grid is bound; adds USE_CLUSTERED_SHADING
+        bool stereo{ false };                               // set by the renderer in single-pass stereo mode; adds USE_STEREO_SINGLE_PASS
+        bool skinned{ false };                              // toggled by the renderer around palette-skinned submission; adds USE_SKINNING
+        bool bindless{ false };                             // set by the renderer when GL_ARB_bindless_texture is in use; adds USE_BINDLESS_TEXTURE
+        bool oit{ false };                                  // toggled by the renderer inside the weighted-oit transparency stage; adds USE_WEIGHTED_OIT
         virtual void update_uniforms() {}                   // generic interface for overriding specific uniform sets
         virtual void use() {}                               // generic interface for binding the program
         virtual void resolve_variants() = 0;                // all overridden functions need to call this to cache the shader
         virtual uint32_t id() = 0;                          // returns the gl handle, used for sorting materials by type to minimize state changes in the renderer
+        virtual bool requires_blending() const { return false; } // routed through the renderer's back-to-front transparency pass instead of the opaque queue
+        void set_instanced(const bool b) { instanced = b; }
+        void set_clustered(const bool b) { clustered = b; }
+        void set_stereo(const bool b) { stereo = b; }
+        void set_skinned(const bool b) { skinned = b; }
+        void set_bindless(const bool b) { bindless = b; }
+        void set_oit(const bool b) { oit = b; }
+        bool supports_instancing() const { return instancing_supported; }
+
+        // Drops any baked binding state so the next bind re-resolves handles and
+        // locations. Called from the edit path (visit_fields) and by the asset
+        // resolver when a referenced texture is (re)loaded.
+        void invalidate_command_lists() { command_lists.clear(); resolved_flags = 0xffffffff; }
+
+    protected:
+        bool instancing_supported{ false };                 // set by subclasses whose vertex stage understands USE_INSTANCING
+
+        // One list per live variant program: the renderer toggles instanced /
+        // skinned / etc. around submission, so a material can alternate between
+        // a few programs within a single frame.
+        material_command_list & get_command_list(const GLuint program)
+        {
+            for (auto & c : command_lists) if (c.program == program) return c;
+            command_lists.push_back(material_command_list());
+            command_lists.back().program = program;
+            return command_lists.back();
+        }
+
+        std::vector<material_command_list> command_lists;
+        uint32_t resolved_flags{ 0xffffffff };              // submission flag mask the cached variant was resolved against
     };
 
     //////////////////////////////////
@@ -58,6 +165,7 @@ namespace polymer
         virtual void use() override final;
         virtual void resolve_variants() override final;
         virtual uint32_t id() override final;
+        virtual bool requires_blending() const override final { return true; }
     };
     POLYMER_SETUP_TYPEID(polymer_fx_material);
 
@@ -121,6 +229,7 @@ namespace polymer
         f("diffuse_handle", o.diffuse);
         f("normal_handle", o.normal);
         f("program_handle", o.shader, editor_hidden{}); // hidden because shaders are tied to materials
+        o.invalidate_command_lists(); // any property may have changed, so baked bindings are stale
         o.resolve_variants(); // trigger recompile if a property has been changed
     }
 
@@ -143,6 +252,7 @@ namespace polymer
     class polymer_pbr_standard final : public material_interface
     {
         int bindpoint = 0;
+        gl_buffer bindlessMaterialBuffer; // resident GLuint64 handles (uniforms::per_bindless_material)
 
     public:
 
@@ -154,7 +264,7 @@ namespace polymer
         virtual uint32_t id() override final;
 
         void update_uniforms_shadow(GLuint handle);
-        void update_uniforms_ibl(GLuint irradiance, GLuint radiance);
+        void update_uniforms_ibl(GLuint irradiance, GLuint radiance, GLuint brdfLut, GLuint radianceBlend = 0, float blendWeight = 0.f);
 
         float3 baseAlbedo{1.f, 1.f, 1.f};
 
@@ -204,6 +314,7 @@ namespace polymer
         f("height_handle", o.height);
         f("occlusion_handle", o.occlusion);
         f("program_handle", o.shader, editor_hidden{}); // hidden because shaders are tied to materials
+        o.invalidate_command_lists(); // any property may have changed, so baked bindings are stale
         o.resolve_variants(); // trigger recompile if a property has been changed
     }
 
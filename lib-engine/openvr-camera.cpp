@@ -65,20 +65,31 @@ bool openvr_tracked_camera::start()
     uint32_t frameHeight = 0;
     uint32_t framebufferSize = 0;
 
-    intrin.width = frameWidth;
-    intrin.height = frameHeight;
-
     if (trackedCamera->GetCameraFrameSize(vr::k_unTrackedDeviceIndex_Hmd, vr::VRTrackedCameraFrameType_MaximumUndistorted, &frameWidth, &frameHeight, &framebufferSize) != vr::VRTrackedCameraError_None)
     {
         std::cout << "GetCameraFrameSize() failed" << std::endl;
         return false;
     }
 
-    // Generate texture handle
-    frame.texture.setup(intrin.width, intrin.height, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    intrin.width = frameWidth;
+    intrin.height = frameHeight;
+    cameraFrameBufferSize = framebufferSize;
 
-    // Create a persistent buffer for holding the incoming camera data
-    frame.rawBytes = image_buffer<uint8_t, 3>(int2(frameWidth, frameHeight));
+    // Generate texture handles (double-buffered: consumers bind frame.texture
+    // while the next frame uploads into backTexture)
+    frame.texture.setup(intrin.width, intrin.height, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    backTexture.setup(intrin.width, intrin.height, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+
+    // Persistent-mapped PBO ring for the incoming camera data
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    slotSize = framebufferSize;
+    glNamedBufferStorageEXT(streamingPbo, slotSize * PBO_RING_SIZE, nullptr, flags);
+    streamingPboMapped = reinterpret_cast<uint8_t *>(glMapNamedBufferRangeEXT(streamingPbo, 0, slotSize * PBO_RING_SIZE, flags));
+    if (!streamingPboMapped)
+    {
+        std::cout << "glMapNamedBufferRangeEXT failed (persistent mapping unsupported?)" << std::endl;
+        return false;
+    }
 
     lastFrameSequence = 0;
 
@@ -99,9 +110,15 @@ void openvr_tracked_camera::stop()
     trackedCameraHandle = INVALID_TRACKED_CAMERA_HANDLE;
 }
 
+openvr_tracked_camera::~openvr_tracked_camera()
+{
+    for (int i = 0; i < PBO_RING_SIZE; ++i) if (slotFences[i]) glDeleteSync(slotFences[i]);
+    if (streamingPboMapped) glUnmapNamedBufferEXT(streamingPbo);
+}
+
 void openvr_tracked_camera::capture()
 {
-    if (!trackedCamera || !trackedCameraHandle) return;
+    if (!trackedCamera || !trackedCameraHandle || !streamingPboMapped) return;
 
     vr::CameraVideoStreamFrameHeader_t frameHeader;
     vr::EVRTrackedCameraError error = trackedCamera->GetVideoStreamFrameBuffer(trackedCameraHandle, vr::VRTrackedCameraFrameType_MaximumUndistorted, nullptr, 0, &frameHeader, sizeof(frameHeader));
@@ -110,13 +127,33 @@ void openvr_tracked_camera::capture()
     // Ideally called once every ~16ms but who knows
     if (frameHeader.nFrameSequence == lastFrameSequence) return;
 
-    // Copy
-    error = trackedCamera->GetVideoStreamFrameBuffer(trackedCameraHandle, vr::VRTrackedCameraFrameType_MaximumUndistorted, frame.rawBytes.data(), cameraFrameBufferSize, &frameHeader, sizeof(frameHeader));
+    // Skip the frame (rather than stall) if the GPU hasn't finished reading
+    // the next ring slot - the consumer keeps the last completed texture
+    const int nextSlot = (slotIndex + 1) % PBO_RING_SIZE;
+    if (slotFences[nextSlot])
+    {
+        const GLenum wait = glClientWaitSync(slotFences[nextSlot], 0, 0);
+        if (wait != GL_ALREADY_SIGNALED && wait != GL_CONDITION_SATISFIED) return;
+        glDeleteSync(slotFences[nextSlot]);
+        slotFences[nextSlot] = nullptr;
+    }
+    slotIndex = nextSlot;
+
+    // The API writes directly into the mapped slot - no intermediate CPU vector
+    const GLintptr slotOffset = slotIndex * slotSize;
+    error = trackedCamera->GetVideoStreamFrameBuffer(trackedCameraHandle, vr::VRTrackedCameraFrameType_MaximumUndistorted, streamingPboMapped + slotOffset, cameraFrameBufferSize, &frameHeader, sizeof(frameHeader));
     if (error != vr::VRTrackedCameraError_None) return;
 
     frame.render_pose = make_pose(frameHeader.standingTrackedDevicePose.mDeviceToAbsoluteTracking);
 
     lastFrameSequence = frameHeader.nFrameSequence;
 
-    glTextureImage2DEXT(frame.texture, GL_TEXTURE_2D, 0, GL_RGB, intrin.width, intrin.height, 0, GL_RGB, GL_UNSIGNED_BYTE, frame.rawBytes.data());
+    // Queue the upload sourced from the PBO slot, fence it, and flip the
+    // freshly written texture into the frame the consumer sees
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, streamingPbo);
+    glTextureSubImage2DEXT(backTexture, GL_TEXTURE_2D, 0, 0, 0, intrin.width, intrin.height, GL_RGB, GL_UNSIGNED_BYTE, reinterpret_cast<const void *>(slotOffset));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    slotFences[slotIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    std::swap(frame.texture, backTexture);
 }
\ No newline at end of file
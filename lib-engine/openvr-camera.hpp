@@ -8,7 +8,6 @@
 #include "math-core.hpp"
 #include "geometry.hpp"
 #include "gl-api.hpp"
-#include "image-buffer.hpp"
 
 namespace polymer
 {
@@ -26,7 +25,6 @@ namespace polymer
     {
         transform render_pose;
         gl_texture_2d texture;
-        image_buffer<uint8_t, 3> rawBytes;
     };
 
     class openvr_tracked_camera
@@ -42,8 +40,23 @@ namespace polymer
         camera_intrinsics intrin;
         tracked_camera_frame frame;
 
+        // Persistent-mapped PBO ring: the OpenVR API writes each frame straight
+        // into a mapped slot and the texture upload sources from the bound PBO,
+        // so pixels cross the CPU once instead of staging through a vector. A
+        // slot whose fence hasn't signaled means the GPU is still consuming it;
+        // capture() skips that frame rather than stalling the main thread.
+        static const int PBO_RING_SIZE = 3;
+        gl_buffer_object streamingPbo;
+        uint8_t * streamingPboMapped{ nullptr };
+        GLsync slotFences[PBO_RING_SIZE] = { nullptr, nullptr, nullptr };
+        int slotIndex{ 0 };
+        GLsizeiptr slotSize{ 0 };
+        gl_texture_2d backTexture; // upload target, swapped into frame.texture once the copy is queued
+
     public:
 
+        ~openvr_tracked_camera();
+
         bool initialize(vr::IVRSystem * vr_system);
         bool start();
         void stop();
@@ -32,15 +32,101 @@ openvr_hmd::openvr_hmd()
     {
         throw std::runtime_error("could not initialize VRCompositor");
     }
+
+    // Timing properties used to predict poses to photon time on the tracking thread
+    vr::TrackedPropertyError propError = vr::TrackedProp_Success;
+    const float secondsFromVsyncToPhotons = hmd->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_SecondsFromVsyncToPhotons_Float, &propError);
+    if (propError == vr::TrackedProp_Success) vsync_to_photons = secondsFromVsyncToPhotons;
+    const float displayFrequency = hmd->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float, &propError);
+    if (propError == vr::TrackedProp_Success && displayFrequency > 0.f) display_frequency = displayFrequency;
+
+    tracking_thread = std::thread([this]() { tracking_loop(); });
 }
 
 openvr_hmd::~openvr_hmd()
 {
+    tracking_should_exit = true;
+    if (tracking_thread.joinable()) tracking_thread.join();
     glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_FALSE);
     glDebugMessageCallback(nullptr, nullptr);
     if (hmd) vr::VR_Shutdown();
 }
 
+// Runs for the lifetime of the hmd. WaitGetPoses (in update()) still drives
+// compositor pacing on the render thread; this loop keeps the hmd prediction
+// slot fresh so the renderer can late-latch a pose sampled microseconds ago
+// rather than one from the top of the frame, and samples controller state at
+// the same rate so input latency is bounded by the poll interval instead of
+// jittering with frame time.
+void openvr_hmd::tracking_loop()
+{
+    std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount> poses;
+
+    while (!tracking_should_exit)
+    {
+        // Predict forward to the moment the current frame's photons leave the panel
+        float secondsSinceLastVsync = 0.f;
+        hmd->GetTimeSinceLastVsync(&secondsSinceLastVsync, nullptr);
+        const float frameDuration = 1.f / display_frequency;
+        const float predictedSeconds = frameDuration - secondsSinceLastVsync + vsync_to_photons;
+
+        hmd->GetDeviceToAbsoluteTrackingPose(vr::VRCompositor()->GetTrackingSpace(), predictedSeconds, poses.data(), static_cast<uint32_t>(poses.size()));
+
+        const vr::TrackedDevicePose_t & hmdSample = poses[vr::k_unTrackedDeviceIndex_Hmd];
+        if (hmdSample.bPoseIsValid) predicted_pose_slot.write(make_pose(hmdSample.mDeviceToAbsoluteTracking));
+
+        const double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i)
+        {
+            if (hmd->GetTrackedDeviceClass(i) != vr::TrackedDeviceClass_Controller) continue;
+
+            uint32_t hand = 0;
+            switch (hmd->GetControllerRoleForTrackedDeviceIndex(i))
+            {
+                case vr::TrackedControllerRole_LeftHand:  hand = 0; break;
+                case vr::TrackedControllerRole_RightHand: hand = 1; break;
+                default: continue;
+            }
+
+            vr::VRControllerState_t controllerState = vr::VRControllerState_t();
+            if (!hmd->GetControllerState(i, &controllerState, sizeof(controllerState))) continue;
+
+            vr_input_sample sample;
+            sample.timestamp = now;
+            sample.buttonMask = controllerState.ulButtonPressed;
+            sample.touchpad = { controllerState.rAxis[vr::k_eControllerAxis_TrackPad].x, controllerState.rAxis[vr::k_eControllerAxis_TrackPad].y };
+            sample.poseValid = poses[i].bPoseIsValid;
+            if (sample.poseValid) sample.pose = make_pose(poses[i].mDeviceToAbsoluteTracking);
+            controller_sample_slot[hand].write(sample);
+
+            // Queue transitions only; held state is recoverable from the slot if
+            // the queue ever overflows, so dropping here is merely edge loss
+            if (controllerState.ulButtonPressed != polled_button_mask[hand])
+            {
+                vr_input_event evt{ now, hand, controllerState.ulButtonPressed };
+                input_event_queue.produce(evt);
+                polled_button_mask[hand] = controllerState.ulButtonPressed;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+}
+
+bool openvr_hmd::get_predicted_hmd_pose(transform & out)
+{
+    transform sample;
+    if (!predicted_pose_slot.read(sample)) return false;
+    out = worldPose * sample;
+    return true;
+}
+
+transform openvr_hmd::get_eye_pose_from(const transform & hmd_world_pose, vr_eye eye)
+{
+    return hmd_world_pose * make_pose(hmd->GetEyeToHeadTransform(static_cast<vr::Hmd_Eye>(eye)));
+}
+
 vr_controller openvr_hmd::get_controller(vr_controller_role controller)
 {
     auto openvr_controller = static_cast<vr::ETrackedControllerRole>(controller);
@@ -213,53 +299,60 @@ void openvr_hmd::update()
     for (vr::TrackedDeviceIndex_t i = 0; i < poses.size(); ++i)
     {
         if (!poses[i].bPoseIsValid) continue;
-        switch (hmd->GetTrackedDeviceClass(i))
-        {
-        case vr::TrackedDeviceClass_HMD:
+        if (hmd->GetTrackedDeviceClass(i) == vr::TrackedDeviceClass_HMD)
         {
-            hmdPose = make_pose(poses[i].mDeviceToAbsoluteTracking); 
-            break;
+            hmdPose = make_pose(poses[i].mDeviceToAbsoluteTracking);
         }
-        case vr::TrackedDeviceClass_Controller:
+    }
+
+    // Controller input comes from the tracking thread. First age last frame's
+    // single-frame edge flags (update_button_state with the current value keeps
+    // `down` and clears `pressed`/`released`)...
+    const vr_button triggerButton = get_button_id_for_vendor(static_cast<uint32_t>(vr::k_EButton_SteamVR_Trigger), get_input_vendor());
+    const vr_button padButton = get_button_id_for_vendor(static_cast<uint32_t>(vr::k_EButton_SteamVR_Touchpad), get_input_vendor());
+
+    for (int hand = 0; hand < 2; ++hand)
+    {
+        for (const vr_button b : { triggerButton, padButton })
         {
-            vr::VRControllerState_t controllerState = vr::VRControllerState_t();
-            switch (hmd->GetControllerRoleForTrackedDeviceIndex(i))
-            {
-            case vr::TrackedControllerRole_LeftHand:
-            {
-                if (hmd->GetControllerState(i, &controllerState, sizeof(controllerState)))
-                {
-                    update_button_state(controllers[0].buttons[get_button_id_for_vendor(static_cast<uint32_t>(vr::k_EButton_SteamVR_Trigger), get_input_vendor())],
-                        !!(controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger)));
-
-                    update_button_state(controllers[0].buttons[get_button_id_for_vendor(static_cast<uint32_t>(vr::k_EButton_SteamVR_Touchpad), get_input_vendor())],
-                        !!(controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Touchpad)));
-
-                    controllers[0].xy_values = { controllerState.rAxis[vr::k_eControllerAxis_TrackPad].x, controllerState.rAxis[vr::k_eControllerAxis_TrackPad].y };
-                    controllers[0].t = (worldPose * make_pose(poses[i].mDeviceToAbsoluteTracking));
-                }
-                break;
-            }
-            case vr::TrackedControllerRole_RightHand:
-            {
-                if (hmd->GetControllerState(i, &controllerState, sizeof(controllerState)))
-                {
-                    update_button_state(controllers[1].buttons[get_button_id_for_vendor(static_cast<uint32_t>(vr::k_EButton_SteamVR_Trigger), get_input_vendor())],
-                        !!(controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Trigger)));
-
-                    update_button_state(controllers[1].buttons[get_button_id_for_vendor(static_cast<uint32_t>(vr::k_EButton_SteamVR_Touchpad), get_input_vendor())],
-                        !!(controllerState.ulButtonPressed & vr::ButtonMaskFromId(vr::k_EButton_SteamVR_Touchpad)));
-
-                    controllers[1].xy_values = { controllerState.rAxis[vr::k_eControllerAxis_TrackPad].x, controllerState.rAxis[vr::k_eControllerAxis_TrackPad].y };
-                    controllers[1].t = (worldPose * make_pose(poses[i].mDeviceToAbsoluteTracking));
-                }
-                break;
-            }
-            }
-            break;
-        }
+            vr_button_state & s = controllers[hand].buttons[b];
+            update_button_state(s, s.down);
         }
     }
+
+    // ...then fold every queued button-mask transition since the previous frame,
+    // accumulating edges so a press and release that both landed within one
+    // frame still register as pressed and released this frame
+    auto fold_transition = [this](const uint32_t hand, const vr_button b, const vr::EVRButtonId id, const uint64_t mask)
+    {
+        vr_button_state & s = controllers[hand].buttons[b];
+        const bool wasPressed = s.pressed;
+        const bool wasReleased = s.released;
+        update_button_state(s, !!(mask & vr::ButtonMaskFromId(id)));
+        s.pressed |= wasPressed;
+        s.released |= wasReleased;
+    };
+
+    vr_input_event evt;
+    while (input_event_queue.consume(evt))
+    {
+        fold_transition(evt.hand, triggerButton, vr::k_EButton_SteamVR_Trigger, evt.buttonMask);
+        fold_transition(evt.hand, padButton, vr::k_EButton_SteamVR_Touchpad, evt.buttonMask);
+    }
+
+    // Finally latch the freshest per-hand sample for poses and axes, and
+    // reconcile held state against it in case transitions were ever dropped
+    for (uint32_t hand = 0; hand < 2; ++hand)
+    {
+        vr_input_sample sample;
+        if (!controller_sample_slot[hand].read(sample)) continue;
+
+        fold_transition(hand, triggerButton, vr::k_EButton_SteamVR_Trigger, sample.buttonMask);
+        fold_transition(hand, padButton, vr::k_EButton_SteamVR_Touchpad, sample.buttonMask);
+
+        controllers[hand].xy_values = sample.touchpad;
+        if (sample.poseValid) controllers[hand].t = worldPose * sample.pose;
+    }
 }
 
 void openvr_hmd::submit(const GLuint leftEye, const GLuint rightEye)
@@ -5,9 +5,70 @@
 
 #include "openvr/include/openvr.h"
 #include "hmd-base.hpp"
+#include "queue-spsc-bounded.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace polymer;
 
+// Single-writer/single-reader latest-value slot for tracking samples (seqlock).
+// The sequence is odd while the writer is mid-update; readers retry until they
+// observe the same even value on both sides of the copy, so the render thread
+// always gets a coherent sample without ever blocking the tracking thread.
+template<typename T>
+struct tracked_sample_slot
+{
+    std::atomic<uint32_t> sequence{ 0 };
+    T sample;
+
+    void write(const T & s)
+    {
+        const uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_release); // odd: write in progress
+        sample = s;
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Returns false until the first sample has been written
+    bool read(T & out)
+    {
+        for (int attempt = 0; attempt < 16; ++attempt)
+        {
+            const uint32_t seqBefore = sequence.load(std::memory_order_acquire);
+            if (seqBefore == 0) return false;
+            if (seqBefore & 1) continue;
+            const T copy = sample;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == seqBefore) { out = copy; return true; }
+        }
+        return false;
+    }
+};
+
+typedef tracked_sample_slot<transform> tracked_pose_slot;
+
+// One high-rate controller sample from the tracking thread. Timestamps are
+// seconds on std::chrono::steady_clock, taken at poll time.
+struct vr_input_sample
+{
+    double timestamp{ 0.0 };
+    uint64_t buttonMask{ 0 };
+    float2 touchpad{ 0.f, 0.f };
+    transform pose;
+    bool poseValid{ false };
+};
+
+// A change in a controller's button mask, queued so that a press + release
+// that both land between two render frames still produce their edges.
+struct vr_input_event
+{
+    double timestamp{ 0.0 };
+    uint32_t hand{ 0 }; // 0 = left, 1 = right
+    uint64_t buttonMask{ 0 };
+};
+
 inline transform make_pose(const vr::HmdMatrix34_t & m)
 {
     return {
@@ -29,6 +90,20 @@ class openvr_hmd : public hmd_base
     std::function<void(cached_controller_render_data & data)> async_data_cb;
     void load_render_data_impl(vr::VREvent_t event);
 
+    // Tracking thread: samples photon-time-predicted poses and controller state
+    // continuously, decoupled from WaitGetPoses frame pacing. Poses/axes go into
+    // latest-value slots; button-mask transitions are additionally queued so no
+    // press/release edge is lost between render frames.
+    std::thread tracking_thread;
+    std::atomic<bool> tracking_should_exit{ false };
+    tracked_pose_slot predicted_pose_slot;
+    tracked_sample_slot<vr_input_sample> controller_sample_slot[2];
+    spsc_queue_bounded<vr_input_event> input_event_queue{ 256 };
+    uint64_t polled_button_mask[2]{ 0, 0 }; // tracking-thread local
+    float vsync_to_photons{ 0.f };
+    float display_frequency{ 90.f };
+    void tracking_loop();
+
 public:
 
     openvr_hmd();
@@ -41,6 +116,14 @@ public:
     virtual void set_hmd_pose(const transform & p) override final;
 
     virtual transform get_eye_pose(vr_eye eye) override final;
+
+    // Freshest photon-time-predicted hmd pose (world space) from the tracking
+    // thread; false until the first sample lands. Intended for late-latching.
+    bool get_predicted_hmd_pose(transform & out);
+
+    // Eye pose derived from an explicit hmd pose rather than the most recent
+    // WaitGetPoses result (pairs with get_predicted_hmd_pose for late-latch)
+    transform get_eye_pose_from(const transform & hmd_world_pose, vr_eye eye);
     virtual vr_controller get_controller(vr_controller_role controller) override final;
     virtual uint2 get_recommended_render_target_size() override final;
     virtual float4x4 get_proj_matrix(vr_eye eye, float near_clip, float far_clip) override final;
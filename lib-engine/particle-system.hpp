@@ -0,0 +1,266 @@
+#pragma once
+
+#ifndef polymer_particle_system_hpp
+#define polymer_particle_system_hpp
+
+#include "math-core.hpp"
+#include "gl-api.hpp"
+#include "util.hpp"
+
+#include <vector>
+
+namespace polymer
+{
+    /////////////////////////////
+    //   gpu_particle_system   //
+    /////////////////////////////
+
+    // GPU-resident successor to the CPU particle system in samples/gl-particles-hull. Particles
+    // live in double-buffered SSBOs: the simulation pass integrates, applies the modifier set
+    // (gravity, damping, point attractor, ground bounce) and stream-compacts survivors into the
+    // destination buffer with an atomic counter that doubles as the instance count of an indirect
+    // draw command. New particles are appended by a second small dispatch from a staging buffer
+    // filled on the CPU. The alive count never crosses back over the bus, so the only per-frame
+    // CPU cost is the emission upload - the CPU path re-uploads every particle every frame and
+    // tops out around 50k where this handles millions.
+
+    static const char * particle_simulate_compute_source = R"(#version 450
+        layout(local_size_x = 128) in;
+        struct gpu_particle { vec4 position_life; vec4 velocity_size; };
+        layout(std430, binding = 0) readonly buffer ParticlesIn { gpu_particle p_in[]; };
+        layout(std430, binding = 1) writeonly buffer ParticlesOut { gpu_particle p_out[]; };
+        layout(std430, binding = 2) buffer DstCommand { uint dst_vertexCount; uint dst_instanceCount; uint dst_firstVertex; uint dst_baseInstance; };
+        layout(std430, binding = 3) readonly buffer SrcCommand { uint src_vertexCount; uint src_instanceCount; uint src_firstVertex; uint src_baseInstance; };
+        uniform float u_dt;
+        uniform vec4 u_gravityDamping; // xyz gravity, w damping per second
+        uniform vec4 u_ground;         // plane equation (0 to disable)
+        uniform vec4 u_pointGravity;   // xyz position, w strength (0 to disable)
+        void main()
+        {
+            uint i = gl_GlobalInvocationID.x;
+            if (i >= src_instanceCount) return;
+
+            gpu_particle p = p_in[i];
+            float life = p.position_life.w - u_dt;
+            if (life <= 0.0) return; // dead particles are simply not compacted forward
+
+            vec3 vel = p.velocity_size.xyz + u_gravityDamping.xyz * u_dt;
+            if (u_pointGravity.w > 0.0)
+            {
+                vec3 d = u_pointGravity.xyz - p.position_life.xyz;
+                float distSqr = max(dot(d, d), 1e-4);
+                vel += normalize(d) * min(u_pointGravity.w / distSqr, 8.0) * u_dt;
+            }
+            vel *= pow(u_gravityDamping.w, u_dt);
+
+            vec3 pos = p.position_life.xyz + vel * u_dt;
+            if (dot(u_ground.xyz, u_ground.xyz) > 0.0)
+            {
+                float reflected = dot(u_ground.xyz, vel);
+                if (dot(u_ground, vec4(pos, 1.0)) < 0.0 && reflected < 0.0) vel -= u_ground.xyz * (reflected * 2.0);
+            }
+
+            uint slot = atomicAdd(dst_instanceCount, 1u);
+            p_out[slot].position_life = vec4(pos, life);
+            p_out[slot].velocity_size = vec4(vel, p.velocity_size.w);
+        })";
+
+    static const char * particle_emit_compute_source = R"(#version 450
+        layout(local_size_x = 128) in;
+        struct gpu_particle { vec4 position_life; vec4 velocity_size; };
+        layout(std430, binding = 0) readonly buffer Emission { gpu_particle emitted[]; };
+        layout(std430, binding = 1) writeonly buffer ParticlesOut { gpu_particle p_out[]; };
+        layout(std430, binding = 2) buffer DstCommand { uint dst_vertexCount; uint dst_instanceCount; uint dst_firstVertex; uint dst_baseInstance; };
+        uniform int u_emitCount;
+        uniform int u_maxParticles;
+        void main()
+        {
+            uint i = gl_GlobalInvocationID.x;
+            if (i >= uint(u_emitCount)) return;
+            uint slot = atomicAdd(dst_instanceCount, 1u);
+            if (slot >= uint(u_maxParticles)) { atomicAdd(dst_instanceCount, uint(-1)); return; } // pool exhausted; undo
+            p_out[slot] = emitted[i];
+        })";
+
+    class gpu_particle_system
+    {
+        // Matches the std430 struct in the kernels: xyz position / w remaining life,
+        // xyz velocity / w size
+        struct gpu_particle
+        {
+            float4 position_life;
+            float4 velocity_size;
+        };
+
+        // glDrawArraysIndirect layout; instanceCount is the compaction cursor
+        struct draw_arrays_command
+        {
+            uint32_t vertexCount{ 6 };
+            uint32_t instanceCount{ 0 };
+            uint32_t firstVertex{ 0 };
+            uint32_t baseInstance{ 0 };
+        };
+
+        gl_shader_compute simulateShader{ particle_simulate_compute_source };
+        gl_shader_compute emitShader{ particle_emit_compute_source };
+
+        gl_buffer particleBuffers[2];   // double-buffered pool; sim compacts src -> dst
+        gl_buffer commandBuffers[2];    // indirect draw command per pool buffer
+        gl_buffer emissionBuffer;       // staging for particles added this frame
+        gl_buffer vertexBuffer;         // billboard corner texcoords
+        gl_vertex_array_object vao;
+
+        std::vector<gpu_particle> pendingEmissions;
+        uint32_t srcIndex{ 0 };
+        bool computeSupported{ false };
+
+    public:
+
+        // Modifier set, evaluated in the simulation kernel
+        float3 gravity{ 0, -9.8f, 0 };
+        float damping{ 0.85f };                   // velocity retained per second
+        float4 groundPlane{ 0, 0, 0, 0 };         // plane equation; zero normal disables the bounce
+        float4 pointGravity{ 0, 0, 0, 0 };        // xyz attractor position, w strength (0 disables)
+
+        const uint32_t maxParticles;
+
+        gpu_particle_system(const uint32_t max_particles = 1 << 20) : maxParticles(max_particles)
+        {
+            std::vector<std::pair<std::string, bool>> requiredExtensions = { { "GL_ARB_compute_shader", false }, { "GL_ARB_draw_indirect", false } };
+            has_gl_extension(requiredExtensions);
+            computeSupported = requiredExtensions[0].second && requiredExtensions[1].second;
+            if (!computeSupported) return;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                glNamedBufferDataEXT(particleBuffers[i], maxParticles * sizeof(gpu_particle), nullptr, GL_DYNAMIC_COPY);
+                const draw_arrays_command cmd;
+                glNamedBufferDataEXT(commandBuffers[i], sizeof(cmd), &cmd, GL_DYNAMIC_COPY);
+            }
+
+            const float2 triangle_coords[] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 0, 1 }, { 1, 0 }, { 1, 1 } };
+            glNamedBufferDataEXT(vertexBuffer, sizeof(triangle_coords), triangle_coords, GL_STATIC_DRAW);
+        }
+
+        bool is_supported() const { return computeSupported; }
+
+        // Queue a particle for emission on the next update
+        void add(const float3 & position, const float3 & velocity, const float size, const float lifeSeconds)
+        {
+            gpu_particle p;
+            p.position_life = float4(position, lifeSeconds);
+            p.velocity_size = float4(velocity, size);
+            pendingEmissions.push_back(p);
+        }
+
+        void update(const float dt)
+        {
+            if (!computeSupported) return;
+
+            const uint32_t dstIndex = 1 - srcIndex;
+
+            // Reset the destination compaction cursor
+            const draw_arrays_command reset;
+            glNamedBufferSubDataEXT(commandBuffers[dstIndex], 0, sizeof(reset), &reset);
+
+            // Simulate: integrate src and compact survivors into dst. Group count covers the
+            // whole pool; threads past the alive count early-out against the src command.
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, particleBuffers[srcIndex]);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, particleBuffers[dstIndex]);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commandBuffers[dstIndex]);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, commandBuffers[srcIndex]);
+
+            simulateShader.uniform("u_dt", dt);
+            simulateShader.uniform("u_gravityDamping", float4(gravity, damping));
+            simulateShader.uniform("u_ground", groundPlane);
+            simulateShader.uniform("u_pointGravity", pointGravity);
+            simulateShader.dispatch((maxParticles + 127) / 128, 1, 1);
+
+            // Append this frame's emissions behind the survivors
+            if (!pendingEmissions.empty())
+            {
+                glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+                glNamedBufferDataEXT(emissionBuffer, pendingEmissions.size() * sizeof(gpu_particle), pendingEmissions.data(), GL_STREAM_DRAW);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, emissionBuffer);
+
+                emitShader.uniform("u_emitCount", static_cast<int>(pendingEmissions.size()));
+                emitShader.uniform("u_maxParticles", static_cast<int>(maxParticles));
+                emitShader.dispatch((static_cast<uint32_t>(pendingEmissions.size()) + 127) / 128, 1, 1);
+
+                pendingEmissions.clear();
+            }
+
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+            srcIndex = dstIndex;
+        }
+
+        // Indirect-draws the live set as instanced billboards; the instance count comes straight
+        // from the compaction cursor so nothing is read back. Mirrors the CPU system's draw.
+        void draw(const float4x4 & viewMat, const float4x4 & projMat, gl_shader & shader, gl_texture_2d & particle_tex, const float time)
+        {
+            if (!computeSupported) return;
+
+            shader.bind();
+
+            const GLboolean wasBlendingEnabled = glIsEnabled(GL_BLEND);
+
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDepthMask(GL_FALSE);
+
+            shader.uniform("u_modelMatrix", Identity4x4);
+            shader.uniform("u_inverseViewMatrix", inverse(viewMat));
+            shader.uniform("u_viewProjMat", projMat * viewMat);
+            shader.uniform("u_time", time);
+            shader.texture("s_particleTex", 0, particle_tex, GL_TEXTURE_2D);
+
+            glBindVertexArray(vao);
+
+            // The live pool doubles as the instance buffer: position/life and velocity/size
+            glBindBuffer(GL_ARRAY_BUFFER, particleBuffers[srcIndex]);
+            glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(gpu_particle), (GLvoid *)offsetof(gpu_particle, position_life));
+            glVertexAttribDivisor(0, 1);
+            glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(gpu_particle), (GLvoid *)offsetof(gpu_particle, velocity_size));
+            glVertexAttribDivisor(1, 1);
+
+            glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(float2), nullptr);
+            glVertexAttribDivisor(2, 0);
+
+            glEnableVertexAttribArray(0);
+            glEnableVertexAttribArray(1);
+            glEnableVertexAttribArray(2);
+
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffers[srcIndex]);
+            glDrawArraysIndirect(GL_TRIANGLES, 0);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+            glDisableVertexAttribArray(0);
+            glDisableVertexAttribArray(1);
+            glDisableVertexAttribArray(2);
+
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindVertexArray(0);
+
+            if (wasBlendingEnabled) glEnable(GL_BLEND);
+            glDepthMask(GL_TRUE);
+
+            shader.unbind();
+
+            gl_check_error(__FILE__, __LINE__);
+        }
+    };
+
+    template<class F> void visit_fields(gpu_particle_system & o, F f)
+    {
+        f("gravity", o.gravity);
+        f("damping", o.damping, range_metadata<float>{ 0.f, 1.f });
+        f("ground_plane", o.groundPlane);
+        f("point_gravity", o.pointGravity);
+    }
+
+} // end namespace polymer
+
+#endif // end polymer_particle_system_hpp
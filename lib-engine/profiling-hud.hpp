@@ -0,0 +1,82 @@
+/*
+ * An imgui overlay that turns the profiler sample rings into an actionable surface:
+ * a rolling histogram per pass id, colored against a frame budget, with fresh
+ * hitches called out next to the plot. Draw it inside an existing imgui frame;
+ * when `visible` is false it costs nothing, so it can stay wired up in production
+ * builds and be toggled at runtime.
+ */
+
+#pragma once
+
+#ifndef polymer_profiling_hud_hpp
+#define polymer_profiling_hud_hpp
+
+#include "profiling.hpp"
+#include "gfx/gl/gl-imgui.hpp"
+
+namespace polymer
+{
+    class profiler_hud
+    {
+        // Draws one profiler's rings under a heading, colored against the budget
+        template<typename T>
+        void draw_section(const char * heading, profiler<T> & p)
+        {
+            ImGui::TextDisabled("%s", heading);
+            for (auto & h : p.get_histories())
+            {
+                if (h.second.empty()) continue;
+
+                const float latest = h.second.back();
+                float peak = 0.f;
+                for (const float s : h.second) peak = std::max(peak, s);
+
+                // Green when the whole ring is under budget, yellow when approaching
+                // it, red once any sample in the window went over
+                ImVec4 color = { 0.33f, 0.83f, 0.41f, 1.f };
+                if (peak > budgetMs) color = { 0.91f, 0.31f, 0.26f, 1.f };
+                else if (peak > budgetMs * 0.75f) color = { 0.95f, 0.77f, 0.22f, 1.f };
+
+                char overlay[64];
+                snprintf(overlay, sizeof(overlay), "%.2f ms", latest);
+
+                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, color);
+                ImGui::PlotHistogram(h.first.c_str(), h.second.data(), static_cast<int>(h.second.size()), 0, overlay, 0.f, budgetMs * 2.f, ImVec2(192, 32));
+                ImGui::PopStyleColor();
+
+                if (latest > budgetMs * hitchScale)
+                {
+                    ImGui::SameLine();
+                    ImGui::TextColored({ 0.91f, 0.31f, 0.26f, 1.f }, "hitch");
+                }
+            }
+        }
+
+    public:
+
+        bool visible{ false };
+        float budgetMs{ 16.66f }; // 60hz - drop to 11.1f when targeting a 90hz hmd
+        float hitchScale{ 1.5f }; // the most recent sample flags a hitch above budgetMs * hitchScale
+
+        // Call between imgui begin_frame/end_frame
+        void draw(const char * title, profiler<gl_gpu_timer> & gpuProfiler, profiler<simple_cpu_timer> & cpuProfiler)
+        {
+            if (!visible) return;
+
+            ImGui::SetNextWindowPos({ 16, 36 }, ImGuiCond_FirstUseEver);
+            ImGui::SetNextWindowBgAlpha(0.75f);
+            if (ImGui::Begin(title, &visible, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNav))
+            {
+                ImGui::SliderFloat("budget (ms)", &budgetMs, 1.f, 33.3f);
+                ImGui::Separator();
+                draw_section("gpu", gpuProfiler);
+                ImGui::Separator();
+                draw_section("cpu", cpuProfiler);
+            }
+            ImGui::End();
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_profiling_hud_hpp
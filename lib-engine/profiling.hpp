@@ -11,11 +11,389 @@
 #define polymer_profiling_hpp
 
 #include "queue-circular.hpp"
+#include "telemetry.hpp"
 #include "gfx/gl/gl-async-gpu-timer.hpp"
 #include "simple_timer.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <fstream>
+#include <type_traits>
+
 namespace polymer
 {
+    ///////////////////////
+    //   trace_capture   //
+    ///////////////////////
+
+    // A process-wide event sink shared by every profiler instance. The rolling averages
+    // in `profiler` are good for steady-state budgets but useless for diagnosing a frame
+    // spike that crosses several systems. trace_capture records raw begin/end events with
+    // timestamps and thread ids over a burst of frames and serializes them as Chrome
+    // trace-event JSON, viewable in chrome://tracing (or any perfetto-compatible ui).
+    // Recording is a single atomic check when inactive, so profilers stay wired up for free.
+
+    class trace_capture
+    {
+        struct trace_event
+        {
+            std::string name;
+            char phase;           // 'B' begin, 'E' end, 'i' instant (frame marker)
+            uint64_t timestamp;   // microseconds
+            size_t threadId;
+        };
+
+        std::vector<trace_event> events;
+        std::mutex eventMutex;
+        std::atomic<bool> active{ false };
+        uint32_t framesRemaining{ 0 };
+
+        uint64_t now_us() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        trace_capture() = default;
+
+    public:
+
+        static trace_capture & get()
+        {
+            static trace_capture instance;
+            return instance;
+        }
+
+        bool is_active() const { return active; }
+
+        void begin(const uint32_t frameCount)
+        {
+            std::lock_guard<std::mutex> guard(eventMutex);
+            events.clear();
+            events.reserve(frameCount * 64);
+            framesRemaining = frameCount;
+            active = true;
+        }
+
+        void record(const char phase, const std::string & name)
+        {
+            if (!active) return;
+            const uint64_t t = now_us();
+            const size_t tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+            std::lock_guard<std::mutex> guard(eventMutex);
+            events.push_back({ name, phase, t, tid });
+        }
+
+        // Call once per frame from the main loop; returns true on the frame the burst
+        // completes, which is the cue to export.
+        bool signal_frame()
+        {
+            if (!active) return false;
+            record('i', "frame");
+            std::lock_guard<std::mutex> guard(eventMutex);
+            if (--framesRemaining == 0) { active = false; return true; }
+            return false;
+        }
+
+        // Writes the captured burst as trace-event JSON and clears the buffer
+        bool export_to_file(const std::string & path)
+        {
+            std::lock_guard<std::mutex> guard(eventMutex);
+
+            std::ofstream file(path, std::ios::trunc);
+            if (!file.good()) return false;
+
+            file << "{\"traceEvents\":[\n";
+            for (size_t i = 0; i < events.size(); ++i)
+            {
+                const trace_event & e = events[i];
+                file << "{\"name\":\"" << e.name << "\",\"cat\":\"polymer\",\"ph\":\"" << e.phase
+                     << "\",\"ts\":" << e.timestamp << ",\"pid\":0,\"tid\":" << (e.threadId & 0xffff)
+                     << (e.phase == 'i' ? ",\"s\":\"t\"" : "") << "}";
+                if (i + 1 < events.size()) file << ",";
+                file << "\n";
+            }
+            file << "]}\n";
+
+            events.clear();
+            return true;
+        }
+    };
+
+    ////////////////////////
+    //   flight_recorder  //
+    ////////////////////////
+
+    // Per-frame counters snapshotted into the flight recorder ring: draw_calls is the
+    // frame's delta of the gl_submission_stats total; gpu_allocations and gpu_bytes are
+    // deltas of the gl_memory_tracker totals (so an upload spike shows on the hitch frame).
+    // The hardware rows are absolute values from hardware_telemetry, so a dump shows
+    // whether a frame-time ramp coincides with falling clocks or a throttle event.
+    enum class flight_counter : uint32_t
+    {
+        draw_calls,
+        gpu_allocations,
+        gpu_bytes,
+        gpu_clock_mhz,
+        gpu_temperature_c,
+        gpu_throttled,
+        cpu_clock_mhz,
+        count
+    };
+
+    // A black-box recorder for hitches that refuse to reproduce under a profiler: keeps
+    // the last kFrameHistory frames of per-system CPU stage timings (fed automatically by
+    // every profiler<simple_cpu_timer>) plus per-frame counters, and dumps the whole
+    // window to a CSV the moment a frame exceeds the hitch threshold. Always-on cost is
+    // one small vector swap and a few atomic exchanges per frame.
+
+    class flight_recorder
+    {
+    public:
+
+        static const size_t kFrameHistory = 300;
+
+    private:
+
+        struct frame_record
+        {
+            uint64_t frameIndex{ 0 };
+            uint64_t timestamp_us{ 0 };
+            double frame_ms{ 0.0 };
+            int64_t counters[static_cast<size_t>(flight_counter::count)]{};
+            std::vector<std::pair<std::string, double>> stages;
+        };
+
+        std::vector<frame_record> ring{ kFrameHistory };
+        std::vector<std::pair<std::string, double>> pendingStages;
+        std::mutex frameMutex;
+
+        std::atomic<bool> enabled{ true };
+        double thresholdMs{ 50.0 };
+        uint64_t frameCounter{ 0 };
+        uint64_t lastFrameTimestamp{ 0 };
+        uint64_t framesSinceDump{ kFrameHistory }; // the first hitch may dump immediately
+        uint64_t lastDrawCalls{ 0 };
+        int64_t lastGpuAllocations{ 0 };
+        int64_t lastGpuBytes{ 0 };
+
+        uint64_t now_us() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        flight_recorder() = default;
+
+    public:
+
+        static flight_recorder & get()
+        {
+            static flight_recorder instance;
+            return instance;
+        }
+
+        void set_enabled(const bool newState) { enabled = newState; }
+        void set_hitch_threshold_ms(const double ms) { thresholdMs = ms; }
+        double get_hitch_threshold_ms() const { return thresholdMs; }
+
+        // Called from profiler<simple_cpu_timer>::end with the raw per-stage sample
+        void record_stage(const std::string & id, const double ms)
+        {
+            if (!enabled) return;
+            std::lock_guard<std::mutex> guard(frameMutex);
+            pendingStages.emplace_back(id, ms);
+        }
+
+        // Call once per frame from the main loop (alongside trace_capture::signal_frame).
+        // Returns the dump path when this frame hitched and a CSV was written, empty otherwise.
+        std::string end_frame()
+        {
+            if (!enabled) return {};
+
+            const uint64_t t = now_us();
+
+            std::lock_guard<std::mutex> guard(frameMutex);
+
+            frame_record & f = ring[frameCounter % kFrameHistory];
+            f.frameIndex = frameCounter;
+            f.timestamp_us = t;
+            f.frame_ms = lastFrameTimestamp ? (t - lastFrameTimestamp) / 1000.0 : 0.0;
+            f.stages = std::move(pendingStages);
+            pendingStages.clear();
+
+            const uint64_t drawCalls = gl_submission_stats::get().total_draw_calls();
+            f.counters[static_cast<size_t>(flight_counter::draw_calls)] = static_cast<int64_t>(drawCalls - lastDrawCalls);
+            lastDrawCalls = drawCalls;
+
+            const int64_t gpuAllocations = gl_memory_tracker::get().get_allocation_count(gl_memory_category::meshes)
+                + gl_memory_tracker::get().get_allocation_count(gl_memory_category::textures)
+                + gl_memory_tracker::get().get_allocation_count(gl_memory_category::render_targets)
+                + gl_memory_tracker::get().get_allocation_count(gl_memory_category::uniform_buffers)
+                + gl_memory_tracker::get().get_allocation_count(gl_memory_category::other);
+            const int64_t gpuBytes = gl_memory_tracker::get().get_total_bytes();
+            f.counters[static_cast<size_t>(flight_counter::gpu_allocations)] = gpuAllocations - lastGpuAllocations;
+            f.counters[static_cast<size_t>(flight_counter::gpu_bytes)] = gpuBytes - lastGpuBytes;
+            lastGpuAllocations = gpuAllocations;
+            lastGpuBytes = gpuBytes;
+
+            // Telemetry rides along with the always-on recorder; start() is idempotent
+            hardware_telemetry::get().start();
+            const hardware_telemetry::sample hw = hardware_telemetry::get().latest();
+            f.counters[static_cast<size_t>(flight_counter::gpu_clock_mhz)] = hw.gpuValid ? int64_t(hw.gpuCoreClockMhz) : -1;
+            f.counters[static_cast<size_t>(flight_counter::gpu_temperature_c)] = hw.gpuValid ? int64_t(hw.gpuTemperatureC) : -1;
+            f.counters[static_cast<size_t>(flight_counter::gpu_throttled)] = hw.gpuValid ? int64_t(hardware_telemetry::is_throttled(hw.gpuThrottleReasons)) : -1;
+            f.counters[static_cast<size_t>(flight_counter::cpu_clock_mhz)] = hw.cpuValid ? int64_t(hw.cpuFrequencyMhz) : -1;
+
+            lastFrameTimestamp = t;
+            frameCounter++;
+            framesSinceDump++;
+
+            // A hitch dumps at most once per ring-length of frames so one bad stretch
+            // does not shred the disk with overlapping windows
+            if (f.frame_ms > thresholdMs && framesSinceDump >= kFrameHistory)
+            {
+                const std::string path = "polymer-hitch-" + std::to_string(f.frameIndex) + ".csv";
+                if (write_history(path))
+                {
+                    framesSinceDump = 0;
+                    return path;
+                }
+            }
+            return {};
+        }
+
+        // Long-format CSV of the recorded window, oldest frame first; the hitch frame is
+        // the final group of rows. Callers may also invoke this manually at any time.
+        bool write_history(const std::string & path)
+        {
+            std::ofstream file(path, std::ios::trunc);
+            if (!file.good()) return false;
+
+            file << "frame,timestamp_us,metric,value\n";
+
+            const uint64_t recorded = frameCounter < kFrameHistory ? frameCounter : kFrameHistory;
+            for (uint64_t i = 0; i < recorded; ++i)
+            {
+                const frame_record & f = ring[(frameCounter - recorded + i) % kFrameHistory];
+                file << f.frameIndex << "," << f.timestamp_us << ",frame_ms," << f.frame_ms << "\n";
+                file << f.frameIndex << "," << f.timestamp_us << ",draw_calls," << f.counters[static_cast<size_t>(flight_counter::draw_calls)] << "\n";
+                file << f.frameIndex << "," << f.timestamp_us << ",gpu_allocations," << f.counters[static_cast<size_t>(flight_counter::gpu_allocations)] << "\n";
+                file << f.frameIndex << "," << f.timestamp_us << ",gpu_bytes," << f.counters[static_cast<size_t>(flight_counter::gpu_bytes)] << "\n";
+                file << f.frameIndex << "," << f.timestamp_us << ",gpu_clock_mhz," << f.counters[static_cast<size_t>(flight_counter::gpu_clock_mhz)] << "\n";
+                file << f.frameIndex << "," << f.timestamp_us << ",gpu_temperature_c," << f.counters[static_cast<size_t>(flight_counter::gpu_temperature_c)] << "\n";
+                file << f.frameIndex << "," << f.timestamp_us << ",gpu_throttled," << f.counters[static_cast<size_t>(flight_counter::gpu_throttled)] << "\n";
+                file << f.frameIndex << "," << f.timestamp_us << ",cpu_clock_mhz," << f.counters[static_cast<size_t>(flight_counter::cpu_clock_mhz)] << "\n";
+                for (const auto & stage : f.stages)
+                {
+                    file << f.frameIndex << "," << f.timestamp_us << "," << stage.first << "," << stage.second << "\n";
+                }
+            }
+            return true;
+        }
+    };
+
+    //////////////////////////
+    //   startup_profiler   //
+    //////////////////////////
+
+    // Phase timing for application boot, where the per-frame profilers above don't
+    // apply. Phases are recorded through scoped spans (nesting renders as
+    // indentation; spans may begin and end on worker threads) and the whole table
+    // is reported once - typically logged on the first frame - so a slow cold
+    // start shows exactly which phase ate the time. Spans also feed trace_capture
+    // when a capture is active.
+    class startup_profiler
+    {
+        struct phase_record
+        {
+            std::string name;
+            uint32_t depth{ 0 };
+            uint64_t begin_us{ 0 };
+            uint64_t end_us{ 0 };
+        };
+
+        std::vector<phase_record> phases;
+        std::mutex phaseMutex;
+        uint64_t origin_us{ 0 };
+        bool reported{ false };
+
+        uint64_t now_us() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        static uint32_t & local_depth()
+        {
+            static thread_local uint32_t depth{ 0 };
+            return depth;
+        }
+
+        startup_profiler() : origin_us(now_us()) {}
+
+    public:
+
+        static startup_profiler & get()
+        {
+            static startup_profiler instance;
+            return instance;
+        }
+
+        size_t begin_phase(const std::string & name)
+        {
+            trace_capture::get().record('B', name);
+            std::lock_guard<std::mutex> guard(phaseMutex);
+            phases.push_back({ name, local_depth()++, now_us(), 0 });
+            return phases.size() - 1;
+        }
+
+        void end_phase(const size_t index)
+        {
+            std::lock_guard<std::mutex> guard(phaseMutex);
+            phases[index].end_us = now_us();
+            --local_depth();
+            trace_capture::get().record('E', phases[index].name);
+        }
+
+        class scoped_phase
+        {
+            startup_profiler * profiler{ nullptr };
+            size_t index{ 0 };
+            scoped_phase(const scoped_phase &) = delete;
+            scoped_phase & operator = (const scoped_phase &) = delete;
+        public:
+            scoped_phase(startup_profiler * p, const size_t i) : profiler(p), index(i) {}
+            scoped_phase(scoped_phase && r) : profiler(r.profiler), index(r.index) { r.profiler = nullptr; }
+            ~scoped_phase() { if (profiler) profiler->end_phase(index); }
+        };
+
+        scoped_phase phase(const std::string & name) { return scoped_phase(this, begin_phase(name)); }
+
+        // Formatted table (chronological, indented by nesting) plus a total line.
+        // Returns lines on the first call only, so the caller can log it from the
+        // first frame without extra bookkeeping.
+        std::vector<std::string> report_once()
+        {
+            std::lock_guard<std::mutex> guard(phaseMutex);
+            if (reported || phases.empty()) return {};
+            reported = true;
+
+            std::vector<std::string> lines;
+            uint64_t latest_us = origin_us;
+            char buffer[320];
+            for (const phase_record & p : phases)
+            {
+                const uint64_t end = p.end_us ? p.end_us : now_us();
+                if (end > latest_us) latest_us = end;
+                const double ms = (end - p.begin_us) / 1000.0;
+                snprintf(buffer, sizeof(buffer), "%8.1f ms  %*s%s", ms, p.depth * 2, "", p.name.c_str());
+                lines.push_back(buffer);
+            }
+            snprintf(buffer, sizeof(buffer), "%8.1f ms  total (launch to first report)", (latest_us - origin_us) / 1000.0);
+            lines.push_back(buffer);
+            return lines;
+        }
+    };
+
     template<typename T>
     class profiler
     {
@@ -37,18 +415,26 @@ namespace polymer
             dataPoints.clear();
         }
 
+        // Note that trace events are recorded at call time, so for a profiler<gl_gpu_timer>
+        // the capture reflects cpu-side submission cost, not the async query result.
         void begin(const std::string & id)
         {
+            trace_capture::get().record('B', id);
             if (!enabled) return;
             dataPoints[id].timer.start();
         }
 
         void end(const std::string & id)
         {
+            trace_capture::get().record('E', id);
             if (!enabled) return;
             dataPoints[id].timer.stop();
             const double t = dataPoints[id].timer.elapsed_ms();
             if (t > 0.0) dataPoints[id].average.put(t);
+
+            // CPU stage samples also feed the hitch flight recorder; gpu timers are
+            // excluded since their queries resolve asynchronously, frames later
+            if (std::is_same<T, simple_cpu_timer>::value && t > 0.0) flight_recorder::get().record_stage(id, t);
         }
 
         std::vector<std::pair<std::string, float>> get_data()
@@ -60,6 +446,19 @@ namespace polymer
             }
             return data;
         }
+
+        // The raw sample rings behind get_data(), oldest sample first (for plotting)
+        std::vector<std::pair<std::string, std::vector<float>>> get_histories()
+        {
+            std::vector<std::pair<std::string, std::vector<float>>> data;
+            for (auto & d : dataPoints)
+            {
+                std::vector<float> samples(d.second.average.get_current_size());
+                for (size_t i = 0; i < samples.size(); ++i) samples[i] = static_cast<float>(d.second.average[i]);
+                data.emplace_back(d.first, std::move(samples));
+            }
+            return data;
+        }
     };
 
 } // end namespace polymer
@@ -0,0 +1,164 @@
+#pragma once
+
+#ifndef polymer_renderer_brdf_hpp
+#define polymer_renderer_brdf_hpp
+
+#include "math-core.hpp"
+#include "gl-api.hpp"
+
+#include <fstream>
+#include <vector>
+
+namespace polymer
+{
+    ////////////////////////
+    //   brdf_lut_baker   //
+    ////////////////////////
+
+    // Integrates the split-sum environment BRDF (Karis, "Real Shading in Unreal Engine 4")
+    // into a 2d lookup table indexed by (NdotV, roughness), each texel holding the scale and
+    // bias applied to specular color. The integral is identical on every run, so the table is
+    // persisted next to the other baked assets and subsequent starts load bytes; the CPU
+    // Monte-Carlo integration only runs when the cache is missing or stale.
+
+    class brdf_lut_baker
+    {
+        static const uint32_t cache_magic = 0x424c5431; // 'BLT1'
+
+        static float radical_inverse_vdc(uint32_t bits)
+        {
+            bits = (bits << 16u) | (bits >> 16u);
+            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+            return static_cast<float>(bits) * 2.3283064365386963e-10f;
+        }
+
+        static float3 importance_sample_ggx(const float2 xi, const float roughness, const float3 N)
+        {
+            const float a = roughness * roughness;
+            const float phi = 2.f * float(POLYMER_PI) * xi.x;
+            const float cosTheta = std::sqrt((1.f - xi.y) / (1.f + (a * a - 1.f) * xi.y));
+            const float sinTheta = std::sqrt(1.f - cosTheta * cosTheta);
+            const float3 H = { sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta };
+            const float3 up = std::abs(N.z) < 0.999f ? float3(0, 0, 1) : float3(1, 0, 0);
+            const float3 tangentX = normalize(cross(up, N));
+            const float3 tangentY = cross(N, tangentX);
+            return tangentX * H.x + tangentY * H.y + N * H.z;
+        }
+
+        // Schlick-GGX geometry term with the k remapping for image-based lighting
+        static float geometry_smith_ibl(const float NdotV, const float NdotL, const float roughness)
+        {
+            const float a = roughness * roughness;
+            const float k = a / 2.f;
+            const float gv = NdotV / (NdotV * (1.f - k) + k);
+            const float gl = NdotL / (NdotL * (1.f - k) + k);
+            return gv * gl;
+        }
+
+    public:
+
+        int lutSize{ 256 };
+        int sampleCount{ 1024 };
+
+        // Monte-Carlo integration of the split-sum terms; returns lutSize * lutSize RG pairs
+        // with NdotV along x and roughness along y.
+        std::vector<float> integrate() const
+        {
+            std::vector<float> texels(lutSize * lutSize * 2);
+            const float3 N = { 0, 0, 1 };
+
+            for (int y = 0; y < lutSize; ++y)
+            {
+                const float roughness = (y + 0.5f) / static_cast<float>(lutSize);
+                for (int x = 0; x < lutSize; ++x)
+                {
+                    const float NdotV = (x + 0.5f) / static_cast<float>(lutSize);
+                    const float3 V = { std::sqrt(1.f - NdotV * NdotV), 0.f, NdotV };
+
+                    float A = 0.f, B = 0.f;
+                    for (int i = 0; i < sampleCount; ++i)
+                    {
+                        const float2 xi = { i / static_cast<float>(sampleCount), radical_inverse_vdc(static_cast<uint32_t>(i)) };
+                        const float3 H = importance_sample_ggx(xi, roughness, N);
+                        const float3 L = 2.f * dot(V, H) * H - V;
+
+                        const float NdotL = linalg::max(L.z, 0.f);
+                        const float NdotH = linalg::max(H.z, 0.f);
+                        const float VdotH = linalg::max(dot(V, H), 0.f);
+                        if (NdotL <= 0.f) continue;
+
+                        const float G = geometry_smith_ibl(NdotV, NdotL, roughness);
+                        const float G_vis = (G * VdotH) / (NdotH * NdotV + 1e-5f);
+                        const float Fc = std::pow(1.f - VdotH, 5.f);
+                        A += (1.f - Fc) * G_vis;
+                        B += Fc * G_vis;
+                    }
+
+                    texels[(y * lutSize + x) * 2 + 0] = A / static_cast<float>(sampleCount);
+                    texels[(y * lutSize + x) * 2 + 1] = B / static_cast<float>(sampleCount);
+                }
+            }
+            return texels;
+        }
+
+        gl_texture_2d upload(const std::vector<float> & texels) const
+        {
+            gl_texture_2d lut;
+            glTextureImage2DEXT(lut, GL_TEXTURE_2D, 0, GL_RG16F, lutSize, lutSize, 0, GL_RG, GL_FLOAT, texels.data());
+            glTextureParameteriEXT(lut, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(lut, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(lut, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(lut, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            return lut;
+        }
+
+        // Raw dump: small header, then lutSize^2 RG float pairs
+        void store_cached(const std::string & path, const std::vector<float> & texels) const
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file.is_open()) return;
+            const uint32_t header[2] = { cache_magic, static_cast<uint32_t>(lutSize) };
+            file.write(reinterpret_cast<const char *>(header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(texels.data()), texels.size() * sizeof(float));
+        }
+
+        // Returns false (leaving `texels` untouched) when the cache is missing, truncated,
+        // or was written with a different table size.
+        bool load_cached(const std::string & path, std::vector<float> & texels) const
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) return false;
+
+            uint32_t header[2] = { 0, 0 };
+            file.read(reinterpret_cast<char *>(header), sizeof(header));
+            if (file.gcount() != sizeof(header)) return false;
+            if (header[0] != cache_magic || header[1] != static_cast<uint32_t>(lutSize)) return false;
+
+            std::vector<float> loaded(lutSize * lutSize * 2);
+            file.read(reinterpret_cast<char *>(loaded.data()), loaded.size() * sizeof(float));
+            if (file.gcount() != static_cast<std::streamsize>(loaded.size() * sizeof(float))) return false;
+
+            texels = std::move(loaded);
+            return true;
+        }
+
+        // Load-else-bake convenience: a cache hit costs a 512kb read; a miss runs the
+        // integration once and writes the cache for every subsequent start.
+        gl_texture_2d get_or_bake(const std::string & cache_path)
+        {
+            std::vector<float> texels;
+            if (!load_cached(cache_path, texels))
+            {
+                texels = integrate();
+                store_cached(cache_path, texels);
+            }
+            return upload(texels);
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_renderer_brdf_hpp
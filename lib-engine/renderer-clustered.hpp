@@ -0,0 +1,148 @@
+#pragma once
+
+#ifndef polymer_renderer_clustered_hpp
+#define polymer_renderer_clustered_hpp
+
+#include "math-core.hpp"
+#include "memory-arena.hpp"
+#include "gl-api.hpp"
+#include "environment.hpp"
+
+namespace polymer
+{
+    ////////////////////////////
+    //   cluster_light_grid   //
+    ////////////////////////////
+
+    // CPU froxel binning for clustered forward shading. The view frustum is divided into a
+    // 16x8x24 grid (exponential depth slices); every enabled point light is tested against the
+    // froxels its bounding sphere overlaps and three SSBOs are uploaded per view: packed light
+    // data, a per-froxel (offset, count) table, and the flattened light index list. Fragment
+    // shaders compiled with USE_CLUSTERED_SHADING walk only the lights touching their froxel,
+    // lifting the uniforms.hpp MAX_POINT_LIGHTS cap.
+    class cluster_light_grid
+    {
+    public:
+
+        static const int GRID_X = 16;
+        static const int GRID_Y = 8;
+        static const int GRID_Z = 24;
+        static const int NUM_CLUSTERS = GRID_X * GRID_Y * GRID_Z;
+        static const int MAX_CLUSTERED_LIGHTS = 1024;
+
+        static const int LIGHT_DATA_BINDING = 3;
+        static const int CLUSTER_TABLE_BINDING = 4;
+        static const int LIGHT_INDEX_BINDING = 5;
+
+    private:
+
+        gl_buffer lightDataBuffer;    // 2 x float4 per light: [color.rgb, radius], [position.xyz, 0]
+        gl_buffer clusterTableBuffer; // uint2 (offset, count) per froxel
+        gl_buffer indexListBuffer;    // flattened light indices
+
+        std::vector<float4> lightData;
+        std::vector<uint2> clusterTable;
+        std::vector<std::vector<uint32_t>> clusterScratch;
+        std::vector<uint32_t> indexList;
+
+    public:
+
+        cluster_light_grid()
+        {
+            clusterTable.resize(NUM_CLUSTERS);
+            clusterScratch.resize(NUM_CLUSTERS);
+        }
+
+        // `LightList` is any range of point_light_component pointers (the payload's
+        // small_vector, a std::vector, etc.)
+        template<typename LightList>
+        void update(const LightList & lights,
+            const float4x4 & viewMatrix, const float4x4 & projectionMatrix,
+            const float nearClip, const float farClip)
+        {
+            lightData.clear();
+            indexList.clear();
+            for (auto & cluster : clusterScratch) cluster.clear();
+
+            const float logScale = static_cast<float>(GRID_Z) / std::log(farClip / nearClip);
+
+            uint32_t lightIdx = 0;
+            for (const point_light_component * light : lights)
+            {
+                if (!light->enabled) continue;
+                if (lightIdx >= MAX_CLUSTERED_LIGHTS) break;
+
+                const float3 & p = light->data.position;
+                const float radius = light->data.radius;
+
+                lightData.push_back(float4(light->data.color, radius));
+                lightData.push_back(float4(p, 0.f));
+
+                // View-space sphere
+                const float3 centerVs = transform_coord(viewMatrix, p);
+                const float nearZ = std::max(-centerVs.z - radius, nearClip);
+                const float farZ = std::min(-centerVs.z + radius, farClip);
+
+                if (farZ <= nearClip || nearZ >= farClip) { lightIdx++; continue; }
+
+                const int sliceMin = clamp(static_cast<int>(std::log(nearZ / nearClip) * logScale), 0, GRID_Z - 1);
+                const int sliceMax = clamp(static_cast<int>(std::log(farZ / nearClip) * logScale), 0, GRID_Z - 1);
+
+                // Conservative screen rect from the projected view-space box of the sphere
+                int xMin = 0, xMax = GRID_X - 1, yMin = 0, yMax = GRID_Y - 1;
+                if (-centerVs.z - radius > nearClip)
+                {
+                    float2 ndcLo{ 1.f, 1.f }, ndcHi{ -1.f, -1.f };
+                    for (int c = 0; c < 8; ++c)
+                    {
+                        const float3 corner = centerVs + radius * float3((c & 1) ? 1.f : -1.f, (c & 2) ? 1.f : -1.f, (c & 4) ? 1.f : -1.f);
+                        const float4 clip = projectionMatrix * float4(corner, 1.f);
+                        const float2 ndc = clip.xy / std::max(static_cast<float>(clip.w), 1e-5f);
+                        ndcLo = min(ndcLo, ndc);
+                        ndcHi = max(ndcHi, ndc);
+                    }
+                    xMin = clamp(static_cast<int>((ndcLo.x * 0.5f + 0.5f) * GRID_X), 0, GRID_X - 1);
+                    xMax = clamp(static_cast<int>((ndcHi.x * 0.5f + 0.5f) * GRID_X), 0, GRID_X - 1);
+                    yMin = clamp(static_cast<int>((ndcLo.y * 0.5f + 0.5f) * GRID_Y), 0, GRID_Y - 1);
+                    yMax = clamp(static_cast<int>((ndcHi.y * 0.5f + 0.5f) * GRID_Y), 0, GRID_Y - 1);
+                }
+
+                for (int z = sliceMin; z <= sliceMax; ++z)
+                {
+                    for (int y = yMin; y <= yMax; ++y)
+                    {
+                        for (int x = xMin; x <= xMax; ++x)
+                        {
+                            clusterScratch[(z * GRID_Y + y) * GRID_X + x].push_back(lightIdx);
+                        }
+                    }
+                }
+
+                lightIdx++;
+            }
+
+            // Flatten
+            for (int c = 0; c < NUM_CLUSTERS; ++c)
+            {
+                clusterTable[c] = uint2(static_cast<uint32_t>(indexList.size()), static_cast<uint32_t>(clusterScratch[c].size()));
+                indexList.insert(indexList.end(), clusterScratch[c].begin(), clusterScratch[c].end());
+            }
+
+            if (indexList.empty()) indexList.push_back(0); // keep the buffer valid when no lights are binned
+
+            lightDataBuffer.set_buffer_data(sizeof(float4) * std::max<size_t>(lightData.size(), 2), lightData.empty() ? nullptr : lightData.data(), GL_STREAM_DRAW);
+            clusterTableBuffer.set_buffer_data(sizeof(uint2) * clusterTable.size(), clusterTable.data(), GL_STREAM_DRAW);
+            indexListBuffer.set_buffer_data(sizeof(uint32_t) * indexList.size(), indexList.data(), GL_STREAM_DRAW);
+        }
+
+        void bind() const
+        {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_DATA_BINDING, lightDataBuffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CLUSTER_TABLE_BINDING, clusterTableBuffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_INDEX_BINDING, indexListBuffer);
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_renderer_clustered_hpp
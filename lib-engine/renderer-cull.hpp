@@ -0,0 +1,131 @@
+#pragma once
+
+#ifndef polymer_renderer_cull_hpp
+#define polymer_renderer_cull_hpp
+
+#include "math-core.hpp"
+#include "gl-api.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace polymer
+{
+    ////////////////////////////
+    //   gpu_frustum_culler   //
+    ////////////////////////////
+
+    // Frustum culls an instanced batch on the GPU. The renderer uploads every instance's world
+    // bounding sphere and model matrix once, a compute pass tests each sphere against the six
+    // view planes and stream-compacts surviving matrices with an atomic counter written straight
+    // into the instanceCount of an indirect draw command. The CPU never walks the instance list
+    // or learns the visible count - at 100k instances that walk alone costs several milliseconds.
+
+    static const char * frustum_cull_compute_source = R"(#version 450
+        layout(local_size_x = 128) in;
+        struct cull_instance { vec4 sphere; mat4 modelMatrix; };
+        layout(std430, binding = 0) readonly buffer Instances { cull_instance instances[]; };
+        layout(std430, binding = 1) writeonly buffer VisibleMatrices { mat4 visible[]; };
+        layout(std430, binding = 2) buffer DrawCommand { uint indexCount; uint instanceCount; uint firstIndex; uint baseVertex; uint baseInstance; };
+        uniform vec4 u_planes[6]; // inward-facing, normalized
+        uniform int u_instanceCount;
+        uniform int u_eyeCount;   // stereo duplicates each instance per eye via the attribute divisor
+        void main()
+        {
+            uint i = gl_GlobalInvocationID.x;
+            if (i >= uint(u_instanceCount)) return;
+
+            vec4 sphere = instances[i].sphere;
+            if (sphere.w > 0.0) // zero radius means unknown bounds: never culled
+            {
+                for (int p = 0; p < 6; ++p)
+                {
+                    if (dot(u_planes[p].xyz, sphere.xyz) + u_planes[p].w < -sphere.w) return;
+                }
+            }
+
+            uint slot = atomicAdd(instanceCount, uint(u_eyeCount)) / uint(u_eyeCount);
+            visible[slot] = instances[i].modelMatrix;
+        })";
+
+    class gpu_frustum_culler
+    {
+        // Matches the std430 struct in the kernel: xyz world center / w radius, then the matrix
+        struct cull_instance
+        {
+            float4 sphere;
+            float4x4 modelMatrix;
+        };
+
+        gl_shader_compute cullShader{ frustum_cull_compute_source };
+
+        gl_buffer instanceBuffer;          // per-batch upload of spheres + matrices
+        gl_buffer visibleMatrixBuffer;     // compacted output, sourced as the instance attribute stream
+        gl_indirect_buffer commandBuffer;  // instanceCount is the compaction cursor
+
+        std::vector<cull_instance> staging;
+        size_t visibleCapacity{ 0 };
+        bool computeSupported{ false };
+
+    public:
+
+        gpu_frustum_culler()
+        {
+            std::vector<std::pair<std::string, bool>> requiredExtensions = { { "GL_ARB_compute_shader", false } };
+            has_gl_extension(requiredExtensions);
+            computeSupported = requiredExtensions[0].second;
+        }
+
+        bool is_supported() const { return computeSupported; }
+
+        // Cull one batch. On return the command buffer holds a ready-to-submit indirect draw for
+        // `indexCount` indices and the visible matrix buffer holds the compacted model matrices;
+        // bind it as the instance attribute stream and submit without reading anything back.
+        void dispatch(const std::vector<float4> & spheres, const std::vector<float4x4> & matrices, const frustum & f, const uint32_t indexCount, const uint32_t eyeCount)
+        {
+            const size_t count = matrices.size();
+            assert(spheres.size() == count);
+
+            staging.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                staging[i].sphere = spheres[i];
+                staging[i].modelMatrix = matrices[i];
+            }
+            glNamedBufferDataEXT(instanceBuffer, count * sizeof(cull_instance), staging.data(), GL_STREAM_DRAW);
+
+            // The output only grows; re-allocating per batch would defeat the point
+            if (count > visibleCapacity)
+            {
+                visibleCapacity = count;
+                glNamedBufferDataEXT(visibleMatrixBuffer, visibleCapacity * sizeof(float4x4), nullptr, GL_DYNAMIC_COPY);
+            }
+
+            draw_elements_indirect_command cmd;
+            cmd.count = indexCount;
+            commandBuffer.set_commands({ cmd }, GL_STREAM_DRAW);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instanceBuffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, visibleMatrixBuffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commandBuffer);
+
+            for (int p = 0; p < 6; ++p)
+            {
+                char name[16];
+                std::snprintf(name, sizeof(name), "u_planes[%d]", p);
+                cullShader.uniform(name, f.planes[p].equation);
+            }
+            cullShader.uniform("u_instanceCount", static_cast<int>(count));
+            cullShader.uniform("u_eyeCount", static_cast<int>(eyeCount));
+            cullShader.dispatch((static_cast<uint32_t>(count) + 127) / 128, 1, 1);
+
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+        }
+
+        GLuint get_visible_matrices() const { return visibleMatrixBuffer; }
+        const gl_indirect_buffer & get_commands() const { return commandBuffer; }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_renderer_cull_hpp
@@ -9,45 +9,82 @@
 
 namespace polymer
 {
+    // A frame-scoped accumulator for debug primitives. Everything appended between clear()
+    // and draw() lands in one persistently-mapped vertex ring (GL_ARB_buffer_storage) and
+    // is rendered with a single glDrawArrays per primitive type, so thousands of lines
+    // (e.g. bullet debug visualization) cost two draw calls instead of thousands. Falls
+    // back to a stream-draw upload when persistent mapping is unavailable.
     class renderer_debug
     {
         struct Vertex { float3 position; float3 color; };
-        std::vector<Vertex> vertices;
 
-        gl_mesh payload;
+        std::vector<Vertex> lines;      // GL_LINES, appended in pairs
+        std::vector<Vertex> points;     // GL_POINTS
+        std::vector<Vertex> scratch;    // per-frame staging so the ring sees one contiguous write
+
+        gl_mesh payload;                // legacy stream-draw fallback
         gl_shader shader;
 
-        constexpr static const char debugVertexShader[] = R"(#version 330 
-            layout(location = 0) in vec3 v; 
-            layout(location = 1) in vec3 c; 
-            uniform mat4 u_mvp; 
-            out vec3 color; 
+        gl_mapped_ring_buffer streamBuffer;
+        gl_vertex_array_object streamVao;
+        bool persistentMappingSupported{ false };
+
+        static const GLsizeiptr maxStreamVertices = 1 << 18; // per section; ~6mb each, triple buffered
+
+        constexpr static const char debugVertexShader[] = R"(#version 330
+            layout(location = 0) in vec3 v;
+            layout(location = 1) in vec3 c;
+            uniform mat4 u_mvp;
+            out vec3 color;
             void main() { gl_Position = u_mvp * vec4(v.xyz, 1); color = c; }
         )";
 
-        constexpr static const char debugFragmentShader[] = R"(#version 330 
-            in vec3 color; 
-            out vec4 f_color; 
+        constexpr static const char debugFragmentShader[] = R"(#version 330
+            in vec3 color;
+            out vec4 f_color;
             void main() { f_color = vec4(color.rgb, 1); }
         )";
 
     public:
 
-        renderer_debug() { shader = gl_shader(debugVertexShader, debugFragmentShader); }
+        renderer_debug()
+        {
+            shader = gl_shader(debugVertexShader, debugFragmentShader);
+
+            std::vector<std::pair<std::string, bool>> requiredExtensions = { { "GL_ARB_buffer_storage", false } };
+            has_gl_extension(requiredExtensions);
+            persistentMappingSupported = requiredExtensions[0].second;
+
+            if (persistentMappingSupported)
+            {
+                // Section size is a multiple of sizeof(Vertex), so section starts land on
+                // whole-vertex boundaries and glDrawArrays can address them with a first index.
+                streamBuffer.setup(maxStreamVertices * sizeof(Vertex));
+                glEnableVertexArrayAttribEXT(streamVao, 0);
+                glVertexArrayVertexAttribOffsetEXT(streamVao, streamBuffer, 0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLintptr) offsetof(Vertex, position));
+                glEnableVertexArrayAttribEXT(streamVao, 1);
+                glVertexArrayVertexAttribOffsetEXT(streamVao, streamBuffer, 1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLintptr) offsetof(Vertex, color));
+            }
+        }
 
-        void clear() { vertices.clear(); }
+        void clear() { lines.clear(); points.clear(); }
 
         // World-space
         void draw_line(const float3 & from, const float3 & to, const float3 color = float3(1, 1, 1))
         {
-            vertices.push_back({ from, color });
-            vertices.push_back({ to, color });
+            lines.push_back({ from, color });
+            lines.push_back({ to, color });
         }
 
         void draw_line(const transform & pose, const float3 & from, const float3 & to, const float3 color = float3(1, 1, 1))
         {
-            vertices.push_back({ pose.transform_coord(from), color });
-            vertices.push_back({ pose.transform_coord(to), color });
+            lines.push_back({ pose.transform_coord(from), color });
+            lines.push_back({ pose.transform_coord(to), color });
+        }
+
+        void draw_point(const float3 & position, const float3 color = float3(1, 1, 1))
+        {
+            points.push_back({ position, color });
         }
 
         void draw_box(const transform & pose, const aabb_3d & local_bounds, const float3 color = float3(1, 1, 1))
@@ -58,7 +95,7 @@ namespace polymer
             {
                 v *= local_bounds.size() / 2.f; // scale
                 auto tV = pose.transform_coord(v); // translate
-                vertices.push_back({ tV, color });
+                lines.push_back({ tV, color });
             }
         }
 
@@ -70,7 +107,7 @@ namespace polymer
             {
                 v *= radius;
                 auto tV = pose.transform_coord(v);
-                vertices.push_back({ tV, color });
+                lines.push_back({ tV, color });
             }
         }
 
@@ -82,20 +119,59 @@ namespace polymer
             {
                 auto v = axis.vertices[i];
                 v = pose.transform_coord(v);
-                vertices.push_back({ v, axis.colors[i].xyz });
+                lines.push_back({ v, axis.colors[i].xyz });
             }
         }
 
         void draw(const float4x4 & viewProjectionMatrix)
         {
-            payload.set_vertices(vertices.size(), vertices.data(), GL_STREAM_DRAW);
-            payload.set_attribute(0, &Vertex::position);
-            payload.set_attribute(1, &Vertex::color);
-            payload.set_non_indexed(GL_LINES);
+            if (lines.empty() && points.empty()) return;
 
             shader.bind();
             shader.uniform("u_mvp", viewProjectionMatrix * Identity4x4);
-            payload.draw_elements();
+
+            if (persistentMappingSupported)
+            {
+                // One contiguous write into the current ring section, then one draw per type
+                scratch.clear();
+                scratch.insert(scratch.end(), lines.begin(), lines.end());
+                scratch.insert(scratch.end(), points.begin(), points.end());
+                if (scratch.size() > maxStreamVertices) scratch.resize(maxStreamVertices);
+
+                streamBuffer.begin_frame();
+                const GLintptr offset = streamBuffer.write(scratch.data(), scratch.size() * sizeof(Vertex));
+                const GLint baseVertex = static_cast<GLint>(offset / sizeof(Vertex));
+
+                const GLsizei lineCount = static_cast<GLsizei>(std::min(lines.size(), scratch.size()));
+                const GLsizei pointCount = static_cast<GLsizei>(scratch.size()) - lineCount;
+
+                glBindVertexArray(streamVao);
+                if (lineCount) glDrawArrays(GL_LINES, baseVertex, lineCount);
+                if (pointCount) glDrawArrays(GL_POINTS, baseVertex + lineCount, pointCount);
+                glBindVertexArray(0);
+                streamBuffer.end_frame();
+            }
+            else
+            {
+                if (!lines.empty())
+                {
+                    payload.set_vertices(lines.size(), lines.data(), GL_STREAM_DRAW);
+                    payload.set_attribute(0, &Vertex::position);
+                    payload.set_attribute(1, &Vertex::color);
+                    payload.set_non_indexed(GL_LINES);
+                    payload.draw_elements();
+                }
+
+                if (!points.empty())
+                {
+                    payload.set_vertices(points.size(), points.data(), GL_STREAM_DRAW);
+                    payload.set_attribute(0, &Vertex::position);
+                    payload.set_attribute(1, &Vertex::color);
+                    payload.set_non_indexed(GL_POINTS);
+                    payload.draw_elements();
+                }
+            }
+
             shader.unbind();
         }
 
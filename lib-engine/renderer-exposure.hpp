@@ -0,0 +1,139 @@
+#pragma once
+
+#ifndef polymer_renderer_exposure_hpp
+#define polymer_renderer_exposure_hpp
+
+#include "math-core.hpp"
+#include "gl-api.hpp"
+
+namespace polymer
+{
+    ///////////////////////
+    //   auto_exposure   //
+    ///////////////////////
+
+    // Measures scene luminance with a two-stage compute reduction over the resolved HDR
+    // target - a 256-bin log-luminance histogram, then a single-workgroup weighted average
+    // with temporal adaptation - and writes the resulting exposure into a small SSBO the
+    // tonemap shader reads directly. Everything stays on the GPU, so unlike a readback
+    // implementation this never stalls the pipeline.
+
+    static const char * exposure_histogram_compute_source = R"(#version 450
+        layout(local_size_x = 16, local_size_y = 16) in;
+        layout(std430, binding = 0) buffer Histogram { uint u_bins[256]; };
+        layout(binding = 0) uniform sampler2D s_hdr;
+        uniform vec2 u_logRange;  // x = min log2 luminance, y = 1 / log2 range
+        uniform vec2 u_inputSize;
+        shared uint local_bins[256];
+        void main()
+        {
+            local_bins[gl_LocalInvocationIndex] = 0u;
+            barrier();
+            ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+            if (coord.x < int(u_inputSize.x) && coord.y < int(u_inputSize.y))
+            {
+                vec3 c = texelFetch(s_hdr, coord, 0).rgb;
+                float lum = dot(c, vec3(0.2126, 0.7152, 0.0722));
+                uint bin = 0u; // bin 0 collects pixels too dark to meter
+                if (lum > 0.0001)
+                {
+                    float t = clamp((log2(lum) - u_logRange.x) * u_logRange.y, 0.0, 1.0);
+                    bin = uint(t * 254.0 + 1.0);
+                }
+                atomicAdd(local_bins[bin], 1u);
+            }
+            barrier();
+            atomicAdd(u_bins[gl_LocalInvocationIndex], local_bins[gl_LocalInvocationIndex]);
+        })";
+
+    static const char * exposure_adapt_compute_source = R"(#version 450
+        layout(local_size_x = 256) in;
+        layout(std430, binding = 0) buffer Histogram { uint u_bins[256]; };
+        layout(std430, binding = 1) buffer ExposureData { float exposure; float adaptedLuminance; };
+        uniform vec4 u_params; // x = min log2 luminance, y = log2 range, z = adaptation blend for this frame, w = total pixels
+        uniform float u_exposureKey;
+        shared uint local_bins[256];
+        void main()
+        {
+            uint count = u_bins[gl_LocalInvocationIndex];
+            local_bins[gl_LocalInvocationIndex] = count * gl_LocalInvocationIndex;
+            u_bins[gl_LocalInvocationIndex] = 0u; // zeroed in place, ready for next frame
+            barrier();
+            for (uint cutoff = 128u; cutoff > 0u; cutoff >>= 1u)
+            {
+                if (gl_LocalInvocationIndex < cutoff) local_bins[gl_LocalInvocationIndex] += local_bins[gl_LocalInvocationIndex + cutoff];
+                barrier();
+            }
+            if (gl_LocalInvocationIndex == 0u)
+            {
+                float blackPixels = float(count); // thread 0's count is bin 0
+                float weightedAverage = (float(local_bins[0]) / max(u_params.w - blackPixels, 1.0)) - 1.0;
+                float averageLuminance = exp2(((weightedAverage / 254.0) * u_params.y) + u_params.x);
+                float adapted = adaptedLuminance + (averageLuminance - adaptedLuminance) * u_params.z;
+                adaptedLuminance = adapted;
+                exposure = u_exposureKey / max(adapted, 0.0001);
+            }
+        })";
+
+    class auto_exposure
+    {
+        gl_shader_compute histogramShader{ exposure_histogram_compute_source };
+        gl_shader_compute adaptShader{ exposure_adapt_compute_source };
+
+        gl_buffer histogramBuffer;  // 256 uints
+        gl_buffer exposureBuffer;   // { float exposure, float adaptedLuminance }
+
+    public:
+
+        static const GLuint exposure_binding = 7; // matches the tonemap shader's ExposureData block
+
+        float minLogLuminance{ -8.f };
+        float logLuminanceRange{ 12.f };
+        float adaptationSpeed{ 1.1f };  // 1/seconds; higher adapts faster
+        float exposureKey{ 0.18f };     // middle grey target
+
+        auto_exposure()
+        {
+            const std::vector<uint32_t> zeroBins(256, 0);
+            histogramBuffer.set_buffer_data(zeroBins.size() * sizeof(uint32_t), zeroBins.data(), GL_DYNAMIC_COPY);
+
+            const float initial[2] = { 1.f, exposureKey }; // identity exposure until the first measurement lands
+            exposureBuffer.set_buffer_data(sizeof(initial), initial, GL_DYNAMIC_COPY);
+        }
+
+        // Measure `hdrColor` (extent `size`) and fold the result into the adapted exposure.
+        // `dt` is the frame delta in seconds, used for framerate-independent adaptation.
+        void dispatch(const GLuint hdrColor, const int2 & size, const float dt)
+        {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, histogramBuffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, exposureBuffer);
+
+            histogramShader.uniform("u_logRange", float2(minLogLuminance, 1.f / logLuminanceRange));
+            histogramShader.uniform("u_inputSize", float2(size));
+            histogramShader.texture(histogramShader.get_uniform_location("s_hdr"), GL_TEXTURE_2D, 0, hdrColor);
+            histogramShader.dispatch((size.x + 15) / 16, (size.y + 15) / 16, 1);
+
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+            const float blend = 1.f - std::exp(-dt * adaptationSpeed);
+            adaptShader.uniform("u_params", float4(minLogLuminance, logLuminanceRange, clamp(blend, 0.f, 1.f), static_cast<float>(size.x * size.y)));
+            adaptShader.uniform("u_exposureKey", exposureKey);
+            adaptShader.dispatch(1, 1, 1);
+
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        }
+
+        // Expose the measured exposure to the tonemap shader
+        void bind() const { glBindBufferBase(GL_SHADER_STORAGE_BUFFER, exposure_binding, exposureBuffer); }
+    };
+
+    template<class F> void visit_fields(auto_exposure & o, F f)
+    {
+        f("min_log_luminance", o.minLogLuminance, range_metadata<float>{ -16.f, 0.f });
+        f("log_luminance_range", o.logLuminanceRange, range_metadata<float>{ 1.f, 24.f });
+        f("adaptation_speed", o.adaptationSpeed, range_metadata<float>{ 0.1f, 10.f });
+        f("exposure_key", o.exposureKey, range_metadata<float>{ 0.01f, 1.f });
+    }
+}
+
+#endif // end polymer_renderer_exposure_hpp
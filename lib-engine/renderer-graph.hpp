@@ -0,0 +1,139 @@
+#pragma once
+
+#ifndef polymer_renderer_graph_hpp
+#define polymer_renderer_graph_hpp
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_set>
+#include <cassert>
+
+namespace polymer
+{
+    //////////////////////
+    //   render_graph   //
+    //////////////////////
+
+    // A lightweight declarative pass list, rebuilt every frame. Passes declare the logical
+    // resources they read and write; compile() orders them so every read follows the writes
+    // of that resource, and culls passes that contribute nothing (transitively) to a marked
+    // output. Disabled or culled passes never execute, so they cost nothing - not even
+    // render target setup.
+
+    struct render_graph_pass
+    {
+        std::string name;
+        std::vector<std::string> reads;
+        std::vector<std::string> writes;
+        std::function<void()> execute;
+        bool enabled{ true };
+    };
+
+    class render_graph
+    {
+        std::vector<render_graph_pass> passes;
+        std::vector<size_t> schedule;
+        std::unordered_set<std::string> outputs;
+
+        static bool lists_intersect(const std::vector<std::string> & a, const std::vector<std::string> & b)
+        {
+            for (const std::string & x : a) for (const std::string & y : b) if (x == y) return true;
+            return false;
+        }
+
+    public:
+
+        void reset()
+        {
+            passes.clear();
+            schedule.clear();
+            outputs.clear();
+        }
+
+        void add_pass(render_graph_pass && pass) { passes.push_back(std::move(pass)); }
+
+        // Resources named here anchor the liveness walk (typically the per-eye color targets)
+        void mark_output(const std::string & resource) { outputs.insert(resource); }
+
+        void compile()
+        {
+            schedule.clear();
+            const size_t n = passes.size();
+
+            // Liveness, back to front: a pass survives if something demands one of its writes;
+            // its reads then become demanded in turn. Passes with no writes are treated as
+            // side-effect-only and always survive.
+            std::unordered_set<std::string> demanded = outputs;
+            std::vector<bool> alive(n, false);
+            for (size_t i = n; i-- > 0;)
+            {
+                const render_graph_pass & p = passes[i];
+                if (!p.enabled) continue;
+                bool needed = p.writes.empty();
+                for (const std::string & w : p.writes) if (demanded.count(w)) { needed = true; break; }
+                if (!needed) continue;
+                alive[i] = true;
+                for (const std::string & r : p.reads) demanded.insert(r);
+            }
+
+            // Dependency edges between surviving passes: read-after-write, write-after-write,
+            // and write-after-read, all directed along submission order.
+            std::vector<std::vector<size_t>> successors(n);
+            std::vector<uint32_t> indegree(n, 0);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (!alive[i]) continue;
+                for (size_t j = i + 1; j < n; ++j)
+                {
+                    if (!alive[j]) continue;
+                    const bool depends =
+                        lists_intersect(passes[i].writes, passes[j].reads) ||
+                        lists_intersect(passes[i].writes, passes[j].writes) ||
+                        lists_intersect(passes[i].reads, passes[j].writes);
+                    if (depends)
+                    {
+                        successors[i].push_back(j);
+                        indegree[j]++;
+                    }
+                }
+            }
+
+            // Kahn's algorithm; among ready passes the lowest submission index goes first so
+            // the schedule is stable frame-to-frame. Pass counts are tiny, O(n^2) is fine.
+            std::vector<bool> emitted(n, false);
+            size_t aliveCount = 0;
+            for (size_t i = 0; i < n; ++i) if (alive[i]) aliveCount++;
+
+            while (schedule.size() < aliveCount)
+            {
+                size_t next = n;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (alive[i] && !emitted[i] && indegree[i] == 0) { next = i; break; }
+                }
+                assert(next != n); // a cycle in declared reads/writes
+                if (next == n) break;
+
+                emitted[next] = true;
+                schedule.push_back(next);
+                for (const size_t s : successors[next]) indegree[s]--;
+            }
+        }
+
+        void execute()
+        {
+            for (const size_t i : schedule) passes[i].execute();
+        }
+
+        // Scheduled pass names in execution order (used by tooling / tests)
+        std::vector<std::string> get_schedule() const
+        {
+            std::vector<std::string> names;
+            for (const size_t i : schedule) names.push_back(passes[i].name);
+            return names;
+        }
+    };
+}
+
+#endif // end polymer_renderer_graph_hpp
@@ -0,0 +1,220 @@
+#pragma once
+
+#ifndef polymer_renderer_hiz_hpp
+#define polymer_renderer_hiz_hpp
+
+#include "math-core.hpp"
+#include "gl-api.hpp"
+
+#include <unordered_map>
+
+namespace polymer
+{
+    //////////////////////////////
+    //   hi_z_occlusion_culler  //
+    //////////////////////////////
+
+    // Builds a max-depth pyramid (Hi-Z) from the resolved depth of the previous frame and tests
+    // world-space bounding spheres against it in compute, producing a per-object visibility mask.
+    // Results are consumed with one frame of latency so the readback never stalls the pipeline:
+    // each frame we collect last frame's results, rebuild the pyramid, and dispatch the next test.
+    // Objects with an unknown bound (zero radius) are always reported visible.
+
+    static const char * hiz_downsample_compute_source = R"(#version 450
+        layout(local_size_x = 8, local_size_y = 8) in;
+        layout(binding = 0, r32f) uniform readonly image2D u_source;
+        layout(binding = 1, r32f) uniform writeonly image2D u_dest;
+        layout(binding = 0) uniform sampler2D s_depth;
+        uniform int u_copyDepth; // 1 on the first level, where we read the raw depth attachment
+        uniform ivec2 u_srcSize;
+        uniform ivec2 u_destSize;
+        void main()
+        {
+            ivec2 dst = ivec2(gl_GlobalInvocationID.xy);
+            if (dst.x >= u_destSize.x || dst.y >= u_destSize.y) return;
+
+            // Max-reduce a 2x2 block. On odd source dimensions the last row/column
+            // has no destination texel of its own, so the edge texel widens its
+            // footprint to cover the remainder - dropping it would under-estimate
+            // the farthest depth, and a conservative Hi-Z must only over-estimate.
+            ivec2 src = dst * 2;
+            ivec2 extent = ivec2(2) + ivec2(
+                ((u_srcSize.x & 1) != 0 && dst.x == u_destSize.x - 1) ? 1 : 0,
+                ((u_srcSize.y & 1) != 0 && dst.y == u_destSize.y - 1) ? 1 : 0);
+
+            float d = 0.0;
+            for (int y = 0; y < extent.y; ++y)
+            {
+                for (int x = 0; x < extent.x; ++x)
+                {
+                    ivec2 p = min(src + ivec2(x, y), u_srcSize - 1);
+                    d = max(d, (u_copyDepth == 1) ? texelFetch(s_depth, p, 0).r : imageLoad(u_source, p).r);
+                }
+            }
+            imageStore(u_dest, dst, vec4(d));
+        })";
+
+    static const char * hiz_cull_compute_source = R"(#version 450
+        layout(local_size_x = 64) in;
+        layout(std430, binding = 0) readonly buffer Bounds { vec4 u_bounds[]; };      // xyz world center, w radius
+        layout(std430, binding = 1) writeonly buffer Visibility { uint u_visible[]; };
+        layout(binding = 0) uniform sampler2D s_pyramid;
+        uniform mat4 u_viewProj;
+        uniform vec2 u_pyramidSize;
+        uniform int u_numBounds;
+        uniform int u_maxMip;
+        void main()
+        {
+            uint i = gl_GlobalInvocationID.x;
+            if (i >= uint(u_numBounds)) return;
+
+            vec4 sphere = u_bounds[i];
+            if (sphere.w <= 0.0) { u_visible[i] = 1u; return; }
+
+            // Project the eight corners of the sphere's world-space box to a conservative ndc rect
+            vec3 lo = vec3(1e9); vec3 hi = vec3(-1e9);
+            for (int c = 0; c < 8; ++c)
+            {
+                vec3 corner = sphere.xyz + sphere.w * vec3((c & 1) != 0 ? 1.0 : -1.0, (c & 2) != 0 ? 1.0 : -1.0, (c & 4) != 0 ? 1.0 : -1.0);
+                vec4 clip = u_viewProj * vec4(corner, 1.0);
+                if (clip.w <= 0.0) { u_visible[i] = 1u; return; } // crosses the near plane; keep
+                vec3 ndc = clip.xyz / clip.w;
+                lo = min(lo, ndc); hi = max(hi, ndc);
+            }
+
+            if (lo.x > 1.0 || hi.x < -1.0 || lo.y > 1.0 || hi.y < -1.0) { u_visible[i] = 0u; return; } // off screen
+
+            vec2 uvLo = clamp(lo.xy * 0.5 + 0.5, 0.0, 1.0);
+            vec2 uvHi = clamp(hi.xy * 0.5 + 0.5, 0.0, 1.0);
+
+            // Pick a mip where the rect covers at most ~2x2 texels
+            vec2 extent = (uvHi - uvLo) * u_pyramidSize;
+            int mip = clamp(int(ceil(log2(max(max(extent.x, extent.y), 1.0)))), 0, u_maxMip);
+
+            float occluder = max(
+                max(textureLod(s_pyramid, uvLo, mip).r, textureLod(s_pyramid, vec2(uvHi.x, uvLo.y), mip).r),
+                max(textureLod(s_pyramid, vec2(uvLo.x, uvHi.y), mip).r, textureLod(s_pyramid, uvHi, mip).r));
+
+            float nearestDepth = lo.z * 0.5 + 0.5;
+            u_visible[i] = (nearestDepth <= occluder) ? 1u : 0u;
+        })";
+
+    class hi_z_occlusion_culler
+    {
+        gl_texture_2d depthPyramid;
+        gl_buffer boundsBuffer;
+        gl_buffer visibilityBuffer;
+
+        std::unique_ptr<gl_shader_compute> downsample;
+        std::unique_ptr<gl_shader_compute> cull;
+
+        int2 sourceSize{ 0, 0 }; // full-res depth the first reduction reads from
+        int2 pyramidSize{ 0, 0 };
+        int mipCount{ 0 };
+
+        std::vector<float4> boundsScratch;
+        std::vector<uint32_t> visibilityReadback;
+        std::unordered_map<uint64_t, uint32_t> lastResults; // entity -> visible, one frame latent
+        std::vector<uint64_t> inflightEntities;             // entity order of the dispatch in flight
+        bool dispatchInFlight{ false };
+
+    public:
+
+        hi_z_occlusion_culler(const int2 & render_size)
+        {
+            sourceSize = render_size;
+            pyramidSize = { std::max(render_size.x / 2, 1), std::max(render_size.y / 2, 1) };
+            mipCount = 1 + static_cast<int>(std::floor(std::log2(std::max(static_cast<int>(pyramidSize.x), static_cast<int>(pyramidSize.y)))));
+
+            glTextureStorage2DEXT(depthPyramid, GL_TEXTURE_2D, mipCount, GL_R32F, pyramidSize.x, pyramidSize.y);
+            glTextureParameteriEXT(depthPyramid, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            glTextureParameteriEXT(depthPyramid, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTextureParameteriEXT(depthPyramid, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(depthPyramid, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+            downsample.reset(new gl_shader_compute(hiz_downsample_compute_source));
+            cull.reset(new gl_shader_compute(hiz_cull_compute_source));
+
+            gl_check_error(__FILE__, __LINE__);
+        }
+
+        // True when the entity passed last frame's occlusion test (or no result is known for it yet)
+        bool is_visible(const uint64_t e) const
+        {
+            auto iter = lastResults.find(e);
+            if (iter == lastResults.end()) return true;
+            return iter->second != 0;
+        }
+
+        // Collect the results of the dispatch issued last frame; the GPU finished long ago so this
+        // readback does not introduce a sync point.
+        void gather_results()
+        {
+            if (!dispatchInFlight) return;
+            dispatchInFlight = false;
+
+            visibilityReadback.resize(inflightEntities.size());
+            glGetNamedBufferSubDataEXT(visibilityBuffer, 0, sizeof(uint32_t) * visibilityReadback.size(), visibilityReadback.data());
+
+            lastResults.clear();
+            for (size_t i = 0; i < inflightEntities.size(); ++i) lastResults[inflightEntities[i]] = visibilityReadback[i];
+        }
+
+        // Downsample `depth_texture` (the previous frame's resolved depth) into the max pyramid,
+        // then test each (entity, world-space sphere) pair against it. Call once per frame.
+        void dispatch(const GLuint depth_texture, const std::vector<std::pair<uint64_t, float4>> & bounds, const float4x4 & viewProjMatrix)
+        {
+            if (bounds.empty()) return;
+
+            // Build the pyramid
+            int2 levelSize = pyramidSize;
+            int2 srcSize = sourceSize;
+            for (int level = 0; level < mipCount; ++level)
+            {
+                downsample->uniform("u_copyDepth", level == 0 ? 1 : 0);
+                glProgramUniform2i(downsample->handle(), downsample->get_uniform_location("u_srcSize"), srcSize.x, srcSize.y);
+                glProgramUniform2i(downsample->handle(), downsample->get_uniform_location("u_destSize"), levelSize.x, levelSize.y);
+                if (level == 0) downsample->texture("s_depth", 0, depth_texture, GL_TEXTURE_2D);
+                else glBindImageTexture(0, depthPyramid, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+                glBindImageTexture(1, depthPyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+                downsample->dispatch((levelSize.x + 7) / 8, (levelSize.y + 7) / 8, 1);
+                glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+                srcSize = levelSize;
+                levelSize = { std::max(levelSize.x / 2, 1), std::max(levelSize.y / 2, 1) };
+            }
+
+            // Upload bounds and dispatch the test
+            boundsScratch.clear();
+            inflightEntities.clear();
+            for (auto & b : bounds)
+            {
+                inflightEntities.push_back(b.first);
+                boundsScratch.push_back(b.second);
+            }
+
+            boundsBuffer.set_buffer_data(sizeof(float4) * boundsScratch.size(), boundsScratch.data(), GL_STREAM_DRAW);
+            visibilityBuffer.set_buffer_data(sizeof(uint32_t) * boundsScratch.size(), nullptr, GL_STREAM_READ);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, boundsBuffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, visibilityBuffer);
+
+            cull->uniform("u_viewProj", viewProjMatrix);
+            cull->uniform("u_pyramidSize", float2(static_cast<float>(pyramidSize.x), static_cast<float>(pyramidSize.y)));
+            cull->uniform("u_numBounds", static_cast<int>(boundsScratch.size()));
+            cull->uniform("u_maxMip", mipCount - 1);
+            cull->texture("s_pyramid", 0, depthPyramid, GL_TEXTURE_2D);
+            cull->dispatch((static_cast<GLuint>(boundsScratch.size()) + 63) / 64, 1, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+
+            dispatchInFlight = true;
+
+            gl_check_error(__FILE__, __LINE__);
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_renderer_hiz_hpp
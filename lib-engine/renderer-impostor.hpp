@@ -0,0 +1,305 @@
+#pragma once
+
+#ifndef polymer_renderer_impostor_hpp
+#define polymer_renderer_impostor_hpp
+
+#include "gfx/gl/gl-api.hpp"
+#include "math-core.hpp"
+
+#include <unordered_map>
+
+namespace polymer
+{
+
+    ///////////////////////////
+    //   impostor_atlas      //
+    ///////////////////////////
+
+    // A baked octahedral impostor: one albedo/coverage atlas holding grid x grid
+    // views of a mesh, each rendered from a direction produced by octahedral
+    // mapping over the full sphere. Far-field entities carrying one of these are
+    // pulled out of the mesh path and drawn as alpha-tested billboards, one
+    // instanced draw per atlas regardless of instance count.
+    struct impostor_atlas
+    {
+        gl_texture_2d albedo;         // rgba8, alpha holds coverage
+        uint32_t grid{ 12 };          // cells per atlas side
+        uint32_t cell_resolution{ 64 };
+        float radius{ 0.f };          // local-space bounding radius the bake framed
+        float3 center{ 0, 0, 0 };     // local-space bounds center
+
+        bool ready() const { return radius > 0.f; }
+    };
+
+    // Runtime-only per-entity impostor state tracked by the render_system (the
+    // atlas is a gpu texture baked on the owning context, so like skinning state
+    // it is rebuilt by the app rather than serialized).
+    struct impostor_state
+    {
+        impostor_atlas atlas;
+        float transition_distance{ 150.f }; // meters beyond which the impostor takes over
+    };
+
+    //////////////////////////
+    //   impostor_baker     //
+    //////////////////////////
+
+    constexpr const char impostor_bake_vert[] = R"(#version 330
+        layout(location = 0) in vec3 inPosition;
+        layout(location = 3) in vec2 inTexcoord;
+        uniform mat4 u_mvp;
+        out vec2 v_texcoord;
+        void main()
+        {
+            gl_Position = u_mvp * vec4(inPosition, 1);
+            v_texcoord = inTexcoord;
+        }
+    )";
+
+    constexpr const char impostor_bake_frag[] = R"(#version 330
+        in vec2 v_texcoord;
+        uniform sampler2D s_baseColor;
+        uniform vec3 u_color;
+        uniform float u_useTexture;
+        out vec4 f_color;
+        void main()
+        {
+            vec3 albedo = mix(u_color, texture(s_baseColor, v_texcoord).rgb, u_useTexture);
+            f_color = vec4(albedo, 1);
+        }
+    )";
+
+    class impostor_baker
+    {
+        gl_framebuffer bakeFramebuffer;
+        gl_renderbuffer bakeDepth;
+        gl_shader bakeShader{ impostor_bake_vert, impostor_bake_frag };
+
+        // Full-sphere octahedral mapping; matches the decode in the billboard shader
+        static float3 octahedral_decode(float2 e)
+        {
+            float3 v = float3(e.x, e.y, 1.f - std::abs(e.x) - std::abs(e.y));
+            if (v.z < 0.f)
+            {
+                const float px = (1.f - std::abs(v.y)) * (v.x >= 0.f ? 1.f : -1.f);
+                const float py = (1.f - std::abs(v.x)) * (v.y >= 0.f ? 1.f : -1.f);
+                v.x = px; v.y = py;
+            }
+            return normalize(v);
+        }
+
+    public:
+
+        // Renders `mesh` into a fresh atlas, one orthographic view per octahedral
+        // cell framed around `local_bounds`. Albedo comes from `base_color` when
+        // provided (sampled through texcoord0), otherwise `flat_color`; coverage
+        // lands in alpha via the cleared-to-zero background.
+        impostor_atlas bake(gl_mesh & mesh, const aabb_3d & local_bounds,
+            gl_texture_2d * base_color = nullptr, const float3 & flat_color = float3(0.5f, 0.5f, 0.5f),
+            const uint32_t grid = 12, const uint32_t cell_resolution = 64)
+        {
+            impostor_atlas atlas;
+            atlas.grid = grid;
+            atlas.cell_resolution = cell_resolution;
+            atlas.center = local_bounds.center();
+            atlas.radius = 0.5f * length(local_bounds.size());
+            if (atlas.radius <= 0.f) return atlas;
+
+            const uint32_t atlasSize = grid * cell_resolution;
+
+            atlas.albedo.memory.set_category(gl_memory_category::textures);
+            atlas.albedo.setup(atlasSize, atlasSize, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTextureParameteriEXT(atlas.albedo, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(atlas.albedo, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(atlas.albedo, GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+            glNamedRenderbufferStorageMultisampleEXT(bakeDepth, 0, GL_DEPTH_COMPONENT24, atlasSize, atlasSize);
+            bakeDepth.record_storage(GL_DEPTH_COMPONENT24, atlasSize, atlasSize, 0);
+
+            glNamedFramebufferTexture2DEXT(bakeFramebuffer, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, atlas.albedo, 0);
+            glNamedFramebufferRenderbufferEXT(bakeFramebuffer, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, bakeDepth);
+            bakeFramebuffer.check_complete();
+
+            glBindFramebuffer(GL_FRAMEBUFFER, bakeFramebuffer);
+            glViewport(0, 0, atlasSize, atlasSize);
+            glClearColor(0.f, 0.f, 0.f, 0.f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glEnable(GL_DEPTH_TEST);
+
+            const float4x4 projection = make_orthographic_matrix(
+                -atlas.radius, atlas.radius, -atlas.radius, atlas.radius, 0.1f * atlas.radius, 4.f * atlas.radius);
+
+            bakeShader.bind();
+            if (base_color) bakeShader.texture("s_baseColor", 0, *base_color, GL_TEXTURE_2D);
+            bakeShader.uniform("u_color", flat_color);
+            bakeShader.uniform("u_useTexture", base_color ? 1.f : 0.f);
+
+            for (uint32_t y = 0; y < grid; ++y)
+            {
+                for (uint32_t x = 0; x < grid; ++x)
+                {
+                    const float2 cell((x + 0.5f) / grid * 2.f - 1.f, (y + 0.5f) / grid * 2.f - 1.f);
+                    const float3 dir = octahedral_decode(cell);
+                    const float3 worldUp = std::abs(dir.y) > 0.99f ? float3(0, 0, 1) : float3(0, 1, 0);
+
+                    const transform eye = lookat_rh(atlas.center + dir * (2.f * atlas.radius), atlas.center, worldUp);
+                    const float4x4 mvp = projection * eye.view_matrix();
+
+                    glViewport(x * cell_resolution, y * cell_resolution, cell_resolution, cell_resolution);
+                    bakeShader.uniform("u_mvp", mvp);
+                    mesh.draw_elements();
+                }
+            }
+
+            bakeShader.unbind();
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            gl_check_error(__FILE__, __LINE__);
+
+            return atlas;
+        }
+    };
+
+    ////////////////////////////
+    //   gl_impostor_batch    //
+    ////////////////////////////
+
+    constexpr const char impostor_batch_vert[] = R"(#version 430
+        layout(binding = 0, std430) readonly buffer InstanceBuffer
+        {
+            vec4 instances[]; // xyz world center, w world radius
+        };
+
+        uniform mat4 u_viewProj;
+        uniform vec3 u_eye;
+
+        out vec2 v_corner;
+        flat out vec3 v_viewDir;
+
+        void main()
+        {
+            const vec2 corners[4] = vec2[](vec2(-1, -1), vec2(1, -1), vec2(-1, 1), vec2(1, 1));
+            vec2 corner = corners[gl_VertexID];
+            vec4 instance = instances[gl_InstanceID];
+
+            // Spherical billboard facing the eye, up chosen per instance
+            vec3 forward = normalize(u_eye - instance.xyz);
+            vec3 right = normalize(cross(vec3(0, 1, 0), forward));
+            if (abs(forward.y) > 0.99) right = normalize(cross(vec3(0, 0, 1), forward));
+            vec3 up = cross(forward, right);
+
+            vec3 world = instance.xyz + (right * corner.x + up * corner.y) * instance.w;
+            gl_Position = u_viewProj * vec4(world, 1);
+            v_corner = corner;
+            v_viewDir = forward;
+        }
+    )";
+
+    constexpr const char impostor_batch_frag[] = R"(#version 430
+        in vec2 v_corner;
+        flat in vec3 v_viewDir;
+
+        uniform sampler2D s_atlas;
+        uniform float u_grid;
+
+        out vec4 f_color;
+
+        vec2 octahedral_encode(vec3 v)
+        {
+            vec2 e = v.xy / (abs(v.x) + abs(v.y) + abs(v.z));
+            if (v.z < 0.0) e = (1.0 - abs(e.yx)) * vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);
+            return e;
+        }
+
+        void main()
+        {
+            // Snap the view direction to the nearest baked cell, then address the
+            // quad's uv inside that cell
+            vec2 oct = octahedral_encode(v_viewDir) * 0.5 + 0.5;
+            vec2 cell = clamp(floor(oct * u_grid), vec2(0.0), vec2(u_grid - 1.0));
+            vec2 uv = (cell + (v_corner * 0.5 + 0.5)) / u_grid;
+
+            vec4 s = texture(s_atlas, uv);
+            if (s.a < 0.5) discard; // alpha test keeps the pass order-independent
+            f_color = vec4(s.rgb, 1);
+        }
+    )";
+
+    // Accumulates far-field impostors for the frame and renders each atlas's
+    // instances with a single glDrawArraysInstanced. Instance data streams into
+    // one shared buffer per draw.
+    class gl_impostor_batch
+    {
+        struct group
+        {
+            const impostor_atlas * atlas{ nullptr };
+            std::vector<float4> instances; // xyz world center, w world radius
+        };
+
+        gl_shader shader{ impostor_batch_vert, impostor_batch_frag };
+        gl_buffer instanceBuffer;
+        gl_vertex_array_object vao; // attribless draw still needs a bound vao
+        std::vector<group> groups;
+
+    public:
+
+        gl_impostor_batch()
+        {
+            instanceBuffer.memory.set_category(gl_memory_category::meshes);
+        }
+
+        void clear() { groups.clear(); }
+
+        void add(const impostor_atlas & atlas, const float3 & world_center, const float world_radius)
+        {
+            for (auto & g : groups)
+            {
+                if (g.atlas == &atlas)
+                {
+                    g.instances.push_back(float4(world_center, world_radius));
+                    return;
+                }
+            }
+            groups.push_back({ &atlas, { float4(world_center, world_radius) } });
+        }
+
+        size_t instance_count() const
+        {
+            size_t count = 0;
+            for (const auto & g : groups) count += g.instances.size();
+            return count;
+        }
+
+        // One instanced draw per atlas. Alpha-tested with depth writes on, so the
+        // batch composes correctly against the forward pass without sorting.
+        void draw(const float4x4 & viewProjMatrix, const float3 & eye_position)
+        {
+            if (groups.empty()) return;
+
+            shader.bind();
+            shader.uniform("u_viewProj", viewProjMatrix);
+            shader.uniform("u_eye", eye_position);
+
+            glBindVertexArray(vao);
+
+            for (const auto & g : groups)
+            {
+                if (g.instances.empty()) continue;
+
+                instanceBuffer.set_buffer_data(g.instances.size() * sizeof(float4), g.instances.data(), GL_STREAM_DRAW);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instanceBuffer);
+
+                shader.texture("s_atlas", 0, g.atlas->albedo, GL_TEXTURE_2D);
+                shader.uniform("u_grid", static_cast<float>(g.atlas->grid));
+
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(g.instances.size()));
+            }
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+            glBindVertexArray(0);
+            shader.unbind();
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_renderer_impostor_hpp
@@ -4,8 +4,51 @@
 #include "geometry.hpp"
 #include "system-render.hpp"
 
+#include <algorithm>
 #include <execution>
 
+namespace
+{
+    // Sized internal format for the HDR intermediates (see hdr_precision in renderer-pbr.hpp)
+    GLenum hdr_internal_format(const polymer::hdr_precision p)
+    {
+        switch (p)
+        {
+            case polymer::hdr_precision::full_float:   return GL_RGBA32F;
+            case polymer::hdr_precision::half_float:   return GL_RGBA16F;
+            case polymer::hdr_precision::packed_float: return GL_R11F_G11F_B10F;
+        }
+        return GL_RGBA16F;
+    }
+
+    GLenum hdr_pixel_format(const polymer::hdr_precision p)
+    {
+        return (p == polymer::hdr_precision::packed_float) ? GL_RGB : GL_RGBA;
+    }
+
+    // Weighted-blended OIT composite (McGuire & Bavoil): resolves the accumulated
+    // premultiplied color sum against the revealage product onto the scene color
+    constexpr const char oit_composite_vert[] = R"(#version 330
+        layout(location = 0) in vec3 position;
+        layout(location = 3) in vec2 texcoord;
+        out vec2 v_texcoord;
+        void main() { v_texcoord = texcoord; gl_Position = vec4(position, 1); }
+    )";
+
+    constexpr const char oit_composite_frag[] = R"(#version 330
+        in vec2 v_texcoord;
+        uniform sampler2D s_accum;
+        uniform sampler2D s_reveal;
+        out vec4 f_color;
+        void main()
+        {
+            vec4 accum = texture(s_accum, v_texcoord);
+            float reveal = texture(s_reveal, v_texcoord).r;
+            f_color = vec4(accum.rgb / clamp(accum.a, 1e-4, 5e4), reveal);
+        }
+    )";
+}
+
 ////////////////////////////////////////////////
 //   stable_cascaded_shadows implementation   //
 ////////////////////////////////////////////////
@@ -13,23 +56,46 @@
 stable_cascaded_shadows::stable_cascaded_shadows()
 {
     const GLsizei size = static_cast<GLsizei>(resolution);
+    shadowArrayDepth.memory.set_category(gl_memory_category::render_targets);
     shadowArrayDepth.setup(GL_TEXTURE_2D_ARRAY, size, size, uniforms::NUM_CASCADES, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
     glNamedFramebufferTextureEXT(shadowArrayFramebuffer, GL_DEPTH_ATTACHMENT, shadowArrayDepth, 0);
     shadowArrayFramebuffer.check_complete();
+
+    staticArrayDepth.memory.set_category(gl_memory_category::render_targets);
+    staticArrayDepth.setup(GL_TEXTURE_2D_ARRAY, size, size, uniforms::NUM_CASCADES, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glNamedFramebufferTextureEXT(staticArrayFramebuffer, GL_DEPTH_ATTACHMENT, staticArrayDepth, 0);
+    staticArrayFramebuffer.check_complete();
+
     gl_check_error(__FILE__, __LINE__);
 }
 
 void stable_cascaded_shadows::update_cascades(const float4x4 & view, const float near, const float far, const float aspectRatio, const float vfov, const float3 & lightDir)
 {
-    nearPlanes.clear();
-    farPlanes.clear();
-    splitPlanes.clear();
-    viewMatrices.clear();
-    projMatrices.clear();
-    shadowMatrices.clear();
+    // Advance the round-robin schedule. Cascades whose bit is clear keep every fitted
+    // quantity from their last refresh, so the depth they retain stays consistent with the
+    // matrix the lighting pass samples them through. The phase offset staggers the far
+    // cascades so no single frame refreshes more than it has to.
+    static const uint32_t refresh_intervals[4] = { 1, 1, 2, 4 };
+    ++frameIndex;
+    refreshMask = 0;
+    for (uint32_t C = 0; C < uniforms::NUM_CASCADES; ++C)
+    {
+        const uint32_t interval = roundRobinEnabled ? refresh_intervals[C % 4] : 1;
+        if ((frameIndex + C) % interval == 0) refreshMask |= (1u << C);
+    }
+    if (shadowMatrices.size() != uniforms::NUM_CASCADES) refreshMask = (1u << uniforms::NUM_CASCADES) - 1; // first update primes every cascade
+
+    nearPlanes.resize(uniforms::NUM_CASCADES);
+    farPlanes.resize(uniforms::NUM_CASCADES);
+    splitPlanes.resize(uniforms::NUM_CASCADES);
+    viewMatrices.resize(uniforms::NUM_CASCADES);
+    projMatrices.resize(uniforms::NUM_CASCADES);
+    shadowMatrices.resize(uniforms::NUM_CASCADES);
+    cascadeRadii.resize(uniforms::NUM_CASCADES);
 
     for (size_t C = 0; C < uniforms::NUM_CASCADES; ++C)
     {
+        if (!(refreshMask & (1u << C))) continue; // held until its next scheduled refresh
         const float splitIdx = uniforms::NUM_CASCADES;
 
         // Find the split planes using GPU Gem 3. Chap 10 "Practical Split Scheme".
@@ -96,13 +162,20 @@ void stable_cascaded_shadows::update_cascades(const float4x4 & view, const float
 
         const float4x4 theShadowMatrix = (shadowProjectionMatrix * splitViewMatrix);
 
-        viewMatrices.push_back(splitViewMatrix);
-        projMatrices.push_back(shadowProjectionMatrix);
-        shadowMatrices.push_back(theShadowMatrix);
-        splitPlanes.push_back(float2(splitNear, splitFar));
-        nearPlanes.push_back(-maxExtents.z);
-        farPlanes.push_back(-minExtents.z);
+        viewMatrices[C] = splitViewMatrix;
+        projMatrices[C] = shadowProjectionMatrix;
+        shadowMatrices[C] = theShadowMatrix;
+        cascadeRadii[C] = sphereRadius;
+        splitPlanes[C] = float2(splitNear, splitFar);
+        nearPlanes[C] = -maxExtents.z;
+        farPlanes[C] = -minExtents.z;
     }
+
+    // Texel snapping keeps the cascade matrices bit-identical while the camera holds still,
+    // so an exact comparison against last frame is a reliable invalidation signal for the
+    // cached static-caster depth layer.
+    matricesDirty = (previousShadowMatrices != shadowMatrices);
+    previousShadowMatrices = shadowMatrices;
 }
 
 void stable_cascaded_shadows::pre_draw()
@@ -112,7 +185,37 @@ void stable_cascaded_shadows::pre_draw()
     glEnable(GL_CULL_FACE);
     glCullFace(GL_FRONT);
 
+    const GLsizei size = static_cast<GLsizei>(resolution);
     glBindFramebuffer(GL_FRAMEBUFFER, shadowArrayFramebuffer);
+    glViewport(0, 0, size, size);
+
+    if (refreshMask == (1u << uniforms::NUM_CASCADES) - 1) glClear(GL_DEPTH_BUFFER_BIT);
+    else
+    {
+        // Clear only the layers refreshing this frame; held layers retain their depth
+        const float clearDepth = 1.f;
+        for (uint32_t C = 0; C < uniforms::NUM_CASCADES; ++C)
+        {
+            if (refreshMask & (1u << C)) glClearTexSubImage(shadowArrayDepth, 0, 0, 0, C, size, size, 1, GL_DEPTH_COMPONENT, GL_FLOAT, &clearDepth);
+        }
+    }
+
+    auto & shader = program.get()->get_variant()->shader;
+
+    shader.bind();
+    shader.uniform("u_cascadeViewMatrixArray", uniforms::NUM_CASCADES, viewMatrices);
+    shader.uniform("u_cascadeProjMatrixArray", uniforms::NUM_CASCADES, projMatrices);
+    shader.uniform("u_cascadeMask", static_cast<int>(refreshMask));
+}
+
+void stable_cascaded_shadows::pre_draw_static()
+{
+    glEnable(GL_DEPTH_TEST);
+
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, staticArrayFramebuffer);
     glViewport(0, 0, static_cast<GLsizei>(resolution), static_cast<GLsizei>(resolution));
     glClear(GL_DEPTH_BUFFER_BIT);
 
@@ -121,6 +224,38 @@ void stable_cascaded_shadows::pre_draw()
     shader.bind();
     shader.uniform("u_cascadeViewMatrixArray", uniforms::NUM_CASCADES, viewMatrices);
     shader.uniform("u_cascadeProjMatrixArray", uniforms::NUM_CASCADES, projMatrices);
+    shader.uniform("u_cascadeMask", static_cast<int>((1u << uniforms::NUM_CASCADES) - 1)); // the cache covers every cascade
+}
+
+void stable_cascaded_shadows::pre_draw_composite()
+{
+    // Seed the output array from the cached static-caster layer instead of clearing,
+    // so only dynamic casters need to be rasterized this frame. Held cascades are
+    // skipped entirely — they keep last refresh's composite (static + dynamic).
+    const GLsizei size = static_cast<GLsizei>(resolution);
+    for (uint32_t C = 0; C < uniforms::NUM_CASCADES; ++C)
+    {
+        if (refreshMask & (1u << C))
+        {
+            glCopyImageSubData(staticArrayDepth, GL_TEXTURE_2D_ARRAY, 0, 0, 0, C,
+                shadowArrayDepth, GL_TEXTURE_2D_ARRAY, 0, 0, 0, C, size, size, 1);
+        }
+    }
+
+    glEnable(GL_DEPTH_TEST);
+
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, shadowArrayFramebuffer);
+    glViewport(0, 0, size, size);
+
+    auto & shader = program.get()->get_variant()->shader;
+
+    shader.bind();
+    shader.uniform("u_cascadeViewMatrixArray", uniforms::NUM_CASCADES, viewMatrices);
+    shader.uniform("u_cascadeProjMatrixArray", uniforms::NUM_CASCADES, projMatrices);
+    shader.uniform("u_cascadeMask", static_cast<int>(refreshMask)); // dynamic casters only touch refreshing layers
 }
 
 void stable_cascaded_shadows::update_shadow_matrix(const float4x4 & shadowModelMatrix)
@@ -129,6 +264,30 @@ void stable_cascaded_shadows::update_shadow_matrix(const float4x4 & shadowModelM
     shader.uniform("u_modelShadowMatrix", shadowModelMatrix);
 }
 
+uint32_t stable_cascaded_shadows::cascade_mask_for_sphere(const float4 & sphere) const
+{
+    const uint32_t all = (1u << uniforms::NUM_CASCADES) - 1;
+    if (sphere.w <= 0.f || cascadeRadii.size() != uniforms::NUM_CASCADES) return all;
+
+    uint32_t mask = 0;
+    for (uint32_t C = 0; C < uniforms::NUM_CASCADES; ++C)
+    {
+        // The fitted ortho volume spans ±cascadeRadii[C] in x/y of the cascade's view
+        // space. Depth is deliberately untested: casters between the light and the
+        // volume still shadow into the layer.
+        const float3 center = transform_coord(viewMatrices[C], sphere.xyz());
+        const float reach = cascadeRadii[C] + sphere.w;
+        if (std::abs(center.x) <= reach && std::abs(center.y) <= reach) mask |= (1u << C);
+    }
+    return mask;
+}
+
+void stable_cascaded_shadows::set_caster_mask(const uint32_t mask)
+{
+    auto & shader = program.get()->get_variant()->shader;
+    shader.uniform("u_cascadeMask", static_cast<int>(mask));
+}
+
 void stable_cascaded_shadows::post_draw()
 {
     auto & shader = program.get()->get_variant()->shader; // should this be a call to default()?
@@ -147,18 +306,88 @@ GLuint stable_cascaded_shadows::get_output_texture() const
 //   pbr_renderer implementation   //
 /////////////////////////////////////
 
-void pbr_renderer::update_per_object_uniform_buffer(const transform & p, const float3 & scale, const bool recieveShadow, const view_data & d)
+// Base 2/3 halton offsets for the taa sub-pixel jitter sequence
+static float halton_sequence(uint32_t index, uint32_t base)
+{
+    float f = 1.f, r = 0.f;
+    while (index > 0)
+    {
+        f /= static_cast<float>(base);
+        r += f * static_cast<float>(index % base);
+        index /= base;
+    }
+    return r;
+}
+
+void pbr_renderer::update_per_object_uniform_buffer(const entity e, const transform & p, const float3 & scale, const material_component & mat, const view_data & d)
 {
     uniforms::per_object object = {};
     object.modelMatrix = p.matrix() * make_scaling_matrix(scale);
     object.modelMatrixIT = inverse(transpose(object.modelMatrix));
     object.modelViewMatrix = d.viewMatrix * object.modelMatrix;
-    object.receiveShadow = static_cast<float>(recieveShadow);
-    perObject.set_buffer_data(sizeof(object), &object, GL_STREAM_DRAW);
+    object.receiveShadow = static_cast<float>(mat.receive_shadow);
+
+    // Per-instance property block: overrides over the shared material ride the
+    // same ring write, so tinted/dimmed variants don't need their own materials
+    object.propertyTint = mat.tint;
+    object.propertyEmissiveScale = mat.emissive_strength;
+
+    // Last frame's model matrix rides along for motion vectors; a newly visible
+    // entity falls back to its current matrix (zero velocity)
+    const auto prev = previousModelMatrices.find(e);
+    object.modelMatrixPrevious = (prev != previousModelMatrices.end()) ? prev->second : object.modelMatrix;
+    currentModelMatrices[e] = object.modelMatrix;
+
+    if (persistentMappingSupported)
+    {
+        // Bump-allocate out of the persistently mapped ring and bind the range; no driver round-trip per object
+        const GLintptr offset = perObjectRing.write(&object, sizeof(object));
+        if (offset >= 0)
+        {
+            perObjectRing.bind_range(uniforms::per_object::binding, offset, sizeof(object));
+        }
+        else
+        {
+            // The section filled up this frame: spill to the sub-data path for the
+            // remaining objects. The base bind is needed per spill because the
+            // once-per-frame base bind only happens on the non-mapped path.
+            static bool warned = false;
+            if (!warned) { log::get()->engine_log->warn("per-object ring section exhausted; spilling to glBufferSubData (consider a larger ring)"); warned = true; }
+            perObject.set_buffer_data(sizeof(object), &object, GL_STREAM_DRAW);
+            glBindBufferBase(GL_UNIFORM_BUFFER, uniforms::per_object::binding, perObject);
+        }
+    }
+    else
+    {
+        perObject.set_buffer_data(sizeof(object), &object, GL_STREAM_DRAW);
+    }
+}
+
+void pbr_renderer::bind_bone_palette(const std::vector<float4x4> & palette)
+{
+    const GLsizeiptr bytes = std::min(palette.size(), size_t(uniforms::MAX_BONES)) * sizeof(float4x4);
+
+    if (persistentMappingSupported)
+    {
+        // Palettes for every skinned entity this frame bump-allocate out of the same
+        // style of mapped ring as the per-object data; one memcpy + bind range each
+        const GLintptr offset = perSkinRing.write(palette.data(), bytes);
+        if (offset >= 0)
+        {
+            perSkinRing.bind_range(uniforms::per_skin::binding, offset, bytes);
+            return;
+        }
+        // Section exhausted this frame: fall through to the sub-data path below
+    }
+
+    perSkin.set_buffer_data(bytes, palette.data(), GL_STREAM_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, uniforms::per_skin::binding, perSkin);
 }
 
 void pbr_renderer::run_stencil_prepass(const view_data & view, const render_payload & scene)
 {
+    scoped_pass_stats stats(passStats, "stencil_prepass-" + std::to_string(view.index));
+
     gl_check_error(__FILE__, __LINE__);
 
     GLboolean colorMask[4];
@@ -230,6 +459,8 @@ stable_cascaded_shadows * pbr_renderer::get_shadow_pass() const
 
 void pbr_renderer::run_depth_prepass(const view_data & view, const render_payload & scene)
 {
+    scoped_pass_stats stats(passStats, "depth_prepass-" + std::to_string(view.index));
+
     GLboolean colorMask[4];
     glGetBooleanv(GL_COLOR_WRITEMASK, &colorMask[0]);
 
@@ -238,16 +469,90 @@ void pbr_renderer::run_depth_prepass(const view_data & view, const render_payloa
     glDepthMask(GL_TRUE);       // Need depth mask on
     glColorMask(0, 0, 0, 0);    // Do not write any color
 
-    auto & shader = renderPassEarlyZ.get()->get_variant()->shader;
-    shader.bind();
-
-    for (const render_component & r : scene.render_components)
+    if (settings.instancedDrawing)
     {
-        update_per_object_uniform_buffer(r.world_transform->world_pose, r.local_transform->local_scale, r.material->receive_shadow, view);
-        r.mesh->draw();
+        // The prepass only writes depth, so components can be bucketed by mesh alone
+        // (material is irrelevant) and each bucket drawn with a single instanced or
+        // multi-draw-indirect submission.
+        std::unordered_map<std::string, std::vector<const render_component *>> meshBuckets;
+        for (const render_component & r : scene.render_components)
+        {
+            if (hiz && !hiz->is_visible(r.get_entity())) continue;
+            if (r.bone_palette) continue; // skinned depth comes from the forward pass, not the rigid mesh
+            if (r.impostor) continue;     // impostors draw alpha-tested billboards with their own depth
+            if (r.material->material.get().get()->requires_blending()) continue; // transparents never write depth
+            meshBuckets[r.mesh->mesh.name].push_back(&r);
+        }
+
+        const uint32_t eyeCount = stereoSinglePassActive ? 2 : 1;
+
+        auto asset = renderPassEarlyZ.get();
+        if (asset->feature_count() == 0)
+        {
+            asset->declare_features({ "USE_INSTANCING", "USE_STEREO_SINGLE_PASS" });
+            asset->precompile_variants({ 0, 1, 2, 3 }); // all four combinations are live within a session
+        }
+
+        auto & shader = asset->get_variant(1ull | (stereoSinglePassActive ? 2ull : 0ull))->shader;
+        shader.bind();
+
+        for (auto & bucket : meshBuckets)
+        {
+            instanceTransforms.clear();
+            for (const render_component * r : bucket.second)
+            {
+                instanceTransforms.push(r->world_transform->world_pose, r->local_transform->local_scale);
+            }
+            instanceTransforms.compose(instanceModelMatrices);
+
+            gl_mesh & mesh = bucket.second.front()->mesh->mesh.get();
+            mesh.set_instance_data(sizeof(float4x4) * instanceModelMatrices.size(), instanceModelMatrices.data(), GL_STREAM_DRAW);
+            for (GLuint column = 0; column < 4; ++column)
+            {
+                mesh.set_instance_attribute(6 + column, 4, GL_FLOAT, GL_FALSE, sizeof(float4x4), (GLvoid *)(sizeof(float4) * column), eyeCount);
+            }
+
+            if (multiDrawIndirectSupported)
+            {
+                draw_elements_indirect_command cmd;
+                cmd.count = static_cast<GLuint>(mesh.get_index_count());
+                cmd.instanceCount = static_cast<GLuint>(bucket.second.size() * eyeCount);
+                indirectDrawBuffer.set_commands({ cmd }, GL_STREAM_DRAW);
+                mesh.draw_elements_indirect_depth(indirectDrawBuffer);
+            }
+            else
+            {
+                mesh.draw_elements_depth(static_cast<int>(bucket.second.size() * eyeCount));
+            }
+        }
+
+        shader.unbind();
     }
+    else
+    {
+        auto asset = renderPassEarlyZ.get();
+        if (asset->feature_count() == 0)
+        {
+            asset->declare_features({ "USE_INSTANCING", "USE_STEREO_SINGLE_PASS" });
+            asset->precompile_variants({ 0, 1, 2, 3 });
+        }
 
-    shader.unbind();
+        auto & shader = asset->get_variant(stereoSinglePassActive ? 2ull : 0ull)->shader;
+        shader.bind();
+
+        for (const render_component & r : scene.render_components)
+        {
+            if (hiz && !hiz->is_visible(r.get_entity())) continue;
+            if (r.bone_palette) continue; // skinned depth comes from the forward pass, not the rigid mesh
+            if (r.impostor) continue;     // impostors draw alpha-tested billboards with their own depth
+            if (r.material->material.get().get()->requires_blending()) continue; // transparents never write depth
+            update_per_object_uniform_buffer(r.get_entity(), r.world_transform->world_pose, r.local_transform->local_scale, *r.material, view);
+            if (stereoSinglePassActive) r.mesh->mesh.get().draw_elements_depth(2);
+            else r.mesh->mesh.get().draw_elements_depth();
+        }
+
+        shader.unbind();
+    }
 
     // Restore color mask state
     glColorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
@@ -257,6 +562,8 @@ void pbr_renderer::run_skybox_pass(const view_data & view, const render_payload
 {
     if (!scene.skybox) return;
 
+    scoped_pass_stats stats(passStats, "skybox_pass-" + std::to_string(view.index));
+
     const GLboolean wasDepthTestingEnabled = glIsEnabled(GL_DEPTH_TEST);
     const GLboolean wasCullingEnabled = glIsEnabled(GL_CULL_FACE);
 
@@ -283,32 +590,245 @@ void pbr_renderer::run_skybox_pass(const view_data & view, const render_payload
 
 void pbr_renderer::run_shadow_pass(const view_data & view, const render_payload & scene)
 {
+    scoped_pass_stats stats(passStats, "shadow_pass-" + std::to_string(view.index));
+
+    // Sample-distribution tightening: reduce last frame's resolved depth to the min/max
+    // actually occupied and fit the cascades to that range instead of the worst-case
+    // near/far. One frame of latency, absorbed by a small margin on either side.
+    float shadowNear = view.nearClip;
+    float shadowFar = view.farClip;
+
+    if (depthReducer)
+    {
+        depthReducer->gather_results();
+
+        float minDepth01 = 0.f, maxDepth01 = 1.f;
+        if (depthReducer->get_depth_bounds(minDepth01, maxDepth01))
+        {
+            const float n = view.nearClip, f = view.farClip;
+            auto linearize = [n, f](const float d) { const float ndc = d * 2.f - 1.f; return (2.f * n * f) / (f + n - ndc * (f - n)); };
+
+            // Quantize to 1/16ths of the full range so the fitted bounds (and therefore the
+            // cascade matrices) hold still under small depth fluctuations; the texel snapping
+            // in update_cascades only stabilizes translation, not rescaling.
+            const float step = (f - n) / 16.f;
+            shadowNear = clamp(std::floor(linearize(minDepth01) * 0.95f / step) * step, n, f);
+            shadowFar = clamp(std::ceil(linearize(maxDepth01) * 1.05f / step) * step, n, f);
+            if (shadowFar - shadowNear < step) { shadowNear = n; shadowFar = f; } // degenerate reduction; fall back
+        }
+
+        depthReducer->dispatch(eyeDepthTextures[0], settings.renderSize);
+    }
+
     shadow->update_cascades(view.viewMatrix,
-        view.nearClip,
-        view.farClip,
+        shadowNear,
+        shadowFar,
         aspect_from_projection(view.projectionMatrix),
         vfov_from_projection(view.projectionMatrix),
         scene.sunlight->data.direction);
 
-    shadow->pre_draw();
+    if (!shadow->staticCachingEnabled)
+    {
+        shadow->pre_draw();
+
+        for (const render_component & r : scene.render_components)
+        {
+            if (r.material->cast_shadow)
+            {
+                // Fan the caster out only into cascades its bounds can reach
+                const uint32_t mask = shadow->cascade_mask_for_sphere(r.world_bounding_sphere) & shadow->cascade_refresh_mask();
+                if (!mask) continue;
+                shadow->set_caster_mask(mask);
+
+                const float4x4 modelMatrix = (r.world_transform->world_pose.matrix() * make_scaling_matrix(r.local_transform->local_scale));
+                shadow->update_shadow_matrix(modelMatrix);
+                r.mesh->mesh.get().draw_elements_depth();
+            }
+        }
+
+        shadow->post_draw();
+
+        gl_check_error(__FILE__, __LINE__);
+        return;
+    }
+
+    // Classify casters as static (model matrix unchanged since last frame) or dynamic. The
+    // static set is re-rendered into the cached depth layer only when a cascade moves or the
+    // set itself changes; every other frame the cache is composited and only dynamic casters
+    // are rasterized.
+    staticShadowCasters.clear();
+    dynamicShadowCasters.clear();
+    uint64_t staticCasterHash = 0;
 
     for (const render_component & r : scene.render_components)
     {
-        if (r.material->cast_shadow)
+        if (!r.material->cast_shadow) continue;
+        if (r.impostor) continue; // far-field impostors sit beyond the cascade range
+
+        const float4x4 modelMatrix = (r.world_transform->world_pose.matrix() * make_scaling_matrix(r.local_transform->local_scale));
+        const entity e = r.get_entity();
+
+        auto previous = previousShadowCasterPoses.find(e);
+        const bool moved = (previous == previousShadowCasterPoses.end()) || (previous->second != modelMatrix);
+        previousShadowCasterPoses[e] = modelMatrix;
+
+        if (moved) dynamicShadowCasters.push_back(&r);
+        else
+        {
+            staticShadowCasters.push_back(&r);
+            staticCasterHash = (staticCasterHash * 1099511628211ull) ^ e; // fnv-style combine over set membership
+        }
+    }
+
+    const bool staticLayerDirty = shadow->cascades_dirty() || (staticCasterHash != previousStaticCasterHash);
+    previousStaticCasterHash = staticCasterHash;
+
+    if (staticLayerDirty)
+    {
+        shadow->pre_draw_static();
+        for (const render_component * r : staticShadowCasters)
         {
-            const float4x4 modelMatrix = (r.world_transform->world_pose.matrix() * make_scaling_matrix(r.local_transform->local_scale));
-            shadow->update_shadow_matrix(modelMatrix);
-            r.mesh->draw();
+            // The cache covers every cascade, so only the caster's own membership restricts it.
+            // Masks stay valid while the cache lives: they only change when a cascade moves,
+            // which dirties the whole static layer anyway.
+            const uint32_t mask = shadow->cascade_mask_for_sphere(r->world_bounding_sphere);
+            if (!mask) continue;
+            shadow->set_caster_mask(mask);
+
+            shadow->update_shadow_matrix(r->world_transform->world_pose.matrix() * make_scaling_matrix(r->local_transform->local_scale));
+            r->mesh->mesh.get().draw_elements_depth();
         }
+        shadow->post_draw();
     }
 
+    shadow->pre_draw_composite();
+    for (const render_component * r : dynamicShadowCasters)
+    {
+        const uint32_t mask = shadow->cascade_mask_for_sphere(r->world_bounding_sphere) & shadow->cascade_refresh_mask();
+        if (!mask) continue;
+        shadow->set_caster_mask(mask);
+
+        shadow->update_shadow_matrix(r->world_transform->world_pose.matrix() * make_scaling_matrix(r->local_transform->local_scale));
+        r->mesh->mesh.get().draw_elements_depth();
+    }
     shadow->post_draw();
 
     gl_check_error(__FILE__, __LINE__);
 }
 
+void pbr_renderer::submit_material_and_draw(const render_component * r, const uint32_t instanceCount, const render_payload & scene)
+{
+    // Lookup the material component (materials[e]), .get() the asset_handle, and then .get() since
+    // materials instances are stored as shared pointers.
+    material_interface * mat = r->material->material.get().get();
+    mat->set_clustered(clusterGrid != nullptr);
+    mat->set_stereo(stereoSinglePassActive);
+    mat->set_bindless(bindlessTexturesSupported);
+    mat->update_uniforms();
+
+    // @todo - handle other specific material requirements here
+    if (auto * mr = dynamic_cast<polymer_pbr_standard*>(mat))
+    {
+        if (settings.shadowsEnabled)
+        {
+            // @todo - ideally compile this out from the shader if not using shadows
+            mr->update_uniforms_shadow(shadow->get_output_texture());
+        }
+
+        // The nearest enabled reflection probes override the scene-level radiance; the second
+        // probe (when one is in range) is blended in-shader so objects crossing probe
+        // boundaries don't pop. The scene IBL remains the fallback outside all probes.
+        GLuint primaryRadiance = scene.ibl_radianceCubemap.get();
+        GLuint blendRadiance = 0;
+        float probeBlend = 0.f;
+
+        if (!scene.reflection_probes.empty())
+        {
+            const float3 objectPosition = r->world_transform->world_pose.position;
+
+            const reflection_probe_component * best = nullptr;
+            const reflection_probe_component * next = nullptr;
+            float bestWeight = 0.f, nextWeight = 0.f;
+
+            for (const auto * probe : scene.reflection_probes)
+            {
+                if (!probe->enabled || !probe->bakedCubemap || probe->radius <= 0.f) continue;
+                const float w = 1.f - (length(objectPosition - probe->position) / probe->radius);
+                if (w <= 0.f) continue;
+                if (w > bestWeight) { next = best; nextWeight = bestWeight; best = probe; bestWeight = w; }
+                else if (w > nextWeight) { next = probe; nextWeight = w; }
+            }
+
+            if (best) primaryRadiance = best->bakedCubemap;
+            if (best && next)
+            {
+                blendRadiance = next->bakedCubemap;
+                probeBlend = nextWeight / (bestWeight + nextWeight);
+            }
+        }
+
+        mr->update_uniforms_ibl(scene.ibl_irradianceCubemap.get(), primaryRadiance, brdfLut, blendRadiance, probeBlend);
+    }
+    mat->use();
+
+    // In single-pass stereo every submission is duplicated per eye (instance parity selects the viewport)
+    const uint32_t eyeCount = stereoSinglePassActive ? 2 : 1;
+
+    if (instanceCount > 1)
+    {
+        gl_mesh & mesh = r->mesh->mesh.get();
+
+        // GPU frustum cull: the compute pass compacts surviving matrices and writes the instance
+        // count straight into the indirect command, so the CPU never walks the batch. Attribute
+        // slots 6-9 are re-pointed at the compacted stream instead of the mesh's instance buffer.
+        if (gpuCuller && instanceBoundingSpheres.size() == instanceModelMatrices.size())
+        {
+            gpuCuller->dispatch(instanceBoundingSpheres, instanceModelMatrices, cullingFrustum, static_cast<uint32_t>(mesh.get_index_count()), eyeCount);
+
+            for (GLuint column = 0; column < 4; ++column)
+            {
+                mesh.set_instance_attribute_buffer(gpuCuller->get_visible_matrices(), 6 + column, 4, GL_FLOAT, GL_FALSE, sizeof(float4x4), (GLvoid *)(sizeof(float4) * column), eyeCount);
+            }
+
+            mesh.draw_elements_indirect(gpuCuller->get_commands());
+            return;
+        }
+
+        mesh.set_instance_data(sizeof(float4x4) * instanceModelMatrices.size(), instanceModelMatrices.data(), GL_STREAM_DRAW);
+
+        // A model matrix occupies four consecutive vec4 attribute slots (6, 7, 8, 9), advanced once
+        // per instance (or once per eye-pair of instances in stereo)
+        for (GLuint column = 0; column < 4; ++column)
+        {
+            mesh.set_instance_attribute(6 + column, 4, GL_FLOAT, GL_FALSE, sizeof(float4x4), (GLvoid *)(sizeof(float4) * column), eyeCount);
+        }
+
+        if (multiDrawIndirectSupported)
+        {
+            draw_elements_indirect_command cmd;
+            cmd.count = static_cast<GLuint>(mesh.get_index_count());
+            cmd.instanceCount = instanceCount * eyeCount;
+            indirectDrawBuffer.set_commands({ cmd }, GL_STREAM_DRAW);
+            mesh.draw_elements_indirect(indirectDrawBuffer);
+        }
+        else
+        {
+            mesh.draw_elements(static_cast<int>(instanceCount * eyeCount));
+        }
+    }
+    else
+    {
+        if (stereoSinglePassActive) r->mesh->mesh.get().draw_elements(2);
+        else r->mesh->draw();
+    }
+}
+
 void pbr_renderer::run_forward_pass(std::vector<const render_component *> & render_queue, const view_data & view, const render_payload & scene)
 {
+    scoped_pass_stats stats(passStats, "forward_pass-" + std::to_string(view.index));
+
+    if (gpuCuller) cullingFrustum = frustum(view.viewProjMatrix);
+
     if (settings.useDepthPrepass)
     {
         glEnable(GL_DEPTH_TEST);
@@ -316,29 +836,85 @@ void pbr_renderer::run_forward_pass(std::vector<const render_component *> & rend
         glDepthMask(GL_FALSE); // depth already comes from the prepass
     }
 
-    for (const render_component * r : render_queue)
+    // The queue arrives sorted by material, so components sharing a (mesh, material) pair form
+    // contiguous runs. Each run of two or more is submitted through the instanced path: per-instance
+    // model matrices are streamed into the mesh's instance buffer and the whole run becomes a single
+    // glDrawElementsInstanced call instead of one draw (and one UBO upload) per component.
+    size_t runBegin = 0;
+    while (runBegin < render_queue.size())
     {
-        update_per_object_uniform_buffer(r->world_transform->world_pose, r->local_transform->local_scale, r->material->receive_shadow, view);
+        const render_component * first = render_queue[runBegin];
+        material_interface * mat = first->material->material.get().get();
 
-        // Lookup the material component (materials[e]), .get() the asset_handle, and then .get() since 
-        // materials instances are stored as shared pointers. 
-        material_interface * mat = r->material->material.get().get();
-        mat->update_uniforms();
+        size_t runEnd = runBegin + 1;
+        if (settings.instancedDrawing && mat->supports_instancing() && !first->bone_palette)
+        {
+            // Skinned components never join a run: each one binds its own bone palette
+            while (runEnd < render_queue.size()
+                && render_queue[runEnd]->mesh->mesh.name == first->mesh->mesh.name
+                && render_queue[runEnd]->material->material.name == first->material->material.name
+                && render_queue[runEnd]->material->receive_shadow == first->material->receive_shadow
+                && !render_queue[runEnd]->bone_palette)
+            {
+                runEnd++;
+            }
+        }
 
-        // @todo - handle other specific material requirements here
-        if (auto * mr = dynamic_cast<polymer_pbr_standard*>(mat))
+        const uint32_t instanceCount = static_cast<uint32_t>(runEnd - runBegin);
+
+        if (instanceCount > 1)
         {
-            if (settings.shadowsEnabled)
+            instanceTransforms.clear();
+            instanceBoundingSpheres.clear();
+            for (size_t i = runBegin; i < runEnd; ++i)
             {
-                // @todo - ideally compile this out from the shader if not using shadows
-                mr->update_uniforms_shadow(shadow->get_output_texture());
+                const render_component * r = render_queue[i];
+                instanceTransforms.push(r->world_transform->world_pose, r->local_transform->local_scale);
+                if (gpuCuller) instanceBoundingSpheres.push_back(r->world_bounding_sphere);
             }
+            instanceTransforms.compose(instanceModelMatrices);
+
+            // The per-object UBO still carries the shared shadowing state (and the first
+            // instance's property block) for the batch; the model matrix comes from the
+            // instance attribute stream in the USE_INSTANCING variant.
+            update_per_object_uniform_buffer(first->get_entity(), first->world_transform->world_pose, first->local_transform->local_scale, *first->material, view);
+
+            mat->set_instanced(true);
+            submit_material_and_draw(first, instanceCount, scene);
+            mat->set_instanced(false);
+        }
+        else
+        {
+            update_per_object_uniform_buffer(first->get_entity(), first->world_transform->world_pose, first->local_transform->local_scale, *first->material, view);
+
+            if (first->bone_palette)
+            {
+                // Skinned meshes are excluded from the depth prepass (their depth would be
+                // the rigid bind pose), so this draw must write its own depth
+                if (settings.useDepthPrepass) glDepthMask(GL_TRUE);
 
-            mr->update_uniforms_ibl(scene.ibl_irradianceCubemap.get(), scene.ibl_radianceCubemap.get());
+                bind_bone_palette(*first->bone_palette);
+                mat->set_skinned(true);
+                submit_material_and_draw(first, 1, scene);
+                mat->set_skinned(false);
+
+                if (settings.useDepthPrepass) glDepthMask(GL_FALSE);
+            }
+            else
+            {
+                submit_material_and_draw(first, 1, scene);
+            }
         }
-        mat->use();
 
-        r->mesh->draw();
+        runBegin = runEnd;
+    }
+
+    // Far-field impostor batch: one instanced draw per atlas, alpha-tested with
+    // its own depth writes (impostors never run the prepass)
+    if (impostorBatch.instance_count() > 0)
+    {
+        if (settings.useDepthPrepass) glDepthMask(GL_TRUE);
+        impostorBatch.draw(view.viewProjMatrix, view.pose.position);
     }
 
     if (settings.useDepthPrepass)
@@ -347,10 +923,171 @@ void pbr_renderer::run_forward_pass(std::vector<const render_component *> & rend
     }
 }
 
+void pbr_renderer::run_transparency_pass(std::vector<const render_component *> & transparent_queue, const view_data & view, const render_payload & scene, const bool allow_oit)
+{
+    if (transparent_queue.empty()) return;
+
+    scoped_pass_stats stats(passStats, "transparency_pass-" + std::to_string(view.index));
+
+    // Transparents test against the opaque depth laid down by the forward pass but
+    // never write it, so sorted blending composes correctly against geometry.
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+
+    // Weighted-blended output needs its own accum/reveal targets sharing the eye
+    // depth, which only exists mid-frame on the single-sample direct path; the
+    // msaa and stereo paths fall back to sorted blending.
+    const bool useWeightedOIT = settings.weightedOITEnabled && allow_oit;
+
+    if (useWeightedOIT)
+    {
+        ensure_oit_targets();
+
+        const GLuint oitFbo = oitFramebuffers[view.index];
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, oitFbo);
+        const float clearAccum[4] = { 0.f, 0.f, 0.f, 0.f };
+        const float clearReveal[4] = { 1.f, 0.f, 0.f, 0.f };
+        glClearNamedFramebufferfv(oitFbo, GL_COLOR, 0, clearAccum);
+        glClearNamedFramebufferfv(oitFbo, GL_COLOR, 1, clearReveal);
+
+        // Both blend equations are commutative, which is the whole point: fragment
+        // order stops mattering, so overlapping particles never pop with sort order
+        glBlendFunci(0, GL_ONE, GL_ONE);                  // accum: weighted premultiplied sum
+        glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR); // reveal: multiplicative coverage
+    }
+    else
+    {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    // One submission per component: outside OIT the queue order is back-to-front
+    // and load-bearing, so runs never collapse into instanced draws here
+    for (const render_component * r : transparent_queue)
+    {
+        material_interface * mat = r->material->material.get().get();
+        mat->set_oit(useWeightedOIT);
+
+        update_per_object_uniform_buffer(r->get_entity(), r->world_transform->world_pose, r->local_transform->local_scale, *r->material, view);
+        submit_material_and_draw(r, 1, scene);
+
+        mat->set_oit(false);
+    }
+
+    if (useWeightedOIT)
+    {
+        // Resolve accum/reveal onto the scene color with one fullscreen composite
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, eyeFramebuffers[view.index]);
+        glViewport(0, 0, scaledRenderSize.x, scaledRenderSize.y);
+        glDisable(GL_DEPTH_TEST);
+        glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA); // src alpha carries revealage
+
+        oitCompositeShader.bind();
+        oitCompositeShader.texture("s_accum", 0, oitAccumTextures[view.index], GL_TEXTURE_2D);
+        oitCompositeShader.texture("s_reveal", 1, oitRevealTextures[view.index], GL_TEXTURE_2D);
+        oit_quad.draw_elements();
+        oitCompositeShader.unbind();
+
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+
+    gl_check_error(__FILE__, __LINE__);
+}
+
+void pbr_renderer::ensure_oit_targets()
+{
+    if (!oitFramebuffers.empty()) return;
+
+    oitFramebuffers.resize(settings.cameraCount);
+    oitAccumTextures.resize(settings.cameraCount);
+    oitRevealTextures.resize(settings.cameraCount);
+    oit_quad = make_fullscreen_quad();
+    oitCompositeShader = gl_shader(oit_composite_vert, oit_composite_frag);
+
+    for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
+    {
+        oitAccumTextures[camIdx].memory.set_category(gl_memory_category::render_targets);
+        oitAccumTextures[camIdx].setup(settings.renderSize.x, settings.renderSize.y, GL_RGBA16F, GL_RGBA, GL_FLOAT, nullptr, false);
+        glTextureParameteriEXT(oitAccumTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(oitAccumTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(oitAccumTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        oitRevealTextures[camIdx].memory.set_category(gl_memory_category::render_targets);
+        oitRevealTextures[camIdx].setup(settings.renderSize.x, settings.renderSize.y, GL_R16F, GL_RED, GL_FLOAT, nullptr, false);
+        glTextureParameteriEXT(oitRevealTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(oitRevealTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(oitRevealTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        // The view's depth texture is attached (not copied) so transparents depth-test
+        // against exactly the opaque depth the forward pass wrote
+        glNamedFramebufferTexture2DEXT(oitFramebuffers[camIdx], GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, oitAccumTextures[camIdx], 0);
+        glNamedFramebufferTexture2DEXT(oitFramebuffers[camIdx], GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, oitRevealTextures[camIdx], 0);
+        glNamedFramebufferTexture2DEXT(oitFramebuffers[camIdx], GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, eyeDepthTextures[camIdx], 0);
+
+        const GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glFramebufferDrawBuffersEXT(oitFramebuffers[camIdx], 2, drawBuffers);
+        oitFramebuffers[camIdx].check_complete();
+    }
+
+    gl_check_error(__FILE__, __LINE__);
+}
+
+void pbr_renderer::ensure_post_targets()
+{
+    if (!postFramebuffers.empty()) return;
+
+    postFramebuffers.resize(settings.cameraCount);
+    postTextures.resize(settings.cameraCount);
+    post_quad = make_fullscreen_quad();
+
+    for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
+    {
+        postTextures[camIdx].memory.set_category(gl_memory_category::render_targets);
+        postTextures[camIdx].setup(settings.renderSize.x, settings.renderSize.y, hdr_internal_format(settings.hdrPrecision), hdr_pixel_format(settings.hdrPrecision), GL_FLOAT, nullptr, false);
+        glTextureParameteriEXT(postTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(postTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(postTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glNamedFramebufferTexture2DEXT(postFramebuffers[camIdx], GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, postTextures[camIdx], 0);
+        postFramebuffers[camIdx].check_complete();
+    }
+
+    gl_check_error(__FILE__, __LINE__);
+}
+
+void pbr_renderer::ensure_taa_targets()
+{
+    if (!taaFramebuffers.empty()) return;
+
+    // Two full-resolution history surfaces per view, ping-ponged by frame parity
+    taaFramebuffers.resize(settings.cameraCount * 2);
+    taaTextures.resize(settings.cameraCount * 2);
+    taaPreviousViewProj.resize(settings.cameraCount, Identity4x4);
+    taaHistoryValid.resize(settings.cameraCount, 0);
+
+    for (size_t i = 0; i < taaTextures.size(); ++i)
+    {
+        taaTextures[i].memory.set_category(gl_memory_category::render_targets);
+        taaTextures[i].setup(settings.renderSize.x, settings.renderSize.y, hdr_internal_format(settings.hdrPrecision), hdr_pixel_format(settings.hdrPrecision), GL_FLOAT, nullptr, false);
+        glTextureParameteriEXT(taaTextures[i], GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(taaTextures[i], GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteriEXT(taaTextures[i], GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glNamedFramebufferTexture2DEXT(taaFramebuffers[i], GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, taaTextures[i], 0);
+        taaFramebuffers[i].check_complete();
+    }
+
+    gl_check_error(__FILE__, __LINE__);
+}
+
 void pbr_renderer::run_post_pass(const view_data & view, const render_payload & scene)
 {
     if (!settings.tonemapEnabled) return;
 
+    scoped_pass_stats stats(passStats, "post_pass-" + std::to_string(view.index));
+
     GLboolean wasCullingEnabled = glIsEnabled(GL_CULL_FACE);
     GLboolean wasDepthTestingEnabled = glIsEnabled(GL_DEPTH_TEST);
 
@@ -358,12 +1095,55 @@ void pbr_renderer::run_post_pass(const view_data & view, const render_payload &
     glDisable(GL_CULL_FACE);
     glDisable(GL_DEPTH_TEST);
 
+    // Temporal accumulation runs on the resolved HDR target ahead of tonemapping: history
+    // is reprojected through depth using last frame's view-proj, clamped to the 3x3
+    // neighborhood of the current sample to reject disocclusions, and blended in. Because
+    // the resolve blit already stretched the scaled sub-rect to full resolution, this one
+    // pass is both the antialias and the upscale.
+    GLuint postInput = eyeTextures[view.index];
+
+    if (settings.taaEnabled)
+    {
+        ensure_taa_targets();
+
+        const uint32_t writeIdx = view.index * 2 + (taaFrameIndex & 1);
+        const uint32_t readIdx = view.index * 2 + ((taaFrameIndex + 1) & 1);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, taaFramebuffers[writeIdx]);
+        glViewport(0, 0, settings.renderSize.x, settings.renderSize.y);
+
+        auto & taa = renderPassTaa.get()->get_variant()->shader;
+        taa.bind();
+        taa.uniform("u_reprojection", taaPreviousViewProj[view.index] * inverse(view.viewProjMatrix));
+        taa.uniform("u_feedback", taaHistoryValid[view.index] ? settings.taaFeedback : 0.f); // first frame: pass current through
+        taa.texture("s_current", 0, eyeTextures[view.index], GL_TEXTURE_2D);
+        taa.texture("s_history", 1, taaTextures[readIdx], GL_TEXTURE_2D);
+        taa.texture("s_depth", 2, eyeDepthTextures[view.index], GL_TEXTURE_2D);
+        post_quad.draw_elements();
+        taa.unbind();
+
+        taaPreviousViewProj[view.index] = view.viewProjMatrix; // unjittered on both ends of the reprojection
+        taaHistoryValid[view.index] = 1;
+
+        postInput = taaTextures[writeIdx];
+    }
+
+    // Meter the resolved HDR target and fold the result into the adapted exposure before
+    // tonemapping reads it; the reduction stays on the GPU so nothing stalls.
+    if (autoExposure)
+    {
+        autoExposure->dispatch(eyeTextures[view.index], settings.renderSize, frameDeltaSeconds);
+        autoExposure->bind();
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, postFramebuffers[view.index]);
     glViewport(0, 0, settings.renderSize.x, settings.renderSize.y);
 
-    auto & shader = renderPassTonemap.get()->get_variant()->shader;
+    auto & shader = autoExposure
+        ? renderPassTonemap.get()->get_variant({ "USE_AUTO_EXPOSURE" })->shader
+        : renderPassTonemap.get()->get_variant()->shader;
     shader.bind();
-    shader.texture("s_texColor", 0, eyeTextures[view.index], GL_TEXTURE_2D);
+    shader.texture("s_texColor", 0, postInput, GL_TEXTURE_2D);
     post_quad.draw_elements();
     shader.unbind();
 
@@ -376,14 +1156,32 @@ pbr_renderer::pbr_renderer(const renderer_settings settings) : settings(settings
     assert(settings.renderSize.x > 0 && settings.renderSize.y > 0);
     assert(settings.cameraCount >= 1);
 
+    // Categorize the streamed uniform blocks for the gl_memory_tracker totals
+    perScene.memory.set_category(gl_memory_category::uniform_buffers);
+    perView.memory.set_category(gl_memory_category::uniform_buffers);
+    perObject.memory.set_category(gl_memory_category::uniform_buffers);
+    perSkin.memory.set_category(gl_memory_category::uniform_buffers);
+
+    // The split-sum BRDF table is view and scene independent; a warm cache turns this
+    // into a file read, and a cold one integrates on the CPU and writes the cache.
+    {
+        brdf_lut_baker lutBaker;
+        brdfLut = lutBaker.get_or_bake(settings.brdfLutCachePath);
+    }
+
     eyeFramebuffers.resize(settings.cameraCount);
     eyeTextures.resize(settings.cameraCount);
     eyeDepthTextures.resize(settings.cameraCount);
 
-    // Generate multisample render buffers for color and depth, attach to multi-sampled framebuffer target
-    glNamedRenderbufferStorageMultisampleEXT(multisampleRenderbuffers[0], settings.msaaSamples, GL_RGBA, settings.renderSize.x, settings.renderSize.y);
+    // Generate multisample render buffers for color and depth, attach to multi-sampled framebuffer target.
+    // The color plane uses the configured HDR precision; half/packed floats halve post-chain bandwidth.
+    const GLenum hdrFormat = hdr_internal_format(settings.hdrPrecision);
+
+    glNamedRenderbufferStorageMultisampleEXT(multisampleRenderbuffers[0], settings.msaaSamples, hdrFormat, settings.renderSize.x, settings.renderSize.y);
+    multisampleRenderbuffers[0].record_storage(hdrFormat, settings.renderSize.x, settings.renderSize.y, settings.msaaSamples);
     glNamedFramebufferRenderbufferEXT(multisampleFramebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, multisampleRenderbuffers[0]);
     glNamedRenderbufferStorageMultisampleEXT(multisampleRenderbuffers[1], settings.msaaSamples, GL_DEPTH24_STENCIL8, settings.renderSize.x, settings.renderSize.y);
+    multisampleRenderbuffers[1].record_storage(GL_DEPTH24_STENCIL8, settings.renderSize.x, settings.renderSize.y, settings.msaaSamples);
     glNamedFramebufferRenderbufferEXT(multisampleFramebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, multisampleRenderbuffers[1]);
 
     multisampleFramebuffer.check_complete();
@@ -392,10 +1190,12 @@ pbr_renderer::pbr_renderer(const renderer_settings settings) : settings(settings
     for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
     {
         // Depth
+        eyeDepthTextures[camIdx].memory.set_category(gl_memory_category::render_targets);
         eyeDepthTextures[camIdx].setup(settings.renderSize.x, settings.renderSize.y, GL_DEPTH_COMPONENT32, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
 
         // Color
-        eyeTextures[camIdx].setup(settings.renderSize.x, settings.renderSize.y, GL_RGBA, GL_RGBA, GL_FLOAT, nullptr, false);
+        eyeTextures[camIdx].memory.set_category(gl_memory_category::render_targets);
+        eyeTextures[camIdx].setup(settings.renderSize.x, settings.renderSize.y, hdrFormat, hdr_pixel_format(settings.hdrPrecision), GL_FLOAT, nullptr, false);
         glTextureParameteriEXT(eyeTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTextureParameteriEXT(eyeTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTextureParameteriEXT(eyeTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
@@ -407,31 +1207,91 @@ pbr_renderer::pbr_renderer(const renderer_settings settings) : settings(settings
         eyeFramebuffers[camIdx].check_complete();
     }
 
-    if (settings.tonemapEnabled)
+    // Post targets are allocated lazily on first use (see ensure_post_targets) so a renderer
+    // constructed with tonemapping disabled never pays for them.
+
+    gl_check_error(__FILE__, __LINE__);
+
+    // Check once whether the driver can batch whole buckets into a single indirect submission,
+    // and whether per-object uniforms can be streamed through a persistently-mapped ring
+    std::vector<std::pair<std::string, bool>> requiredExtensions = { { "GL_ARB_multi_draw_indirect", false }, { "GL_ARB_buffer_storage", false } };
+    has_gl_extension(requiredExtensions);
+    multiDrawIndirectSupported = requiredExtensions[0].second;
+
+    // GPU frustum culling compacts instanced batches in compute and submits them indirectly,
+    // so it is only worth enabling where the indirect path exists
+    if (settings.gpuCullingEnabled && multiDrawIndirectSupported)
     {
-        postFramebuffers.resize(settings.cameraCount);
-        postTextures.resize(settings.cameraCount);
-        post_quad = make_fullscreen_quad();
+        gpuCuller.reset(new gpu_frustum_culler());
+        if (!gpuCuller->is_supported()) gpuCuller.reset();
+    }
+    persistentMappingSupported = requiredExtensions[1].second;
 
-        for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
+    // Resident bindless texture handles remove per-draw sampler binds entirely;
+    // opt-in because driver support is effectively nvidia-only
+    if (settings.bindlessTexturesEnabled)
+    {
+        std::vector<std::pair<std::string, bool>> bindlessExtensions = { { "GL_ARB_bindless_texture", false } };
+        has_gl_extension(bindlessExtensions);
+        bindlessTexturesSupported = bindlessExtensions[0].second;
+    }
+
+    // Each ring section holds one frame of per-object blocks at the UBO offset alignment
+    // (256b on typical hardware) across *all* views - begin_frame() rotates once per frame,
+    // not per view - so 4MB covers ~16k non-instanced draws per frame total (~8k per eye in
+    // stereo). Past that, write() reports exhaustion and draws spill to glBufferSubData.
+    if (persistentMappingSupported) perObjectRing.setup(4 * 1024 * 1024);
+
+    // Bone palettes are written per skinned entity per view; a full 256-bone palette is
+    // 16kB, so 2MB per section covers ~128 characters per frame.
+    if (persistentMappingSupported) perSkinRing.setup(2 * 1024 * 1024);
+
+    // Single-pass stereo submits geometry once for both eyes: instances are duplicated per eye
+    // and the vertex stage routes them to side-by-side viewports in a double-wide target.
+    if (settings.singlePassStereo && settings.cameraCount == 2)
+    {
+        std::vector<std::pair<std::string, bool>> stereoExtensions = { { "GL_ARB_shader_viewport_layer_array", false } };
+        has_gl_extension(stereoExtensions);
+        stereoSinglePassActive = stereoExtensions[0].second;
+
+        if (stereoSinglePassActive)
         {
-            postTextures[camIdx].setup(settings.renderSize.x, settings.renderSize.y, GL_RGBA, GL_RGBA, GL_FLOAT, nullptr, false);
-            glTextureParameteriEXT(postTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTextureParameteriEXT(postTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTextureParameteriEXT(postTextures[camIdx], GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
-            glNamedFramebufferTexture2DEXT(postFramebuffers[camIdx], GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, postTextures[camIdx], 0);
-            postFramebuffers[camIdx].check_complete();
+            glNamedRenderbufferStorageMultisampleEXT(stereoMultisampleRenderbuffers[0], settings.msaaSamples, hdrFormat, settings.renderSize.x * 2, settings.renderSize.y);
+            stereoMultisampleRenderbuffers[0].record_storage(hdrFormat, settings.renderSize.x * 2, settings.renderSize.y, settings.msaaSamples);
+            glNamedFramebufferRenderbufferEXT(stereoMultisampleFramebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, stereoMultisampleRenderbuffers[0]);
+            glNamedRenderbufferStorageMultisampleEXT(stereoMultisampleRenderbuffers[1], settings.msaaSamples, GL_DEPTH24_STENCIL8, settings.renderSize.x * 2, settings.renderSize.y);
+            stereoMultisampleRenderbuffers[1].record_storage(GL_DEPTH24_STENCIL8, settings.renderSize.x * 2, settings.renderSize.y, settings.msaaSamples);
+            glNamedFramebufferRenderbufferEXT(stereoMultisampleFramebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, stereoMultisampleRenderbuffers[1]);
+            stereoMultisampleFramebuffer.check_complete();
         }
     }
 
-    gl_check_error(__FILE__, __LINE__);
-
-    // Only create shadow resources if the user has requested them. 
+    // Only create shadow resources if the user has requested them.
     if (settings.shadowsEnabled)
     {
         shadow.reset(new stable_cascaded_shadows());
     }
 
+    if (settings.occlusionCullingEnabled)
+    {
+        hiz.reset(new hi_z_occlusion_culler(settings.renderSize));
+    }
+
+    if (settings.sdsmShadowsEnabled && settings.shadowsEnabled)
+    {
+        depthReducer.reset(new depth_bounds_reducer());
+    }
+
+    if (settings.clusteredLightingEnabled)
+    {
+        clusterGrid.reset(new cluster_light_grid());
+    }
+
+    if (settings.autoExposureEnabled)
+    {
+        autoExposure.reset(new auto_exposure());
+    }
+
     // Respect performance profiling settings on construction
     gpuProfiler.set_enabled(settings.performanceProfiling);
     cpuProfiler.set_enabled(settings.performanceProfiling);
@@ -448,8 +1308,94 @@ void pbr_renderer::render_frame(const render_payload & scene)
 {
     assert(settings.cameraCount == scene.views.size());
 
+    passStats.clear();
     cpuProfiler.begin("render_frame");
 
+    // New frame, new budget for unresolved texture probes (see texture_handle::get_or)
+    texture_handle::begin_resolution_frame();
+
+    // Late-latch: let the app rewrite each view from the freshest tracking
+    // sample before any pass consumes the matrices. The payload is rebuilt by
+    // the caller every frame, so mutating the views here is safe.
+    if (late_latch_callback)
+    {
+        for (view_data & view : const_cast<render_payload &>(scene).views)
+        {
+            late_latch_callback(view);
+        }
+    }
+
+    // Frame delta for time-dependent effects (exposure adaptation)
+    {
+        const float nowMs = static_cast<float>(timer.milliseconds().count());
+        frameDeltaSeconds = clamp((nowMs - lastFrameTimeMs) / 1000.f, 0.f, 0.1f);
+        lastFrameTimeMs = nowMs;
+    }
+
+    // Dynamic time-of-day: when the procedural sun has moved, re-capture and
+    // re-convolve the scene IBL one slice per frame; the finished pair swaps in
+    // through the texture handles, so lighting follows the sun without a stall.
+    if (settings.dynamicSkyProbes && scene.skybox)
+    {
+        if (!skyProbeUpdater && !scene.ibl_radianceCubemap.name.empty() && !scene.ibl_irradianceCubemap.name.empty())
+        {
+            skyProbeUpdater.reset(new environment_probe_updater(scene.ibl_radianceCubemap.name, scene.ibl_irradianceCubemap.name));
+        }
+
+        if (skyProbeUpdater)
+        {
+            const float2 sun = scene.skybox->get_sun_position();
+            if (sun != lastSunPosition)
+            {
+                skyProbeUpdater->request_refresh();
+                lastSunPosition = sun;
+            }
+            skyProbeUpdater->step(*scene.skybox);
+        }
+    }
+
+    // Dynamic resolution: nudge the render scale using last frame's whole-frame GPU time.
+    // The timestamp queries are asynchronous so feedback arrives a frame or two late, which
+    // suits a controller that backs off quickly and recovers slowly. All passes render into
+    // a scaled sub-rect of the existing targets; the resolve blit stretches it back out, so
+    // no render target is ever reallocated.
+    if (settings.dynamicResolutionEnabled)
+    {
+        const double frameMs = frameGpuTimer.elapsed_ms();
+        if (frameMs > 0.0)
+        {
+            if (frameMs > settings.targetFrameTimeMs) resolutionScale -= 0.04f;
+            else if (frameMs < settings.targetFrameTimeMs * 0.80f) resolutionScale += 0.01f;
+            resolutionScale = clamp(resolutionScale, 0.5f, 1.f);
+        }
+        frameGpuTimer.start();
+    }
+    else resolutionScale = 1.f;
+
+    // Temporal upsampling renders geometry at a fixed reduced scale through the same
+    // sub-rect path; the dynamic controller takes precedence when both are enabled
+    if (settings.taaEnabled && !settings.dynamicResolutionEnabled)
+    {
+        resolutionScale = clamp(settings.taaRenderScale, 0.5f, 1.f);
+    }
+
+    scaledRenderSize = int2(
+        std::max(1, static_cast<int>(settings.renderSize.x * resolutionScale)),
+        std::max(1, static_cast<int>(settings.renderSize.y * resolutionScale)));
+
+    // Sub-pixel projection jitter (applied at per-view UBO fill so culling and shadow
+    // matrices stay stable); the post-pass accumulation resolves it back out
+    if (settings.taaEnabled)
+    {
+        taaJitterPixels = float2(
+            halton_sequence((taaFrameIndex % 8) + 1, 2) - 0.5f,
+            halton_sequence((taaFrameIndex % 8) + 1, 3) - 0.5f);
+        taaJitterMatrix = make_translation_matrix({
+            2.f * taaJitterPixels.x / static_cast<float>(scaledRenderSize.x),
+            2.f * taaJitterPixels.y / static_cast<float>(scaledRenderSize.y), 0.f });
+    }
+    else taaJitterMatrix = Identity4x4;
+
     // Renderer default state
     glEnable(GL_CULL_FACE);
     glEnable(GL_DEPTH_TEST);
@@ -457,14 +1403,17 @@ void pbr_renderer::render_frame(const render_payload & scene)
 
     glBindBufferBase(GL_UNIFORM_BUFFER, uniforms::per_scene::binding, perScene);
     glBindBufferBase(GL_UNIFORM_BUFFER, uniforms::per_view::binding, perView);
-    glBindBufferBase(GL_UNIFORM_BUFFER, uniforms::per_object::binding, perObject);
+
+    // Per-object data is range-bound out of the ring as objects are submitted
+    if (persistentMappingSupported) perObjectRing.begin_frame();
+    if (persistentMappingSupported) perSkinRing.begin_frame();
+    else glBindBufferBase(GL_UNIFORM_BUFFER, uniforms::per_object::binding, perObject);
 
     // Update per-scene uniform buffer
     uniforms::per_scene b = {};
     b.time = timer.milliseconds().count() / 1000.f; // expressed in seconds
-    b.resolution = float2(settings.renderSize);
+    b.resolution = float2(scaledRenderSize); // matches gl_FragCoord extents (cluster lookup depends on this)
     b.invResolution = 1.f / b.resolution;
-    b.activePointLights = static_cast<int>(scene.point_lights.size());
     b.sunlightActive = 0;
 
     if (scene.sunlight)
@@ -475,14 +1424,18 @@ void pbr_renderer::render_frame(const render_payload & scene)
         b.directional_light.amount = scene.sunlight->data.amount;
     }
 
-    assert(scene.point_lights.size() <= uniforms::MAX_POINT_LIGHTS);
+    // When clustered lighting is active the SSBO path carries the full light list; the legacy
+    // uniform array is still filled (up to its cap) for materials compiled without the define.
+    if (!clusterGrid) assert(scene.point_lights.size() <= uniforms::MAX_POINT_LIGHTS);
     uint32_t lightIdx = 0;
     for (auto & light : scene.point_lights)
     {
         if (!light->enabled) continue;
+        if (lightIdx >= uniforms::MAX_POINT_LIGHTS) break;
         b.point_lights[lightIdx] = light->data;
         lightIdx++;
     }
+    b.activePointLights = static_cast<int>(lightIdx);
 
     GLfloat defaultColor[] = { scene.clear_color.x, scene.clear_color.y, scene.clear_color.z, scene.clear_color.w };
     GLfloat defaultDepth = 1.f;
@@ -508,9 +1461,148 @@ void pbr_renderer::render_frame(const render_payload & scene)
         near_far_clip_from_projection(shadowAndCullingView.projectionMatrix, shadowAndCullingView.nearClip, shadowAndCullingView.farClip);
     }
 
-    // Shadow pass can only run if we've configured a directional sunlight
+    // The shadow pass and the per-scene upload (which consumes the cascade matrices) are
+    // scheduled through the frame graph below rather than executed here.
+
+    // We follow the sorting strategy outlined here: http://realtimecollisiondetection.net/blog/?p=86
+    // Each component gets a 64-bit draw key: program handle (most expensive state change), then
+    // material instance, then view depth quantized front-to-back. The low 16 bits carry the
+    // component's index into the payload so the sorted key array can be scattered back into pointer
+    // order without needing a separate key-value sort. The keys are integer-sorted with the
+    // lib-polymer radix sort, which is stable and avoids the comparator overhead measured here before.
+    // Blended materials (fx surfaces) split into a second key array sorted back-to-front by
+    // depth alone and draw in the dedicated transparency pass after the opaque forward pass.
+    // Hi-Z occlusion: gather last frame's verdicts, then test this frame's bounds against a
+    // depth pyramid built from the previous frame's resolved depth (one frame of latency, no stall).
+    // Shadow casters are deliberately left unculled; an object occluded from the camera can still
+    // cast a visible shadow.
+    if (hiz)
+    {
+        cpuProfiler.begin("hi-z-occlusion");
+        hiz->gather_results();
+        if (havePreviousViewProj)
+        {
+            std::vector<std::pair<uint64_t, float4>> occlusionBounds;
+            occlusionBounds.reserve(scene.render_components.size());
+            for (const render_component & rc : scene.render_components)
+            {
+                occlusionBounds.emplace_back(rc.get_entity(), rc.world_bounding_sphere);
+            }
+            hiz->dispatch(eyeDepthTextures[0], occlusionBounds, previousViewProjMatrix);
+        }
+        cpuProfiler.end("hi-z-occlusion");
+    }
+
+    cpuProfiler.begin("sort-render_queue_material");
+
+    const size_t componentCount = scene.render_components.size();
 
-    if (settings.shadowsEnabled && scene.sunlight)
+    // The fast path packs the component index into the low 16 bits of the radix key;
+    // past 65535 components the pack would wrap and scatter duplicate draws, so
+    // oversized scenes carry indices in a side array and pay for a comparator
+    // pair-sort instead - correct, just slower, and worth a one-time warning since
+    // a scene that large should be instancing or batching.
+    const bool packedIndices = componentCount < 65536;
+    if (!packedIndices)
+    {
+        static bool warned = false;
+        if (!warned) { log::get()->engine_log->warn("{} render components exceed the packed draw-key limit; using the comparator sort path", componentCount); warned = true; }
+    }
+
+    drawKeys.clear();
+    transparentDrawKeys.clear();
+    impostorBatch.clear();
+    std::vector<uint32_t> drawKeyIndices, transparentDrawKeyIndices;
+    const float invFarClip = 1.f / shadowAndCullingView.farClip;
+
+    for (size_t i = 0; i < componentCount; ++i)
+    {
+        const render_component & rc = scene.render_components[i];
+
+        if (hiz && !hiz->is_visible(rc.get_entity())) continue;
+
+        // Far-field impostors skip material sorting entirely and accumulate into
+        // one instanced draw per atlas at the end of the forward pass
+        if (rc.impostor)
+        {
+            const bool hasSphere = rc.world_bounding_sphere.w > 0.f;
+            const float3 center = hasSphere ? rc.world_bounding_sphere.xyz() : rc.world_transform->world_pose.position;
+            const float radius = hasSphere ? rc.world_bounding_sphere.w : rc.impostor->radius * maxelem(rc.local_transform->local_scale);
+            impostorBatch.add(*rc.impostor, center, radius);
+            continue;
+        }
+
+        material_interface * mat = rc.material->material.get().get();
+
+        const float dist = distance(shadowAndCullingView.pose.position, rc.world_transform->world_pose.position);
+        const uint64_t depthKey = static_cast<uint64_t>(std::min(dist * invFarClip, 1.f) * 65535.f) & 0xffff;
+
+        // Blended materials leave the opaque queue entirely: their ordering is a
+        // correctness requirement, so depth (inverted, back-to-front) is the whole
+        // key and program/material grouping is forfeited.
+        if (mat->requires_blending())
+        {
+            transparentDrawKeys.push_back(((depthKey ^ 0xffff) << 16) | (packedIndices ? (i & 0xffff) : 0));
+            if (!packedIndices) transparentDrawKeyIndices.push_back(static_cast<uint32_t>(i));
+            continue;
+        }
+
+        const uint64_t programKey = mat->id() & 0xffff;
+        const uint64_t materialKey = std::hash<std::string>{}(rc.material->material.name) & 0xffff;
+
+        drawKeys.push_back((programKey << 48) | (materialKey << 32) | (depthKey << 16) | (packedIndices ? (i & 0xffff) : 0));
+        if (!packedIndices) drawKeyIndices.push_back(static_cast<uint32_t>(i));
+    }
+
+    std::vector<const render_component *> render_queue_material(drawKeys.size());
+    std::vector<const render_component *> render_queue_transparent(transparentDrawKeys.size());
+
+    if (packedIndices)
+    {
+        drawKeySorter.sort(drawKeys.data(), drawKeys.size());
+        drawKeySorter.sort(transparentDrawKeys.data(), transparentDrawKeys.size());
+
+        for (size_t i = 0; i < drawKeys.size(); ++i)
+        {
+            render_queue_material[i] = &scene.render_components[drawKeys[i] & 0xffff];
+        }
+        for (size_t i = 0; i < transparentDrawKeys.size(); ++i)
+        {
+            render_queue_transparent[i] = &scene.render_components[transparentDrawKeys[i] & 0xffff];
+        }
+    }
+    else
+    {
+        // Stable pair-sort keeps the same key ordering semantics as the radix path
+        auto sort_with_indices = [](std::vector<uint64_t> & keys, std::vector<uint32_t> & indices)
+        {
+            std::vector<std::pair<uint64_t, uint32_t>> zipped(keys.size());
+            for (size_t j = 0; j < keys.size(); ++j) zipped[j] = { keys[j], indices[j] };
+            std::stable_sort(zipped.begin(), zipped.end(), [](const std::pair<uint64_t, uint32_t> & a, const std::pair<uint64_t, uint32_t> & b) { return a.first < b.first; });
+            for (size_t j = 0; j < keys.size(); ++j) indices[j] = zipped[j].second;
+        };
+        sort_with_indices(drawKeys, drawKeyIndices);
+        sort_with_indices(transparentDrawKeys, transparentDrawKeyIndices);
+
+        for (size_t i = 0; i < drawKeyIndices.size(); ++i)
+        {
+            render_queue_material[i] = &scene.render_components[drawKeyIndices[i]];
+        }
+        for (size_t i = 0; i < transparentDrawKeyIndices.size(); ++i)
+        {
+            render_queue_transparent[i] = &scene.render_components[transparentDrawKeyIndices[i]];
+        }
+    }
+
+    cpuProfiler.end("sort-render_queue_material");
+
+    // Declarative schedule for the rest of the frame. Each pass names the logical resources
+    // it reads and writes; compile() orders writer-before-reader and culls work that no
+    // marked output consumes (e.g. the whole post chain when tonemapping is off, or the
+    // stencil prepass when no hidden-area mask is set).
+    frameGraph.reset();
+
+    frameGraph.add_pass({ "shadow", {}, { "shadow-cascades" }, [&]()
     {
         cpuProfiler.begin("run_shadow_pass");
         gpuProfiler.begin("run_shadow_pass");
@@ -525,115 +1617,270 @@ void pbr_renderer::render_frame(const render_payload & scene)
             b.cascadesNear[c] = shadow->nearPlanes[c];
             b.cascadesFar[c] = shadow->farPlanes[c];
         }
-    }
+    }, settings.shadowsEnabled && scene.sunlight != nullptr });
 
-    // Per-scene can be uploaded now that the shadow pass has completed
-    perScene.set_buffer_data(sizeof(b), &b, GL_STREAM_DRAW);
-
-    // We follow the sorting strategy outlined here: http://realtimecollisiondetection.net/blog/?p=86
-    auto materialSortFunc = [this, scene, shadowAndCullingView](const render_component * lhs, const render_component * rhs)
+    // Uploaded through the graph so it always lands after the cascade matrices are final
+    frameGraph.add_pass({ "upload-per-scene", { "shadow-cascades" }, { "per-scene" }, [&]()
     {
-        // Sort by material (expensive shader state change)
-        // @fixme - why is this so expensive? Adds an additional ~2ms to the sort
-        auto lid = lhs->material->material.get()->id();
-        auto rid = rhs->material->material.get()->id();
-        if (lid != rid) return lid > rid;
-
-        const float lDist = distance(shadowAndCullingView.pose.position, lhs->world_transform->world_pose.position);
-        const float rDist = distance(shadowAndCullingView.pose.position, rhs->world_transform->world_pose.position);
+        perScene.set_buffer_data(sizeof(b), &b, GL_STREAM_DRAW);
+    } });
 
-        // Otherwise sort by distance
-        return lDist < rDist;
-    };
-
-    cpuProfiler.begin("sort-render_queue_material");
-    std::vector<const render_component *> render_queue_material(scene.render_components.size());
-    for (int i = 0; i < scene.render_components.size(); ++i) 
-    { 
-        render_queue_material[i] = (&(scene.render_components[i]));
-    }
-    std::sort(render_queue_material.begin(), render_queue_material.end(), materialSortFunc);
-    cpuProfiler.end("sort-render_queue_material");
-
-    for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
+    if (stereoSinglePassActive)
     {
-        // Update per-view uniform buffer
+        frameGraph.add_pass({ "stereo-forward", { "per-scene", "shadow-cascades" }, { "eye-color-0", "eye-color-1" }, [&]()
+        {
+        // Single-pass stereo: one cull, one uniform update, and one set of draws covering
+        // both eyes. The mono per-view slots carry the centered superfrustum (used by passes
+        // that are not eye-dependent); the stereo arrays carry the real eye matrices.
         uniforms::per_view v = {};
-        v.view = scene.views[camIdx].viewMatrix;
-        v.viewProj = scene.views[camIdx].viewProjMatrix;
-        v.eyePos = float4(scene.views[camIdx].pose.position, 1);
+        v.view = shadowAndCullingView.viewMatrix;
+        v.viewProj = shadowAndCullingView.projectionMatrix * shadowAndCullingView.viewMatrix;
+        v.eyePos = float4(shadowAndCullingView.pose.position, 1);
+        v.nearFarClip = float4(shadowAndCullingView.nearClip, shadowAndCullingView.farClip, 0, 0);
+        for (uint32_t eyeIdx = 0; eyeIdx < 2; ++eyeIdx)
+        {
+            v.viewStereo[eyeIdx] = scene.views[eyeIdx].viewMatrix;
+            v.viewProjStereo[eyeIdx] = taaJitterMatrix * scene.views[eyeIdx].viewProjMatrix; // identity jitter unless taa is on
+            v.eyePosStereo[eyeIdx] = float4(scene.views[eyeIdx].pose.position, 1);
+        }
         perView.set_buffer_data(sizeof(v), &v, GL_STREAM_DRAW);
 
-        // Render into multisampled fbo
+        // Lights are binned once against the superfrustum; the per-eye error is bounded by the
+        // interocular distance, well under the conservative tile footprint.
+        if (clusterGrid)
+        {
+            cpuProfiler.begin("cluster-binning-stereo");
+            clusterGrid->update(scene.point_lights, shadowAndCullingView.viewMatrix, shadowAndCullingView.projectionMatrix,
+                shadowAndCullingView.nearClip, shadowAndCullingView.farClip);
+            clusterGrid->bind();
+            cpuProfiler.end("cluster-binning-stereo");
+        }
+
+        const float eyeWidth = static_cast<float>(scaledRenderSize.x);
+        const float eyeHeight = static_cast<float>(scaledRenderSize.y);
+
         glEnable(GL_MULTISAMPLE);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, multisampleFramebuffer);
-        glViewport(0, 0, settings.renderSize.x, settings.renderSize.y);
-        glClearNamedFramebufferfv(multisampleFramebuffer, GL_COLOR, 0, &defaultColor[0]);
-        glClearNamedFramebufferfv(multisampleFramebuffer, GL_DEPTH, 0, &defaultDepth);
-        if (using_stencil_mask) glClearNamedFramebufferuiv(multisampleFramebuffer, GL_STENCIL, 0, &defaultStencil);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, stereoMultisampleFramebuffer);
+        glClearNamedFramebufferfv(stereoMultisampleFramebuffer, GL_COLOR, 0, &defaultColor[0]);
+        glClearNamedFramebufferfv(stereoMultisampleFramebuffer, GL_DEPTH, 0, &defaultDepth);
+        if (using_stencil_mask) glClearNamedFramebufferuiv(stereoMultisampleFramebuffer, GL_STENCIL, 0, &defaultStencil);
+
+        // One viewport per eye, side by side; vertex stage routes instances by gl_ViewportIndex
+        glViewportIndexedf(0, 0.f, 0.f, eyeWidth, eyeHeight);
+        glViewportIndexedf(1, eyeWidth, 0.f, eyeWidth, eyeHeight);
 
         if (settings.useDepthPrepass)
         {
-            gpuProfiler.begin("depth-prepass-" + std::to_string(camIdx));
-            run_depth_prepass(scene.views[camIdx], scene);
-            gpuProfiler.end("depth-prepass-" + std::to_string(camIdx));
+            gpuProfiler.begin("depth-prepass-stereo");
+            run_depth_prepass(shadowAndCullingView, scene);
+            gpuProfiler.end("depth-prepass-stereo");
         }
 
-        // Hidden area mesh for stereo rendering with openvr
-        if (using_stencil_mask)
+        // The stencil mask and skybox are not stereo-aware, so they run per eye with
+        // viewport 0 (the default route for non-stereo shaders) moved over each half.
+        for (uint32_t eyeIdx = 0; eyeIdx < 2; ++eyeIdx)
         {
-            cpuProfiler.begin("run_stencil_prepass-" + std::to_string(camIdx));
-            gpuProfiler.begin("run_stencil_prepass-" + std::to_string(camIdx));
-            run_stencil_prepass(scene.views[camIdx], scene);
-            gpuProfiler.end("run_stencil_prepass-" + std::to_string(camIdx));
-            cpuProfiler.end("run_stencil_prepass-" + std::to_string(camIdx));
+            glViewportIndexedf(0, eyeIdx * eyeWidth, 0.f, eyeWidth, eyeHeight);
+            if (using_stencil_mask) run_stencil_prepass(scene.views[eyeIdx], scene);
+            run_skybox_pass(scene.views[eyeIdx], scene);
         }
+        glViewportIndexedf(0, 0.f, 0.f, eyeWidth, eyeHeight);
 
-        // Execute the forward passes
-        gpuProfiler.begin("run_skybox_pass-" + std::to_string(camIdx));
-        cpuProfiler.begin("run_skybox_pass-" + std::to_string(camIdx));
-        run_skybox_pass(scene.views[camIdx], scene);
-        cpuProfiler.end("run_skybox_pass-" + std::to_string(camIdx));
-        gpuProfiler.end("run_skybox_pass-" + std::to_string(camIdx));
+        gpuProfiler.begin("run_forward_pass-stereo");
+        cpuProfiler.begin("run_forward_pass-stereo");
+        run_forward_pass(render_queue_material, shadowAndCullingView, scene);
+        cpuProfiler.end("run_forward_pass-stereo");
+        gpuProfiler.end("run_forward_pass-stereo");
 
-        gpuProfiler.begin("run_forward_pass-" + std::to_string(camIdx));
-        cpuProfiler.begin("run_forward_pass-" + std::to_string(camIdx));
-        run_forward_pass(render_queue_material, scene.views[camIdx], scene);
-        cpuProfiler.end("run_forward_pass-" + std::to_string(camIdx));
-        gpuProfiler.end("run_forward_pass-" + std::to_string(camIdx));
+        // Transparents follow the opaques into the shared stereo target. Always the
+        // sorted path here: the per-eye depth needed by the OIT targets does not
+        // exist until the resolve below. Sort order comes from the superfrustum,
+        // whose per-eye error is bounded by the interocular distance.
+        run_transparency_pass(render_queue_transparent, shadowAndCullingView, scene, false);
 
         glDisable(GL_MULTISAMPLE);
 
-        // Resolve multisample into per-view framebuffer
+        // Resolve each half into its per-eye framebuffer so downstream consumers are unchanged
+        gpuProfiler.begin("blit-stereo");
+        for (uint32_t eyeIdx = 0; eyeIdx < 2; ++eyeIdx)
         {
-            gpuProfiler.begin("blit-" + std::to_string(camIdx));
+            const int32_t srcX = eyeIdx * scaledRenderSize.x;
 
-            // blit color 
-            glBlitNamedFramebuffer(multisampleFramebuffer, eyeFramebuffers[camIdx],
-                0, 0, settings.renderSize.x, settings.renderSize.y, 0, 0,
+            glBlitNamedFramebuffer(stereoMultisampleFramebuffer, eyeFramebuffers[eyeIdx],
+                srcX, 0, srcX + scaledRenderSize.x, scaledRenderSize.y, 0, 0,
                 settings.renderSize.x, settings.renderSize.y, GL_COLOR_BUFFER_BIT, GL_LINEAR);
 
-            // blit depth
-            glBlitNamedFramebuffer(multisampleFramebuffer, eyeFramebuffers[camIdx],
-                0, 0, settings.renderSize.x, settings.renderSize.y, 0, 0,
-                settings.renderSize.x, settings.renderSize.y, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+            if (settings.depthResolveEnabled || settings.taaEnabled || hiz || depthReducer) // taa reprojects history by resolved depth
+            {
+                glBlitNamedFramebuffer(stereoMultisampleFramebuffer, eyeFramebuffers[eyeIdx],
+                    srcX, 0, srcX + scaledRenderSize.x, scaledRenderSize.y, 0, 0,
+                    settings.renderSize.x, settings.renderSize.y, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+            }
+        }
+        gpuProfiler.end("blit-stereo");
+        } });
+    }
+    else
+    {
+        // The shared MSAA target serializes the per-view passes through write-after-write and
+        // write-after-read edges on "msaa", so views execute in submission order while passes
+        // with no surviving consumer drop out of the schedule entirely.
+        //
+        // Single-sample fast path: with msaa off, no hidden-area stencil mask, and no pending
+        // dynamic-resolution upscale, every per-view pass renders straight into the eye
+        // framebuffer and the resolve pass is never declared, so compile() schedules no blit
+        // at all. Otherwise the resolve stays a declared pass and survives only while
+        // something downstream (the post chain or the marked output) reads its color.
+        const bool renderDirectToEye = settings.msaaSamples <= 1 && !using_stencil_mask && scaledRenderSize == settings.renderSize;
+
+        for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
+        {
+            const std::string idx = std::to_string(camIdx);
+            const std::string sceneTarget = renderDirectToEye ? "eye-color-" + idx : "msaa";
 
-            gpuProfiler.end("blit-" + std::to_string(camIdx));
+            frameGraph.add_pass({ "begin-view-" + idx, {}, { sceneTarget, "per-view" }, [this, &scene, &defaultColor, &defaultDepth, &defaultStencil, renderDirectToEye, camIdx]()
+            {
+                // Update per-view uniform buffer
+                uniforms::per_view v = {};
+                v.view = scene.views[camIdx].viewMatrix;
+                v.viewProj = taaJitterMatrix * scene.views[camIdx].viewProjMatrix; // identity jitter unless taa is on
+                v.eyePos = float4(scene.views[camIdx].pose.position, 1);
+                v.nearFarClip = float4(scene.views[camIdx].nearClip, scene.views[camIdx].farClip, 0, 0);
+                perView.set_buffer_data(sizeof(v), &v, GL_STREAM_DRAW);
+
+                // Bin this view's point lights into froxels and bind the cluster SSBOs
+                if (clusterGrid)
+                {
+                    cpuProfiler.begin("cluster-binning-" + std::to_string(camIdx));
+                    clusterGrid->update(scene.point_lights, scene.views[camIdx].viewMatrix, scene.views[camIdx].projectionMatrix,
+                        scene.views[camIdx].nearClip, scene.views[camIdx].farClip);
+                    clusterGrid->bind();
+                    cpuProfiler.end("cluster-binning-" + std::to_string(camIdx));
+                }
+
+                // Render into the multisampled fbo, or straight into the eye framebuffer on
+                // the single-sample path (same formats, so downstream consumers are unchanged)
+                const GLuint sceneFramebuffer = renderDirectToEye ? GLuint(eyeFramebuffers[camIdx]) : GLuint(multisampleFramebuffer);
+                if (!renderDirectToEye) glEnable(GL_MULTISAMPLE);
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, sceneFramebuffer);
+                glViewport(0, 0, scaledRenderSize.x, scaledRenderSize.y);
+                glClearNamedFramebufferfv(sceneFramebuffer, GL_COLOR, 0, &defaultColor[0]);
+                glClearNamedFramebufferfv(sceneFramebuffer, GL_DEPTH, 0, &defaultDepth);
+                if (using_stencil_mask) glClearNamedFramebufferuiv(multisampleFramebuffer, GL_STENCIL, 0, &defaultStencil);
+            } });
+
+            frameGraph.add_pass({ "depth-prepass-" + idx, { "per-view" }, { sceneTarget }, [this, &scene, camIdx]()
+            {
+                gpuProfiler.begin("depth-prepass-" + std::to_string(camIdx));
+                run_depth_prepass(scene.views[camIdx], scene);
+                gpuProfiler.end("depth-prepass-" + std::to_string(camIdx));
+            }, settings.useDepthPrepass });
+
+            // Hidden area mesh for stereo rendering with openvr
+            frameGraph.add_pass({ "stencil-prepass-" + idx, { "per-view" }, { sceneTarget }, [this, &scene, camIdx]()
+            {
+                cpuProfiler.begin("run_stencil_prepass-" + std::to_string(camIdx));
+                gpuProfiler.begin("run_stencil_prepass-" + std::to_string(camIdx));
+                run_stencil_prepass(scene.views[camIdx], scene);
+                gpuProfiler.end("run_stencil_prepass-" + std::to_string(camIdx));
+                cpuProfiler.end("run_stencil_prepass-" + std::to_string(camIdx));
+            }, using_stencil_mask });
+
+            frameGraph.add_pass({ "skybox-" + idx, { "per-view" }, { sceneTarget }, [this, &scene, camIdx]()
+            {
+                gpuProfiler.begin("run_skybox_pass-" + std::to_string(camIdx));
+                cpuProfiler.begin("run_skybox_pass-" + std::to_string(camIdx));
+                run_skybox_pass(scene.views[camIdx], scene);
+                cpuProfiler.end("run_skybox_pass-" + std::to_string(camIdx));
+                gpuProfiler.end("run_skybox_pass-" + std::to_string(camIdx));
+            }, scene.skybox != nullptr });
+
+            frameGraph.add_pass({ "forward-" + idx, { "per-view", "per-scene", "shadow-cascades" }, { sceneTarget }, [this, &scene, &render_queue_material, camIdx]()
+            {
+                gpuProfiler.begin("run_forward_pass-" + std::to_string(camIdx));
+                cpuProfiler.begin("run_forward_pass-" + std::to_string(camIdx));
+                run_forward_pass(render_queue_material, scene.views[camIdx], scene);
+                cpuProfiler.end("run_forward_pass-" + std::to_string(camIdx));
+                gpuProfiler.end("run_forward_pass-" + std::to_string(camIdx));
+            } });
+
+            // Blended components draw after all opaques, back-to-front with depth writes
+            // off (weighted-blended OIT when enabled and the direct path makes the eye
+            // depth available mid-frame)
+            frameGraph.add_pass({ "transparency-" + idx, { "per-view", "per-scene", "shadow-cascades" }, { sceneTarget }, [this, &scene, &render_queue_transparent, camIdx, renderDirectToEye]()
+            {
+                gpuProfiler.begin("run_transparency_pass-" + std::to_string(camIdx));
+                cpuProfiler.begin("run_transparency_pass-" + std::to_string(camIdx));
+                run_transparency_pass(render_queue_transparent, scene.views[camIdx], scene, renderDirectToEye);
+                cpuProfiler.end("run_transparency_pass-" + std::to_string(camIdx));
+                gpuProfiler.end("run_transparency_pass-" + std::to_string(camIdx));
+            }, !render_queue_transparent.empty() });
+
+            // Resolve multisample into per-view framebuffer. Never declared on the direct
+            // path, where color and depth already live in the eye textures.
+            if (!renderDirectToEye)
+            {
+                frameGraph.add_pass({ "resolve-" + idx, { "msaa" }, { "eye-color-" + idx }, [this, camIdx]()
+                {
+                    glDisable(GL_MULTISAMPLE);
+
+                    gpuProfiler.begin("blit-" + std::to_string(camIdx));
+
+                    // blit color (the resolve doubles as the dynamic-resolution upscale)
+                    glBlitNamedFramebuffer(multisampleFramebuffer, eyeFramebuffers[camIdx],
+                        0, 0, scaledRenderSize.x, scaledRenderSize.y, 0, 0,
+                        settings.renderSize.x, settings.renderSize.y, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+                    // blit depth - skipped entirely when no consumer samples eye depth (hi-z needs it)
+                    if (settings.depthResolveEnabled || settings.taaEnabled || hiz || depthReducer) // taa reprojects history by resolved depth
+                    {
+                        glBlitNamedFramebuffer(multisampleFramebuffer, eyeFramebuffers[camIdx],
+                            0, 0, scaledRenderSize.x, scaledRenderSize.y, 0, 0,
+                            settings.renderSize.x, settings.renderSize.y, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+                    }
+
+                    gpuProfiler.end("blit-" + std::to_string(camIdx));
+                } });
+            }
         }
     }
 
-    // Execute the post passes after having resolved the multisample framebuffers
+    // Post passes consume the resolved per-eye targets; their framebuffers are allocated on
+    // first use, so a renderer that never tonemaps never pays for them
+    for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
     {
-        gpuProfiler.begin("run_post_pass");
-        cpuProfiler.begin("run_post_pass");
-        for (uint32_t camIdx = 0; camIdx < settings.cameraCount; ++camIdx)
+        const std::string idx = std::to_string(camIdx);
+
+        frameGraph.add_pass({ "post-" + idx, { "eye-color-" + idx }, { "post-color-" + idx }, [this, &scene, camIdx]()
         {
+            gpuProfiler.begin("run_post_pass-" + std::to_string(camIdx));
+            cpuProfiler.begin("run_post_pass-" + std::to_string(camIdx));
+            ensure_post_targets();
             run_post_pass(scene.views[camIdx], scene);
-        }
-        cpuProfiler.end("run_post_pass");
-        gpuProfiler.end("run_post_pass");
+            cpuProfiler.end("run_post_pass-" + std::to_string(camIdx));
+            gpuProfiler.end("run_post_pass-" + std::to_string(camIdx));
+        }, settings.tonemapEnabled });
+
+        frameGraph.mark_output(settings.tonemapEnabled ? "post-color-" + idx : "eye-color-" + idx);
     }
 
+    frameGraph.compile();
+    frameGraph.execute();
+
+    if (persistentMappingSupported) perObjectRing.end_frame();
+    if (persistentMappingSupported) perSkinRing.end_frame();
+
+    previousViewProjMatrix = scene.views[0].viewProjMatrix;
+    havePreviousViewProj = true;
+
+    // Rotate the per-object matrices: what was written this frame becomes next frame's
+    // "previous" set, and entities that left visibility age out with the swapped map
+    std::swap(previousModelMatrices, currentModelMatrices);
+    currentModelMatrices.clear();
+    ++taaFrameIndex;
+
+    if (settings.dynamicResolutionEnabled) frameGpuTimer.stop();
+
     glDisable(GL_FRAMEBUFFER_SRGB);
     cpuProfiler.end("render_frame");
 
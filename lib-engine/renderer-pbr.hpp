@@ -4,6 +4,8 @@
 #define polymer_renderer_pbr_hpp
 
 #include "math-core.hpp"
+#include "memory-arena.hpp"
+#include "radix_sort.hpp"
 #include "simple_timer.hpp"
 #include "uniforms.hpp"
 #include "queue-circular.hpp"
@@ -14,6 +16,16 @@
 #include "gl-async-gpu-timer.hpp"
 #include "gl-procedural-sky.hpp"
 
+#include "renderer-hiz.hpp"
+#include "renderer-sdsm.hpp"
+#include "renderer-clustered.hpp"
+#include "renderer-graph.hpp"
+#include "renderer-exposure.hpp"
+#include "renderer-cull.hpp"
+#include "renderer-impostor.hpp"
+#include "renderer-brdf.hpp"
+#include "renderer-probes.hpp"
+
 #include "ecs/typeid.hpp"
 #include "ecs/core-ecs.hpp"
 #include "environment.hpp"
@@ -31,10 +43,30 @@ namespace polymer
     {
         gl_texture_3d shadowArrayDepth;
         gl_framebuffer shadowArrayFramebuffer;
+
+        // Cached depth layer containing static casters only; composited into the main
+        // array each frame so only dynamic casters need to be re-rendered.
+        gl_texture_3d staticArrayDepth;
+        gl_framebuffer staticArrayFramebuffer;
+
+        std::vector<float4x4> previousShadowMatrices;
+        bool matricesDirty{ true };
+
+        uint32_t frameIndex{ 0 };    // drives the round-robin refresh schedule
+        uint32_t refreshMask{ 0xf }; // cascades refreshing this frame, one bit per layer
+
         shader_handle program = { "cascaded-shadows" };
 
     public:
 
+        bool staticCachingEnabled{ true };
+
+        // Refresh distant cascades at reduced rates (cascade 0 every frame, cascade 3 every
+        // 4th). Their fitted bounds change slowly by construction, and held cascades keep the
+        // matrices from their last refresh so the retained depth stays consistent with the
+        // matrix it is sampled through — the texel-snapped fit prevents swim in between.
+        bool roundRobinEnabled{ true };
+
         float resolution = 4096;        // cascade resolution
         float splitLambda = 0.675f;     // frustum split constant
 
@@ -46,13 +78,36 @@ namespace polymer
         std::vector<float4x4> projMatrices;
         std::vector<float4x4> shadowMatrices;
 
+        std::vector<float> cascadeRadii; // half-extent of each cascade's fitted ortho volume in its view space
+
         stable_cascaded_shadows();
 
         void update_cascades(const float4x4 & view, const float near, const float far, const float aspectRatio, const float vfov, const float3 & lightDir);
         void update_shadow_matrix(const float4x4 & shadowModelMatrix);
+
+        // Cascade membership for a world-space bounding sphere (xyz center, w radius).
+        // A zero radius means unknown bounds and conservatively lands in every cascade.
+        uint32_t cascade_mask_for_sphere(const float4 & sphere) const;
+
+        // Restricts the geometry-shader cascade fan-out for the next draws; callers
+        // AND the caster's membership mask with the relevant refresh mask
+        void set_caster_mask(const uint32_t mask);
         void pre_draw();
         void post_draw();
 
+        // True when the camera-stabilized cascade matrices changed since the last update,
+        // which invalidates the cached static-caster layer.
+        bool cascades_dirty() const { return matricesDirty; }
+
+        // Bitmask of the cascade layers being re-rendered this frame (0xf when the
+        // round-robin schedule is disabled)
+        uint32_t cascade_refresh_mask() const { return refreshMask; }
+
+        // Render target control for the cached static layer: the static pass renders into the
+        // cache; the composite pre-draw seeds the main array from the cache instead of clearing.
+        void pre_draw_static();
+        void pre_draw_composite();
+
         GLuint get_output_texture() const;
     };
 
@@ -60,12 +115,25 @@ namespace polymer
     {
         f("shadowmap_resolution", o.resolution);
         f("cascade_split", o.splitLambda, range_metadata<float>{ 0.1f, 1.0f });
+        f("static_caching", o.staticCachingEnabled);
+        f("round_robin_refresh", o.roundRobinEnabled);
     }
 
     ////////////////////////////////////////
     //   render system data + utilities   //
     ////////////////////////////////////////
 
+    // Storage for the HDR intermediates: the msaa color plane, the resolved per-eye color,
+    // and the post chain. `half_float` halves bandwidth against `full_float` with no visible
+    // loss ahead of tonemapping; `packed_float` (R11F_G11F_B10F) halves it again but drops
+    // alpha, for bandwidth-bound mobile-class parts.
+    enum class hdr_precision : uint32_t
+    {
+        full_float,     // RGBA32F
+        half_float,     // RGBA16F
+        packed_float    // R11F_G11F_B10F
+    };
+
     struct renderer_settings
     {
         int2 renderSize{ 0, 0 };
@@ -75,6 +143,24 @@ namespace polymer
         bool useDepthPrepass{ false };
         bool tonemapEnabled{ true };
         bool shadowsEnabled{ true };
+        bool instancedDrawing{ true };
+        bool occlusionCullingEnabled{ false };
+        bool clusteredLightingEnabled{ false };
+        bool singlePassStereo{ false }; // requires cameraCount == 2 and GL_ARB_shader_viewport_layer_array
+        bool dynamicResolutionEnabled{ false };
+        float targetFrameTimeMs{ 11.1f }; // 90hz hmd budget; 16.6f for a 60hz display
+        hdr_precision hdrPrecision{ hdr_precision::half_float }; // fixed at construction (targets are allocated once)
+        bool depthResolveEnabled{ true }; // skip the msaa depth resolve when nothing downstream samples eye depth
+        bool autoExposureEnabled{ false };
+        bool gpuCullingEnabled{ false };  // compute frustum cull for instanced batches; requires multi-draw-indirect
+        bool bindlessTexturesEnabled{ false }; // resident texture handles in a material ubo instead of per-draw sampler binds; requires GL_ARB_bindless_texture
+        std::string brdfLutCachePath{ "../assets/textures/brdf-lut.bin" }; // baked split-sum BRDF table; re-integrated and written here when absent
+        bool sdsmShadowsEnabled{ false }; // tighten cascade near/far from a min/max reduction of last frame's depth (sample-distribution shadow maps)
+        bool taaEnabled{ false };         // temporal aa + upscale stage ahead of tonemap (requires tonemapEnabled); jitters projections and reprojects history by depth
+        float taaRenderScale{ 1.f };      // geometry passes render at renderSize * scale; taa accumulates back to full resolution (0.7 trades against msaa 4x)
+        float taaFeedback{ 0.9f };        // history weight after neighborhood clamping
+        bool dynamicSkyProbes{ false };   // re-capture + re-convolve the scene IBL incrementally when the procedural sun moves (time-of-day)
+        bool weightedOITEnabled{ false }; // weighted-blended transparency (accum/reveal targets + fullscreen composite) instead of sorted blending; single-sample path only, fx shaders opt in via USE_WEIGHTED_OIT
     };
 
     struct view_data
@@ -101,54 +187,157 @@ namespace polymer
     class render_system;
     struct render_payload
     {
-        std::vector<view_data> views;
-        std::vector<render_component> render_components;
-        std::vector<point_light_component *> point_lights;
-        directional_light_component * sunlight;
+        // Rebuilt every frame; the typical frame (a couple of views, a few dozen
+        // renderables and lights) lives entirely in the inline capacities below. Spills
+        // go to the frame arena when constructed against one, otherwise the heap.
+        small_vector<view_data, 4> views;
+        small_vector<render_component, 64> render_components;
+        small_vector<point_light_component *, 16> point_lights;
+        small_vector<reflection_probe_component *, 4> reflection_probes;
+        directional_light_component * sunlight{ nullptr };
         float4 clear_color{ 1, 0, 0, 1 };
         texture_handle ibl_radianceCubemap;
         texture_handle ibl_irradianceCubemap;
         gl_procedural_sky * skybox{ nullptr };
+
+        render_payload() = default;
+        explicit render_payload(linear_arena & arena)
+            : views(arena), render_components(arena), point_lights(arena), reflection_probes(arena) {}
     };
 
     //////////////////////
     //   pbr_renderer   //
     //////////////////////
 
-    class pbr_renderer 
+    // Records the gl_submission_stats delta over a scope (one renderer pass) into `out`.
+    // Declared on the stack at the top of each run_*_pass so every exit path is covered.
+    struct scoped_pass_stats
+    {
+        std::vector<std::pair<std::string, gl_submission_stats_snapshot>> & out;
+        std::string name;
+        gl_submission_stats_snapshot begin;
+        scoped_pass_stats(std::vector<std::pair<std::string, gl_submission_stats_snapshot>> & out, std::string name)
+            : out(out), name(std::move(name)), begin(gl_submission_stats::get().capture()) {}
+        ~scoped_pass_stats() { out.emplace_back(std::move(name), gl_submission_stats::get().capture() - begin); }
+    };
+
+    class pbr_renderer
     {
         simple_cpu_timer timer;
 
+        // Per-pass submission statistics for the frame most recently rendered
+        std::vector<std::pair<std::string, gl_submission_stats_snapshot>> passStats;
+
         gl_buffer perScene;
         gl_buffer perView;
-        gl_buffer perObject;
+        gl_buffer perObject;               // legacy path, used when persistent mapping is unavailable
+        gl_mapped_ring_buffer perObjectRing;
+        gl_buffer perSkin;                 // legacy skinning palette upload, same fallback condition
+        gl_mapped_ring_buffer perSkinRing; // bone palettes for every skinned entity this frame
+
+        gl_impostor_batch impostorBatch; // far-field components swapped off the mesh path this frame
+        bool persistentMappingSupported{ false };
 
         // MSAA Targets
         gl_renderbuffer multisampleRenderbuffers[2]; // color, depth/stencil
         gl_framebuffer multisampleFramebuffer;
 
+        // Single-pass stereo target (double-wide, one viewport per eye)
+        gl_renderbuffer stereoMultisampleRenderbuffers[2];
+        gl_framebuffer stereoMultisampleFramebuffer;
+        bool stereoSinglePassActive{ false };
+
         // Non-MSAA Targets
         std::vector<gl_framebuffer> eyeFramebuffers;
         std::vector<gl_texture_2d> eyeTextures, eyeDepthTextures;
 
         std::unique_ptr<stable_cascaded_shadows> shadow;
+        std::unique_ptr<hi_z_occlusion_culler> hiz;
+        std::unique_ptr<depth_bounds_reducer> depthReducer; // sdsm shadow tightening
+        std::unique_ptr<environment_probe_updater> skyProbeUpdater; // incremental IBL refresh for dynamic time-of-day
+        float2 lastSunPosition{ -1000.f, -1000.f };
+        std::unique_ptr<cluster_light_grid> clusterGrid;
+        std::unique_ptr<auto_exposure> autoExposure;
+        float lastFrameTimeMs{ 0.f };
+        float frameDeltaSeconds{ 0.f }; // drives exposure adaptation
+        float4x4 previousViewProjMatrix;
+        bool havePreviousViewProj{ false };
         gl_mesh post_quad;
 
         gl_mesh left_stencil_mask, right_stencil_mask;
         bool using_stencil_mask{ false };
 
+        gl_texture_2d brdfLut; // split-sum environment BRDF table, loaded from cache or baked once at construction
+
         shader_handle renderPassEarlyZ = { "depth-prepass" };
         shader_handle renderPassTonemap = { "post-tonemap" };
         shader_handle no_op = { "no-op" };
 
-        void update_per_object_uniform_buffer(const transform & p, const float3 & scale, const bool receiveShadow, const view_data & d);
+        std::vector<float4x4> instanceModelMatrices; // per-frame scratch for the instanced submission path
+        transform_soa instanceTransforms; // SoA staging for the batched matrix compose that fills the scratch above
+        std::vector<float4> instanceBoundingSpheres; // parallel scratch of world bounding spheres for the gpu cull
+        std::vector<uint64_t> drawKeys;              // per-frame scratch for draw-key generation
+        std::vector<uint64_t> transparentDrawKeys;   // blended components split out of the opaque queue, keyed back-to-front
+        radix_sort drawKeySorter;
+        gl_indirect_buffer indirectDrawBuffer;       // re-filled per bucket when multi-draw-indirect is available
+        bool multiDrawIndirectSupported{ false };
+        bool bindlessTexturesSupported{ false };     // settings.bindlessTexturesEnabled and the driver exposes GL_ARB_bindless_texture
+
+        std::unique_ptr<gpu_frustum_culler> gpuCuller;
+        frustum cullingFrustum;                      // refreshed per view at the top of the forward pass
+
+        std::unordered_map<entity, float4x4> previousShadowCasterPoses; // static/dynamic caster classification for the cascade cache
+        uint64_t previousStaticCasterHash{ 0 };
+        std::vector<const render_component *> staticShadowCasters, dynamicShadowCasters; // per-frame scratch
+
+        render_graph frameGraph; // rebuilt each frame from the declared pass reads/writes
+
+        // Dynamic resolution: whole-frame GPU time feeds a controller that shrinks the
+        // rendered sub-rect when over budget and creeps it back up when there is headroom.
+        gl_gpu_frame_timer frameGpuTimer;
+        float resolutionScale{ 1.f };
+        int2 scaledRenderSize{ 0, 0 }; // renderSize * resolutionScale, recomputed per frame
+
+        // Temporal aa state (settings.taaEnabled): ping-ponged full-resolution history
+        // per view, last frame's unjittered view-proj for depth reprojection, and the
+        // per-object model matrices of the previous frame for the motion-vector uniform
+        shader_handle renderPassTaa = { "post-taa" };
+        std::vector<gl_framebuffer> taaFramebuffers; // two per view
+        std::vector<gl_texture_2d> taaTextures;
+        std::vector<float4x4> taaPreviousViewProj;
+        std::vector<uint32_t> taaHistoryValid;
+        uint32_t taaFrameIndex{ 0 };
+        float4x4 taaJitterMatrix{ Identity4x4 }; // clip-space sub-pixel offset for this frame (identity when taa is off)
+        float2 taaJitterPixels{ 0.f, 0.f };
+        std::unordered_map<entity, float4x4> previousModelMatrices, currentModelMatrices; // swapped at end of frame
+
+        // Weighted-blended OIT intermediates (settings.weightedOITEnabled): accum/reveal
+        // pair per view sharing the eye depth texture, resolved by a fullscreen composite
+        std::vector<gl_framebuffer> oitFramebuffers;
+        std::vector<gl_texture_2d> oitAccumTextures, oitRevealTextures;
+        gl_shader oitCompositeShader;
+        gl_mesh oit_quad;
+
+        void ensure_post_targets();
+        void ensure_taa_targets();
+        void ensure_oit_targets();
+
+        void update_per_object_uniform_buffer(const entity e, const transform & p, const float3 & scale, const material_component & mat, const view_data & d);
+        void bind_bone_palette(const std::vector<float4x4> & palette);
+        void submit_material_and_draw(const render_component * r, const uint32_t instanceCount, const render_payload & scene);
         void run_stencil_prepass(const view_data & view, const render_payload & scene);
         void run_depth_prepass(const view_data & view, const render_payload & scene);
         void run_skybox_pass(const view_data & view, const render_payload & scene);
         void run_shadow_pass(const view_data & view, const render_payload & scene);
         void run_forward_pass(std::vector<const render_component *> & render_queue, const view_data & view, const render_payload & scene);
+        void run_transparency_pass(std::vector<const render_component *> & transparent_queue, const view_data & view, const render_payload & scene, const bool allow_oit);
         void run_post_pass(const view_data & view, const render_payload & scene);
 
+        // Invoked per view at the top of render_frame, before any matrices are
+        // consumed, so HMD apps can rewrite each view from a pose sampled as
+        // late as possible (see openvr_hmd::get_predicted_hmd_pose)
+        std::function<void(view_data & view)> late_latch_callback;
+
     public:
 
         std::vector<gl_framebuffer> postFramebuffers;
@@ -166,6 +355,13 @@ namespace polymer
         uint32_t get_color_texture(const uint32_t idx = 0) const;
         uint32_t get_depth_texture(const uint32_t idx = 0) const;
         void set_stencil_mask(const uint32_t idx, gl_mesh && m);
+        void set_late_latch(std::function<void(view_data & view)> callback) { late_latch_callback = callback; }
+
+        float get_resolution_scale() const { return resolutionScale; }
+
+        // Draw calls, binds, ubo updates and triangles submitted by each pass of the last
+        // frame, in execution order (see gl_submission_stats)
+        const std::vector<std::pair<std::string, gl_submission_stats_snapshot>> & get_pass_stats() const { return passStats; }
 
         stable_cascaded_shadows * get_shadow_pass() const;
     };
@@ -179,6 +375,18 @@ namespace polymer
         f("depth_prepass", o.settings.useDepthPrepass);
         f("tonemap_pass", o.settings.tonemapEnabled);
         f("shadow_pass", o.settings.shadowsEnabled);
+        f("instanced_drawing", o.settings.instancedDrawing);
+        f("occlusion_culling", o.settings.occlusionCullingEnabled);
+        f("clustered_lighting", o.settings.clusteredLightingEnabled);
+        f("single_pass_stereo", o.settings.singlePassStereo, editor_hidden{}); // fixed at construction alongside camera count
+        f("dynamic_resolution", o.settings.dynamicResolutionEnabled);
+        f("target_frame_ms", o.settings.targetFrameTimeMs, range_metadata<float>{ 4.f, 33.3f });
+        f("depth_resolve", o.settings.depthResolveEnabled);
+        f("temporal_aa", o.settings.taaEnabled);
+        f("taa_render_scale", o.settings.taaRenderScale, range_metadata<float>{ 0.5f, 1.f });
+        f("taa_feedback", o.settings.taaFeedback, range_metadata<float>{ 0.f, 0.98f });
+        f("auto_exposure", o.settings.autoExposureEnabled, editor_hidden{}); // fixed at construction
+        f("gpu_culling", o.settings.gpuCullingEnabled, editor_hidden{});     // fixed at construction
     }
 
 }
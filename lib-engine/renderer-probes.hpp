@@ -0,0 +1,576 @@
+#pragma once
+
+#ifndef polymer_renderer_probes_hpp
+#define polymer_renderer_probes_hpp
+
+#include "math-core.hpp"
+#include "gl-api.hpp"
+#include "gl-loaders.hpp"
+#include "gl-procedural-sky.hpp"
+#include "asset-handle-utils.hpp"
+#include "thread-pool.hpp"
+
+#include <fstream>
+#include <vector>
+
+namespace polymer
+{
+    /////////////////////////////////
+    //   reflection_probe_baker    //
+    /////////////////////////////////
+
+    // Prefilters the GGX specular mip chain of a source environment cubemap in compute, one
+    // dispatch per mip with roughness increasing linearly down the chain. Baked chains are
+    // round-trippable to disk as raw RGBA16F payloads so a scene re-open loads bytes instead
+    // of re-running the convolution.
+
+    static const char * ggx_prefilter_compute_source = R"(#version 450
+        layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+        layout(binding = 0) uniform samplerCube sc_source;
+        layout(binding = 1, rgba16f) uniform writeonly imageCube u_output;
+        uniform float u_roughness;
+        uniform float u_faceSize;
+
+        // Face index + [-1, 1] face uv to a cubemap direction (GL face ordering)
+        vec3 face_direction(vec2 uv, uint face)
+        {
+            if (face == 0u) return vec3( 1.0, -uv.y, -uv.x);
+            if (face == 1u) return vec3(-1.0, -uv.y,  uv.x);
+            if (face == 2u) return vec3( uv.x,  1.0,  uv.y);
+            if (face == 3u) return vec3( uv.x, -1.0, -uv.y);
+            if (face == 4u) return vec3( uv.x, -uv.y,  1.0);
+            return vec3(-uv.x, -uv.y, -1.0);
+        }
+
+        float radical_inverse_vdc(uint bits)
+        {
+            bits = (bits << 16u) | (bits >> 16u);
+            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+            return float(bits) * 2.3283064365386963e-10;
+        }
+
+        vec3 importance_sample_ggx(vec2 xi, float roughness, vec3 N)
+        {
+            float a = roughness * roughness;
+            float phi = 6.28318530718 * xi.x;
+            float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (a * a - 1.0) * xi.y));
+            float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+            vec3 H = vec3(sinTheta * cos(phi), sinTheta * sin(phi), cosTheta);
+            vec3 up = abs(N.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+            vec3 tangentX = normalize(cross(up, N));
+            vec3 tangentY = cross(N, tangentX);
+            return tangentX * H.x + tangentY * H.y + N * H.z;
+        }
+
+        void main()
+        {
+            ivec2 pix = ivec2(gl_GlobalInvocationID.xy);
+            int size = int(u_faceSize);
+            if (pix.x >= size || pix.y >= size) return;
+
+            vec2 uv = ((vec2(pix) + 0.5) / float(size)) * 2.0 - 1.0;
+            vec3 N = normalize(face_direction(uv, gl_GlobalInvocationID.z));
+
+            vec3 prefiltered = vec3(0.0);
+            if (u_roughness <= 0.001)
+            {
+                prefiltered = textureLod(sc_source, N, 0.0).rgb; // mip 0 is a mirror
+            }
+            else
+            {
+                const uint NUM_SAMPLES = 64u;
+                float totalWeight = 0.0;
+                for (uint i = 0u; i < NUM_SAMPLES; ++i)
+                {
+                    vec2 xi = vec2(float(i) / float(NUM_SAMPLES), radical_inverse_vdc(i));
+                    vec3 H = importance_sample_ggx(xi, u_roughness, N);
+                    vec3 L = 2.0 * dot(N, H) * H - N; // N = V = R approximation
+                    float NdotL = max(dot(N, L), 0.0);
+                    if (NdotL > 0.0)
+                    {
+                        prefiltered += textureLod(sc_source, L, 0.0).rgb * NdotL;
+                        totalWeight += NdotL;
+                    }
+                }
+                prefiltered /= max(totalWeight, 0.001);
+            }
+            imageStore(u_output, ivec3(pix, int(gl_GlobalInvocationID.z)), vec4(prefiltered, 1.0));
+        })";
+
+    class reflection_probe_baker
+    {
+        gl_shader_compute prefilterShader{ ggx_prefilter_compute_source };
+
+        static const uint32_t cache_magic = 0x50524231; // 'PRB1'
+
+        void configure_sampling(const gl_texture_2d & cubemap) const
+        {
+            glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+        }
+
+    public:
+
+        // Six mips matches NUM_MIP_LEVELS in pbr_material_frag.glsl, so the shader's
+        // roughness-to-mip mapping holds for probe chains without modification.
+        int faceSize{ 128 };
+        int mipCount{ 6 };
+
+        // Storage + sampling state for a destination chain, without filling it
+        gl_texture_2d allocate_chain() const
+        {
+            gl_texture_2d chain;
+            glTextureStorage2DEXT(chain, GL_TEXTURE_CUBE_MAP, mipCount, GL_RGBA16F, faceSize, faceSize);
+            configure_sampling(chain);
+            return chain;
+        }
+
+        // One mip of the GGX chain - the unit of work the incremental updater below
+        // uses to spread a refresh across frames
+        void prefilter_mip(const GLuint sourceCubemap, gl_texture_2d & dest, const int mip)
+        {
+            const int mipSize = faceSize >> mip;
+            prefilterShader.uniform("u_roughness", static_cast<float>(mip) / static_cast<float>(mipCount - 1));
+            prefilterShader.uniform("u_faceSize", static_cast<float>(mipSize));
+            prefilterShader.texture(prefilterShader.get_uniform_location("sc_source"), GL_TEXTURE_CUBE_MAP, 0, sourceCubemap);
+            glBindImageTexture(1, dest, mip, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+            prefilterShader.dispatch((mipSize + 7) / 8, (mipSize + 7) / 8, 6);
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        }
+
+        // Prefilter the full GGX chain of `sourceCubemap` into a freshly allocated cubemap
+        gl_texture_2d prefilter(const GLuint sourceCubemap)
+        {
+            gl_texture_2d baked = allocate_chain();
+            for (int mip = 0; mip < mipCount; ++mip) prefilter_mip(sourceCubemap, baked, mip);
+            return baked;
+        }
+
+        // Raw dump of the chain: small header, then per-mip, per-face RGBA16F payloads
+        void store_cached(const std::string & path, const gl_texture_2d & baked) const
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file.is_open()) return;
+
+            const uint32_t header[3] = { cache_magic, static_cast<uint32_t>(faceSize), static_cast<uint32_t>(mipCount) };
+            file.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+            std::vector<uint8_t> pixels;
+            for (int mip = 0; mip < mipCount; ++mip)
+            {
+                const int mipSize = faceSize >> mip;
+                pixels.resize(mipSize * mipSize * 4 * sizeof(uint16_t));
+                for (int face = 0; face < 6; ++face)
+                {
+                    glGetTextureImageEXT(baked, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mip, GL_RGBA, GL_HALF_FLOAT, pixels.data());
+                    file.write(reinterpret_cast<const char *>(pixels.data()), pixels.size());
+                }
+            }
+        }
+
+        // Returns false (leaving `baked` untouched) when the cache is missing, truncated,
+        // or was written with different bake settings.
+        bool load_cached(const std::string & path, gl_texture_2d & baked) const
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) return false;
+
+            uint32_t header[3] = { 0, 0, 0 };
+            file.read(reinterpret_cast<char *>(header), sizeof(header));
+            if (file.gcount() != sizeof(header)) return false;
+            if (header[0] != cache_magic || header[1] != static_cast<uint32_t>(faceSize) || header[2] != static_cast<uint32_t>(mipCount)) return false;
+
+            gl_texture_2d loaded;
+            glTextureStorage2DEXT(loaded, GL_TEXTURE_CUBE_MAP, mipCount, GL_RGBA16F, faceSize, faceSize);
+
+            std::vector<uint8_t> pixels;
+            for (int mip = 0; mip < mipCount; ++mip)
+            {
+                const int mipSize = faceSize >> mip;
+                pixels.resize(mipSize * mipSize * 4 * sizeof(uint16_t));
+                for (int face = 0; face < 6; ++face)
+                {
+                    file.read(reinterpret_cast<char *>(pixels.data()), pixels.size());
+                    if (file.gcount() != static_cast<std::streamsize>(pixels.size())) return false;
+                    glTextureSubImage2DEXT(loaded, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mip, 0, 0, mipSize, mipSize, GL_RGBA, GL_HALF_FLOAT, pixels.data());
+                }
+            }
+
+            configure_sampling(loaded);
+            baked = std::move(loaded);
+            return true;
+        }
+    };
+
+    ///////////////////////////////////
+    //   environment_probe_updater   //
+    ///////////////////////////////////
+
+    // Cosine-hemisphere convolution of a source cubemap into a small irradiance cubemap
+    static const char * irradiance_convolve_compute_source = R"(#version 450
+        layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+        layout(binding = 0) uniform samplerCube sc_source;
+        layout(binding = 1, rgba16f) uniform writeonly imageCube u_output;
+        uniform float u_faceSize;
+
+        vec3 face_direction(vec2 uv, uint face)
+        {
+            if (face == 0u) return vec3( 1.0, -uv.y, -uv.x);
+            if (face == 1u) return vec3(-1.0, -uv.y,  uv.x);
+            if (face == 2u) return vec3( uv.x,  1.0,  uv.y);
+            if (face == 3u) return vec3( uv.x, -1.0, -uv.y);
+            if (face == 4u) return vec3( uv.x, -uv.y,  1.0);
+            return vec3(-uv.x, -uv.y, -1.0);
+        }
+
+        void main()
+        {
+            ivec2 pix = ivec2(gl_GlobalInvocationID.xy);
+            int size = int(u_faceSize);
+            if (pix.x >= size || pix.y >= size) return;
+
+            vec2 uv = ((vec2(pix) + 0.5) / float(size)) * 2.0 - 1.0;
+            vec3 N = normalize(face_direction(uv, gl_GlobalInvocationID.z));
+            vec3 up = abs(N.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+            vec3 tangentX = normalize(cross(up, N));
+            vec3 tangentY = cross(N, tangentX);
+
+            const float PI = 3.14159265359;
+            vec3 irradiance = vec3(0.0);
+            float samples = 0.0;
+            for (float phi = 0.0; phi < 2.0 * PI; phi += 0.2)
+            {
+                for (float theta = 0.0; theta < 0.5 * PI; theta += 0.1)
+                {
+                    vec3 t = vec3(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+                    vec3 dir = tangentX * t.x + tangentY * t.y + N * t.z;
+                    irradiance += textureLod(sc_source, dir, 0.0).rgb * cos(theta) * sin(theta);
+                    samples += 1.0;
+                }
+            }
+            imageStore(u_output, ivec3(pix, int(gl_GlobalInvocationID.z)), vec4(PI * irradiance / samples, 1.0));
+        })";
+
+    // Incremental refresh of the scene IBL pair from a dynamic procedural sky. One
+    // unit of work runs per frame: six frames render the sky into the capture
+    // cubemap face by face, then one GGX mip prefilters per frame, then a single
+    // irradiance convolution, and finally the finished pair is moved into the named
+    // texture handles. Handle reassignment is the publish point - consumers pick
+    // the new probes up on their next .get() and never sample a half-built chain,
+    // so an animating sun costs a bounded slice per frame instead of a full
+    // convolution stall.
+    class environment_probe_updater
+    {
+        reflection_probe_baker baker;
+        gl_shader_compute irradianceShader{ irradiance_convolve_compute_source };
+
+        std::string radianceName, irradianceName;
+
+        gl_framebuffer captureFramebuffer;
+        gl_texture_2d captureCubemap;    // the sky renders here, one face per frame
+        gl_texture_2d buildingRadiance;  // ggx chain under construction
+        gl_texture_2d buildingIrradiance;
+
+        int irradianceSize{ 32 };
+        uint32_t stepIndex{ 0 };
+        bool cycleActive{ false };
+        bool refreshQueued{ false };
+
+    public:
+
+        environment_probe_updater(const std::string & radiance_handle, const std::string & irradiance_handle, const int face_size = 128)
+            : radianceName(radiance_handle), irradianceName(irradiance_handle)
+        {
+            baker.faceSize = face_size;
+
+            captureCubemap.memory.set_category(gl_memory_category::render_targets);
+            glTextureStorage2DEXT(captureCubemap, GL_TEXTURE_CUBE_MAP, 1, GL_RGBA16F, face_size, face_size);
+            glTextureParameteriEXT(captureCubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(captureCubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(captureCubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(captureCubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(captureCubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        }
+
+        // Queues a full refresh; the running cycle (if any) completes first so the
+        // handles always receive a coherent pair
+        void request_refresh() { refreshQueued = true; }
+        bool refreshing() const { return cycleActive; }
+
+        // Call once per frame on the GL thread; performs at most one slice of work.
+        // Returns true on the frame a completed probe pair was swapped in.
+        bool step(gl_procedural_sky & sky)
+        {
+            if (!cycleActive)
+            {
+                if (!refreshQueued) return false;
+                refreshQueued = false;
+                cycleActive = true;
+                stepIndex = 0;
+            }
+
+            const uint32_t faceCount = 6;
+            const uint32_t mipSteps = static_cast<uint32_t>(baker.mipCount);
+
+            if (stepIndex < faceCount)
+            {
+                const int face = static_cast<int>(stepIndex);
+
+                GLint prevFramebuffer = 0, prevViewport[4];
+                glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
+                glGetIntegerv(GL_VIEWPORT, prevViewport);
+                const GLboolean wasDepthTestingEnabled = glIsEnabled(GL_DEPTH_TEST);
+
+                glNamedFramebufferTexture2DEXT(captureFramebuffer, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, captureCubemap, 0);
+                glBindFramebuffer(GL_FRAMEBUFFER, captureFramebuffer);
+                glViewport(0, 0, baker.faceSize, baker.faceSize);
+                glClear(GL_COLOR_BUFFER_BIT);
+                glDisable(GL_DEPTH_TEST);
+
+                static const float3 forwards[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+                static const float3 ups[6] = { { 0, -1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 0, -1, 0 }, { 0, -1, 0 } };
+
+                const float farClip = 64.f;
+                const transform eye = lookat_rh(float3(0, 0, 0), forwards[face], ups[face]);
+                const float4x4 viewProj = make_projection_matrix(static_cast<float>(POLYMER_PI) * 0.5f, 1.f, 0.1f, farClip) * eye.view_matrix();
+                sky.render(viewProj, float3(0, 0, 0), farClip);
+
+                if (wasDepthTestingEnabled) glEnable(GL_DEPTH_TEST);
+                glBindFramebuffer(GL_FRAMEBUFFER, prevFramebuffer);
+                glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+            }
+            else if (stepIndex < faceCount + mipSteps)
+            {
+                const int mip = static_cast<int>(stepIndex - faceCount);
+                if (mip == 0) buildingRadiance = baker.allocate_chain();
+                baker.prefilter_mip(captureCubemap, buildingRadiance, mip);
+            }
+            else if (stepIndex == faceCount + mipSteps)
+            {
+                gl_texture_2d irradiance;
+                glTextureStorage2DEXT(irradiance, GL_TEXTURE_CUBE_MAP, 1, GL_RGBA16F, irradianceSize, irradianceSize);
+                glTextureParameteriEXT(irradiance, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTextureParameteriEXT(irradiance, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTextureParameteriEXT(irradiance, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTextureParameteriEXT(irradiance, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTextureParameteriEXT(irradiance, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+                irradianceShader.uniform("u_faceSize", static_cast<float>(irradianceSize));
+                irradianceShader.texture(irradianceShader.get_uniform_location("sc_source"), GL_TEXTURE_CUBE_MAP, 0, captureCubemap);
+                glBindImageTexture(1, irradiance, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+                irradianceShader.dispatch((irradianceSize + 7) / 8, (irradianceSize + 7) / 8, 6);
+                glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+
+                buildingIrradiance = std::move(irradiance);
+            }
+            else
+            {
+                create_handle_for_asset(radianceName.c_str(), std::move(buildingRadiance));
+                create_handle_for_asset(irradianceName.c_str(), std::move(buildingIrradiance));
+                cycleActive = false;
+                return true;
+            }
+
+            ++stepIndex;
+            return false;
+        }
+    };
+
+    ////////////////////////////////////
+    //   hdr_environment_importer     //
+    ////////////////////////////////////
+
+    // Samples an equirectangular panorama into one cubemap face per dispatch
+    static const char * equirect_to_cube_compute_source = R"(#version 450
+        layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+        layout(binding = 0) uniform sampler2D s_equirect;
+        layout(binding = 1, rgba16f) uniform writeonly imageCube u_output;
+        uniform float u_faceSize;
+
+        vec3 face_direction(vec2 uv, uint face)
+        {
+            if (face == 0u) return vec3( 1.0, -uv.y, -uv.x);
+            if (face == 1u) return vec3(-1.0, -uv.y,  uv.x);
+            if (face == 2u) return vec3( uv.x,  1.0,  uv.y);
+            if (face == 3u) return vec3( uv.x, -1.0, -uv.y);
+            if (face == 4u) return vec3( uv.x, -uv.y,  1.0);
+            return vec3(-uv.x, -uv.y, -1.0);
+        }
+
+        void main()
+        {
+            ivec2 pix = ivec2(gl_GlobalInvocationID.xy);
+            int size = int(u_faceSize);
+            if (pix.x >= size || pix.y >= size) return;
+
+            vec2 uv = ((vec2(pix) + 0.5) / float(size)) * 2.0 - 1.0;
+            vec3 d = normalize(face_direction(uv, gl_GlobalInvocationID.z));
+            vec2 st = vec2(atan(d.z, d.x) * 0.15915494309 + 0.5, acos(clamp(d.y, -1.0, 1.0)) * 0.31830988618);
+            imageStore(u_output, ivec3(pix, int(gl_GlobalInvocationID.z)), vec4(textureLod(s_equirect, st, 0.0).rgb, 1.0));
+        })";
+
+    // Progressive import of an equirectangular *.hdr environment into the scene's
+    // radiance/irradiance handle pair. The stb decode runs on a worker; the frame
+    // it lands, a small preview chain (32px faces) converts, prefilters and
+    // convolves in a handful of tiny dispatches and is published immediately, so
+    // lighting is approximately right while the full-resolution conversion, one
+    // GGX mip per frame, and the final irradiance convolution refine in the
+    // background. Handle reassignment is the publish point, same as
+    // environment_probe_updater - consumers atomically pick up first the preview
+    // pair, then the finished one, and never sample a half-built chain.
+    class hdr_environment_importer
+    {
+        struct decoded_hdr
+        {
+            std::vector<float> pixels;
+            int32_t width{ 0 }, height{ 0 };
+        };
+
+        reflection_probe_baker baker;        // full-resolution chain
+        reflection_probe_baker previewBaker; // preview chain, published first
+        gl_shader_compute equirectShader{ equirect_to_cube_compute_source };
+        gl_shader_compute convolveShader{ irradiance_convolve_compute_source };
+
+        std::string radianceName, irradianceName;
+        std::string pendingPath;
+
+        task_handle<decoded_hdr> decode;
+        gl_texture_2d equirect;          // decoded panorama, alive for the cycle
+        gl_texture_2d sourceCubemap;     // full-resolution equirect conversion
+        gl_texture_2d buildingRadiance;  // ggx chain under construction
+
+        int irradianceSize{ 32 };
+        uint32_t stepIndex{ 0 };
+        bool cycleActive{ false };
+
+        gl_texture_2d allocate_cubemap(const int faceSize) const
+        {
+            gl_texture_2d cubemap;
+            glTextureStorage2DEXT(cubemap, GL_TEXTURE_CUBE_MAP, 1, GL_RGBA16F, faceSize, faceSize);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTextureParameteriEXT(cubemap, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            return cubemap;
+        }
+
+        void convert_equirect(gl_texture_2d & dest, const int faceSize)
+        {
+            equirectShader.uniform("u_faceSize", static_cast<float>(faceSize));
+            equirectShader.texture(equirectShader.get_uniform_location("s_equirect"), GL_TEXTURE_2D, 0, equirect);
+            glBindImageTexture(1, dest, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+            equirectShader.dispatch((faceSize + 7) / 8, (faceSize + 7) / 8, 6);
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        }
+
+        gl_texture_2d convolve_irradiance(const GLuint source)
+        {
+            gl_texture_2d irradiance = allocate_cubemap(irradianceSize);
+            convolveShader.uniform("u_faceSize", static_cast<float>(irradianceSize));
+            convolveShader.texture(convolveShader.get_uniform_location("sc_source"), GL_TEXTURE_CUBE_MAP, 0, source);
+            glBindImageTexture(1, irradiance, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+            convolveShader.dispatch((irradianceSize + 7) / 8, (irradianceSize + 7) / 8, 6);
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+            return irradiance;
+        }
+
+    public:
+
+        hdr_environment_importer(const std::string & radiance_handle, const std::string & irradiance_handle, const int face_size = 128)
+            : radianceName(radiance_handle), irradianceName(irradiance_handle)
+        {
+            baker.faceSize = face_size;
+            previewBaker.faceSize = 32;
+        }
+
+        // Queues |path| for import. A cycle already in flight completes (and
+        // publishes) first; when iterating quickly only the latest request runs.
+        void import_async(const std::string & path) { pendingPath = path; }
+
+        bool importing() const { return cycleActive || !pendingPath.empty(); }
+
+        // Call once per frame on the GL thread; performs at most one slice of work.
+        // Returns true on the frame the finished full-resolution pair was published.
+        bool step()
+        {
+            if (!cycleActive)
+            {
+                if (pendingPath.empty()) return false;
+
+                const std::string path = pendingPath;
+                pendingPath.clear();
+                decode = spawn(get_task_scheduler(), [path]() -> decoded_hdr
+                {
+                    decoded_hdr result;
+                    try { result.pixels = load_hdr_image_data(path, result.width, result.height); }
+                    catch (const std::exception & e) { log::get()->engine_log->error("[hdr_environment_importer] {}", e.what()); }
+                    return result;
+                });
+
+                cycleActive = true;
+                stepIndex = 0;
+                return false;
+            }
+
+            const uint32_t mipSteps = static_cast<uint32_t>(baker.mipCount);
+
+            if (stepIndex == 0)
+            {
+                if (!decode.ready()) return false; // decode still on the worker; no GL-thread cost
+
+                decoded_hdr & image = decode.get();
+                if (image.pixels.empty()) { cycleActive = false; return false; } // decode failed; keep the current pair
+
+                glTextureImage2DEXT(equirect, GL_TEXTURE_2D, 0, GL_RGB32F, image.width, image.height, 0, GL_RGB, GL_FLOAT, image.pixels.data());
+                glTextureParameteriEXT(equirect, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTextureParameteriEXT(equirect, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTextureParameteriEXT(equirect, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+                glTextureParameteriEXT(equirect, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                decode = {};
+
+                // Preview: everything at 32px faces fits comfortably in one slice
+                gl_texture_2d previewCubemap = allocate_cubemap(previewBaker.faceSize);
+                convert_equirect(previewCubemap, previewBaker.faceSize);
+                create_handle_for_asset(radianceName.c_str(), previewBaker.prefilter(previewCubemap));
+                create_handle_for_asset(irradianceName.c_str(), convolve_irradiance(previewCubemap));
+            }
+            else if (stepIndex == 1)
+            {
+                sourceCubemap = allocate_cubemap(baker.faceSize);
+                convert_equirect(sourceCubemap, baker.faceSize);
+            }
+            else if (stepIndex < 2 + mipSteps)
+            {
+                const int mip = static_cast<int>(stepIndex - 2);
+                if (mip == 0) buildingRadiance = baker.allocate_chain();
+                baker.prefilter_mip(sourceCubemap, buildingRadiance, mip);
+            }
+            else
+            {
+                create_handle_for_asset(radianceName.c_str(), std::move(buildingRadiance));
+                create_handle_for_asset(irradianceName.c_str(), convolve_irradiance(sourceCubemap));
+                equirect = {};
+                sourceCubemap = {};
+                cycleActive = false;
+                ++stepIndex;
+                return true;
+            }
+
+            ++stepIndex;
+            return false;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_renderer_probes_hpp
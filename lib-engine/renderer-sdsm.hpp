@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef polymer_renderer_sdsm_hpp
+#define polymer_renderer_sdsm_hpp
+
+#include "math-core.hpp"
+#include "gl-api.hpp"
+
+#include <cstring>
+
+namespace polymer
+{
+    //////////////////////////////
+    //   depth_bounds_reducer   //
+    //////////////////////////////
+
+    // Reduces the previous frame's resolved depth to a scene min/max in compute
+    // (sample-distribution shadow maps, Lauritzen et al.). The bounds replace the
+    // analytic worst-case near/far fed into the cascade fit, so cascade texels cover
+    // only the depth range actually occupied this frame. Results are consumed with one
+    // frame of latency so the readback never stalls the pipeline, and a hold-over
+    // margin absorbs the lag.
+
+    static const char * depth_minmax_compute_source = R"(#version 450
+        layout(local_size_x = 16, local_size_y = 16) in;
+        layout(binding = 0) uniform sampler2D s_depth;
+        layout(std430, binding = 0) buffer Reduction { uint u_minDepth; uint u_maxDepth; };
+        uniform ivec2 u_depthSize;
+
+        shared uint s_min;
+        shared uint s_max;
+
+        void main()
+        {
+            if (gl_LocalInvocationIndex == 0u) { s_min = 0xffffffffu; s_max = 0u; }
+            barrier();
+
+            ivec2 pix = ivec2(gl_GlobalInvocationID.xy);
+            if (pix.x < u_depthSize.x && pix.y < u_depthSize.y)
+            {
+                float d = texelFetch(s_depth, pix, 0).r;
+                if (d < 1.0) // the far plane clear value carries no geometry
+                {
+                    // Depth is non-negative, so its bit pattern orders like the float
+                    uint bits = floatBitsToUint(d);
+                    atomicMin(s_min, bits);
+                    atomicMax(s_max, bits);
+                }
+            }
+            barrier();
+
+            // One global atomic pair per workgroup instead of per texel
+            if (gl_LocalInvocationIndex == 0u && s_max != 0u)
+            {
+                atomicMin(u_minDepth, s_min);
+                atomicMax(u_maxDepth, s_max);
+            }
+        })";
+
+    class depth_bounds_reducer
+    {
+        gl_buffer reductionBuffer;
+        std::unique_ptr<gl_shader_compute> reduce;
+
+        bool dispatchInFlight{ false };
+        bool haveResult{ false };
+        float minDepth{ 0.f };
+        float maxDepth{ 1.f };
+
+    public:
+
+        depth_bounds_reducer()
+        {
+            reduce.reset(new gl_shader_compute(depth_minmax_compute_source));
+            gl_check_error(__FILE__, __LINE__);
+        }
+
+        // Collect the bounds of the dispatch issued last frame; the GPU finished long
+        // ago so this readback does not introduce a sync point.
+        void gather_results()
+        {
+            if (!dispatchInFlight) return;
+            dispatchInFlight = false;
+
+            uint32_t bits[2] = { 0, 0 };
+            glGetNamedBufferSubDataEXT(reductionBuffer, 0, sizeof(bits), bits);
+
+            // An untouched buffer means every texel was at the far plane (empty view)
+            if (bits[1] == 0) { haveResult = false; return; }
+
+            memcpy(&minDepth, &bits[0], sizeof(float));
+            memcpy(&maxDepth, &bits[1], sizeof(float));
+            haveResult = (maxDepth > minDepth);
+        }
+
+        // Latest reduced bounds as raw [0, 1] depth values. False until the first
+        // dispatch completes or when the last reduction saw no geometry.
+        bool get_depth_bounds(float & outMinDepth, float & outMaxDepth) const
+        {
+            if (!haveResult) return false;
+            outMinDepth = minDepth;
+            outMaxDepth = maxDepth;
+            return true;
+        }
+
+        // Reduce `depth_texture` (the previous frame's resolved depth). Call once per frame.
+        void dispatch(const GLuint depth_texture, const int2 & depth_size)
+        {
+            const uint32_t initial[2] = { 0xffffffffu, 0u };
+            reductionBuffer.set_buffer_data(sizeof(initial), initial, GL_STREAM_READ);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, reductionBuffer);
+
+            glProgramUniform2i(reduce->handle(), reduce->get_uniform_location("u_depthSize"), depth_size.x, depth_size.y);
+            reduce->texture("s_depth", 0, depth_texture, GL_TEXTURE_2D);
+            reduce->dispatch((depth_size.x + 15) / 16, (depth_size.y + 15) / 16, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+
+            dispatchInFlight = true;
+
+            gl_check_error(__FILE__, __LINE__);
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_renderer_sdsm_hpp
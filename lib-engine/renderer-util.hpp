@@ -59,6 +59,10 @@ namespace polymer
             monitor.watch("post-tonemap",
                 base_path + "/shaders/renderer/post_tonemap_vert.glsl",
                 base_path + "/shaders/renderer/post_tonemap_frag.glsl");
+
+            monitor.watch("post-taa",
+                base_path + "/shaders/renderer/post_tonemap_vert.glsl",
+                base_path + "/shaders/renderer/post_taa_frag.glsl");
         }
         catch (const std::exception & e)
         {
@@ -0,0 +1,248 @@
+#pragma once
+
+#ifndef polymer_scene_journal_hpp
+#define polymer_scene_journal_hpp
+
+#include "environment.hpp"
+#include "ui-actions.hpp"
+#include "system-transform.hpp"
+#include "system-render.hpp"
+#include "system-identifier.hpp"
+#include "system-collision.hpp"
+
+#include <cstring>
+#include <functional>
+
+namespace polymer
+{
+    ///////////////////////
+    //   scene journal   //
+    ///////////////////////
+
+    // Delta-based undo for the scene editor. An editing operation journals only the
+    // entities it touches: each one's components are flattened through visit_fields
+    // into a compact binary record before and after the edit, so apply/revert cost is
+    // proportional to what changed - never a full export_environment pass. Fields
+    // serialize raw when trivially copyable; strings, asset handles and entity lists
+    // get a length prefix, mirroring the binary environment format.
+
+    struct journal_writer
+    {
+        std::vector<uint8_t> buffer;
+
+        template <typename T, typename std::enable_if<std::is_trivially_copyable<T>::value, int>::type = 0>
+        void field(const T & value)
+        {
+            const uint8_t * bytes = reinterpret_cast<const uint8_t *>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void field(const std::string & s)
+        {
+            field(static_cast<uint32_t>(s.size()));
+            buffer.insert(buffer.end(), s.begin(), s.end());
+        }
+
+        template <typename T>
+        void field(const asset_handle<T> & handle) { field(handle.name); }
+
+        template <typename T, typename std::enable_if<std::is_trivially_copyable<T>::value, int>::type = 0>
+        void field(const std::vector<T> & v)
+        {
+            field(static_cast<uint32_t>(v.size()));
+            const uint8_t * bytes = reinterpret_cast<const uint8_t *>(v.data());
+            buffer.insert(buffer.end(), bytes, bytes + v.size() * sizeof(T));
+        }
+    };
+
+    struct journal_reader
+    {
+        const uint8_t * cursor{ nullptr };
+        const uint8_t * end{ nullptr };
+
+        journal_reader(const std::vector<uint8_t> & data) : cursor(data.data()), end(data.data() + data.size()) {}
+
+        template <typename T, typename std::enable_if<std::is_trivially_copyable<T>::value, int>::type = 0>
+        void field(T & value)
+        {
+            if (cursor + sizeof(T) > end) throw std::runtime_error("scene journal: truncated component record");
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+        }
+
+        void field(std::string & s)
+        {
+            uint32_t size{ 0 };
+            field(size);
+            if (cursor + size > end) throw std::runtime_error("scene journal: truncated component record");
+            s.assign(reinterpret_cast<const char *>(cursor), size);
+            cursor += size;
+        }
+
+        template <typename T>
+        void field(asset_handle<T> & handle)
+        {
+            std::string name;
+            field(name);
+            handle = asset_handle<T>(name);
+        }
+
+        template <typename T, typename std::enable_if<std::is_trivially_copyable<T>::value, int>::type = 0>
+        void field(std::vector<T> & v)
+        {
+            uint32_t size{ 0 };
+            field(size);
+            if (cursor + size * sizeof(T) > end) throw std::runtime_error("scene journal: truncated component record");
+            v.resize(size);
+            std::memcpy(v.data(), cursor, size * sizeof(T));
+            cursor += size * sizeof(T);
+        }
+    };
+
+    struct component_delta
+    {
+        poly_typeid type{ 0 };
+        std::vector<uint8_t> fields;
+    };
+
+    struct entity_snapshot
+    {
+        entity e{ kInvalidEntity };
+        bool exists{ false };
+        std::vector<component_delta> components;
+    };
+
+    // Flattens every component the systems hold for `e` into binary field records.
+    // An untracked entity snapshots as { exists = false }, which is how an undo of
+    // a create (or a redo of a delete) knows to remove it again.
+    inline entity_snapshot capture_entity_snapshot(environment & env, const entity e)
+    {
+        entity_snapshot snap;
+        snap.e = e;
+
+        const auto & entities = env.entity_list();
+        snap.exists = std::find(entities.begin(), entities.end(), e) != entities.end();
+        if (!snap.exists) return snap;
+
+        visit_systems(&env, [&](const char * system_name, auto * system_pointer)
+        {
+            if (!system_pointer) return;
+            visit_components(e, system_pointer, [&](const char * component_name, auto & component_ref, auto... component_metadata)
+            {
+                component_delta delta;
+                delta.type = get_typeid<typename std::decay<decltype(component_ref)>::type>();
+
+                journal_writer w;
+                visit_fields(component_ref, [&w](const char * field_name, auto & field, auto... field_metadata) { w.field(field); });
+                delta.fields = std::move(w.buffer);
+
+                snap.components.push_back(std::move(delta));
+            });
+        });
+
+        return snap;
+    }
+
+    template <typename C>
+    inline void journal_restore_component(environment & env, const entity e, const component_delta & delta)
+    {
+        C c;
+        c.e = e;
+
+        journal_reader r(delta.fields);
+        visit_fields(c, [&r](const char * field_name, auto & field, auto... field_metadata) { r.field(field); });
+
+        const poly_typeid id = get_typeid<C>();
+        visit_systems(&env, [&](const char * system_name, auto * system_pointer)
+        {
+            if (system_pointer) system_pointer->create(e, id, &c);
+        });
+    }
+
+    // Restores an entity to the captured state. Touched entities are cleared and
+    // rebuilt component-by-component from their records - the same create() path
+    // import_environment uses - so cost scales with the entity's component count.
+    inline void apply_entity_snapshot(environment & env, const entity_snapshot & snap)
+    {
+        const auto & entities = env.entity_list();
+        const bool live = std::find(entities.begin(), entities.end(), snap.e) != entities.end();
+
+        if (!snap.exists)
+        {
+            if (live) env.destroy(snap.e);
+            return;
+        }
+
+        if (live) env.destroy(snap.e);
+        env.track_entity(snap.e);
+
+        for (const auto & delta : snap.components)
+        {
+            if      (delta.type == get_typeid<identifier_component>())        journal_restore_component<identifier_component>(env, snap.e, delta);
+            else if (delta.type == get_typeid<local_transform_component>())   journal_restore_component<local_transform_component>(env, snap.e, delta);
+            else if (delta.type == get_typeid<mesh_component>())              journal_restore_component<mesh_component>(env, snap.e, delta);
+            else if (delta.type == get_typeid<material_component>())          journal_restore_component<material_component>(env, snap.e, delta);
+            else if (delta.type == get_typeid<geometry_component>())          journal_restore_component<geometry_component>(env, snap.e, delta);
+            else if (delta.type == get_typeid<point_light_component>())       journal_restore_component<point_light_component>(env, snap.e, delta);
+            else if (delta.type == get_typeid<directional_light_component>()) journal_restore_component<directional_light_component>(env, snap.e, delta);
+            else if (delta.type == get_typeid<reflection_probe_component>())  journal_restore_component<reflection_probe_component>(env, snap.e, delta);
+        }
+    }
+
+    ///////////////////////////////
+    //   action_edit_entities    //
+    ///////////////////////////////
+
+    // Journal-backed action for the undo_manager. Two construction modes: the
+    // deferred form snapshots the touched entities, runs the edit (which returns
+    // any entities it created, so their prior non-existence is journaled too) and
+    // snapshots again; the pre-captured form takes before/after sets recorded
+    // externally - e.g. around a gizmo drag - and makes execute() a no-op.
+    class action_edit_entities final : public action
+    {
+        environment & env;
+        std::vector<entity> touched;
+        std::function<std::vector<entity>()> edit;
+        std::vector<entity_snapshot> before, after;
+
+    public:
+
+        action_edit_entities(const std::string & desc, environment & env, std::vector<entity> touched_entities, std::function<std::vector<entity>()> edit_fn)
+            : env(env), touched(std::move(touched_entities)), edit(std::move(edit_fn))
+        {
+            description = desc;
+            timestamp = system_time_ns();
+        }
+
+        action_edit_entities(const std::string & desc, environment & env, std::vector<entity_snapshot> before_state, std::vector<entity_snapshot> after_state)
+            : env(env), before(std::move(before_state)), after(std::move(after_state))
+        {
+            description = desc;
+            timestamp = system_time_ns();
+        }
+
+        virtual void execute() override final
+        {
+            if (!edit) return; // pre-captured form
+
+            for (const entity e : touched) before.push_back(capture_entity_snapshot(env, e));
+
+            const std::vector<entity> created = edit();
+            for (const entity e : created)
+            {
+                touched.push_back(e);
+                entity_snapshot did_not_exist;
+                did_not_exist.e = e;
+                before.push_back(did_not_exist);
+            }
+
+            for (const entity e : touched) after.push_back(capture_entity_snapshot(env, e));
+        }
+
+        virtual void undo() override final { for (const auto & snap : before) apply_entity_snapshot(env, snap); }
+        virtual void redo() override final { for (const auto & snap : after) apply_entity_snapshot(env, snap); }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_scene_journal_hpp
@@ -0,0 +1,174 @@
+#pragma once
+
+#ifndef polymer_scene_streaming_hpp
+#define polymer_scene_streaming_hpp
+
+#include "environment.hpp"
+#include "ecs/core-ecs.hpp"
+#include "file_io.hpp"
+#include "thread-pool.hpp"
+#include "json.hpp"
+
+#include <future>
+
+namespace polymer
+{
+
+    ////////////////////////
+    //   scene_streamer   //
+    ////////////////////////
+
+    // Streams a chunked scene (environment::export_environment_chunks) in and out
+    // around a moving focus point. File reads run on the task scheduler's workers;
+    // activation and unload happen on the calling thread through the additive
+    // binary importer, budgeted to one chunk per update() so a walk across a cell
+    // boundary never stacks multi-chunk hitches into a single frame. Load and
+    // unload distances are separated for hysteresis, so a focus oscillating on a
+    // boundary doesn't thrash a chunk.
+    class scene_streamer
+    {
+        enum class chunk_state
+        {
+            unloaded,   // on disk only
+            loading,    // file read in flight on a worker
+            ready,      // bytes in memory, awaiting activation
+            active      // entities live in the environment
+        };
+
+        struct scene_chunk
+        {
+            int32_t cell_x{ 0 }, cell_y{ 0 };
+            std::string file;
+            chunk_state state{ chunk_state::unloaded };
+            std::future<std::vector<uint8_t>> pending; // worker-side file read
+            std::vector<uint8_t> data;                 // populated between ready and activation
+            std::vector<entity> entities;              // live set owned by this chunk
+        };
+
+        std::vector<scene_chunk> chunks;
+        std::string base_dir;
+        float cell_size{ 0.f };
+
+        // Ground-plane distance from the focus to the cell's bounds (zero inside it)
+        float chunk_distance(const scene_chunk & c, const float3 & focus) const
+        {
+            const float min_x = c.cell_x * cell_size, min_z = c.cell_y * cell_size;
+            const float dx = std::max(std::max(min_x - focus.x, focus.x - (min_x + cell_size)), 0.f);
+            const float dz = std::max(std::max(min_z - focus.z, focus.z - (min_z + cell_size)), 0.f);
+            return std::sqrt(dx * dx + dz * dz);
+        }
+
+    public:
+
+        float load_distance{ 96.f };
+        float unload_distance{ 128.f }; // keep > load_distance for hysteresis
+
+        // Parses the `chunks.json` manifest written by export_environment_chunks.
+        // Returns false (leaving the streamer empty) if the manifest is missing.
+        bool load_manifest(const std::string & chunk_dir)
+        {
+            chunks.clear();
+            base_dir = chunk_dir;
+
+            json manifest;
+            try { manifest = json::parse(read_file_text(chunk_dir + "/chunks.json")); }
+            catch (const std::exception & e)
+            {
+                log::get()->engine_log->error("[scene_streamer] failed to read manifest in {} ({})", chunk_dir, e.what());
+                return false;
+            }
+
+            cell_size = manifest["cell_size"].get<float>();
+            for (const auto & entry : manifest["chunks"])
+            {
+                scene_chunk c;
+                c.cell_x = entry["x"].get<int32_t>();
+                c.cell_y = entry["y"].get<int32_t>();
+                c.file = entry["file"].get<std::string>();
+                chunks.push_back(std::move(c));
+            }
+
+            log::get()->engine_log->info("[scene_streamer] manifest lists {} chunks ({}m cells)", chunks.size(), cell_size);
+            return true;
+        }
+
+        // Call once per frame from the thread that owns the environment (reads are
+        // async; entity creation/destruction is not). Activates at most one ready
+        // chunk per call.
+        void update(environment & env, entity_orchestrator & orch, const float3 & focus)
+        {
+            bool activated_this_update = false;
+
+            for (auto & c : chunks)
+            {
+                const float distance = chunk_distance(c, focus);
+
+                switch (c.state)
+                {
+                    case chunk_state::unloaded:
+                    {
+                        if (distance <= load_distance)
+                        {
+                            const std::string path = base_dir + "/" + c.file;
+                            c.pending = get_task_scheduler().enqueue([path]() { return read_file_binary(path); });
+                            c.state = chunk_state::loading;
+                        }
+                        break;
+                    }
+                    case chunk_state::loading:
+                    {
+                        if (c.pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            c.data = c.pending.get();
+                            c.state = chunk_state::ready;
+                        }
+                        break;
+                    }
+                    case chunk_state::ready:
+                    {
+                        // The focus may have moved on while the read was in flight
+                        if (distance >= unload_distance)
+                        {
+                            c.data.clear();
+                            c.data.shrink_to_fit();
+                            c.state = chunk_state::unloaded;
+                        }
+                        else if (!activated_this_update)
+                        {
+                            c.entities = env.import_environment_binary_chunk(c.data, orch);
+                            c.data.clear();
+                            c.data.shrink_to_fit();
+                            c.state = chunk_state::active;
+                            activated_this_update = true;
+                            log::get()->engine_log->info("[scene_streamer] activated chunk ({}, {}) with {} entities", c.cell_x, c.cell_y, c.entities.size());
+                        }
+                        break;
+                    }
+                    case chunk_state::active:
+                    {
+                        if (distance >= unload_distance)
+                        {
+                            env.destroy_entities(c.entities); // one compacting pass per system instead of per-entity destroys
+                            c.entities.clear();
+                            c.state = chunk_state::unloaded;
+                            log::get()->engine_log->info("[scene_streamer] unloaded chunk ({}, {})", c.cell_x, c.cell_y);
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        size_t chunk_count() const { return chunks.size(); }
+
+        size_t active_chunk_count() const
+        {
+            size_t count = 0;
+            for (const auto & c : chunks) if (c.state == chunk_state::active) ++count;
+            return count;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_scene_streaming_hpp
@@ -13,34 +13,27 @@ system_clock::time_point write_time(const std::string & file_path)
 
 gl_shader_monitor::gl_shader_monitor(const std::string & root_path) : root_path(root_path)
 {
-    watch_thread = std::thread([this, root_path]()
+    // Constructed on the gl thread, so the extension query is safe here. When the driver
+    // compiles on its own threads, recompiles are swapped in by completion polling instead
+    // of stalling the frame.
+    std::vector<std::pair<std::string, bool>> requiredExtensions = { { "GL_KHR_parallel_shader_compile", false } };
+    has_gl_extension(requiredExtensions);
+    parallelCompileSupported = requiredExtensions[0].second;
+
+    if (parallelCompileSupported && glMaxShaderCompilerThreadsKHR)
     {
-        while (!watch_should_exit)
-        {
-            try
-            {
-                std::lock_guard<std::mutex> guard(watch_mutex);
-                walk_asset_dir();
-            }
-            catch (const std::exception & e)
-            {
-                //@todo use logger
-                std::cout << "Filesystem error: " << e.what() << std::endl;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(250));
-        }
-    });
-}
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF); // let the driver pick its own thread count
+    }
 
-gl_shader_monitor::~gl_shader_monitor()
-{
-    watch_should_exit = true;
-    if (watch_thread.joinable()) watch_thread.join();
+    // The watcher thread only accumulates changed paths; matching and
+    // recompiles both happen on the gl thread inside handle_recompile().
+    watcher.reset(new file_watcher(root_path));
 }
 
+gl_shader_monitor::~gl_shader_monitor() {}
+
 void gl_shader_monitor::watch(const std::string & name, const std::string & vert_path, const std::string & frag_path)
 {
-    std::lock_guard<std::mutex> guard(watch_mutex);
     auto asset = std::make_shared<gl_shader_asset>(name, vert_path, frag_path);
     assets[name] = asset;
     create_handle_for_asset(name.c_str(), std::move(asset));
@@ -48,7 +41,6 @@ void gl_shader_monitor::watch(const std::string & name, const std::string & vert
 
 void gl_shader_monitor::watch(const std::string & name, const std::string & vert_path, const std::string & frag_path, const std::string & include_path)
 {
-    std::lock_guard<std::mutex> guard(watch_mutex);
     auto asset = std::make_shared<gl_shader_asset>(name, vert_path, frag_path, "", include_path);
     assets[name] = asset;
     create_handle_for_asset(name.c_str(), std::move(asset));
@@ -56,74 +48,69 @@ void gl_shader_monitor::watch(const std::string & name, const std::string & vert
 
 void gl_shader_monitor::watch(const std::string & name, const std::string & vert_path, const std::string & frag_path, const std::string & geom_path, const std::string & include_path)
 {
-    std::lock_guard<std::mutex> guard(watch_mutex);
     auto asset = std::make_shared<gl_shader_asset>(name, vert_path, frag_path, geom_path, include_path);
     assets[name] = asset;
     create_handle_for_asset(name.c_str(), std::move(asset));
 }
 
-void gl_shader_monitor::walk_asset_dir()
+void gl_shader_monitor::process_changed_path(const std::string & path)
 {
-    const path root = root_path;
-
-    for (auto & entry : recursive_directory_iterator(root))
+    for (auto & asset : assets)
     {
-        const size_t root_len = root.string().length(), ext_len = entry.path().extension().string().length();
-        auto path = entry.path().string(), name = path.substr(root_len + 1, path.size() - root_len - ext_len - 1);
-        for (auto & chr : path) if (chr == '\\') chr = '/';
+        // Compare file names + extension instead of paths directly
+        const auto scanned_file = get_filename_with_extension(path);
 
-        for (auto & asset : assets)
+        // Regular shader assets
+        if (scanned_file == get_filename_with_extension(asset.second->vertexPath)   || 
+            scanned_file == get_filename_with_extension(asset.second->fragmentPath) ||
+            scanned_file == get_filename_with_extension(asset.second->geomPath))
         {
-            // Compare file names + extension instead of paths directly
-            const auto scanned_file = get_filename_with_extension(path);
+            auto writeTime = duration_cast<seconds>(write_time(path).time_since_epoch()).count();
+            if (writeTime > asset.second->writeTime)
+            {
+                asset.second->writeTime = writeTime;
+                asset.second->shouldRecompile = true;
+                //@todo use logger
+                std::cout << "Processed Asset: " << asset.first << std::endl;
+            }
+        }
 
-            // Regular shader assets
-            if (scanned_file == get_filename_with_extension(asset.second->vertexPath)   || 
-                scanned_file == get_filename_with_extension(asset.second->fragmentPath) ||
-                scanned_file == get_filename_with_extension(asset.second->geomPath))
+        // Each shader keeps a list of the files it includes. gl_shader_monitor watches a base path,
+        // so we should be able to recompile shaders dependent on common includes
+        for (std::string includePath : asset.second->includes)
+        {
+            if (get_filename_with_extension(path) == get_filename_with_extension(includePath))
             {
                 auto writeTime = duration_cast<seconds>(write_time(path).time_since_epoch()).count();
                 if (writeTime > asset.second->writeTime)
                 {
                     asset.second->writeTime = writeTime;
                     asset.second->shouldRecompile = true;
-                    //@todo use logger
-                    std::cout << "Processed Asset: " << asset.first << std::endl;
-                }
-            }
 
-            // Each shader keeps a list of the files it includes. gl_shader_monitor watches a base path,
-            // so we should be able to recompile shaders dependent on common includes
-            for (std::string includePath : asset.second->includes)
-            {
-                if (get_filename_with_extension(path) == get_filename_with_extension(includePath))
-                {
-                    auto writeTime = duration_cast<seconds>(write_time(path).time_since_epoch()).count();
-                    if (writeTime > asset.second->writeTime)
-                    {
-                        asset.second->writeTime = writeTime;
-                        asset.second->shouldRecompile = true;
-
-                        //@todo use logger
-                        std::cout << "Processed Include: " << includePath << std::endl;
-                        break;
-                    }
+                    //@todo use logger
+                    std::cout << "Processed Include: " << includePath << std::endl;
+                    break;
                 }
             }
-
         }
     }
 }
 
 void gl_shader_monitor::handle_recompile()
 {
-    try_locker locker(watch_mutex);
+    // Match paths the watcher accumulated since last frame against watched shaders
+    for (auto & changed : watcher->drain_changes()) process_changed_path(changed);
+
     for (auto & asset : assets)
     {
         if (asset.second->shouldRecompile)
         {
-            asset.second->recompile_all();
+            if (parallelCompileSupported) asset.second->recompile_all_async();
+            else asset.second->recompile_all();
             asset.second->shouldRecompile = false;
         }
+
+        // Swap in any recompiles the driver has finished since last frame
+        if (parallelCompileSupported) asset.second->poll_async();
     }
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "gl-api.hpp"
 #include "util.hpp"
 #include "string_utils.hpp"
+#include "file_watcher.hpp"
 #include "gl-loaders.hpp"
 #include "shader.hpp"
 
@@ -13,7 +14,6 @@
 #include <unordered_map>
 #include <chrono>
 #include <filesystem>
-#include <atomic>
 
 using namespace std::experimental::filesystem;
 using namespace std::chrono;
@@ -25,11 +25,10 @@ namespace polymer
     {
         std::unordered_map<std::string, std::shared_ptr<gl_shader_asset>> assets;
         std::string root_path;
-        std::thread watch_thread;
-        std::mutex watch_mutex;
-        std::atomic<bool> watch_should_exit{ false };
+        std::unique_ptr<file_watcher> watcher; // OS change notifications; no per-frame tree walk
+        bool parallelCompileSupported{ false }; // GL_KHR_parallel_shader_compile
 
-        void walk_asset_dir();
+        void process_changed_path(const std::string & path);
 
     public:
 
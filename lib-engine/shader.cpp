@@ -1,7 +1,78 @@
 #include "shader.hpp"
 
+#include <fstream>
+
 using namespace polymer;
 
+//////////////////////////////////
+//   Program Binary Disk Cache  //
+//////////////////////////////////
+
+static std::string s_shaderBinaryCachePath = "cache/shaders";
+
+void polymer::set_shader_binary_cache_path(const std::string & path) { s_shaderBinaryCachePath = path; }
+const std::string & polymer::get_shader_binary_cache_path() { return s_shaderBinaryCachePath; }
+
+namespace
+{
+    // The driver strings participate in the key so binaries produced by a different
+    // vendor/driver revision are never offered to glProgramBinary in the first place.
+    uint64_t program_binary_cache_key(const std::string & vert, const std::string & frag, const std::string & geom)
+    {
+        uint64_t key = poly_hash_fnv1a(vert);
+        key = (key * 0x100000001b3ull) ^ poly_hash_fnv1a(frag);
+        key = (key * 0x100000001b3ull) ^ poly_hash_fnv1a(geom);
+
+        if (const GLubyte * vendor = glGetString(GL_VENDOR))     key = (key * 0x100000001b3ull) ^ poly_hash_fnv1a(reinterpret_cast<const char *>(vendor));
+        if (const GLubyte * renderer = glGetString(GL_RENDERER)) key = (key * 0x100000001b3ull) ^ poly_hash_fnv1a(reinterpret_cast<const char *>(renderer));
+        if (const GLubyte * version = glGetString(GL_VERSION))   key = (key * 0x100000001b3ull) ^ poly_hash_fnv1a(reinterpret_cast<const char *>(version));
+
+        return key;
+    }
+
+    std::string cached_program_file(const std::string & name, const uint64_t key)
+    {
+        std::stringstream ss;
+        ss << s_shaderBinaryCachePath << "/" << name << "-" << std::hex << key << ".bin";
+        return ss.str();
+    }
+
+    bool load_cached_program(const std::string & name, const uint64_t key, gl_shader & out)
+    {
+        if (s_shaderBinaryCachePath.empty()) return false;
+
+        std::ifstream file(cached_program_file(name, key), std::ios::binary);
+        if (!file.good()) return false;
+
+        GLenum format = 0;
+        file.read(reinterpret_cast<char *>(&format), sizeof(format));
+        std::vector<uint8_t> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (binary.empty()) return false;
+
+        try { out = gl_shader(format, binary); }
+        catch (const std::exception &) { return false; } // rejected by the driver; fall back to source compile
+        return true;
+    }
+
+    void store_cached_program(const std::string & name, const uint64_t key, const gl_shader & shader)
+    {
+        if (s_shaderBinaryCachePath.empty()) return;
+
+        GLenum format = 0;
+        std::vector<uint8_t> binary;
+        if (!shader.get_binary(format, binary)) return;
+
+        std::error_code ec;
+        std::experimental::filesystem::create_directories(s_shaderBinaryCachePath, ec);
+        if (ec) return; // a failed cache write never fails the compile
+
+        std::ofstream file(cached_program_file(name, key), std::ios::binary);
+        if (!file.good()) return;
+        file.write(reinterpret_cast<const char *>(&format), sizeof(format));
+        file.write(reinterpret_cast<const char *>(binary.data()), binary.size());
+    }
+}
+
 ////////////////////////////////////////
 //   Shader Preprocessing Functions   //
 ////////////////////////////////////////
@@ -66,7 +137,14 @@ std::string preprocess_version(const std::string & source)
     return result.str();
 }
 
-gl_shader preprocess(const std::string & vertexShader,
+// The fully preprocessed per-stage sources (includes expanded, defines injected). These are
+// what actually reaches the driver, which makes them the right input for binary cache keys.
+struct preprocessed_sources
+{
+    std::string vertex, fragment, geometry;
+};
+
+preprocessed_sources preprocess(const std::string & vertexShader,
     const std::string & fragmentShader,
     const std::string & geomShader,
     const std::string & includeSearchPath,
@@ -88,19 +166,11 @@ gl_shader preprocess(const std::string & vertexShader,
     if (fragmentShader.size()) fragment << fragmentShader;
     if (geomShader.size()) geom << geomShader;
 
-    if (geomShader.size())
-    {
-        return gl_shader(
-            preprocess_version(process_includes_recursive(vertex.str(), includeSearchPath, includes, 0)),
-            preprocess_version(process_includes_recursive(fragment.str(), includeSearchPath, includes, 0)),
-            preprocess_version(process_includes_recursive(geom.str(), includeSearchPath, includes, 0)));
-    }
-    else
-    {
-        return gl_shader(
-            preprocess_version(process_includes_recursive(vertex.str(), includeSearchPath, includes, 0)),
-            preprocess_version(process_includes_recursive(fragment.str(), includeSearchPath, includes, 0)));
-    }
+    preprocessed_sources result;
+    result.vertex = preprocess_version(process_includes_recursive(vertex.str(), includeSearchPath, includes, 0));
+    result.fragment = preprocess_version(process_includes_recursive(fragment.str(), includeSearchPath, includes, 0));
+    if (geomShader.size()) result.geometry = preprocess_version(process_includes_recursive(geom.str(), includeSearchPath, includes, 0));
+    return result;
 }
 
 ///////////////////////////////////////
@@ -135,6 +205,49 @@ std::shared_ptr<shader_variant> gl_shader_asset::get_variant(const std::vector<s
     return newVariant;
 }
 
+void gl_shader_asset::declare_features(const std::vector<std::string> & feature_defines)
+{
+    assert(feature_defines.size() <= 64);
+    features = feature_defines;
+    variantsByMask.clear();
+}
+
+uint64_t gl_shader_asset::feature_bit(const std::string & feature_define) const
+{
+    for (size_t i = 0; i < features.size(); ++i)
+    {
+        if (features[i] == feature_define) return 1ull << i;
+    }
+    return 0;
+}
+
+std::vector<std::string> gl_shader_asset::defines_for_mask(const uint64_t feature_mask) const
+{
+    std::vector<std::string> defines;
+    for (size_t i = 0; i < features.size(); ++i)
+    {
+        if (feature_mask & (1ull << i)) defines.push_back(features[i]);
+    }
+    return defines;
+}
+
+std::shared_ptr<shader_variant> gl_shader_asset::get_variant(const uint64_t feature_mask)
+{
+    auto itr = variantsByMask.find(feature_mask);
+    if (itr != variantsByMask.end()) return itr->second;
+
+    // Miss: fall through the string path once (compiling, or pulling the binary
+    // cache), then pin the result under the mask so later lookups stay string-free
+    auto variant = get_variant(defines_for_mask(feature_mask));
+    variantsByMask[feature_mask] = variant;
+    return variant;
+}
+
+void gl_shader_asset::precompile_variants(const std::vector<uint64_t> & used_masks)
+{
+    for (const uint64_t mask : used_masks) get_variant(mask);
+}
+
 gl_shader & gl_shader_asset::get()
 {
     std::shared_ptr<shader_variant> theDefault;
@@ -143,6 +256,86 @@ gl_shader & gl_shader_asset::get()
     return theDefault->shader;
 }
 
+gl_shader_asset::pending_variant gl_shader_asset::compile_variant_async(const std::vector<std::string> & defines)
+{
+    pending_variant entry;
+    entry.variantHash = hash(defines);
+
+    try
+    {
+        std::string vertexSource = read_file_text(vertexPath);
+        std::string fragmentSource = read_file_text(fragmentPath);
+        std::string geomSource = read_file_text(geomPath);
+
+        if (defines.size() > 0 || includePath.size() > 0)
+        {
+            const preprocessed_sources sources = preprocess(vertexSource, fragmentSource, geomSource, includePath, defines, includes);
+            vertexSource = sources.vertex;
+            fragmentSource = sources.fragment;
+            geomSource = sources.geometry;
+        }
+
+        entry.cacheKey = program_binary_cache_key(vertexSource, fragmentSource, geomSource);
+
+        if (load_cached_program(name, entry.cacheKey, entry.shader)) entry.readyImmediately = true;
+        else entry.shader = gl_shader(gl_shader::async_compile_tag{}, vertexSource, fragmentSource, geomSource);
+    }
+    catch (const std::exception & e)
+    {
+        //@todo use logger
+        std::cout << "Shader recompilation error: " << e.what() << std::endl;
+        entry.failed = true;
+    }
+
+    return entry;
+}
+
+void gl_shader_asset::recompile_all_async()
+{
+    // Nothing live to keep serving yet; the synchronous path is fine for first compiles
+    if (shaders.empty())
+    {
+        recompile_all();
+        return;
+    }
+
+    pendingAsync.clear();
+    for (auto & variant : shaders)
+    {
+        pendingAsync.push_back(compile_variant_async(variant.second->defines));
+    }
+}
+
+bool gl_shader_asset::poll_async()
+{
+    for (auto it = pendingAsync.begin(); it != pendingAsync.end();)
+    {
+        if (it->failed)
+        {
+            it = pendingAsync.erase(it); // the previous program keeps serving
+            continue;
+        }
+
+        if (!it->readyImmediately && !it->shader.is_ready())
+        {
+            ++it; // still on the driver's compiler threads
+            continue;
+        }
+
+        if (it->readyImmediately || it->shader.confirm_link())
+        {
+            if (!it->readyImmediately) store_cached_program(name, it->cacheKey, it->shader);
+
+            auto variantItr = shaders.find(it->variantHash);
+            if (variantItr != shaders.end()) variantItr->second->shader = std::move(it->shader);
+        }
+
+        it = pendingAsync.erase(it);
+    }
+
+    return pendingAsync.empty();
+}
+
 void gl_shader_asset::recompile_all()
 {
     // Compile at least the default variant with no includes defined... 
@@ -165,13 +358,26 @@ gl_shader gl_shader_asset::compile_variant(const std::vector<std::string> define
 
     try
     {
+        std::string vertexSource = read_file_text(vertexPath);
+        std::string fragmentSource = read_file_text(fragmentPath);
+        std::string geomSource = read_file_text(geomPath);
+
         if (defines.size() > 0 || includePath.size() > 0)
         {
-            variant = preprocess(read_file_text(vertexPath), read_file_text(fragmentPath), read_file_text(geomPath), includePath, defines, includes);
+            const preprocessed_sources sources = preprocess(vertexSource, fragmentSource, geomSource, includePath, defines, includes);
+            vertexSource = sources.vertex;
+            fragmentSource = sources.fragment;
+            geomSource = sources.geometry;
         }
-        else
+
+        // Warm start: a cached driver binary skips GLSL compilation entirely. The key covers
+        // the preprocessed source, so an edited file (or changed define set) misses naturally.
+        const uint64_t cacheKey = program_binary_cache_key(vertexSource, fragmentSource, geomSource);
+
+        if (!load_cached_program(name, cacheKey, variant))
         {
-            variant = gl_shader(read_file_text(vertexPath), read_file_text(fragmentPath), read_file_text(geomPath));
+            variant = gl_shader(vertexSource, fragmentSource, geomSource);
+            store_cached_program(name, cacheKey, variant);
         }
     }
     catch (const std::exception & e)
@@ -18,6 +18,14 @@
 
 namespace polymer
 {
+    // Program binary cache (glGetProgramBinary / glProgramBinary). Compiled programs are
+    // written to disk keyed by a hash of the fully preprocessed source and the driver
+    // strings, so warm starts skip GLSL compilation entirely. Stale entries are ignored
+    // automatically after a driver update (the key changes) or rejected at load time.
+    // An empty path disables the cache.
+    void set_shader_binary_cache_path(const std::string & path);
+    const std::string & get_shader_binary_cache_path();
+
     struct shader_variant
     {
         uint64_t hash;
@@ -32,18 +40,51 @@ namespace polymer
         std::string vertexPath, fragmentPath, geomPath, includePath;
         std::vector<std::string> includes;
         std::unordered_map<uint64_t, std::shared_ptr<shader_variant>> shaders;
+        std::vector<std::string> features; // declared feature defines; bit i of a mask <-> features[i]
+        std::unordered_map<uint64_t, std::shared_ptr<shader_variant>> variantsByMask;
         bool shouldRecompile{ true };
         int64_t writeTime{ 0 };
         friend class gl_shader_monitor;
 
+        // A recompiled variant in flight on the driver's compiler threads (GL_KHR_parallel_shader_compile)
+        struct pending_variant
+        {
+            uint64_t variantHash{ 0 };
+            uint64_t cacheKey{ 0 };
+            gl_shader shader;
+            bool readyImmediately{ false }; // satisfied from the binary cache, no polling needed
+            bool failed{ false };
+        };
+        std::vector<pending_variant> pendingAsync;
+        pending_variant compile_variant_async(const std::vector<std::string> & defines);
+
     public:
 
         gl_shader_asset(const std::string & n, const std::string & v, const std::string & f, const std::string & g = "", const std::string & inc = "");
         gl_shader compile_variant(const std::vector<std::string> defines);
         std::shared_ptr<shader_variant> get_variant(const std::vector<std::string> defines = {});
+
+        // Feature-bit variant management. A shader family declares its defines once
+        // (up to 64; bit i of a mask selects features[i]) and callers then request
+        // variants by bitmask - a single map lookup on the hot path with no define
+        // vectors built or strings hashed. precompile_variants walks the masks a
+        // renderer knows it will use so every permutation is compiled (or pulled
+        // from the program binary cache) before the first frame that needs it.
+        void declare_features(const std::vector<std::string> & feature_defines);
+        size_t feature_count() const { return features.size(); }
+        uint64_t feature_bit(const std::string & feature_define) const; // 0 if undeclared
+        std::vector<std::string> defines_for_mask(const uint64_t feature_mask) const;
+        std::shared_ptr<shader_variant> get_variant(const uint64_t feature_mask);
+        void precompile_variants(const std::vector<uint64_t> & used_masks);
         gl_shader & get(); // returns compiled shader, assumes no defines
         uint64_t hash(const std::vector<std::string> & defines);
         void recompile_all();
+
+        // Non-blocking recompile: kicks off deferred compiles of every live variant and returns.
+        // poll_async() must then be called on the gl thread until it reports completion; each
+        // finished program is swapped in only once GL_COMPLETION_STATUS_KHR says it is ready.
+        void recompile_all_async();
+        bool poll_async();
     };
 }
 
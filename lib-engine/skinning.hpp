@@ -0,0 +1,447 @@
+#pragma once
+
+#ifndef polymer_skinning_hpp
+#define polymer_skinning_hpp
+
+#include "gl-api.hpp"
+#include "uniforms.hpp"
+#include "../lib-model-io/model-io.hpp"
+
+namespace polymer
+{
+
+    //////////////////////////////
+    //   compiled_animation     //
+    //////////////////////////////
+
+    // Import-time compilation of a skeletal_animation into flat, quantized keyframe
+    // blocks. The authoring representation (shared_ptr-per-keyframe, sampled by
+    // linear search) scatters a load per key per channel; at fifty characters that
+    // dominates the frame. Here every track's keys live contiguously in shared
+    // arrays, rotations are stored as snorm16 quaternions and translation/scale as
+    // unorm16 against a per-track range, and neighbouring quaternions are flipped
+    // onto the same hemisphere at compile time so sampling never needs a dot test.
+    struct compiled_animation
+    {
+        struct track_range
+        {
+            uint32_t boneIndex{ 0 };
+            uint32_t firstKey{ 0 };
+            uint32_t keyCount{ 0 };
+            float3 translationMin, translationExtent;
+            float3 scaleMin, scaleExtent;
+        };
+
+        float startFrame{ 0.f };
+        float endFrame{ 0.f };
+
+        std::vector<track_range> tracks;
+        std::vector<float>    keyFrames;       // one frame value per key, ascending within each track
+        std::vector<int16_t>  keyRotations;    // 4 per key, snorm16
+        std::vector<uint16_t> keyTranslations; // 3 per key, unorm16 against the track range
+        std::vector<uint16_t> keyScales;       // 3 per key, unorm16 against the track range
+    };
+
+    inline compiled_animation compile_animation(const skeletal_animation & source)
+    {
+        compiled_animation clip;
+        clip.startFrame = static_cast<float>(source.startFrame);
+        clip.endFrame = static_cast<float>(source.endFrame);
+
+        for (const auto & track : source.tracks)
+        {
+            if (!track || track->keyframes.empty()) continue;
+
+            std::vector<std::shared_ptr<animation_keyframe>> keys = track->keyframes;
+            std::sort(keys.begin(), keys.end(), [](const std::shared_ptr<animation_keyframe> & a,
+                const std::shared_ptr<animation_keyframe> & b) { return a->key < b->key; });
+
+            compiled_animation::track_range range;
+            range.boneIndex = track->boneIndex;
+            range.firstKey = static_cast<uint32_t>(clip.keyFrames.size());
+            range.keyCount = static_cast<uint32_t>(keys.size());
+
+            float3 tMin = keys.front()->translation, tMax = tMin;
+            float3 sMin = keys.front()->scale, sMax = sMin;
+            for (const auto & k : keys)
+            {
+                tMin = linalg::min(tMin, k->translation); tMax = linalg::max(tMax, k->translation);
+                sMin = linalg::min(sMin, k->scale); sMax = linalg::max(sMax, k->scale);
+            }
+            range.translationMin = tMin; range.translationExtent = tMax - tMin;
+            range.scaleMin = sMin; range.scaleExtent = sMax - sMin;
+
+            float4 previousRotation = keys.front()->rotation;
+            for (const auto & k : keys)
+            {
+                clip.keyFrames.push_back(static_cast<float>(k->key));
+
+                float4 q = normalize(k->rotation);
+                if (dot(q, previousRotation) < 0.f) q = -q; // same hemisphere as the previous key
+                previousRotation = q;
+                for (int c = 0; c < 4; ++c)
+                {
+                    clip.keyRotations.push_back(static_cast<int16_t>(std::round(clamp(q[c], -1.f, 1.f) * 32767.f)));
+                }
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    const float te = range.translationExtent[c];
+                    const float se = range.scaleExtent[c];
+                    const float tn = te > 0.f ? (k->translation[c] - range.translationMin[c]) / te : 0.f;
+                    const float sn = se > 0.f ? (k->scale[c] - range.scaleMin[c]) / se : 0.f;
+                    clip.keyTranslations.push_back(static_cast<uint16_t>(std::round(tn * 65535.f)));
+                    clip.keyScales.push_back(static_cast<uint16_t>(std::round(sn * 65535.f)));
+                }
+            }
+
+            clip.tracks.push_back(range);
+        }
+
+        return clip;
+    }
+
+    // Per-player bracketing hints: animation time moves forward a frame at a time,
+    // so the bracket found last frame is almost always this frame's bracket (or its
+    // neighbour). Shared clips each need their own cursor.
+    struct animation_cursor
+    {
+        std::vector<uint32_t> hints;
+    };
+
+    ///////////////////////////
+    //   skeleton_instance   //
+    ///////////////////////////
+
+    // CPU side of the gpu palette-skinning path: samples a skeletal_animation at a
+    // point in time and produces the bone-matrix palette the renderer streams into
+    // the skinning uniform ring. Convention: bone::bindPose holds the inverse bind
+    // matrix (mesh space to bone space at bind time), so each palette entry is the
+    // animated global pose times the inverse bind. Bones are expected in
+    // parent-before-child order; a parentIndex outside the array marks a root.
+    struct skeleton_instance
+    {
+        std::vector<bone> bones;
+        std::vector<float4x4> palette;
+
+        void set_bones(const std::vector<bone> & skeleton_bones)
+        {
+            bones = skeleton_bones;
+            palette.clear();
+            // Identity palette until the first animate() so a freshly-created
+            // instance renders in the bind pose
+            palette.resize(bones.size(), Identity4x4);
+            globals.resize(bones.size(), Identity4x4);
+        }
+
+        void animate(const skeletal_animation & anim, const float time_seconds, const float fps = 24.f)
+        {
+            if (bones.empty()) return;
+
+            const float frameSpan = static_cast<float>(anim.total_frames());
+            const float frame = anim.startFrame + (frameSpan > 0.f ? std::fmod(time_seconds * fps, frameSpan) : 0.f);
+
+            // Local pose defaults to the skeleton's initial pose; tracks override it
+            for (size_t i = 0; i < bones.size(); ++i) globals[i] = bones[i].initialPose;
+
+            for (const auto & track : anim.tracks)
+            {
+                if (!track || track->boneIndex >= bones.size() || track->keyframes.empty()) continue;
+                globals[track->boneIndex] = sample_track(*track, frame);
+            }
+
+            finalize_palette();
+        }
+
+        // Compiled-clip path: brackets every track with a cursor hint (falling back
+        // to binary search on seeks), decodes both bracketing keys for all tracks
+        // into structure-of-arrays blend blocks, and resolves the whole pose with a
+        // single vectorized lerp pass. Rotations nlerp - compile_animation aligned
+        // neighbouring hemispheres, and adjacent keys are close enough that the
+        // arc-length error sits below the quantization noise floor.
+        void animate(const compiled_animation & clip, const float time_seconds, animation_cursor & cursor, const float fps = 24.f)
+        {
+            if (bones.empty()) return;
+
+            const float frameSpan = clip.endFrame - clip.startFrame;
+            const float frame = clip.startFrame + (frameSpan > 0.f ? std::fmod(time_seconds * fps, frameSpan) : 0.f);
+
+            const size_t trackCount = clip.tracks.size();
+            cursor.hints.resize(trackCount, 0);
+            blendA.resize(trackCount * channels_per_track);
+            blendB.resize(trackCount * channels_per_track);
+            blendT.resize(trackCount * channels_per_track);
+
+            for (size_t i = 0; i < trackCount; ++i)
+            {
+                const compiled_animation::track_range & track = clip.tracks[i];
+                const float * keys = clip.keyFrames.data() + track.firstKey;
+                uint32_t & hint = cursor.hints[i];
+                if (hint >= track.keyCount) hint = 0;
+
+                // Bracket the frame: last frame's bracket first, then its successor,
+                // then a binary search for seeks and loop-arounds
+                uint32_t next;
+                if (hint + 1 < track.keyCount && keys[hint] <= frame && frame <= keys[hint + 1]) next = hint + 1;
+                else if (hint + 2 < track.keyCount && keys[hint + 1] <= frame && frame <= keys[hint + 2]) next = ++hint + 1;
+                else
+                {
+                    next = static_cast<uint32_t>(std::upper_bound(keys, keys + track.keyCount, frame) - keys);
+                    hint = next > 0 ? next - 1 : 0;
+                }
+
+                const uint32_t a = next > 0 ? next - 1 : 0;
+                const uint32_t b = next < track.keyCount ? next : track.keyCount - 1;
+                const float span = keys[b] - keys[a];
+                const float t = span > 0.f ? clamp((frame - keys[a]) / span, 0.f, 1.f) : 0.f;
+
+                decode_key(clip, track, a, blendA.data() + i * channels_per_track);
+                decode_key(clip, track, b, blendB.data() + i * channels_per_track);
+                for (int c = 0; c < channels_per_track; ++c) blendT[i * channels_per_track + c] = t;
+            }
+
+            // In-place: blendA now holds the blended pose channels for every track
+            blend_channels(blendA.data(), blendB.data(), blendT.data(), trackCount * channels_per_track);
+
+            // Local pose defaults to the skeleton's initial pose; tracks override it
+            for (size_t i = 0; i < bones.size(); ++i) globals[i] = bones[i].initialPose;
+
+            for (size_t i = 0; i < trackCount; ++i)
+            {
+                const compiled_animation::track_range & track = clip.tracks[i];
+                if (track.boneIndex >= bones.size()) continue;
+                const float * pose = blendA.data() + i * channels_per_track;
+                const float4 rotation = normalize(float4(pose[0], pose[1], pose[2], pose[3]));
+                const float3 translation(pose[4], pose[5], pose[6]);
+                const float3 scale(pose[7], pose[8], pose[9]);
+                globals[track.boneIndex] = transform(quatf(rotation), translation).matrix() * make_scaling_matrix(scale);
+            }
+
+            finalize_palette();
+        }
+
+        // Object-space global pose position of joint `i` as of the last animate()
+        float3 joint_position(const size_t i) const { return globals[i][3].xyz(); }
+
+        // First bone whose parentIndex falls outside the array (parent-before-child
+        // ordering puts the root first in practice)
+        size_t root_joint_index() const
+        {
+            for (size_t i = 0; i < bones.size(); ++i) if (bones[i].parentIndex >= bones.size()) return i;
+            return 0;
+        }
+
+    private:
+
+        static const int channels_per_track = 10; // quat4 + translation3 + scale3
+
+        std::vector<float4x4> globals;       // scratch, sized with the palette
+        std::vector<float> blendA, blendB, blendT; // structure-of-arrays blend blocks
+
+        // Accumulate parent transforms (parent-before-child ordering), then fold
+        // in the inverse bind to produce the final palette
+        void finalize_palette()
+        {
+            for (size_t i = 0; i < bones.size(); ++i)
+            {
+                if (bones[i].parentIndex < bones.size()) globals[i] = globals[bones[i].parentIndex] * globals[i];
+                palette[i] = globals[i] * bones[i].bindPose;
+            }
+        }
+
+        static void decode_key(const compiled_animation & clip, const compiled_animation::track_range & track, const uint32_t key, float * out)
+        {
+            const size_t k = track.firstKey + key;
+            const int16_t * r = clip.keyRotations.data() + k * 4;
+            const uint16_t * t = clip.keyTranslations.data() + k * 3;
+            const uint16_t * s = clip.keyScales.data() + k * 3;
+            for (int c = 0; c < 4; ++c) out[c] = r[c] * (1.f / 32767.f);
+            for (int c = 0; c < 3; ++c) out[4 + c] = track.translationMin[c] + (t[c] * (1.f / 65535.f)) * track.translationExtent[c];
+            for (int c = 0; c < 3; ++c) out[7 + c] = track.scaleMin[c] + (s[c] * (1.f / 65535.f)) * track.scaleExtent[c];
+        }
+
+        // a = a + t * (b - a) across every channel of every track in one pass
+        static void blend_channels(float * a, const float * b, const float * t, const size_t count)
+        {
+            size_t i = 0;
+#if defined(POLYMER_MATH_PRIMITIVES_SSE2)
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 va = _mm_loadu_ps(a + i);
+                const __m128 vb = _mm_loadu_ps(b + i);
+                const __m128 vt = _mm_loadu_ps(t + i);
+                _mm_storeu_ps(a + i, _mm_add_ps(va, _mm_mul_ps(vt, _mm_sub_ps(vb, va))));
+            }
+#endif
+            for (; i < count; ++i) a[i] = a[i] + t[i] * (b[i] - a[i]);
+        }
+
+        static float4x4 sample_track(const animation_track & track, const float frame)
+        {
+            const auto & keys = track.keyframes;
+
+            // Bracket the requested frame (keyframes are stored in key order)
+            size_t next = 0;
+            while (next < keys.size() && keys[next]->key < frame) ++next;
+
+            if (next == 0) return compose(*keys.front());
+            if (next == keys.size()) return compose(*keys.back());
+
+            const animation_keyframe & a = *keys[next - 1];
+            const animation_keyframe & b = *keys[next];
+            const float span = static_cast<float>(b.key - a.key);
+            const float t = span > 0.f ? (frame - a.key) / span : 0.f;
+
+            animation_keyframe blended;
+            float4 rotB = b.rotation;
+            if (dot(a.rotation, rotB) < 0.f) rotB = -rotB; // take the short arc
+            blended.rotation = slerp(a.rotation, rotB, t);
+            blended.translation = lerp(a.translation, b.translation, t);
+            blended.scale = lerp(a.scale, b.scale, t);
+            return compose(blended);
+        }
+
+        static float4x4 compose(const animation_keyframe & key)
+        {
+            return transform(quatf(normalize(key.rotation)), key.translation).matrix() * make_scaling_matrix(key.scale);
+        }
+    };
+
+    ///////////////////////////
+    //   animation_bounds    //
+    ///////////////////////////
+
+    // Bind-pose bounds cull animated characters incorrectly, and inflating them by
+    // hand defeats the octree. Instead, joint excursion is baked per clip at import
+    // time (alongside compile_animation): the clip is sampled through the hierarchy
+    // and every joint position, padded by the mesh's skin radius, unions into
+    // object-space clip bounds. The excursion radius - how far any padded joint
+    // strays from the root joint - drives the cheap per-frame approximation in
+    // skinned_mesh_state::approximate_local_bounds.
+    struct animation_bounds
+    {
+        aabb_3d clip_bounds;             // object-space union over the sampled clip, skin-padded
+        float excursion_radius{ 0.f };   // max skin-padded joint distance from the root joint
+    };
+
+    // Max distance from any vertex to the bind-pose position of its highest-weighted
+    // joint; the padding that turns joint bounds into mesh bounds
+    inline float compute_skin_radius(const runtime_skinned_mesh & mesh)
+    {
+        if (mesh.bones.empty() || mesh.boneIndices.size() != mesh.vertices.size()) return 0.f;
+
+        // bone::bindPose is the inverse bind matrix, so its inverse carries the
+        // joint back to its bind-pose position in mesh space
+        std::vector<float3> jointPositions(mesh.bones.size());
+        for (size_t i = 0; i < mesh.bones.size(); ++i) jointPositions[i] = inverse(mesh.bones[i].bindPose)[3].xyz();
+
+        float radius = 0.f;
+        for (size_t v = 0; v < mesh.vertices.size(); ++v)
+        {
+            const int4 & idx = mesh.boneIndices[v];
+            const float4 & w = mesh.boneWeights[v];
+            int dominant = idx.x;
+            float best = w.x;
+            if (w.y > best) { best = w.y; dominant = idx.y; }
+            if (w.z > best) { best = w.z; dominant = idx.z; }
+            if (w.w > best) { best = w.w; dominant = idx.w; }
+            if (dominant < 0 || dominant >= static_cast<int>(jointPositions.size())) continue;
+            radius = std::max(radius, length(mesh.vertices[v] - jointPositions[dominant]));
+        }
+        return radius;
+    }
+
+    inline animation_bounds compute_animation_bounds(const skeletal_animation & clip,
+                                                     const std::vector<bone> & bones,
+                                                     const float skin_radius,
+                                                     const uint32_t samples = 32,
+                                                     const float fps = 24.f)
+    {
+        animation_bounds result;
+        if (bones.empty()) return result;
+
+        skeleton_instance instance;
+        instance.set_bones(bones);
+        const size_t root = instance.root_joint_index();
+        const float duration = clip.total_time(fps);
+
+        float3 boundsMin(std::numeric_limits<float>::max());
+        float3 boundsMax(-std::numeric_limits<float>::max());
+
+        for (uint32_t s = 0; s < samples; ++s)
+        {
+            const float t = samples > 1 ? duration * (static_cast<float>(s) / (samples - 1)) : 0.f;
+            instance.animate(clip, t, fps);
+
+            const float3 rootPosition = instance.joint_position(root);
+            for (size_t j = 0; j < bones.size(); ++j)
+            {
+                const float3 p = instance.joint_position(j);
+                boundsMin = linalg::min(boundsMin, p - skin_radius);
+                boundsMax = linalg::max(boundsMax, p + skin_radius);
+                result.excursion_radius = std::max(result.excursion_radius, length(p - rootPosition) + skin_radius);
+            }
+        }
+
+        result.clip_bounds = { boundsMin, boundsMax };
+        return result;
+    }
+
+    //////////////////////////
+    //   skinned_mesh_state //
+    //////////////////////////
+
+    // Runtime-only per-entity skinning state tracked by the render_system. The skin
+    // attribute buffer owns the per-vertex bone indices/weights wired into the gpu
+    // mesh's vao at locations 10/11 (6-9 carry the instancing matrix columns).
+    struct skinned_mesh_state
+    {
+        skeleton_instance skeleton;
+        gl_buffer skin_attributes;
+        animation_bounds bounds; // baked for the active clip via compute_animation_bounds
+
+        // Cheap per-frame bounds: a cube of the clip's excursion radius centered on
+        // the current root joint. Callers push this into their entity's
+        // geometry_component::set_local_bounds_override after animate() so the
+        // spatial index and shadow caster masks track the pose instead of the bind
+        // pose. Falls back to `bind_bounds` until clip bounds are baked.
+        aabb_3d approximate_local_bounds(const aabb_3d & bind_bounds) const
+        {
+            if (bounds.excursion_radius <= 0.f || skeleton.bones.empty()) return bind_bounds;
+            const float3 root = skeleton.joint_position(skeleton.root_joint_index());
+            const float3 r(bounds.excursion_radius);
+            return { root - r, root + r };
+        }
+    };
+
+    // Uploads bone indices/weights from an imported skinned mesh and attaches them
+    // to `mesh` as static per-vertex attributes. Indices ride as float4 so the
+    // attribute stream stays uniform with everything else polymer submits; the
+    // vertex stage casts them back.
+    inline void set_skinning_attributes(gl_mesh & mesh, gl_buffer & skin_buffer, const runtime_skinned_mesh & source)
+    {
+        struct skin_vertex { float4 indices; float4 weights; };
+        assert(source.boneIndices.size() == source.boneWeights.size());
+
+        std::vector<skin_vertex> vertices(source.boneIndices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const int4 & idx = source.boneIndices[i];
+            float4 w = source.boneWeights[i];
+            const float sum = w.x + w.y + w.z + w.w;
+            if (sum > 0.f) w /= sum;
+            vertices[i].indices = float4(float(idx.x), float(idx.y), float(idx.z), float(idx.w));
+            vertices[i].weights = w;
+        }
+
+        skin_buffer.memory.set_category(gl_memory_category::meshes);
+        skin_buffer.set_buffer_data(vertices.size() * sizeof(skin_vertex), vertices.data(), GL_STATIC_DRAW);
+
+        // Divisor zero: a regular per-vertex attribute sourced from the external buffer
+        mesh.set_instance_attribute_buffer(skin_buffer, 10, 4, GL_FLOAT, GL_FALSE, sizeof(skin_vertex), (GLvoid *)0, 0);
+        mesh.set_instance_attribute_buffer(skin_buffer, 11, 4, GL_FLOAT, GL_FALSE, sizeof(skin_vertex), (GLvoid *)sizeof(float4), 0);
+    }
+
+} // end namespace polymer
+
+#endif // end polymer_skinning_hpp
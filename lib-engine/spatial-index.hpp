@@ -0,0 +1,300 @@
+#pragma once
+
+#ifndef polymer_spatial_index_hpp
+#define polymer_spatial_index_hpp
+
+#include "ecs/core-ecs.hpp"
+#include "octree.hpp"
+#include "memory-arena.hpp"
+
+#include <unordered_map>
+
+namespace polymer
+{
+
+    // World-space bounds from the eight transformed corners of a (scaled) local box
+    inline aabb_3d compute_world_bounds(const transform & pose, const float3 & scale, const aabb_3d & localBounds)
+    {
+        float3 boundsMin(std::numeric_limits<float>::infinity()), boundsMax(-std::numeric_limits<float>::infinity());
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const float3 localCorner = float3(
+                (corner & 1) ? localBounds.max().x : localBounds.min().x,
+                (corner & 2) ? localBounds.max().y : localBounds.min().y,
+                (corner & 4) ? localBounds.max().z : localBounds.min().z) * scale;
+            const float3 worldCorner = pose.transform_coord(localCorner);
+            boundsMin = linalg::min(boundsMin, worldCorner);
+            boundsMax = linalg::max(boundsMax, worldCorner);
+        }
+        return { boundsMin, boundsMax };
+    }
+
+    /////////////////////////////
+    //   scene_spatial_index   //
+    /////////////////////////////
+
+    // One incremental spatial structure for the whole scene: frustum culling and
+    // entity raycasts query the same loose octree, refreshed once per frame from
+    // world transforms (upsert is a containment check while an entity moves within
+    // its octant's inflated bounds). Entities whose bounds fall outside the root
+    // volume are kept on an overflow list and conservatively included in every
+    // query, so nothing is ever lost to the index.
+    class scene_spatial_index
+    {
+        struct tracked
+        {
+            entity value;
+            node_container<entity> node;
+            bool indexed{ false };
+            uint32_t revision{ 0 }; // bumped when the entity's bounds actually change
+            tracked(const entity e, const aabb_3d & bounds) : value(e), node(value, bounds) {}
+        };
+
+        octree<entity> tree;
+        std::unordered_map<entity, std::unique_ptr<tracked>> entries;
+        uint32_t indexRevision{ 0 };
+
+        // Temporal visibility cache for cull_incremental: one per registered view. Each
+        // entity stores the signed slack of its last frustum test (distance inside or
+        // outside the nearest plane); while the accumulated frustum drift since that test
+        // stays below the slack, the old classification cannot have flipped and is reused.
+        struct cached_classification
+        {
+            float margin{ 0.f };      // +inside / -outside the nearest plane by this much
+            float driftAtTest{ 0.f }; // cache drift total when the margin was computed
+            uint32_t revision{ 0 };   // entity revision the margin was computed against
+            bool visible{ false };
+        };
+
+        struct view_visibility_cache
+        {
+            frustum lastFrustum;
+            float accumulatedDrift{ 0.f };
+            bool valid{ false };
+            std::unordered_map<entity, cached_classification> classifications;
+        };
+
+        std::unordered_map<uint32_t, view_visibility_cache> viewCaches;
+
+        // Signed slack of an aabb against the nearest frustum plane; >= 0 matches the
+        // conservative intersects_aabb test (fully or partially inside)
+        static float frustum_margin(const frustum & f, const aabb_3d & bounds)
+        {
+            const float3 center = bounds.center();
+            const float3 half = bounds.size() * 0.5f;
+            float margin = std::numeric_limits<float>::max();
+            for (int p = 0; p < 6; ++p)
+            {
+                const float r = dot(linalg::abs(f.planes[p].get_normal()), half);
+                margin = std::min(margin, f.planes[p].distance_to(center) + r);
+            }
+            return margin;
+        }
+
+        // Upper bound on how much any indexed point's plane distance changed between two
+        // frustums: |dn| * R + |dd| per plane, with R covering the whole root volume
+        float plane_drift_bound(const frustum & a, const frustum & b) const
+        {
+            const float3 extremity = linalg::max(linalg::abs(tree.root->box.min()), linalg::abs(tree.root->box.max()));
+            const float R = length(extremity);
+            float drift = 0.f;
+            for (int p = 0; p < 6; ++p)
+            {
+                const float4 d = b.planes[p].equation - a.planes[p].equation;
+                drift = std::max(drift, length(d.xyz()) * R + std::abs(d.w()));
+            }
+            return drift;
+        }
+
+        // Reused SoA scratch for the batch frustum classifier (cull runs several times per frame)
+        struct
+        {
+            std::vector<float> cx, cy, cz, hx, hy, hz;
+            std::vector<entity> candidates;
+            std::vector<uint8_t> visible;
+        } cullScratch;
+
+        scene_spatial_index(const scene_spatial_index &) = delete;
+        scene_spatial_index & operator = (const scene_spatial_index &) = delete;
+
+        void try_index(tracked & t)
+        {
+            if (inside_root(t.node.worldspaceBounds))
+            {
+                tree.create(t.node);
+                t.indexed = true;
+            }
+        }
+
+        bool inside_root(const aabb_3d & bounds) const
+        {
+            return linalg::all(gequal(bounds.min(), tree.root->box.min())) &&
+                   linalg::all(lequal(bounds.max(), tree.root->box.max()));
+        }
+
+    public:
+
+        scene_spatial_index(const aabb_3d & world_bounds = { { -128, -128, -128 }, { +128, +128, +128 } }, const uint32_t max_depth = 8)
+            : tree(max_depth, world_bounds)
+        {
+            tree.looseness = 2.f;
+        }
+
+        // Inserts or refreshes the world bounds for an entity
+        void upsert(const entity e, const aabb_3d & world_bounds)
+        {
+            auto iter = entries.find(e);
+            if (iter == entries.end())
+            {
+                std::unique_ptr<tracked> t(new tracked(e, world_bounds));
+                t->revision = ++indexRevision;
+                try_index(*t);
+                entries[e] = std::move(t);
+                return;
+            }
+
+            tracked & t = *iter->second;
+
+            // A stationary entity keeps its revision (and its cached classifications), and
+            // skips the octree containment check entirely
+            const aabb_3d & old_bounds = t.node.worldspaceBounds;
+            if (linalg::all(equal(old_bounds.min(), world_bounds.min())) &&
+                linalg::all(equal(old_bounds.max(), world_bounds.max()))) return;
+
+            t.revision = ++indexRevision;
+            t.node.worldspaceBounds = world_bounds;
+            if (t.indexed)
+            {
+                if (inside_root(world_bounds)) tree.update(t.node);
+                else { tree.remove(t.node); t.indexed = false; }
+            }
+            else try_index(t);
+        }
+
+        void remove(const entity e)
+        {
+            auto iter = entries.find(e);
+            if (iter == entries.end()) return;
+            if (iter->second->indexed) tree.remove(iter->second->node);
+            entries.erase(iter);
+            for (auto & cache : viewCaches) cache.second.classifications.erase(e);
+        }
+
+        size_t size() const { return entries.size(); }
+
+        // Releases a bounded number of octants emptied by moving entities (octree::refit
+        // defers this). Call once per frame after the upsert pass.
+        void rebalance(const uint32_t budget = 64) { tree.rebalance(budget); }
+
+        // Entities whose bounds potentially intersect the view frustum
+        void cull(const frustum & camera, std::vector<entity> & out)
+        {
+            small_vector<octant<entity> *, 128> visibleNodes;
+            tree.cull(camera, visibleNodes, nullptr, false);
+
+            // Octant-granularity culling keeps everything resident in a partially visible
+            // octant, so re-test each candidate's own bounds with the SIMD batch classifier
+            cullScratch.cx.clear(); cullScratch.cy.clear(); cullScratch.cz.clear();
+            cullScratch.hx.clear(); cullScratch.hy.clear(); cullScratch.hz.clear();
+            cullScratch.candidates.clear();
+
+            for (octant<entity> * node : visibleNodes)
+            {
+                for (auto & obj : node->objects)
+                {
+                    const float3 center = obj.worldspaceBounds.center();
+                    const float3 half = obj.worldspaceBounds.size() * 0.5f;
+                    cullScratch.cx.push_back(center.x); cullScratch.cy.push_back(center.y); cullScratch.cz.push_back(center.z);
+                    cullScratch.hx.push_back(half.x); cullScratch.hy.push_back(half.y); cullScratch.hz.push_back(half.z);
+                    cullScratch.candidates.push_back(obj.object);
+                }
+            }
+
+            const size_t candidateCount = cullScratch.candidates.size();
+            cullScratch.visible.resize(candidateCount);
+
+            frustum_cull_aabb_soa(camera,
+                cullScratch.cx.data(), cullScratch.cy.data(), cullScratch.cz.data(),
+                cullScratch.hx.data(), cullScratch.hy.data(), cullScratch.hz.data(),
+                candidateCount, cullScratch.visible.data());
+
+            for (size_t i = 0; i < candidateCount; ++i)
+            {
+                if (cullScratch.visible[i]) out.push_back(cullScratch.candidates[i]);
+            }
+
+            for (auto & e : entries) if (!e.second->indexed) out.push_back(e.first); // overflow
+        }
+
+        // Temporal variant of cull() for per-camera render culls, keyed by a caller-chosen
+        // view id. Last frame's classification is retained per entity; a frame only re-tests
+        // entities near a frustum boundary (cached slack smaller than the accumulated frustum
+        // drift) or whose bounds changed since they were classified, so a slow-moving camera
+        // re-evaluates a few percent of the scene instead of all of it. A teleport (drift
+        // exceeding a quarter of the root extent) throws the cache away and re-culls fully.
+        // Produces exactly the same conservative set as cull().
+        void cull_incremental(const uint32_t view_id, const frustum & camera, std::vector<entity> & out)
+        {
+            view_visibility_cache & cache = viewCaches[view_id];
+
+            const float3 extremity = linalg::max(linalg::abs(tree.root->box.min()), linalg::abs(tree.root->box.max()));
+            const float drift = cache.valid ? plane_drift_bound(cache.lastFrustum, camera) : 0.f;
+
+            if (!cache.valid || drift > 0.25f * length(extremity))
+            {
+                cache.classifications.clear();
+                cache.accumulatedDrift = 0.f;
+            }
+            else cache.accumulatedDrift += drift;
+
+            cache.lastFrustum = camera;
+            cache.valid = true;
+
+            for (auto & e : entries)
+            {
+                tracked & t = *e.second;
+
+                if (!t.indexed) { out.push_back(e.first); continue; } // overflow, conservatively included
+
+                cached_classification & c = cache.classifications[e.first];
+
+                // A cached verdict holds while the frustum cannot have drifted across the
+                // entity's recorded slack and the entity itself has not moved
+                const bool held = (c.revision == t.revision) &&
+                    (std::abs(c.margin) > cache.accumulatedDrift - c.driftAtTest);
+
+                if (!held)
+                {
+                    c.margin = frustum_margin(camera, t.node.worldspaceBounds);
+                    c.driftAtTest = cache.accumulatedDrift;
+                    c.revision = t.revision;
+                    c.visible = (c.margin >= 0.f);
+                }
+
+                if (c.visible) out.push_back(e.first);
+            }
+        }
+
+        // Entities whose bounds potentially intersect the ray
+        void query_ray(const ray & world_ray, std::vector<entity> & out)
+        {
+            std::vector<octant<entity> *> hitNodes;
+            tree.query_ray(world_ray, hitNodes);
+            for (octant<entity> * node : hitNodes)
+            {
+                for (auto & obj : node->objects)
+                {
+                    float outMinT, outMaxT;
+                    if (intersect_ray_box(world_ray, obj.worldspaceBounds.min(), obj.worldspaceBounds.max(), &outMinT, &outMaxT))
+                    {
+                        out.push_back(obj.object);
+                    }
+                }
+            }
+            for (auto & e : entries) if (!e.second->indexed) out.push_back(e.first); // overflow
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_spatial_index_hpp
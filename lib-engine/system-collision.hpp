@@ -7,6 +7,7 @@
 #include "asset-handle-utils.hpp"
 #include "ecs/typeid.hpp"
 #include "ecs/core-ecs.hpp"
+#include "spatial-index.hpp"
 #include "system-transform.hpp"
 #include "environment.hpp"
 
@@ -24,12 +25,27 @@ namespace polymer
     };
 
     // todo - need to support proxy mesh (sphere or box)
-    // todo - accelerate using spatial data structure (use existing octree?)
     class collision_system final : public base_system
     {
         std::unordered_map<entity, geometry_component> meshes;
         transform_system * xform_system{ nullptr };
 
+        // Shared scene broadphase: raycasts here and frustum culling elsewhere
+        // query the same structure, refreshed once from world transforms
+        scene_spatial_index spatial_index;
+        bool spatial_index_valid{ false };
+
+        // Potential cross-orchestrator issues here
+        void resolve_transform_system()
+        {
+            if (!xform_system)
+            {
+                base_system * xform_base = orchestrator->get_system(get_typeid<transform_system>());
+                xform_system = dynamic_cast<transform_system *>(xform_base);
+                assert(xform_system != nullptr);
+            }
+        }
+
         template<class F> friend void visit_components(entity e, collision_system * system, F f);
         friend class asset_resolver;
 
@@ -40,16 +56,50 @@ namespace polymer
             register_system_for_type(this, get_typeid<geometry_component>());
         }
 
-        entity_hit_result raycast(const ray & world_ray, const raycast_type type = raycast_type::mesh)
+        // Refreshes the shared spatial index from world_transform_components. Call once per
+        // frame (before any frustum culls or raycasts); an upsert for an entity that moved
+        // within its octant's loose bounds is just a containment check.
+        void update_spatial_index()
         {
-            // Potential cross-orchestrator issues here
-            if (!xform_system)
+            resolve_transform_system();
+
+            entity_activity_tracker & activity = orchestrator->get_activity_tracker();
+
+            for (auto & mesh : meshes)
             {
-                base_system * xform_base = orchestrator->get_system(get_typeid<transform_system>());
-                xform_system = dynamic_cast<transform_system *>(xform_base);
-                assert(xform_system != nullptr);
+                if (mesh.first == kInvalidEntity) continue;
+
+                // A sleeping entity hasn't been touched (no transform writes) since it was
+                // last upserted while awake, so its cached index entry is already correct
+                if (spatial_index_valid && activity.is_tracked(mesh.first) && !activity.is_awake(mesh.first)) continue;
+
+                if (!xform_system->has_transform(mesh.first)) continue;
+                if (mesh.second.geom.get().vertices.empty()) continue;
+
+                const transform meshPose = xform_system->get_world_transform(mesh.first)->world_pose;
+                const float3 meshScale = xform_system->get_local_transform(mesh.first)->local_scale;
+                spatial_index.upsert(mesh.first, compute_world_bounds(meshPose, meshScale, mesh.second.get_local_bounds()));
             }
 
+            // Amortized cleanup of octants emptied by entities that moved this frame
+            spatial_index.rebalance();
+
+            spatial_index_valid = true;
+        }
+
+        // The renderer's frustum culling queries this same index
+        scene_spatial_index & get_spatial_index() { return spatial_index; }
+
+        entity_hit_result raycast(const ray & world_ray, const raycast_type type = raycast_type::mesh)
+        {
+            resolve_transform_system();
+
+            if (!spatial_index_valid) update_spatial_index();
+
+            // Broad-phase candidates from the shared index
+            std::vector<entity> candidates;
+            spatial_index.query_ray(world_ray, candidates);
+
             auto raycast_mesh = [&](entity e) -> raycast_result
             {
                 if (!xform_system->has_transform(e)) return {};
@@ -92,20 +142,19 @@ namespace polymer
             entity hit_entity = kInvalidEntity;
             raycast_result out_result;
 
-            // fixme - we really need an environment-wide spatial data structure for this
             if (type == raycast_type::mesh)
             {
-                for (const auto & mesh : meshes)
+                for (const entity e : candidates)
                 {
-                    if (mesh.first == kInvalidEntity) continue;
+                    if (e == kInvalidEntity || meshes.find(e) == meshes.end()) continue;
 
-                    raycast_result res = raycast_mesh(mesh.first);
+                    raycast_result res = raycast_mesh(e);
                     if (res.hit)
                     {
                         if (res.distance < best_t)
                         {
                             best_t = res.distance;
-                            hit_entity = mesh.first;
+                            hit_entity = e;
                             out_result = res;
                         }
                     }
@@ -113,17 +162,17 @@ namespace polymer
             }
             else if (type == raycast_type::box)
             {
-                for (const auto & mesh : meshes)
+                for (const entity e : candidates)
                 {
-                    if (mesh.first == kInvalidEntity) continue;
+                    if (e == kInvalidEntity || meshes.find(e) == meshes.end()) continue;
 
-                    raycast_result res = raycast_box(mesh.first);
+                    raycast_result res = raycast_box(e);
                     if (res.hit)
                     {
                         if (res.distance < best_t)
                         {
                             best_t = res.distance;
-                            hit_entity = mesh.first;
+                            hit_entity = e;
                             out_result = res;
                         }
                     }
@@ -134,16 +183,121 @@ namespace polymer
             else return { kInvalidEntity, raycast_result() };
         }
 
+        // Entities whose world bounds intersect the given frustum. Broad-phase through
+        // the shared spatial index (the same path the renderer's culling takes), so the
+        // editor's rubber-band selection never walks the full entity list.
+        void query_frustum(const frustum & f, std::vector<entity> & out)
+        {
+            resolve_transform_system();
+            if (!spatial_index_valid) update_spatial_index();
+            spatial_index.cull(f, out);
+        }
+
+        // Per-camera variant that retains last frame's visible set (keyed by view_id) and
+        // only re-tests entities near frustum boundaries or whose bounds changed - the right
+        // call for a cull that repeats every frame from a slowly moving camera. One-shot
+        // queries (e.g. rubber-band selection) should keep using query_frustum.
+        void query_frustum_incremental(const uint32_t view_id, const frustum & f, std::vector<entity> & out)
+        {
+            resolve_transform_system();
+            if (!spatial_index_valid) update_spatial_index();
+            spatial_index.cull_incremental(view_id, f, out);
+        }
+
+        // Batched raycast: one result per input ray, closest hit each. The per-entity world
+        // bounds and inverse poses are gathered once for the whole batch, and every ray runs a
+        // cheap slab test against those bounds before the (BVH-accelerated) triangle query - the
+        // previous pattern of calling raycast() in a loop re-derived all of that N*M times. Used
+        // for VR interaction where two controllers, teleport arc samples and UI hit tests all
+        // query the same scene within one frame.
+        std::vector<entity_hit_result> raycast_batch(const std::vector<ray> & world_rays, const raycast_type type = raycast_type::mesh)
+        {
+            resolve_transform_system();
+
+            // Broad-phase scene snapshot, shared by all rays in the batch
+            struct scene_primitive
+            {
+                entity e;
+                aabb_3d worldBounds;
+                transform inversePose;
+                float3 scale;
+            };
+
+            std::vector<scene_primitive> primitives;
+            primitives.reserve(meshes.size());
+
+            for (auto & mesh : meshes)
+            {
+                if (mesh.first == kInvalidEntity) continue;
+                if (!xform_system->has_transform(mesh.first)) continue;
+                if (mesh.second.geom.get().vertices.empty()) continue;
+
+                const transform meshPose = xform_system->get_world_transform(mesh.first)->world_pose;
+                const float3 meshScale = xform_system->get_local_transform(mesh.first)->local_scale;
+
+                primitives.push_back({ mesh.first, compute_world_bounds(meshPose, meshScale, mesh.second.get_local_bounds()), meshPose.inverse(), meshScale });
+            }
+
+            std::vector<entity_hit_result> results(world_rays.size());
+
+            for (size_t rayIdx = 0; rayIdx < world_rays.size(); ++rayIdx)
+            {
+                const ray & world_ray = world_rays[rayIdx];
+
+                float best_t = std::numeric_limits<float>::max();
+                entity hit_entity = kInvalidEntity;
+                raycast_result out_result;
+
+                for (const scene_primitive & prim : primitives)
+                {
+                    float boundsMinT, boundsMaxT;
+                    if (!intersect_ray_box(world_ray, prim.worldBounds.min(), prim.worldBounds.max(), &boundsMinT, &boundsMaxT)) continue;
+                    if (boundsMinT > best_t) continue;
+
+                    if (type == raycast_type::box)
+                    {
+                        if (boundsMaxT < best_t)
+                        {
+                            best_t = boundsMaxT;
+                            hit_entity = prim.e;
+                            out_result = raycast_result(true, boundsMaxT, {}, {});
+                        }
+                        continue;
+                    }
+
+                    ray localRay = prim.inversePose * world_ray;
+                    localRay.origin /= prim.scale;
+                    localRay.direction /= prim.scale;
+
+                    float outT = 0.0f;
+                    float3 outNormal = { 0, 0, 0 };
+                    float2 outUv = { -1, -1 };
+                    if (intersect_ray_mesh(localRay, meshes[prim.e].geom.get(), &outT, &outNormal, &outUv) && outT < best_t)
+                    {
+                        best_t = outT;
+                        hit_entity = prim.e;
+                        out_result = raycast_result(true, outT, outNormal, outUv);
+                    }
+                }
+
+                if (out_result.hit) results[rayIdx] = { hit_entity, out_result };
+            }
+
+            return results;
+        }
+
         virtual bool create(entity e, poly_typeid hash, void * data) override final 
         { 
             if (hash != get_typeid<geometry_component>()) { return false; }
             meshes[e] = *static_cast<geometry_component *>(data);
+            spatial_index_valid = false;
             return true;
         }
-        
+
         bool create(entity e, geometry_component && c)
         {
             meshes[e] = std::move(c);
+            spatial_index_valid = false;
             return true;
         }
 
@@ -154,13 +308,15 @@ namespace polymer
             return nullptr;
         }
 
-        virtual void destroy(entity e) override final 
+        virtual void destroy(entity e) override final
         {
             auto iter = meshes.find(e);
             if (iter != meshes.end()) meshes.erase(e);
+            spatial_index.remove(e);
         }
     };
     POLYMER_SETUP_TYPEID(collision_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(geometry_component, collision_system);
 
     template<class F> void visit_components(entity e, collision_system * system, F f)
     {
@@ -17,8 +17,8 @@ namespace polymer
     class identifier_system final : public base_system
     {
         std::unordered_map<entity, identifier_component> entity_to_name_;
-        std::unordered_map<entity, poly_hash_value> entity_to_hash_;
-        std::unordered_map<poly_hash_value, entity> hash_to_entity_;
+        flat_hash_map<entity, symbol_id> entity_to_symbol_;
+        flat_hash_map<symbol_id, entity> symbol_to_entity_;
 
         template<class F> friend void visit_components(entity e, identifier_system * system, F f);
 
@@ -46,30 +46,37 @@ namespace polymer
             return set_name(e, name);
         }
 
+        // Typed overload for the compile-time attach() path.
+        bool create(entity e, identifier_component && c)
+        {
+            return create(e, c.id);
+        }
+
         // Disassociates any name from the entity
         void destroy(entity entity) override final
         {
-            auto iter = entity_to_hash_.find(entity);
-            if (iter != entity_to_hash_.end())
+            auto iter = entity_to_symbol_.find(entity);
+            if (iter != entity_to_symbol_.end())
             {
-                hash_to_entity_.erase(iter->second);
-                entity_to_hash_.erase(iter);
+                symbol_to_entity_.erase(iter->second);
+                entity_to_symbol_.erase(entity);
             }
             entity_to_name_.erase(entity);
         }
 
         // Finds the name associated with the entity. Returns empty string if no name is found.
-        std::string get_name(entity entity) const
+        const std::string & get_name(entity entity)
         {
+            static const std::string no_name;
             const auto iter = entity_to_name_.find(entity);
-            return iter != entity_to_name_.end() ? iter->second.id : "";
+            return iter != entity_to_name_.end() ? iter->second.id : no_name;
         }
 
         bool set_name(entity entity, const std::string & name)
         {
             if (entity == kInvalidEntity) { return false; }
 
-            const std::string existing_name = get_name(entity);
+            const std::string & existing_name = get_name(entity);
             if (existing_name == name) { return false; } // No need to proceed if current name and desired name are identical
 
             // Ensure a different entity with the same name does not already exist. This
@@ -77,26 +84,32 @@ namespace polymer
             // the same entity had been created multiple times.
             if (find_entity(name) != kInvalidEntity) return false; // fail silently
 
-            const auto h = hash(name.c_str());
+            // Names are interned once; every map below keys on the 32-bit symbol
+            const symbol_id symbol = string_interner::get().intern(name);
 
-            hash_to_entity_.erase(hash(existing_name.c_str()));
-            hash_to_entity_[h] = entity;
+            auto previous = entity_to_symbol_.find(entity);
+            if (previous != entity_to_symbol_.end()) symbol_to_entity_.erase(previous->second);
+            symbol_to_entity_[symbol] = entity;
 
             entity_to_name_[entity] = identifier_component(entity, name);
-            entity_to_hash_[entity] = h;
+            entity_to_symbol_[entity] = symbol;
 
             return true;
         }
 
-        entity find_entity(const std::string & name) const
+        // Accepts transient text (string_view lookups never intern), so scene-load
+        // resolution and editor search do not allocate or grow the symbol table.
+        entity find_entity(const string_view name)
         {
-            const auto h = hash(name.c_str());
-            const auto iter = hash_to_entity_.find(h);
-            return iter != hash_to_entity_.end() ? iter->second : kInvalidEntity;
+            const symbol_id symbol = string_interner::get().find(name);
+            if (symbol == kInvalidSymbol) return kInvalidEntity;
+            const auto iter = symbol_to_entity_.find(symbol);
+            return iter != symbol_to_entity_.end() ? iter->second : kInvalidEntity;
         }
     };
 
     POLYMER_SETUP_TYPEID(identifier_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(identifier_component, identifier_system);
 
     // pass-through visit_fields for a string since the id system has no component type
     template<class F> void visit_fields(std::string & str, F f) { f("id", str); }
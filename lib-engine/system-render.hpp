@@ -5,13 +5,20 @@
 
 #include "geometry.hpp"
 #include "asset-handle-utils.hpp"
+#include "morton.hpp"
+
+#include <map>
+#include <unordered_set>
 
 #include "ecs/typeid.hpp"
 #include "ecs/core-ecs.hpp"
 #include "system-transform.hpp"
 #include "system-identifier.hpp"
+#include "system-collision.hpp"
 #include "environment.hpp"
 #include "renderer-pbr.hpp"
+#include "renderer-probes.hpp"
+#include "skinning.hpp"
 
 namespace polymer
 {
@@ -23,9 +30,38 @@ namespace polymer
     class render_system final : public base_system
     {
         std::unordered_map<entity, mesh_component> meshes;
+        std::unordered_map<entity, lod_component> lods;
         std::unordered_map<entity, material_component> materials;
         std::unordered_map<entity, point_light_component> point_lights;
         std::unordered_map<entity, directional_light_component> directional_lights;
+        std::unordered_map<entity, reflection_probe_component> reflection_probes;
+
+        std::unordered_map<entity, gl_texture_2d> bakedProbeChains; // gpu lifetime of the prefiltered mip chains
+        std::unique_ptr<reflection_probe_baker> probeBaker;         // created lazily on first bake
+
+        // Runtime-only skinning state (skeleton + gpu skin attribute buffer) for
+        // animated entities; not serialized, apps rebuild it alongside their meshes
+        std::unordered_map<entity, skinned_mesh_state> skinned_meshes;
+
+        // Runtime-only impostor state (baked octahedral atlas + transition distance);
+        // like skinning state, atlases are rebuilt on the owning gl context
+        std::unordered_map<entity, impostor_state> impostors;
+
+        // Static-batch state (bake_static_batches): synthetic entities carrying merged
+        // world-space chunks, the source entities they replace in the render path
+        // (sources keep their components for picking/serialization), and baked chunk
+        // bounds - synthetic entities have no collision geometry to derive them from
+        std::vector<entity> staticBatchEntities;
+        std::unordered_set<entity> staticallyBatchedSources;
+        std::unordered_map<entity, float4> staticBatchBounds;
+
+        // Per-frame scratch for gather_render_payload (entity snapshot + slot-addressed
+        // assembly output); kept across frames so the gather doesn't reallocate
+        std::vector<entity> gatherEntities;
+        std::vector<render_component> gatherComponents;
+        std::vector<float3> gatherPositions;  // world positions for the Morton reorder
+        std::vector<uint32_t> gatherOrder;    // permutation produced by morton_sort_indices
+        std::vector<entity> gatherScratch;    // re-ordered entity snapshot
 
         renderer_settings settings;
         std::unique_ptr<pbr_renderer> renderer;
@@ -42,9 +78,11 @@ namespace polymer
         render_system(renderer_settings s, entity_orchestrator * orch) : base_system(orch), settings(s)
         {
             register_system_for_type(this, get_typeid<mesh_component>());
+            register_system_for_type(this, get_typeid<lod_component>());
             register_system_for_type(this, get_typeid<material_component>());
             register_system_for_type(this, get_typeid<point_light_component>());
             register_system_for_type(this, get_typeid<directional_light_component>());
+            register_system_for_type(this, get_typeid<reflection_probe_component>());
 
             skybox.reset(new gl_hosek_sky());
             renderer.reset(new pbr_renderer(settings));
@@ -79,9 +117,246 @@ namespace polymer
 
         void reconfigure(const renderer_settings new_settings)
         {
+            // Destroy the old renderer before constructing the new one - building it
+            // first doubles every MSAA/eye/post target for the duration of the call.
+            settings = new_settings;
+            renderer.reset();
             renderer.reset(new pbr_renderer(settings));
         }
 
+        // Fills `payload` with everything the renderer consumes this frame: assembled
+        // render components (lod resolution and impostor tagging included), point lights,
+        // reflection probes, the skybox and the implicit sunlight. Views and ibl handles
+        // remain the caller's responsibility. Component assembly is chunked over the task
+        // scheduler once the scene is large enough to cover the scheduling overhead; each
+        // worker writes its own slot range of the scratch array, so the merge into the
+        // payload is a single filtered append with no locking.
+        void gather_render_payload(environment & env, const float3 & view_position, render_payload & payload)
+        {
+            payload.render_components.clear();
+            payload.point_lights.clear();
+            payload.reflection_probes.clear();
+
+            // Snapshot the candidate set (anything carrying a material) so the pool
+            // iteration below is index-addressable
+            gatherEntities.clear();
+            for (auto & m : materials)
+            {
+                // Batched sources draw through their merged chunk instead
+                if (!staticallyBatchedSources.empty() && staticallyBatchedSources.count(m.first)) continue;
+                gatherEntities.push_back(m.first);
+            }
+
+            // Reorder the snapshot along a Morton curve so assembly and every
+            // downstream pass (culling, bucketing, instance runs) walk spatial
+            // neighbours in adjacent slots instead of hash-map order. Small
+            // scenes fit in cache either way and skip the sort.
+            if (gatherEntities.size() >= 256)
+            {
+                gatherPositions.clear();
+                for (const entity e : gatherEntities)
+                {
+                    const world_transform_component * xform = xform_system->get_world_transform(e);
+                    gatherPositions.push_back(xform ? xform->world_pose.position : float3(0, 0, 0));
+                }
+
+                gatherOrder.resize(gatherEntities.size());
+                morton_sort_indices(gatherPositions.data(), gatherPositions.size(), gatherOrder.data());
+
+                gatherScratch.resize(gatherEntities.size());
+                for (size_t i = 0; i < gatherOrder.size(); ++i) gatherScratch[i] = gatherEntities[gatherOrder[i]];
+                gatherEntities.swap(gatherScratch);
+            }
+
+            gatherComponents.resize(gatherEntities.size());
+
+            // Assembly only reads shared system state and writes per-entity slots,
+            // so chunks are independent
+            parallel_for(0, gatherEntities.size(), 512, [this, &env, &view_position](const size_t i)
+            {
+                gatherComponents[i] = assemble_render_component(env, gatherEntities[i], view_position);
+            });
+
+            for (auto & r : gatherComponents)
+            {
+                // A material whose mesh hasn't been set yet (mid-edit) assembles incomplete
+                if (r.mesh && r.world_transform)
+                {
+                    // Chunk entities carry no collision geometry, so their culling
+                    // sphere comes from the bounds recorded at bake time
+                    if (!staticBatchBounds.empty())
+                    {
+                        auto bounds = staticBatchBounds.find(r.get_entity());
+                        if (bounds != staticBatchBounds.end()) r.world_bounding_sphere = bounds->second;
+                    }
+                    payload.render_components.push_back(r);
+                }
+            }
+
+            for (auto & light : point_lights) payload.point_lights.push_back(&light.second);
+
+            for (auto & probe : reflection_probes)
+            {
+                if (auto * probe_xform = xform_system->get_world_transform(probe.first)) probe.second.position = probe_xform->world_pose.position;
+                payload.reflection_probes.push_back(&probe.second);
+            }
+
+            payload.skybox = skybox.get();
+            payload.sunlight = get_implicit_sunlight();
+        }
+
+        // Attaches skinning state to an animated entity. Callers wire the skin
+        // attributes into the entity's gpu mesh with set_skinning_attributes and
+        // drive skeleton.animate() per frame; assemble_render_component picks the
+        // palette up from here.
+        skinned_mesh_state & create_skinned_mesh_state(entity e) { return skinned_meshes[e]; }
+
+        skinned_mesh_state * get_skinned_mesh_state(entity e)
+        {
+            auto iter = skinned_meshes.find(e);
+            if (iter != skinned_meshes.end()) return &iter->second;
+            return nullptr;
+        }
+
+        // Attaches a baked impostor to an entity. Apps bake the atlas through
+        // impostor_baker (typically right after import) and the distance-aware
+        // assemble_render_component swaps far instances onto the impostor batch.
+        impostor_state & create_impostor_state(entity e) { return impostors[e]; }
+
+        impostor_state * get_impostor_state(entity e)
+        {
+            auto iter = impostors.find(e);
+            if (iter != impostors.end()) return &iter->second;
+            return nullptr;
+        }
+
+        // Merges immovable set-dressing into combined world-space chunks at scene
+        // activation, collapsing thousands of per-object uniform updates and draws
+        // into a handful per material. Entities bucket by material state (handle,
+        // shadow flags, tint/emissive - these ride the per-object uniforms, so they
+        // must match to share a chunk) and by world-space region of `cell_size`
+        // meters, which keeps chunks local enough for frustum and cascade culling.
+        // Source entities keep every component - picking and serialization see the
+        // scene unchanged - but leave the render path until release_static_batches().
+        // Skinned, lod'd and impostor'd entities never batch; entities moved after
+        // baking need a release + rebake.
+        void bake_static_batches(environment & env, const float cell_size = 16.f)
+        {
+            release_static_batches();
+
+            identifier_system * identifier_sys = dynamic_cast<identifier_system *>(orchestrator->get_system(get_typeid<identifier_system>()));
+
+            struct batch_source { entity e; const geometry * geom; transform pose; float3 scale; };
+            std::map<std::string, std::vector<batch_source>> buckets;
+
+            for (auto & m : materials)
+            {
+                const entity e = m.first;
+                if (e == kInvalidEntity) continue;
+                if (meshes.find(e) == meshes.end()) continue;
+                if (lods.find(e) != lods.end()) continue;
+                if (skinned_meshes.find(e) != skinned_meshes.end()) continue;
+                if (impostors.find(e) != impostors.end()) continue;
+                if (!m.second.material.assigned()) continue;
+
+                geometry_component * gc = env.collision_system->get_component(e);
+                if (!gc || !gc->geom.assigned() || gc->geom.get().vertices.empty()) continue;
+
+                const world_transform_component * world = xform_system->get_world_transform(e);
+                const local_transform_component * local = xform_system->get_local_transform(e);
+                if (!world || !local) continue;
+
+                const float3 center = world->world_pose.transform_coord(gc->get_local_bounds().center() * local->local_scale);
+                const int3 cell(static_cast<int>(std::floor(center.x / cell_size)),
+                                static_cast<int>(std::floor(center.y / cell_size)),
+                                static_cast<int>(std::floor(center.z / cell_size)));
+
+                char key[320];
+                std::snprintf(key, sizeof(key), "%s|%d%d|%a,%a,%a,%a|%a|%d,%d,%d",
+                    m.second.material.name.c_str(), m.second.cast_shadow ? 1 : 0, m.second.receive_shadow ? 1 : 0,
+                    m.second.tint.x, m.second.tint.y, m.second.tint.z, m.second.tint.w, m.second.emissive_strength,
+                    cell.x, cell.y, cell.z);
+
+                buckets[key].push_back({ e, &gc->geom.get(), world->world_pose, local->local_scale });
+            }
+
+            uint32_t batchIndex = 0;
+            for (auto & bucket : buckets)
+            {
+                if (bucket.second.size() < 2) continue; // a singleton draws cheaper unbatched
+
+                geometry merged;
+                for (const batch_source & src : bucket.second)
+                {
+                    const geometry & g = *src.geom;
+                    const uint32_t base = static_cast<uint32_t>(merged.vertices.size());
+
+                    // Inverse-transpose handling for non-uniform scale: directions
+                    // divide by the scale before rotating, tangents multiply by it
+                    const float3 invScale = 1.f / linalg::max(src.scale, float3(1e-6f));
+
+                    for (const float3 & v : g.vertices) merged.vertices.push_back(src.pose.transform_coord(v * src.scale));
+                    for (const float3 & n : g.normals) merged.normals.push_back(safe_normalize(src.pose.transform_vector(n * invScale)));
+                    for (const float3 & t : g.tangents) merged.tangents.push_back(safe_normalize(src.pose.transform_vector(t * src.scale)));
+                    for (const float3 & b : g.bitangents) merged.bitangents.push_back(safe_normalize(src.pose.transform_vector(b * src.scale)));
+                    merged.texcoord0.insert(merged.texcoord0.end(), g.texcoord0.begin(), g.texcoord0.end());
+                    merged.texcoord1.insert(merged.texcoord1.end(), g.texcoord1.begin(), g.texcoord1.end());
+                    merged.colors.insert(merged.colors.end(), g.colors.begin(), g.colors.end());
+
+                    // Sources with a sparser attribute set pad with zeros so the
+                    // merged arrays stay index-aligned with the vertices
+                    merged.normals.resize(merged.vertices.size(), float3(0.f));
+                    merged.tangents.resize(merged.vertices.size(), float3(0.f));
+                    merged.bitangents.resize(merged.vertices.size(), float3(0.f));
+                    merged.texcoord0.resize(merged.vertices.size(), float2(0.f));
+                    merged.texcoord1.resize(merged.vertices.size(), float2(0.f));
+                    merged.colors.resize(merged.vertices.size(), float4(0.f));
+
+                    for (const uint3 & f : g.faces) merged.faces.push_back(f + base);
+                }
+
+                const aabb_3d bounds = compute_bounds(merged);
+
+                const std::string asset_id = "static-batch-" + std::to_string(batchIndex++);
+                create_handle_for_asset(asset_id.c_str(), make_mesh_from_geometry(merged));
+
+                const entity batch = orchestrator->create_entity();
+                xform_system->create(batch, transform(), float3(1.f, 1.f, 1.f)); // chunks are pre-transformed to world space
+                if (identifier_sys) identifier_sys->create(batch, asset_id);
+
+                mesh_component batchMesh(batch, gpu_mesh_handle(asset_id.c_str()));
+                create(batch, std::move(batchMesh));
+
+                const material_component & proto = materials[bucket.second.front().e];
+                material_component batchMaterial(batch, proto.material);
+                batchMaterial.cast_shadow = proto.cast_shadow;
+                batchMaterial.receive_shadow = proto.receive_shadow;
+                batchMaterial.tint = proto.tint;
+                batchMaterial.emissive_strength = proto.emissive_strength;
+                create(batch, std::move(batchMaterial));
+
+                staticBatchEntities.push_back(batch);
+                staticBatchBounds[batch] = float4(bounds.center(), 0.5f * length(bounds.size()));
+                for (const batch_source & src : bucket.second) staticallyBatchedSources.insert(src.e);
+            }
+        }
+
+        // Returns batched sources to the per-entity render path and drops the
+        // synthetic chunk entities (their gpu meshes stay in the asset table until
+        // the next bake overwrites them)
+        void release_static_batches()
+        {
+            for (const entity e : staticBatchEntities)
+            {
+                meshes.erase(e);
+                materials.erase(e);
+                xform_system->destroy(e);
+            }
+            staticBatchEntities.clear();
+            staticBatchBounds.clear();
+            staticallyBatchedSources.clear();
+        }
+
         mesh_component * get_mesh_component(entity e)
         {
             auto iter = meshes.find(e);
@@ -89,6 +364,13 @@ namespace polymer
             return nullptr;
         }
 
+        lod_component * get_lod_component(entity e)
+        {
+            auto iter = lods.find(e);
+            if (iter != lods.end()) return &iter->second;
+            return nullptr;
+        }
+
         material_component * get_material_component(entity e)
         {
             auto iter = materials.find(e);
@@ -110,50 +392,108 @@ namespace polymer
             return nullptr;
         }
 
+        reflection_probe_component * get_reflection_probe_component(entity e)
+        {
+            auto iter = reflection_probes.find(e);
+            if (iter != reflection_probes.end()) return &iter->second;
+            return nullptr;
+        }
+
+        // Prefilter any probe that does not yet have a baked GGX chain. Results are cached in
+        // `cache_dir` (conventionally the directory the scene file lives in), keyed by the
+        // probe's source cubemap, so re-opening a scene loads bytes instead of re-convolving.
+        void bake_reflection_probes(const std::string & cache_dir)
+        {
+            if (reflection_probes.empty()) return;
+            if (!probeBaker) probeBaker.reset(new reflection_probe_baker());
+
+            for (auto & pair : reflection_probes)
+            {
+                reflection_probe_component & probe = pair.second;
+                if (probe.bakedCubemap || !probe.source.assigned()) continue;
+
+                const std::string cache_path = cache_dir + "/" + probe.source.name + "-ggx.cubebin";
+
+                gl_texture_2d baked;
+                if (!probeBaker->load_cached(cache_path, baked))
+                {
+                    baked = probeBaker->prefilter(probe.source.get());
+                    probeBaker->store_cached(cache_path, baked);
+                }
+
+                probe.bakedCubemap = baked;
+                bakedProbeChains[pair.first] = std::move(baked);
+            }
+        }
+
         virtual bool create(entity e, poly_typeid hash, void * data) override final 
         { 
-            if (hash == get_typeid<mesh_component>()) 
+            // get_typeid<T>() is constexpr, so these are integral case labels and the
+            // compiler lowers the dispatch to a jump table / compare tree on the hash
+            // rather than the sequential compare chain an if-else ladder produces.
+            switch (hash)
             {
-                meshes[e] = *static_cast<mesh_component *>(data);
-                return true;
-            }
-            else if (hash == get_typeid<material_component>()) 
-            { 
-                materials[e] = *static_cast<material_component *>(data); 
-                return true;
-            }
-            else if (hash == get_typeid<point_light_component>()) 
-            { 
-                point_lights[e] = *static_cast<point_light_component *>(data); 
-                return true;
-            }
-            else if (hash == get_typeid<directional_light_component>()) 
-            { 
-                directional_lights[e] = *static_cast<directional_light_component *>(data); 
-                return true; 
+                case get_typeid<mesh_component>():
+                {
+                    meshes[e] = *static_cast<mesh_component *>(data);
+                    return true;
+                }
+                case get_typeid<lod_component>():
+                {
+                    lods[e] = *static_cast<lod_component *>(data);
+                    return true;
+                }
+                case get_typeid<material_component>():
+                {
+                    materials[e] = *static_cast<material_component *>(data);
+                    return true;
+                }
+                case get_typeid<point_light_component>():
+                {
+                    point_lights[e] = *static_cast<point_light_component *>(data);
+                    return true;
+                }
+                case get_typeid<directional_light_component>():
+                {
+                    directional_lights[e] = *static_cast<directional_light_component *>(data);
+                    return true;
+                }
+                case get_typeid<reflection_probe_component>():
+                {
+                    reflection_probes[e] = *static_cast<reflection_probe_component *>(data);
+                    return true;
+                }
             }
             return false;
         }
 
         mesh_component * create(entity e, mesh_component && c) { meshes[e] = std::move(c); return &meshes[e]; }
+        lod_component * create(entity e, lod_component && c) { lods[e] = std::move(c); return &lods[e]; }
         material_component * create(entity e, material_component && c) { materials[e] = std::move(c); return &materials[e]; }
         point_light_component * create(entity e, point_light_component && c) { point_lights[e] = std::move(c); return &point_lights[e]; }
         directional_light_component * create(entity e, directional_light_component && c) { directional_lights[e] = std::move(c); return &directional_lights[e]; }
+        reflection_probe_component * create(entity e, reflection_probe_component && c) { reflection_probes[e] = std::move(c); return &reflection_probes[e]; }
 
         virtual void destroy(entity e) override final 
         {
             if (e == kAllEntities)
             {
                 meshes.clear();
+                lods.clear();
                 materials.clear();
                 point_lights.clear();
                 directional_lights.clear();
+                reflection_probes.clear();
+                bakedProbeChains.clear();
                 return;
             }
 
             auto meshIter = meshes.find(e);
             if (meshIter != meshes.end()) meshes.erase(meshIter);
 
+            auto lodIter = lods.find(e);
+            if (lodIter != lods.end()) lods.erase(lodIter);
+
             auto matIter = materials.find(e);
             if (matIter != materials.end()) materials.erase(matIter);
 
@@ -162,13 +502,26 @@ namespace polymer
 
             auto dirLightIter = directional_lights.find(e);
             if (dirLightIter != directional_lights.end()) directional_lights.erase(dirLightIter);
+
+            auto probeIter = reflection_probes.find(e);
+            if (probeIter != reflection_probes.end()) reflection_probes.erase(probeIter);
+
+            auto probeChainIter = bakedProbeChains.find(e);
+            if (probeChainIter != bakedProbeChains.end()) bakedProbeChains.erase(probeChainIter);
         }
     };
     POLYMER_SETUP_TYPEID(render_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(mesh_component, render_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(lod_component, render_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(material_component, render_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(point_light_component, render_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(directional_light_component, render_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(reflection_probe_component, render_system);
 
     template<class F> void visit_components(entity e, render_system * system, F f)
     {
         if (auto ptr = system->get_mesh_component(e)) f("mesh component", *ptr);
+        if (auto ptr = system->get_lod_component(e)) f("lod component", *ptr);
         if (auto ptr = system->get_material_component(e)) f("material component", *ptr);
         if (auto ptr = system->get_point_light_component(e))
         {
@@ -179,6 +532,13 @@ namespace polymer
             f("point light component", *ptr);
         }
         if (auto ptr = system->get_directional_light_component(e)) f("directional light component", *ptr);
+        if (auto ptr = system->get_reflection_probe_component(e))
+        {
+            // hack hack (same as the point light above)
+            transform_system * transform_sys = dynamic_cast<transform_system *>(system->orchestrator->get_system(get_typeid<transform_system>()));
+            if (auto probe_xform = transform_sys->get_world_transform(e)) ptr->position = probe_xform->world_pose.position;
+            f("reflection probe component", *ptr);
+        }
     }
 
 } // end namespace polymer
@@ -17,10 +17,12 @@ namespace polymer
 
     class transform_system final : public base_system
     {
-        void recalculate_world_transform(entity child)
+        // Recomputes the world transform of |child| alone, without touching its children.
+        void update_world_transform(entity child)
         {
             auto node = scene_graph_transforms.get(child);
             auto world_xform = world_transforms.get(child);
+            if (!node || !world_xform) return;
 
             // If the node has a parent then we can compute a new world transform.
             // Note that during deserialization we might not have created the parent yet
@@ -39,9 +41,65 @@ namespace polymer
                 // If the node has no parent, it should be considered already in world space.
                 world_xform->world_pose = node->local_pose;
             }
+        }
+
+        void recalculate_world_transform(entity child)
+        {
+            update_world_transform(child);
 
             // For each child, calculate its new world transform
-            for (auto c : node->children) recalculate_world_transform(c);
+            auto node = scene_graph_transforms.get(child);
+            if (node) for (auto c : node->children) recalculate_world_transform(c);
+        }
+
+        // Dirty tracking for the deferred update path. Stamps are compared against
+        // |flush_generation| so that entries left over from earlier frames go stale
+        // automatically instead of requiring a map-wide clear every flush.
+        uint64_t flush_generation{ 1 };
+        std::unordered_map<entity, uint64_t> dirty_stamps;
+        std::vector<entity> dirty_list; // entities marked since the last flush()
+
+        // One pending recompute, with component pointers resolved up front so the
+        // per-level loops below are pure contiguous-array traversals with no hash
+        // lookups. Pool pointers are stable for the duration of a flush because
+        // flush() is not re-entrant (no create/destroy during iteration).
+        struct flush_item
+        {
+            local_transform_component * node;
+            world_transform_component * world;
+            const local_transform_component * parent; // null for roots (or not-yet-created parents)
+        };
+        std::vector<flush_item> flush_items;
+
+        // Minimum entities in a hierarchy level before fanning the level out to the thread pool.
+        constexpr static const size_t parallel_flush_threshold = 1024;
+
+        bool is_marked_dirty(entity e) const
+        {
+            auto iter = dirty_stamps.find(e);
+            return iter != dirty_stamps.end() && iter->second == flush_generation;
+        }
+
+        void push_flush_item(entity e)
+        {
+            auto * node = scene_graph_transforms.get(e);
+            auto * world = world_transforms.get(e);
+            if (!node || !world) return;
+            auto * parent = (node->parent != kInvalidEntity) ? scene_graph_transforms.get(node->parent) : nullptr;
+            flush_items.push_back({ node, world, parent });
+        }
+
+        // Identical update rule to update_world_transform(), operating on pre-resolved pointers.
+        static void recompute_flush_item(const flush_item & item)
+        {
+            if (item.node->parent != kInvalidEntity)
+            {
+                if (item.parent) item.world->world_pose = item.parent->local_pose * item.node->local_pose;
+            }
+            else
+            {
+                item.world->world_pose = item.node->local_pose;
+            }
         }
 
         void destroy_recursive(entity child)
@@ -93,13 +151,23 @@ namespace polymer
 
         ~transform_system() override { }
 
-        bool create(entity e, poly_typeid hash, void * data) override final 
-        { 
+        bool create(entity e, poly_typeid hash, void * data) override final
+        {
             if (hash != get_typeid<local_transform_component>()) { return false; }
             auto new_component = static_cast<local_transform_component *>(data);
             return create(e, new_component->local_pose, new_component->local_scale, new_component->parent, new_component->children);
         }
 
+        bool create_bulk(const entity * entities, const size_t count, poly_typeid hash, void * data, const size_t stride) override final
+        {
+            if (hash != get_typeid<local_transform_component>()) { return false; }
+
+            // Reserve both pools up front so a large spawn burst doesn't rehash mid-insert.
+            scene_graph_transforms.reserve(count);
+            world_transforms.reserve(count);
+            return base_system::create_bulk(entities, count, hash, data, stride);
+        }
+
         bool create(entity e, 
             const transform local_pose, 
             const float3 local_scale = float3(1, 1, 1), 
@@ -122,6 +190,12 @@ namespace polymer
             return false;
         }
 
+        // Typed overload for the compile-time attach() path.
+        bool create(entity e, local_transform_component && c)
+        {
+            return create(e, c.local_pose, c.local_scale, c.parent, c.children);
+        }
+
         bool has_transform(entity e) const
         {
             return (scene_graph_transforms.get(e) != nullptr);
@@ -164,6 +238,7 @@ namespace polymer
             {
                 node->local_pose = new_transform;
                 recalculate_world_transform(e);
+                orchestrator->get_activity_tracker().touch(e); // transform writes keep the entity in the awake tier
                 return true;
             }
             return false;
@@ -215,14 +290,144 @@ namespace polymer
             destroy_recursive(e);
         }
 
+        // Bulk unload path. Expands the doomed set over each entity's subtree (matching
+        // destroy()'s recursive semantics), severs only the hierarchy edges that cross
+        // into survivors, then removes both pools in one compacting pass each - no
+        // per-entity recursion, hash erases, or swap-removals. Entities without a
+        // transform are skipped rather than treated as an error, since an unload batch
+        // spans every system.
+        void destroy_entities(const entity * entities, const size_t count) override final
+        {
+            std::vector<entity> stack(entities, entities + count);
+            std::unordered_set<entity> doomed;
+            doomed.reserve(count);
+
+            while (!stack.empty())
+            {
+                const entity e = stack.back();
+                stack.pop_back();
+                if (e == kInvalidEntity || !doomed.insert(e).second) continue;
+                if (auto * node = scene_graph_transforms.get(e))
+                {
+                    for (const entity child : node->children) stack.push_back(child);
+                }
+            }
+
+            std::vector<entity> batch;
+            batch.reserve(doomed.size());
+            for (const entity e : doomed)
+            {
+                auto * node = scene_graph_transforms.get(e);
+                if (!node) continue;
+                batch.push_back(e);
+
+                // A surviving parent must forget its doomed child; doomed parents are
+                // skipped since their children lists die with them
+                if (node->parent != kInvalidEntity && doomed.count(node->parent) == 0)
+                {
+                    if (auto * parent_node = scene_graph_transforms.get(node->parent))
+                    {
+                        parent_node->children.erase(std::remove(parent_node->children.begin(), parent_node->children.end(), e), parent_node->children.end());
+                    }
+                }
+            }
+
+            if (batch.empty()) return;
+            world_transforms.destroy_bulk(batch.data(), batch.size());
+            scene_graph_transforms.destroy_bulk(batch.data(), batch.size());
+        }
+
         void refresh()
         {
-           scene_graph_transforms.for_each([&](local_transform_component & t) 
-           { 
+           scene_graph_transforms.for_each([&](local_transform_component & t)
+           {
                const auto entity = t.get_entity();
                if (entity != kInvalidEntity) recalculate_world_transform(entity);
            });
         }
+
+        // Deferred update path. Most scenes are dominated by entities that never move
+        // after load, so instead of paying recalculate_world_transform() on every set,
+        // callers that mutate many transforms per frame can use the _deferred variant
+        // and invoke flush() once at frame end; only the dirty subtrees are recomputed
+        // and static hierarchies are never visited. The eager set_local_transform()
+        // remains valid for callers that need the world transform immediately.
+
+        // Queues |e|'s subtree for recomputation at the next flush().
+        void mark_dirty(entity e)
+        {
+            if (e == kInvalidEntity) return;
+            if (!has_transform(e)) return;
+            auto & stamp = dirty_stamps[e];
+            if (stamp == flush_generation) return; // already queued this frame
+            stamp = flush_generation;
+            dirty_list.push_back(e);
+            orchestrator->get_activity_tracker().touch(e); // deferred writes wake the entity too
+        }
+
+        // Same as set_local_transform() but defers world transform propagation to flush().
+        bool set_local_transform_deferred(entity e, const transform new_transform)
+        {
+            if (e == kInvalidEntity) return false;
+            if (auto * node = scene_graph_transforms.get(e))
+            {
+                node->local_pose = new_transform;
+                mark_dirty(e);
+                return true;
+            }
+            return false;
+        }
+
+        // Recomputes every dirty subtree, processing the hierarchy level-by-level so
+        // that parents are always finished before their children, and fanning large
+        // levels out across the thread pool. Call once per frame.
+        void flush()
+        {
+            if (dirty_list.empty()) { ++flush_generation; return; }
+
+            // Keep only dirty roots: an entity with a dirty ancestor is recomputed
+            // as part of that ancestor's subtree anyway.
+            flush_items.clear();
+            for (auto e : dirty_list)
+            {
+                bool covered = false;
+                for (entity p = get_parent(e); p != kInvalidEntity; p = get_parent(p))
+                {
+                    if (is_marked_dirty(p)) { covered = true; break; }
+                }
+                if (!covered) push_flush_item(e);
+            }
+
+            // The dirty roots form level 0; each iteration appends the next level
+            // (the children of the current one) and then recomputes the current
+            // level. Items within a level write disjoint world_transform_components
+            // and only read transforms from completed levels, so each level can run
+            // in parallel once it is large enough to cover the scheduling overhead.
+            size_t level_begin = 0;
+            size_t level_end = flush_items.size();
+            while (level_begin < level_end)
+            {
+                for (size_t i = level_begin; i < level_end; ++i)
+                {
+                    for (auto c : flush_items[i].node->children) push_flush_item(c);
+                }
+
+                if ((level_end - level_begin) >= parallel_flush_threshold)
+                {
+                    parallel_for(level_begin, level_end, 512, [this](const size_t i) { recompute_flush_item(flush_items[i]); });
+                }
+                else
+                {
+                    for (size_t i = level_begin; i < level_end; ++i) recompute_flush_item(flush_items[i]);
+                }
+
+                level_begin = level_end;
+                level_end = flush_items.size();
+            }
+
+            dirty_list.clear();
+            ++flush_generation; // stamps from this frame become stale without a map clear
+        }
     };
 
     template<class F> void visit_components(entity e, transform_system * system, F f)
@@ -237,6 +442,7 @@ namespace polymer
     }
 
     POLYMER_SETUP_TYPEID(transform_system);
+    POLYMER_REGISTER_COMPONENT_SYSTEM(local_transform_component, transform_system);
 
 } // end namespace polymer
 
@@ -7,6 +7,7 @@
 #include "ecs/typeid.hpp"
 
 #include "environment.hpp"
+#include "profiling.hpp"
 
 namespace polymer
 {
@@ -23,6 +24,103 @@ namespace polymer
         f(get_typename<local_transform_component>(), get_typeid<local_transform_component>());
     }
 
+    ////////////////////////////////
+    //   frame_budget_scheduler   //
+    ////////////////////////////////
+
+    // Runtime enforcement of per-frame budgets for the engine's incremental systems
+    // (asset uploads, streaming, octree rebalance, probe refresh). Each system registers
+    // its expected per-frame cost once; begin_frame() turns the registrations into this
+    // frame's slices, scaled down proportionally when the registered total oversubscribes
+    // the shared incremental budget. A running system brackets its work with begin()/end()
+    // and polls over_slice() from its incremental loop, stopping when the slice is spent.
+    // Unused time (or overshoot) carries into the next frame's slice, capped at one
+    // expected cost either way, so bursty systems average out to their registration
+    // instead of compounding debt or hoarding credit. Spans feed trace_capture like the
+    // per-frame profilers, so budgeted systems show up in captured traces for free.
+
+    class frame_budget_scheduler
+    {
+        struct budget_entry
+        {
+            double expectedMs{ 0.0 };
+            double sliceMs{ 0.0 };
+            double carryMs{ 0.0 };
+            uint64_t sliceBegin_us{ 0 };
+            circular_queue<double> actuals{ 30 };
+        };
+
+        std::unordered_map<std::string, budget_entry> entries;
+        double frameBudgetMs{ 4.0 }; // shared allotment for all incremental systems
+
+        uint64_t now_us() const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    public:
+
+        void set_frame_budget_ms(const double ms) { frameBudgetMs = ms; }
+        double get_frame_budget_ms() const { return frameBudgetMs; }
+
+        void register_system(const std::string & id, const double expected_ms)
+        {
+            entries[id].expectedMs = expected_ms;
+        }
+
+        // Call once per frame before any budgeted system runs
+        void begin_frame()
+        {
+            double total = 0.0;
+            for (const auto & e : entries) total += e.second.expectedMs;
+            const double scale = (total > frameBudgetMs && total > 0.0) ? frameBudgetMs / total : 1.0;
+            for (auto & e : entries)
+            {
+                e.second.sliceMs = std::max(0.0, e.second.expectedMs * scale + e.second.carryMs);
+            }
+        }
+
+        double slice_ms(const std::string & id) const
+        {
+            const auto it = entries.find(id);
+            return it != entries.end() ? it->second.sliceMs : 0.0;
+        }
+
+        void begin(const std::string & id)
+        {
+            trace_capture::get().record('B', id);
+            entries[id].sliceBegin_us = now_us();
+        }
+
+        // Poll from the system's incremental loop; true once the slice is spent
+        bool over_slice(const std::string & id)
+        {
+            const budget_entry & e = entries[id];
+            return (now_us() - e.sliceBegin_us) / 1000.0 >= e.sliceMs;
+        }
+
+        void end(const std::string & id)
+        {
+            trace_capture::get().record('E', id);
+            budget_entry & e = entries[id];
+            const double actual = (now_us() - e.sliceBegin_us) / 1000.0;
+            e.actuals.put(actual);
+            e.carryMs = clamp(e.sliceMs - actual, -e.expectedMs, e.expectedMs);
+        }
+
+        // Expected vs. rolling mean actual cost for every registration, for a hud
+        struct budget_sample { std::string id; float expected_ms; float mean_actual_ms; };
+        std::vector<budget_sample> get_data()
+        {
+            std::vector<budget_sample> data;
+            for (auto & e : entries)
+            {
+                data.push_back({ e.first, static_cast<float>(e.second.expectedMs), static_cast<float>(compute_mean(e.second.actuals)) });
+            }
+            return data;
+        }
+    };
+
 } // end namespace polymer
 
 #endif // end polymer_system_utils_hpp
@@ -0,0 +1,235 @@
+/*
+ * Hardware telemetry for 24/7 installations: samples GPU core/memory clocks,
+ * GPU temperature, and throttle reasons through NVML (loaded dynamically, so
+ * non-NVIDIA machines and machines without the driver library degrade to
+ * "no gpu telemetry" rather than failing to start), plus the current CPU
+ * frequency. A background thread polls about once per second - NVML queries
+ * can take milliseconds, so they never run on the frame path - and publishes
+ * the latest sample through relaxed atomics. The flight recorder folds the
+ * published sample into every frame record, which is what lets a dump
+ * distinguish "engine got slower" from "silicon got hotter": a frame-time
+ * ramp that tracks rising temperature and a thermal throttle bit is the
+ * cooling solution, not a regression.
+ */
+
+#pragma once
+
+#ifndef polymer_telemetry_hpp
+#define polymer_telemetry_hpp
+
+#include "util.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+#if defined(POLYMER_PLATFORM_WINDOWS)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fstream>
+    #include <dlfcn.h>
+#endif
+
+namespace polymer
+{
+    //////////////////////////////
+    //     hardware_telemetry   //
+    //////////////////////////////
+
+    // NVML throttle-reason bits we care about (nvmlClocksThrottleReasons.h)
+    static const uint64_t gpu_throttle_sw_power_cap = 0x0000000000000004ull;
+    static const uint64_t gpu_throttle_hw_slowdown = 0x0000000000000008ull;
+    static const uint64_t gpu_throttle_sw_thermal = 0x0000000000000020ull;
+    static const uint64_t gpu_throttle_hw_thermal = 0x0000000000000040ull;
+    static const uint64_t gpu_throttle_hw_power_brake = 0x0000000000000080ull;
+
+    class hardware_telemetry
+    {
+    public:
+
+        struct sample
+        {
+            uint32_t gpuCoreClockMhz{ 0 };
+            uint32_t gpuMemoryClockMhz{ 0 };
+            uint32_t gpuTemperatureC{ 0 };
+            uint64_t gpuThrottleReasons{ 0 };
+            uint32_t cpuFrequencyMhz{ 0 };
+            bool gpuValid{ false };
+            bool cpuValid{ false };
+        };
+
+    private:
+
+        // Minimal NVML surface, resolved at runtime so we carry no SDK dependency
+        typedef int (*nvml_init_fn)();
+        typedef int (*nvml_shutdown_fn)();
+        typedef int (*nvml_get_handle_fn)(unsigned int, void **);
+        typedef int (*nvml_get_temperature_fn)(void *, int, unsigned int *);
+        typedef int (*nvml_get_clock_fn)(void *, int, unsigned int *);
+        typedef int (*nvml_get_throttle_fn)(void *, unsigned long long *);
+
+        void * nvmlLibrary{ nullptr };
+        void * nvmlDevice{ nullptr };
+        nvml_shutdown_fn nvmlShutdown{ nullptr };
+        nvml_get_temperature_fn nvmlGetTemperature{ nullptr };
+        nvml_get_clock_fn nvmlGetClock{ nullptr };
+        nvml_get_throttle_fn nvmlGetThrottle{ nullptr };
+
+        std::atomic<uint32_t> gpuCoreClockMhz{ 0 };
+        std::atomic<uint32_t> gpuMemoryClockMhz{ 0 };
+        std::atomic<uint32_t> gpuTemperatureC{ 0 };
+        std::atomic<uint64_t> gpuThrottleReasons{ 0 };
+        std::atomic<uint32_t> cpuFrequencyMhz{ 0 };
+        std::atomic<bool> gpuValid{ false };
+        std::atomic<bool> cpuValid{ false };
+
+        std::atomic<bool> running{ false };
+        std::thread worker;
+
+        void * load_symbol(const char * name)
+        {
+        #if defined(POLYMER_PLATFORM_WINDOWS)
+            return reinterpret_cast<void *>(GetProcAddress(reinterpret_cast<HMODULE>(nvmlLibrary), name));
+        #else
+            return dlsym(nvmlLibrary, name);
+        #endif
+        }
+
+        void bind_nvml()
+        {
+        #if defined(POLYMER_PLATFORM_WINDOWS)
+            nvmlLibrary = reinterpret_cast<void *>(LoadLibraryA("nvml.dll"));
+        #else
+            nvmlLibrary = dlopen("libnvidia-ml.so.1", RTLD_LAZY);
+        #endif
+            if (!nvmlLibrary) return;
+
+            const nvml_init_fn init = reinterpret_cast<nvml_init_fn>(load_symbol("nvmlInit_v2"));
+            const nvml_get_handle_fn getHandle = reinterpret_cast<nvml_get_handle_fn>(load_symbol("nvmlDeviceGetHandleByIndex_v2"));
+            nvmlShutdown = reinterpret_cast<nvml_shutdown_fn>(load_symbol("nvmlShutdown"));
+            nvmlGetTemperature = reinterpret_cast<nvml_get_temperature_fn>(load_symbol("nvmlDeviceGetTemperature"));
+            nvmlGetClock = reinterpret_cast<nvml_get_clock_fn>(load_symbol("nvmlDeviceGetClockInfo"));
+            nvmlGetThrottle = reinterpret_cast<nvml_get_throttle_fn>(load_symbol("nvmlDeviceGetCurrentClocksThrottleReasons"));
+
+            if (!init || !getHandle || !nvmlGetTemperature || !nvmlGetClock) return;
+            if (init() != 0) return;
+            if (getHandle(0, &nvmlDevice) != 0) nvmlDevice = nullptr; // device 0: we deploy single-gpu
+        }
+
+        void sample_gpu()
+        {
+            if (!nvmlDevice) return;
+
+            unsigned int value = 0;
+            bool valid = false;
+
+            if (nvmlGetClock(nvmlDevice, 0 /* graphics */, &value) == 0) { gpuCoreClockMhz.store(value, std::memory_order_relaxed); valid = true; }
+            if (nvmlGetClock(nvmlDevice, 2 /* memory */, &value) == 0) { gpuMemoryClockMhz.store(value, std::memory_order_relaxed); valid = true; }
+            if (nvmlGetTemperature(nvmlDevice, 0 /* gpu core */, &value) == 0) { gpuTemperatureC.store(value, std::memory_order_relaxed); valid = true; }
+
+            unsigned long long reasons = 0;
+            if (nvmlGetThrottle && nvmlGetThrottle(nvmlDevice, &reasons) == 0) gpuThrottleReasons.store(reasons, std::memory_order_relaxed);
+
+            gpuValid.store(valid, std::memory_order_relaxed);
+        }
+
+        void sample_cpu()
+        {
+        #if defined(POLYMER_PLATFORM_WINDOWS)
+            // PROCESSOR_POWER_INFORMATION via CallNtPowerInformation(ProcessorInformation)
+            struct processor_power_information { ULONG Number, MaxMhz, CurrentMhz, MhzLimit, MaxIdleState, CurrentIdleState; };
+            typedef LONG(WINAPI * call_nt_power_information_fn)(int, PVOID, ULONG, PVOID, ULONG);
+
+            static call_nt_power_information_fn callNtPowerInformation = []() -> call_nt_power_information_fn
+            {
+                const HMODULE lib = LoadLibraryA("powrprof.dll");
+                return lib ? reinterpret_cast<call_nt_power_information_fn>(GetProcAddress(lib, "CallNtPowerInformation")) : nullptr;
+            }();
+            if (!callNtPowerInformation) return;
+
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            std::vector<processor_power_information> processors(info.dwNumberOfProcessors);
+            if (callNtPowerInformation(11 /* ProcessorInformation */, nullptr, 0, processors.data(), ULONG(processors.size() * sizeof(processor_power_information))) == 0)
+            {
+                cpuFrequencyMhz.store(processors[0].CurrentMhz, std::memory_order_relaxed);
+                cpuValid.store(true, std::memory_order_relaxed);
+            }
+        #else
+            std::ifstream freq("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq");
+            uint64_t khz = 0;
+            if (freq >> khz)
+            {
+                cpuFrequencyMhz.store(static_cast<uint32_t>(khz / 1000), std::memory_order_relaxed);
+                cpuValid.store(true, std::memory_order_relaxed);
+            }
+        #endif
+        }
+
+        hardware_telemetry() = default;
+
+    public:
+
+        static hardware_telemetry & get()
+        {
+            static hardware_telemetry instance;
+            return instance;
+        }
+
+        ~hardware_telemetry() { stop(); }
+
+        // Idempotent; the flight recorder calls this lazily so telemetry rides along
+        // with the always-on hitch recorder without explicit app wiring.
+        void start(const uint32_t interval_ms = 1000)
+        {
+            bool expected = false;
+            if (!running.compare_exchange_strong(expected, true)) return;
+
+            worker = std::thread([this, interval_ms]()
+            {
+                bind_nvml();
+                while (running.load(std::memory_order_relaxed))
+                {
+                    sample_gpu();
+                    sample_cpu();
+                    for (uint32_t waited = 0; waited < interval_ms && running.load(std::memory_order_relaxed); waited += 50)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    }
+                }
+                if (nvmlShutdown && nvmlDevice) nvmlShutdown();
+            });
+        }
+
+        void stop()
+        {
+            if (!running.exchange(false)) return;
+            if (worker.joinable()) worker.join();
+        }
+
+        // Most recent published sample; fields are ~1 second stale by design
+        sample latest() const
+        {
+            sample s;
+            s.gpuCoreClockMhz = gpuCoreClockMhz.load(std::memory_order_relaxed);
+            s.gpuMemoryClockMhz = gpuMemoryClockMhz.load(std::memory_order_relaxed);
+            s.gpuTemperatureC = gpuTemperatureC.load(std::memory_order_relaxed);
+            s.gpuThrottleReasons = gpuThrottleReasons.load(std::memory_order_relaxed);
+            s.cpuFrequencyMhz = cpuFrequencyMhz.load(std::memory_order_relaxed);
+            s.gpuValid = gpuValid.load(std::memory_order_relaxed);
+            s.cpuValid = cpuValid.load(std::memory_order_relaxed);
+            return s;
+        }
+
+        static bool is_throttled(const uint64_t reasons)
+        {
+            return (reasons & (gpu_throttle_sw_power_cap | gpu_throttle_hw_slowdown | gpu_throttle_sw_thermal | gpu_throttle_hw_thermal | gpu_throttle_hw_power_brake)) != 0;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_telemetry_hpp
@@ -0,0 +1,261 @@
+#pragma once
+
+#ifndef polymer_texture_streaming_hpp
+#define polymer_texture_streaming_hpp
+
+#include "asset-handle-utils.hpp"
+#include "system-transform.hpp"
+#include "gfx/gl/gl-texture-transcode.hpp"
+#include "queue-mpsc-bounded.hpp"
+#include "thread-pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace polymer
+{
+    //////////////////////////
+    //   texture_streamer   //
+    //////////////////////////
+
+    // Budget-driven mip streaming over block-compressed (DDS/KTX) sources.
+    // Registered textures become resident at a coarse mip tail immediately and
+    // are promoted or demoted each frame based on the camera's distance to the
+    // entity they are attached to, keeping total resident bytes under a fixed
+    // budget. Workers read and slice the container off-thread; the GL thread
+    // re-specifies the texture in update() and re-assigns the shared
+    // asset_handle entry, so materials referencing the handle pick up the new
+    // residency without changes. Scenes can reference far more texture data
+    // than fits in VRAM as long as any single viewpoint's working set does.
+    class texture_streamer
+    {
+        // Extent at or below which mips are always resident - the "low-mip"
+        // baseline a texture falls back to when out of budget or far away.
+        constexpr static const int coarse_extent = 64;
+
+        struct streamed_texture
+        {
+            std::string handle_id;
+            std::string path;
+            entity attachment{ kInvalidEntity };
+            float distance{ 0.f };
+            std::vector<size_t> level_bytes;      // per-level compressed size, filled by the first load
+            std::vector<int> level_extent;        // per-level max(width, height)
+            uint32_t total_levels{ 0 };
+            uint32_t resident_base_level{ 0xffffffff };
+            uint32_t requested_base_level{ 0xffffffff };
+            bool load_in_flight{ false };
+        };
+
+        struct upload_payload
+        {
+            streamed_texture * source{ nullptr };
+            gli::texture2d tex;
+            uint32_t base_level{ 0 };
+            bool failed{ false };
+        };
+
+        transform_system * xform_system{ nullptr };
+        std::map<std::string, std::unique_ptr<streamed_texture>> textures;
+        mpsc_queue_bounded<std::shared_ptr<upload_payload>, 256> upload_queue;
+
+        size_t residency_budget_bytes{ 512 * 1024 * 1024 };
+        float full_detail_distance{ 4.f };
+
+        texture_streamer(const texture_streamer &) = delete;
+        texture_streamer & operator = (const texture_streamer &) = delete;
+
+        // Reads the container on a worker and queues levels [base_level, end)
+        // for upload. The first load also discovers the mip layout.
+        void submit_load(streamed_texture & t, const uint32_t base_level)
+        {
+            t.load_in_flight = true;
+            t.requested_base_level = base_level;
+
+            streamed_texture * source = &t;
+            const std::string path = t.path;
+            get_task_scheduler().submit([this, source, path, base_level]()
+            {
+                auto result = std::make_shared<upload_payload>();
+                result->source = source;
+                result->base_level = base_level;
+
+                try
+                {
+                    mapped_file binaryFile(path);
+                    gli::texture container = gli::load(reinterpret_cast<const char *>(binaryFile.data()), binaryFile.size());
+                    if (container.empty()) throw std::runtime_error("unrecognized texture container");
+                    result->tex = gli::texture2d(container);
+                }
+                catch (const std::exception & e)
+                {
+                    log::get()->engine_log->error("[texture_streamer] failed to load {}: {}", path, e.what());
+                    result->failed = true;
+                }
+
+                while (!upload_queue.emplace_back(result)) std::this_thread::yield();
+            });
+        }
+
+        // Distance-driven mip selection: one level per doubling of distance
+        // beyond full_detail_distance, clamped to the always-resident tail.
+        uint32_t desired_base_level(const streamed_texture & t) const
+        {
+            if (t.total_levels == 0) return 0;
+            const float ratio = std::max(t.distance / full_detail_distance, 1.f);
+            const uint32_t byDistance = uint32_t(std::log2(ratio));
+            return std::min(byDistance, coarse_base_level(t));
+        }
+
+        // First level whose extent fits within coarse_extent
+        uint32_t coarse_base_level(const streamed_texture & t) const
+        {
+            for (uint32_t l = 0; l < t.total_levels; ++l)
+            {
+                if (t.level_extent[l] <= coarse_extent) return l;
+            }
+            return t.total_levels > 0 ? t.total_levels - 1 : 0;
+        }
+
+        size_t resident_bytes(const streamed_texture & t) const
+        {
+            if (t.resident_base_level == 0xffffffff) return 0;
+            size_t bytes = 0;
+            for (uint32_t l = t.resident_base_level; l < t.total_levels; ++l) bytes += t.level_bytes[l];
+            return bytes;
+        }
+
+        size_t bytes_for_base(const streamed_texture & t, const uint32_t base) const
+        {
+            size_t bytes = 0;
+            for (uint32_t l = base; l < t.total_levels; ++l) bytes += t.level_bytes[l];
+            return bytes;
+        }
+
+    public:
+
+        texture_streamer(transform_system * xform) : xform_system(xform) {}
+
+        void set_residency_budget_bytes(const size_t bytes) { residency_budget_bytes = bytes; }
+        void set_full_detail_distance(const float meters) { full_detail_distance = meters; }
+
+        // Registers a DDS/KTX-backed texture under `handle_id`, attached to the
+        // entity whose world transform drives its streaming priority. The
+        // coarse mip tail loads immediately; callers may reference the handle
+        // right away (lazy asset_handle semantics apply until the first upload).
+        void register_texture(const std::string & handle_id, const std::string & path, const entity attach_to)
+        {
+            auto & t = textures[handle_id];
+            if (t) return; // already registered
+
+            t.reset(new streamed_texture());
+            t->handle_id = handle_id;
+            t->path = path;
+            t->attachment = attach_to;
+
+            // Level layout is unknown until the first parse; request everything
+            // coarse by asking for the highest level the worker discovers.
+            submit_load(*t, 0xffffffff);
+        }
+
+        size_t tracked_count() const { return textures.size(); }
+
+        // Called once per frame from the GL thread. Refreshes distances from
+        // the transform system, queues promotions/demotions that fit the
+        // residency budget, and performs any finished uploads. Returns the
+        // number of textures re-specified this frame.
+        uint32_t update(const float3 & camera_position)
+        {
+            // 1. Refresh distances
+            for (auto & pair : textures)
+            {
+                streamed_texture & t = *pair.second;
+                t.distance = 0.f;
+                if (t.attachment != kInvalidEntity && xform_system)
+                {
+                    if (auto * world = xform_system->get_world_transform(t.attachment))
+                    {
+                        t.distance = length(world->world_pose.position - camera_position);
+                    }
+                }
+            }
+
+            // 2. Queue residency changes, nearest textures first, within budget
+            std::vector<streamed_texture *> byPriority;
+            byPriority.reserve(textures.size());
+            for (auto & pair : textures) if (pair.second->total_levels > 0) byPriority.push_back(pair.second.get());
+            std::sort(byPriority.begin(), byPriority.end(), [](const streamed_texture * a, const streamed_texture * b) { return a->distance < b->distance; });
+
+            size_t plannedBytes = 0;
+            for (streamed_texture * t : byPriority)
+            {
+                uint32_t target = desired_base_level(*t);
+                if (plannedBytes + bytes_for_base(*t, target) > residency_budget_bytes) target = coarse_base_level(*t);
+                plannedBytes += bytes_for_base(*t, target);
+
+                if (!t->load_in_flight && target != t->resident_base_level) submit_load(*t, target);
+            }
+
+            // 3. Apply finished loads
+            uint32_t uploaded = 0;
+            for (;;)
+            {
+                auto finished = upload_queue.pop_front();
+                if (!finished.first) break;
+
+                upload_payload & payload = *finished.second;
+                streamed_texture & t = *payload.source;
+                t.load_in_flight = false;
+
+                if (payload.failed) continue;
+
+                if (t.total_levels == 0)
+                {
+                    t.total_levels = uint32_t(payload.tex.levels());
+                    t.level_bytes.resize(t.total_levels);
+                    t.level_extent.resize(t.total_levels);
+                    for (uint32_t l = 0; l < t.total_levels; ++l)
+                    {
+                        t.level_bytes[l] = payload.tex.size(l);
+                        const auto extent = payload.tex.extent(l);
+                        t.level_extent[l] = std::max(extent.x, extent.y);
+                    }
+                }
+
+                // The registration load requests the coarse tail; the layout
+                // wasn't known until this payload arrived.
+                const uint32_t base = (payload.base_level == 0xffffffff) ? coarse_base_level(t) : std::min(payload.base_level, t.total_levels - 1);
+
+                gli::gl GL(gli::gl::PROFILE_GL33);
+                const gli::gl::format fmt = GL.translate(payload.tex.format(), payload.tex.swizzles());
+                const bool compressed = gli::is_compressed(payload.tex.format());
+
+                gl_texture_2d tex;
+                for (uint32_t level = base; level < t.total_levels; ++level)
+                {
+                    const auto extent = payload.tex.extent(level);
+                    const GLint dst = GLint(level - base);
+                    if (compressed) glCompressedTextureImage2DEXT(tex, GL_TEXTURE_2D, dst, fmt.Internal, extent.x, extent.y, 0, GLsizei(payload.tex.size(level)), payload.tex.data(0, 0, level));
+                    else glTextureImage2DEXT(tex, GL_TEXTURE_2D, dst, fmt.Internal, extent.x, extent.y, 0, fmt.External, fmt.Type, payload.tex.data(0, 0, level));
+                }
+
+                glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+                glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, GLint(t.total_levels - base - 1));
+                glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glTextureParameteriEXT(tex, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+                create_handle_for_asset(t.handle_id.c_str(), std::move(tex));
+                t.resident_base_level = base;
+                ++uploaded;
+            }
+
+            return uploaded;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_texture_streaming_hpp
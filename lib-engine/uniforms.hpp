@@ -12,6 +12,7 @@ namespace uniforms
 {
     static const int MAX_POINT_LIGHTS = 4;
     static const int NUM_CASCADES = 2;
+    static const int MAX_BONES = 256;
 
     struct point_light
     {
@@ -58,6 +59,12 @@ namespace uniforms
         ALIGNED(16) float4x4  view;
         ALIGNED(16) float4x4  viewProj;
         ALIGNED(16) float4    eyePos;
+        ALIGNED(16) float4    nearFarClip; // x = near, y = far (used by the clustered shading froxel lookup)
+
+        // Single-pass stereo: both eyes' matrices, selected in the vertex stage by instance parity
+        ALIGNED(16) float4x4  viewStereo[2];
+        ALIGNED(16) float4x4  viewProjStereo[2];
+        ALIGNED(16) float4    eyePosStereo[2];
     };
 
     struct per_object
@@ -66,7 +73,38 @@ namespace uniforms
         ALIGNED(16) float4x4  modelMatrix;
         ALIGNED(16) float4x4  modelMatrixIT;
         ALIGNED(16) float4x4  modelViewMatrix;
+        ALIGNED(16) float4x4  modelMatrixPrevious; // last frame's model matrix, for per-object motion vectors
         ALIGNED(16) float     receiveShadow;
+
+        // Per-instance material property block: small overrides applied on top of the
+        // shared material so per-entity variation (tint, emissive level) doesn't force
+        // duplicating the whole material. Rides the same per-object ring write.
+        ALIGNED(16) float4    propertyTint{ 1.f, 1.f, 1.f, 1.f }; // multiplies albedo (a multiplies opacity)
+        float                 propertyEmissiveScale{ 1.f };       // multiplies emissive strength
+    };
+
+    // Bone palette for gpu skinning; bound as a range into the skinning ring, sized
+    // to the entity's actual bone count (MAX_BONES is the shader-side upper bound).
+    // Bindings 3-5 belong to the clustered-shading storage buffers.
+    struct per_skin
+    {
+        static const int      binding = 7;
+        ALIGNED(16) float4x4  bonePalette[MAX_BONES];
+    };
+
+    // Resident bindless texture handles for one material (GL_ARB_bindless_texture),
+    // uploaded in place of per-draw sampler binds when the renderer runs in bindless
+    // mode. Slot order matches the uvec2 block in the material shaders; unassigned
+    // slots stay zero and are never sampled (the HAS_*_MAP defines gate usage).
+    struct per_bindless_material
+    {
+        static const int      binding = 8;
+        ALIGNED(8) uint64_t   albedo;
+        ALIGNED(8) uint64_t   normal;
+        ALIGNED(8) uint64_t   roughness;
+        ALIGNED(8) uint64_t   metallic;
+        ALIGNED(8) uint64_t   emissive;
+        ALIGNED(8) uint64_t   occlusion;
     };
 
 }
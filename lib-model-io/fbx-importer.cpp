@@ -7,7 +7,10 @@ using namespace polymer;
 #include <fbxsdk.h>
 #include <assert.h>
 #include <map>
+#include <atomic>
 #include "util.hpp"
+#include "geometry.hpp"
+#include "thread-pool.hpp"
 
 float2 to_linalg(const fbxsdk::FbxDouble2 & v) { return float2(double2(v[0], v[1])); }
 float4 to_linalg(const fbxsdk::FbxDouble4 & v) { return float4(double4(v[0], v[1], v[2], v[3])); }
@@ -25,7 +28,107 @@ inline TValue get_vertex_element(TGeometryElement * pElement, int iPoint, int iT
     return pElement->GetDirectArray().GetAt(index);
 }
 
-void polymer::gather_meshes(fbx_container & file, fbxsdk::FbxNode * node)
+// Converts one triangulated FbxMesh into a runtime_skinned_mesh. Only reads
+// this node's attribute data, so distinct nodes convert safely in parallel.
+static void convert_mesh_node(fbxsdk::FbxNode * node, runtime_skinned_mesh & mesh)
+{
+    auto * attrib = node->GetNodeAttribute();
+
+    auto * fbxMesh = fbxsdk::FbxCast<fbxsdk::FbxMesh>(attrib);
+
+    auto points = fbxMesh->GetControlPoints();
+    if (!points) throw std::runtime_error("no control points");
+
+    auto pUV1 = fbxMesh->GetElementUV(0);
+    if (pUV1 && pUV1->GetMappingMode() != fbxsdk::FbxGeometryElement::eByPolygonVertex) throw std::runtime_error("UV1 set must be mapped by eByPolygonVertex");
+
+    auto pUV2 = fbxMesh->GetElementUV(1);
+    if (pUV2 && pUV2->GetMappingMode() != fbxsdk::FbxGeometryElement::eByPolygonVertex) throw std::runtime_error("UV2 set must be mapped by eByPolygonVertex");
+
+    const fbxsdk::FbxGeometryElementVertexColor * pVertexColors = fbxMesh->GetElementVertexColor(0);
+    const fbxsdk::FbxGeometryElementNormal * pNormals = fbxMesh->GetElementNormal(0);
+
+    int materialCount = node->GetMaterialCount();
+
+    const fbxsdk::FbxLayerElementMaterial * pPolygonMaterials = fbxMesh->GetElementMaterial();
+    assert(pPolygonMaterials != nullptr);
+    assert(pPolygonMaterials->GetReferenceMode() == fbxsdk::FbxGeometryElement::eIndex || pPolygonMaterials->GetReferenceMode() == fbxsdk::FbxGeometryElement::eIndexToDirect);
+
+    fbxsdk::FbxGeometryElement::EMappingMode mappingMode = pPolygonMaterials->GetMappingMode();
+
+    auto getMaterialIndex = [pPolygonMaterials, mappingMode, materialCount](uint32_t triangleIndex) 
+    {
+        int lookupIndex = 0;
+        switch (mappingMode) 
+        {
+            case fbxsdk::FbxGeometryElement::eByPolygon: lookupIndex = triangleIndex; break;
+            case fbxsdk::FbxGeometryElement::eAllSame: lookupIndex = 0; break;
+            default: assert(false); break;
+        }
+
+        int materialIndex = pPolygonMaterials->mIndexArray->GetAt(lookupIndex);
+        assert(materialIndex >= 0 && materialIndex < materialCount);
+        return uint32_t(materialIndex);
+    };
+
+    // de-duplicate vertices
+    unordered_map_generator<unique_vertex, uint32_t>::Type uniqueVertexMap;
+
+    uint32_t numTriangles = uint32_t(fbxMesh->GetPolygonCount());
+    mesh.vertices.reserve(numTriangles * 3);
+    mesh.faces.reserve(numTriangles);
+
+    for (uint32_t t = 0; t < numTriangles; t++) 
+    {
+        uint3 indices;
+        for (uint32_t v = 0; v < 3; v++) 
+        {
+            int controlPointIndex = fbxMesh->GetPolygonVertex(t, v);
+
+            fbxsdk::FbxVector4 point = fbxMesh->GetControlPointAt(controlPointIndex);
+            fbxsdk::FbxVector4 normal = get_vertex_element(pNormals, controlPointIndex, t, v, fbxsdk::FbxVector4(0, 0, 0, 0));
+            fbxsdk::FbxVector2 texcoord1 = get_vertex_element(pUV1, controlPointIndex, t, v, fbxsdk::FbxVector2(0, 1));
+            fbxsdk::FbxVector2 texcoord2 = get_vertex_element(pUV2, controlPointIndex, t, v, fbxsdk::FbxVector2(0, 1));
+            fbxsdk::FbxColor vertexColor = get_vertex_element(pVertexColors, controlPointIndex, t, v, fbxsdk::FbxColor(0, 0, 0, 0));
+
+            unique_vertex vertex;
+            vertex.position = to_linalg(point).xyz;
+            vertex.normal = to_linalg(normal).xyz;
+            vertex.texcoord = to_linalg(texcoord1);
+
+            auto it = uniqueVertexMap.find(vertex);
+            if (it != uniqueVertexMap.end())
+            {
+                indices[v] = it->second; // found duplicated vertex
+            }
+            else
+            {
+                // we haven't run into this vertex yet
+                uint32_t index = uint32_t(mesh.vertices.size());
+
+                uniqueVertexMap[vertex] = index;
+                indices[v] = index;
+
+                mesh.vertices.push_back(vertex.position);
+                mesh.normals.push_back(vertex.normal);
+                mesh.texcoord0.push_back(vertex.texcoord);
+                mesh.texcoord1.push_back(to_linalg(texcoord2));
+                mesh.colors.push_back({ (float) vertexColor.mRed, (float) vertexColor.mGreen, (float) vertexColor.mBlue, (float) vertexColor.mAlpha });
+            }
+
+        }
+
+        mesh.material.push_back(getMaterialIndex(t));
+        mesh.faces.push_back(indices);
+    }
+
+    // Newly deduplicated index/vertex data also gets tangent frames here,
+    // inside the worker, so the cost parallelizes with the rest of the mesh.
+    compute_tangents(mesh);
+}
+
+// Serial scene-graph walk collecting every node with a mesh-like attribute.
+static void gather_mesh_nodes(fbxsdk::FbxNode * node, std::vector<fbxsdk::FbxNode *> & out)
 {
     auto * attrib = node->GetNodeAttribute();
 
@@ -38,114 +141,57 @@ void polymer::gather_meshes(fbx_container & file, fbxsdk::FbxNode * node)
             fbxsdk::FbxNodeAttribute::eTrimNurbsSurface,
             fbxsdk::FbxNodeAttribute::ePatch };
 
-        bool hasAcceptableAttribute = false;
         for (auto & att : acceptedAttributes)
         {
             if (attrib->GetAttributeType() == att)
             {
-                hasAcceptableAttribute = true;
+                out.push_back(node);
                 break;
             }
         }
+    }
 
-        if (hasAcceptableAttribute)
-        {
-            auto & mesh = file.meshes[node->GetName()];
-            auto * fbxMesh = fbxsdk::FbxCast<fbxsdk::FbxMesh>(attrib);
-
-            auto points = fbxMesh->GetControlPoints();
-            if (!points) throw std::runtime_error("no control points");
-
-            auto pUV1 = fbxMesh->GetElementUV(0);
-            if (pUV1 && pUV1->GetMappingMode() != fbxsdk::FbxGeometryElement::eByPolygonVertex) throw std::runtime_error("UV1 set must be mapped by eByPolygonVertex");
-
-            auto pUV2 = fbxMesh->GetElementUV(1);
-            if (pUV2 && pUV2->GetMappingMode() != fbxsdk::FbxGeometryElement::eByPolygonVertex) throw std::runtime_error("UV2 set must be mapped by eByPolygonVertex");
-
-            const fbxsdk::FbxGeometryElementVertexColor * pVertexColors = fbxMesh->GetElementVertexColor(0);
-            const fbxsdk::FbxGeometryElementNormal * pNormals = fbxMesh->GetElementNormal(0);
-
-            int materialCount = node->GetMaterialCount();
-
-            const fbxsdk::FbxLayerElementMaterial * pPolygonMaterials = fbxMesh->GetElementMaterial();
-            assert(pPolygonMaterials != nullptr);
-            assert(pPolygonMaterials->GetReferenceMode() == fbxsdk::FbxGeometryElement::eIndex || pPolygonMaterials->GetReferenceMode() == fbxsdk::FbxGeometryElement::eIndexToDirect);
-
-            fbxsdk::FbxGeometryElement::EMappingMode mappingMode = pPolygonMaterials->GetMappingMode();
+    for (int i = 0; i < node->GetChildCount(); i++)
+    {
+        gather_mesh_nodes(node->GetChild(i), out);
+    }
+}
 
-            auto getMaterialIndex = [pPolygonMaterials, mappingMode, materialCount](uint32_t triangleIndex) 
-            {
-                int lookupIndex = 0;
-                switch (mappingMode) 
-                {
-                    case fbxsdk::FbxGeometryElement::eByPolygon: lookupIndex = triangleIndex; break;
-                    case fbxsdk::FbxGeometryElement::eAllSame: lookupIndex = 0; break;
-                    default: assert(false); break;
-                }
-
-                int materialIndex = pPolygonMaterials->mIndexArray->GetAt(lookupIndex);
-                assert(materialIndex >= 0 && materialIndex < materialCount);
-                return uint32_t(materialIndex);
-            };
-
-            // de-duplicate vertices
-            unordered_map_generator<unique_vertex, uint32_t>::Type uniqueVertexMap;
-
-            uint32_t numTriangles = uint32_t(fbxMesh->GetPolygonCount());
-            mesh.vertices.reserve(numTriangles * 3);
-            mesh.faces.reserve(numTriangles);
-
-            for (uint32_t t = 0; t < numTriangles; t++) 
+void polymer::gather_meshes(fbx_container & file, fbxsdk::FbxNode * node)
+{
+    std::vector<fbxsdk::FbxNode *> meshNodes;
+    gather_mesh_nodes(node, meshNodes);
+
+    // Map entries are created up front on this thread; workers then fill
+    // disjoint meshes. The parse/triangulation already happened, and each task
+    // only reads its own node's attribute arrays, so per-mesh conversion
+    // (attribute extraction, vertex dedup, tangent generation) is the
+    // embarrassingly parallel part of the import.
+    std::vector<runtime_skinned_mesh *> destinations;
+    destinations.reserve(meshNodes.size());
+    for (auto * meshNode : meshNodes) destinations.push_back(&file.meshes[meshNode->GetName()]);
+
+    task_scheduler & scheduler = get_task_scheduler();
+    task_group conversion_tasks;
+    std::atomic<bool> conversion_failed{ false };
+
+    for (size_t i = 0; i < meshNodes.size(); ++i)
+    {
+        fbxsdk::FbxNode * meshNode = meshNodes[i];
+        runtime_skinned_mesh * destination = destinations[i];
+        conversion_tasks.run(scheduler, [meshNode, destination, &conversion_failed]()
+        {
+            try { convert_mesh_node(meshNode, *destination); }
+            catch (const std::exception & e)
             {
-                uint3 indices;
-                for (uint32_t v = 0; v < 3; v++) 
-                {
-                    int controlPointIndex = fbxMesh->GetPolygonVertex(t, v);
-
-                    fbxsdk::FbxVector4 point = fbxMesh->GetControlPointAt(controlPointIndex);
-                    fbxsdk::FbxVector4 normal = get_vertex_element(pNormals, controlPointIndex, t, v, fbxsdk::FbxVector4(0, 0, 0, 0));
-                    fbxsdk::FbxVector2 texcoord1 = get_vertex_element(pUV1, controlPointIndex, t, v, fbxsdk::FbxVector2(0, 1));
-                    fbxsdk::FbxVector2 texcoord2 = get_vertex_element(pUV2, controlPointIndex, t, v, fbxsdk::FbxVector2(0, 1));
-                    fbxsdk::FbxColor vertexColor = get_vertex_element(pVertexColors, controlPointIndex, t, v, fbxsdk::FbxColor(0, 0, 0, 0));
-
-                    unique_vertex vertex;
-                    vertex.position = to_linalg(point).xyz;
-                    vertex.normal = to_linalg(normal).xyz;
-                    vertex.texcoord = to_linalg(texcoord1);
-
-                    auto it = uniqueVertexMap.find(vertex);
-                    if (it != uniqueVertexMap.end())
-                    {
-                        indices[v] = it->second; // found duplicated vertex
-                    }
-                    else
-                    {
-                        // we haven't run into this vertex yet
-                        uint32_t index = uint32_t(mesh.vertices.size());
-
-                        uniqueVertexMap[vertex] = index;
-                        indices[v] = index;
-
-                        mesh.vertices.push_back(vertex.position);
-                        mesh.normals.push_back(vertex.normal);
-                        mesh.texcoord0.push_back(vertex.texcoord);
-                        mesh.texcoord1.push_back(to_linalg(texcoord2));
-                        mesh.colors.push_back({ (float) vertexColor.mRed, (float) vertexColor.mGreen, (float) vertexColor.mBlue, (float) vertexColor.mAlpha });
-                    }
-
-                }
-
-                mesh.material.push_back(getMaterialIndex(t));
-                mesh.faces.push_back(indices);
+                std::cerr << "convert_mesh_node failed for " << meshNode->GetName() << ": " << e.what() << std::endl;
+                conversion_failed = true;
             }
-        }
+        });
     }
 
-    // Recurse
-    for (int i = 0; i < node->GetChildCount(); i++)
-    {
-        gather_meshes(file, node->GetChild(i));
-    }
+    conversion_tasks.wait();
+    if (conversion_failed) throw std::runtime_error("one or more meshes failed to convert");
 }
 
 ////////////////////////
@@ -8,8 +8,14 @@
 
 #include <assert.h>
 #include "string_utils.hpp"
+#include "file_io.hpp"
+#include "thread-pool.hpp"
 #include <fstream>
 #include <ostream>
+#include <cstring>
+#include <cmath>
+#include <atomic>
+#include <map>
 
 using namespace polymer;
 
@@ -23,12 +29,12 @@ std::unordered_map<std::string, runtime_mesh> polymer::import_model(const std::s
     if (ext == "fbx")
     {
         auto asset = import_fbx_model(path);
-        for (auto & a : asset) models[a.first] = a.second;
+        for (auto & a : asset) { optimize_model(a.second); models[a.first] = a.second; }
     }
     else if (ext == "obj")
     {
         auto asset = import_obj_model(path);
-        for (auto & a : asset) models[a.first] = a.second;
+        for (auto & a : asset) { optimize_model(a.second); models[a.first] = a.second; }
     }
     else if (ext == "ply")
     {
@@ -164,80 +170,696 @@ std::unordered_map<std::string, runtime_mesh> polymer::import_obj_model(const st
 
 void polymer::optimize_model(runtime_mesh & input)
 {
-    // todo 
+    if (input.faces.empty() || input.vertices.empty()) return;
+
+    const size_t vertexCount = input.vertices.size();
+    uint32_t * indices = reinterpret_cast<uint32_t *>(input.faces.data());
+    const size_t indexCount = input.faces.size() * 3;
+
+    // Triangle reordering must keep the per-face material array associated with
+    // its triangles, so when a mesh carries mixed material ids the faces are
+    // bucketed by material and each bucket is optimized independently.
+    const bool perFaceMaterials = (input.material.size() == input.faces.size());
+    bool mixedMaterials = false;
+    if (perFaceMaterials)
+    {
+        for (size_t f = 1; f < input.material.size(); ++f)
+        {
+            if (input.material[f] != input.material[0]) { mixedMaterials = true; break; }
+        }
+    }
+
+    auto optimize_triangle_range = [&input, vertexCount](uint32_t * rangeIndices, const size_t rangeIndexCount)
+    {
+        // Forsyth-style post-transform cache optimization, then overdraw-aware
+        // reordering constrained to cost at most 5% of the cache win.
+        std::vector<uint32_t> scratch(rangeIndexCount);
+        meshopt_optimizeVertexCache(scratch.data(), rangeIndices, rangeIndexCount, vertexCount);
+        meshopt_optimizeOverdraw(rangeIndices, scratch.data(), rangeIndexCount, &input.vertices[0].x, vertexCount, sizeof(float3), 1.05f);
+    };
+
+    if (mixedMaterials)
+    {
+        std::map<uint32_t, std::vector<uint3>> buckets;
+        for (size_t f = 0; f < input.faces.size(); ++f) buckets[input.material[f]].push_back(input.faces[f]);
+
+        size_t cursor = 0;
+        for (auto & bucket : buckets)
+        {
+            optimize_triangle_range(reinterpret_cast<uint32_t *>(bucket.second.data()), bucket.second.size() * 3);
+            for (const uint3 & face : bucket.second)
+            {
+                input.faces[cursor] = face;
+                input.material[cursor] = bucket.first;
+                ++cursor;
+            }
+        }
+    }
+    else
+    {
+        optimize_triangle_range(indices, indexCount);
+    }
+
+    // Vertex fetch optimization: reorder the vertex streams into the order the
+    // optimized indices first reference them, and drop unreferenced vertices.
+    std::vector<uint32_t> remap(vertexCount);
+    const size_t uniqueVertexCount = meshopt_optimizeVertexFetchRemap(remap.data(), indices, indexCount, vertexCount);
+    meshopt_remapIndexBuffer(indices, indices, indexCount, remap.data());
+
+    auto remap_attribute = [&](void * data, const size_t count, const size_t stride)
+    {
+        if (count == vertexCount) meshopt_remapVertexBuffer(data, data, vertexCount, stride, remap.data());
+    };
+
+    remap_attribute(input.vertices.data(), input.vertices.size(), sizeof(float3));
+    remap_attribute(input.normals.data(), input.normals.size(), sizeof(float3));
+    remap_attribute(input.colors.data(), input.colors.size(), sizeof(float4));
+    remap_attribute(input.texcoord0.data(), input.texcoord0.size(), sizeof(float2));
+    remap_attribute(input.texcoord1.data(), input.texcoord1.size(), sizeof(float2));
+    remap_attribute(input.tangents.data(), input.tangents.size(), sizeof(float3));
+    remap_attribute(input.bitangents.data(), input.bitangents.size(), sizeof(float3));
+
+    if (uniqueVertexCount < vertexCount)
+    {
+        auto shrink = [&](auto & attribute) { if (attribute.size() == vertexCount) attribute.resize(uniqueVertexCount); };
+        shrink(input.vertices);
+        shrink(input.normals);
+        shrink(input.colors);
+        shrink(input.texcoord0);
+        shrink(input.texcoord1);
+        shrink(input.tangents);
+        shrink(input.bitangents);
+    }
+}
+
+runtime_mesh polymer::decimate_mesh(const runtime_mesh & input, const float triangle_ratio)
+{
+    runtime_mesh output = input;
+    if (input.faces.empty() || input.vertices.empty() || triangle_ratio >= 1.f) return output;
+
+    const size_t vertexCount = input.vertices.size();
+    const size_t indexCount = input.faces.size() * 3;
+    const size_t targetIndexCount = std::max<size_t>((static_cast<size_t>(indexCount * triangle_ratio) / 3) * 3, 3);
+
+    std::vector<uint32_t> simplified(indexCount);
+    const size_t simplifiedIndexCount = meshopt_simplify(simplified.data(),
+        reinterpret_cast<const uint32_t *>(input.faces.data()), indexCount,
+        &input.vertices[0].x, vertexCount, sizeof(float3), targetIndexCount);
+
+    output.faces.resize(simplifiedIndexCount / 3);
+    std::memcpy(output.faces.data(), simplified.data(), simplifiedIndexCount * sizeof(uint32_t));
+
+    // Simplification has no triangle-to-source mapping, so per-face materials only
+    // survive when the source used a single id throughout
+    bool uniformMaterial = (input.material.size() == input.faces.size());
+    for (size_t f = 1; uniformMaterial && f < input.material.size(); ++f)
+    {
+        if (input.material[f] != input.material[0]) uniformMaterial = false;
+    }
+    if (uniformMaterial && !input.material.empty()) output.material.assign(output.faces.size(), input.material[0]);
+    else output.material.clear();
+
+    // Compact away unreferenced vertices and restore cache-friendly ordering
+    optimize_model(output);
+
+    return output;
+}
+
+std::vector<runtime_mesh> polymer::generate_mesh_lods(const std::string & base_path, const runtime_mesh & mesh, bool compressed)
+{
+    static const float ratios[] = { 0.5f, 0.2f, 0.05f };
+
+    std::vector<runtime_mesh> lods;
+    for (int level = 0; level < 3; ++level)
+    {
+        const std::string lod_path = base_path + "_lod" + std::to_string(level + 1) + ".mesh";
+
+        if (std::ifstream(lod_path, std::ios::binary).good())
+        {
+            lods.push_back(import_mesh_binary(lod_path));
+            continue;
+        }
+
+        runtime_mesh lod = decimate_mesh(mesh, ratios[level]);
+        export_mesh_binary(lod_path, lod, compressed);
+        lods.push_back(std::move(lod));
+    }
+    return lods;
 }
 
+namespace
+{
+    // Octahedral mapping between unit vectors and a pair of snorm16 values.
+    // ~0.01 degree worst-case error, 4 bytes per direction instead of 12.
+    inline void oct16_encode(const float3 & n, int16_t * out)
+    {
+        const float invL1 = 1.f / (std::abs(n.x) + std::abs(n.y) + std::abs(n.z) + 1e-9f);
+        float u = n.x * invL1, v = n.y * invL1;
+        if (n.z < 0.f)
+        {
+            const float pu = (1.f - std::abs(v)) * (u >= 0.f ? 1.f : -1.f);
+            const float pv = (1.f - std::abs(u)) * (v >= 0.f ? 1.f : -1.f);
+            u = pu; v = pv;
+        }
+        out[0] = (int16_t) meshopt_quantizeSnorm(u, 16);
+        out[1] = (int16_t) meshopt_quantizeSnorm(v, 16);
+    }
+
+    inline float3 oct16_decode(const int16_t * in)
+    {
+        const float u = in[0] / 32767.f, v = in[1] / 32767.f;
+        float3 n(u, v, 1.f - std::abs(u) - std::abs(v));
+        if (n.z < 0.f)
+        {
+            const float px = (1.f - std::abs(n.y)) * (n.x >= 0.f ? 1.f : -1.f);
+            const float py = (1.f - std::abs(n.x)) * (n.y >= 0.f ? 1.f : -1.f);
+            n.x = px; n.y = py;
+        }
+        return normalize(n);
+    }
+
+    // Version 1 layout: fixed attribute order, raw bytes. Byte-identical to the
+    // original reader so existing *.mesh files continue to import. (The v1
+    // exporter sized colors as float3 while runtime_mesh stores float4, so v1
+    // colors were never reliable; that quirk is preserved, not fixed, here.)
+    runtime_mesh import_mesh_binary_v1(const mapped_file & file, const std::string & path)
+    {
+        runtime_mesh_binary_header h;
+        std::memcpy(&h, file.data(), sizeof(runtime_mesh_binary_header));
+
+        if (h.compressionVersion > 1) throw std::runtime_error("unsupported v1 compression version in " + path);
+
+        runtime_mesh mesh;
+
+        mesh.vertices.resize(h.verticesBytes / sizeof(float3));
+        mesh.normals.resize(h.normalsBytes / sizeof(float3));
+        mesh.colors.resize(h.colorsBytes / sizeof(float3));
+        mesh.texcoord0.resize(h.texcoord0Bytes / sizeof(float2));
+        mesh.texcoord1.resize(h.texcoord1Bytes / sizeof(float2));
+        mesh.tangents.resize(h.tangentsBytes / sizeof(float3));
+        mesh.bitangents.resize(h.bitangentsBytes / sizeof(float3));
+        mesh.faces.resize(h.facesBytes / sizeof(uint3));
+        mesh.material.resize(h.materialsBytes / sizeof(uint32_t));
+
+        const uint8_t * cursor = file.data() + sizeof(runtime_mesh_binary_header);
+        const uint8_t * end = file.data() + file.size();
+        auto read_attribute = [&cursor, end, &path](void * dst, const size_t bytes)
+        {
+            if (cursor + bytes > end) throw std::runtime_error("mesh binary is truncated: " + path);
+            std::memcpy(dst, cursor, bytes);
+            cursor += bytes;
+        };
+
+        read_attribute(mesh.vertices.data(), h.verticesBytes);
+        read_attribute(mesh.normals.data(), h.normalsBytes);
+        read_attribute(mesh.colors.data(), h.colorsBytes);
+        read_attribute(mesh.texcoord0.data(), h.texcoord0Bytes);
+        read_attribute(mesh.texcoord1.data(), h.texcoord1Bytes);
+        read_attribute(mesh.tangents.data(), h.tangentsBytes);
+        read_attribute(mesh.bitangents.data(), h.bitangentsBytes);
+        read_attribute(mesh.faces.data(), h.facesBytes);
+        read_attribute(mesh.material.data(), h.materialsBytes);
+
+        return mesh;
+    }
+
+} // end anonymous namespace
+
 runtime_mesh polymer::import_mesh_binary(const std::string & path)
 {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file.good()) throw std::runtime_error("couldn't open");
+    mapped_file file(path);
+    if (file.size() < sizeof(uint32_t)) throw std::runtime_error("mesh binary is truncated: " + path);
 
-    file.seekg(0, std::ios::end);
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    uint32_t headerVersion;
+    std::memcpy(&headerVersion, file.data(), sizeof(uint32_t));
 
-    runtime_mesh_binary_header h;
-    file.read((char*)&h, sizeof(runtime_mesh_binary_header));
+    if (headerVersion == 1) return import_mesh_binary_v1(file, path);
+    if (headerVersion != runtime_mesh_binary_version) throw std::runtime_error("unsupported mesh binary version in " + path);
 
-    assert(h.headerVersion == runtime_mesh_binary_version);
-    if (h.compressionVersion > 0) assert(h.compressionVersion == runtime_mesh_compression_version);
+    if (file.size() < sizeof(runtime_mesh_binary_header_v2)) throw std::runtime_error("mesh binary is truncated: " + path);
+    runtime_mesh_binary_header_v2 h;
+    std::memcpy(&h, file.data(), sizeof(runtime_mesh_binary_header_v2));
+    if (h.compressionVersion > runtime_mesh_compression_version) throw std::runtime_error("unsupported compression version in " + path);
+
+    const uint8_t * descriptors = file.data() + sizeof(runtime_mesh_binary_header_v2);
+    const uint8_t * payload = descriptors + h.chunkCount * sizeof(runtime_mesh_binary_chunk);
+    const uint8_t * end = file.data() + file.size();
+    if (payload > end) throw std::runtime_error("mesh binary is truncated: " + path);
 
     runtime_mesh mesh;
 
-    mesh.vertices.resize(h.verticesBytes / sizeof(float3));
-    mesh.normals.resize(h.normalsBytes / sizeof(float3));
-    mesh.colors.resize(h.colorsBytes / sizeof(float3));
-    mesh.texcoord0.resize(h.texcoord0Bytes / sizeof(float2));
-    mesh.texcoord1.resize(h.texcoord1Bytes / sizeof(float2));
-    mesh.tangents.resize(h.tangentsBytes / sizeof(float3));
-    mesh.bitangents.resize(h.bitangentsBytes / sizeof(float3));
-    mesh.faces.resize(h.facesBytes / sizeof(uint3));
-    mesh.material.resize(h.materialsBytes / sizeof(uint32_t));
-
-    file.read((char*)mesh.vertices.data(), h.verticesBytes);
-    file.read((char*)mesh.normals.data(), h.normalsBytes);
-    file.read((char*)mesh.colors.data(), h.colorsBytes);
-    file.read((char*)mesh.texcoord0.data(), h.texcoord0Bytes);
-    file.read((char*)mesh.texcoord1.data(), h.texcoord1Bytes);
-    file.read((char*)mesh.tangents.data(), h.tangentsBytes);
-    file.read((char*)mesh.bitangents.data(), h.bitangentsBytes);
-    file.read((char*)mesh.faces.data(), h.facesBytes);
-    file.read((char*)mesh.material.data(), h.materialsBytes);
+    // Sizing happens up front on the calling thread; each chunk then decodes
+    // into a disjoint destination on a worker, overlapping decompression of
+    // positions, indices, uvs etc. across the pool.
+    task_scheduler & scheduler = get_task_scheduler();
+    task_group decode_tasks;
+    std::atomic<bool> decode_failed{ false };
+
+    auto decode_elements = [&decode_failed](const runtime_mesh_binary_chunk & c, const uint8_t * src, void * dst, const size_t stride)
+    {
+        if (c.encoding == mesh_encoding_raw) std::memcpy(dst, src, size_t(c.elementCount) * stride);
+        else if (meshopt_decodeVertexBuffer(dst, c.elementCount, stride, src, c.payloadBytes) != 0) decode_failed = true;
+    };
+
+    for (uint32_t i = 0; i < h.chunkCount; ++i)
+    {
+        runtime_mesh_binary_chunk c;
+        std::memcpy(&c, descriptors + i * sizeof(runtime_mesh_binary_chunk), sizeof(runtime_mesh_binary_chunk));
+
+        const uint8_t * src = payload;
+        payload += c.payloadBytes;
+        if (payload > end) throw std::runtime_error("mesh binary is truncated: " + path);
+
+        switch (c.attribute)
+        {
+            case mesh_attribute_vertices:   mesh.vertices.resize(c.elementCount);   decode_tasks.run(scheduler, [=, &mesh]() { decode_elements(c, src, mesh.vertices.data(), sizeof(float3)); }); break;
+            case mesh_attribute_colors:     mesh.colors.resize(c.elementCount);     decode_tasks.run(scheduler, [=, &mesh]() { decode_elements(c, src, mesh.colors.data(), sizeof(float4)); }); break;
+            case mesh_attribute_texcoord0:  mesh.texcoord0.resize(c.elementCount);  decode_tasks.run(scheduler, [=, &mesh]() { decode_elements(c, src, mesh.texcoord0.data(), sizeof(float2)); }); break;
+            case mesh_attribute_texcoord1:  mesh.texcoord1.resize(c.elementCount);  decode_tasks.run(scheduler, [=, &mesh]() { decode_elements(c, src, mesh.texcoord1.data(), sizeof(float2)); }); break;
+            case mesh_attribute_material:   mesh.material.resize(c.elementCount);   decode_tasks.run(scheduler, [=, &mesh]() { decode_elements(c, src, mesh.material.data(), sizeof(uint32_t)); }); break;
+
+            case mesh_attribute_normals:
+            case mesh_attribute_tangents:
+            case mesh_attribute_bitangents:
+            {
+                std::vector<float3> * dst = (c.attribute == mesh_attribute_normals) ? &mesh.normals : (c.attribute == mesh_attribute_tangents) ? &mesh.tangents : &mesh.bitangents;
+                dst->resize(c.elementCount);
+                if (c.encoding == mesh_encoding_oct16)
+                {
+                    decode_tasks.run(scheduler, [c, src, dst, &decode_failed]()
+                    {
+                        std::vector<int16_t> quantized(size_t(c.elementCount) * 2);
+                        if (meshopt_decodeVertexBuffer(quantized.data(), c.elementCount, 2 * sizeof(int16_t), src, c.payloadBytes) != 0) { decode_failed = true; return; }
+                        for (uint32_t e = 0; e < c.elementCount; ++e) (*dst)[e] = oct16_decode(&quantized[e * 2]);
+                    });
+                }
+                else decode_tasks.run(scheduler, [=]() { decode_elements(c, src, dst->data(), sizeof(float3)); });
+                break;
+            }
+
+            case mesh_attribute_faces:
+            {
+                mesh.faces.resize(c.elementCount);
+                if (c.encoding == mesh_encoding_index_codec)
+                {
+                    decode_tasks.run(scheduler, [c, src, &mesh, &decode_failed]()
+                    {
+                        if (meshopt_decodeIndexBuffer(reinterpret_cast<uint32_t *>(mesh.faces.data()), size_t(c.elementCount) * 3, sizeof(uint32_t), src, c.payloadBytes) != 0) decode_failed = true;
+                    });
+                }
+                else decode_tasks.run(scheduler, [=, &mesh]() { decode_elements(c, src, mesh.faces.data(), sizeof(uint3)); });
+                break;
+            }
+
+            default: throw std::runtime_error("unknown attribute chunk in " + path);
+        }
+    }
+
+    decode_tasks.wait();
+    if (decode_failed) throw std::runtime_error("corrupt chunk payload in " + path);
 
     return mesh;
 }
 
 void polymer::export_mesh_binary(const std::string & path, runtime_mesh & mesh, bool compressed)
 {
+    std::vector<runtime_mesh_binary_chunk> chunks;
+    std::vector<std::vector<uint8_t>> payloads;
+
+    auto add_chunk = [&](const runtime_mesh_attribute attribute, const void * data, const size_t count, const size_t stride)
+    {
+        if (count == 0) return;
+
+        runtime_mesh_binary_chunk c;
+        c.attribute = attribute;
+        c.elementCount = (uint32_t) count;
+        c.elementStride = (uint32_t) stride;
+
+        std::vector<uint8_t> bytes;
+        if (compressed)
+        {
+            c.encoding = mesh_encoding_vertex_codec;
+            bytes.resize(meshopt_encodeVertexBufferBound(count, stride));
+            bytes.resize(meshopt_encodeVertexBuffer(bytes.data(), bytes.size(), data, count, stride));
+        }
+        else
+        {
+            c.encoding = mesh_encoding_raw;
+            bytes.assign((const uint8_t *) data, (const uint8_t *) data + count * stride);
+        }
+
+        c.payloadBytes = (uint32_t) bytes.size();
+        chunks.push_back(c);
+        payloads.push_back(std::move(bytes));
+    };
+
+    // Unit direction attributes quantize to snorm16 octahedral pairs before the
+    // vertex codec - a third the size of raw float3s even before compression.
+    auto add_direction_chunk = [&](const runtime_mesh_attribute attribute, const std::vector<float3> & directions)
+    {
+        if (directions.empty()) return;
+        if (!compressed) { add_chunk(attribute, directions.data(), directions.size(), sizeof(float3)); return; }
+
+        std::vector<int16_t> quantized(directions.size() * 2);
+        for (size_t i = 0; i < directions.size(); ++i) oct16_encode(directions[i], &quantized[i * 2]);
+
+        runtime_mesh_binary_chunk c;
+        c.attribute = attribute;
+        c.encoding = mesh_encoding_oct16;
+        c.elementCount = (uint32_t) directions.size();
+        c.elementStride = 2 * sizeof(int16_t);
+
+        std::vector<uint8_t> bytes(meshopt_encodeVertexBufferBound(directions.size(), 2 * sizeof(int16_t)));
+        bytes.resize(meshopt_encodeVertexBuffer(bytes.data(), bytes.size(), quantized.data(), directions.size(), 2 * sizeof(int16_t)));
+
+        c.payloadBytes = (uint32_t) bytes.size();
+        chunks.push_back(c);
+        payloads.push_back(std::move(bytes));
+    };
+
+    add_chunk(mesh_attribute_vertices, mesh.vertices.data(), mesh.vertices.size(), sizeof(float3));
+    add_direction_chunk(mesh_attribute_normals, mesh.normals);
+    add_chunk(mesh_attribute_colors, mesh.colors.data(), mesh.colors.size(), sizeof(float4));
+    add_chunk(mesh_attribute_texcoord0, mesh.texcoord0.data(), mesh.texcoord0.size(), sizeof(float2));
+    add_chunk(mesh_attribute_texcoord1, mesh.texcoord1.data(), mesh.texcoord1.size(), sizeof(float2));
+    add_direction_chunk(mesh_attribute_tangents, mesh.tangents);
+    add_direction_chunk(mesh_attribute_bitangents, mesh.bitangents);
+
+    if (!mesh.faces.empty())
+    {
+        if (compressed)
+        {
+            runtime_mesh_binary_chunk c;
+            c.attribute = mesh_attribute_faces;
+            c.elementCount = (uint32_t) mesh.faces.size();
+            c.elementStride = sizeof(uint3);
+
+            // The index codec delta-encodes against recently seen vertices, so it
+            // already beats a blanket 16-bit truncation whenever ranges are small.
+            const size_t indexCount = mesh.faces.size() * 3;
+            const uint32_t * indices = reinterpret_cast<const uint32_t *>(mesh.faces.data());
+            size_t vertexCount = mesh.vertices.size();
+            if (vertexCount == 0) for (size_t i = 0; i < indexCount; ++i) vertexCount = std::max(vertexCount, size_t(indices[i]) + 1);
+
+            c.encoding = mesh_encoding_index_codec;
+            std::vector<uint8_t> bytes(meshopt_encodeIndexBufferBound(indexCount, vertexCount));
+            bytes.resize(meshopt_encodeIndexBuffer(bytes.data(), bytes.size(), indices, indexCount));
+            c.payloadBytes = (uint32_t) bytes.size();
+            chunks.push_back(c);
+            payloads.push_back(std::move(bytes));
+        }
+        else
+        {
+            add_chunk(mesh_attribute_faces, mesh.faces.data(), mesh.faces.size(), sizeof(uint3));
+        }
+    }
+
+    add_chunk(mesh_attribute_material, mesh.material.data(), mesh.material.size(), sizeof(uint32_t));
+
+    runtime_mesh_binary_header_v2 header;
+    header.compressionVersion = compressed ? runtime_mesh_compression_version : 0;
+    header.chunkCount = (uint32_t) chunks.size();
+
     auto file = std::ofstream(path, std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<char *>(&header), sizeof(runtime_mesh_binary_header_v2));
+    for (auto & c : chunks) file.write(reinterpret_cast<char *>(&c), sizeof(runtime_mesh_binary_chunk));
+    for (auto & p : payloads) file.write(reinterpret_cast<const char *>(p.data()), p.size());
+    file.close();
+}
+
+////////////////////////////////
+//   Animation Serialization  //
+////////////////////////////////
+
+namespace
+{
+    std::vector<std::shared_ptr<animation_keyframe>> sorted_track_keys(const animation_track & track)
+    {
+        std::vector<std::shared_ptr<animation_keyframe>> keys = track.keyframes;
+        std::sort(keys.begin(), keys.end(), [](const std::shared_ptr<animation_keyframe> & a,
+            const std::shared_ptr<animation_keyframe> & b) { return a->key < b->key; });
+        return keys;
+    }
+}
+
+skeletal_animation polymer::simplify_animation(const skeletal_animation & input,
+                                               const float rotation_tolerance_degrees,
+                                               const float translation_tolerance,
+                                               const float scale_tolerance)
+{
+    // Quaternion angular error: theta = 2 * acos(|dot|); compare dots instead of angles
+    const float minRotationDot = std::cos(rotation_tolerance_degrees * float(POLYMER_PI) / 180.f * 0.5f);
+
+    skeletal_animation out;
+    out.name = input.name;
+    out.startFrame = input.startFrame;
+    out.endFrame = input.endFrame;
+
+    for (const auto & track : input.tracks)
+    {
+        if (!track) continue;
+
+        auto simplified = std::make_shared<animation_track>();
+        simplified->boneIndex = track->boneIndex;
+
+        if (track->keyframes.size() <= 2)
+        {
+            simplified->keyframes = track->keyframes;
+        }
+        else
+        {
+            const auto keys = sorted_track_keys(*track);
+
+            // Greedy window growth: anchored at the last kept key, extend the
+            // candidate endpoint while every interior key lerps back within
+            // tolerance. First and last keys always survive so clip endpoints
+            // (and loop boundaries) are exact.
+            size_t anchor = 0;
+            simplified->keyframes.push_back(keys.front());
+
+            while (anchor + 1 < keys.size())
+            {
+                size_t endpoint = keys.size() - 1;
+                for (size_t candidate = anchor + 2; candidate <= keys.size() - 1; ++candidate)
+                {
+                    const animation_keyframe & a = *keys[anchor];
+                    const animation_keyframe & b = *keys[candidate];
+                    const float span = float(b.key - a.key);
+
+                    bool reconstructible = true;
+                    for (size_t i = anchor + 1; i < candidate && reconstructible; ++i)
+                    {
+                        const animation_keyframe & k = *keys[i];
+                        const float t = span > 0.f ? (k.key - a.key) / span : 0.f;
+
+                        float4 rotB = b.rotation;
+                        if (dot(a.rotation, rotB) < 0.f) rotB = -rotB;
+                        const float4 rot = normalize(lerp(a.rotation, rotB, t));
+                        if (std::abs(dot(rot, normalize(k.rotation))) < minRotationDot) reconstructible = false;
+                        if (length(lerp(a.translation, b.translation, t) - k.translation) > translation_tolerance) reconstructible = false;
+                        if (length(lerp(a.scale, b.scale, t) - k.scale) > scale_tolerance) reconstructible = false;
+                    }
+
+                    if (!reconstructible) { endpoint = candidate - 1; break; }
+                }
+
+                simplified->keyframes.push_back(keys[endpoint]);
+                anchor = endpoint;
+            }
+        }
+
+        simplified->keyframeCount = uint32_t(simplified->keyframes.size());
+        out.tracks.push_back(simplified);
+    }
+
+    out.trackCount = uint32_t(out.tracks.size());
+    return out;
+}
+
+void polymer::export_animation_binary(const std::string & path, const skeletal_animation & anim, bool compressed)
+{
+    skeletal_animation_binary_header header;
+    header.compressionVersion = compressed ? 1 : 0;
+    header.startFrame = anim.startFrame;
+    header.endFrame = anim.endFrame;
+    header.nameBytes = uint32_t(anim.name.size());
+
+    std::vector<skeletal_animation_binary_track> descriptors;
+    std::vector<uint32_t> frames;
+    std::vector<int16_t>  rotations;    // 4 per key, snorm16, hemisphere-aligned
+    std::vector<uint16_t> translations; // 3 per key, unorm16 against the track range
+    std::vector<uint16_t> scales;       // 3 per key, unorm16 against the track range
+
+    for (const auto & track : anim.tracks)
+    {
+        if (!track || track->keyframes.empty()) continue;
 
-    runtime_mesh_binary_header header;
-    header.headerVersion = runtime_mesh_binary_version;
-    header.compressionVersion = (compressed) ? runtime_mesh_compression_version : 0;
-    header.verticesBytes = (uint32_t)mesh.vertices.size() * sizeof(float3);
-    header.normalsBytes = (uint32_t)mesh.normals.size() * sizeof(float3);
-    header.colorsBytes = (uint32_t)mesh.colors.size() * sizeof(float3);
-    header.texcoord0Bytes = (uint32_t)mesh.texcoord0.size() * sizeof(float2);
-    header.texcoord1Bytes = (uint32_t)mesh.texcoord1.size() * sizeof(float2);
-    header.tangentsBytes = (uint32_t)mesh.tangents.size() * sizeof(float3);
-    header.bitangentsBytes = (uint32_t)mesh.bitangents.size() * sizeof(float3);
-    header.facesBytes = (uint32_t)mesh.faces.size() * sizeof(uint3);
-    header.materialsBytes = (uint32_t)mesh.material.size() * sizeof(uint32_t);
-
-    file.write(reinterpret_cast<char*>(&header), sizeof(runtime_mesh_binary_header));
-    file.write(reinterpret_cast<char*>(mesh.vertices.data()), header.verticesBytes);
-    file.write(reinterpret_cast<char*>(mesh.normals.data()), header.normalsBytes);
-    file.write(reinterpret_cast<char*>(mesh.colors.data()), header.colorsBytes);
-    file.write(reinterpret_cast<char*>(mesh.texcoord0.data()), header.texcoord0Bytes);
-    file.write(reinterpret_cast<char*>(mesh.texcoord1.data()), header.texcoord1Bytes);
-    file.write(reinterpret_cast<char*>(mesh.tangents.data()), header.tangentsBytes);
-    file.write(reinterpret_cast<char*>(mesh.bitangents.data()), header.bitangentsBytes);
-    file.write(reinterpret_cast<char*>(mesh.faces.data()), header.facesBytes);
-    file.write(reinterpret_cast<char*>(mesh.material.data()), header.materialsBytes);
+        const auto keys = sorted_track_keys(*track);
 
+        skeletal_animation_binary_track descriptor;
+        descriptor.boneIndex = track->boneIndex;
+        descriptor.keyCount = uint32_t(keys.size());
+
+        float3 tMin = keys.front()->translation, tMax = tMin;
+        float3 sMin = keys.front()->scale, sMax = sMin;
+        for (const auto & k : keys)
+        {
+            tMin = linalg::min(tMin, k->translation); tMax = linalg::max(tMax, k->translation);
+            sMin = linalg::min(sMin, k->scale); sMax = linalg::max(sMax, k->scale);
+        }
+        descriptor.translationMin = tMin; descriptor.translationExtent = tMax - tMin;
+        descriptor.scaleMin = sMin; descriptor.scaleExtent = sMax - sMin;
+
+        float4 previousRotation = keys.front()->rotation;
+        for (const auto & k : keys)
+        {
+            frames.push_back(k->key);
+
+            float4 q = normalize(k->rotation);
+            if (dot(q, previousRotation) < 0.f) q = -q;
+            previousRotation = q;
+            for (int c = 0; c < 4; ++c) rotations.push_back(int16_t(std::round(clamp(q[c], -1.f, 1.f) * 32767.f)));
+
+            for (int c = 0; c < 3; ++c)
+            {
+                const float te = descriptor.translationExtent[c];
+                const float se = descriptor.scaleExtent[c];
+                const float tn = te > 0.f ? (k->translation[c] - descriptor.translationMin[c]) / te : 0.f;
+                const float sn = se > 0.f ? (k->scale[c] - descriptor.scaleMin[c]) / se : 0.f;
+                translations.push_back(uint16_t(std::round(tn * 65535.f)));
+                scales.push_back(uint16_t(std::round(sn * 65535.f)));
+            }
+        }
+
+        header.keyCount += descriptor.keyCount;
+        descriptors.push_back(descriptor);
+    }
+
+    header.trackCount = uint32_t(descriptors.size());
+
+    // The vertex codec's byte-plane deltas do the heavy lifting: quantized mocap
+    // curves change by a few ulps per key, so most planes collapse to near-zero.
+    auto encode_payload = [compressed](const void * data, const size_t count, const size_t stride)
+    {
+        std::vector<uint8_t> bytes;
+        if (compressed && count > 0)
+        {
+            bytes.resize(meshopt_encodeVertexBufferBound(count, stride));
+            bytes.resize(meshopt_encodeVertexBuffer(bytes.data(), bytes.size(), data, count, stride));
+        }
+        else bytes.assign((const uint8_t *) data, (const uint8_t *) data + count * stride);
+        return bytes;
+    };
+
+    const size_t keyCount = frames.size();
+    const std::vector<uint8_t> framePayload = encode_payload(frames.data(), keyCount, sizeof(uint32_t));
+    const std::vector<uint8_t> rotationPayload = encode_payload(rotations.data(), keyCount, 4 * sizeof(int16_t));
+    const std::vector<uint8_t> translationPayload = encode_payload(translations.data(), keyCount, 3 * sizeof(uint16_t));
+    const std::vector<uint8_t> scalePayload = encode_payload(scales.data(), keyCount, 3 * sizeof(uint16_t));
+
+    header.framesBytes = uint32_t(framePayload.size());
+    header.rotationsBytes = uint32_t(rotationPayload.size());
+    header.translationsBytes = uint32_t(translationPayload.size());
+    header.scalesBytes = uint32_t(scalePayload.size());
+
+    auto file = std::ofstream(path, std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<char *>(&header), sizeof(skeletal_animation_binary_header));
+    for (auto & d : descriptors) file.write(reinterpret_cast<char *>(&d), sizeof(skeletal_animation_binary_track));
+    file.write(anim.name.data(), header.nameBytes);
+    file.write(reinterpret_cast<const char *>(framePayload.data()), framePayload.size());
+    file.write(reinterpret_cast<const char *>(rotationPayload.data()), rotationPayload.size());
+    file.write(reinterpret_cast<const char *>(translationPayload.data()), translationPayload.size());
+    file.write(reinterpret_cast<const char *>(scalePayload.data()), scalePayload.size());
     file.close();
 }
 
+skeletal_animation polymer::import_animation_binary(const std::string & path)
+{
+    mapped_file file(path);
+    if (file.size() < sizeof(skeletal_animation_binary_header)) throw std::runtime_error("animation binary is truncated: " + path);
+
+    skeletal_animation_binary_header h;
+    std::memcpy(&h, file.data(), sizeof(skeletal_animation_binary_header));
+    if (h.headerVersion != skeletal_animation_binary_version) throw std::runtime_error("unsupported animation binary version in " + path);
+    if (h.compressionVersion > 1) throw std::runtime_error("unsupported compression version in " + path);
+
+    const uint8_t * cursor = file.data() + sizeof(skeletal_animation_binary_header);
+    const uint8_t * end = file.data() + file.size();
+    auto advance = [&cursor, end, &path](const size_t bytes) -> const uint8_t *
+    {
+        const uint8_t * at = cursor;
+        cursor += bytes;
+        if (cursor > end) throw std::runtime_error("animation binary is truncated: " + path);
+        return at;
+    };
+
+    const uint8_t * descriptors = advance(h.trackCount * sizeof(skeletal_animation_binary_track));
+    const char * name = reinterpret_cast<const char *>(advance(h.nameBytes));
+
+    const size_t keyCount = h.keyCount;
+    std::vector<uint32_t> frames(keyCount);
+    std::vector<int16_t>  rotations(keyCount * 4);
+    std::vector<uint16_t> translations(keyCount * 3);
+    std::vector<uint16_t> scales(keyCount * 3);
+
+    auto decode_payload = [&h, &path](void * dst, const size_t count, const size_t stride, const uint8_t * src, const size_t payloadBytes)
+    {
+        if (count == 0) return;
+        if (h.compressionVersion == 0)
+        {
+            if (payloadBytes != count * stride) throw std::runtime_error("corrupt payload in " + path);
+            std::memcpy(dst, src, payloadBytes);
+        }
+        else if (meshopt_decodeVertexBuffer(dst, count, stride, src, payloadBytes) != 0) throw std::runtime_error("corrupt payload in " + path);
+    };
+
+    decode_payload(frames.data(), keyCount, sizeof(uint32_t), advance(h.framesBytes), h.framesBytes);
+    decode_payload(rotations.data(), keyCount, 4 * sizeof(int16_t), advance(h.rotationsBytes), h.rotationsBytes);
+    decode_payload(translations.data(), keyCount, 3 * sizeof(uint16_t), advance(h.translationsBytes), h.translationsBytes);
+    decode_payload(scales.data(), keyCount, 3 * sizeof(uint16_t), advance(h.scalesBytes), h.scalesBytes);
+
+    skeletal_animation anim;
+    anim.name.assign(name, h.nameBytes);
+    anim.startFrame = h.startFrame;
+    anim.endFrame = h.endFrame;
+    anim.trackCount = h.trackCount;
+
+    size_t key = 0;
+    for (uint32_t i = 0; i < h.trackCount; ++i)
+    {
+        skeletal_animation_binary_track d;
+        std::memcpy(&d, descriptors + i * sizeof(skeletal_animation_binary_track), sizeof(skeletal_animation_binary_track));
+        if (key + d.keyCount > keyCount) throw std::runtime_error("corrupt track descriptor in " + path);
+
+        auto track = std::make_shared<animation_track>();
+        track->boneIndex = d.boneIndex;
+        track->keyframeCount = d.keyCount;
+
+        for (uint32_t k = 0; k < d.keyCount; ++k, ++key)
+        {
+            auto keyframe = std::make_shared<animation_keyframe>();
+            keyframe->key = frames[key];
+
+            const int16_t * r = rotations.data() + key * 4;
+            keyframe->rotation = normalize(float4(r[0], r[1], r[2], r[3]) * (1.f / 32767.f));
+
+            const uint16_t * t = translations.data() + key * 3;
+            const uint16_t * s = scales.data() + key * 3;
+            for (int c = 0; c < 3; ++c)
+            {
+                keyframe->translation[c] = d.translationMin[c] + (t[c] * (1.f / 65535.f)) * d.translationExtent[c];
+                keyframe->scale[c] = d.scaleMin[c] + (s[c] * (1.f / 65535.f)) * d.scaleExtent[c];
+            }
+
+            track->keyframes.push_back(keyframe);
+        }
+
+        anim.tracks.push_back(track);
+    }
+
+    return anim;
+}
+
 void export_obj_data(std::ofstream & file, runtime_mesh & mesh)
 {
     file << "# vertices\n";
@@ -52,14 +52,16 @@ namespace polymer
         std::vector<float4> boneWeights;
     };
 
-    #define runtime_mesh_binary_version 1
-    #define runtime_mesh_compression_version 1
+    #define runtime_mesh_binary_version 2
+    #define runtime_mesh_compression_version 2
 
     #pragma pack(push, 1)
+    // Version 1 layout: this header followed by raw attribute arrays in field
+    // order. Retained read-only so existing *.mesh files continue to import.
     struct runtime_mesh_binary_header
     {
-        uint32_t headerVersion{ runtime_mesh_binary_version };
-        uint32_t compressionVersion{ runtime_mesh_compression_version };
+        uint32_t headerVersion{ 1 };
+        uint32_t compressionVersion{ 1 };
         uint32_t verticesBytes{ 0 };
         uint32_t normalsBytes{ 0 };
         uint32_t colorsBytes{ 0 };
@@ -70,6 +72,82 @@ namespace polymer
         uint32_t facesBytes{ 0 };
         uint32_t materialsBytes{ 0 };
     };
+
+    // Version 2 layout: header, then `chunkCount` descriptors, then each chunk's
+    // payload in descriptor order. Attributes are stored as independent chunks
+    // (optionally run through the meshoptimizer vertex/index codecs, with unit
+    // directions quantized to 16-bit octahedral pairs first) so import can hand
+    // each chunk to a thread-pool worker and decompress them in parallel.
+    struct runtime_mesh_binary_header_v2
+    {
+        uint32_t headerVersion{ runtime_mesh_binary_version };
+        uint32_t compressionVersion{ runtime_mesh_compression_version };
+        uint32_t chunkCount{ 0 };
+    };
+
+    enum runtime_mesh_attribute : uint32_t
+    {
+        mesh_attribute_vertices = 0,
+        mesh_attribute_normals = 1,
+        mesh_attribute_colors = 2,
+        mesh_attribute_texcoord0 = 3,
+        mesh_attribute_texcoord1 = 4,
+        mesh_attribute_tangents = 5,
+        mesh_attribute_bitangents = 6,
+        mesh_attribute_faces = 7,
+        mesh_attribute_material = 8
+    };
+
+    enum runtime_mesh_encoding : uint32_t
+    {
+        mesh_encoding_raw = 0,          // uncompressed elements, memcpy on import
+        mesh_encoding_vertex_codec = 1, // meshopt vertex codec over fixed-stride elements
+        mesh_encoding_index_codec = 2,  // meshopt index codec over uint32 triangle indices
+        mesh_encoding_oct16 = 3         // snorm16 octahedral directions, then vertex codec
+    };
+
+    struct runtime_mesh_binary_chunk
+    {
+        uint32_t attribute{ 0 };    // runtime_mesh_attribute
+        uint32_t encoding{ 0 };     // runtime_mesh_encoding
+        uint32_t elementCount{ 0 }; // faces count triangles, everything else counts elements
+        uint32_t elementStride{ 0 };// size in bytes of one stored (pre-codec) element
+        uint32_t payloadBytes{ 0 }; // bytes on disk for this chunk
+    };
+
+    #define skeletal_animation_binary_version 1
+
+    // Polymer's *.anim layout: this header, then `trackCount` track descriptors,
+    // then the clip name, then four payloads (frames, rotations, translations,
+    // scales) holding every track's keys back to back in descriptor order.
+    // Rotations are snorm16 quaternions on a shared hemisphere; translation and
+    // scale are unorm16 against each track's range - the same quantization the
+    // runtime compiles clips to, so serialization adds no sampling error of its
+    // own. A compressionVersion of 1 runs each payload through the meshopt vertex
+    // codec, whose byte-plane delta encoding collapses the slowly-varying
+    // quantized curves mocap bakes produce.
+    struct skeletal_animation_binary_header
+    {
+        uint32_t headerVersion{ skeletal_animation_binary_version };
+        uint32_t compressionVersion{ 0 };
+        uint32_t startFrame{ 0 };
+        uint32_t endFrame{ 0 };
+        uint32_t trackCount{ 0 };
+        uint32_t keyCount{ 0 };   // summed across tracks
+        uint32_t nameBytes{ 0 };
+        uint32_t framesBytes{ 0 };
+        uint32_t rotationsBytes{ 0 };
+        uint32_t translationsBytes{ 0 };
+        uint32_t scalesBytes{ 0 };
+    };
+
+    struct skeletal_animation_binary_track
+    {
+        uint32_t boneIndex{ 0 };
+        uint32_t keyCount{ 0 };
+        float3 translationMin, translationExtent;
+        float3 scaleMin, scaleExtent;
+    };
     #pragma pack(pop)
 
     ///////////////////////
@@ -80,6 +158,20 @@ namespace polymer
     runtime_mesh import_mesh_binary(const std::string & path);
     void export_mesh_binary(const std::string & path, runtime_mesh & mesh, bool compressed = false);
 
+    // Tolerance-driven keyframe reduction: drops every interior key that linear
+    // interpolation of its surviving neighbours reconstructs within the given
+    // tolerances (rotation as an angle, translation/scale as absolute deltas).
+    // Dense baked curves - mocap exports keying every bone every frame - are
+    // mostly reconstructible, so this is run at import time before serializing.
+    skeletal_animation simplify_animation(const skeletal_animation & input,
+                                          const float rotation_tolerance_degrees = 0.5f,
+                                          const float translation_tolerance = 1e-3f,
+                                          const float scale_tolerance = 1e-3f);
+
+    // Polymer's quantized *.anim clip format (see skeletal_animation_binary_header)
+    skeletal_animation import_animation_binary(const std::string & path);
+    void export_animation_binary(const std::string & path, const skeletal_animation & anim, bool compressed = false);
+
     // Load an FBX model, assuming the path points to a valid *.fbx
     std::unordered_map<std::string, runtime_mesh> import_fbx_model(const std::string & path);
 
@@ -95,6 +187,18 @@ namespace polymer
     // Currently a no-op
     void optimize_model(runtime_mesh & input);
 
+    // Quadric simplification down to approximately `triangle_ratio` of the source
+    // triangle count (meshopt_simplify, topology-preserving - heavily constrained
+    // meshes may stop above the target). The result is compacted and reordered
+    // through optimize_model, so unreferenced vertices are dropped.
+    runtime_mesh decimate_mesh(const runtime_mesh & input, const float triangle_ratio);
+
+    // Builds polymer's standard three-level decimation chain (1/2, 1/5 and 1/20 of
+    // the source triangles), persisting each beside the source as
+    // <base_path>_lod<N>.mesh via export_mesh_binary. Levels that already exist on
+    // disk are imported instead of re-decimated.
+    std::vector<runtime_mesh> generate_mesh_lods(const std::string & base_path, const runtime_mesh & mesh, bool compressed = false);
+
 } // end namespace polymer
 
 #endif // end polymer_model_io_hpp
@@ -52,6 +52,7 @@ namespace polymer
 #include <cstddef>
 #include <initializer_list>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <typeinfo>
@@ -236,6 +237,11 @@ namespace polymer
     ///
     /// `polymer::any` is a C++11 compatible version of the C++17 `std::any` abstraction
     /// and is designed to be a drop-in replacement for code compliant with C++17.
+    ///
+    /// Contained objects up to `kInlineCapacity` bytes (float4, transform, asset handles,
+    /// and most other component field types) with a non-throwing move constructor are
+    /// stored directly inside the `any` - no heap allocation on construction, and moving
+    /// an `any` never allocates. Larger or throwing-move types fall back to the heap.
     class any
     {
     private:
@@ -248,16 +254,22 @@ namespace polymer
         // Constructors
 
         /// Constructs an empty `polymer::any` object (`any::has_value()` will return `false`).
-        constexpr any() noexcept;
+        constexpr any() noexcept : obj_(nullptr), is_inline_(false), buffer_{} {}
 
         /// Copy constructs an `polymer::any` object with a "contained object" of the
         /// passed type of `other` (or an empty `polymer::any` if `other.has_value()` is `false`.
-        any(const any & other) :
-            obj_(other.has_value() ? other.obj_->Clone() : std::unique_ptr<ObjInterface>()) {}
+        any(const any & other) : obj_(nullptr), is_inline_(false)
+        {
+            if (other.has_value()) copy_from(other);
+        }
 
         /// Move constructs an `polymer::any` object with a "contained object" of the
         /// passed type of `other` (or an empty `polymer::any` if `other.has_value()` is `false`).
-        any(any && other) noexcept = default;
+        /// Inline-stored values are moved member-wise; heap-stored values transfer ownership.
+        any(any && other) noexcept : obj_(nullptr), is_inline_(false)
+        {
+            move_from(std::move(other));
+        }
 
         /// Constructs an `polymer::any` object with a "contained object" of the decayed
         /// type of `T`, which is initialized via `std::forward<T>(value)`.
@@ -269,8 +281,10 @@ namespace polymer
             polymer::enable_if_t<!polymer::disjunction<
                 std::is_same<any, VT>, IsInPlaceType<VT>,
                 polymer::negation<std::is_copy_constructible<VT>>>::value> * = nullptr>
-        any(T && value) :
-            obj_(new Obj<VT>(in_place, std::forward<T>(value))) {}
+        any(T && value) : obj_(nullptr), is_inline_(false)
+        {
+            construct<VT>(std::forward<T>(value));
+        }
 
         /// Constructs an `polymer::any` object with a "contained object" of the decayed
         /// type of `T`, which is initialized via `std::forward<T>(value)`.
@@ -278,8 +292,10 @@ namespace polymer
                   polymer::enable_if_t<polymer::conjunction<
                       std::is_copy_constructible<VT>,
                       std::is_constructible<VT, Args...>>::value> * = nullptr>
-        explicit any(in_place_type_t<T> /*tag*/, Args &&... args) :
-            obj_(new Obj<VT>(in_place, std::forward<Args>(args)...)) {}
+        explicit any(in_place_type_t<T> /*tag*/, Args &&... args) : obj_(nullptr), is_inline_(false)
+        {
+            construct<VT>(std::forward<Args>(args)...);
+        }
 
         /// Constructs an `polymer::any` object with a "contained object" of the passed
         /// type `VT` as a decayed type of `T`. `VT` is initialized as if
@@ -292,8 +308,12 @@ namespace polymer
                                      std::is_constructible<VT, std::initializer_list<U> &,
                                                            Args...>>::value> * = nullptr>
         explicit any(in_place_type_t<T> /*tag*/, std::initializer_list<U> ilist,
-                     Args &&... args) :
-            obj_(new Obj<VT>(in_place, ilist, std::forward<Args>(args)...)) {}
+                     Args &&... args) : obj_(nullptr), is_inline_(false)
+        {
+            construct<VT>(ilist, std::forward<Args>(args)...);
+        }
+
+        ~any() { reset(); }
 
         // Assignment operators
 
@@ -308,7 +328,11 @@ namespace polymer
         /// passed type. `rhs` is left in a valid but otherwise unspecified state.
         any & operator=(any && rhs) noexcept
         {
-            any(std::move(rhs)).swap(*this);
+            if (this != &rhs)
+            {
+                reset();
+                move_from(std::move(rhs));
+            }
             return *this;
         }
 
@@ -340,9 +364,7 @@ namespace polymer
         VT & emplace(Args &&... args)
         {
             reset();  // NOTE: reset() is required here even in the world of exceptions.
-            Obj<VT> * const object_ptr = new Obj<VT>(in_place, std::forward<Args>(args)...);
-            obj_ = std::unique_ptr<ObjInterface>(object_ptr);
-            return object_ptr->value;
+            return construct<VT>(std::forward<Args>(args)...);
         }
 
         /// Overload of `any::emplace()` to emplace a value within an `polymer::any`
@@ -362,16 +384,26 @@ namespace polymer
         VT & emplace(std::initializer_list<U> ilist, Args &&... args)
         {
             reset();  // NOTE: reset() is required here even in the world of exceptions.
-            Obj<VT> * const object_ptr = new Obj<VT>(in_place, ilist, std::forward<Args>(args)...);
-            obj_ = std::unique_ptr<ObjInterface>(object_ptr);
-            return object_ptr->value;
+            return construct<VT>(ilist, std::forward<Args>(args)...);
         }
 
         /// Resets the state of the `polymer::any` object, destroying the contained object if present.
-        void reset() noexcept { obj_ = nullptr; }
+        void reset() noexcept
+        {
+            if (!obj_) return;
+            if (is_inline_) obj_->~ObjInterface();
+            else delete obj_;
+            obj_ = nullptr;
+            is_inline_ = false;
+        }
 
         /// Swaps the passed value and the value of this `polymer::any` object.
-        void swap(any & other) noexcept { obj_.swap(other.obj_); }
+        void swap(any & other) noexcept
+        {
+            any tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
 
         // Observers
 
@@ -387,11 +419,19 @@ namespace polymer
 
     private:
 
-        /// Tagged type-erased abstraction for holding a cloneable object.
+        /// Values whose wrapper fits in this many bytes (plus the wrapper vtable pointer)
+        /// are stored inline rather than on the heap.
+        static const size_t kInlineCapacity = 32;
+
+        /// Tagged type-erased abstraction for holding a cloneable object. The *Into
+        /// variants placement-construct the wrapper into caller-provided storage so the
+        /// small-buffer path can clone/move without touching the heap.
         struct ObjInterface
         {
             virtual ~ObjInterface() = default;
-            virtual std::unique_ptr<ObjInterface> Clone() const = 0;
+            virtual ObjInterface * Clone() const = 0;
+            virtual ObjInterface * CloneInto(void * storage) const = 0;
+            virtual ObjInterface * MoveInto(void * storage) noexcept = 0;
             virtual const void * ObjTypeId() const noexcept = 0;
             virtual const std::type_info & Type() const noexcept = 0;
         };
@@ -402,16 +442,72 @@ namespace polymer
         {
             template <typename... Args>
             explicit Obj(in_place_t /*tag*/, Args &&... args) : value(std::forward<Args>(args)...) {}
-            std::unique_ptr<ObjInterface> Clone() const final { return std::unique_ptr<ObjInterface>(new Obj(in_place, value)); }
+            ObjInterface * Clone() const final { return new Obj(in_place, value); }
+            ObjInterface * CloneInto(void * storage) const final { return new (storage) Obj(in_place, value); }
+            ObjInterface * MoveInto(void * storage) noexcept final { return new (storage) Obj(in_place, std::move(value)); }
             const void * ObjTypeId() const noexcept final { return IdForType<T>(); }
             const std::type_info & Type() const noexcept final { return typeid(T); }
             T value;
         };
 
-        std::unique_ptr<ObjInterface> CloneObj() const
+        /// A type is eligible for inline storage when its wrapper fits the buffer,
+        /// doesn't over-align it, and can be moved without throwing (so the `any`
+        /// move operations stay noexcept).
+        template <typename T>
+        struct UsesInlineStorage : std::integral_constant<bool,
+            sizeof(Obj<T>) <= sizeof(void *) + kInlineCapacity &&
+            alignof(Obj<T>) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible<T>::value> {};
+
+        template <typename VT, typename... Args>
+        typename std::enable_if<UsesInlineStorage<VT>::value, VT &>::type construct(Args &&... args)
         {
-            if (!obj_) return nullptr;
-            return obj_->Clone();
+            Obj<VT> * const object_ptr = new (buffer_) Obj<VT>(in_place, std::forward<Args>(args)...);
+            obj_ = object_ptr;
+            is_inline_ = true;
+            return object_ptr->value;
+        }
+
+        template <typename VT, typename... Args>
+        typename std::enable_if<!UsesInlineStorage<VT>::value, VT &>::type construct(Args &&... args)
+        {
+            Obj<VT> * const object_ptr = new Obj<VT>(in_place, std::forward<Args>(args)...);
+            obj_ = object_ptr;
+            is_inline_ = false;
+            return object_ptr->value;
+        }
+
+        /// Precondition for both: *this is empty
+        void copy_from(const any & other)
+        {
+            if (!other.obj_) return;
+            if (other.is_inline_)
+            {
+                obj_ = other.obj_->CloneInto(buffer_);
+                is_inline_ = true;
+            }
+            else
+            {
+                obj_ = other.obj_->Clone();
+                is_inline_ = false;
+            }
+        }
+
+        void move_from(any && other) noexcept
+        {
+            if (!other.obj_) return;
+            if (other.is_inline_)
+            {
+                obj_ = other.obj_->MoveInto(buffer_);
+                is_inline_ = true;
+                other.reset();
+            }
+            else
+            {
+                obj_ = other.obj_;
+                is_inline_ = false;
+                other.obj_ = nullptr;
+            }
         }
 
         template <typename T>
@@ -441,15 +537,15 @@ namespace polymer
         template <typename T>
         friend T * any_cast(any * operand) noexcept;
 
-        std::unique_ptr<ObjInterface> obj_;
+        ObjInterface * obj_;
+        bool is_inline_;
+        alignas(alignof(std::max_align_t)) unsigned char buffer_[sizeof(void *) + kInlineCapacity];
     };
 
     ////////////////////////////////
     //   Implementation Details   //
     ////////////////////////////////
 
-    constexpr any::any() noexcept = default;
-
     template <typename T>
     struct any::IsInPlaceType : std::false_type {};
 
@@ -502,14 +598,14 @@ namespace polymer
     const T * any_cast(const any * operand) noexcept
     {
         return operand && operand->GetObjTypeId() == 
-            any::IdForType<T>() ? std::addressof(static_cast<const any::Obj<T> *>(operand->obj_.get())->value) : nullptr;
+            any::IdForType<T>() ? std::addressof(static_cast<const any::Obj<T> *>(operand->obj_)->value) : nullptr;
     }
 
     template <typename T>
     T * any_cast(any * operand) noexcept
     {
         return operand && operand->GetObjTypeId() == 
-            any::IdForType<T>() ? std::addressof(static_cast<any::Obj<T> *>(operand->obj_.get())->value) : nullptr;
+            any::IdForType<T>() ? std::addressof(static_cast<any::Obj<T> *>(operand->obj_)->value) : nullptr;
     }
 
 }  // end namespace polymer
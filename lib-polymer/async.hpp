@@ -0,0 +1,283 @@
+#pragma once
+
+#ifndef polymer_async_hpp
+#define polymer_async_hpp
+
+#include "thread-pool.hpp"
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+namespace polymer
+{
+
+    //////////////////////////////
+    //   main_thread_executor   //
+    //////////////////////////////
+
+    // Queue of work destined for a specific thread — in the engine, the thread
+    // that owns the GL context. post() is safe from any thread; the owning thread
+    // calls drain() once per frame. The queue is swapped out before running, so a
+    // continuation that posts follow-up work defers it to the next drain instead
+    // of extending the current one.
+    class main_thread_executor
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> queue;
+
+        main_thread_executor() = default;
+        main_thread_executor(const main_thread_executor &) = delete;
+        main_thread_executor & operator = (const main_thread_executor &) = delete;
+
+    public:
+
+        static main_thread_executor & get()
+        {
+            static main_thread_executor executor;
+            return executor;
+        }
+
+        void post(std::function<void()> fn)
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            queue.push_back(std::move(fn));
+        }
+
+        // Runs everything posted before this call on the calling thread. Returns
+        // the number of items executed.
+        size_t drain()
+        {
+            std::deque<std::function<void()>> local;
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                local.swap(queue);
+            }
+            for (auto & fn : local) fn();
+            return local.size();
+        }
+
+        size_t size()
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            return queue.size();
+        }
+    };
+
+    ////////////////////
+    //   async_task   //
+    ////////////////////
+
+    // Chainable asynchronous value: `async_spawn(decode).then(process).then_on_main(upload)`
+    // replaces per-call-site callback plumbing. A `then` continuation runs inline on
+    // whichever thread completes the antecedent (continuation stealing — no re-submit,
+    // no thread hop); `then_on_main` routes the continuation through the
+    // main_thread_executor for work that must touch the GL context. Each stage holds
+    // at most one continuation, mirroring task_handle.
+
+    template<class T>
+    struct async_state
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool completed{ false };
+        T value;
+        std::function<void()> next;
+    };
+
+    template<>
+    struct async_state<void>
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool completed{ false };
+        std::function<void()> next;
+    };
+
+    namespace detail
+    {
+        // Completes `st` with the result of `produce()` and, if a continuation was
+        // already attached, runs it inline on this thread.
+        template<class R, class Produce>
+        void settle(const std::shared_ptr<async_state<R>> & st, Produce && produce)
+        {
+            R value = produce();
+            std::function<void()> continuation;
+            {
+                std::lock_guard<std::mutex> lk(st->mutex);
+                st->value = std::move(value);
+                st->completed = true;
+                continuation = std::move(st->next);
+            }
+            st->cv.notify_all();
+            if (continuation) continuation();
+        }
+
+        template<class Produce>
+        void settle(const std::shared_ptr<async_state<void>> & st, Produce && produce)
+        {
+            produce();
+            std::function<void()> continuation;
+            {
+                std::lock_guard<std::mutex> lk(st->mutex);
+                st->completed = true;
+                continuation = std::move(st->next);
+            }
+            st->cv.notify_all();
+            if (continuation) continuation();
+        }
+
+        // Attaches `run` to `st`: deferred if the antecedent is still in flight,
+        // otherwise executed immediately on the calling thread.
+        template<class S>
+        void attach(const std::shared_ptr<S> & st, std::function<void()> run)
+        {
+            std::unique_lock<std::mutex> lk(st->mutex);
+            if (st->completed)
+            {
+                lk.unlock();
+                run();
+            }
+            else st->next = std::move(run);
+        }
+    }
+
+    template<class T>
+    class async_task
+    {
+        std::shared_ptr<async_state<T>> state;
+
+        template<class F>
+        std::function<void()> make_runner(F && f, async_task<typename std::result_of<F(T &)>::type> & out)
+        {
+            using R = typename std::result_of<F(T &)>::type;
+            auto child = std::make_shared<async_state<R>>();
+            out = async_task<R>(child);
+            auto parent = state;
+            auto fn = std::make_shared<typename std::decay<F>::type>(std::forward<F>(f));
+            return [parent, child, fn]() { detail::settle(child, [&]() { return (*fn)(parent->value); }); };
+        }
+
+    public:
+
+        async_task() = default;
+        explicit async_task(std::shared_ptr<async_state<T>> st) : state(std::move(st)) {}
+
+        bool valid() const { return state != nullptr; }
+
+        bool ready() const
+        {
+            std::lock_guard<std::mutex> lk(state->mutex);
+            return state->completed;
+        }
+
+        T & get()
+        {
+            std::unique_lock<std::mutex> lk(state->mutex);
+            state->cv.wait(lk, [this] { return state->completed; });
+            return state->value;
+        }
+
+        // Continuation runs inline on the thread that completes this task
+        template<class F>
+        auto then(F && f) -> async_task<typename std::result_of<F(T &)>::type>
+        {
+            async_task<typename std::result_of<F(T &)>::type> result;
+            detail::attach(state, make_runner(std::forward<F>(f), result));
+            return result;
+        }
+
+        // Continuation runs on the next main_thread_executor drain
+        template<class F>
+        auto then_on_main(F && f) -> async_task<typename std::result_of<F(T &)>::type>
+        {
+            async_task<typename std::result_of<F(T &)>::type> result;
+            auto run = make_runner(std::forward<F>(f), result);
+            detail::attach(state, [run]() { main_thread_executor::get().post(run); });
+            return result;
+        }
+    };
+
+    template<>
+    class async_task<void>
+    {
+        std::shared_ptr<async_state<void>> state;
+
+        template<class F>
+        std::function<void()> make_runner(F && f, async_task<typename std::result_of<F()>::type> & out)
+        {
+            using R = typename std::result_of<F()>::type;
+            auto child = std::make_shared<async_state<R>>();
+            out = async_task<R>(child);
+            auto fn = std::make_shared<typename std::decay<F>::type>(std::forward<F>(f));
+            return [child, fn]() { detail::settle(child, [&]() { return (*fn)(); }); };
+        }
+
+    public:
+
+        async_task() = default;
+        explicit async_task(std::shared_ptr<async_state<void>> st) : state(std::move(st)) {}
+
+        bool valid() const { return state != nullptr; }
+
+        bool ready() const
+        {
+            std::lock_guard<std::mutex> lk(state->mutex);
+            return state->completed;
+        }
+
+        void get()
+        {
+            std::unique_lock<std::mutex> lk(state->mutex);
+            state->cv.wait(lk, [this] { return state->completed; });
+        }
+
+        template<class F>
+        auto then(F && f) -> async_task<typename std::result_of<F()>::type>
+        {
+            async_task<typename std::result_of<F()>::type> result;
+            detail::attach(state, make_runner(std::forward<F>(f), result));
+            return result;
+        }
+
+        template<class F>
+        auto then_on_main(F && f) -> async_task<typename std::result_of<F()>::type>
+        {
+            async_task<typename std::result_of<F()>::type> result;
+            auto run = make_runner(std::forward<F>(f), result);
+            detail::attach(state, [run]() { main_thread_executor::get().post(run); });
+            return result;
+        }
+    };
+
+    // Runs `f` on a thread-pool worker and returns the task heading the chain
+    template<class F>
+    auto async_spawn(F && f) -> async_task<typename std::result_of<F()>::type>
+    {
+        using R = typename std::result_of<F()>::type;
+        auto st = std::make_shared<async_state<R>>();
+        auto fn = std::make_shared<typename std::decay<F>::type>(std::forward<F>(f));
+        get_task_scheduler().submit([st, fn]() { detail::settle(st, [&]() { return (*fn)(); }); });
+        return async_task<R>(st);
+    }
+
+    // Already-completed tasks, for code paths that can answer synchronously
+    template<class T>
+    async_task<typename std::decay<T>::type> make_ready_task(T && value)
+    {
+        auto st = std::make_shared<async_state<typename std::decay<T>::type>>();
+        st->value = std::forward<T>(value);
+        st->completed = true;
+        return async_task<typename std::decay<T>::type>(st);
+    }
+
+    inline async_task<void> make_ready_task()
+    {
+        auto st = std::make_shared<async_state<void>>();
+        st->completed = true;
+        return async_task<void>(st);
+    }
+
+} // end namespace polymer
+
+#endif // end polymer_async_hpp
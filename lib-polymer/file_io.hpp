@@ -8,10 +8,122 @@
 #include <string>
 #include <fstream>
 #include <streambuf>
+#include <cstdint>
+#include <utility>
+
+#if (defined(_WIN64) || defined(_WIN32) || defined(__CYGWIN32__) || defined(__MINGW32__))
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 namespace polymer
 {
-    
+
+    // Read-only memory-mapped view of a file. The view aliases the OS page cache
+    // directly, so parsers can consume large files without first copying every
+    // byte into a freshly-allocated vector (what read_file_binary does). The
+    // mapping is released when the object goes out of scope. Move-only; the view
+    // pointer must not outlive the mapped_file that produced it.
+    class mapped_file
+    {
+        const uint8_t * view{ nullptr };
+        size_t length{ 0 };
+
+        #if (defined(_WIN64) || defined(_WIN32) || defined(__CYGWIN32__) || defined(__MINGW32__))
+        HANDLE file{ INVALID_HANDLE_VALUE };
+        HANDLE mapping{ nullptr };
+        #else
+        int file{ -1 };
+        #endif
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file & operator = (const mapped_file &) = delete;
+
+        void close()
+        {
+            #if (defined(_WIN64) || defined(_WIN32) || defined(__CYGWIN32__) || defined(__MINGW32__))
+            if (view) UnmapViewOfFile((LPCVOID) view);
+            if (mapping) CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+            mapping = nullptr;
+            #else
+            if (view) munmap((void *) view, length);
+            if (file != -1) ::close(file);
+            file = -1;
+            #endif
+            view = nullptr;
+            length = 0;
+        }
+
+    public:
+
+        mapped_file(const std::string & pathToFile)
+        {
+            #if (defined(_WIN64) || defined(_WIN32) || defined(__CYGWIN32__) || defined(__MINGW32__))
+            file = CreateFileA(pathToFile.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("could not open file mapping to path " + pathToFile);
+
+            LARGE_INTEGER sizeBytes;
+            if (!GetFileSizeEx(file, &sizeBytes)) { close(); throw std::runtime_error("could not stat file at path " + pathToFile); }
+            length = static_cast<size_t>(sizeBytes.QuadPart);
+            if (length == 0) return; // zero-length files cannot be mapped; empty view is valid
+
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) { close(); throw std::runtime_error("could not create file mapping for path " + pathToFile); }
+
+            view = reinterpret_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!view) { close(); throw std::runtime_error("could not map view of file at path " + pathToFile); }
+            #else
+            file = ::open(pathToFile.c_str(), O_RDONLY);
+            if (file == -1) throw std::runtime_error("could not open file mapping to path " + pathToFile);
+
+            struct stat fileStat;
+            if (fstat(file, &fileStat) == -1) { close(); throw std::runtime_error("could not stat file at path " + pathToFile); }
+            length = static_cast<size_t>(fileStat.st_size);
+            if (length == 0) return;
+
+            void * mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapped == MAP_FAILED) { close(); throw std::runtime_error("could not map view of file at path " + pathToFile); }
+            view = reinterpret_cast<const uint8_t *>(mapped);
+            #endif
+        }
+
+        mapped_file(mapped_file && r) { *this = std::move(r); }
+        mapped_file & operator = (mapped_file && r)
+        {
+            close();
+            view = r.view; length = r.length; file = r.file;
+            #if (defined(_WIN64) || defined(_WIN32) || defined(__CYGWIN32__) || defined(__MINGW32__))
+            mapping = r.mapping;
+            r.mapping = nullptr;
+            r.file = INVALID_HANDLE_VALUE;
+            #else
+            r.file = -1;
+            #endif
+            r.view = nullptr;
+            r.length = 0;
+            return *this;
+        }
+
+        ~mapped_file() { close(); }
+
+        const uint8_t * data() const { return view; }
+        size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+    };
+
+
     inline std::vector<uint8_t> read_file_binary(const std::string & pathToFile)
     {
         std::ifstream file(pathToFile, std::ios::binary);
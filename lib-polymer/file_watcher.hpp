@@ -0,0 +1,193 @@
+#pragma once
+
+#ifndef file_watcher_hpp
+#define file_watcher_hpp
+
+#include "file_io.hpp" // platform headers (windows.h / unistd.h) come via the guarded block here
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if (defined(_WIN64) || defined(_WIN32) || defined(__CYGWIN32__) || defined(__MINGW32__))
+    // ReadDirectoryChangesW backend
+#else
+    #include <sys/inotify.h>
+    #include <poll.h>
+    #include <dirent.h>
+#endif
+
+namespace polymer
+{
+
+    // Recursive directory watcher built on OS change notifications
+    // (ReadDirectoryChangesW / inotify) instead of timestamp polling, so the
+    // cost of watching is proportional to the number of changes rather than
+    // the size of the tree. A background thread accumulates changed paths
+    // (forward-slash normalized, rooted at the watched directory) into a dirty
+    // set; consumers call drain_changes() at their own cadence. Create,
+    // modify, delete and rename all report the affected path.
+    class file_watcher
+    {
+        std::string root;
+        std::thread watch_thread;
+        std::atomic<bool> should_exit{ false };
+
+        std::mutex mutex;
+        std::vector<std::string> changes;
+
+        file_watcher(const file_watcher &) = delete;
+        file_watcher & operator = (const file_watcher &) = delete;
+
+        void record_change(std::string path)
+        {
+            for (auto & chr : path) if (chr == '\\') chr = '/';
+            std::lock_guard<std::mutex> guard(mutex);
+            changes.push_back(std::move(path));
+        }
+
+        #if (defined(_WIN64) || defined(_WIN32) || defined(__CYGWIN32__) || defined(__MINGW32__))
+
+        void run()
+        {
+            HANDLE directory = CreateFileA(root.c_str(), FILE_LIST_DIRECTORY,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+            if (directory == INVALID_HANDLE_VALUE) return;
+
+            OVERLAPPED overlapped = {};
+            overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+            std::vector<uint8_t> buffer(64 * 1024);
+
+            while (!should_exit)
+            {
+                ResetEvent(overlapped.hEvent);
+
+                const BOOL ok = ReadDirectoryChangesW(directory, buffer.data(), DWORD(buffer.size()), TRUE,
+                    FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+                    nullptr, &overlapped, nullptr);
+                if (!ok) break;
+
+                // Wake periodically so destruction doesn't hang on a quiet tree
+                while (!should_exit && WaitForSingleObject(overlapped.hEvent, 250) == WAIT_TIMEOUT) {}
+                if (should_exit) { CancelIo(directory); break; }
+
+                DWORD bytes = 0;
+                if (!GetOverlappedResult(directory, &overlapped, &bytes, FALSE) || bytes == 0) continue;
+
+                size_t offset = 0;
+                for (;;)
+                {
+                    const FILE_NOTIFY_INFORMATION * info = reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(buffer.data() + offset);
+
+                    const int narrowLength = WideCharToMultiByte(CP_UTF8, 0, info->FileName, int(info->FileNameLength / sizeof(WCHAR)), nullptr, 0, nullptr, nullptr);
+                    std::string relativePath(narrowLength, '\0');
+                    WideCharToMultiByte(CP_UTF8, 0, info->FileName, int(info->FileNameLength / sizeof(WCHAR)), &relativePath[0], narrowLength, nullptr, nullptr);
+
+                    record_change(root + "/" + relativePath);
+
+                    if (info->NextEntryOffset == 0) break;
+                    offset += info->NextEntryOffset;
+                }
+            }
+
+            CloseHandle(overlapped.hEvent);
+            CloseHandle(directory);
+        }
+
+        #else
+
+        void add_watch_recursive(const int fd, const std::string & directory, std::unordered_map<int, std::string> & watch_to_dir)
+        {
+            const int wd = inotify_add_watch(fd, directory.c_str(),
+                IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM);
+            if (wd >= 0) watch_to_dir[wd] = directory;
+
+            if (DIR * dir = opendir(directory.c_str()))
+            {
+                while (dirent * entry = readdir(dir))
+                {
+                    if (entry->d_type != DT_DIR) continue;
+                    const std::string name = entry->d_name;
+                    if (name == "." || name == "..") continue;
+                    add_watch_recursive(fd, directory + "/" + name, watch_to_dir);
+                }
+                closedir(dir);
+            }
+        }
+
+        void run()
+        {
+            const int fd = inotify_init1(IN_NONBLOCK);
+            if (fd < 0) return;
+
+            std::unordered_map<int, std::string> watch_to_dir;
+            add_watch_recursive(fd, root, watch_to_dir);
+
+            std::vector<uint8_t> buffer(64 * 1024);
+
+            while (!should_exit)
+            {
+                pollfd pfd = { fd, POLLIN, 0 };
+                if (poll(&pfd, 1, 250) <= 0) continue;
+
+                const ssize_t length = ::read(fd, buffer.data(), buffer.size());
+                if (length <= 0) continue;
+
+                ssize_t offset = 0;
+                while (offset < length)
+                {
+                    const inotify_event * event = reinterpret_cast<const inotify_event *>(buffer.data() + offset);
+
+                    auto dir = watch_to_dir.find(event->wd);
+                    if (dir != watch_to_dir.end() && event->len > 0)
+                    {
+                        const std::string path = dir->second + "/" + event->name;
+                        record_change(path);
+
+                        // New subdirectories must be watched as they appear
+                        if ((event->mask & IN_CREATE) && (event->mask & IN_ISDIR)) add_watch_recursive(fd, path, watch_to_dir);
+                    }
+
+                    offset += sizeof(inotify_event) + event->len;
+                }
+            }
+
+            for (auto & watch : watch_to_dir) inotify_rm_watch(fd, watch.first);
+            ::close(fd);
+        }
+
+        #endif
+
+    public:
+
+        file_watcher(const std::string & root_path) : root(root_path)
+        {
+            while (!root.empty() && (root.back() == '/' || root.back() == '\\')) root.pop_back();
+            watch_thread = std::thread([this]() { run(); });
+        }
+
+        ~file_watcher()
+        {
+            should_exit = true;
+            if (watch_thread.joinable()) watch_thread.join();
+        }
+
+        // Swaps out the accumulated dirty set. Paths may repeat if a file
+        // changed several times since the last drain.
+        std::vector<std::string> drain_changes()
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            std::vector<std::string> result;
+            result.swap(changes);
+            return result;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end file_watcher_hpp
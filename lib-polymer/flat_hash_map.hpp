@@ -0,0 +1,206 @@
+#pragma once
+
+#ifndef polymer_flat_hash_map_hpp
+#define polymer_flat_hash_map_hpp
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace polymer
+{
+    ///////////////////////
+    //   flat_hash_map   //
+    ///////////////////////
+
+    // Open-addressing hash map with robin-hood probing and backward-shift
+    // deletion. Slots live in one contiguous array, so lookups touch a single
+    // cache line instead of chasing std::unordered_map's per-node allocations —
+    // the difference that matters on per-frame paths (asset tables, system
+    // registries) where the same few keys are hit thousands of times.
+    //
+    // Constraints relative to unordered_map: values must be default-constructible
+    // and movable, iteration order is unspecified, and pointers/iterators into the
+    // table are invalidated by any insertion (rehash moves elements). Do not use
+    // it where node stability is relied upon, e.g. component pools whose element
+    // addresses are cached across frames.
+    template<class K, class V, class Hash = std::hash<K>>
+    class flat_hash_map
+    {
+        static constexpr uint8_t kEmpty = 0xff;
+        static constexpr uint8_t kMaxProbe = 0xfe;
+
+        struct slot
+        {
+            std::pair<K, V> kv;
+            uint8_t dist{ kEmpty }; // probe distance from the key's home slot
+        };
+
+        std::vector<slot> slots;
+        size_t occupied{ 0 };
+        size_t mask{ 0 };
+
+        // Integer keys are often poorly distributed (sequential ids, pointers);
+        // a final avalanche keeps the probe sequences short regardless.
+        static size_t mix(size_t h)
+        {
+            uint64_t x = static_cast<uint64_t>(h);
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            return static_cast<size_t>(x);
+        }
+
+        size_t home_slot(const K & key) const { return mix(Hash{}(key)) & mask; }
+
+        void grow()
+        {
+            std::vector<slot> previous;
+            previous.swap(slots);
+            slots.resize(previous.empty() ? 16 : previous.size() * 2);
+            mask = slots.size() - 1;
+            occupied = 0;
+            for (slot & s : previous)
+            {
+                if (s.dist != kEmpty) insert_slot(std::move(s.kv));
+            }
+        }
+
+        // Places kv (a key known to be absent) and returns its final slot index
+        size_t insert_slot(std::pair<K, V> && kv)
+        {
+            size_t index = home_slot(kv.first);
+            uint8_t dist = 0;
+            size_t result = size_t(-1);
+            bool placed = false;
+
+            while (true)
+            {
+                if (dist >= kMaxProbe)
+                {
+                    // Pathological clustering; grow and retry from scratch
+                    grow();
+                    return insert_slot(std::move(kv));
+                }
+
+                slot & s = slots[index];
+                if (s.dist == kEmpty)
+                {
+                    s.kv = std::move(kv);
+                    s.dist = dist;
+                    ++occupied;
+                    return placed ? result : index;
+                }
+
+                // Rich element found a poorer one: swap so no key probes much
+                // further than any other (the robin-hood invariant)
+                if (s.dist < dist)
+                {
+                    std::swap(s.kv, kv);
+                    std::swap(s.dist, dist);
+                    if (!placed) { result = index; placed = true; }
+                }
+
+                index = (index + 1) & mask;
+                ++dist;
+            }
+        }
+
+    public:
+
+        class iterator
+        {
+            slot * current{ nullptr };
+            slot * last{ nullptr };
+            friend class flat_hash_map;
+            iterator(slot * c, slot * l) : current(c), last(l) { while (current != last && current->dist == kEmpty) ++current; }
+
+        public:
+
+            iterator() = default;
+            std::pair<K, V> & operator * () const { return current->kv; }
+            std::pair<K, V> * operator -> () const { return &current->kv; }
+            iterator & operator ++ () { ++current; while (current != last && current->dist == kEmpty) ++current; return *this; }
+            bool operator == (const iterator & r) const { return current == r.current; }
+            bool operator != (const iterator & r) const { return current != r.current; }
+        };
+
+        flat_hash_map() = default;
+
+        iterator begin() { return iterator(slots.data(), slots.data() + slots.size()); }
+        iterator end() { return iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+
+        size_t size() const { return occupied; }
+        bool empty() const { return occupied == 0; }
+
+        void clear()
+        {
+            for (slot & s : slots) { if (s.dist != kEmpty) { s.kv = std::pair<K, V>(); s.dist = kEmpty; } }
+            occupied = 0;
+        }
+
+        iterator find(const K & key)
+        {
+            if (slots.empty()) return end();
+            size_t index = home_slot(key);
+            uint8_t dist = 0;
+            while (true)
+            {
+                const slot & s = slots[index];
+                if (s.dist == kEmpty || s.dist < dist) return end(); // a present key would have displaced this slot
+                if (s.kv.first == key) return iterator(slots.data() + index, slots.data() + slots.size());
+                index = (index + 1) & mask;
+                ++dist;
+            }
+        }
+
+        size_t count(const K & key) { return find(key) != end() ? 1 : 0; }
+
+        template<class... Args>
+        std::pair<iterator, bool> emplace(const K & key, Args &&... args)
+        {
+            iterator existing = find(key);
+            if (existing != end()) return { existing, false };
+            if (slots.empty() || occupied + 1 > (slots.size() * 3) / 4) grow();
+            const size_t index = insert_slot(std::make_pair(key, V(std::forward<Args>(args)...)));
+            return { iterator(slots.data() + index, slots.data() + slots.size()), true };
+        }
+
+        V & operator [] (const K & key)
+        {
+            return emplace(key).first->second;
+        }
+
+        void erase(const iterator & it)
+        {
+            size_t index = static_cast<size_t>(it.current - slots.data());
+            while (true)
+            {
+                const size_t next = (index + 1) & mask;
+                if (slots[next].dist == kEmpty || slots[next].dist == 0)
+                {
+                    slots[index].kv = std::pair<K, V>();
+                    slots[index].dist = kEmpty;
+                    break;
+                }
+                // Backward shift: pull the displaced neighbour one slot closer to home
+                slots[index].kv = std::move(slots[next].kv);
+                slots[index].dist = slots[next].dist - 1;
+                index = next;
+            }
+            --occupied;
+        }
+
+        size_t erase(const K & key)
+        {
+            iterator it = find(key);
+            if (it == end()) return 0;
+            erase(it);
+            return 1;
+        }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_flat_hash_map_hpp
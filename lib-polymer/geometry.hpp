@@ -4,6 +4,19 @@
 #define polymer_geometry_hpp
 
 #include "math-core.hpp"
+#include "thread-pool.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POLYMER_GEOMETRY_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace polymer
 {
@@ -38,6 +51,34 @@ namespace polymer
         return bounds;
     }
 
+    namespace geometry_impl
+    {
+        // safe_normalize over SoA arrays, four at a time: sqrt, max(1e-6), divide - the same
+        // operations in the same order as the scalar version, so results are bit-identical
+        inline void safe_normalize_soa(float * x, float * y, float * z, const size_t count)
+        {
+            size_t i = 0;
+#if defined(POLYMER_GEOMETRY_SSE2)
+            const __m128 epsilon = _mm_set1_ps(1e-6f);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 vx = _mm_loadu_ps(x + i);
+                const __m128 vy = _mm_loadu_ps(y + i);
+                const __m128 vz = _mm_loadu_ps(z + i);
+                const __m128 len = _mm_max_ps(epsilon, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_add_ps(_mm_mul_ps(vy, vy), _mm_mul_ps(vz, vz)))));
+                _mm_storeu_ps(x + i, _mm_div_ps(vx, len));
+                _mm_storeu_ps(y + i, _mm_div_ps(vy, len));
+                _mm_storeu_ps(z + i, _mm_div_ps(vz, len));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                const float len = std::max(1e-6f, std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]));
+                x[i] /= len; y[i] /= len; z[i] /= len;
+            }
+        }
+    }
+
     // Lengyel, Eric. "Computing Tangent Space Basis Vectors for an Arbitrary Mesh".
     // Terathon Software 3D Graphics Library, 2001.
     inline void compute_tangents(geometry & g)
@@ -45,8 +86,11 @@ namespace polymer
         g.tangents.resize(g.vertices.size());
         g.bitangents.resize(g.vertices.size());
 
-        // Each face
-        for (size_t i = 0; i < g.faces.size(); ++i)
+        const size_t faceCount = g.faces.size();
+
+        // Per-face tangents into SoA scratch, parallel over triangle ranges
+        std::vector<float> ftx(faceCount), fty(faceCount), ftz(faceCount);
+        parallel_for(0, faceCount, 8192, [&g, &ftx, &fty, &ftz](size_t i)
         {
             uint3 face = g.faces[i];
 
@@ -75,16 +119,23 @@ namespace polymer
             if (r != 0.0f) r = 1.0f / r;
 
             // Tangent in the S direction
-            const float3 tangent((t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r);
+            ftx[i] = (t2 * x1 - t1 * x2) * r;
+            fty[i] = (t2 * y1 - t1 * y2) * r;
+            ftz[i] = (t2 * z1 - t1 * z2) * r;
+        });
 
-            // Accumulate
+        // Scatter into vertices serially in face order - the reduction stays deterministic
+        for (size_t i = 0; i < faceCount; ++i)
+        {
+            const uint3 & face = g.faces[i];
+            const float3 tangent(ftx[i], fty[i], ftz[i]);
             g.tangents[face.x] += tangent;
             g.tangents[face.y] += tangent;
             g.tangents[face.z] += tangent;
         }
 
-        // Tangents
-        for (size_t i = 0; i < g.vertices.size(); ++i)
+        // Tangents (per-vertex, no cross-vertex dependencies)
+        parallel_for(0, g.vertices.size(), 4096, [&g](size_t i)
         {
             const float3 normal = g.normals[i];
             const float3 tangent = g.tangents[i];
@@ -95,13 +146,13 @@ namespace polymer
             const float len = length(g.tangents[i]);
 
             if (len > 0.0f) g.tangents[i] = g.tangents[i] / (float)sqrt(len);
-        }
+        });
 
-        // Bitangents 
-        for (size_t i = 0; i < g.vertices.size(); ++i)
+        // Bitangents
+        parallel_for(0, g.vertices.size(), 4096, [&g](size_t i)
         {
             g.bitangents[i] = safe_normalize(cross(g.normals[i], g.tangents[i]));
-        }
+        });
     }
 
     inline void compute_normals(geometry & g, bool smooth = true)
@@ -121,26 +172,32 @@ namespace polymer
                 {
                     uniqueVertIndices[i] = i + 1;
                     const float3 v0 = g.vertices[i];
-                    for (auto j = i + 1; j < g.vertices.size(); ++j)
+                    const uint32_t uniqueIndex = uniqueVertIndices[i];
+                    // Each j writes only its own slot, so the scan parallelizes cleanly
+                    parallel_for(i + 1, g.vertices.size(), 4096, [&g, &uniqueVertIndices, v0, uniqueIndex](size_t j)
                     {
                         const float3 v1 = g.vertices[j];
                         if (length2(v1 - v0) < NORMAL_EPSILON)
                         {
-                            uniqueVertIndices[j] = uniqueVertIndices[i];
+                            uniqueVertIndices[j] = uniqueIndex;
                         }
-                    }
+                    });
                 }
             }
         }
 
-        uint32_t idx0, idx1, idx2;
-        for (size_t i = 0; i < g.faces.size(); ++i)
+        const size_t faceCount = g.faces.size();
+
+        // Unnormalized face normals into SoA scratch, parallel over triangle ranges;
+        // degenerate faces contribute zero (matching the old `continue`)
+        std::vector<float> fnx(faceCount), fny(faceCount), fnz(faceCount);
+        parallel_for(0, faceCount, 4096, [&](size_t i)
         {
             const auto & f = g.faces[i];
 
-            idx0 = (smooth) ? uniqueVertIndices[f.x] - 1 : f.x;
-            idx1 = (smooth) ? uniqueVertIndices[f.y] - 1 : f.y;
-            idx2 = (smooth) ? uniqueVertIndices[f.z] - 1 : f.z;
+            const uint32_t idx0 = (smooth) ? uniqueVertIndices[f.x] - 1 : f.x;
+            const uint32_t idx1 = (smooth) ? uniqueVertIndices[f.y] - 1 : f.y;
+            const uint32_t idx2 = (smooth) ? uniqueVertIndices[f.z] - 1 : f.z;
 
             const float3 v0 = g.vertices[idx0];
             const float3 v1 = g.vertices[idx1];
@@ -150,27 +207,40 @@ namespace polymer
             float3 e1 = v2 - v0;
             float3 e2 = v2 - v1;
 
-            if (length2(e0) < NORMAL_EPSILON) continue;
-            if (length2(e1) < NORMAL_EPSILON) continue;
-            if (length2(e2) < NORMAL_EPSILON) continue;
+            fnx[i] = 0.f; fny[i] = 0.f; fnz[i] = 0.f;
+            if (length2(e0) < NORMAL_EPSILON) return;
+            if (length2(e1) < NORMAL_EPSILON) return;
+            if (length2(e2) < NORMAL_EPSILON) return;
 
-            const float3 n = safe_normalize(cross(e0, e1));
+            const float3 n = cross(e0, e1);
+            fnx[i] = n.x; fny[i] = n.y; fnz[i] = n.z;
+        });
 
+        geometry_impl::safe_normalize_soa(fnx.data(), fny.data(), fnz.data(), faceCount);
+
+        // Scatter into vertices serially in face order - the reduction stays deterministic
+        for (size_t i = 0; i < faceCount; ++i)
+        {
+            const auto & f = g.faces[i];
+            const float3 n(fnx[i], fny[i], fnz[i]);
             g.normals[f.x] += n;
             g.normals[f.y] += n;
             g.normals[f.z] += n;
+        }
 
-            // Copy normals for non-unique verts
-            if (smooth)
+        // Copy normals for non-unique verts. This used to run inside the face loop
+        // (O(faces * vertices)); representative slots are never modified by the copy, so
+        // doing it once after accumulation produces identical values.
+        if (smooth)
+        {
+            parallel_for(0, g.vertices.size(), 4096, [&](size_t i)
             {
-                for (uint32_t i = 0; i < g.vertices.size(); ++i)
-                {
-                    g.normals[i] = g.normals[uniqueVertIndices[i] - 1];
-                }
-            }
+                const uint32_t rep = uniqueVertIndices[i] - 1;
+                if (rep != i) g.normals[i] = g.normals[rep]; // representative slots are read-only here
+            });
         }
 
-        for (auto & n : g.normals) n = safe_normalize(n);
+        parallel_for(0, g.normals.size(), 4096, [&g](size_t i) { g.normals[i] = safe_normalize(g.normals[i]); });
     }
 
     inline void rescale_geometry(runtime_mesh & g, float radius = 1.0f)
@@ -209,6 +279,98 @@ namespace polymer
         }
     }
 
+    // Merges vertices whose positions lie within `epsilon` of each other and whose other
+    // authored attributes (normals, colors, uvs, tangents) also agree within `epsilon`,
+    // rewriting faces to share the surviving vertex. Corners that genuinely differ - a
+    // hard-edge normal, a uv seam - are left alone, so welding never flattens shading
+    // that was authored per-face on purpose. Candidates are bucketed on an epsilon-sized
+    // grid, so the pass is O(vertices) rather than all-pairs.
+    inline void weld_vertices(geometry & g, const float epsilon = 1e-4f)
+    {
+        const size_t vertexCount = g.vertices.size();
+        if (vertexCount == 0) return;
+
+        const bool hasNormals    = g.normals.size() == vertexCount;
+        const bool hasColors     = g.colors.size() == vertexCount;
+        const bool hasTexcoord0  = g.texcoord0.size() == vertexCount;
+        const bool hasTexcoord1  = g.texcoord1.size() == vertexCount;
+        const bool hasTangents   = g.tangents.size() == vertexCount;
+        const bool hasBitangents = g.bitangents.size() == vertexCount;
+
+        const float sqEpsilon = epsilon * epsilon;
+        const float invEpsilon = 1.f / epsilon;
+
+        auto bucket_key = [](const int64_t x, const int64_t y, const int64_t z) -> uint64_t
+        {
+            return static_cast<uint64_t>(x) * 73856093ull ^ static_cast<uint64_t>(y) * 19349663ull ^ static_cast<uint64_t>(z) * 83492791ull;
+        };
+
+        std::unordered_map<uint64_t, std::vector<uint32_t>> buckets; // key -> indices into the welded arrays
+        buckets.reserve(vertexCount);
+
+        geometry welded;
+        std::vector<uint32_t> remap(vertexCount);
+
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            const float3 & p = g.vertices[i];
+            const int64_t cx = static_cast<int64_t>(std::floor(p.x * invEpsilon));
+            const int64_t cy = static_cast<int64_t>(std::floor(p.y * invEpsilon));
+            const int64_t cz = static_cast<int64_t>(std::floor(p.z * invEpsilon));
+
+            uint32_t match = ~0u;
+            for (int64_t dz = -1; dz <= 1 && match == ~0u; ++dz)
+            {
+                for (int64_t dy = -1; dy <= 1 && match == ~0u; ++dy)
+                {
+                    for (int64_t dx = -1; dx <= 1 && match == ~0u; ++dx)
+                    {
+                        const auto bucket = buckets.find(bucket_key(cx + dx, cy + dy, cz + dz));
+                        if (bucket == buckets.end()) continue;
+
+                        for (const uint32_t candidate : bucket->second)
+                        {
+                            if (length2(p - welded.vertices[candidate]) > sqEpsilon) continue;
+                            if (hasNormals    && length2(g.normals[i]    - welded.normals[candidate])    > sqEpsilon) continue;
+                            if (hasColors     && length2(g.colors[i]     - welded.colors[candidate])     > sqEpsilon) continue;
+                            if (hasTexcoord0  && length2(g.texcoord0[i]  - welded.texcoord0[candidate])  > sqEpsilon) continue;
+                            if (hasTexcoord1  && length2(g.texcoord1[i]  - welded.texcoord1[candidate])  > sqEpsilon) continue;
+                            if (hasTangents   && length2(g.tangents[i]   - welded.tangents[candidate])   > sqEpsilon) continue;
+                            if (hasBitangents && length2(g.bitangents[i] - welded.bitangents[candidate]) > sqEpsilon) continue;
+                            match = candidate;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (match == ~0u)
+            {
+                match = static_cast<uint32_t>(welded.vertices.size());
+                welded.vertices.push_back(p);
+                if (hasNormals)    welded.normals.push_back(g.normals[i]);
+                if (hasColors)     welded.colors.push_back(g.colors[i]);
+                if (hasTexcoord0)  welded.texcoord0.push_back(g.texcoord0[i]);
+                if (hasTexcoord1)  welded.texcoord1.push_back(g.texcoord1[i]);
+                if (hasTangents)   welded.tangents.push_back(g.tangents[i]);
+                if (hasBitangents) welded.bitangents.push_back(g.bitangents[i]);
+                buckets[bucket_key(cx, cy, cz)].push_back(match);
+            }
+
+            remap[i] = match;
+        }
+
+        g.vertices   = std::move(welded.vertices);
+        g.normals    = std::move(welded.normals);
+        g.colors     = std::move(welded.colors);
+        g.texcoord0  = std::move(welded.texcoord0);
+        g.texcoord1  = std::move(welded.texcoord1);
+        g.tangents   = std::move(welded.tangents);
+        g.bitangents = std::move(welded.bitangents);
+
+        for (auto & f : g.faces) f = uint3(remap[f.x], remap[f.y], remap[f.z]);
+    }
+
     // warning: only accounts for vertices and faces
     inline geometry concatenate_geometry(const geometry & a, const geometry & b)
     {
@@ -220,6 +382,166 @@ namespace polymer
         return s;
     }
 
+    //////////////////
+    //   mesh bvh   //
+    //////////////////
+
+    // Binary BVH over mesh triangles, median-split on the longest centroid axis with a packed
+    // 32-byte node layout. Built once per mesh (see get_mesh_bvh below) and traversed by
+    // intersect_ray_mesh, which turns picking against large meshes from a linear walk over
+    // every face into a handful of box tests.
+    struct mesh_bvh
+    {
+        static const uint32_t leaf_size = 4;
+
+        struct bvh_node
+        {
+            float3 boundsMin; uint32_t leftOrFirst; // internal: left child index (right is left + 1); leaf: first primitive
+            float3 boundsMax; uint32_t count;       // leaf triangle count; 0 marks an internal node
+        };
+
+        std::vector<bvh_node> nodes;
+        std::vector<uint32_t> primitives; // face indices, re-ordered during the build
+
+        void build(const geometry & mesh)
+        {
+            const uint32_t faceCount = static_cast<uint32_t>(mesh.faces.size());
+
+            primitives.resize(faceCount);
+            std::iota(primitives.begin(), primitives.end(), 0);
+
+            std::vector<float3> centroids(faceCount);
+            for (uint32_t f = 0; f < faceCount; ++f)
+            {
+                const uint3 & tri = mesh.faces[f];
+                centroids[f] = (mesh.vertices[tri.x] + mesh.vertices[tri.y] + mesh.vertices[tri.z]) / 3.f;
+            }
+
+            nodes.clear();
+            nodes.reserve(faceCount * 2);
+            nodes.emplace_back();
+            if (faceCount) subdivide(mesh, centroids, 0, 0, faceCount, 0);
+        }
+
+        bool intersect(const ray & r, const geometry & mesh, float * outT, uint32_t * outFace, float2 * outUv) const
+        {
+            if (nodes.empty()) return false;
+
+            float best_t = std::numeric_limits<float>::infinity(), t;
+            uint32_t best_face = 0;
+            float2 uv, best_uv;
+
+            uint32_t stack[64];
+            uint32_t stackSize = 0;
+            stack[stackSize++] = 0;
+
+            while (stackSize)
+            {
+                const bvh_node & node = nodes[stack[--stackSize]];
+
+                float tmin;
+                if (!intersect_ray_box(r, node.boundsMin, node.boundsMax, &tmin)) continue;
+                if (tmin > best_t) continue;
+
+                if (node.count) // leaf
+                {
+                    for (uint32_t i = 0; i < node.count; ++i)
+                    {
+                        const uint32_t f = primitives[node.leftOrFirst + i];
+                        const uint3 & tri = mesh.faces[f];
+                        if (intersect_ray_triangle(r, mesh.vertices[tri.x], mesh.vertices[tri.y], mesh.vertices[tri.z], &t, &uv) && t < best_t)
+                        {
+                            best_t = t;
+                            best_face = f;
+                            best_uv = uv;
+                        }
+                    }
+                }
+                else
+                {
+                    stack[stackSize++] = node.leftOrFirst;
+                    stack[stackSize++] = node.leftOrFirst + 1;
+                }
+            }
+
+            if (best_t == std::numeric_limits<float>::infinity()) return false;
+
+            if (outT) *outT = best_t;
+            if (outFace) *outFace = best_face;
+            if (outUv) *outUv = best_uv;
+            return true;
+        }
+
+    private:
+
+        void subdivide(const geometry & mesh, const std::vector<float3> & centroids, const uint32_t nodeIndex, const uint32_t first, const uint32_t count, const uint32_t depth)
+        {
+            // Fit the node bounds over its triangles
+            float3 boundsMin(std::numeric_limits<float>::infinity()), boundsMax(-std::numeric_limits<float>::infinity());
+            float3 centroidMin = boundsMin, centroidMax = boundsMax;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const uint3 & tri = mesh.faces[primitives[first + i]];
+                boundsMin = linalg::min(boundsMin, linalg::min(mesh.vertices[tri.x], linalg::min(mesh.vertices[tri.y], mesh.vertices[tri.z])));
+                boundsMax = linalg::max(boundsMax, linalg::max(mesh.vertices[tri.x], linalg::max(mesh.vertices[tri.y], mesh.vertices[tri.z])));
+                centroidMin = linalg::min(centroidMin, centroids[primitives[first + i]]);
+                centroidMax = linalg::max(centroidMax, centroids[primitives[first + i]]);
+            }
+            nodes[nodeIndex].boundsMin = boundsMin;
+            nodes[nodeIndex].boundsMax = boundsMax;
+
+            // Depth cap keeps the traversal stack bounded on pathological geometry
+            if (count <= leaf_size || depth >= 60)
+            {
+                nodes[nodeIndex].leftOrFirst = first;
+                nodes[nodeIndex].count = count;
+                return;
+            }
+
+            // Split on the longest centroid axis at its spatial midpoint
+            const float3 extent = centroidMax - centroidMin;
+            const int axis = (extent.x > extent.y) ? ((extent.x > extent.z) ? 0 : 2) : ((extent.y > extent.z) ? 1 : 2);
+            const float splitPos = centroidMin[axis] + extent[axis] * 0.5f;
+
+            auto * mid = std::partition(primitives.data() + first, primitives.data() + first + count,
+                [&](const uint32_t f) { return centroids[f][axis] < splitPos; });
+            uint32_t leftCount = static_cast<uint32_t>(mid - (primitives.data() + first));
+
+            // Degenerate split (all centroids coincident on the axis): fall back to a median
+            if (leftCount == 0 || leftCount == count) leftCount = count / 2;
+
+            const uint32_t leftChild = static_cast<uint32_t>(nodes.size());
+            nodes[nodeIndex].leftOrFirst = leftChild;
+            nodes[nodeIndex].count = 0;
+            nodes.emplace_back();
+            nodes.emplace_back();
+
+            subdivide(mesh, centroids, leftChild, first, leftCount, depth + 1);
+            subdivide(mesh, centroids, leftChild + 1, first + leftCount, count - leftCount, depth + 1);
+        }
+    };
+
+    // Build-once BVH cache, keyed by mesh address and validated against the mesh's current
+    // vertex/face counts so a mesh re-filled in place re-builds on its next query
+    inline const mesh_bvh & get_mesh_bvh(const geometry & mesh)
+    {
+        struct cache_entry { size_t vertexCount{ 0 }; size_t faceCount{ 0 }; std::unique_ptr<mesh_bvh> bvh; };
+        static std::map<const geometry *, cache_entry> cache;
+        static std::mutex cacheMutex;
+
+        std::lock_guard<std::mutex> guard(cacheMutex);
+
+        cache_entry & entry = cache[&mesh];
+        if (!entry.bvh || entry.vertexCount != mesh.vertices.size() || entry.faceCount != mesh.faces.size())
+        {
+            entry.bvh.reset(new mesh_bvh());
+            entry.bvh->build(mesh);
+            entry.vertexCount = mesh.vertices.size();
+            entry.faceCount = mesh.faces.size();
+        }
+        return *entry.bvh;
+    }
+
     inline bool intersect_ray_mesh(const ray & ray,
         const geometry & mesh,
         float * outRayT = nullptr,
@@ -231,13 +553,23 @@ namespace polymer
         uint3 best_face = { 0, 0, 0 };
         float2 outUv;
 
-        for (int f = 0; f < mesh.faces.size(); ++f)
+        // Meshes past a handful of faces go through the cached BVH; tiny ones aren't worth the node fetch
+        if (mesh.faces.size() > 2 * mesh_bvh::leaf_size)
         {
-            auto & tri = mesh.faces[f];
-            if (intersect_ray_triangle(ray, mesh.vertices[tri.x], mesh.vertices[tri.y], mesh.vertices[tri.z], &t, &outUv) && t < best_t)
+            uint32_t hitFace;
+            if (!get_mesh_bvh(mesh).intersect(ray, mesh, &best_t, &hitFace, &outUv)) return false;
+            best_face = mesh.faces[hitFace];
+        }
+        else
+        {
+            for (int f = 0; f < mesh.faces.size(); ++f)
             {
-                best_t = t;
-                best_face = mesh.faces[f];
+                auto & tri = mesh.faces[f];
+                if (intersect_ray_triangle(ray, mesh.vertices[tri.x], mesh.vertices[tri.y], mesh.vertices[tri.z], &t, &outUv) && t < best_t)
+                {
+                    best_t = t;
+                    best_face = mesh.faces[f];
+                }
             }
         }
 
@@ -10,8 +10,12 @@
 #include "simple_timer.hpp"
 #include "procedural_mesh.hpp"
 #include "memory-pool.hpp"
+#include "memory-arena.hpp"
+#include "flat_hash_map.hpp"
 #include "image-buffer.hpp"
 #include "geometry.hpp"
+#include "mesh_simplify.hpp"
+#include "file_watcher.hpp"
 #include "file_io.hpp"
 #include "camera.hpp"
 #include "bit_mask.hpp"
@@ -19,12 +23,15 @@
 #include "any.hpp"
 #include "property.hpp"
 #include "thread-pool.hpp"
+#include "async.hpp"
 
 #include "simple_animator.hpp"
 #include "trajectory.hpp"
 #include "splines.hpp"
 #include "simplex_noise.hpp"
 #include "radix_sort.hpp"
+#include "morton.hpp"
+#include "spatial_grid.hpp"
 #include "quick_hull.hpp"
 #include "poisson_disk.hpp"
 #include "parallel_transport_frames.hpp"
@@ -35,6 +42,7 @@
 #include "algo_misc.hpp"
 
 #include "queue-spsc-bounded.hpp"
+#include "queue-spsc-bytes.hpp"
 #include "queue-spsc.hpp"
 #include "queue-mpsc-bounded.hpp"
 #include "queue-mpsc.hpp"
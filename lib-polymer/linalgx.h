@@ -173,4 +173,91 @@ namespace std
     template<class T> struct hash<linalg::quat<T>> { std::size_t operator()(const linalg::quat<T> & q) const { std::hash<T> h; return h(q.x) ^ (h(q.y) << 1) ^ (h(q.z) << 2) ^ (h(q.w) << 3); } };
 }
 
+//////////////////////////////////////////////////////////////
+// SIMD specializations for hot float4/float4x4/quat<float> //
+//////////////////////////////////////////////////////////////
+
+// linalg.h implements everything as scalar templates. The float specializations
+// below are plain (non-template) overloads, so overload resolution prefers them
+// for exact float4/float4x4/quatf argument types and every existing call site
+// picks them up unchanged. Results may differ from the scalar path in the last
+// ulp (different operation order), which is within the engine's tolerance.
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define LINALGX_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
+
+#ifdef LINALGX_SIMD_SSE
+
+namespace linalg
+{
+    namespace detail_simd
+    {
+        inline __m128 load(const vec<float,4> & v) { return _mm_loadu_ps(v.data()); }
+        inline __m128 load(const vec<float,3> & v) { return _mm_set_ps(0.f, v[2], v[1], v[0]); }
+        inline vec<float,4> store(const __m128 m) { vec<float,4> v; _mm_storeu_ps(v.data(), m); return v; }
+        inline vec<float,3> store3(const __m128 m) { float f[4]; _mm_storeu_ps(f, m); return {f[0], f[1], f[2]}; }
+
+        // a[0]*b.x + a[1]*b.y + a[2]*b.z + a[3]*b.w — one splat + multiply-add per column
+        inline __m128 mul_mat_vec(const mat<float,4,4> & a, const __m128 b)
+        {
+            __m128 r =            _mm_mul_ps(load(a[0]), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0,0,0,0)));
+            r = _mm_add_ps(r, _mm_mul_ps(load(a[1]), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1,1,1,1))));
+            r = _mm_add_ps(r, _mm_mul_ps(load(a[2]), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2,2,2,2))));
+            r = _mm_add_ps(r, _mm_mul_ps(load(a[3]), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3,3,3,3))));
+            return r;
+        }
+
+        inline __m128 cross(const __m128 a, const __m128 b)
+        {
+            const __m128 t = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3,0,2,1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3,1,0,2))),
+                _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3,1,0,2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3,0,2,1))));
+            return t;
+        }
+    }
+
+    inline vec<float,4> operator * (const mat<float,4,4> & a, const vec<float,4> & b)
+    {
+        return detail_simd::store(detail_simd::mul_mat_vec(a, detail_simd::load(b)));
+    }
+
+    inline mat<float,4,4> operator * (const mat<float,4,4> & a, const mat<float,4,4> & b)
+    {
+        return { detail_simd::store(detail_simd::mul_mat_vec(a, detail_simd::load(b[0]))),
+                 detail_simd::store(detail_simd::mul_mat_vec(a, detail_simd::load(b[1]))),
+                 detail_simd::store(detail_simd::mul_mat_vec(a, detail_simd::load(b[2]))),
+                 detail_simd::store(detail_simd::mul_mat_vec(a, detail_simd::load(b[3]))) };
+    }
+
+    inline quat<float> operator * (const quat<float> & a, const quat<float> & b)
+    {
+        // Lanes of t2/t3 carry a flipped sign in w (the scalar products), handled by xor
+        const __m128 wsign = _mm_set_ps(-0.f, 0.f, 0.f, 0.f);
+        const __m128 av = _mm_loadu_ps(&a.x);
+        const __m128 bv = _mm_loadu_ps(&b.x);
+        const __m128 t1 = _mm_mul_ps(_mm_shuffle_ps(av, av, _MM_SHUFFLE(3,3,3,3)), bv);
+        const __m128 t2 = _mm_xor_ps(wsign, _mm_mul_ps(_mm_shuffle_ps(av, av, _MM_SHUFFLE(0,2,1,0)), _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(0,3,3,3))));
+        const __m128 t3 = _mm_xor_ps(wsign, _mm_mul_ps(_mm_shuffle_ps(av, av, _MM_SHUFFLE(1,0,2,1)), _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(1,1,0,2))));
+        const __m128 t4 = _mm_mul_ps(_mm_shuffle_ps(av, av, _MM_SHUFFLE(2,1,0,2)), _mm_shuffle_ps(bv, bv, _MM_SHUFFLE(2,0,2,1)));
+        const __m128 r = _mm_sub_ps(_mm_add_ps(_mm_add_ps(t1, t2), t3), t4);
+        quat<float> q;
+        _mm_storeu_ps(&q.x, r);
+        return q;
+    }
+
+    // v + 2*cross(q.xyz, cross(q.xyz, v) + q.w*v)
+    inline vec<float,3> qrot(const quat<float> & q, const vec<float,3> & v)
+    {
+        const __m128 qv = _mm_set_ps(0.f, q.z, q.y, q.x);
+        const __m128 vv = detail_simd::load(v);
+        const __m128 qw = _mm_set1_ps(q.w);
+        const __m128 t = detail_simd::cross(qv, _mm_add_ps(detail_simd::cross(qv, vv), _mm_mul_ps(qw, vv)));
+        return detail_simd::store3(_mm_add_ps(vv, _mm_add_ps(t, t)));
+    }
+}
+
+#endif // LINALGX_SIMD_SSE
+
 #endif
\ No newline at end of file
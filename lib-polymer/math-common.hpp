@@ -222,6 +222,64 @@ namespace polymer
         }
         return y + (2.f * x * k) / (2.f * (1.f + k - 2.f * x));
     }
+
+    //////////////////////////////////
+    //   Counter-based randomness   //
+    //////////////////////////////////
+
+    // Stateless counter-based generator for parallel procedural work. A stateful
+    // generator (uniform_random_gen) either races or serializes when a parallel_for
+    // body draws from it; here every (seed, index) pair hashes independently to the
+    // same value on every run and every thread, so scatter and noise passes stay
+    // deterministic no matter how the scheduler splits the range. The mixer is
+    // splitmix64's finalizer - full 64-bit avalanche in three multiply/xor rounds.
+    inline uint64_t counter_hash(const uint64_t seed, const uint64_t index)
+    {
+        uint64_t z = seed + index * 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    struct counter_rng
+    {
+        uint64_t seed{ 0 };
+
+        counter_rng() = default;
+        explicit counter_rng(const uint64_t seed) : seed(seed) {}
+
+        uint64_t random_uint64(const uint64_t index) const { return counter_hash(seed, index); }
+        uint32_t random_uint(const uint64_t index) const { return uint32_t(counter_hash(seed, index) >> 32); }
+
+        // [0, max] - rejection-free via the 64-bit hash's upper bits
+        uint32_t random_uint(const uint64_t index, const uint32_t max) const
+        {
+            return uint32_t((counter_hash(seed, index) >> 32) * (uint64_t(max) + 1) >> 32);
+        }
+
+        // [0, 1): the hash's top 24 bits scaled into a float mantissa
+        float random_float(const uint64_t index) const
+        {
+            return (counter_hash(seed, index) >> 40) * (1.f / 16777216.f);
+        }
+
+        float random_float(const uint64_t index, const float min, const float max) const
+        {
+            return min + random_float(index) * (max - min);
+        }
+
+        // Independent components for scatter positions: the component id offsets
+        // into a disjoint region of the index space.
+        float2 random_float2(const uint64_t index) const
+        {
+            return float2(random_float(index * 2 + 0), random_float(index * 2 + 1));
+        }
+
+        float3 random_float3(const uint64_t index) const
+        {
+            return float3(random_float(index * 3 + 0), random_float(index * 3 + 1), random_float(index * 3 + 2));
+        }
+    };
 }
 
 #endif // end math_common_hpp
\ No newline at end of file
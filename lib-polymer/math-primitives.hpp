@@ -14,6 +14,12 @@
 #include "math-common.hpp"
 #include <array>
 
+// SSE2 path for the batch frustum/aabb classifier (frustum_cull_aabb_soa)
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POLYMER_MATH_PRIMITIVES_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace polymer
 {
     /////////////////////////////////////
@@ -33,7 +39,7 @@ namespace polymer
         float2 max() const { return _max; }
 
         float2 size() const { return max() - min(); }
-        float2 center() const { return{ (_min.x + _max.y) / 2, (_min.y + _max.y) / 2 }; }
+        float2 center() const { return{ (_min.x + _max.x) / 2, (_min.y + _max.y) / 2 }; }
         float area() const { return (_max.x - _min.x) * (_max.y - _min.y); }
 
         float width() const { return _max.x - _min.x; }
@@ -429,8 +435,93 @@ namespace polymer
             return true;
         }
 
+        // Branch-free center/half-extent form of the test above. The support radius
+        // r = dot(|n|, half_extents) selects the p-vertex implicitly, so no per-plane
+        // sign comparisons are needed. Returns true if the box is fully or partially
+        // contained within the frustum.
+        bool intersects_aabb(const float3 & box_center, const float3 & half_extents) const
+        {
+            for (int p = 0; p < 6; p++)
+            {
+                const float r = dot(linalg::abs(planes[p].get_normal()), half_extents);
+                if (planes[p].distance_to(box_center) < -r) return false;
+            }
+            return true;
+        }
+
+        // n-vertex companion to intersects_aabb. Returns true only if the box is fully
+        // contained within the frustum.
+        bool contains_aabb(const float3 & box_center, const float3 & half_extents) const
+        {
+            for (int p = 0; p < 6; p++)
+            {
+                const float r = dot(linalg::abs(planes[p].get_normal()), half_extents);
+                if (planes[p].distance_to(box_center) < r) return false;
+            }
+            return true;
+        }
+
     };
 
+    // Classifies `count` axis-aligned boxes (structure-of-arrays center/half-extent
+    // channels) against all six frustum planes, writing 1 for each box that is fully or
+    // partially inside and 0 for each box that can be culled. Plane constants are
+    // broadcast once and four boxes are resolved per SSE2 iteration; hot linear culls
+    // (per-object refinement after an octree walk, the renderer's non-compute fallback)
+    // should prefer this over calling intersects_aabb per box.
+    inline void frustum_cull_aabb_soa(const frustum & f,
+        const float * cx, const float * cy, const float * cz,
+        const float * hx, const float * hy, const float * hz,
+        const size_t count, uint8_t * visible)
+    {
+        size_t i = 0;
+
+#if defined(POLYMER_MATH_PRIMITIVES_SSE2)
+        __m128 pnx[6], pny[6], pnz[6], pd[6], pax[6], pay[6], paz[6];
+        for (int p = 0; p < 6; ++p)
+        {
+            const float4 & eq = f.planes[p].equation;
+            pnx[p] = _mm_set1_ps(eq[0]);
+            pny[p] = _mm_set1_ps(eq[1]);
+            pnz[p] = _mm_set1_ps(eq[2]);
+            pd[p]  = _mm_set1_ps(eq[3]);
+            pax[p] = _mm_set1_ps(std::fabs(eq[0]));
+            pay[p] = _mm_set1_ps(std::fabs(eq[1]));
+            paz[p] = _mm_set1_ps(std::fabs(eq[2]));
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 bx = _mm_loadu_ps(cx + i), by = _mm_loadu_ps(cy + i), bz = _mm_loadu_ps(cz + i);
+            const __m128 ex = _mm_loadu_ps(hx + i), ey = _mm_loadu_ps(hy + i), ez = _mm_loadu_ps(hz + i);
+
+            __m128 inside = _mm_cmpeq_ps(zero, zero); // all lanes true
+
+            for (int p = 0; p < 6; ++p)
+            {
+                // signed distance to the plane plus the p-vertex support radius; a box is
+                // outside as soon as (dist + r) goes negative for any plane
+                const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pnx[p], bx), _mm_mul_ps(pny[p], by)), _mm_add_ps(_mm_mul_ps(pnz[p], bz), pd[p]));
+                const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pax[p], ex), _mm_mul_ps(pay[p], ey)), _mm_mul_ps(paz[p], ez));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, r), zero));
+            }
+
+            const int mask = _mm_movemask_ps(inside);
+            visible[i + 0] = static_cast<uint8_t>((mask >> 0) & 1);
+            visible[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+            visible[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+            visible[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            visible[i] = f.intersects_aabb({ cx[i], cy[i], cz[i] }, { hx[i], hy[i], hz[i] }) ? 1 : 0;
+        }
+    }
+
     inline std::array<float3, 8> make_frustum_corners(const frustum & f)
     {
         std::array<float3, 8> corners;
@@ -50,6 +50,106 @@ namespace polymer
     inline bool operator != (const transform & a, const transform & b) { return (a.position != b.position) || (a.orientation != b.orientation); }
     inline std::ostream & operator << (std::ostream & o, const transform & r) { return o << "{" << r.position << ", " << r.orientation << "}"; }
 
+    ///////////////////////////////////
+    //   batched transform kernels   //
+    ///////////////////////////////////
+
+    // Bulk paths (instance-buffer building, transform flushes) pay for one
+    // quaternion-to-matrix conversion per object when they walk AoS transforms.
+    // compose_model_matrices takes structure-of-arrays inputs and emits model
+    // matrices (rotation * scale, translation in the last column) four at a time:
+    // the quaternion products for four objects are computed lane-parallel in SSE
+    // registers, with a scalar loop covering the tail and non-SSE builds.
+
+    inline void compose_model_matrices_scalar(const quatf * orientations, const float3 * positions, const float3 * scales,
+                                              const size_t count, float4x4 * out)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = { { qxdir(orientations[i]) * scales[i].x, 0 },
+                       { qydir(orientations[i]) * scales[i].y, 0 },
+                       { qzdir(orientations[i]) * scales[i].z, 0 },
+                       { positions[i], 1 } };
+        }
+    }
+
+    inline void compose_model_matrices(const quatf * orientations, const float3 * positions, const float3 * scales,
+                                       const size_t count, float4x4 * out)
+    {
+#ifdef LINALGX_SIMD_SSE
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // Transpose four xyzw quaternions into lane-parallel registers
+            __m128 qx = _mm_loadu_ps(&orientations[i + 0].x);
+            __m128 qy = _mm_loadu_ps(&orientations[i + 1].x);
+            __m128 qz = _mm_loadu_ps(&orientations[i + 2].x);
+            __m128 qw = _mm_loadu_ps(&orientations[i + 3].x);
+            _MM_TRANSPOSE4_PS(qx, qy, qz, qw); // now qx = {x0,x1,x2,x3} etc.
+
+            const __m128 two = _mm_set1_ps(2.f);
+            const __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz), ww = _mm_mul_ps(qw, qw);
+            const __m128 xy = _mm_mul_ps(qx, qy), yz = _mm_mul_ps(qy, qz), zx = _mm_mul_ps(qz, qx);
+            const __m128 xw = _mm_mul_ps(qx, qw), yw = _mm_mul_ps(qy, qw), zw = _mm_mul_ps(qz, qw);
+
+            // Nine rotation entries for four objects at once, matching qxdir/qydir/qzdir
+            float m00[4], m01[4], m02[4], m10[4], m11[4], m12[4], m20[4], m21[4], m22[4];
+            _mm_storeu_ps(m00, _mm_sub_ps(_mm_add_ps(ww, xx), _mm_add_ps(yy, zz)));
+            _mm_storeu_ps(m01, _mm_mul_ps(two, _mm_add_ps(xy, zw)));
+            _mm_storeu_ps(m02, _mm_mul_ps(two, _mm_sub_ps(zx, yw)));
+            _mm_storeu_ps(m10, _mm_mul_ps(two, _mm_sub_ps(xy, zw)));
+            _mm_storeu_ps(m11, _mm_add_ps(_mm_sub_ps(ww, xx), _mm_sub_ps(yy, zz)));
+            _mm_storeu_ps(m12, _mm_mul_ps(two, _mm_add_ps(yz, xw)));
+            _mm_storeu_ps(m20, _mm_mul_ps(two, _mm_add_ps(zx, yw)));
+            _mm_storeu_ps(m21, _mm_mul_ps(two, _mm_sub_ps(yz, xw)));
+            _mm_storeu_ps(m22, _mm_sub_ps(_mm_sub_ps(ww, xx), _mm_sub_ps(yy, zz)));
+
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                const float3 & s = scales[i + lane];
+                out[i + lane] = { { m00[lane] * s.x, m01[lane] * s.x, m02[lane] * s.x, 0 },
+                                  { m10[lane] * s.y, m11[lane] * s.y, m12[lane] * s.y, 0 },
+                                  { m20[lane] * s.z, m21[lane] * s.z, m22[lane] * s.z, 0 },
+                                  { positions[i + lane], 1 } };
+            }
+        }
+        compose_model_matrices_scalar(orientations + i, positions + i, scales + i, count - i, out + i);
+#else
+        compose_model_matrices_scalar(orientations, positions, scales, count, out);
+#endif
+    }
+
+    // SoA scratch for the bulk compose path: push per-object transforms, then
+    // compose() the whole run into a packed float4x4 array in one call.
+    struct transform_soa
+    {
+        std::vector<quatf> orientations;
+        std::vector<float3> positions;
+        std::vector<float3> scales;
+
+        void clear()
+        {
+            orientations.clear();
+            positions.clear();
+            scales.clear();
+        }
+
+        void push(const transform & t, const float3 & scale)
+        {
+            orientations.push_back(t.orientation);
+            positions.push_back(t.position);
+            scales.push_back(scale);
+        }
+
+        size_t size() const { return orientations.size(); }
+
+        void compose(std::vector<float4x4> & out) const
+        {
+            out.resize(orientations.size());
+            if (!out.empty()) compose_model_matrices(orientations.data(), positions.data(), scales.data(), orientations.size(), out.data());
+        }
+    };
+
     //////////////////////////////////////////
     //   rotation quaternion construction   //
     //////////////////////////////////////////
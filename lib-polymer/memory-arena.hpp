@@ -0,0 +1,300 @@
+#pragma once
+
+#ifndef polymer_memory_arena_hpp
+#define polymer_memory_arena_hpp
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace polymer
+{
+    //////////////////////
+    //   linear_arena   //
+    //////////////////////
+
+    // Resettable bump allocator for frame-scoped transients (render queues, visible-node
+    // lists, view arrays). Allocation is a pointer increment; individual frees are no-ops
+    // and the whole arena is reclaimed at once with reset(). If a frame spikes past the
+    // fixed block, overflow allocations fall back to the heap and are released on reset.
+    //
+    // reset() must only be called when no arena-backed container still owns its memory -
+    // containers that persist across frames (cleared, not destroyed) keep their capacity
+    // pointing into the arena and simply stop allocating once they reach steady state.
+    class linear_arena
+    {
+        uint8_t * block{ nullptr };
+        size_t capacity{ 0 };
+        size_t offset{ 0 };
+        size_t highWater{ 0 };
+        std::vector<void *> overflow;
+
+        linear_arena(const linear_arena &) = delete;
+        linear_arena & operator = (const linear_arena &) = delete;
+
+    public:
+
+        explicit linear_arena(const size_t bytes = 2 * 1024 * 1024) : capacity(bytes)
+        {
+            block = static_cast<uint8_t *>(std::malloc(capacity));
+            if (!block) throw std::bad_alloc();
+        }
+
+        ~linear_arena()
+        {
+            for (void * p : overflow) std::free(p);
+            std::free(block);
+        }
+
+        void * allocate(const size_t size, const size_t alignment = alignof(std::max_align_t))
+        {
+            const size_t aligned = (offset + (alignment - 1)) & ~(alignment - 1);
+            if (aligned + size <= capacity)
+            {
+                offset = aligned + size;
+                if (offset > highWater) highWater = offset;
+                return block + aligned;
+            }
+
+            // Frame spike - spill to the heap and reclaim on reset
+            void * p = std::malloc(size);
+            if (!p) throw std::bad_alloc();
+            overflow.push_back(p);
+            return p;
+        }
+
+        void reset()
+        {
+            for (void * p : overflow) std::free(p);
+            overflow.clear();
+            offset = 0;
+        }
+
+        size_t bytes_used() const { return offset; }
+        size_t bytes_capacity() const { return capacity; }
+        size_t high_water_mark() const { return highWater; }
+        bool did_overflow() const { return !overflow.empty(); }
+    };
+
+    /////////////////////////
+    //   arena_allocator   //
+    /////////////////////////
+
+    // STL-compatible adapter. A default-constructed allocator (no arena) falls back to the
+    // heap so containers declared without an arena keep working; deallocation is a no-op
+    // for arena-backed memory since the arena reclaims in bulk.
+    template<class T>
+    class arena_allocator
+    {
+        linear_arena * arena{ nullptr };
+
+        template<class U> friend class arena_allocator;
+
+    public:
+
+        using value_type = T;
+
+        arena_allocator() = default;
+        arena_allocator(linear_arena & a) : arena(&a) {}
+        template<class U> arena_allocator(const arena_allocator<U> & other) : arena(other.arena) {}
+
+        T * allocate(const size_t n)
+        {
+            if (arena) return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T * p, const size_t n)
+        {
+            if (!arena) ::operator delete(p);
+        }
+
+        bool operator == (const arena_allocator & other) const { return arena == other.arena; }
+        bool operator != (const arena_allocator & other) const { return arena != other.arena; }
+    };
+
+    template<class T> using arena_vector = std::vector<T, arena_allocator<T>>;
+
+    //////////////////////
+    //   small_vector   //
+    //////////////////////
+
+    // Sequence container with inline storage for the first `N` elements - the common case
+    // for per-frame collections (a handful of views, a few dozen lights or visible nodes)
+    // never touches an allocator at all. Growth past `N` spills into a bound linear_arena
+    // when one was supplied at construction, otherwise the heap. Capacity never shrinks;
+    // clear() destroys elements but keeps the spilled block, so steady-state reuse is
+    // allocation-free on either path.
+    template<typename T, size_t N>
+    class small_vector
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type inlineStorage[N];
+        T * elements;
+        size_t count{ 0 };
+        size_t cap{ N };
+        linear_arena * arena{ nullptr };
+
+        T * inline_begin() { return reinterpret_cast<T *>(inlineStorage); }
+        const T * inline_begin() const { return reinterpret_cast<const T *>(inlineStorage); }
+        bool is_inline() const { return elements == inline_begin(); }
+
+        void grow(const size_t minimum)
+        {
+            size_t newCap = cap * 2;
+            if (newCap < minimum) newCap = minimum;
+
+            T * block = arena
+                ? static_cast<T *>(arena->allocate(newCap * sizeof(T), alignof(T)))
+                : static_cast<T *>(::operator new(newCap * sizeof(T)));
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                new (block + i) T(std::move(elements[i]));
+                elements[i].~T();
+            }
+
+            release_block();
+            elements = block;
+            cap = newCap;
+        }
+
+        // Arena-backed blocks are reclaimed in bulk by the arena's own reset()
+        void release_block()
+        {
+            if (!is_inline() && !arena) ::operator delete(elements);
+        }
+
+        void move_from(small_vector && other)
+        {
+            arena = other.arena;
+            if (other.is_inline())
+            {
+                elements = inline_begin();
+                cap = N;
+                for (size_t i = 0; i < other.count; ++i)
+                {
+                    new (elements + i) T(std::move(other.elements[i]));
+                    other.elements[i].~T();
+                }
+                count = other.count;
+                other.count = 0;
+            }
+            else
+            {
+                // Steal the spilled block (heap-owned, or arena-owned and reclaimed there)
+                elements = other.elements;
+                cap = other.cap;
+                count = other.count;
+                other.elements = other.inline_begin();
+                other.cap = N;
+                other.count = 0;
+            }
+        }
+
+    public:
+
+        typedef T * iterator;
+        typedef const T * const_iterator;
+        typedef T value_type;
+
+        small_vector() : elements(inline_begin()) {}
+        explicit small_vector(linear_arena & a) : elements(inline_begin()), arena(&a) {}
+
+        small_vector(const small_vector & other) : elements(inline_begin()), arena(other.arena)
+        {
+            reserve(other.count);
+            for (size_t i = 0; i < other.count; ++i) new (elements + i) T(other.elements[i]);
+            count = other.count;
+        }
+
+        small_vector(small_vector && other) : elements(inline_begin()) { move_from(std::move(other)); }
+
+        small_vector & operator = (const small_vector & other)
+        {
+            if (this == &other) return *this;
+            clear();
+            reserve(other.count);
+            for (size_t i = 0; i < other.count; ++i) new (elements + i) T(other.elements[i]);
+            count = other.count;
+            return *this;
+        }
+
+        small_vector & operator = (small_vector && other)
+        {
+            if (this == &other) return *this;
+            clear();
+            release_block();
+            move_from(std::move(other));
+            return *this;
+        }
+
+        ~small_vector()
+        {
+            clear();
+            release_block();
+        }
+
+        void push_back(const T & value) { emplace_back(value); }
+        void push_back(T && value) { emplace_back(std::move(value)); }
+
+        template<typename... Args>
+        T & emplace_back(Args &&... args)
+        {
+            if (count == cap) grow(count + 1);
+            T * slot = new (elements + count) T(std::forward<Args>(args)...);
+            ++count;
+            return *slot;
+        }
+
+        void pop_back() { elements[--count].~T(); }
+
+        void clear()
+        {
+            for (size_t i = 0; i < count; ++i) elements[i].~T();
+            count = 0;
+        }
+
+        void reserve(const size_t n) { if (n > cap) grow(n); }
+
+        void resize(const size_t n)
+        {
+            if (n > count)
+            {
+                reserve(n);
+                for (size_t i = count; i < n; ++i) new (elements + i) T();
+            }
+            else
+            {
+                for (size_t i = n; i < count; ++i) elements[i].~T();
+            }
+            count = n;
+        }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return cap; }
+        bool empty() const { return count == 0; }
+
+        T * data() { return elements; }
+        const T * data() const { return elements; }
+
+        T & operator [] (const size_t i) { return elements[i]; }
+        const T & operator [] (const size_t i) const { return elements[i]; }
+
+        T & front() { return elements[0]; }
+        const T & front() const { return elements[0]; }
+        T & back() { return elements[count - 1]; }
+        const T & back() const { return elements[count - 1]; }
+
+        iterator begin() { return elements; }
+        iterator end() { return elements + count; }
+        const_iterator begin() const { return elements; }
+        const_iterator end() const { return elements + count; }
+    };
+
+} // end namespace polymer
+
+#endif // end polymer_memory_arena_hpp
@@ -3,14 +3,164 @@
 #ifndef polymer_memory_pool_hpp
 #define polymer_memory_pool_hpp
 
+#include <assert.h>
 #include <stdint.h>
-#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <type_traits>
-#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace polymer
 {
-    // ... 
-};
+    /////////////////////
+    //   object_pool   //
+    /////////////////////
+
+    // Chunked free-list allocator for fixed-size objects with per-entity lifetimes
+    // (physics bodies, queued event wrappers) - the cases linear_arena's bulk reset
+    // cannot serve. Capacity grows by doubling chunks, so the pool never moves or
+    // invalidates live objects, and freed slots recycle through per-thread caches:
+    // steady-state construct/destroy is a TLS pointer pop with no lock, and the
+    // shared list (mutex-guarded) is only touched to refill or flush a cache batch.
+    // Worker threads therefore stop contending on the global heap.
+    //
+    // Caveats: per-thread caches are flushed back when they exceed two batches, but
+    // a thread that exits while holding cached slots strands them until the pool is
+    // destroyed - intended for engine-lifetime pools serving persistent workers.
+    // The pool itself must outlive every object constructed from it; destruction
+    // with live objects is a leak and asserts in debug builds.
+    template<typename T>
+    class object_pool
+    {
+        union slot
+        {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+            slot * next; // valid only while the slot is free
+        };
+
+        static const size_t kCacheBatch = 32;
+        static const size_t kMaxChunkSize = 8192;
+
+        std::vector<std::unique_ptr<slot[]>> chunks;
+        size_t nextChunkSize;
+        slot * freeList{ nullptr };   // shared list, guarded by `mutex`
+        std::mutex mutex;             // guards chunks + freeList
+        std::atomic<size_t> liveCount{ 0 };     // debug leak accounting
+        std::atomic<size_t> totalCapacity{ 0 };
+
+        struct thread_cache
+        {
+            slot * head{ nullptr };
+            size_t count{ 0 };
+        };
+
+        // One cache per (thread, pool) pair; the map is tiny (a handful of pools)
+        thread_cache & local_cache()
+        {
+            static thread_local std::unordered_map<const object_pool *, thread_cache> caches;
+            return caches[this];
+        }
+
+        // Carves a fresh chunk and threads its slots onto the shared list. Caller holds `mutex`.
+        void grow()
+        {
+            const size_t count = nextChunkSize;
+            if (nextChunkSize < kMaxChunkSize) nextChunkSize *= 2;
+
+            std::unique_ptr<slot[]> chunk(new slot[count]);
+            for (size_t i = 0; i < count; ++i)
+            {
+                chunk[i].next = freeList;
+                freeList = &chunk[i];
+            }
+            chunks.push_back(std::move(chunk));
+            totalCapacity += count;
+        }
+
+        // Moves up to one batch from the shared list into the thread cache
+        void refill(thread_cache & cache)
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (!freeList) grow();
+            while (freeList && cache.count < kCacheBatch)
+            {
+                slot * s = freeList;
+                freeList = s->next;
+                s->next = cache.head;
+                cache.head = s;
+                ++cache.count;
+            }
+        }
+
+        // Returns one batch from an overfull thread cache to the shared list
+        void flush(thread_cache & cache)
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            while (cache.count > kCacheBatch)
+            {
+                slot * s = cache.head;
+                cache.head = s->next;
+                --cache.count;
+                s->next = freeList;
+                freeList = s;
+            }
+        }
+
+        object_pool(const object_pool &) = delete;
+        object_pool & operator = (const object_pool &) = delete;
+
+    public:
+
+        explicit object_pool(const size_t initial_capacity = 256) : nextChunkSize(initial_capacity) {}
+
+        ~object_pool()
+        {
+            assert(liveCount == 0 && "object_pool destroyed with live objects");
+        }
+
+        void * allocate()
+        {
+            thread_cache & cache = local_cache();
+            if (!cache.head) refill(cache);
+            slot * s = cache.head;
+            cache.head = s->next;
+            --cache.count;
+            ++liveCount;
+            return &s->storage;
+        }
+
+        void deallocate(void * p)
+        {
+            if (!p) return;
+            thread_cache & cache = local_cache();
+            slot * s = reinterpret_cast<slot *>(p);
+            s->next = cache.head;
+            cache.head = s;
+            ++cache.count;
+            --liveCount;
+            if (cache.count > 2 * kCacheBatch) flush(cache);
+        }
+
+        template<typename... Args>
+        T * construct(Args &&... args)
+        {
+            return new (allocate()) T(std::forward<Args>(args)...);
+        }
+
+        void destroy(T * object)
+        {
+            if (!object) return;
+            object->~T();
+            deallocate(object);
+        }
+
+        size_t live() const { return liveCount; }
+        size_t capacity() const { return totalCapacity; }
+    };
+
+} // end namespace polymer
 
-#endif
+#endif // end polymer_memory_pool_hpp
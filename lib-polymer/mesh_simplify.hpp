@@ -0,0 +1,563 @@
+#pragma once
+
+#ifndef polymer_mesh_simplify_hpp
+#define polymer_mesh_simplify_hpp
+
+#include "geometry.hpp"
+#include "thread-pool.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace polymer
+{
+    ///////////////////////////////////////////
+    //   quadric-error mesh simplification   //
+    ///////////////////////////////////////////
+
+    // Runtime decimation for meshes that arrive after import (scanned props in the
+    // capture workflow), complementing the meshoptimizer-based LOD generation that
+    // runs at import time. Garland-Heckbert error quadrics drive iterative edge
+    // collapse with a rising error threshold per pass (no priority queue, so passes
+    // parallelize): vertices partition into slabs along the longest bounds axis and
+    // each pass collapses slab-interior edges concurrently, with edges whose
+    // one-ring crosses a slab handled in a short serial sweep afterwards.
+    //
+    // Two stopping modes compose: `target_triangle_count` collapses until the count
+    // is reached, `max_error` is a hard quadric-error ceiling no collapse may
+    // exceed (so a target may be left unmet on shape-critical meshes). With
+    // `preserve_seams` (default), open boundary vertices and attribute seams -
+    // positions shared by multiple indices carrying different normals/uvs - are
+    // locked in place, so texture atlases and hard edges survive decimation.
+    // Normals, texcoords, colors and tangent frames interpolate through collapses.
+
+    struct mesh_simplify_options
+    {
+        uint32_t target_triangle_count{ 0 };                        // collapse until at or below (0 = error bound alone decides)
+        float max_error{ std::numeric_limits<float>::infinity() };  // quadric error ceiling; collapses above it never apply
+        bool preserve_seams{ true };                                // lock open-boundary and attribute-seam vertices in place
+        uint32_t max_iterations{ 100 };
+        float aggressiveness{ 7.f };                                // growth rate of the per-pass error threshold schedule
+    };
+
+    namespace detail
+    {
+        // Symmetric 4x4 error quadric, upper triangle in 10 doubles
+        struct error_quadric
+        {
+            double m[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+            error_quadric() = default;
+
+            // From the plane ax + by + cz + d = 0
+            error_quadric(const double a, const double b, const double c, const double d)
+            {
+                m[0] = a * a; m[1] = a * b; m[2] = a * c; m[3] = a * d;
+                m[4] = b * b; m[5] = b * c; m[6] = b * d;
+                m[7] = c * c; m[8] = c * d;
+                m[9] = d * d;
+            }
+
+            error_quadric & operator += (const error_quadric & r)
+            {
+                for (int i = 0; i < 10; ++i) m[i] += r.m[i];
+                return *this;
+            }
+
+            error_quadric operator + (const error_quadric & r) const
+            {
+                error_quadric q(*this);
+                q += r;
+                return q;
+            }
+
+            double evaluate(const double x, const double y, const double z) const
+            {
+                return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x
+                     + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y
+                     + m[7] * z * z + 2 * m[8] * z
+                     + m[9];
+            }
+
+            double det(int a11, int a12, int a13, int a21, int a22, int a23, int a31, int a32, int a33) const
+            {
+                return m[a11] * m[a22] * m[a33] + m[a13] * m[a21] * m[a32] + m[a12] * m[a23] * m[a31]
+                     - m[a13] * m[a22] * m[a31] - m[a11] * m[a23] * m[a32] - m[a12] * m[a21] * m[a33];
+            }
+        };
+
+        class mesh_simplifier
+        {
+            struct triangle
+            {
+                uint32_t v[3];
+                double err[4];          // per-edge collapse error, [3] = min
+                float3 n;
+                uint32_t material{ 0 };
+                bool deleted{ false }, dirty{ false };
+            };
+
+            struct vertex
+            {
+                float3 p;
+                error_quadric q;
+                uint32_t tstart{ 0 }, tcount{ 0 };
+                uint32_t slab{ 0 };
+                bool locked{ false };
+                bool border{ false };
+            };
+
+            struct ref { uint32_t tid, tvertex; };
+
+            const geometry & input;
+            const mesh_simplify_options options;
+
+            std::vector<triangle> tris;
+            std::vector<vertex> verts;
+            std::vector<ref> refs;
+
+            // Per-slab overflow for refs appended during a parallel pass: each slab's
+            // worker appends only to its own vector, so no shared push_back races. A
+            // spilled vertex's ring lives at spillRefs[spillBucket][spillStart..].
+            std::vector<std::vector<ref>> spillRefs;
+            std::vector<int64_t> spillStart;    // per vertex, -1 = ring lives in `refs`
+            std::vector<uint32_t> spillBucket;  // per vertex, which spillRefs vector holds the ring
+
+            // Attributes carried through collapses, compacted at the end
+            std::vector<float3> normals;
+            std::vector<float2> texcoord0, texcoord1;
+            std::vector<float4> colors;
+            std::vector<float3> tangents, bitangents;
+
+            uint32_t slabCount{ 1 };
+            uint32_t deletedTriangles{ 0 };
+
+            ref get_ref(const vertex & v, const uint32_t k) const
+            {
+                const size_t i = &v - verts.data();
+                if (spillStart[i] >= 0) return spillRefs[spillBucket[i]][static_cast<size_t>(spillStart[i]) + k];
+                return refs[v.tstart + k];
+            }
+
+            // Minimum-error position for collapsing (u, v): solve the summed quadric
+            // when it is invertible, otherwise the best of the endpoints and midpoint
+            double calculate_error(const uint32_t u, const uint32_t v, float3 & result) const
+            {
+                const error_quadric q = verts[u].q + verts[v].q;
+                const bool onBorder = verts[u].border && verts[v].border;
+
+                const double d = q.det(0, 1, 2, 1, 4, 5, 2, 5, 7);
+                if (std::fabs(d) > 1e-12 && !onBorder)
+                {
+                    const double x = -1.0 / d * q.det(1, 2, 3, 4, 5, 6, 5, 7, 8);
+                    const double y =  1.0 / d * q.det(0, 2, 3, 1, 5, 6, 2, 7, 8);
+                    const double z = -1.0 / d * q.det(0, 1, 3, 1, 4, 6, 2, 5, 8);
+                    result = float3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+                    return q.evaluate(x, y, z);
+                }
+
+                const float3 p1 = verts[u].p, p2 = verts[v].p, p3 = (p1 + p2) * 0.5f;
+                const double e1 = q.evaluate(p1.x, p1.y, p1.z);
+                const double e2 = q.evaluate(p2.x, p2.y, p2.z);
+                const double e3 = q.evaluate(p3.x, p3.y, p3.z);
+                const double best = std::min(e1, std::min(e2, e3));
+                result = (best == e1) ? p1 : (best == e2) ? p2 : p3;
+                return best;
+            }
+
+            // Would moving i0 to p flip or degenerate any triangle in i0's ring?
+            // `deleted` flags the ring triangles shared with i1 for removal.
+            bool flipped(const float3 & p, const uint32_t i1, const vertex & v0, std::vector<bool> & deleted) const
+            {
+                for (uint32_t k = 0; k < v0.tcount; ++k)
+                {
+                    const triangle & t = tris[get_ref(v0, k).tid];
+                    if (t.deleted) continue;
+
+                    const uint32_t s = get_ref(v0, k).tvertex;
+                    const uint32_t id1 = t.v[(s + 1) % 3];
+                    const uint32_t id2 = t.v[(s + 2) % 3];
+
+                    if (id1 == i1 || id2 == i1) { deleted[k] = true; continue; }
+                    deleted[k] = false;
+
+                    const float3 d1 = safe_normalize(verts[id1].p - p);
+                    const float3 d2 = safe_normalize(verts[id2].p - p);
+                    if (std::fabs(dot(d1, d2)) > 0.999f) return true;         // sliver
+                    if (dot(safe_normalize(cross(d1, d2)), t.n) < 0.2f) return true; // normal flip
+                }
+                return false;
+            }
+
+            // Rewire v's surviving ring triangles onto i0 and recompute their edge errors.
+            // New ring refs land in `spill` (a slab-owned vector during parallel passes).
+            void update_triangles(const uint32_t i0, const vertex & v, const std::vector<bool> & deleted, std::vector<ref> & spill, uint32_t & deletedCount)
+            {
+                float3 p;
+                for (uint32_t k = 0; k < v.tcount; ++k)
+                {
+                    const ref r = get_ref(v, k);
+                    triangle & t = tris[r.tid];
+                    if (t.deleted) continue;
+                    if (deleted[k]) { t.deleted = true; ++deletedCount; continue; }
+
+                    t.v[r.tvertex] = i0;
+                    t.dirty = true;
+                    t.err[0] = calculate_error(t.v[0], t.v[1], p);
+                    t.err[1] = calculate_error(t.v[1], t.v[2], p);
+                    t.err[2] = calculate_error(t.v[2], t.v[0], p);
+                    t.err[3] = std::min(t.err[0], std::min(t.err[1], t.err[2]));
+                    spill.push_back(r);
+                }
+            }
+
+            // Interpolate carried attributes of i0 toward i1 by `t`
+            void lerp_attributes(const uint32_t i0, const uint32_t i1, const float t)
+            {
+                if (!normals.empty()) normals[i0] = safe_normalize(lerp(normals[i0], normals[i1], t));
+                if (!texcoord0.empty()) texcoord0[i0] = lerp(texcoord0[i0], texcoord0[i1], t);
+                if (!texcoord1.empty()) texcoord1[i0] = lerp(texcoord1[i0], texcoord1[i1], t);
+                if (!colors.empty()) colors[i0] = lerp(colors[i0], colors[i1], t);
+                if (!tangents.empty()) tangents[i0] = safe_normalize(lerp(tangents[i0], tangents[i1], t));
+                if (!bitangents.empty()) bitangents[i0] = safe_normalize(lerp(bitangents[i0], bitangents[i1], t));
+            }
+
+            // Attempt one collapse of edge (i0, i1) toward p; returns true on success
+            bool try_collapse(const uint32_t i0, const uint32_t i1, const float3 & p, std::vector<bool> & deleted0, std::vector<bool> & deleted1, const uint32_t bucket, uint32_t & deletedCount)
+            {
+                std::vector<ref> & spill = spillRefs[bucket];
+                vertex & v0 = verts[i0];
+                vertex & v1 = verts[i1];
+
+                deleted0.assign(v0.tcount, false);
+                deleted1.assign(v1.tcount, false);
+                if (flipped(p, i1, v0, deleted0)) return false;
+                if (flipped(p, i0, v1, deleted1)) return false;
+
+                const float d0 = length(p - v0.p), d1 = length(p - v1.p);
+                lerp_attributes(i0, i1, (d0 + d1) > 1e-12f ? d0 / (d0 + d1) : 0.5f);
+
+                v0.p = p;
+                v0.q += v1.q;
+                v0.border = v0.border || v1.border;
+
+                const size_t start = spill.size();
+                update_triangles(i0, v0, deleted0, spill, deletedCount);
+                update_triangles(i0, v1, deleted1, spill, deletedCount);
+
+                spillStart[i0] = static_cast<int64_t>(start); // ring now lives in the spill vector
+                spillBucket[i0] = bucket;
+                v0.tstart = 0; // unused while spilled
+                v0.tcount = static_cast<uint32_t>(spill.size() - start);
+                return true;
+            }
+
+            // True when the one-rings of both endpoints stay inside slab `s`, so a
+            // collapse touches no data another slab's worker can reach
+            bool ring_interior_to_slab(const uint32_t i0, const uint32_t i1, const uint32_t s) const
+            {
+                for (const uint32_t iv : { i0, i1 })
+                {
+                    const vertex & v = verts[iv];
+                    if (v.slab != s) return false;
+                    for (uint32_t k = 0; k < v.tcount; ++k)
+                    {
+                        const triangle & t = tris[get_ref(v, k).tid];
+                        if (t.deleted) continue;
+                        for (int c = 0; c < 3; ++c) if (verts[t.v[c]].slab != s) return false;
+                    }
+                }
+                return true;
+            }
+
+            // Compact deleted triangles, rebuild the shared ref table (folding any
+            // spilled rings back in), and on the first call derive quadrics, borders,
+            // seam locks and slab assignments
+            void update_mesh(const bool first)
+            {
+                if (!first)
+                {
+                    size_t dst = 0;
+                    for (size_t i = 0; i < tris.size(); ++i) if (!tris[i].deleted) tris[dst++] = tris[i];
+                    tris.resize(dst);
+                    deletedTriangles = 0;
+                }
+
+                // Rebuild vertex -> triangle adjacency
+                for (auto & v : verts) { v.tstart = 0; v.tcount = 0; }
+                for (const auto & t : tris)
+                {
+                    if (t.deleted) continue;
+                    for (int c = 0; c < 3; ++c) ++verts[t.v[c]].tcount;
+                }
+                uint32_t tstart = 0;
+                for (auto & v : verts) { v.tstart = tstart; tstart += v.tcount; v.tcount = 0; }
+                refs.resize(tstart);
+                for (uint32_t i = 0; i < tris.size(); ++i)
+                {
+                    const triangle & t = tris[i];
+                    if (t.deleted) continue;
+                    for (uint32_t c = 0; c < 3; ++c)
+                    {
+                        vertex & v = verts[t.v[c]];
+                        refs[v.tstart + v.tcount] = { i, c };
+                        ++v.tcount;
+                    }
+                }
+                std::fill(spillStart.begin(), spillStart.end(), int64_t(-1));
+                for (auto & s : spillRefs) s.clear();
+
+                if (!first) return;
+
+                // Face planes accumulate into per-vertex quadrics (parallel: each
+                // vertex sums only over its own ring)
+                for (auto & t : tris)
+                {
+                    const float3 n = safe_normalize(cross(verts[t.v[1]].p - verts[t.v[0]].p, verts[t.v[2]].p - verts[t.v[0]].p));
+                    t.n = n;
+                }
+                parallel_for(0, verts.size(), 4096, [this](size_t i)
+                {
+                    vertex & v = verts[i];
+                    for (uint32_t k = 0; k < v.tcount; ++k)
+                    {
+                        const triangle & t = tris[refs[v.tstart + k].tid];
+                        v.q += error_quadric(t.n.x, t.n.y, t.n.z, -dot(t.n, verts[t.v[0]].p));
+                    }
+                });
+
+                // Border detection: an edge with exactly one adjacent triangle marks
+                // its endpoints. Each vertex scans its own ring, so this parallelizes.
+                parallel_for(0, verts.size(), 2048, [this](size_t i)
+                {
+                    vertex & v = verts[i];
+                    std::vector<std::pair<uint32_t, uint32_t>> ring; // (vertex id, shared triangle count)
+                    for (uint32_t k = 0; k < v.tcount; ++k)
+                    {
+                        const triangle & t = tris[refs[v.tstart + k].tid];
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            const uint32_t id = t.v[c];
+                            if (id == static_cast<uint32_t>(i)) continue;
+                            bool found = false;
+                            for (auto & entry : ring) if (entry.first == id) { ++entry.second; found = true; break; }
+                            if (!found) ring.push_back({ id, 1 });
+                        }
+                    }
+                    for (const auto & entry : ring) if (entry.second == 1) { v.border = true; break; }
+                });
+
+                if (options.preserve_seams)
+                {
+                    // Attribute seams appear as duplicated positions in an indexed mesh:
+                    // the same point carried by several indices with different uvs/normals
+                    std::unordered_map<uint64_t, uint32_t> firstAtPosition;
+                    firstAtPosition.reserve(verts.size());
+                    for (uint32_t i = 0; i < verts.size(); ++i)
+                    {
+                        uint32_t bits[3];
+                        std::memcpy(bits, &verts[i].p, sizeof(bits));
+                        uint64_t key = bits[0];
+                        key = key * 0x9e3779b97f4a7c15ull + bits[1];
+                        key = key * 0x9e3779b97f4a7c15ull + bits[2];
+
+                        const auto it = firstAtPosition.find(key);
+                        if (it == firstAtPosition.end()) firstAtPosition[key] = i;
+                        else { verts[i].locked = true; verts[it->second].locked = true; }
+                    }
+                    for (auto & v : verts) if (v.border) v.locked = true;
+                }
+
+                // Slab partition along the longest bounds axis for the parallel passes
+                const aabb_3d bounds = compute_bounds(input);
+                const float3 extent = bounds.size();
+                const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+                const float lo = bounds.min()[axis], range = std::max(extent[axis], 1e-6f);
+                for (auto & v : verts)
+                {
+                    v.slab = std::min(slabCount - 1, static_cast<uint32_t>((v.p[axis] - lo) / range * slabCount));
+                }
+            }
+
+        public:
+
+            mesh_simplifier(const geometry & g, const mesh_simplify_options & opts) : input(g), options(opts)
+            {
+                slabCount = std::max(1u, std::min(16u, static_cast<uint32_t>(std::thread::hardware_concurrency())));
+
+                verts.resize(g.vertices.size());
+                for (size_t i = 0; i < g.vertices.size(); ++i) verts[i].p = g.vertices[i];
+                spillStart.assign(verts.size(), -1);
+                spillBucket.assign(verts.size(), 0);
+                spillRefs.resize(slabCount + 1); // + 1: serial sweep spill
+
+                tris.resize(g.faces.size());
+                for (size_t i = 0; i < g.faces.size(); ++i)
+                {
+                    tris[i].v[0] = g.faces[i].x;
+                    tris[i].v[1] = g.faces[i].y;
+                    tris[i].v[2] = g.faces[i].z;
+                    if (i < g.material.size()) tris[i].material = g.material[i];
+                }
+
+                normals = g.normals;
+                texcoord0 = g.texcoord0;
+                texcoord1 = g.texcoord1;
+                colors = g.colors;
+                tangents = g.tangents;
+                bitangents = g.bitangents;
+            }
+
+            geometry run()
+            {
+                update_mesh(true);
+
+                // Initial edge errors, embarrassingly parallel
+                parallel_for(0, tris.size(), 4096, [this](size_t i)
+                {
+                    triangle & t = tris[i];
+                    float3 p;
+                    t.err[0] = calculate_error(t.v[0], t.v[1], p);
+                    t.err[1] = calculate_error(t.v[1], t.v[2], p);
+                    t.err[2] = calculate_error(t.v[2], t.v[0], p);
+                    t.err[3] = std::min(t.err[0], std::min(t.err[1], t.err[2]));
+                });
+
+                const uint32_t target = options.target_triangle_count;
+                const double maxError = options.max_error;
+
+                for (uint32_t iteration = 0; iteration < options.max_iterations; ++iteration)
+                {
+                    if (target > 0 && tris.size() - deletedTriangles <= target) break;
+                    if (iteration > 0 && iteration % 5 == 0) update_mesh(false);
+
+                    for (auto & t : tris) t.dirty = false;
+
+                    // Rising threshold schedule; the error bound caps it permanently
+                    double threshold = 1e-9 * std::pow(static_cast<double>(iteration) + 3.0, static_cast<double>(options.aggressiveness));
+                    const bool thresholdSaturated = threshold >= maxError;
+                    if (thresholdSaturated) threshold = maxError;
+
+                    // Bucket candidate edges by slab; rings that cross a slab go to the
+                    // serial bucket so no two workers can touch the same triangle
+                    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> candidates(slabCount + 1); // (tri, edge)
+                    for (uint32_t i = 0; i < tris.size(); ++i)
+                    {
+                        const triangle & t = tris[i];
+                        if (t.deleted || t.dirty || t.err[3] > threshold) continue;
+                        for (uint32_t e = 0; e < 3; ++e)
+                        {
+                            if (t.err[e] > threshold) continue;
+                            const uint32_t i0 = t.v[e], i1 = t.v[(e + 1) % 3];
+                            if (verts[i0].locked || verts[i1].locked) continue;
+                            const uint32_t s = verts[i0].slab;
+                            candidates[ring_interior_to_slab(i0, i1, s) ? s : slabCount].push_back({ i, e });
+                        }
+                    }
+
+                    // A pass without a deletion budget can blow straight through the
+                    // target (a high-threshold pass will happily collapse everything),
+                    // so workers share the remaining quota through a relaxed atomic
+                    const uint32_t passBudget = (target > 0)
+                        ? static_cast<uint32_t>(tris.size()) - deletedTriangles - target
+                        : std::numeric_limits<uint32_t>::max();
+                    std::atomic<uint32_t> deletedThisPass{ 0 };
+
+                    auto drain = [&](const uint32_t s)
+                    {
+                        std::vector<bool> deleted0, deleted1;
+                        for (const auto & c : candidates[s])
+                        {
+                            if (deletedThisPass.load(std::memory_order_relaxed) >= passBudget) break;
+
+                            triangle & t = tris[c.first];
+                            if (t.deleted || t.dirty || t.err[3] > threshold) continue;
+                            if (t.err[c.second] > threshold) continue;
+
+                            const uint32_t i0 = t.v[c.second], i1 = t.v[(c.second + 1) % 3];
+                            if (verts[i0].locked || verts[i1].locked) continue;
+                            if (s != slabCount && !ring_interior_to_slab(i0, i1, s)) continue; // ring grew past the slab since bucketing
+
+                            float3 p;
+                            if (calculate_error(i0, i1, p) > threshold) continue;
+
+                            uint32_t delta = 0;
+                            try_collapse(i0, i1, p, deleted0, deleted1, s, delta);
+                            if (delta) deletedThisPass.fetch_add(delta, std::memory_order_relaxed);
+                        }
+                    };
+
+                    parallel_for(0, static_cast<size_t>(slabCount), 1, [&](size_t s) { drain(static_cast<uint32_t>(s)); });
+                    drain(slabCount);
+
+                    deletedTriangles += deletedThisPass.load();
+
+                    // Converged: nothing under the ceiling collapses any more
+                    if (deletedThisPass.load() == 0 && thresholdSaturated) break;
+                }
+
+                return build_output();
+            }
+
+        private:
+
+            geometry build_output()
+            {
+                geometry out;
+
+                std::vector<uint32_t> remap(verts.size(), ~0u);
+                uint32_t vertexCount = 0;
+
+                for (const auto & t : tris)
+                {
+                    if (t.deleted) continue;
+                    for (int c = 0; c < 3; ++c) if (remap[t.v[c]] == ~0u) remap[t.v[c]] = vertexCount++;
+                }
+
+                out.vertices.resize(vertexCount);
+                if (!normals.empty()) out.normals.resize(vertexCount);
+                if (!texcoord0.empty()) out.texcoord0.resize(vertexCount);
+                if (!texcoord1.empty()) out.texcoord1.resize(vertexCount);
+                if (!colors.empty()) out.colors.resize(vertexCount);
+                if (!tangents.empty()) out.tangents.resize(vertexCount);
+                if (!bitangents.empty()) out.bitangents.resize(vertexCount);
+
+                for (uint32_t i = 0; i < verts.size(); ++i)
+                {
+                    if (remap[i] == ~0u) continue;
+                    out.vertices[remap[i]] = verts[i].p;
+                    if (!normals.empty()) out.normals[remap[i]] = normals[i];
+                    if (!texcoord0.empty()) out.texcoord0[remap[i]] = texcoord0[i];
+                    if (!texcoord1.empty()) out.texcoord1[remap[i]] = texcoord1[i];
+                    if (!colors.empty()) out.colors[remap[i]] = colors[i];
+                    if (!tangents.empty()) out.tangents[remap[i]] = tangents[i];
+                    if (!bitangents.empty()) out.bitangents[remap[i]] = bitangents[i];
+                }
+
+                const bool hasMaterials = !input.material.empty();
+                for (const auto & t : tris)
+                {
+                    if (t.deleted) continue;
+                    out.faces.push_back({ remap[t.v[0]], remap[t.v[1]], remap[t.v[2]] });
+                    if (hasMaterials) out.material.push_back(t.material);
+                }
+
+                return out;
+            }
+        };
+
+    } // end namespace detail
+
+    inline geometry simplify_mesh(const geometry & g, const mesh_simplify_options & options = {})
+    {
+        if (g.faces.empty() || g.vertices.empty()) return g;
+        detail::mesh_simplifier simplifier(g, options);
+        return simplifier.run();
+    }
+
+} // end namespace polymer
+
+#endif // end polymer_mesh_simplify_hpp
@@ -0,0 +1,80 @@
+#pragma once
+
+#ifndef polymer_morton_hpp
+#define polymer_morton_hpp
+
+#include "math-common.hpp"
+#include "math-primitives.hpp"
+#include "radix_sort.hpp"
+
+namespace polymer
+{
+    //////////////////////
+    //   morton codes   //
+    //////////////////////
+
+    // 63-bit Morton (Z-order) codes: 21 bits per axis, bit-interleaved so that
+    // keys close in value are close in space. Sorting entities/leaves by their
+    // code turns spatially-random creation-order iteration into a cache-coherent
+    // walk — neighbouring objects end up in neighbouring slots, so bounds fetches
+    // during culling, streaming, and physics stop missing on every element.
+
+    // Spreads the low 21 bits of v so each lands on every third bit
+    inline uint64_t morton_expand_bits(uint64_t v)
+    {
+        v &= 0x1fffff;
+        v = (v | v << 32) & 0x001f00000000ffffull;
+        v = (v | v << 16) & 0x001f0000ff0000ffull;
+        v = (v | v << 8)  & 0x100f00f00f00f00full;
+        v = (v | v << 4)  & 0x10c30c30c30c30c3ull;
+        v = (v | v << 2)  & 0x1249249249249249ull;
+        return v;
+    }
+
+    // Interleaves three 21-bit integer coordinates (x in the lowest bit)
+    inline uint64_t morton_encode(const uint32_t x, const uint32_t y, const uint32_t z)
+    {
+        return morton_expand_bits(x) | (morton_expand_bits(y) << 1) | (morton_expand_bits(z) << 2);
+    }
+
+    // Quantizes a world-space position into the bounds' 21-bits-per-axis grid
+    // and interleaves. Positions outside the bounds clamp to the boundary cells.
+    inline uint64_t morton_encode(const float3 & position, const aabb_3d & bounds)
+    {
+        const float3 extent = linalg::max(bounds.size(), float3(1e-6f)); // degenerate axes quantize to cell zero
+        const float3 normalized = (position - bounds.min()) / extent;
+        const float max_coord = 2097151.f; // (1 << 21) - 1
+        const uint32_t x = static_cast<uint32_t>(clamp(normalized.x, 0.f, 1.f) * max_coord);
+        const uint32_t y = static_cast<uint32_t>(clamp(normalized.y, 0.f, 1.f) * max_coord);
+        const uint32_t z = static_cast<uint32_t>(clamp(normalized.z, 0.f, 1.f) * max_coord);
+        return morton_encode(x, y, z);
+    }
+
+    // Fills `indices` with the permutation that visits `positions` in Morton
+    // order (radix-sorted, so the cost is linear in count). The bounds are
+    // computed from the positions themselves.
+    inline void morton_sort_indices(const float3 * positions, const size_t count, uint32_t * indices)
+    {
+        if (count == 0) return;
+
+        aabb_3d bounds(positions[0], positions[0]);
+        for (size_t i = 1; i < count; ++i)
+        {
+            bounds._min = linalg::min(bounds._min, positions[i]);
+            bounds._max = linalg::max(bounds._max, positions[i]);
+        }
+
+        std::vector<uint64_t> keys(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            keys[i] = morton_encode(positions[i], bounds);
+            indices[i] = static_cast<uint32_t>(i);
+        }
+
+        radix_sort sorter;
+        sorter.sort_pairs(keys.data(), indices, count);
+    }
+
+} // end namespace polymer
+
+#endif // end polymer_morton_hpp
@@ -7,9 +7,17 @@
 #define movement_tracker_hpp
 
 #include "math-common.hpp"
+#include "util.hpp"
 #include <deque>
 #include <utility>
 #include <memory>
+#include <vector>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POLYMER_MOVEMENT_TRACKER_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace polymer
 {
@@ -88,7 +96,7 @@ namespace polymer
         // Last movement delta
         T rel() const
         {
-            assert(size() >= 2);
+            POLYMER_ASSERT_HOT(size() >= 2); // queried per-frame by interaction code; elided in shipping
             return timeList[timeList.size() - 1].where - timeList[timeList.size() - 2].where;
         }
 
@@ -149,6 +157,211 @@ namespace polymer
 
     };
 
+    // SoA batch variant of movement_tracker for N scalar channels sampled on the same
+    // clock (per-joint hand tracking, controller axes). One shared time ring replaces
+    // N per-object deques, frames are stored frame-major in one contiguous array, and
+    // velocity() resolves the window start index once and then differences all channels
+    // four at a time. A vec3 position contributes three channels, laid out flat.
+    class movement_tracker_batch
+    {
+        size_t channelCount{ 0 };
+        size_t capacity{ 0 };
+
+        std::vector<float> frames;  // capacity * channelCount, frame-major ring
+        std::vector<double> times;  // capacity, shared by all channels
+        size_t head{ 0 };           // index of the oldest frame
+        size_t count{ 0 };
+
+        static double velocity_time() { return 0.5; }   // window over which velocity is averaged
+        static double max_history() { return 30.0; }    // drop frames older than this (seconds)
+
+        size_t frame_index(const size_t logical) const { return (head + logical) % capacity; }
+
+    public:
+
+        movement_tracker_batch(const size_t num_channels, const size_t frame_capacity = 64)
+            : channelCount(num_channels), capacity(frame_capacity), frames(frame_capacity * num_channels, 0.f), times(frame_capacity, 0.0) {}
+
+        void clear() { head = 0; count = 0; }
+
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+        size_t channels() const { return channelCount; }
+
+        double latest_time() const { return times[frame_index(count - 1)]; }
+        const float * latest_frame() const { return frames.data() + frame_index(count - 1) * channelCount; }
+
+        // Append one frame of channels() values; evicts frames older than max_history()
+        void add(const float * values, const double time)
+        {
+            // Flush out old entries (and the oldest frame when the ring is full)
+            while (count > 0 && (count == capacity || times[head] < time - max_history()))
+            {
+                head = (head + 1) % capacity;
+                --count;
+            }
+
+            const size_t slot = frame_index(count);
+            std::memcpy(frames.data() + slot * channelCount, values, channelCount * sizeof(float));
+            times[slot] = time;
+            ++count;
+        }
+
+        // Average velocity per channel over the last velocity_time() seconds, written to
+        // `out` (channels() floats). Zeros when there isn't enough history.
+        void velocity(const double now, float * out) const
+        {
+            std::memset(out, 0, channelCount * sizeof(float));
+            if (count < 2) return;
+
+            // Shared window start: first frame inside the velocity window
+            size_t begin = count; // invalid
+            for (size_t i = 0; i < count - 1; ++i)
+            {
+                if (now - times[frame_index(i)] < velocity_time()) { begin = i; break; }
+            }
+            if (begin == count) return;
+
+            const double dt = times[frame_index(count - 1)] - times[frame_index(begin)];
+            if (dt <= 0) return;
+
+            const float invDt = static_cast<float>(1.0 / dt);
+            const float * first = frames.data() + frame_index(begin) * channelCount;
+            const float * last = frames.data() + frame_index(count - 1) * channelCount;
+
+            size_t i = 0;
+
+#if defined(POLYMER_MOVEMENT_TRACKER_SSE2)
+            const __m128 vInvDt = _mm_set1_ps(invDt);
+            for (; i + 4 <= channelCount; i += 4)
+            {
+                _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(last + i), _mm_loadu_ps(first + i)), vInvDt));
+            }
+#endif
+
+            for (; i < channelCount; ++i) out[i] = (last[i] - first[i]) * invDt;
+        }
+
+        void velocity(float * out) const
+        {
+            if (count < 2) { std::memset(out, 0, channelCount * sizeof(float)); return; }
+            velocity(latest_time(), out);
+        }
+    };
+
+    //////////////////////////////
+    //   motion_history_store   //
+    //////////////////////////////
+
+    // Columnar motion history for crowds of recorded or networked entities. One store
+    // replaces N individual trackers: a fixed ring of whole-scene frames where each
+    // frame keeps every object's position and orientation contiguously (SoA,
+    // frame-major), recorded on a shared clock. Playback resolves the two frames
+    // bracketing the requested time once, then interpolates every object in a single
+    // linear sweep over the two frame rows - lerp for positions, hemisphere-corrected
+    // nlerp for orientations - instead of walking hundreds of per-object deques.
+    class motion_history_store
+    {
+        size_t objectCount{ 0 };
+        size_t capacity{ 0 };
+
+        std::vector<float3> positions;    // capacity * objectCount, frame-major ring
+        std::vector<quatf> orientations;  // capacity * objectCount, frame-major ring
+        std::vector<double> times;        // capacity, shared by all objects
+        size_t head{ 0 };                 // index of the oldest frame
+        size_t count{ 0 };
+
+        size_t frame_index(const size_t logical) const { return (head + logical) % capacity; }
+
+        void copy_frame(const size_t logical, float3 * out_pos, quatf * out_rot) const
+        {
+            std::memcpy(out_pos, positions.data() + frame_index(logical) * objectCount, objectCount * sizeof(float3));
+            std::memcpy(out_rot, orientations.data() + frame_index(logical) * objectCount, objectCount * sizeof(quatf));
+        }
+
+    public:
+
+        motion_history_store(const size_t num_objects, const size_t frame_capacity = 128)
+            : objectCount(num_objects), capacity(frame_capacity),
+              positions(frame_capacity * num_objects, float3()),
+              orientations(frame_capacity * num_objects, quatf(0, 0, 0, 1)),
+              times(frame_capacity, 0.0) {}
+
+        void clear() { head = 0; count = 0; }
+
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+        size_t objects() const { return objectCount; }
+
+        double start_time() const { return times[frame_index(0)]; }
+        double latest_time() const { return times[frame_index(count - 1)]; }
+
+        // Append one frame for all objects. Times must be monotonically increasing;
+        // the oldest frame is evicted when the ring is full.
+        void add_frame(const float3 * pos, const quatf * rot, const double time)
+        {
+            if (count == capacity) { head = (head + 1) % capacity; --count; }
+            const size_t slot = frame_index(count);
+            std::memcpy(positions.data() + slot * objectCount, pos, objectCount * sizeof(float3));
+            std::memcpy(orientations.data() + slot * objectCount, rot, objectCount * sizeof(quatf));
+            times[slot] = time;
+            ++count;
+        }
+
+        // Writes the interpolated pose of every object at `play_time` (clamped to the
+        // recorded range) to out_pos / out_rot, objects() entries each.
+        void sample(const double play_time, float3 * out_pos, quatf * out_rot) const
+        {
+            if (count == 0) return;
+
+            // Binary search for the first frame at or after play_time (shared by the
+            // whole crowd; times are monotonic in logical order)
+            size_t lo = 0, hi = count;
+            while (lo < hi)
+            {
+                const size_t mid = (lo + hi) / 2;
+                if (times[frame_index(mid)] < play_time) lo = mid + 1;
+                else hi = mid;
+            }
+
+            if (lo == 0) { copy_frame(0, out_pos, out_rot); return; }
+            if (lo == count) { copy_frame(count - 1, out_pos, out_rot); return; }
+
+            const size_t f0 = lo - 1, f1 = lo;
+            const double t0 = times[frame_index(f0)], t1 = times[frame_index(f1)];
+            const float t = static_cast<float>((play_time - t0) / (t1 - t0));
+
+            // Positions are one flat float stream per frame; blend four lanes at a time
+            const float * a = reinterpret_cast<const float *>(positions.data() + frame_index(f0) * objectCount);
+            const float * b = reinterpret_cast<const float *>(positions.data() + frame_index(f1) * objectCount);
+            float * outf = reinterpret_cast<float *>(out_pos);
+            const size_t n = objectCount * 3;
+
+            size_t i = 0;
+
+#if defined(POLYMER_MOVEMENT_TRACKER_SSE2)
+            const __m128 vt = _mm_set1_ps(t);
+            for (; i + 4 <= n; i += 4)
+            {
+                const __m128 va = _mm_loadu_ps(a + i);
+                _mm_storeu_ps(outf + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + i), va), vt)));
+            }
+#endif
+
+            for (; i < n; ++i) outf[i] = a[i] + (b[i] - a[i]) * t;
+
+            const quatf * q0 = orientations.data() + frame_index(f0) * objectCount;
+            const quatf * q1 = orientations.data() + frame_index(f1) * objectCount;
+
+            for (size_t j = 0; j < objectCount; ++j)
+            {
+                const quatf & qa = q0[j];
+                const quatf qb = (dot(qa, q1[j]) < 0.f) ? quatf(-q1[j].x, -q1[j].y, -q1[j].z, -q1[j].w) : q1[j];
+                out_rot[j] = nlerp(qa, qb, t);
+            }
+        }
+    };
+
 } // end namespace polymer
 
 #endif // end movement_tracker_hpp
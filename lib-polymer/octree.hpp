@@ -2,10 +2,11 @@
  * An octree is a tree data structure in which each internal node has exactly
  * eight children. Octrees are most often used to partition a three
  * dimensional space by recursively subdividing it into eight octants.
- * This implementation stores 8 pointers per node, instead of the other common
- * approach, which is to use a flat array with an offset. The `inside` method
- * defines the comparison function (loose in this case). The main usage of this
- * class is for basic frustum culling.
+ * The original `octree` stores 8 pointers per node; `flat_octree` below implements
+ * the other common approach - a contiguous node array with 32-bit indices, which
+ * culls considerably faster on large trees because traversal stops chasing pointers
+ * across the heap. The `inside` method defines the comparison function (loose in
+ * this case). The main usage of these classes is for basic frustum culling.
  */
 
 #pragma once
@@ -19,8 +20,11 @@
 #include "util.hpp"
 #include "algo_misc.hpp"
 
+#include "thread-pool.hpp"
+
 #include <list>
 #include <memory>
+#include <future>
 
 namespace polymer
 {
@@ -50,6 +54,7 @@ namespace polymer
         aabb_3d box;
         voxel_array<std::unique_ptr<octant<T>>> arr = { { 2, 2, 2 } };
         uint32_t occupancy{ 0 };
+        uint32_t depth{ 0 }; // distance from the root, set at creation (refit re-descends from here)
 
         int3 get_indices(const aabb_3d & other) const
         {
@@ -112,6 +117,19 @@ namespace polymer
         std::unique_ptr<octant<T>> root;
         uint32_t maxDepth{ 8 };
 
+        // Octant bounds inflation factor. At 1 every boundary crossing re-inserts the node
+        // (and cascades occupancy updates up the parent chain); at 2 - the classic loose
+        // octree - a moving object stays in its cell until it exits the doubled bounds, so
+        // update() is a cheap containment check in the common case. Set before inserting.
+        float looseness{ 1.f };
+
+        // Runtime cull tuning. Refinement stops and the subtree is appended wholesale once
+        // a node is deeper than `cullDepthBudget` or holds `cullOccupancyThreshold` or fewer
+        // objects - testing a handful of candidates downstream is cheaper than walking their
+        // octants. Defaults preserve full refinement; tune per scene scale.
+        uint32_t cullDepthBudget{ 0xffffffffu };
+        uint32_t cullOccupancyThreshold{ 0 };
+
         octree(const uint32_t maxDepth = 8, const aabb_3d rootBounds = { { -1, -1, -1 },{ +1, +1, +1 } })
         {
             root.reset(new octant<T>(nullptr));
@@ -129,7 +147,11 @@ namespace polymer
 
             const aabb_3d bounds = sceneNode.worldspaceBounds;
 
-            if (depth < maxDepth && child->check_fit(bounds))
+            // With inflated octants an object up to `looseness` times the strict half-size
+            // still fits a child, which keeps it deeper in the tree
+            const bool fits = all(lequal(bounds.size(), child->box.size() * (0.5f * looseness)));
+
+            if (depth < maxDepth && fits)
             {
                 int3 lookup = child->get_indices(bounds);
 
@@ -137,6 +159,7 @@ namespace polymer
                 if (child->arr[lookup] == nullptr)
                 {
                     child->arr[lookup].reset(new octant<T>(child));
+                    child->arr[lookup]->depth = child->depth + 1;
 
                     const float3 octantMin = child->box.min();
                     const float3 octantMax = child->box.max();
@@ -193,14 +216,77 @@ namespace polymer
 
             const aabb_3d box = sceneNode.worldspaceBounds;
 
+            // Loose mode: the node stays put while its bounds remain within the octant's
+            // inflated box - no re-insertion, no occupancy cascade
+            if (looseness > 1.f)
+            {
+                const float3 halfInflated = sceneNode.octant->box.size() * (0.5f * looseness);
+                const float3 octantCenter = sceneNode.octant->box.center();
+                if (linalg::all(gequal(box.min(), octantCenter - halfInflated)) &&
+                    linalg::all(lequal(box.max(), octantCenter + halfInflated)))
+                {
+                    return;
+                }
+
+                refit(sceneNode);
+                return;
+            }
+
             // Check if this scene node has bounds that are not consistent with its assigned octant
             if (!(inside(box, sceneNode.octant->box)))
             {
-                remove(sceneNode);
-                create(sceneNode);
+                refit(sceneNode);
             }
         }
 
+        // Relocates a node whose bounds escaped its octant. Instead of remove() + create()
+        // (which re-descends from the root every time), detach and walk up only until an
+        // ancestor can host the new bounds again, then re-descend from there - for small
+        // motion the walk stops after a level or two. Lands the object in exactly the octant
+        // create() would pick: an ancestor containing the object's center lies on the root's
+        // descent path, and add() navigates identically from that point.
+        void refit(node_container<T> & sceneNode)
+        {
+            const aabb_3d bounds = sceneNode.worldspaceBounds;
+
+            octant<T> * oct = sceneNode.octant;
+            oct->decrease_occupancy(oct);
+            oct->objects.erase(std::find(oct->objects.begin(), oct->objects.end(), sceneNode));
+            sceneNode.octant = nullptr;
+
+            octant<T> * host = oct;
+            while (host->parent != nullptr)
+            {
+                const float3 c = bounds.center();
+                const bool centerInside = linalg::all(gequal(c, host->box.min())) && linalg::all(lequal(c, host->box.max()));
+                const bool fits = all(lequal(bounds.size(), host->box.size() * (0.5f * looseness)));
+                if (centerInside && fits) break;
+                host = host->parent;
+            }
+
+            add(sceneNode, host, host->depth);
+        }
+
+        // Deferred structural maintenance: refit() leaves emptied octants in place rather
+        // than restructuring mid-update. Call once per frame to release up to `budget`
+        // empty subtrees (occupancy counts the whole subtree, so an empty octant can be
+        // dropped wholesale); the work amortizes across frames instead of spiking.
+        uint32_t rebalance(const uint32_t budget = 64, octant<T> * node = nullptr)
+        {
+            if (!node) node = root.get();
+
+            uint32_t released = 0;
+            for (int x : { 0, 1 }) for (int y : { 0, 1 }) for (int z : { 0, 1 })
+            {
+                if (released >= budget) return released;
+                std::unique_ptr<octant<T>> & child = node->arr[{x, y, z}];
+                if (child == nullptr) continue;
+                if (child->occupancy == 0) { child.reset(); ++released; }
+                else released += rebalance(budget - released, child.get());
+            }
+            return released;
+        }
+
         void remove(node_container<T> & sceneNode)
         {
             if (sceneNode.octant == nullptr)
@@ -214,46 +300,354 @@ namespace polymer
             sceneNode.octant = nullptr;
         }
 
-        void cull(const frustum & camera, std::vector<octant<T> *> & visibleNodeList, octant<T> * node, bool alreadyVisible)
+        // Appends an entire subtree known to be visible, skipping the per-node plane tests
+        // `VisibleList` is any container of octant<T> pointers with push_back
+        // (std::vector, small_vector, ...)
+        template<typename VisibleList>
+        void append_subtree(octant<T> * node, VisibleList & visibleNodeList)
+        {
+            if (!node || node->occupancy == 0) return;
+
+            visibleNodeList.push_back(node);
+
+            octant<T> * child;
+            if ((child = node->arr[{0, 0, 0}].get()) != nullptr) append_subtree(child, visibleNodeList);
+            if ((child = node->arr[{0, 0, 1}].get()) != nullptr) append_subtree(child, visibleNodeList);
+            if ((child = node->arr[{0, 1, 0}].get()) != nullptr) append_subtree(child, visibleNodeList);
+            if ((child = node->arr[{0, 1, 1}].get()) != nullptr) append_subtree(child, visibleNodeList);
+            if ((child = node->arr[{1, 0, 0}].get()) != nullptr) append_subtree(child, visibleNodeList);
+            if ((child = node->arr[{1, 0, 1}].get()) != nullptr) append_subtree(child, visibleNodeList);
+            if ((child = node->arr[{1, 1, 0}].get()) != nullptr) append_subtree(child, visibleNodeList);
+            if ((child = node->arr[{1, 1, 1}].get()) != nullptr) append_subtree(child, visibleNodeList);
+        }
+
+        template<typename VisibleList>
+        void cull(const frustum & camera, VisibleList & visibleNodeList, octant<T> * node, bool alreadyVisible)
         {
             if (!node) node = root.get();
+            if (node->occupancy == 0) return; // empty subtree: occupancy is cumulative
+
+            if (alreadyVisible)
+            {
+                append_subtree(node, visibleNodeList);
+                return;
+            }
+
+
+            // Residents may overhang their octant: |object center - octant center| <= half and
+            // object size <= looseness * half, so half * max(looseness, 1 + looseness / 2)
+            // bounds everything stored here (the inflated bounds once looseness >= 2)
+            const float inflation = std::max(looseness, 1.f + 0.5f * looseness);
+            const float3 center = node->box.center();
+            const float3 half = node->box.size() * (0.5f * inflation);
+
+            if (camera.contains_aabb(center, half))
+            {
+                // The whole subtree is visible: append it without testing another plane
+                append_subtree(node, visibleNodeList);
+                return;
+            }
+
+            if (!camera.intersects_aabb(center, half)) return;
+
+            // Partially visible but over the depth budget or down to a trivial population:
+            // stop refining and hand the remaining candidates to the per-object test
+            if (node->depth >= cullDepthBudget || node->occupancy <= cullOccupancyThreshold)
+            {
+                append_subtree(node, visibleNodeList);
+                return;
+            }
+
+            // Partially visible: this node's own objects stay candidates, children are refined
+            visibleNodeList.push_back(node);
+
+            octant<T> * child;
+            if ((child = node->arr[{0, 0, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+            if ((child = node->arr[{0, 0, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+            if ((child = node->arr[{0, 1, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+            if ((child = node->arr[{0, 1, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+            if ((child = node->arr[{1, 0, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+            if ((child = node->arr[{1, 0, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+            if ((child = node->arr[{1, 1, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+            if ((child = node->arr[{1, 1, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, false);
+        }
+
+        // Parallel cull: the eight root subtrees fan out across `pool`, each task filling its
+        // own visible vector (no shared state during traversal), merged into `visibleNodeList`
+        // once every future resolves. Useful when several culls run per frame - two stereo
+        // views plus the shadow cascades would otherwise serialize on one core. The tree must
+        // not be mutated while culls are in flight.
+        template<typename VisibleList>
+        void cull_parallel(simple_thread_pool & pool, const frustum & camera, VisibleList & visibleNodeList)
+        {
+            octant<T> * node = root.get();
             if (node->occupancy == 0) return;
 
-            visibility status = visibility::outside;
+            std::vector<std::future<std::vector<octant<T> *>>> pending;
+            pending.reserve(8);
 
-            if (alreadyVisible)
+            for (int x : { 0, 1 }) for (int y : { 0, 1 }) for (int z : { 0, 1 })
             {
-                status = visibility::inside;
+                octant<T> * child = node->arr[{x, y, z}].get();
+                if (!child || child->occupancy == 0) continue;
+
+                pending.push_back(pool.enqueue([this, child, &camera]()
+                {
+                    std::vector<octant<T> *> localVisible;
+                    cull(camera, localVisible, child, false);
+                    return localVisible;
+                }));
             }
-            else if (node == root.get())
+
+            for (auto & f : pending)
             {
-                status = visibility::intersect;
+                const std::vector<octant<T> *> localVisible = f.get();
+                for (octant<T> * n : localVisible) visibleNodeList.push_back(n);
+            }
+        }
+
+        // Collects every occupied octant the ray passes through, testing against the
+        // inflated (loose) bounds so overhanging objects are never missed. Same
+        // occupancy-based early-out as cull().
+        void query_ray(const ray & r, std::vector<octant<T> *> & hitNodeList, octant<T> * node = nullptr)
+        {
+            if (!node) node = root.get();
+            if (node->occupancy == 0) return;
+
+            const float3 halfInflated = node->box.size() * (0.5f * std::max(looseness, 1.f));
+            const float3 octantCenter = node->box.center();
+
+            float outMinT, outMaxT;
+            if (!intersect_ray_box(r, octantCenter - halfInflated, octantCenter + halfInflated, &outMinT, &outMaxT)) return;
+            if (outMaxT < 0.f) return;
+
+            if (!node->objects.empty()) hitNodeList.push_back(node);
+
+            octant<T> * child;
+            if ((child = node->arr[{0, 0, 0}].get()) != nullptr) query_ray(r, hitNodeList, child);
+            if ((child = node->arr[{0, 0, 1}].get()) != nullptr) query_ray(r, hitNodeList, child);
+            if ((child = node->arr[{0, 1, 0}].get()) != nullptr) query_ray(r, hitNodeList, child);
+            if ((child = node->arr[{0, 1, 1}].get()) != nullptr) query_ray(r, hitNodeList, child);
+            if ((child = node->arr[{1, 0, 0}].get()) != nullptr) query_ray(r, hitNodeList, child);
+            if ((child = node->arr[{1, 0, 1}].get()) != nullptr) query_ray(r, hitNodeList, child);
+            if ((child = node->arr[{1, 1, 0}].get()) != nullptr) query_ray(r, hitNodeList, child);
+            if ((child = node->arr[{1, 1, 1}].get()) != nullptr) query_ray(r, hitNodeList, child);
+        }
+    };
+
+    //////////////////////////////////////
+    //   flat-array octree (cull-fast)   //
+    //////////////////////////////////////
+
+    // Container for `flat_octree`, identical to node_container except the owning octant is
+    // referred to by index (node storage is a re-allocating vector, so pointers are unstable)
+    template<typename T>
+    struct flat_node_container
+    {
+        static const uint32_t kInvalidNode = 0xffffffff;
+        T & object;
+        uint32_t node{ kInvalidNode };
+        aabb_3d worldspaceBounds;
+        flat_node_container(T & obj, const aabb_3d & bounds) : object(obj), worldspaceBounds(bounds) {}
+        bool operator== (const flat_node_container<T> & other) { return &object == &other.object; }
+    };
+
+    // Same create/update/remove/cull surface as `octree`, backed by one contiguous node array.
+    // A node's eight children occupy consecutive slots starting at `firstChild` (slot index is
+    // (x << 2) | (y << 1) | z), so a cull walks laid-out-together memory instead of chasing
+    // per-child heap allocations - the pointer tree is memory-latency bound, not compute bound.
+    template<typename T>
+    struct flat_octree
+    {
+        static const uint32_t kInvalidNode = 0xffffffff;
+
+        struct node
+        {
+            aabb_3d box;
+            uint32_t parent{ kInvalidNode };
+            uint32_t firstChild{ kInvalidNode }; // 8 consecutive slots, or kInvalidNode for a leaf
+            uint32_t occupancy{ 0 };
+            uint32_t depth{ 0 };
+            std::list<flat_node_container<T>> objects;
+        };
+
+        std::vector<node> nodes;
+        uint32_t maxDepth{ 8 };
+
+        // Runtime cull tuning, same semantics as octree::cullDepthBudget /
+        // cullOccupancyThreshold
+        uint32_t cullDepthBudget{ 0xffffffffu };
+        uint32_t cullOccupancyThreshold{ 0 };
+
+        flat_octree(const uint32_t maxDepth = 8, const aabb_3d rootBounds = { { -1, -1, -1 },{ +1, +1, +1 } }) : maxDepth(maxDepth)
+        {
+            nodes.reserve(512);
+            node root;
+            root.box = rootBounds;
+            nodes.push_back(root);
+        }
+
+        // Center-compare "loose" fit, identical to octree::inside
+        inline bool inside(const aabb_3d & nodeBounds, const aabb_3d & other) const
+        {
+            if (!(linalg::all(greater(other.max(), nodeBounds.center())) && linalg::all(less(other.min(), nodeBounds.center())))) return false;
+            return linalg::all(less(nodeBounds.size(), other.size()));
+        }
+
+        bool check_fit(const uint32_t nodeIndex, const aabb_3d & other) const
+        {
+            return all(lequal(other.size(), nodes[nodeIndex].box.size() * 0.5f));
+        }
+
+        uint32_t child_slot(const uint32_t nodeIndex, const aabb_3d & other) const
+        {
+            const float3 a = other.center();
+            const float3 b = nodes[nodeIndex].box.center();
+            return ((a.x > b.x ? 1u : 0u) << 2) | ((a.y > b.y ? 1u : 0u) << 1) | (a.z > b.z ? 1u : 0u);
+        }
+
+        // Allocates all eight children of a node in one contiguous block
+        void subdivide(const uint32_t nodeIndex)
+        {
+            const aabb_3d parentBox = nodes[nodeIndex].box; // copied: push_back may re-allocate
+            const uint32_t firstChild = static_cast<uint32_t>(nodes.size());
+
+            for (uint32_t slot = 0; slot < 8; ++slot)
+            {
+                const uint32_t ix = (slot >> 2) & 1, iy = (slot >> 1) & 1, iz = slot & 1;
+
+                float3 min, max;
+                const float3 boxMin = parentBox.min(), boxMax = parentBox.max(), boxCenter = parentBox.center();
+                min.x = ix ? boxCenter.x : boxMin.x; max.x = ix ? boxMax.x : boxCenter.x;
+                min.y = iy ? boxCenter.y : boxMin.y; max.y = iy ? boxMax.y : boxCenter.y;
+                min.z = iz ? boxCenter.z : boxMin.z; max.z = iz ? boxMax.z : boxCenter.z;
+
+                node child;
+                child.box = aabb_3d(min, max);
+                child.parent = nodeIndex;
+                child.depth = nodes[nodeIndex].depth + 1;
+                nodes.push_back(child);
+            }
+
+            nodes[nodeIndex].firstChild = firstChild;
+        }
+
+        void add(flat_node_container<T> & sceneNode, uint32_t nodeIndex, uint32_t depth = 0)
+        {
+            const aabb_3d bounds = sceneNode.worldspaceBounds;
+
+            if (depth < maxDepth && check_fit(nodeIndex, bounds))
+            {
+                if (nodes[nodeIndex].firstChild == kInvalidNode) subdivide(nodeIndex);
+                add(sceneNode, nodes[nodeIndex].firstChild + child_slot(nodeIndex, bounds), ++depth);
             }
             else
             {
-                if (camera.contains(node->box.center()))
-                {
-                    status = visibility::inside;
-                }
+                for (uint32_t n = nodeIndex; n != kInvalidNode; n = nodes[n].parent) nodes[n].occupancy++;
+                nodes[nodeIndex].objects.push_back(sceneNode);
+                sceneNode.node = nodeIndex;
             }
+        }
 
-            alreadyVisible = (status == visibility::inside);
+        void create(flat_node_container<T> & sceneNode)
+        {
+            if (!inside(sceneNode.worldspaceBounds, nodes[0].box))
+            {
+                throw std::invalid_argument("object is not in the bounding volume of the root node");
+            }
+            else
+            {
+                add(sceneNode, 0);
+            }
+        }
 
-            if (alreadyVisible)
+        void update(flat_node_container<T> & sceneNode)
+        {
+            if (sceneNode.node == kInvalidNode)
             {
-                visibleNodeList.push_back(node);
+                throw std::runtime_error("cannot update a scene node that is not present in the tree");
             }
 
-            // Recurse into children
-            octant<T> * child;
-            if ((child = node->arr[{0, 0, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
-            if ((child = node->arr[{0, 0, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
-            if ((child = node->arr[{0, 1, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
-            if ((child = node->arr[{0, 1, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
-            if ((child = node->arr[{1, 0, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
-            if ((child = node->arr[{1, 0, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
-            if ((child = node->arr[{1, 1, 0}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
-            if ((child = node->arr[{1, 1, 1}].get()) != nullptr) cull(camera, visibleNodeList, child, alreadyVisible);
+            if (!(inside(sceneNode.worldspaceBounds, nodes[sceneNode.node].box)))
+            {
+                refit(sceneNode);
+            }
+        }
+
+        // Ascend-then-descend relocation, mirroring octree::refit: the common small-motion
+        // case re-enters the tree from a nearby ancestor instead of the root
+        void refit(flat_node_container<T> & sceneNode)
+        {
+            const aabb_3d bounds = sceneNode.worldspaceBounds;
+            const uint32_t previous = sceneNode.node;
+            remove(sceneNode);
+
+            uint32_t host = previous;
+            while (nodes[host].parent != kInvalidNode)
+            {
+                const float3 c = bounds.center();
+                const bool centerInside = linalg::all(gequal(c, nodes[host].box.min())) && linalg::all(lequal(c, nodes[host].box.max()));
+                if (centerInside && check_fit(host, bounds)) break;
+                host = nodes[host].parent;
+            }
+
+            add(sceneNode, host, nodes[host].depth);
+        }
+
+        void remove(flat_node_container<T> & sceneNode)
+        {
+            if (sceneNode.node == kInvalidNode)
+            {
+                throw std::runtime_error("cannot remove a scene node that is not present in the tree");
+            }
+
+            node & oct = nodes[sceneNode.node];
+            for (uint32_t n = sceneNode.node; n != kInvalidNode; n = nodes[n].parent) nodes[n].occupancy--;
+            oct.objects.erase(std::find(oct.objects.begin(), oct.objects.end(), sceneNode));
+            sceneNode.node = kInvalidNode;
+        }
+
+        template<typename VisibleList>
+        void append_subtree(const uint32_t nodeIndex, VisibleList & visibleNodeList)
+        {
+            if (nodes[nodeIndex].occupancy == 0) return;
+
+            visibleNodeList.push_back(nodeIndex);
+
+            const uint32_t firstChild = nodes[nodeIndex].firstChild;
+            if (firstChild == kInvalidNode) return;
+            for (uint32_t slot = 0; slot < 8; ++slot) append_subtree(firstChild + slot, visibleNodeList);
+        }
+
+        template<typename VisibleList>
+        void cull(const frustum & camera, VisibleList & visibleNodeList, uint32_t nodeIndex = 0, bool alreadyVisible = false)
+        {
+            if (nodes[nodeIndex].occupancy == 0) return;
+
+            // Residents can overhang their octant by up to half its extent (see add), so the
+            // classification box is the octant inflated by 1.5x
+            const float3 center = nodes[nodeIndex].box.center();
+            const float3 half = nodes[nodeIndex].box.size() * 0.75f;
+
+            if (alreadyVisible || camera.contains_aabb(center, half))
+            {
+                append_subtree(nodeIndex, visibleNodeList);
+                return;
+            }
+
+            if (!camera.intersects_aabb(center, half)) return;
+
+            if (nodes[nodeIndex].depth >= cullDepthBudget || nodes[nodeIndex].occupancy <= cullOccupancyThreshold)
+            {
+                append_subtree(nodeIndex, visibleNodeList);
+                return;
+            }
+
+            visibleNodeList.push_back(nodeIndex);
+
+            const uint32_t firstChild = nodes[nodeIndex].firstChild;
+            if (firstChild == kInvalidNode) return;
+            for (uint32_t slot = 0; slot < 8; ++slot) cull(camera, visibleNodeList, firstChild + slot, false);
         }
     };
 
@@ -17,6 +17,13 @@
 
 #include "math-common.hpp"
 
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POLYMER_ONE_EURO_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace impl
 {
     using namespace linalg;
@@ -190,4 +197,111 @@ struct one_euro_filter_quat : public impl::one_euro_filter<impl::quaternion_filt
     }
 };
 
+// SoA batch variant: filters N independent scalar channels in one pass over two
+// contiguous state arrays, four channels per SSE iteration. Running ~50 separate
+// one_euro_filter_vec objects (per joint, per controller) scatters the state
+// across the heap and leaves three float lanes idle; here the caller lays the
+// channels out flat (a vec3 joint contributes three channels) and filters them
+// in place. Each channel runs the scalar algorithm with its own derivative
+// magnitude, so a vec3 gets per-axis cutoffs rather than one norm-based cutoff -
+// in practice indistinguishable for hand tracking, and the parameters mean the
+// same thing as in the per-object filters above.
+class one_euro_filter_batch
+{
+    float minCutoff;
+    float betaCoeff;
+    float derivCutoff;
+
+    bool primed{ false };
+    std::vector<float> hatx;  // filtered value per channel
+    std::vector<float> hatdx; // filtered derivative per channel
+
+    static float alpha(float dt, float cutoff)
+    {
+        const float myTau = 1.f / 2.f * ((POLYMER_TAU * 0.5f) * cutoff);
+        return 1.f / (1.f + myTau / dt);
+    }
+
+public:
+
+    one_euro_filter_batch(const size_t num_channels, float mincutoff = 1.0f, float beta = 0.05f, float dcutoff = 1.0f)
+        : minCutoff(mincutoff), betaCoeff(beta), derivCutoff(dcutoff), hatx(num_channels, 0.f), hatdx(num_channels, 0.f) {}
+
+    void reset() { primed = false; }
+
+    void set_parameters(float mincutoff, float beta, float dcutoff)
+    {
+        minCutoff = mincutoff;
+        betaCoeff = beta;
+        derivCutoff = dcutoff;
+    }
+
+    size_t channels() const { return hatx.size(); }
+
+    // Filters channels() values in place
+    void filter(const float dt, float * values)
+    {
+        const size_t n = hatx.size();
+
+        if (!primed)
+        {
+            primed = true;
+            for (size_t i = 0; i < n; ++i) { hatx[i] = values[i]; hatdx[i] = 0.f; }
+            return;
+        }
+
+        const float invDt = 1.f / dt;
+        const float alphaD = alpha(dt, derivCutoff);
+        const float myTauScale = 1.f / 2.f * (POLYMER_TAU * 0.5f); // myTau = myTauScale * cutoff
+
+        size_t i = 0;
+
+#if defined(POLYMER_ONE_EURO_SSE2)
+        const __m128 vInvDt = _mm_set1_ps(invDt);
+        const __m128 vAlphaD = _mm_set1_ps(alphaD);
+        const __m128 vOneMinusAlphaD = _mm_set1_ps(1.f - alphaD);
+        const __m128 vMinCutoff = _mm_set1_ps(minCutoff);
+        const __m128 vBeta = _mm_set1_ps(betaCoeff);
+        const __m128 vTauScale = _mm_set1_ps(myTauScale);
+        const __m128 vDt = _mm_set1_ps(dt);
+        const __m128 vOne = _mm_set1_ps(1.f);
+        const __m128 vAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 x = _mm_loadu_ps(values + i);
+            const __m128 prev = _mm_loadu_ps(hatx.data() + i);
+
+            // Low-passed derivative, then a per-channel cutoff from its magnitude
+            const __m128 dx = _mm_mul_ps(_mm_sub_ps(x, prev), vInvDt);
+            const __m128 edx = _mm_add_ps(_mm_mul_ps(vAlphaD, dx), _mm_mul_ps(vOneMinusAlphaD, _mm_loadu_ps(hatdx.data() + i)));
+            _mm_storeu_ps(hatdx.data() + i, edx);
+
+            const __m128 cutoff = _mm_add_ps(vMinCutoff, _mm_mul_ps(vBeta, _mm_and_ps(edx, vAbsMask)));
+
+            // alpha = 1 / (1 + myTau / dt) = dt / (dt + myTau)
+            const __m128 a = _mm_div_ps(vDt, _mm_add_ps(vDt, _mm_mul_ps(vTauScale, cutoff)));
+
+            const __m128 filtered = _mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(_mm_sub_ps(vOne, a), prev));
+            _mm_storeu_ps(hatx.data() + i, filtered);
+            _mm_storeu_ps(values + i, filtered);
+        }
+#endif
+
+        for (; i < n; ++i)
+        {
+            const float x = values[i];
+            const float dx = (x - hatx[i]) * invDt;
+            const float edx = alphaD * dx + (1.f - alphaD) * hatdx[i];
+            hatdx[i] = edx;
+
+            const float cutoff = minCutoff + betaCoeff * std::abs(edx);
+            const float a = dt / (dt + myTauScale * cutoff);
+
+            hatx[i] = a * x + (1.f - a) * hatx[i];
+            values[i] = hatx[i];
+        }
+    }
+};
+
 #endif // end one_euro_filter_h
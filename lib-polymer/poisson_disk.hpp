@@ -8,6 +8,7 @@
 
 #include "math-spatial.hpp"
 #include "util.hpp"
+#include "thread-pool.hpp"
 #include <functional>
 #include <vector>
 
@@ -254,15 +255,181 @@ namespace poisson
         }
     };
 
+    // Dense background grid for the accelerated sampler below. Cells are sized
+    // separation / sqrt(2), so each cell can hold at most one accepted sample and a
+    // neighbor query inspects a constant-size block of cells instead of walking
+    // per-cell vectors. Stores indices into the caller's sample array.
+    class background_grid_2d
+    {
+        std::vector<int32_t> cells; // index of the sample occupying each cell, -1 if empty
+        int2 dims;
+        float2 origin;
+        float cellSize, invCellSize;
+
+    public:
+
+        background_grid_2d(const aabb_2d & bounds, const float min_separation)
+        {
+            cellSize = min_separation / 1.41421356f;
+            invCellSize = 1.f / cellSize;
+            origin = bounds.min();
+            dims = int2(ceil(bounds.size() * invCellSize)) + int2(1);
+            cells.assign(dims.x * dims.y, -1);
+        }
+
+        int2 cell_of(const float2 & p) const { return int2((p - origin) * invCellSize); }
+
+        void add(const float2 & p, const int32_t sample_index)
+        {
+            const int2 c = cell_of(p);
+            cells[c.y * dims.x + c.x] = sample_index;
+        }
+
+        bool has_neighbors(const float2 & p, const float radius, const std::vector<float2> & samples) const
+        {
+            const float sqRadius = radius * radius;
+            const int range = static_cast<int>(std::ceil(radius * invCellSize));
+            const int2 c = cell_of(p);
+            const int2 minCell = linalg::max(c - int2(range), int2(0));
+            const int2 maxCell = linalg::min(c + int2(range), dims - int2(1));
+
+            for (int y = minCell.y; y <= maxCell.y; ++y)
+            {
+                for (int x = minCell.x; x <= maxCell.x; ++x)
+                {
+                    const int32_t idx = cells[y * dims.x + x];
+                    if (idx >= 0 && length2(p - samples[idx]) < sqRadius) return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    // Bridson-style sampler: one sample per background-grid cell, constant-size
+    // neighborhood queries, and an active list consumed with swap-removal instead of
+    // O(n) erases. Orders of magnitude faster than poisson_sampler_2d at foliage
+    // densities, and deterministic for a given seed. distFunction may raise the local
+    // separation above the `separation` passed to build (never below - the grid is
+    // sized to the minimum).
+    struct poisson_sampler_grid_2d
+    {
+        std::function<float(const float2 &)> distFunction;
+        std::function<bool(const float2 &)> boundsFunction;
+        uint64_t seed{ 0 }; // nonzero seeds are deterministic
+
+        std::vector<float2> build(const aabb_2d & bounds, const std::vector<float2> & initialSet, int k, float separation = 1.0f)
+        {
+            std::vector<float2> outputList;
+            std::vector<int32_t> activeList; // indices into outputList
+            background_grid_2d grid(bounds, separation);
+            uniform_random_gen r(seed ? seed : std::random_device{}());
+
+            auto emit = [&](const float2 & p)
+            {
+                grid.add(p, static_cast<int32_t>(outputList.size()));
+                activeList.push_back(static_cast<int32_t>(outputList.size()));
+                outputList.push_back(p);
+            };
+
+            for (auto & p : initialSet) emit(p);
+            if (outputList.empty()) emit(bounds.center());
+
+            while (!activeList.empty())
+            {
+                const uint32_t slot = r.random_uint(static_cast<uint32_t>(activeList.size()) - 1);
+                const float2 center = outputList[activeList[slot]];
+
+                const float localSeparation = distFunction ? distFunction(center) : separation;
+
+                bool found = false;
+                for (int i = 0; i < k; ++i)
+                {
+                    const float randRadius = localSeparation * (1.0f + r.random_float());
+                    const float randAngle = r.random_float() * POLYMER_PI * 2.0f;
+                    const float2 newPoint = center + float2(std::cos(randAngle), std::sin(randAngle)) * randRadius;
+
+                    if (!bounds.contains(newPoint)) continue;
+                    if (grid.has_neighbors(newPoint, localSeparation, outputList)) continue;
+                    if (boundsFunction && boundsFunction(newPoint)) continue;
+
+                    emit(newPoint);
+                    found = true;
+                }
+
+                // Retire the point once it stops producing candidates
+                if (!found)
+                {
+                    activeList[slot] = activeList.back();
+                    activeList.pop_back();
+                }
+            }
+            return outputList;
+        }
+    };
+
     // Returns a set of poisson disk samples inside a rectangular area, with a minimum separation and with
     // a packing determined by how high k is. The higher k is the higher the algorithm will be slow.
     // If no initialSet of points is provided the area center will be used as the initial point.
     inline std::vector<float2> make_poisson_disc_distribution(const aabb_2d & bounds, const std::vector<float2> & initialSet, int k, float separation = 1.0)
     {
-        poisson::poisson_sampler_2d sampler;
+        poisson::poisson_sampler_grid_2d sampler;
         return sampler.build(bounds, initialSet, k, separation);
     }
 
+    // Parallel region-subdivision path: the area is cut into tiles sampled independently
+    // on the task scheduler (each tile seeded from `seed` and its coordinates, so results
+    // are deterministic regardless of thread timing). Tiles are then merged in row-major
+    // order; only samples within `separation` of a tile edge need re-checking against the
+    // already-merged neighbors, interior samples are accepted directly.
+    inline std::vector<float2> make_poisson_disc_distribution_parallel(const aabb_2d & bounds, int k, float separation = 1.0f, uint64_t seed = 1, float tile_size = 64.f)
+    {
+        const int2 tileCount = linalg::max(int2(ceil(bounds.size() / tile_size)), int2(1));
+        std::vector<std::vector<float2>> tileSamples(tileCount.x * tileCount.y);
+
+        polymer::task_group group;
+        for (int ty = 0; ty < tileCount.y; ++ty)
+        {
+            for (int tx = 0; tx < tileCount.x; ++tx)
+            {
+                group.run(polymer::get_task_scheduler(), [&, tx, ty]()
+                {
+                    const float2 tileMin = bounds.min() + float2(tx * tile_size, ty * tile_size);
+                    const float2 tileMax = linalg::min(tileMin + float2(tile_size), bounds.max());
+
+                    poisson_sampler_grid_2d sampler;
+                    sampler.seed = seed * 0x9e3779b97f4a7c15ull + (uint64_t(ty) * tileCount.x + tx) * 0xbf58476d1ce4e5b9ull + 1;
+                    tileSamples[ty * tileCount.x + tx] = sampler.build({ tileMin, tileMax }, {}, k, separation);
+                });
+            }
+        }
+        group.wait();
+
+        // Boundary merge: a shared grid over the full bounds arbitrates samples near tile seams
+        std::vector<float2> merged;
+        background_grid_2d grid(bounds, separation);
+
+        for (int ty = 0; ty < tileCount.y; ++ty)
+        {
+            for (int tx = 0; tx < tileCount.x; ++tx)
+            {
+                const float2 tileMin = bounds.min() + float2(tx * tile_size, ty * tile_size);
+                const float2 tileMax = linalg::min(tileMin + float2(tile_size), bounds.max());
+
+                for (const float2 & p : tileSamples[ty * tileCount.x + tx])
+                {
+                    const bool nearSeam = (p.x - tileMin.x) < separation || (tileMax.x - p.x) < separation ||
+                                          (p.y - tileMin.y) < separation || (tileMax.y - p.y) < separation;
+
+                    if (nearSeam && grid.has_neighbors(p, separation, merged)) continue;
+
+                    grid.add(p, static_cast<int32_t>(merged.size()));
+                    merged.push_back(p);
+                }
+            }
+        }
+        return merged;
+    }
+
     inline std::vector<float3> make_poisson_sphere_distribution(const aabb_3d & bounds, const std::vector<float3> & initialSet, int k, float separation = 1.0)
     {
         poisson::poisson_sampler_3d sampler;
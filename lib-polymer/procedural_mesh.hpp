@@ -751,6 +751,10 @@ namespace polymer
             shape.faces.push_back({ q.z,q.y,q.x });
         }
 
+        // The theta wrap and the poles emit coincident vertices; weld them before
+        // smoothing so the normals accumulate over the shared corner
+        weld_vertices(shape);
+
         compute_normals(shape, true);
 
         return shape;
@@ -798,6 +802,11 @@ namespace polymer
         for (auto & v : ico.vertices) v = normalize(v);
         for (auto & n : ico.normals) n = normalize(n);
 
+        // Each subdivision pushed every edge midpoint once per adjacent triangle, roughly
+        // doubling the vertex count per level; weld the shared corners before assigning
+        // uvs (the seam pass below re-splits only where the texture wraps)
+        weld_vertices(ico, 1e-5f);
+
         ico.texcoord0.resize(ico.normals.size(), float2());
         for (size_t i = 0; i < ico.normals.size(); ++i)
         {
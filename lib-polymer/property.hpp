@@ -5,6 +5,8 @@
 
 #include "any.hpp"
 #include <functional>
+#include <algorithm>
+#include <stdexcept>
 
 namespace polymer
 {
@@ -109,6 +111,193 @@ namespace polymer
         void clear_listeners() { listeners.clear(); }
     };
 
+    ////////////////////////////////////////
+    //   lazy property dependency graph   //
+    ////////////////////////////////////////
+
+    // `property<T>` notifies eagerly: every set() runs each listener immediately, so
+    // chained bindings recompute the whole downstream per mutation - a slider drag
+    // over an expensive property re-triggers its side effects per event. The graph
+    // below inverts that. Mutating an input only flags its transitive dependents
+    // dirty; reads pull a recompute through the chain on demand; and listeners fire
+    // at most once per flush() with the final value. Call flush() once per frame to
+    // batch a drag's worth of edits into a single downstream recomputation.
+
+    class property_graph;
+
+    struct lazy_property_base
+    {
+        friend class property_graph;
+
+    protected:
+
+        property_graph * graph{ nullptr };
+        std::vector<lazy_property_base *> dependents; // nodes computed from this one
+        std::vector<lazy_property_base *> sources;    // reverse edges, walked by pull evaluation
+        bool dirty{ false };
+        bool notify_pending{ false };
+        uint8_t mark{ 0 };                            // 0 untouched, 1 on the evaluation stack, 2 evaluated
+
+        virtual void evaluate_now() = 0;
+        virtual void notify_now() = 0;
+
+    public:
+
+        virtual ~lazy_property_base();
+    };
+
+    class property_graph
+    {
+        std::vector<lazy_property_base *> nodes;
+
+        // Depth-first over the reverse edges: sources settle before dependents. A
+        // node found already on the evaluation stack means the edges form a cycle.
+        void evaluate(lazy_property_base * n)
+        {
+            if (n->mark == 1) throw std::runtime_error("property_graph: dependency cycle detected");
+            if (n->mark == 2) return;
+            n->mark = 1;
+            if (n->dirty)
+            {
+                for (auto * s : n->sources) evaluate(s);
+                n->evaluate_now();
+                n->dirty = false;
+            }
+            n->mark = 2;
+        }
+
+        void clear_marks() { for (auto * n : nodes) n->mark = 0; }
+
+    public:
+
+        void add(lazy_property_base * n)
+        {
+            n->graph = this;
+            nodes.push_back(n);
+        }
+
+        void remove(lazy_property_base * n)
+        {
+            nodes.erase(std::remove(nodes.begin(), nodes.end(), n), nodes.end());
+            for (auto * other : nodes)
+            {
+                other->dependents.erase(std::remove(other->dependents.begin(), other->dependents.end(), n), other->dependents.end());
+                other->sources.erase(std::remove(other->sources.begin(), other->sources.end(), n), other->sources.end());
+            }
+            n->graph = nullptr;
+        }
+
+        // Declares that `dependent` is computed from `source` (its kernel reads source.value())
+        void connect(lazy_property_base * source, lazy_property_base * dependent)
+        {
+            source->dependents.push_back(dependent);
+            dependent->sources.push_back(source);
+            mark_dirty(dependent);
+        }
+
+        // The whole per-mutation cost: flag the transitive dependents, recompute nothing.
+        // Already-dirty nodes terminate the walk, so repeated edits are O(1) after the first.
+        void mark_dirty(lazy_property_base * n)
+        {
+            n->notify_pending = true;
+            for (auto * d : n->dependents)
+            {
+                if (!d->dirty)
+                {
+                    d->dirty = true;
+                    mark_dirty(d);
+                }
+            }
+        }
+
+        // On-demand pull for a single read between flushes
+        void pull(lazy_property_base * n)
+        {
+            if (!n->dirty) return;
+            clear_marks();
+            evaluate(n);
+        }
+
+        // Once per frame: settle every dirty node in dependency order, then fire each
+        // pending listener exactly once with the final value
+        void flush()
+        {
+            clear_marks();
+            for (auto * n : nodes) if (n->dirty) evaluate(n);
+            for (auto * n : nodes)
+            {
+                if (n->notify_pending)
+                {
+                    n->notify_pending = false;
+                    n->notify_now();
+                }
+            }
+        }
+    };
+
+    inline lazy_property_base::~lazy_property_base() { if (graph) graph->remove(this); }
+
+    template<typename T>
+    class lazy_property final : public lazy_property_base
+    {
+    public:
+
+        typedef std::function<void(const T & v)> listener_t;
+
+    private:
+
+        T cached{};
+        std::function<T()> compute; // empty for input nodes
+        std::vector<listener_t> listeners;
+
+        virtual void evaluate_now() override final
+        {
+            if (compute)
+            {
+                cached = compute();
+                notify_pending = true;
+            }
+        }
+
+        virtual void notify_now() override final
+        {
+            for (auto & l : listeners) l(cached);
+        }
+
+    public:
+
+        lazy_property() = default;
+        explicit lazy_property(const T & default_value) : cached(default_value) {}
+
+        // Computed node: the kernel pulls its inputs' value()s; declare the matching
+        // edges with property_graph::connect so dirt propagates to this node
+        void kernel(std::function<T()> compute_kernel)
+        {
+            compute = std::move(compute_kernel);
+            dirty = true;
+        }
+
+        // Input mutation: store the value and flag downstream; nothing recomputes here
+        void set(const T & new_value)
+        {
+            cached = new_value;
+            if (graph) graph->mark_dirty(this);
+            else notify_pending = true;
+        }
+
+        // Pull: recomputes this node's chain if anything upstream changed since the last read
+        const T & value()
+        {
+            if (dirty && graph) graph->pull(this);
+            return cached;
+        }
+
+        operator T () { return value(); }
+
+        void add_listener(listener_t l) { listeners.emplace_back(std::move(l)); }
+        void clear_listeners() { listeners.clear(); }
+    };
+
 } // end namespace polymer
 
 #endif // end polymer_property_hpp
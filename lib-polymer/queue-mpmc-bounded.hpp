@@ -5,6 +5,8 @@
 #ifndef mpmc_bounded_queue_hpp
 #define mpmc_bounded_queue_hpp
 
+#include "util.hpp"
+
 #include <assert.h>
 #include <atomic>
 #include <stdint.h>
@@ -47,19 +49,20 @@ namespace polymer
 
         bool sp_produce(T const & input)
         {
+            const size_t headSequence = head.load(std::memory_order_relaxed);
             node_t * node = &buffer[headSequence & mask];
-            size_t nodeSequence = node->node.load(std::memory_order_acquire);
-            intptr_t diff = (intptr_t)nodeSequence - (intptr_t)headSequence;
+            const size_t nodeSequence = node->next.load(std::memory_order_acquire);
+            const intptr_t dif = (intptr_t)nodeSequence - (intptr_t)headSequence;
 
             if (dif == 0)
             {
-                ++head;
+                head.store(headSequence + 1, std::memory_order_relaxed);
                 node->data = input;
-                node->next.store(headSequence, std::memory_order_release);
+                node->next.store(headSequence + 1, std::memory_order_release);
                 return true;
             }
 
-            assert(dif < 0);
+            POLYMER_ASSERT_HOT(dif < 0); // on the producer fast path; elided in shipping
             return false;
         }
 
@@ -125,6 +128,96 @@ namespace polymer
             return false;
         }
 
+        // Enqueues up to `count` items from `input` with a single head CAS for the whole
+        // span, returning the number actually written (possibly zero when full). The scan
+        // counts consecutive free cells for this lap before claiming; winning the CAS from
+        // the scanned head guarantees no other producer touched those cells, and consumers
+        // cannot advance past unwritten cells, so the observations stay valid.
+        size_t mp_produce_bulk(const T * input, const size_t count)
+        {
+            size_t headSequence = head.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                size_t n = 0;
+                bool stale = false;
+
+                while (n < count)
+                {
+                    node_t * node = &buffer[(headSequence + n) & mask];
+                    const size_t nodeSequence = node->next.load(std::memory_order_acquire);
+                    const intptr_t dif = (intptr_t)nodeSequence - (intptr_t)(headSequence + n);
+                    if (dif == 0) ++n;
+                    else if (dif < 0) break; // full at this cell
+                    else { stale = true; break; } // another producer advanced head under us
+                }
+
+                if (stale)
+                {
+                    headSequence = head.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (n == 0) return 0;
+
+                if (head.compare_exchange_weak(headSequence, headSequence + n, std::memory_order_relaxed))
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        node_t * node = &buffer[(headSequence + i) & mask];
+                        node->data = input[i];
+                        node->next.store(headSequence + i + 1, std::memory_order_release);
+                    }
+                    return n;
+                }
+                // CAS failure reloaded headSequence; rescan from the new position
+            }
+        }
+
+        // Dequeues up to `count` items into `output` with a single tail CAS for the whole
+        // span, returning the number actually read. Mirrors mp_produce_bulk: consecutive
+        // published cells are scanned, claimed atomically, then released one lap ahead.
+        size_t consume_bulk(T * output, const size_t count)
+        {
+            size_t tailSequence = tail.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                size_t n = 0;
+                bool stale = false;
+
+                while (n < count)
+                {
+                    node_t * node = &buffer[(tailSequence + n) & mask];
+                    const size_t nodeSequence = node->next.load(std::memory_order_acquire);
+                    const intptr_t dif = (intptr_t)nodeSequence - (intptr_t)(tailSequence + n + 1);
+                    if (dif == 0) ++n;
+                    else if (dif < 0) break; // empty at this cell
+                    else { stale = true; break; } // another consumer advanced tail under us
+                }
+
+                if (stale)
+                {
+                    tailSequence = tail.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (n == 0) return 0;
+
+                if (tail.compare_exchange_weak(tailSequence, tailSequence + n, std::memory_order_relaxed))
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        node_t * node = &buffer[(tailSequence + i) & mask];
+                        output[i] = node->data;
+                        node->next.store(tailSequence + i + mask + 1, std::memory_order_release);
+                    }
+                    return n;
+                }
+                // CAS failure reloaded tailSequence; rescan from the new position
+            }
+        }
+
     };
 
 } // end namespace polymer
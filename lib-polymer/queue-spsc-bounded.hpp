@@ -59,13 +59,40 @@ namespace polymer
 
             if (((head.load(std::memory_order_acquire) - t) & mask) >= 1)
             {
-                output = buffer[tail & mask];
+                output = buffer[t & mask];
                 tail.store(t + 1, std::memory_order_release);
                 return true;
             }
             return false;
         }
 
+        // Enqueues up to `count` items from `input`, returning the number actually written
+        // (possibly zero when the queue is near full). The producer pays one acquire load
+        // and one release store for the whole span instead of per item.
+        size_t produce_bulk(const T * input, const size_t count)
+        {
+            const size_t h = head.load(std::memory_order_relaxed);
+            const size_t free_slots = (tail.load(std::memory_order_acquire) - (h + 1)) & mask;
+            const size_t n = count < free_slots ? count : free_slots;
+
+            for (size_t i = 0; i < n; ++i) buffer[(h + i) & mask] = input[i];
+            if (n) head.store(h + n, std::memory_order_release);
+            return n;
+        }
+
+        // Dequeues up to `count` items into `output`, returning the number actually read.
+        // One acquire load and one release store amortized across the span.
+        size_t consume_bulk(T * output, const size_t count)
+        {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            const size_t available = (head.load(std::memory_order_acquire) - t) & mask;
+            const size_t n = count < available ? count : available;
+
+            for (size_t i = 0; i < n; ++i) output[i] = buffer[(t + i) & mask];
+            if (n) tail.store(t + n, std::memory_order_release);
+            return n;
+        }
+
     };
 
 } // end namespace polymer
@@ -0,0 +1,168 @@
+// This is free and unencumbered software released into the public domain.
+
+#ifndef spsc_bytes_queue_hpp
+#define spsc_bytes_queue_hpp
+
+#include "queue-spsc-bounded.hpp"
+
+#include <assert.h>
+#include <atomic>
+#include <stdint.h>
+#include <cstring>
+#include <type_traits>
+
+namespace polymer
+{
+    // A wait-free single-producer/single-consumer channel carrying variable-length
+    // framed messages as raw bytes. The fixed-size queue family stores whole T
+    // elements, which forces heap-boxed items when message sizes vary (debug draw
+    // batches, GL upload requests, imgui data); this channel instead appends
+    // [size, payload] frames into pooled byte segments. When the current segment
+    // fills, the producer seals it and moves to a recycled one, so the channel
+    // grows under burst but allocates nothing in steady state. write() and drain()
+    // are wait-free outside of growth; neither side ever blocks on the other.
+    class spsc_byte_channel
+    {
+        // Frames are 8-byte aligned so message payloads can be POD command structs
+        static const uint32_t frame_align = 8;
+        static const uint32_t unsealed = 0xffffffffu;
+
+        struct segment
+        {
+            std::atomic<uint32_t> committed{ 0 };    // bytes published by the producer
+            std::atomic<uint32_t> sealed{ unsealed };// final byte count once the producer moves on
+            std::atomic<segment *> next{ nullptr };
+            uint32_t capacity{ 0 };
+            uint8_t * data{ nullptr };
+
+            segment(const uint32_t cap) : capacity(cap), data(new uint8_t[cap]) {}
+            ~segment() { delete[] data; }
+        };
+
+        const uint32_t segmentSize;
+
+        // Producer-owned
+        segment * tail{ nullptr };
+        uint32_t writeOffset{ 0 };
+
+        // Consumer-owned
+        segment * head{ nullptr };
+        uint32_t readOffset{ 0 };
+
+        // Consumer recycles drained segments back to the producer. If the ring is
+        // full (burst collapse) the consumer simply deletes the segment instead.
+        spsc_queue_bounded<segment *> freelist{ 16 };
+
+        static uint32_t aligned_frame_bytes(const uint32_t payload) { return (uint32_t(sizeof(uint32_t)) + payload + (frame_align - 1)) & ~(frame_align - 1); }
+
+        segment * acquire_segment(const uint32_t required)
+        {
+            segment * s{ nullptr };
+            while (freelist.consume(s))
+            {
+                if (s->capacity >= required) return s;
+                delete s; // recycled segment too small for an oversized message
+            }
+            return new segment(required > segmentSize ? required : segmentSize);
+        }
+
+        spsc_byte_channel(const spsc_byte_channel &) = delete;
+        spsc_byte_channel & operator= (const spsc_byte_channel &) = delete;
+
+    public:
+
+        spsc_byte_channel(const uint32_t segment_size = 65536) : segmentSize(segment_size)
+        {
+            tail = new segment(segmentSize);
+            head = tail;
+        }
+
+        ~spsc_byte_channel()
+        {
+            segment * s{ nullptr };
+            while (freelist.consume(s)) delete s;
+            for (s = head; s != nullptr;)
+            {
+                segment * n = s->next.load(std::memory_order_relaxed);
+                delete s;
+                s = n;
+            }
+        }
+
+        // Producer: append one framed message. Always succeeds; a message that does
+        // not fit in the current segment seals it and continues in a pooled (or, for
+        // oversized messages, freshly sized) one.
+        void write(const void * bytes, const uint32_t size)
+        {
+            const uint32_t frameBytes = aligned_frame_bytes(size);
+
+            if (writeOffset + frameBytes > tail->capacity)
+            {
+                segment * fresh = acquire_segment(frameBytes);
+                tail->next.store(fresh, std::memory_order_relaxed);
+                tail->sealed.store(writeOffset, std::memory_order_release); // publishes `next` too
+                tail = fresh;
+                writeOffset = 0;
+            }
+
+            uint8_t * frame = tail->data + writeOffset;
+            std::memcpy(frame, &size, sizeof(uint32_t));
+            if (size) std::memcpy(frame + sizeof(uint32_t), bytes, size);
+
+            writeOffset += frameBytes;
+            tail->committed.store(writeOffset, std::memory_order_release);
+        }
+
+        template<typename T>
+        void write(const T & message)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "messages must be raw-copyable");
+            write(&message, uint32_t(sizeof(T)));
+        }
+
+        // Consumer: invoke f(const void * payload, uint32_t size) for every message
+        // published so far, returning the number delivered. Payload pointers are only
+        // valid for the duration of the callback.
+        template<typename F>
+        size_t drain(F && f)
+        {
+            size_t delivered = 0;
+
+            for (;;)
+            {
+                const uint32_t committed = head->committed.load(std::memory_order_acquire);
+
+                while (readOffset < committed)
+                {
+                    uint32_t size;
+                    std::memcpy(&size, head->data + readOffset, sizeof(uint32_t));
+                    f(static_cast<const void *>(head->data + readOffset + sizeof(uint32_t)), size);
+                    readOffset += aligned_frame_bytes(size);
+                    ++delivered;
+                }
+
+                // A segment is exhausted only once the producer has sealed it at the
+                // point we have read up to; the release on `sealed` makes `next` visible.
+                if (head->sealed.load(std::memory_order_acquire) != readOffset) return delivered;
+
+                segment * drained = head;
+                head = drained->next.load(std::memory_order_relaxed);
+                readOffset = 0;
+
+                drained->committed.store(0, std::memory_order_relaxed);
+                drained->sealed.store(unsealed, std::memory_order_relaxed);
+                drained->next.store(nullptr, std::memory_order_relaxed);
+                if (!freelist.produce(drained)) delete drained;
+            }
+        }
+
+        // Approximate - exact only when called from the consumer thread
+        bool empty() const
+        {
+            return head == tail && readOffset == head->committed.load(std::memory_order_acquire);
+        }
+    };
+
+} // end namespace polymer
+
+#endif // spsc_bytes_queue_hpp
@@ -23,6 +23,11 @@
 #include <assert.h>
 #include <deque>
 
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POLYMER_QUICKHULL_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace quickhull 
 {
     using namespace polymer;
@@ -412,6 +417,156 @@ namespace quickhull
         std::array<size_t, 6> m_extremeValues;
         size_t m_failedHorizonEdges{ 0 };
 
+        // Parallel path state (see compute_parallel). The SoA mirror feeds the SIMD
+        // reduction scans; the scratch array carries per-point face choices so the
+        // parallel partitioning can be merged serially in point order, which keeps the
+        // output identical to the serial algorithm.
+        bool m_parallel{ false };
+        std::vector<float> m_soa_x, m_soa_y, m_soa_z;
+        std::vector<uint32_t> m_pointFaceScratch;
+
+        constexpr static const size_t ParallelThreshold = 8192;
+
+        void buildPointSoA()
+        {
+            const size_t vCount = m_vertexData.size();
+            m_soa_x.resize(vCount); m_soa_y.resize(vCount); m_soa_z.resize(vCount);
+            parallel_for(0, vCount, 16384, [this](size_t i)
+            {
+                m_soa_x[i] = m_vertexData[i].x;
+                m_soa_y[i] = m_vertexData[i].y;
+                m_soa_z[i] = m_vertexData[i].z;
+            });
+        }
+
+        // Chunked parallel argmax: fixed-size chunks reduce independently, then combine in
+        // chunk order with a strict compare - ties resolve to the earliest index, exactly
+        // like the serial scans. Returns size_t max if no value exceeds the seed.
+        template<class ChunkFn>
+        size_t parallelArgMax(const size_t count, const float seed, float & outMaxD, ChunkFn && chunkFn)
+        {
+            const size_t chunkSize = 16384;
+            const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+            std::vector<float> chunkVal(chunkCount, seed);
+            std::vector<size_t> chunkIdx(chunkCount, std::numeric_limits<size_t>::max());
+
+            task_group group;
+            task_scheduler & scheduler = get_task_scheduler();
+            for (size_t c = 0; c < chunkCount; ++c)
+            {
+                group.run(scheduler, [&, c]()
+                {
+                    chunkFn(c * chunkSize, std::min(count, (c + 1) * chunkSize), chunkVal[c], chunkIdx[c]);
+                });
+            }
+            group.wait();
+
+            float best = seed;
+            size_t bestIdx = std::numeric_limits<size_t>::max();
+            for (size_t c = 0; c < chunkCount; ++c)
+            {
+                if (chunkVal[c] > best) { best = chunkVal[c]; bestIdx = chunkIdx[c]; }
+            }
+            outMaxD = best;
+            return bestIdx;
+        }
+
+#if defined(POLYMER_QUICKHULL_SSE2)
+        // Resolve four running per-lane maxima to the single earliest winning index
+        static void resolveLanes(const __m128 laneVal, const __m128i laneIdx, float & bestVal, size_t & bestIdx)
+        {
+            alignas(16) float vals[4];
+            alignas(16) int idxs[4];
+            _mm_store_ps(vals, laneVal);
+            _mm_store_si128((__m128i *)idxs, laneIdx);
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if (idxs[lane] < 0) continue; // lane never updated past the seed
+                if (vals[lane] > bestVal || (vals[lane] == bestVal && bestIdx != std::numeric_limits<size_t>::max() && (size_t)idxs[lane] < bestIdx))
+                {
+                    bestVal = vals[lane];
+                    bestIdx = (size_t)idxs[lane];
+                }
+            }
+        }
+#endif
+
+        // Chunk reducer: squared distance from each point to a ray, over the SoA mirror
+        void chunkFurthestFromRay(const ray & r, const float invDirLen2, const size_t begin, const size_t end, float & bestVal, size_t & bestIdx)
+        {
+            size_t i = begin;
+#if defined(POLYMER_QUICKHULL_SSE2)
+            __m128 laneVal = _mm_set1_ps(bestVal);
+            __m128i laneIdx = _mm_set1_epi32(-1);
+            const __m128 ox = _mm_set1_ps(r.origin.x), oy = _mm_set1_ps(r.origin.y), oz = _mm_set1_ps(r.origin.z);
+            const __m128 dx = _mm_set1_ps(r.direction.x), dy = _mm_set1_ps(r.direction.y), dz = _mm_set1_ps(r.direction.z);
+            const __m128 inv = _mm_set1_ps(invDirLen2);
+            const __m128i laneOffsets = _mm_setr_epi32(0, 1, 2, 3);
+            for (; i + 4 <= end; i += 4)
+            {
+                const __m128 sx = _mm_sub_ps(_mm_loadu_ps(&m_soa_x[i]), ox);
+                const __m128 sy = _mm_sub_ps(_mm_loadu_ps(&m_soa_y[i]), oy);
+                const __m128 sz = _mm_sub_ps(_mm_loadu_ps(&m_soa_z[i]), oz);
+                const __m128 t = _mm_add_ps(_mm_mul_ps(sx, dx), _mm_add_ps(_mm_mul_ps(sy, dy), _mm_mul_ps(sz, dz)));
+                const __m128 len2 = _mm_add_ps(_mm_mul_ps(sx, sx), _mm_add_ps(_mm_mul_ps(sy, sy), _mm_mul_ps(sz, sz)));
+                const __m128 val = _mm_sub_ps(len2, _mm_mul_ps(_mm_mul_ps(t, t), inv));
+
+                const __m128 gt = _mm_cmpgt_ps(val, laneVal);
+                laneVal = _mm_or_ps(_mm_andnot_ps(gt, laneVal), _mm_and_ps(gt, val));
+                const __m128i gti = _mm_castps_si128(gt);
+                const __m128i idx = _mm_add_epi32(_mm_set1_epi32((int)i), laneOffsets);
+                laneIdx = _mm_or_si128(_mm_andnot_si128(gti, laneIdx), _mm_and_si128(gti, idx));
+            }
+            resolveLanes(laneVal, laneIdx, bestVal, bestIdx);
+#endif
+            for (; i < end; ++i)
+            {
+                const float distToRay = getSquaredDistanceBetweenPointAndRay(m_vertexData[i], r);
+                if (distToRay > bestVal) { bestVal = distToRay; bestIdx = i; }
+            }
+        }
+
+        // Chunk reducer: absolute distance from each point to a plane, over the SoA mirror
+        void chunkFurthestFromPlane(const plane & p, const size_t begin, const size_t end, float & bestVal, size_t & bestIdx)
+        {
+            size_t i = begin;
+#if defined(POLYMER_QUICKHULL_SSE2)
+            __m128 laneVal = _mm_set1_ps(bestVal);
+            __m128i laneIdx = _mm_set1_epi32(-1);
+            const float3 N = p.get_normal();
+            const __m128 nx = _mm_set1_ps(N.x), ny = _mm_set1_ps(N.y), nz = _mm_set1_ps(N.z);
+            const __m128 pd = _mm_set1_ps(p.get_distance());
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const __m128i laneOffsets = _mm_setr_epi32(0, 1, 2, 3);
+            for (; i + 4 <= end; i += 4)
+            {
+                const __m128 d = _mm_add_ps(pd, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_soa_x[i]), nx),
+                    _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_soa_y[i]), ny), _mm_mul_ps(_mm_loadu_ps(&m_soa_z[i]), nz))));
+                const __m128 val = _mm_and_ps(d, absMask);
+
+                const __m128 gt = _mm_cmpgt_ps(val, laneVal);
+                laneVal = _mm_or_ps(_mm_andnot_ps(gt, laneVal), _mm_and_ps(gt, val));
+                const __m128i gti = _mm_castps_si128(gt);
+                const __m128i idx = _mm_add_epi32(_mm_set1_epi32((int)i), laneOffsets);
+                laneIdx = _mm_or_si128(_mm_andnot_si128(gti, laneIdx), _mm_and_si128(gti, idx));
+            }
+            resolveLanes(laneVal, laneIdx, bestVal, bestIdx);
+#endif
+            for (; i < end; ++i)
+            {
+                const float d = std::abs(getSignedDistanceToPlane(m_vertexData[i], p));
+                if (d > bestVal) { bestVal = d; bestIdx = i; }
+            }
+        }
+
+        // Read-only version of the addPointToFace test, used by the parallel partitioning
+        bool isPointOnPositiveSide(const typename MeshBuilder::Face & f, const size_t pointIndex) const
+        {
+            const float D = getSignedDistanceToPlane(m_vertexData[pointIndex], f.m_P);
+            return (D > 0 && D * D > m_epsilonSquared * length2(f.m_P.get_normal()));
+        }
+
         // Temporary variables used during iteration process
         std::vector<size_t> m_newFaceIndices;
         std::vector<size_t> m_newHalfEdgeIndices;
@@ -466,10 +621,18 @@ namespace quickhull
             size_t maxI = std::numeric_limits<size_t>::max();
             const size_t vCount = m_vertexData.size();
 
-            for (size_t i = 0; i < vCount; i++) 
+            if (m_parallel && vCount >= ParallelThreshold)
+            {
+                const float invDirLen2 = 1.f / length2(r.direction);
+                maxI = parallelArgMax(vCount, m_epsilonSquared, maxD, [&](size_t begin, size_t end, float & bestVal, size_t & bestIdx)
+                {
+                    chunkFurthestFromRay(r, invDirLen2, begin, end, bestVal, bestIdx);
+                });
+            }
+            else for (size_t i = 0; i < vCount; i++)
             {
                 const float distToRay = getSquaredDistanceBetweenPointAndRay(m_vertexData[i], r);
-                if (distToRay > maxD) 
+                if (distToRay > maxD)
                 {
                     maxD = distToRay;
                     maxI = i;
@@ -509,10 +672,19 @@ namespace quickhull
             const float3 N = getTriangleNormal(baseTriangleVertices[0],baseTriangleVertices[1],baseTriangleVertices[2]);
             plane trianglePlane(N,baseTriangleVertices[0]);
 
-            for (size_t i = 0; i < vCount; i++) 
+            if (m_parallel && vCount >= ParallelThreshold)
+            {
+                const size_t found = parallelArgMax(vCount, m_epsilon, maxD, [&](size_t begin, size_t end, float & bestVal, size_t & bestIdx)
+                {
+                    chunkFurthestFromPlane(trianglePlane, begin, end, bestVal, bestIdx);
+                });
+                if (found != std::numeric_limits<size_t>::max()) maxI = found;
+                else maxI = 0;
+            }
+            else for (size_t i = 0; i < vCount; i++)
             {
                 const float d = std::abs(getSignedDistanceToPlane(m_vertexData[i],trianglePlane));
-                if (d > maxD) 
+                if (d > maxD)
                 {
                     maxD=d;
                     maxI=i;
@@ -557,11 +729,29 @@ namespace quickhull
             }
 
             // Finally we assign a face for each vertex outside the tetrahedron (vertices inside the tetrahedron have no role anymore)
-            for (size_t i=0;i<vCount;i++) 
+            if (m_parallel && vCount >= ParallelThreshold)
             {
-                for (auto & face : mesh.m_faces) 
+                // Face selection (four plane tests per point) is read-only and runs in
+                // parallel; the append happens serially in point order afterwards, so the
+                // per-face point lists match the serial construction exactly
+                m_pointFaceScratch.assign(vCount, 4);
+                parallel_for(0, vCount, ParallelThreshold, [&](size_t i)
                 {
-                    if (addPointToFace(face, i)) 
+                    for (uint32_t j = 0; j < 4; ++j)
+                    {
+                        if (isPointOnPositiveSide(mesh.m_faces[j], i)) { m_pointFaceScratch[i] = j; break; }
+                    }
+                });
+                for (size_t i = 0; i < vCount; i++)
+                {
+                    if (m_pointFaceScratch[i] < 4) addPointToFace(mesh.m_faces[m_pointFaceScratch[i]], i);
+                }
+            }
+            else for (size_t i=0;i<vCount;i++)
+            {
+                for (auto & face : mesh.m_faces)
+                {
+                    if (addPointToFace(face, i))
                     {
                         break;
                     }
@@ -909,20 +1099,43 @@ namespace quickhull
                 }
 
                 // Assign points that were on the positive side of the disabled faces to the new faces.
-                for (auto & disabledPoints : m_disabledFacePointVectors) 
+                for (auto & disabledPoints : m_disabledFacePointVectors)
                 {
                     assert(disabledPoints);
 
-                    for (const auto & point : *(disabledPoints)) 
+                    const size_t disabledCount = disabledPoints->size();
+                    if (m_parallel && disabledCount >= ParallelThreshold)
+                    {
+                        // Same split as the initial partition: parallel read-only face
+                        // selection, then a serial merge in point order
+                        m_pointFaceScratch.assign(disabledCount, (uint32_t)horizonEdgeCount);
+                        parallel_for(0, disabledCount, 4096, [&](size_t k)
+                        {
+                            const size_t point = (*disabledPoints)[k];
+                            if (point == activePointIndex) return;
+                            for (uint32_t j = 0; j < horizonEdgeCount; ++j)
+                            {
+                                if (isPointOnPositiveSide(m_mesh.m_faces[m_newFaceIndices[j]], point)) { m_pointFaceScratch[k] = j; break; }
+                            }
+                        });
+                        for (size_t k = 0; k < disabledCount; ++k)
+                        {
+                            if (m_pointFaceScratch[k] < horizonEdgeCount)
+                            {
+                                addPointToFace(m_mesh.m_faces[m_newFaceIndices[m_pointFaceScratch[k]]], (*disabledPoints)[k]);
+                            }
+                        }
+                    }
+                    else for (const auto & point : *(disabledPoints))
                     {
-                        if (point == activePointIndex) 
+                        if (point == activePointIndex)
                         {
                             continue;
                         }
 
-                        for (size_t j=0;j<horizonEdgeCount;j++) 
+                        for (size_t j=0;j<horizonEdgeCount;j++)
                         {
-                            if (addPointToFace(m_mesh.m_faces[m_newFaceIndices[j]], point)) 
+                            if (addPointToFace(m_mesh.m_faces[m_newFaceIndices[j]], point))
                             {
                                 break;
                             }
@@ -995,6 +1208,21 @@ namespace quickhull
             assert(m_vertexData.size() >= 3);
             return get_convex_hull(formatOutputCCW, useOriginalIndices, eps);
         }
+
+        // Parallel variant for large point clouds: the outside-point partitioning and the
+        // farthest-point scans run across the shared task scheduler, with SSE reductions
+        // over a float SoA mirror of the point cloud. Face-topology surgery stays serial
+        // (it touches a handful of faces per iteration); the hull produced is identical to
+        // compute(). Small inputs fall through to the serial paths automatically.
+        convex_hull compute_parallel(bool formatOutputCCW, bool useOriginalIndices, float eps = 0.001)
+        {
+            assert(m_vertexData.size() >= 3);
+            m_parallel = true;
+            buildPointSoA();
+            convex_hull result = get_convex_hull(formatOutputCCW, useOriginalIndices, eps);
+            m_parallel = false;
+            return result;
+        }
         
         const size_t getFailedHorizonEdges() { return m_failedHorizonEdges; }
     };
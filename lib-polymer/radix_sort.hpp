@@ -6,6 +6,7 @@
 #ifndef radix_sort_hpp
 #define radix_sort_hpp
 
+#include <cstring>
 #include <memory>
 #include <stdint.h>
 #include <algorithm>
@@ -74,6 +75,61 @@ namespace polymer
             }
         }
 
+        // Same histogram/scatter scheme as radix_impl, moving a payload alongside each key.
+        // The even pass count guarantees both arrays land back in the caller's storage.
+        template<typename K, typename V>
+        void radix_pairs_impl(K * keys, V * values, size_t size)
+        {
+            const uint32_t passes = (sizeof(K) * 8) % RADIX_LENGTH_BITS == 0 ? (sizeof(K) * 8) / RADIX_LENGTH_BITS : (sizeof(K) * 8) / RADIX_LENGTH_BITS + 1;
+            static_assert(passes % 2 == 0, "must be even number");
+
+            std::vector<size_t> histograms(passes * HISTOGRAM_BUCKETS);
+            std::vector<K> keyScratch(size);
+            std::vector<V> valueScratch(size);
+
+            for (size_t i = 0; i < size; i++)
+            {
+                K element = keys[i];
+                for (int r = 0; r < passes; r++)
+                {
+                    K pos = (element >> (r * RADIX_LENGTH_BITS)) & BIT_MASK;
+                    histograms[r * HISTOGRAM_BUCKETS + pos] += 1;
+                }
+            }
+
+            for (uint32_t r = 0; r < passes; r++)
+            {
+                size_t sum = 0;
+                for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+                {
+                    size_t val = histograms[r * HISTOGRAM_BUCKETS + i];
+                    histograms[r * HISTOGRAM_BUCKETS + i] = sum;
+                    sum += val;
+                }
+            }
+
+            K * srcKeys = keys;
+            K * dstKeys = keyScratch.data();
+            V * srcValues = values;
+            V * dstValues = valueScratch.data();
+            for (uint32_t r = 0; r < passes; r++)
+            {
+                for (size_t i = 0; i < size; i++)
+                {
+                    K element = srcKeys[i];
+                    K pos = ((element >> (r * RADIX_LENGTH_BITS)) & BIT_MASK);
+
+                    size_t & index = histograms[r * HISTOGRAM_BUCKETS + pos];
+                    dstKeys[index] = element;
+                    dstValues[index] = srcValues[i];
+                    index++;
+                }
+
+                std::swap(srcKeys, dstKeys);
+                std::swap(srcValues, dstValues);
+            }
+        }
+
     public:
 
         template <typename T, typename = std::enable_if <std::is_integral<T>::value>::type>
@@ -89,6 +145,46 @@ namespace polymer
             for (size_t i = 0; i < size; i++) inverse_float_flip((uint32_t &)data[i]);
         }
 
+        // (key, payload) variants - keys end up ascending with each 32-bit payload
+        // (particle id, draw index, octree node) carried to the matching slot
+
+        template <typename T, typename = std::enable_if <std::is_integral<T>::value>::type>
+        void sort_pairs(T * keys, uint32_t * values, const size_t size)
+        {
+            radix_pairs_impl<T, uint32_t>(keys, values, size);
+        }
+
+        void sort_pairs(float * keys, uint32_t * values, const size_t size)
+        {
+            for (size_t i = 0; i < size; i++) float_flip((uint32_t &)keys[i]);
+            radix_pairs_impl<uint32_t, uint32_t>((uint32_t *)keys, values, size);
+            for (size_t i = 0; i < size; i++) inverse_float_flip((uint32_t &)keys[i]);
+        }
+
+        // Indirect variants - fill `indices` with the permutation that orders `keys`
+        // ascending (keys[indices[0]] is the smallest); the keys are left untouched
+
+        void sort_indices(const uint32_t * keys, uint32_t * indices, const size_t size)
+        {
+            std::vector<uint32_t> keyScratch(keys, keys + size);
+            for (size_t i = 0; i < size; i++) indices[i] = static_cast<uint32_t>(i);
+            radix_pairs_impl<uint32_t, uint32_t>(keyScratch.data(), indices, size);
+        }
+
+        void sort_indices(const float * keys, uint32_t * indices, const size_t size)
+        {
+            std::vector<uint32_t> keyScratch(size);
+            for (size_t i = 0; i < size; i++)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &keys[i], sizeof(uint32_t));
+                float_flip(bits);
+                keyScratch[i] = bits;
+                indices[i] = static_cast<uint32_t>(i);
+            }
+            radix_pairs_impl<uint32_t, uint32_t>(keyScratch.data(), indices, size);
+        }
+
     };
 
 } // end namespace polymer
@@ -0,0 +1,347 @@
+// SSE2 batch kernels for the simplex noise in simplex_noise.hpp. The scalar functions
+// evaluate one sample at a time; regenerating a whole texture or heightfield that way
+// leaves three of four float lanes idle. These kernels run the identical algorithm
+// (same permutation table, same skew constants, same scale factors) four samples wide:
+// all arithmetic is vectorized, and only the permutation-table hashing stays scalar
+// since there is no integer gather before AVX2. Outputs match the scalar path.
+
+#pragma once
+
+#ifndef simplex_noise_simd_h
+#define simplex_noise_simd_h
+
+#include "simplex_noise.hpp"
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POLYMER_SIMPLEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace noise
+{
+
+#if defined(POLYMER_SIMPLEX_SSE2)
+
+namespace simd
+{
+    // fast_floor across four lanes: truncate, then subtract one where the input was negative
+    // and truncation rounded toward zero
+    inline __m128i fast_floor_sse(const __m128 x)
+    {
+        __m128i xi = _mm_cvttps_epi32(x);
+        const __m128 truncated = _mm_cvtepi32_ps(xi);
+        const __m128i rounded_up = _mm_castps_si128(_mm_cmplt_ps(x, truncated));
+        return _mm_add_epi32(xi, rounded_up); // mask is -1 where we need to step down
+    }
+
+    // select(a, b, mask): b where mask bits are set, a elsewhere (SSE2 has no blendv)
+    inline __m128 select_sse(const __m128 a, const __m128 b, const __m128 mask)
+    {
+        return _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b));
+    }
+
+    // Four-lane impl::grad(hash, x, y): h = hash & 7 picks one of 8 gradient directions,
+    // signs come from the low two hash bits shifted into the float sign bit
+    inline __m128 grad2_sse(const __m128i hash, const __m128 x, const __m128 y)
+    {
+        const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+        const __m128 h_lt_4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+
+        __m128 u = select_sse(y, x, h_lt_4);
+        __m128 v = select_sse(x, y, h_lt_4);
+
+        u = _mm_xor_ps(u, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31)));
+        v = _mm_mul_ps(v, _mm_set1_ps(2.0f));
+        v = _mm_xor_ps(v, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30)));
+
+        return _mm_add_ps(u, v);
+    }
+
+    // Four-lane impl::grad(hash, x, y, z): h = hash & 15 picks one of the 12 cube-edge
+    // directions (with the h = 12/14 repeats fixed up exactly like the scalar code)
+    inline __m128 grad3_sse(const __m128i hash, const __m128 x, const __m128 y, const __m128 z)
+    {
+        const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+        const __m128 h_lt_8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+        const __m128 h_lt_4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+        const __m128 h_12_or_14 = _mm_castsi128_ps(_mm_or_si128(
+            _mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+
+        __m128 u = select_sse(y, x, h_lt_8);
+        __m128 v = select_sse(select_sse(z, x, h_12_or_14), y, h_lt_4);
+
+        u = _mm_xor_ps(u, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31)));
+        v = _mm_xor_ps(v, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30)));
+
+        return _mm_add_ps(u, v);
+    }
+
+    // t^4 falloff: max(c - d, 0)^4, the branch in the scalar code becomes a clamp
+    inline __m128 falloff_sse(const __m128 c, const __m128 d)
+    {
+        __m128 t = _mm_max_ps(_mm_sub_ps(c, d), _mm_setzero_ps());
+        t = _mm_mul_ps(t, t);
+        return _mm_mul_ps(t, t);
+    }
+
+    // Four 2D simplex samples at once; mirrors noise(const float2 &) step for step
+    inline __m128 noise2_sse(const __m128 vx, const __m128 vy)
+    {
+        const __m128 s = _mm_mul_ps(_mm_add_ps(vx, vy), _mm_set1_ps(F2));
+        const __m128i i = fast_floor_sse(_mm_add_ps(vx, s));
+        const __m128i j = fast_floor_sse(_mm_add_ps(vy, s));
+
+        const __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), _mm_set1_ps(G2));
+        const __m128 x0 = _mm_sub_ps(vx, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+        const __m128 y0 = _mm_sub_ps(vy, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+        // Lower (i1 = 1) or upper (j1 = 1) triangle of the simplex cell
+        const __m128i x0_gt_y0 = _mm_castps_si128(_mm_cmpgt_ps(x0, y0));
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i i1 = _mm_and_si128(x0_gt_y0, one);
+        const __m128i j1 = _mm_andnot_si128(x0_gt_y0, one);
+
+        const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i1)), _mm_set1_ps(G2));
+        const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j1)), _mm_set1_ps(G2));
+        const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_set1_ps(1.0f)), _mm_set1_ps(2.0f * G2));
+        const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_set1_ps(1.0f)), _mm_set1_ps(2.0f * G2));
+
+        // Permutation hashing stays scalar (no integer gather in SSE2)
+        alignas(16) int ia[4], ja[4], i1a[4], j1a[4];
+        alignas(16) int h0[4], h1[4], h2[4];
+        _mm_store_si128((__m128i *)ia, i);
+        _mm_store_si128((__m128i *)ja, j);
+        _mm_store_si128((__m128i *)i1a, i1);
+        _mm_store_si128((__m128i *)j1a, j1);
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            const int ii = ia[lane] & 0xff;
+            const int jj = ja[lane] & 0xff;
+            h0[lane] = impl::s_perm_table[ii + impl::s_perm_table[jj]];
+            h1[lane] = impl::s_perm_table[ii + i1a[lane] + impl::s_perm_table[jj + j1a[lane]]];
+            h2[lane] = impl::s_perm_table[ii + 1 + impl::s_perm_table[jj + 1]];
+        }
+
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 n0 = _mm_mul_ps(falloff_sse(half, _mm_add_ps(_mm_mul_ps(x0, x0), _mm_mul_ps(y0, y0))), grad2_sse(_mm_load_si128((__m128i *)h0), x0, y0));
+        const __m128 n1 = _mm_mul_ps(falloff_sse(half, _mm_add_ps(_mm_mul_ps(x1, x1), _mm_mul_ps(y1, y1))), grad2_sse(_mm_load_si128((__m128i *)h1), x1, y1));
+        const __m128 n2 = _mm_mul_ps(falloff_sse(half, _mm_add_ps(_mm_mul_ps(x2, x2), _mm_mul_ps(y2, y2))), grad2_sse(_mm_load_si128((__m128i *)h2), x2, y2));
+
+        return _mm_mul_ps(_mm_set1_ps(40.0f), _mm_add_ps(n0, _mm_add_ps(n1, n2)));
+    }
+
+    // Four 3D simplex samples at once; the scalar branch ladder picking the simplex
+    // traversal order reduces to six branchless comparisons
+    inline __m128 noise3_sse(const __m128 vx, const __m128 vy, const __m128 vz)
+    {
+        const __m128 s = _mm_mul_ps(_mm_add_ps(vx, _mm_add_ps(vy, vz)), _mm_set1_ps(F3));
+        const __m128i i = fast_floor_sse(_mm_add_ps(vx, s));
+        const __m128i j = fast_floor_sse(_mm_add_ps(vy, s));
+        const __m128i k = fast_floor_sse(_mm_add_ps(vz, s));
+
+        const __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, _mm_add_epi32(j, k))), _mm_set1_ps(G3));
+        const __m128 x0 = _mm_sub_ps(vx, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+        const __m128 y0 = _mm_sub_ps(vy, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+        const __m128 z0 = _mm_sub_ps(vz, _mm_sub_ps(_mm_cvtepi32_ps(k), t));
+
+        // Branchless equivalent of the six traversal-order cases
+        const __m128i x_ge_y = _mm_castps_si128(_mm_cmpge_ps(x0, y0));
+        const __m128i x_ge_z = _mm_castps_si128(_mm_cmpge_ps(x0, z0));
+        const __m128i y_ge_z = _mm_castps_si128(_mm_cmpge_ps(y0, z0));
+        const __m128i one = _mm_set1_epi32(1);
+
+        const __m128i i1 = _mm_and_si128(_mm_and_si128(x_ge_y, x_ge_z), one);
+        const __m128i j1 = _mm_and_si128(_mm_andnot_si128(x_ge_y, y_ge_z), one);
+        const __m128i k1 = _mm_andnot_si128(x_ge_z, _mm_andnot_si128(y_ge_z, one));
+        const __m128i i2 = _mm_and_si128(_mm_or_si128(x_ge_y, x_ge_z), one);
+        const __m128i j2 = _mm_and_si128(_mm_or_si128(_mm_xor_si128(x_ge_y, _mm_set1_epi32(-1)), y_ge_z), one);
+        const __m128i k2 = _mm_andnot_si128(_mm_and_si128(x_ge_z, y_ge_z), one);
+
+        const __m128 g3 = _mm_set1_ps(G3);
+        const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i1)), g3);
+        const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j1)), g3);
+        const __m128 z1 = _mm_add_ps(_mm_sub_ps(z0, _mm_cvtepi32_ps(k1)), g3);
+        const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i2)), _mm_set1_ps(2.0f * G3));
+        const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j2)), _mm_set1_ps(2.0f * G3));
+        const __m128 z2 = _mm_add_ps(_mm_sub_ps(z0, _mm_cvtepi32_ps(k2)), _mm_set1_ps(2.0f * G3));
+        const __m128 x3 = _mm_add_ps(_mm_sub_ps(x0, _mm_set1_ps(1.0f)), _mm_set1_ps(3.0f * G3));
+        const __m128 y3 = _mm_add_ps(_mm_sub_ps(y0, _mm_set1_ps(1.0f)), _mm_set1_ps(3.0f * G3));
+        const __m128 z3 = _mm_add_ps(_mm_sub_ps(z0, _mm_set1_ps(1.0f)), _mm_set1_ps(3.0f * G3));
+
+        alignas(16) int ia[4], ja[4], ka[4], i1a[4], j1a[4], k1a[4], i2a[4], j2a[4], k2a[4];
+        alignas(16) int h0[4], h1[4], h2[4], h3[4];
+        _mm_store_si128((__m128i *)ia, i);   _mm_store_si128((__m128i *)ja, j);   _mm_store_si128((__m128i *)ka, k);
+        _mm_store_si128((__m128i *)i1a, i1); _mm_store_si128((__m128i *)j1a, j1); _mm_store_si128((__m128i *)k1a, k1);
+        _mm_store_si128((__m128i *)i2a, i2); _mm_store_si128((__m128i *)j2a, j2); _mm_store_si128((__m128i *)k2a, k2);
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            const int ii = ia[lane] & 0xff;
+            const int jj = ja[lane] & 0xff;
+            const int kk = ka[lane] & 0xff;
+            h0[lane] = impl::s_perm_table[ii + impl::s_perm_table[jj + impl::s_perm_table[kk]]];
+            h1[lane] = impl::s_perm_table[ii + i1a[lane] + impl::s_perm_table[jj + j1a[lane] + impl::s_perm_table[kk + k1a[lane]]]];
+            h2[lane] = impl::s_perm_table[ii + i2a[lane] + impl::s_perm_table[jj + j2a[lane] + impl::s_perm_table[kk + k2a[lane]]]];
+            h3[lane] = impl::s_perm_table[ii + 1 + impl::s_perm_table[jj + 1 + impl::s_perm_table[kk + 1]]];
+        }
+
+        const __m128 c = _mm_set1_ps(0.6f);
+        const __m128 d0 = _mm_add_ps(_mm_mul_ps(x0, x0), _mm_add_ps(_mm_mul_ps(y0, y0), _mm_mul_ps(z0, z0)));
+        const __m128 d1 = _mm_add_ps(_mm_mul_ps(x1, x1), _mm_add_ps(_mm_mul_ps(y1, y1), _mm_mul_ps(z1, z1)));
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(x2, x2), _mm_add_ps(_mm_mul_ps(y2, y2), _mm_mul_ps(z2, z2)));
+        const __m128 d3 = _mm_add_ps(_mm_mul_ps(x3, x3), _mm_add_ps(_mm_mul_ps(y3, y3), _mm_mul_ps(z3, z3)));
+
+        const __m128 n0 = _mm_mul_ps(falloff_sse(c, d0), grad3_sse(_mm_load_si128((__m128i *)h0), x0, y0, z0));
+        const __m128 n1 = _mm_mul_ps(falloff_sse(c, d1), grad3_sse(_mm_load_si128((__m128i *)h1), x1, y1, z1));
+        const __m128 n2 = _mm_mul_ps(falloff_sse(c, d2), grad3_sse(_mm_load_si128((__m128i *)h2), x2, y2, z2));
+        const __m128 n3 = _mm_mul_ps(falloff_sse(c, d3), grad3_sse(_mm_load_si128((__m128i *)h3), x3, y3, z3));
+
+        return _mm_mul_ps(_mm_set1_ps(32.0f), _mm_add_ps(_mm_add_ps(n0, n1), _mm_add_ps(n2, n3)));
+    }
+
+} // end namespace simd
+
+#endif // POLYMER_SIMPLEX_SSE2
+
+///////////////////////////
+//   Batch Entry Points  //
+///////////////////////////
+
+// Evaluate `count` arbitrary 2D samples into out[]
+inline void noise2d(float * out, const float2 * samples, const size_t count)
+{
+    size_t idx = 0;
+#if defined(POLYMER_SIMPLEX_SSE2)
+    for (; idx + 4 <= count; idx += 4)
+    {
+        const __m128 vx = _mm_setr_ps(samples[idx].x, samples[idx + 1].x, samples[idx + 2].x, samples[idx + 3].x);
+        const __m128 vy = _mm_setr_ps(samples[idx].y, samples[idx + 1].y, samples[idx + 2].y, samples[idx + 3].y);
+        _mm_storeu_ps(out + idx, simd::noise2_sse(vx, vy));
+    }
+#endif
+    for (; idx < count; ++idx) out[idx] = noise(samples[idx]);
+}
+
+// Evaluate `count` arbitrary 3D samples into out[]
+inline void noise3d(float * out, const float3 * samples, const size_t count)
+{
+    size_t idx = 0;
+#if defined(POLYMER_SIMPLEX_SSE2)
+    for (; idx + 4 <= count; idx += 4)
+    {
+        const __m128 vx = _mm_setr_ps(samples[idx].x, samples[idx + 1].x, samples[idx + 2].x, samples[idx + 3].x);
+        const __m128 vy = _mm_setr_ps(samples[idx].y, samples[idx + 1].y, samples[idx + 2].y, samples[idx + 3].y);
+        const __m128 vz = _mm_setr_ps(samples[idx].z, samples[idx + 1].z, samples[idx + 2].z, samples[idx + 3].z);
+        _mm_storeu_ps(out + idx, simd::noise3_sse(vx, vy, vz));
+    }
+#endif
+    for (; idx < count; ++idx) out[idx] = noise(samples[idx]);
+}
+
+// Fill a row-major extent.x * extent.y grid: out[y * extent.x + x] = noise(origin + float2(x, y) * step)
+inline void noise2d(float * out, const int2 & extent, const float2 & origin, const float2 & step)
+{
+    for (int y = 0; y < extent.y; ++y)
+    {
+        float * row = out + static_cast<size_t>(y) * extent.x;
+        const float py = origin.y + y * step.y;
+        int x = 0;
+#if defined(POLYMER_SIMPLEX_SSE2)
+        const __m128 vy = _mm_set1_ps(py);
+        for (; x + 4 <= extent.x; x += 4)
+        {
+            const __m128 vx = _mm_add_ps(_mm_set1_ps(origin.x + x * step.x),
+                _mm_mul_ps(_mm_setr_ps(0.f, 1.f, 2.f, 3.f), _mm_set1_ps(step.x)));
+            _mm_storeu_ps(row + x, simd::noise2_sse(vx, vy));
+        }
+#endif
+        for (; x < extent.x; ++x) row[x] = noise(float2(origin.x + x * step.x, py));
+    }
+}
+
+// Fill a 2D grid from an animated z slice of 3D noise (displacement / flow-style effects)
+inline void noise3d_slice(float * out, const int2 & extent, const float2 & origin, const float2 & step, const float z)
+{
+    for (int y = 0; y < extent.y; ++y)
+    {
+        float * row = out + static_cast<size_t>(y) * extent.x;
+        const float py = origin.y + y * step.y;
+        int x = 0;
+#if defined(POLYMER_SIMPLEX_SSE2)
+        const __m128 vy = _mm_set1_ps(py);
+        const __m128 vz = _mm_set1_ps(z);
+        for (; x + 4 <= extent.x; x += 4)
+        {
+            const __m128 vx = _mm_add_ps(_mm_set1_ps(origin.x + x * step.x),
+                _mm_mul_ps(_mm_setr_ps(0.f, 1.f, 2.f, 3.f), _mm_set1_ps(step.x)));
+            _mm_storeu_ps(row + x, simd::noise3_sse(vx, vy, vz));
+        }
+#endif
+        for (; x < extent.x; ++x) row[x] = noise(float3(origin.x + x * step.x, py, z));
+    }
+}
+
+// Fractal brownian motion over a grid, octave loop outside the lane loop so the per-sample
+// work stays vectorized; matches noise_fb's accumulation (amp starts at 0.5)
+inline void noise_fb2d(float * out, const int2 & extent, const float2 & origin, const float2 & step,
+    const uint8_t octaves = 4, const float lacunarity = 2.0f, const float gain = 0.5f)
+{
+    for (int y = 0; y < extent.y; ++y)
+    {
+        float * row = out + static_cast<size_t>(y) * extent.x;
+        const float py = origin.y + y * step.y;
+        int x = 0;
+#if defined(POLYMER_SIMPLEX_SSE2)
+        for (; x + 4 <= extent.x; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(origin.x + x * step.x),
+                _mm_mul_ps(_mm_setr_ps(0.f, 1.f, 2.f, 3.f), _mm_set1_ps(step.x)));
+            const __m128 pyv = _mm_set1_ps(py);
+
+            __m128 sum = _mm_setzero_ps();
+            float freq = 1.0f, amp = 0.5f;
+            for (uint8_t octave = 0; octave < octaves; ++octave)
+            {
+                const __m128 freqv = _mm_set1_ps(freq);
+                const __m128 n = simd::noise2_sse(_mm_mul_ps(px, freqv), _mm_mul_ps(pyv, freqv));
+                sum = _mm_add_ps(sum, _mm_mul_ps(n, _mm_set1_ps(amp)));
+                freq *= lacunarity;
+                amp *= gain;
+            }
+            _mm_storeu_ps(row + x, sum);
+        }
+#endif
+        for (; x < extent.x; ++x) row[x] = noise_fb(float2(origin.x + x * step.x, py), octaves, lacunarity, gain);
+    }
+}
+
+// fBm over arbitrary 3D samples
+inline void noise_fb3d(float * out, const float3 * samples, const size_t count,
+    const uint8_t octaves = 4, const float lacunarity = 2.0f, const float gain = 0.5f)
+{
+    size_t idx = 0;
+#if defined(POLYMER_SIMPLEX_SSE2)
+    for (; idx + 4 <= count; idx += 4)
+    {
+        const __m128 px = _mm_setr_ps(samples[idx].x, samples[idx + 1].x, samples[idx + 2].x, samples[idx + 3].x);
+        const __m128 py = _mm_setr_ps(samples[idx].y, samples[idx + 1].y, samples[idx + 2].y, samples[idx + 3].y);
+        const __m128 pz = _mm_setr_ps(samples[idx].z, samples[idx + 1].z, samples[idx + 2].z, samples[idx + 3].z);
+
+        __m128 sum = _mm_setzero_ps();
+        float freq = 1.0f, amp = 0.5f;
+        for (uint8_t octave = 0; octave < octaves; ++octave)
+        {
+            const __m128 freqv = _mm_set1_ps(freq);
+            const __m128 n = simd::noise3_sse(_mm_mul_ps(px, freqv), _mm_mul_ps(py, freqv), _mm_mul_ps(pz, freqv));
+            sum = _mm_add_ps(sum, _mm_mul_ps(n, _mm_set1_ps(amp)));
+            freq *= lacunarity;
+            amp *= gain;
+        }
+        _mm_storeu_ps(out + idx, sum);
+    }
+#endif
+    for (; idx < count; ++idx) out[idx] = noise_fb(samples[idx], octaves, lacunarity, gain);
+}
+
+} // end namespace noise
+
+#endif // end simplex_noise_simd_h
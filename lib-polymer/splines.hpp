@@ -5,30 +5,75 @@
 
 #include "math-core.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace polymer
 {
-      
-    class bezier_spline
+
+    // Precomputed arc-length parameterization for any curve evaluated by parameter.
+    // build() samples the curve once into a cumulative-length table; lookups then map a
+    // distance (or fraction of total length) back to the curve parameter. A cursor
+    // remembers the last resolved segment, so monotonically advancing playback (camera
+    // rigs stepping forward each frame) is O(1) - the binary search only runs when the
+    // query seeks backward or jumps.
+    class arc_length_table
     {
-        
-        void calculate_length()
+        std::vector<float> lengths; // cumulative arc length at sample i, lengths[0] == 0
+        size_t cursor{ 0 };         // last resolved segment, hint for monotone queries
+
+    public:
+
+        // point_at(t) -> float3 for t in [0, 1]
+        template<typename CurveFn>
+        void build(CurveFn && point_at, const size_t num_samples = 32)
         {
-            arcLengths.resize(num_steps);
-            arcLengths[0] = 0.0f;
-            float3 start = p0;
-            for (size_t i = 1; i < num_steps; i++)
+            lengths.resize(num_samples);
+            lengths[0] = 0.f;
+            float3 start = point_at(0.f);
+            for (size_t i = 1; i < num_samples; ++i)
             {
-                float t = float(i) / float(num_steps - 1);
-                float3 end = point(t);
-                float length = distance(start, end);
-                arcLengths[i] = arcLengths[i - 1] + length;
+                const float3 end = point_at(float(i) / float(num_samples - 1));
+                lengths[i] = lengths[i - 1] + distance(start, end);
                 start = end;
             }
+            cursor = 0;
         }
-        
+
+        size_t samples() const { return lengths.size(); }
+        float total_length() const { return lengths.back(); }
+        void reset_cursor() { cursor = 0; }
+
+        // Curve parameter in [0, 1] at a distance along the curve
+        float parameter_at_length(const float target_length)
+        {
+            const size_t last = lengths.size() - 1;
+            if (target_length <= 0.f) { cursor = 0; return 0.f; }
+            if (target_length >= lengths[last]) { cursor = last - 1; return 1.f; }
+
+            // Advance the cursor for forward playback; fall back to a binary
+            // search when the query moved backward or skipped ahead
+            if (target_length < lengths[cursor] || target_length > lengths[std::min(cursor + 4, last)])
+            {
+                cursor = std::upper_bound(lengths.begin(), lengths.end(), target_length) - lengths.begin() - 1;
+            }
+            while (lengths[cursor + 1] < target_length) ++cursor;
+
+            const float start = lengths[cursor];
+            const float end = lengths[cursor + 1];
+            const float fraction = (end > start) ? (target_length - start) / (end - start) : 0.f;
+            return (cursor + fraction) / float(last);
+        }
+
+        // Curve parameter in [0, 1] at a fraction of the total length
+        float parameter_at_fraction(const float u) { return parameter_at_length(u * total_length()); }
+    };
+
+    class bezier_spline
+    {
         float3 p0, p1, p2, p3;
-        std::vector<float> arcLengths;
-        
+        arc_length_table arcLengths;
+
     public:
         
         size_t num_steps;
@@ -44,7 +89,7 @@ namespace polymer
             this->p1 = p1;
             this->p2 = p2;
             this->p3 = p3;
-            calculate_length();
+            arcLengths.build([this](const float t) { return point(t); }, num_steps);
         }
         
         float3 point(const float t) const
@@ -92,37 +137,22 @@ namespace polymer
         
         float length() const
         {
-            return arcLengths[arcLengths.size() - 1];
+            return arcLengths.total_length();
         }
-        
+
+        // Maps a fraction of total arc length to the curve parameter; O(1) per call
+        // while t advances monotonically (see arc_length_table)
         float get_length_parameter(float t)
         {
-            float targetLength = t * arcLengths[arcLengths.size() - 1];
-            
-            // Find largest arc length that is less than the target length
-            size_t first = 0;
-            size_t last = arcLengths.size() - 1;
-            while (first <= last)
-            {
-                auto mid = (first + last) / 2;
-                if (arcLengths[mid] > targetLength) last = mid - 1;
-                else first = mid + 1;
-            }
-            
-            size_t index = first - 1;
-            if (arcLengths[index] == targetLength)
-            {
-                return index / float(arcLengths.size() - 1); // No need to interpolate
-            }
-            
-            // Begin interpolation
-            float start = arcLengths[index];
-            float end = arcLengths[index + 1];
-            float length = end - start;
-            float fraction = (targetLength - start) / length;
-            return (index + fraction) / float(arcLengths.size() - 1);
+            return arcLengths.parameter_at_fraction(t);
         }
-        
+
+        // Position at a fraction of total arc length - constant-speed playback
+        float3 point_at_fraction(const float t)
+        {
+            return point(get_length_parameter(t));
+        }
+
     };
     
 }
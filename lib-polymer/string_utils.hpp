@@ -9,9 +9,163 @@
 #include <functional>
 #include <cctype>
 #include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "flat_hash_map.hpp"
 
 namespace polymer
 {
+    /////////////////////
+    //   string_view   //
+    /////////////////////
+
+    // Minimal stand-in for std::string_view (the project toolset predates C++17): a
+    // non-owning pointer + length over characters someone else keeps alive. The parsing
+    // helpers below operate on views, so tokenizing a path or matching identifiers
+    // performs zero allocations.
+    struct string_view
+    {
+        const char * ptr{ nullptr };
+        size_t len{ 0 };
+
+        string_view() = default;
+        string_view(const char * s) : ptr(s), len(s ? std::char_traits<char>::length(s) : 0) {}
+        string_view(const char * s, const size_t l) : ptr(s), len(l) {}
+        string_view(const std::string & s) : ptr(s.data()), len(s.size()) {}
+
+        const char * data() const { return ptr; }
+        size_t size() const { return len; }
+        bool empty() const { return len == 0; }
+        char operator [] (const size_t i) const { return ptr[i]; }
+        const char * begin() const { return ptr; }
+        const char * end() const { return ptr + len; }
+
+        string_view substr(const size_t pos, const size_t count = size_t(-1)) const
+        {
+            if (pos >= len) return {};
+            return { ptr + pos, std::min(count, len - pos) };
+        }
+
+        bool starts_with(const string_view prefix) const
+        {
+            return prefix.len <= len && std::equal(prefix.begin(), prefix.end(), ptr);
+        }
+
+        size_t find(const char c, const size_t pos = 0) const
+        {
+            for (size_t i = pos; i < len; ++i) if (ptr[i] == c) return i;
+            return std::string::npos;
+        }
+
+        std::string to_string() const { return std::string(ptr, len); }
+
+        bool operator == (const string_view r) const { return len == r.len && std::equal(begin(), end(), r.begin()); }
+        bool operator != (const string_view r) const { return !(*this == r); }
+    };
+
+    // Calls `f(string_view)` once per delimiter-separated token without allocating.
+    // Every token is reported, including the empties produced by adjacent, leading,
+    // or trailing delimiters.
+    template<class F>
+    inline void tokenize(const string_view s, const char delim, F f)
+    {
+        size_t start = 0;
+        for (size_t i = 0; i <= s.size(); ++i)
+        {
+            if (i == s.size() || s[i] == delim)
+            {
+                f(s.substr(start, i - start));
+                start = i + 1;
+            }
+        }
+    }
+
+    // split() for callers that need random access to the pieces: one vector of views,
+    // no per-piece string copies. Matches split()'s std::getline semantics: leading
+    // and interior empty tokens are kept, a trailing empty token is not.
+    inline std::vector<string_view> split_views(const string_view s, const char delim)
+    {
+        std::vector<string_view> views;
+        tokenize(s, delim, [&views](const string_view token) { views.push_back(token); });
+        if (!views.empty() && views.back().empty()) views.pop_back();
+        return views;
+    }
+
+    inline string_view trim_view(const string_view s)
+    {
+        size_t b = 0, e = s.size();
+        while (b < e && std::isspace(static_cast<unsigned char>(s[b]))) ++b;
+        while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1]))) --e;
+        return s.substr(b, e - b);
+    }
+
+    /////////////////////////
+    //   string_interner   //
+    /////////////////////////
+
+    // Process-wide table mapping strings to dense 32-bit symbols. Interning hashes and
+    // stores a name exactly once; afterwards equality checks, map keys and
+    // cross-references are single integer compares. find() never grows the table, so
+    // lookups against transient query text stay allocation-free.
+    using symbol_id = uint32_t;
+    constexpr symbol_id kInvalidSymbol = 0;
+
+    class string_interner
+    {
+        flat_hash_map<uint64_t, symbol_id> lookup; // fnv-1a of the text -> symbol
+        std::deque<std::string> strings;           // symbol -> text; deque keeps resolve() references stable
+        std::mutex mutex;
+
+        static uint64_t hash_view(const string_view s)
+        {
+            uint64_t h = 0xcbf29ce484222325ull;
+            for (const char c : s) h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            return h;
+        }
+
+    public:
+
+        string_interner() { strings.emplace_back(); } // slot 0 backs kInvalidSymbol
+
+        static string_interner & get()
+        {
+            static string_interner table;
+            return table;
+        }
+
+        // The symbol for `s`, interning it on first sight
+        symbol_id intern(const string_view s)
+        {
+            if (s.empty()) return kInvalidSymbol;
+            std::lock_guard<std::mutex> guard(mutex);
+            const uint64_t h = hash_view(s);
+            auto iter = lookup.find(h);
+            if (iter != lookup.end()) return iter->second;
+            const symbol_id symbol = static_cast<symbol_id>(strings.size());
+            strings.push_back(s.to_string());
+            lookup.emplace(h, symbol);
+            return symbol;
+        }
+
+        // Lookup without interning, for query text that should not grow the table
+        symbol_id find(const string_view s)
+        {
+            if (s.empty()) return kInvalidSymbol;
+            std::lock_guard<std::mutex> guard(mutex);
+            auto iter = lookup.find(hash_view(s));
+            return iter != lookup.end() ? iter->second : kInvalidSymbol;
+        }
+
+        // The interned text for `symbol` (empty for kInvalidSymbol or an unknown id).
+        // Interned strings are immutable and never move, so the reference stays valid.
+        const std::string & resolve(const symbol_id symbol)
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            return symbol < strings.size() ? strings[symbol] : strings[0];
+        }
+    };
+
     inline bool starts_with(const std::string & str, const std::string & search)
     {
         return search.length() <= str.length() && std::equal(search.begin(), search.end(), str.begin());
@@ -1,78 +1,407 @@
-// A cleaned up version of https://github.com/progschj/ThreadPool (BSD 3-Clause)
+// Originally a cleaned up version of https://github.com/progschj/ThreadPool (BSD 3-Clause),
+// since rewritten as a work-stealing scheduler. The single mutex-guarded queue serialized
+// every submission, which collapses once callers start issuing fine-grained tasks (per-octant
+// culls, per-mesh imports, etc). Each worker now owns a deque: it pops its own work LIFO for
+// cache locality and steals FIFO from its siblings when idle, so the only contention is on a
+// victim's deque during a steal. The coarse `enqueue` future-returning API is unchanged.
 
 #pragma once
 
 #ifndef polymer_thread_pool_hpp
 #define polymer_thread_pool_hpp
 
+#include <chrono>
 #include <condition_variable>
 #include <future>
 #include <functional>
 #include <atomic>
-#include <queue>
+#include <deque>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <vector>
 
 namespace polymer
 {
-    class simple_thread_pool
+    ////////////////////////
+    //   task_scheduler   //
+    ////////////////////////
+
+    class task_scheduler
     {
+        struct worker_deque
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<worker_deque>> queues;
         std::vector<std::thread> workers;
-        std::queue<std::function<void()>> tasks;
 
-        std::mutex queue_mutex;
-        std::condition_variable cv;
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
         std::atomic<bool> should_stop{ false };
+        std::atomic<size_t> approx_pending{ 0 };   // wake predicate only; deques are the source of truth
+        std::atomic<size_t> next_victim{ 0 };      // round-robin submission point for external threads
 
-    public:
+        // Identifies the calling thread as a worker of a particular scheduler so submissions
+        // from inside a task land on the caller's own deque (and steals skip it).
+        struct thread_identity { task_scheduler * owner{ nullptr }; size_t index{ 0 }; };
+        static thread_identity & identity() { static thread_local thread_identity id; return id; }
 
-        simple_thread_pool(const size_t num_threads = std::thread::hardware_concurrency())
+        void worker_main(const size_t index)
         {
-            for (size_t i = 0; i < num_threads; ++i)
+            identity() = { this, index };
+            while (!should_stop)
             {
-                workers.emplace_back([this] {
-                    while (true)
-                    {
-                        std::function<void()> task;
-                        {
-                            std::unique_lock<std::mutex> lk(queue_mutex);
-                            cv.wait(lk, [this] { return should_stop || !tasks.empty(); });
-                            if (should_stop && tasks.empty()) return;
-                            task = std::move(tasks.front());
-                            tasks.pop();
-                        }
-                        task();
-                    }
-                });
+                if (!try_run_one())
+                {
+                    std::unique_lock<std::mutex> lk(sleep_mutex);
+                    sleep_cv.wait(lk, [this] { return should_stop || approx_pending > 0; });
+                }
             }
+            identity() = {};
         }
 
-        ~simple_thread_pool()
+        bool try_pop(const size_t queueIndex, const bool stealing, std::function<void()> & out)
+        {
+            worker_deque & q = *queues[queueIndex];
+            std::lock_guard<std::mutex> lk(q.mutex);
+            if (q.tasks.empty()) return false;
+            // Owner pops newest (LIFO, cache-hot); thieves take oldest (FIFO)
+            if (stealing) { out = std::move(q.tasks.front()); q.tasks.pop_front(); }
+            else { out = std::move(q.tasks.back()); q.tasks.pop_back(); }
+            --approx_pending;
+            return true;
+        }
+
+    public:
+
+        task_scheduler(const size_t num_threads = std::thread::hardware_concurrency())
+        {
+            const size_t count = num_threads ? num_threads : 1;
+            for (size_t i = 0; i < count; ++i) queues.emplace_back(new worker_deque());
+            for (size_t i = 0; i < count; ++i) workers.emplace_back([this, i] { worker_main(i); });
+        }
+
+        ~task_scheduler()
         {
             should_stop = true;
-            cv.notify_all();
+            sleep_cv.notify_all();
             for (std::thread & worker : workers) if (worker.joinable()) worker.join();
         }
 
+        size_t get_worker_count() const { return workers.size(); }
+
+        // Fire-and-forget submission. Worker threads push onto their own deque;
+        // external threads distribute round-robin.
+        void submit(std::function<void()> task)
+        {
+            const thread_identity & id = identity();
+            const size_t queueIndex = (id.owner == this) ? id.index : (next_victim++ % queues.size());
+
+            // The counter bumps under sleep_mutex so it can't interleave between a
+            // worker's predicate check and its wait - that window silently drops
+            // the wakeup and strands the task until an unrelated submit. It also
+            // bumps before the push: a task must never be poppable while uncounted,
+            // or the pop's decrement underflows the counter.
+            {
+                std::lock_guard<std::mutex> lk(sleep_mutex);
+                if (should_stop) throw std::runtime_error("submit on a task_scheduler scheduled to exit...");
+                ++approx_pending;
+            }
+            {
+                std::lock_guard<std::mutex> lk(queues[queueIndex]->mutex);
+                queues[queueIndex]->tasks.push_back(std::move(task));
+            }
+            sleep_cv.notify_one();
+        }
+
+        // Runs one pending task on the calling thread if any is available. Used by the worker
+        // loop, and by waiters (task_group::wait) so a worker blocked on a group keeps the
+        // scheduler making progress instead of idling.
+        bool try_run_one()
+        {
+            const thread_identity & id = identity();
+            std::function<void()> task;
+
+            if (id.owner == this && try_pop(id.index, false, task)) { task(); return true; }
+
+            const size_t start = (id.owner == this) ? id.index : next_victim.load();
+            for (size_t offset = 1; offset <= queues.size(); ++offset)
+            {
+                const size_t victim = (start + offset) % queues.size();
+                if (id.owner == this && victim == id.index) continue;
+                if (try_pop(victim, true, task)) { task(); return true; }
+            }
+            return false;
+        }
+
+        // Future-returning submission for coarse jobs (unchanged from simple_thread_pool)
         template<class F, class... Args>
         decltype(auto) enqueue(F && f, Args &&... args)
         {
             using return_type = typename std::result_of<F(Args...)>::type;
             auto task = std::make_shared<std::packaged_task<return_type()>>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-
             std::future<return_type> task_future = task->get_future();
+            submit([task]() { (*task)(); });
+            return task_future;
+        }
+    };
+
+    // The original single-queue pool is gone; existing callers pick up work-stealing for free.
+    using simple_thread_pool = task_scheduler;
+
+    ////////////////////
+    //   task_group   //
+    ////////////////////
+
+    // Waitable batch of fire-and-forget tasks. wait() helps execute pending scheduler work
+    // while the group drains, so it is safe to wait from inside another task.
+    class task_group
+    {
+        std::atomic<uint32_t> pending{ 0 };
+        std::mutex wait_mutex;
+        std::condition_variable wait_cv;
+        task_scheduler * scheduler{ nullptr };
+
+    public:
+
+        template<class F>
+        void run(task_scheduler & s, F && f)
+        {
+            scheduler = &s;
+            ++pending;
+            auto fn = std::make_shared<typename std::decay<F>::type>(std::forward<F>(f));
+            s.submit([this, fn]()
+            {
+                (*fn)();
+                // The final decrement and notify happen under wait_mutex, and the
+                // waiter's exit check takes the same mutex: a waiter can only see
+                // zero and return (destroying the group - it's a stack object in
+                // parallel_for) after this thread's unlock, its last touch of the
+                // group.
+                std::lock_guard<std::mutex> lk(wait_mutex);
+                if (pending.fetch_sub(1) == 1) wait_cv.notify_all();
+            });
+        }
+
+        void wait()
+        {
+            for (;;)
             {
-                std::unique_lock<std::mutex> lock(queue_mutex);
-                if (should_stop) throw std::runtime_error("enqueue on a thread_pool scheduled to exit...");
-                tasks.emplace([task]() { (*task)(); });
+                {
+                    std::lock_guard<std::mutex> lk(wait_mutex);
+                    if (pending == 0) return;
+                }
+                if (!scheduler || !scheduler->try_run_one())
+                {
+                    std::unique_lock<std::mutex> lk(wait_mutex);
+                    wait_cv.wait_for(lk, std::chrono::milliseconds(1), [this] { return pending == 0; });
+                    if (pending == 0) return;
+                }
             }
+        }
+    };
 
-            cv.notify_one();
-            return task_future;
+    /////////////////////
+    //   task_handle   //
+    /////////////////////
+
+    // Handle to a spawned task's eventual result. `then` chains a continuation that runs on
+    // the scheduler once the result is ready (immediately re-submitted if it already is).
+
+    template<class T>
+    struct task_shared_state
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool completed{ false };
+        T result;
+        std::function<void(T &)> continuation;
+    };
+
+    template<>
+    struct task_shared_state<void>
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool completed{ false };
+        std::function<void()> continuation;
+    };
+
+    template<class T>
+    class task_handle
+    {
+        std::shared_ptr<task_shared_state<T>> state;
+        task_scheduler * scheduler{ nullptr };
+
+        template<class F> friend auto spawn(task_scheduler & s, F && f) -> task_handle<typename std::result_of<F()>::type>;
+        task_handle(std::shared_ptr<task_shared_state<T>> st, task_scheduler * s) : state(std::move(st)), scheduler(s) {}
+
+    public:
+
+        task_handle() = default;
+
+        bool valid() const { return state != nullptr; }
+
+        bool ready() const
+        {
+            std::lock_guard<std::mutex> lk(state->mutex);
+            return state->completed;
+        }
+
+        T & get()
+        {
+            std::unique_lock<std::mutex> lk(state->mutex);
+            state->cv.wait(lk, [this] { return state->completed; });
+            return state->result;
+        }
+
+        template<class F>
+        void then(F && f)
+        {
+            auto st = state;
+            std::function<void(T &)> continuation = std::forward<F>(f);
+            std::unique_lock<std::mutex> lk(st->mutex);
+            if (st->completed)
+            {
+                lk.unlock();
+                scheduler->submit([st, continuation]() { continuation(st->result); });
+            }
+            else st->continuation = std::move(continuation);
         }
     };
 
+    template<>
+    class task_handle<void>
+    {
+        std::shared_ptr<task_shared_state<void>> state;
+        task_scheduler * scheduler{ nullptr };
+
+        template<class F> friend auto spawn(task_scheduler & s, F && f) -> task_handle<typename std::result_of<F()>::type>;
+        task_handle(std::shared_ptr<task_shared_state<void>> st, task_scheduler * s) : state(std::move(st)), scheduler(s) {}
+
+    public:
+
+        task_handle() = default;
+
+        bool valid() const { return state != nullptr; }
+
+        bool ready() const
+        {
+            std::lock_guard<std::mutex> lk(state->mutex);
+            return state->completed;
+        }
+
+        void get()
+        {
+            std::unique_lock<std::mutex> lk(state->mutex);
+            state->cv.wait(lk, [this] { return state->completed; });
+        }
+
+        template<class F>
+        void then(F && f)
+        {
+            auto st = state;
+            std::function<void()> continuation = std::forward<F>(f);
+            std::unique_lock<std::mutex> lk(st->mutex);
+            if (st->completed)
+            {
+                lk.unlock();
+                scheduler->submit([continuation]() { continuation(); });
+            }
+            else st->continuation = std::move(continuation);
+        }
+    };
+
+    namespace detail
+    {
+        template<class T, class F>
+        void run_spawned_task(const std::shared_ptr<task_shared_state<T>> & st, task_scheduler * s, F & fn)
+        {
+            T value = fn();
+            std::function<void(T &)> continuation;
+            {
+                std::lock_guard<std::mutex> lk(st->mutex);
+                st->result = std::move(value);
+                st->completed = true;
+                continuation = std::move(st->continuation);
+            }
+            st->cv.notify_all();
+            if (continuation) s->submit([st, continuation]() { continuation(st->result); });
+        }
+
+        template<class F>
+        void run_spawned_task(const std::shared_ptr<task_shared_state<void>> & st, task_scheduler * s, F & fn)
+        {
+            fn();
+            std::function<void()> continuation;
+            {
+                std::lock_guard<std::mutex> lk(st->mutex);
+                st->completed = true;
+                continuation = std::move(st->continuation);
+            }
+            st->cv.notify_all();
+            if (continuation) s->submit(std::move(continuation));
+        }
+    }
+
+    template<class F>
+    auto spawn(task_scheduler & s, F && f) -> task_handle<typename std::result_of<F()>::type>
+    {
+        using return_type = typename std::result_of<F()>::type;
+        auto state = std::make_shared<task_shared_state<return_type>>();
+        auto fn = std::make_shared<typename std::decay<F>::type>(std::forward<F>(f));
+        task_scheduler * scheduler = &s;
+        s.submit([state, fn, scheduler]() { detail::run_spawned_task(state, scheduler, *fn); });
+        return task_handle<return_type>(state, scheduler);
+    }
+
+    //////////////////////
+    //   parallel_for   //
+    //////////////////////
+
+    // Process-wide scheduler for the data-parallel helpers; callers that want their own
+    // worker budget can still construct a private task_scheduler.
+    inline task_scheduler & get_task_scheduler()
+    {
+        static task_scheduler scheduler;
+        return scheduler;
+    }
+
+    // Data-parallel loop over [begin, end): invokes fn(index) for every index, split into
+    // chunks of at least `grain` iterations, and blocks until the whole range is done (the
+    // calling thread executes chunks too, via task_group's helping wait). Ranges smaller
+    // than one grain run inline with no scheduling overhead. Pick the grain so a chunk does
+    // a few microseconds of work - too small and scheduling dominates.
+    template<class F>
+    void parallel_for(const size_t begin, const size_t end, const size_t grain, F && fn)
+    {
+        if (end <= begin) return;
+
+        task_scheduler & scheduler = get_task_scheduler();
+        const size_t count = end - begin;
+        const size_t chunk = grain > 0 ? grain : 1;
+
+        if (count <= chunk || scheduler.get_worker_count() < 2)
+        {
+            for (size_t i = begin; i < end; ++i) fn(i);
+            return;
+        }
+
+        task_group group;
+        for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunk)
+        {
+            const size_t chunkEnd = (chunkBegin + chunk < end) ? chunkBegin + chunk : end;
+            group.run(scheduler, [chunkBegin, chunkEnd, &fn]()
+            {
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) fn(i);
+            });
+        }
+        group.wait();
+    }
+
 } // end namespace polymer
 
 #endif // end polymer_thread_pool_hpp
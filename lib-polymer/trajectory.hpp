@@ -11,9 +11,26 @@
 #include "util.hpp"
 #include "math-core.hpp"
 #include "solvers.hpp"
+#include "splines.hpp"
 
 namespace polymer
 {
+    // Position along a ballistic arc at time t (gravity positive down, matching the solvers below)
+    inline float3 ballistic_position(const float3 origin, const float3 fire_velocity, const float gravity, const float t)
+    {
+        return origin + fire_velocity * t + float3(0.f, -0.5f * gravity * t * t, 0.f);
+    }
+
+    // Arc-length table over a ballistic arc, for constant-speed playback along the
+    // trajectory (tracer previews, teleport arcs). Sampling by time bunches points at the
+    // apex where vertical speed is lowest; mapping through the table keeps spacing even,
+    // and the table's cursor makes monotone playback O(1) per frame.
+    inline arc_length_table make_ballistic_arc_table(const float3 origin, const float3 fire_velocity, const float gravity, const float duration, const size_t num_samples = 32)
+    {
+        arc_length_table table;
+        table.build([&](const float u) { return ballistic_position(origin, fire_velocity, gravity, u * duration); }, num_samples);
+        return table;
+    }
     // Calculate the maximum range that a ballistic projectile can be fired on given speed and gravity.
     //
     // speed (float): projectile velocity
@@ -51,6 +51,20 @@
     #include <malloc.h>
 #endif
 
+#include <assert.h>
+
+// POLYMER_SHIPPING is defined by the Shipping solution configuration (LTO, checked
+// iterators off). POLYMER_ASSERT_HOT marks checks that sit on per-element or
+// per-frame inner loops: they behave like assert() in every other configuration
+// and compile to nothing in shipping, where the arguments are not evaluated.
+// Checks that run once per operation (setup, teardown, load) should stay plain
+// assert() - the cost is unmeasurable and shipping crash dumps are better with them.
+#if defined(POLYMER_SHIPPING)
+    #define POLYMER_ASSERT_HOT(expr) ((void) 0)
+#else
+    #define POLYMER_ASSERT_HOT(expr) assert(expr)
+#endif
+
 #include <stdlib.h>
 #include <algorithm>
 #include <cstddef>
@@ -78,7 +92,7 @@ inline void polymer_aligned_free(void * ptr)
 
 namespace polymer
 {
-    // 32 bit Fowler�Noll�Vo Hash
+    // 32 bit Fowler�Noll�Vo Hash
     inline uint32_t poly_hash_fnv1a(const std::string & str)
     {
         static const uint32_t fnv1aBase32 = 0x811C9DC5u;
@@ -131,6 +145,7 @@ namespace polymer
         std::uniform_real_distribution<float> two_pi { 0.f, float(6.2831853071795862) };
     public:
         uniform_random_gen() : rd(), gen(rd()) { }
+        uniform_random_gen(uint64_t seed) : rd(), gen(seed) { } // deterministic sequence for a given seed
         float random_float() { return full(gen); }
         float random_float(float max) { std::uniform_real_distribution<float> custom(0.f, max); return custom(gen); }
         float random_float(float min, float max) { std::uniform_real_distribution<float> custom(min, max); return custom(gen); }
@@ -1,6 +1,19 @@
 /*
  * File: samples/engine-ecs-stress.cpp
- * Modified `engine-scene` sample
+ * Modified `engine-scene` sample. In addition to the interactive view, this sample
+ * doubles as a scaling benchmark for the ECS + renderer path. Pass `--benchmark` to
+ * sweep entity counts and component mix profiles over a fixed number of frames and
+ * write per-system CPU timings (via profiling.hpp) to a CSV for regression tracking:
+ *
+ *     engine-ecs-stress --benchmark
+ *         [--entities 1000,4000,16000,64000,250000,500000]
+ *         [--profiles render,full]
+ *         [--frames 256]
+ *         [--csv ecs-stress-benchmark.csv]
+ *
+ * The `render` profile creates transform + identifier + mesh + material components;
+ * `full` additionally creates a geometry component registered with the collision
+ * system, matching the interactive scene.
  */
 
 #include "lib-polymer.hpp"
@@ -10,8 +23,29 @@
 #include "environment.hpp"
 #include "renderer-util.hpp"
 
+#include <fstream>
+#include <sstream>
+
 using namespace polymer;
 
+struct benchmark_config
+{
+    bool enabled{ false };
+    std::vector<uint32_t> entityCounts{ 1000, 4000, 16000, 64000, 250000, 500000 };
+    std::vector<std::string> profiles{ "render", "full" };
+    uint32_t framesPerRun{ 256 };
+    uint32_t warmupFrames{ 32 };
+    std::string csvPath{ "ecs-stress-benchmark.csv" };
+};
+
+struct benchmark_row
+{
+    std::string profile;
+    uint32_t entities{ 0 };
+    std::string metric;
+    double average_ms{ 0.0 };
+};
+
 struct sample_engine_ecs final : public polymer_app
 {
     perspective_camera cam;
@@ -25,19 +59,34 @@ struct sample_engine_ecs final : public polymer_app
     render_payload payload;
     environment scene;
 
-    sample_engine_ecs();
+    // Benchmark state: sweep points are the cross product of profiles x entity counts,
+    // advanced from on_draw() after each fixed-length measurement window.
+    benchmark_config config;
+    size_t sweepIndex{ 0 };
+    uint32_t frameIndex{ 0 };
+    double frameAccumMs{ 0.0 };
+    double sceneCreateMs{ 0.0 };
+    std::vector<benchmark_row> rows;
+
+    sample_engine_ecs(const benchmark_config & cfg);
     ~sample_engine_ecs();
 
+    void populate_scene(const uint32_t count, const std::string & profile);
+    void clear_scene();
+    void begin_sweep_point();
+    void finish_sweep_point();
+    bool write_csv() const;
+
     void on_window_resize(int2 size) override;
     void on_input(const app_input_event & event) override;
     void on_update(const app_update_event & e) override;
     void on_draw() override;
 };
 
-sample_engine_ecs::sample_engine_ecs() : polymer_app(1280, 720, "sample-ecs-stress")
+sample_engine_ecs::sample_engine_ecs(const benchmark_config & cfg) : polymer_app(1280, 720, "sample-ecs-stress"), config(cfg)
 {
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1);
+    glfwSwapInterval(config.enabled ? 0 : 1); // uncap the swap rate when measuring
 
     int width, height;
     glfwGetWindowSize(window, &width, &height);
@@ -73,54 +122,133 @@ sample_engine_ecs::sample_engine_ecs() : polymer_app(1280, 720, "sample-ecs-stre
     create_handle_for_asset("debug-icosahedron", make_mesh_from_geometry(make_icosasphere(5))); // gpu mesh
     create_handle_for_asset("debug-icosahedron", make_icosasphere(5)); // cpu mesh
 
+    if (config.enabled)
     {
-        uniform_random_gen rand;
-        scoped_timer create_timer("create 16384 entities");
-
-        // Configuring an entity at runtime programmatically
-        for (uint32_t entity_index = 0; entity_index < 16384; ++entity_index)
-        {
-            // Create a new entity to represent an icosahedron that we will render
-            const entity debug_icosa = scene.track_entity(orchestrator->create_entity());
+        // Pull the camera back so the bulk of the field is inside the frustum and the
+        // renderer actually pays for what we created.
+        cam.look_at({ 0, 0, 180 }, { 0, 0, 0 });
+        begin_sweep_point();
+    }
+    else
+    {
+        populate_scene(16384, "full");
+        cam.look_at({ 0, 0, 2 }, { 0, 0.1f, 0 });
+    }
 
-            const float rnd1 = static_cast<float>(rand.random_int(-128, 128));
-            const float rnd2 = static_cast<float>(rand.random_int(-128, 128));
-            const float rnd3 = static_cast<float>(rand.random_int(-128, 128));
-            const float rnd_scale = rand.random_float(0.1f, 0.5f);
+    flycam.set_camera(&cam);
+}
 
-            // Give the icosa a name and default transform and scale
-            scene.identifier_system->create(debug_icosa, "debug-icosahedron-" + std::to_string(entity_index));
-            scene.xform_system->create(debug_icosa, transform(float3(rnd1, rnd2, rnd3)), float3(rnd_scale));
+sample_engine_ecs::~sample_engine_ecs() {}
 
-            // Create mesh component for the gpu mesh.
-            polymer::mesh_component mesh_component(debug_icosa);
-            mesh_component.mesh = gpu_mesh_handle("debug-icosahedron");
-            scene.render_system->create(debug_icosa, std::move(mesh_component));
+void sample_engine_ecs::populate_scene(const uint32_t count, const std::string & profile)
+{
+    // Seeded so that every run of a sweep point measures an identical scene
+    uniform_random_gen rand(0x5EED0000ull + count);
+    manual_timer create_timer;
+    create_timer.start();
 
-            // Create a geometry for the cpu mesh. This type of mesh is used for raycasting
-            // and collision, so not strictly required for this sample.
+    // Configuring entities at runtime programmatically
+    for (uint32_t entity_index = 0; entity_index < count; ++entity_index)
+    {
+        // Create a new entity to represent an icosahedron that we will render
+        const entity debug_icosa = scene.track_entity(orchestrator->create_entity());
+
+        const float rnd1 = static_cast<float>(rand.random_int(-128, 128));
+        const float rnd2 = static_cast<float>(rand.random_int(-128, 128));
+        const float rnd3 = static_cast<float>(rand.random_int(-128, 128));
+        const float rnd_scale = rand.random_float(0.1f, 0.5f);
+
+        // Give the icosa a name and default transform and scale
+        scene.identifier_system->create(debug_icosa, "debug-icosahedron-" + std::to_string(entity_index));
+        scene.xform_system->create(debug_icosa, transform(float3(rnd1, rnd2, rnd3)), float3(rnd_scale));
+
+        // Create mesh component for the gpu mesh.
+        polymer::mesh_component mesh_component(debug_icosa);
+        mesh_component.mesh = gpu_mesh_handle("debug-icosahedron");
+        scene.render_system->create(debug_icosa, std::move(mesh_component));
+
+        // The `full` profile additionally creates a geometry for the cpu mesh. This type
+        // of mesh is used for raycasting and collision, so not strictly required to render.
+        if (profile == "full")
+        {
             polymer::geometry_component geom_component(debug_icosa);
             geom_component.geom = cpu_mesh_handle("debug-icosahedron");
             scene.collision_system->create(debug_icosa, std::move(geom_component));
+        }
 
-            // Create material component with a default (normal-mapped) material
-            polymer::material_component material_component(debug_icosa);
-            material_component.material = material_handle(material_library::kDefaultMaterialId);
-            scene.render_system->create(debug_icosa, std::move(material_component));
+        // Create material component with a default (normal-mapped) material
+        polymer::material_component material_component(debug_icosa);
+        material_component.material = material_handle(material_library::kDefaultMaterialId);
+        scene.render_system->create(debug_icosa, std::move(material_component));
 
-            // Assemble a render_component (gather components so the renderer does not have to interface
-            // with many systems). Ordinarily this assembly is done per-frame in the update loop, but
-            // this is a fully static scene.
-            render_component debug_icosahedron_renderable = assemble_render_component(scene, debug_icosa);
-            payload.render_components.push_back(debug_icosahedron_renderable);
-        }
+        // Assemble a render_component (gather components so the renderer does not have to interface
+        // with many systems). Ordinarily this assembly is done per-frame in the update loop, but
+        // this is a fully static scene.
+        render_component debug_icosahedron_renderable = assemble_render_component(scene, debug_icosa);
+        payload.render_components.push_back(debug_icosahedron_renderable);
     }
 
-    cam.look_at({ 0, 0, 2 }, { 0, 0.1f, 0 });
-    flycam.set_camera(&cam);
+    create_timer.stop();
+    sceneCreateMs = create_timer.get();
+    std::cout << "created " << count << " entities (" << profile << ") in " << sceneCreateMs << " ms" << std::endl;
 }
 
-sample_engine_ecs::~sample_engine_ecs() {}
+void sample_engine_ecs::clear_scene()
+{
+    scene.destroy(kAllEntities);
+    payload.render_components.clear();
+    scene.render_system->get_renderer()->cpuProfiler.set_enabled(true); // clears accumulated data points
+}
+
+void sample_engine_ecs::begin_sweep_point()
+{
+    const size_t countsPerProfile = config.entityCounts.size();
+    const std::string & profile = config.profiles[sweepIndex / countsPerProfile];
+    const uint32_t count = config.entityCounts[sweepIndex % countsPerProfile];
+
+    populate_scene(count, profile);
+    frameIndex = 0;
+    frameAccumMs = 0.0;
+}
+
+void sample_engine_ecs::finish_sweep_point()
+{
+    const size_t countsPerProfile = config.entityCounts.size();
+    const std::string & profile = config.profiles[sweepIndex / countsPerProfile];
+    const uint32_t count = config.entityCounts[sweepIndex % countsPerProfile];
+
+    rows.push_back({ profile, count, "scene_create", sceneCreateMs });
+    rows.push_back({ profile, count, "frame_total", frameAccumMs / config.framesPerRun });
+    for (auto & stage : scene.render_system->get_renderer()->cpuProfiler.get_data())
+    {
+        rows.push_back({ profile, count, stage.first, double(stage.second) });
+    }
+
+    clear_scene();
+
+    if (++sweepIndex >= config.profiles.size() * countsPerProfile)
+    {
+        if (write_csv()) std::cout << "wrote " << config.csvPath << " (" << rows.size() << " rows)" << std::endl;
+        else std::cout << "could not write " << config.csvPath << std::endl;
+        glfwSetWindowShouldClose(window, 1);
+    }
+    else
+    {
+        begin_sweep_point();
+    }
+}
+
+bool sample_engine_ecs::write_csv() const
+{
+    std::ofstream file(config.csvPath, std::ios::trunc);
+    if (!file.is_open()) return false;
+    file << "profile,entities,frames,metric,avg_ms\n";
+    for (const benchmark_row & row : rows)
+    {
+        file << row.profile << "," << row.entities << "," << config.framesPerRun << "," << row.metric << "," << row.average_ms << "\n";
+    }
+    return true;
+}
 
 void sample_engine_ecs::on_window_resize(int2 size) {}
 
@@ -141,6 +269,9 @@ void sample_engine_ecs::on_draw()
 {
     glfwMakeContextCurrent(window);
 
+    manual_timer frame_timer;
+    frame_timer.start();
+
     int width, height;
     glfwGetWindowSize(window, &width, &height);
 
@@ -162,22 +293,66 @@ void sample_engine_ecs::on_draw()
 
     fullscreen_surface->draw(scene.render_system->get_renderer()->get_color_texture(viewIndex));
 
-    // Optional debug output
-    for (auto & t : scene.render_system->get_renderer()->cpuProfiler.get_data())
+    if (!config.enabled)
     {
-        std::cout << "[render_system CPU] " << t.first.c_str() << " - " << t.second << "ms" << std::endl;
+        // Optional debug output
+        for (auto & t : scene.render_system->get_renderer()->cpuProfiler.get_data())
+        {
+            std::cout << "[render_system CPU] " << t.first.c_str() << " - " << t.second << "ms" << std::endl;
+        }
     }
 
     gl_check_error(__FILE__, __LINE__);
 
-    glfwSwapBuffers(window); 
+    glfwSwapBuffers(window);
+
+    if (config.enabled)
+    {
+        frame_timer.stop();
+
+        // The first `warmupFrames` frames of each sweep point absorb shader compiles,
+        // first-touch allocations and driver warmup; only the rest are measured.
+        frameIndex++;
+        if (frameIndex > config.warmupFrames) frameAccumMs += frame_timer.get();
+        if (frameIndex == config.warmupFrames + config.framesPerRun) finish_sweep_point();
+    }
+}
+
+std::vector<std::string> split_comma_list(const std::string & list)
+{
+    std::vector<std::string> tokens;
+    std::istringstream stream(list);
+    std::string token;
+    while (std::getline(stream, token, ',')) if (!token.empty()) tokens.push_back(token);
+    return tokens;
+}
+
+benchmark_config parse_benchmark_config(int argc, char * argv[])
+{
+    benchmark_config config;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--benchmark") config.enabled = true;
+        else if (arg == "--entities" && i + 1 < argc)
+        {
+            config.entityCounts.clear();
+            for (auto & token : split_comma_list(argv[++i])) config.entityCounts.push_back(static_cast<uint32_t>(std::stoul(token)));
+        }
+        else if (arg == "--profiles" && i + 1 < argc) config.profiles = split_comma_list(argv[++i]);
+        else if (arg == "--frames" && i + 1 < argc) config.framesPerRun = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--csv" && i + 1 < argc) config.csvPath = argv[++i];
+        else std::cout << "unknown argument: " << arg << std::endl;
+    }
+    if (config.entityCounts.empty() || config.profiles.empty() || config.framesPerRun == 0) config.enabled = false;
+    return config;
 }
 
 int main(int argc, char * argv[])
 {
     try
     {
-        sample_engine_ecs app;
+        sample_engine_ecs app(parse_benchmark_config(argc, argv));
         app.main_loop();
     }
     catch (const std::exception & e)
@@ -59,9 +59,25 @@ sample_vr_app::sample_vr_app() : polymer_app(1280, 800, "sample-engine-openvr-sc
         scene.render_system->get_renderer()->set_stencil_mask(0, hmd->get_stencil_mask(vr_eye::left_eye));
         scene.render_system->get_renderer()->set_stencil_mask(1, hmd->get_stencil_mask(vr_eye::right_eye));
 
-        // Only need to set the skybox on the |render_payload| once (unless we clear the payload)
-        payload.skybox = scene.render_system->get_skybox();
-        payload.sunlight = scene.render_system->get_implicit_sunlight();
+        // Late-latch: just before the renderer consumes the view matrices, replace each eye's
+        // pose with one predicted to photon time by the hmd's tracking thread. The poses set
+        // in on_draw become a fallback for the first frames before a sample is available.
+        scene.render_system->get_renderer()->set_late_latch([this](view_data & view)
+        {
+            transform predicted_hmd_pose;
+            if (hmd->get_predicted_hmd_pose(predicted_hmd_pose))
+            {
+                view = view_data(view.index, hmd->get_eye_pose_from(predicted_hmd_pose, static_cast<vr_eye>(view.index)), view.projectionMatrix);
+            }
+        });
+
+        // Only need to set the skybox once (unless we clear the payload), but on
+        // both of the pipeline's buffers since frames alternate between them
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            pipeline.payload(i).skybox = scene.render_system->get_skybox();
+            pipeline.payload(i).sunlight = scene.render_system->get_implicit_sunlight();
+        }
 
         {
             create_handle_for_asset("floor-mesh", make_mesh_from_geometry(make_plane(48, 48, 24, 24))); // gpu mesh
@@ -76,6 +92,15 @@ sample_vr_app::sample_vr_app() : polymer_app(1280, 800, "sample-engine-openvr-sc
             scene.render_system->create(floor, mesh_component(floor, gpu_mesh_handle("floor-mesh")));
         }
 
+        // Physics: the controllers are pose-driven rigid bodies colliding against a
+        // static ground plane matching the visual floor. Each frame's step runs on a
+        // worker via update_async(), joined by the sync() at the top of on_update.
+        physics_engine = std::make_shared<bullet_engine>();
+        physics_floor = physics_engine->create_object(new btDefaultMotionState(), new btStaticPlaneShape(btVector3(0, 1, 0), 0.f), physics_engine->get_world(), 0.f);
+        physics_engine->add_object(physics_floor);
+        left_physics_controller.reset(new physics_object_openvr_controller(physics_engine));
+        right_physics_controller.reset(new physics_object_openvr_controller(physics_engine));
+
         input_processor.reset(new xr_input_processor(orchestrator.get(), &scene, hmd.get()));
         controller_system.reset(new xr_controller_system(orchestrator.get(), &scene, hmd.get(), input_processor.get()));
         gizmo_system.reset(new xr_gizmo_system(orchestrator.get(), &scene, hmd.get(), input_processor.get()));
@@ -112,6 +137,9 @@ void sample_vr_app::on_update(const app_update_event & e)
 {
     shaderMonitor.handle_recompile();
 
+    // Join last frame's physics step before anything reads or writes body state
+    physics_engine->sync();
+
     hmd->update();
     scene.event_manager->process();
 
@@ -120,6 +148,13 @@ void sample_vr_app::on_update(const app_update_event & e)
     gizmo_system->process(e.timestep_ms);
     vr_imgui->process(e.timestep_ms);
 
+    left_physics_controller->update(hmd->get_controller(vr_controller_role::left_hand).t);
+    right_physics_controller->update(hmd->get_controller(vr_controller_role::right_hand).t);
+
+    // Kick this frame's step on a worker; it overlaps with the render submission
+    // in on_draw and is joined by the sync() above on the next update
+    physics_engine->update_async(e.timestep_ms);
+
     // ImGui surface/billboard is attached to left controller
     auto left_controller_xform = hmd->get_controller(vr_controller_role::left_hand).t;
     left_controller_xform = left_controller_xform * transform(quatf(0, 0, 0, 1), float3(0, 0, -.25f));
@@ -139,7 +174,21 @@ void sample_vr_app::on_draw()
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // Collect eye data for the render payload, always remembering to clear the payload first
+    // Kick the gather for frame N+1 on a worker; the GL thread submits the sealed
+    // snapshot of frame N below. The systems were all ticked in on_update, so the
+    // assembly only reads component state.
+    pipeline.kick_simulation([this](render_payload & p)
+    {
+        p.render_components.clear();
+        p.render_components.push_back(assemble_render_component(scene, floor));
+        for (const entity & r : vr_imgui->get_renderables()) p.render_components.push_back(assemble_render_component(scene, r));
+        for (const entity & r : controller_system->get_renderables()) p.render_components.push_back(assemble_render_component(scene, r));
+        for (const entity & r : gizmo_system->get_renderables()) p.render_components.push_back(assemble_render_component(scene, r));
+    });
+
+    // Collect eye data for the presentation payload, always remembering to clear the views
+    // first. Views are render-thread state, so they are written here rather than snapshotted.
+    render_payload & payload = pipeline.presentation();
     payload.views.clear();
     for (auto eye : { vr_eye::left_eye, vr_eye::right_eye })
     {
@@ -150,12 +199,7 @@ void sample_vr_app::on_draw()
 
     glDisable(GL_CULL_FACE);
 
-    // Render scene using payload
-    payload.render_components.clear();
-    payload.render_components.push_back(assemble_render_component(scene, floor));
-    for (const entity & r : vr_imgui->get_renderables()) payload.render_components.push_back(assemble_render_component(scene, r));
-    for (const entity & r : controller_system->get_renderables()) payload.render_components.push_back(assemble_render_component(scene, r));
-    for (const entity & r : gizmo_system->get_renderables()) payload.render_components.push_back(assemble_render_component(scene, r));
+    // Render scene using the frame N snapshot (empty for the very first frame)
     scene.render_system->get_renderer()->render_frame(payload);
 
     const uint32_t left_eye_texture = scene.render_system->get_renderer()->get_color_texture(0);
@@ -206,6 +250,10 @@ void sample_vr_app::on_draw()
     vr_imgui->end_frame();
 
     glfwSwapBuffers(window);
+
+    // Wait for the N+1 gather to seal and promote it to the presentation slot
+    pipeline.flip();
+
     frame_count++;
     gl_check_error(__FILE__, __LINE__);
 }
@@ -31,7 +31,12 @@ struct sample_vr_app : public polymer_app
     uint64_t frame_count{ 0 };
     entity floor;
 
-    render_payload payload;
+    // Physics steps on a worker (update_async), overlapping the render submission
+    std::shared_ptr<bullet_engine> physics_engine;
+    std::unique_ptr<physics_object_openvr_controller> left_physics_controller, right_physics_controller;
+    physics_object * physics_floor{ nullptr };
+
+    frame_pipeline pipeline; // simulation N+1 gathers on a worker while the GL thread submits frame N
     environment scene;
 
     sample_vr_app();
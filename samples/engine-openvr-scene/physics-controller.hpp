@@ -23,13 +23,11 @@ namespace polymer
     public:
 
         std::shared_ptr<bullet_engine> engine;
-        const vr_controller * ctrl;
 
         btCollisionShape * controllerShape{ nullptr };
         physics_object * physicsObject{ nullptr };
 
-        physics_object_openvr_controller(std::shared_ptr<bullet_engine> engine, const vr_controller * ctrl)
-            : engine(engine), ctrl(ctrl)
+        physics_object_openvr_controller(std::shared_ptr<bullet_engine> engine) : engine(engine)
         {
 
             // Physics tick
@@ -0,0 +1,208 @@
+/*
+ * File: samples/gl-capture-replay.cpp
+ * Standalone replayer for wrapper-level command captures (gl_command_capture in
+ * gl-api.hpp). A capture records the shape of one frame - program binds, texture
+ * binds, uniform buffer writes, and draws, in submission order - and this tool
+ * re-executes that sequence against the live driver using proxy resources: one
+ * trivial shader per recorded program, a small texture per recorded texture, an
+ * orphaned uniform buffer for UBO traffic, and a degenerate mesh per distinct
+ * (mode, vertex count) draw. Contents differ from the original frame, but the
+ * state-change ordering and batch sizes the driver sees are identical, which is
+ * what batching/sorting changes move. After warmup, CPU submission time and GPU
+ * elapsed time are averaged over a fixed number of frames and printed to stdout.
+ *
+ * Usage: gl-capture-replay <capture-file> [frame-count]
+ * Captures are produced by bracketing a frame with gl_command_capture::get()
+ * .begin_frame("frame.pcap") / .end_frame() in any engine app.
+ */
+
+#include "lib-polymer.hpp"
+#include "gl-api.hpp"
+#include "gl-async-gpu-timer.hpp"
+
+using namespace polymer;
+
+constexpr const char proxy_vertex_shader[] = R"(#version 330
+    layout(location = 0) in vec3 vertex;
+    uniform float u_salt;
+    void main() { gl_Position = vec4(vertex * u_salt, 1); }
+)";
+
+constexpr const char proxy_fragment_shader[] = R"(#version 330
+    out vec4 f_color;
+    void main() { f_color = vec4(1); }
+)";
+
+struct sample_gl_capture_replay final : public polymer_app
+{
+    std::vector<gl_capture_command> commands;
+
+    std::map<uint32_t, gl_shader> proxyPrograms;                      // recorded program -> proxy shader
+    std::map<uint32_t, gl_texture_2d> proxyTextures;                  // recorded texture -> proxy texture
+    std::map<std::pair<uint32_t, uint32_t>, gl_mesh> proxyMeshes;     // (mode, verts) -> proxy mesh
+    gl_buffer proxyUniforms;
+    std::vector<uint8_t> uniformScratch;
+
+    manual_timer cpuTimer;
+    gl_gpu_timer gpuTimer;
+
+    uint32_t framesRequested{ 300 };
+    uint32_t framesMeasured{ 0 };
+    int32_t warmupRemaining{ 30 };
+    double cpuTotalMs{ 0.0 }, cpuPeakMs{ 0.0 }, gpuTotalMs{ 0.0 };
+
+    sample_gl_capture_replay(const std::string & capture_path, const uint32_t frame_count);
+
+    void replay_commands();
+    void report_and_quit();
+
+    void on_window_resize(int2 size) override {}
+    void on_input(const app_input_event & event) override {}
+    void on_update(const app_update_event & e) override {}
+    void on_draw() override;
+};
+
+sample_gl_capture_replay::sample_gl_capture_replay(const std::string & capture_path, const uint32_t frame_count)
+    : polymer_app(320, 240, "sample-gl-capture-replay"), framesRequested(frame_count)
+{
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0); // uncapped - we are measuring submission, not presentation
+
+    commands = gl_command_capture::load(capture_path);
+    std::cout << "loaded " << commands.size() << " commands from " << capture_path << std::endl;
+
+    // Build proxy resources up front so replay frames contain no allocation.
+    // Each recorded program gets its own shader object (driver-side program
+    // switches are what we are timing), salted so identical sources cannot
+    // collapse into one cached binary.
+    size_t meshVertsTotal = 0;
+    for (const gl_capture_command & c : commands)
+    {
+        switch (static_cast<gl_capture_op>(c.op))
+        {
+        case gl_capture_op::program_bind:
+        {
+            if (proxyPrograms.find(c.handle) == proxyPrograms.end())
+            {
+                proxyPrograms[c.handle] = gl_shader(proxy_vertex_shader, proxy_fragment_shader);
+                proxyPrograms[c.handle].uniform("u_salt", 1.f / (1.f + c.handle));
+            }
+            break;
+        }
+        case gl_capture_op::texture_bind:
+        {
+            if (proxyTextures.find(c.handle) == proxyTextures.end())
+            {
+                const std::vector<uint8_t> texel(4 * 4 * 4, 255);
+                proxyTextures[c.handle].setup(4, 4, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, texel.data());
+            }
+            break;
+        }
+        case gl_capture_op::ubo_update:
+        {
+            uniformScratch.resize(std::max(uniformScratch.size(), size_t(c.count)));
+            break;
+        }
+        case gl_capture_op::draw:
+        {
+            // Degenerate (zero-area) triangles exercise vertex fetch and submission
+            // cost without rasterization noise. Cap each proxy so a pathological
+            // capture cannot exhaust memory.
+            const auto key = std::make_pair(c.mode, std::min(c.count, 3000000u));
+            if (proxyMeshes.find(key) == proxyMeshes.end())
+            {
+                const std::vector<float3> vertices(std::max(key.second, 3u), float3(0.f));
+                gl_mesh & mesh = proxyMeshes[key];
+                mesh.set_vertices(vertices.size(), vertices.data(), GL_STATIC_DRAW);
+                mesh.set_attribute(0, 3, GL_FLOAT, GL_FALSE, sizeof(float3), (GLvoid *) 0);
+                mesh.set_non_indexed(static_cast<GLenum>(c.mode));
+                meshVertsTotal += vertices.size();
+            }
+            break;
+        }
+        }
+    }
+
+    std::cout << "proxies: " << proxyPrograms.size() << " programs, " << proxyTextures.size()
+              << " textures, " << proxyMeshes.size() << " meshes (" << meshVertsTotal << " verts)" << std::endl;
+}
+
+void sample_gl_capture_replay::replay_commands()
+{
+    for (const gl_capture_command & c : commands)
+    {
+        switch (static_cast<gl_capture_op>(c.op))
+        {
+        case gl_capture_op::program_bind: proxyPrograms[c.handle].bind(); break;
+        case gl_capture_op::texture_bind: glBindMultiTextureEXT(GL_TEXTURE0 + c.mode, GL_TEXTURE_2D, proxyTextures[c.handle]); break;
+        case gl_capture_op::ubo_update: proxyUniforms.set_buffer_data(c.count, uniformScratch.data(), GL_STREAM_DRAW); break;
+        case gl_capture_op::draw: proxyMeshes[std::make_pair(c.mode, std::min(c.count, 3000000u))].draw_elements(static_cast<int>(c.instances)); break;
+        }
+    }
+}
+
+void sample_gl_capture_replay::report_and_quit()
+{
+    const double frames = static_cast<double>(framesMeasured);
+    std::cout << "replayed " << framesMeasured << " frames of " << commands.size() << " commands" << std::endl;
+    std::cout << "  cpu submission: avg " << (cpuTotalMs / frames) << " ms, peak " << cpuPeakMs << " ms" << std::endl;
+    std::cout << "  gpu elapsed:    avg " << (gpuTotalMs / frames) << " ms" << std::endl;
+    glfwSetWindowShouldClose(window, 1);
+}
+
+void sample_gl_capture_replay::on_draw()
+{
+    glfwMakeContextCurrent(window);
+    glViewport(0, 0, 320, 240);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (warmupRemaining > 0)
+    {
+        // Warmup lets the driver finish shader specialization and settle clocks
+        replay_commands();
+        --warmupRemaining;
+    }
+    else if (framesMeasured < framesRequested)
+    {
+        cpuTimer.start();
+        gpuTimer.start();
+        replay_commands();
+        gpuTimer.stop();
+        cpuTimer.stop();
+
+        const double cpuMs = cpuTimer.get();
+        cpuTotalMs += cpuMs;
+        cpuPeakMs = std::max(cpuPeakMs, cpuMs);
+        gpuTotalMs += gpuTimer.elapsed_ms();
+        ++framesMeasured;
+    }
+    else
+    {
+        report_and_quit();
+    }
+
+    gl_check_error(__FILE__, __LINE__);
+    glfwSwapBuffers(window);
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: gl-capture-replay <capture-file> [frame-count]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const uint32_t frameCount = (argc > 2) ? static_cast<uint32_t>(std::stoul(argv[2])) : 300;
+        sample_gl_capture_replay app(argv[1], frameCount);
+        app.main_loop();
+    }
+    catch (const std::exception & e)
+    {
+        POLYMER_ERROR("[Fatal] Caught exception: \n" << e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -271,7 +271,7 @@ public:
     const float4x4 get_projector_matrix(const float4x4 & modelViewMatrix, bool isOrthographic = false)
     {
         // Bias matrix is a constant.
-        // It performs a linear transformation to go from the [�1, 1]
+        // It performs a linear transformation to go from the [�1, 1]
         // range to the [0, 1] range. Having the coordinates in the [0, 1]
         // range is necessary for the values to be used as texture coordinates.
         constexpr float4x4 biasMatrix = {
@@ -405,25 +405,31 @@ void sample_gl_debug_ui::on_draw()
     const float4x4 viewMatrix = cam.get_view_matrix();
     const float4x4 viewProjectionMatrix = (projectionMatrix * viewMatrix);
 
-    // Render the offscreen nvg surface
+    // Render the offscreen nvg surface. The content is static, so after the first
+    // frame the cached surface texture is reused without re-tessellating anything.
     {
         std::string text = "Polymer Engine";
 
-        NVGcontext * nvg = surface->pre_draw(window, 0);
-        const float2 size = surface->surface_size();
+        nvg_content_hash content;
+        content.add(text);
 
-        nvgSave(nvg);
+        if (NVGcontext * nvg = surface->pre_draw_cached(window, 0, content.value))
+        {
+            const float2 size = surface->surface_size();
+
+            nvgSave(nvg);
 
-        nvgBeginPath(nvg);
-        nvgRect(nvg, 0, 0, size.x, size.y);
-        nvgFillColor(nvg, nvgRGBAf(0.2f, 0.2f, 0.2f, 1.f));
-        nvgFill(nvg);
+            nvgBeginPath(nvg);
+            nvgRect(nvg, 0, 0, size.x, size.y);
+            nvgFillColor(nvg, nvgRGBAf(0.2f, 0.2f, 0.2f, 1.f));
+            nvgFill(nvg);
 
-        surface->draw_text_quick(text, 120, float2(size.x / 2, size.y / 2), nvgRGBAf(1, 1, 1, 1));
+            surface->draw_text_quick(text, 120, float2(size.x / 2, size.y / 2), nvgRGBAf(1, 1, 1, 1));
 
-        nvgRestore(nvg);
+            nvgRestore(nvg);
 
-        surface->post_draw();
+            surface->post_draw();
+        }
     }
 
     // Reset state changed by nanovg
@@ -224,7 +224,7 @@ void sample_gl_particle_hull::on_draw()
             std::vector<float3> positions;
             for (const auto & p : particles) positions.push_back(p.position);
             quickhull::quick_hull convex_hull(positions);
-            return convex_hull.compute(true, false, 0.0005f);
+            return convex_hull.compute_parallel(true, false, 0.0005f);
         });
     }
 
@@ -6,6 +6,8 @@
 #include "ecs/core-events.hpp"
 #include "system-transform.hpp"
 #include "system-identifier.hpp"
+#include "frame-scheduler.hpp"
+#include "frame-pipeline.hpp"
 #include "ui-actions.hpp"
 
 /// Quick reference for doctest macros
@@ -193,6 +195,292 @@ namespace polymer
         REQUIRE(2080 * num_producers == handlerClass.static_accumulator);
     }
 
+    TEST_CASE("event_manager_deferred keep-latest coalescing")
+    {
+        event_manager_deferred mgr;
+        mgr.set_coalesce_policy<queued_event>(coalesce_policy::keep_latest);
+
+        uint32_t invocations = 0, last_value = 0;
+        auto c = mgr.connect([&](const queued_event & event) { invocations++; last_value = event.value; });
+
+        for (uint32_t i = 1; i <= 1000; ++i) mgr.send(queued_event{ i });
+        mgr.process();
+
+        // Only the newest of the burst reaches the handler
+        REQUIRE(invocations == 1);
+        REQUIRE(last_value == 1000);
+
+        // A fresh burst in the next drain dispatches again
+        mgr.send(queued_event{ 7 });
+        mgr.process();
+        REQUIRE(invocations == 2);
+        REQUIRE(last_value == 7);
+    }
+
+    TEST_CASE("event_manager_deferred accumulate coalescing")
+    {
+        event_manager_deferred mgr;
+        mgr.set_accumulator<example_event>([](example_event & into, const example_event & next) { into.value += next.value; });
+
+        uint32_t invocations = 0, total = 0;
+        auto c = mgr.connect([&](const example_event & event) { invocations++; total = event.value; });
+
+        for (uint32_t i = 0; i < 10; ++i) mgr.send(example_event{ 5 });
+        mgr.process();
+
+        REQUIRE(invocations == 1);
+        REQUIRE(total == 50);
+    }
+
+    TEST_CASE("queued managers drop unsubscribed events at post time")
+    {
+        event_manager_async mgr;
+        mgr.post_filter_enabled = true;
+
+        // No subscriber for queued_event yet: nothing should be copied or queued
+        REQUIRE(mgr.send(queued_event{ 1 }) == false);
+        REQUIRE(mgr.empty());
+
+        uint32_t received = 0;
+        auto c = mgr.connect([&](const queued_event & event) { received += event.value; });
+
+        REQUIRE(mgr.send(queued_event{ 2 }) == true);
+        mgr.process();
+        REQUIRE(received == 2);
+    }
+
+    // Larger than event_wrapper::inline_payload_capacity, forcing the heap payload path
+    struct bulk_event
+    {
+        float samples[32]{};
+        uint32_t value{ 0 };
+    };
+    POLYMER_SETUP_TYPEID(bulk_event);
+
+    TEST_CASE("event_manager_deferred recycles slots across bursts")
+    {
+        event_manager_deferred mgr;
+
+        uint64_t small_total = 0, bulk_total = 0;
+        auto c1 = mgr.connect([&](const queued_event & event) { small_total += event.value; });
+        auto c2 = mgr.connect([&](const bulk_event & event) { bulk_total += event.value; });
+
+        // Two bursts larger than the arena's slab, so both the recycled-slot and
+        // heap-spill paths are exercised; every event must still arrive intact.
+        for (uint32_t round = 0; round < 2; ++round)
+        {
+            for (uint32_t i = 0; i < 1500; ++i)
+            {
+                mgr.send(queued_event{ 2 });
+                bulk_event bulk;
+                bulk.value = 3;
+                mgr.send(bulk);
+            }
+            mgr.process();
+        }
+
+        REQUIRE(small_total == 2 * 1500 * 2);
+        REQUIRE(bulk_total == 2 * 1500 * 3);
+    }
+
+    ////////////////////
+    //   Typeid Tests  //
+    ////////////////////
+
+    TEST_CASE("poly_typeid resolves at compile time")
+    {
+        // get_typeid<T>() is constexpr: usable in constant expressions (and thus as
+        // switch case labels), and identical to the runtime hash of the same name.
+        static_assert(get_typeid<float3>() == const_hash("float3"), "typeid must be a constant expression");
+        REQUIRE(get_typeid<float3>() == get_typeid("float3"));
+
+        switch (get_typeid("transform"))
+        {
+            case get_typeid<transform>(): break;
+            default: REQUIRE(false);
+        }
+    }
+
+    TEST_CASE("dense type indices are small and distinct")
+    {
+        const uint32_t a = get_type_index<float2>();
+        const uint32_t b = get_type_index<float3>();
+        REQUIRE(a != b);
+        REQUIRE(a < max_poly_type_indices);
+        REQUIRE(b < max_poly_type_indices);
+        REQUIRE(get_type_index<float2>() == a); // stable within the process
+    }
+
+    ///////////////////////////////////
+    //   Entity Orchestrator Tests   //
+    ///////////////////////////////////
+
+    TEST_CASE("entity generational id liveness")
+    {
+        entity_orchestrator orchestrator;
+
+        const entity a = orchestrator.create_entity();
+        const entity b = orchestrator.create_entity();
+        REQUIRE(orchestrator.is_alive(a));
+        REQUIRE(orchestrator.is_alive(b));
+        REQUIRE_FALSE(orchestrator.is_alive(kInvalidEntity));
+
+        // Retiring bumps the slot generation, so the stale id fails the check...
+        orchestrator.retire_entity(a);
+        REQUIRE_FALSE(orchestrator.is_alive(a));
+
+        // ...and the recycled slot yields a distinct, live id at the same index
+        const entity reused = orchestrator.create_entity();
+        REQUIRE(orchestrator.is_alive(reused));
+        REQUIRE(entity_index(reused) == entity_index(a));
+        REQUIRE(reused != a);
+        REQUIRE_FALSE(orchestrator.is_alive(a));
+    }
+
+    TEST_CASE("entity bulk creation stays contiguous after recycling")
+    {
+        entity_orchestrator orchestrator;
+
+        const entity first = orchestrator.create_entity();
+        orchestrator.retire_entity(first);
+
+        // The bulk path never draws from the free list, so indices are contiguous
+        const auto batch = orchestrator.create_entities(8);
+        for (size_t i = 1; i < batch.size(); ++i)
+        {
+            REQUIRE(entity_index(batch[i]) == entity_index(batch[i - 1]) + 1);
+            REQUIRE(orchestrator.is_alive(batch[i]));
+        }
+    }
+
+    TEST_CASE("entity activity tracker demotes and wakes")
+    {
+        entity_orchestrator orchestrator;
+        entity_activity_tracker & activity = orchestrator.get_activity_tracker();
+        activity.set_sleep_threshold(4);
+
+        const entity moving = orchestrator.create_entity();
+        const entity dressing = orchestrator.create_entity();
+        activity.touch(moving);
+        activity.touch(dressing);
+        REQUIRE(activity.awake_entities().size() == 2);
+
+        // Only `moving` keeps changing; the set-dressing ages out of the awake tier
+        for (int frame = 0; frame < 8; ++frame)
+        {
+            activity.touch(moving);
+            activity.advance();
+        }
+        REQUIRE(activity.is_awake(moving));
+        REQUIRE_FALSE(activity.is_awake(dressing));
+        REQUIRE(activity.awake_entities().size() == 1);
+
+        // An edit wakes a sleeping entity; untracked entities report awake
+        activity.touch(dressing);
+        REQUIRE(activity.is_awake(dressing));
+        REQUIRE(activity.awake_entities().size() == 2);
+        REQUIRE(activity.is_awake(orchestrator.create_entity()));
+
+        // Retirement removes the entity from the tier entirely
+        orchestrator.retire_entity(dressing);
+        REQUIRE_FALSE(activity.is_tracked(dressing));
+    }
+
+    ///////////////////////////////
+    //   Frame Scheduler Tests   //
+    ///////////////////////////////
+
+    TEST_CASE("frame scheduler derives dependencies from declared access")
+    {
+        const poly_typeid xform = get_typeid("xform");
+        const poly_typeid geom = get_typeid("geom");
+
+        frame_scheduler scheduler;
+        scheduler.add_stage("write-transforms", {}, { xform }, []() {});
+        scheduler.add_stage("read-transforms", { xform }, {}, []() {});   // read-after-write on xform
+        scheduler.add_stage("write-geometry", {}, { geom }, []() {});     // independent of both
+
+        REQUIRE(scheduler.stage_count() == 3);
+        REQUIRE(scheduler.dependencies_of(1) == std::vector<size_t>{ 0 });
+        REQUIRE(scheduler.dependencies_of(2).empty());
+    }
+
+    TEST_CASE("frame scheduler runs conflicting stages in declaration order")
+    {
+        const poly_typeid xform = get_typeid("xform");
+
+        std::atomic<int> sequence{ 0 };
+        int first_ran_at = -1, second_ran_at = -1;
+
+        frame_scheduler scheduler;
+        scheduler.add_stage("producer", {}, { xform }, [&]() { first_ran_at = sequence++; });
+        scheduler.add_stage("consumer", { xform }, {}, [&]() { second_ran_at = sequence++; });
+        scheduler.execute();
+
+        REQUIRE(first_ran_at == 0);
+        REQUIRE(second_ran_at == 1);
+
+        // The graph is reusable: a second execute() runs every stage again
+        scheduler.execute();
+        REQUIRE(sequence == 4);
+    }
+
+    //////////////////////////////
+    //   Frame Pipeline Tests   //
+    //////////////////////////////
+
+    TEST_CASE("frame pipeline seals an immutable snapshot")
+    {
+        world_transform_component live_transform(entity(1));
+        live_transform.world_pose.position = float3(1, 2, 3);
+
+        frame_pipeline pipeline;
+        pipeline.kick_simulation([&](render_payload & p)
+        {
+            render_component r(entity(1));
+            r.world_transform = &live_transform;
+            p.render_components.clear();
+            p.render_components.push_back(r);
+        });
+        pipeline.flip();
+
+        // Simulation for the next frame moves the live component; the sealed
+        // presentation payload must still see the pose it was gathered with.
+        live_transform.world_pose.position = float3(9, 9, 9);
+
+        render_payload & snapshot = pipeline.presentation();
+        REQUIRE(snapshot.render_components.size() == 1);
+        REQUIRE(snapshot.render_components[0].world_transform != &live_transform);
+        REQUIRE(snapshot.render_components[0].world_transform->world_pose.position == float3(1, 2, 3));
+    }
+
+    ////////////////////////
+    //   BRDF LUT Tests   //
+    ////////////////////////
+
+    TEST_CASE("brdf lut integration produces well-formed split-sum terms")
+    {
+        brdf_lut_baker baker;
+        baker.lutSize = 8;       // coarse grid keeps the test fast; the integrand is smooth
+        baker.sampleCount = 256;
+
+        const std::vector<float> texels = baker.integrate();
+        REQUIRE(texels.size() == size_t(8 * 8 * 2));
+
+        for (const float v : texels)
+        {
+            REQUIRE(std::isfinite(v));
+            REQUIRE(v >= 0.f);
+            REQUIRE(v <= 1.f);
+        }
+
+        // A mirror-smooth surface viewed head-on reflects at full scale with negligible bias
+        const float scale = texels[(0 * 8 + 7) * 2 + 0]; // lowest roughness row, highest NdotV column
+        const float bias = texels[(0 * 8 + 7) * 2 + 1];
+        REQUIRE(scale > 0.9f);
+        REQUIRE(bias < 0.1f);
+    }
+
     ////////////////////////////////
     //   Transform System Tests   //
     ////////////////////////////////
@@ -474,6 +762,71 @@ namespace polymer
         REQUIRE(static_cast<int>(scene_graph_pool.size()) == (128 - 101 + 44));
     }
 
+    TEST_CASE("polymer_component_pool sorted iteration")
+    {
+        polymer_component_pool<local_transform_component> pool(8);
+        pool.enable_sort_index();
+
+        // Insert with descending keys so the native order is maximally wrong
+        for (int i = 0; i < 64; ++i)
+        {
+            auto obj = pool.emplace(i);
+            obj->parent = 63 - i;
+        }
+
+        const auto by_parent = [](const local_transform_component & t) { return static_cast<uint64_t>(t.parent); };
+
+        // Full sort: one refresh with no op budget
+        pool.refresh_sort_index(by_parent);
+        entity last = 0;
+        bool ordered = true;
+        pool.for_each_sorted([&](local_transform_component & t) { if (t.parent < last) ordered = false; last = t.parent; });
+        REQUIRE(ordered);
+
+        // Amortized: a tiny per-call budget converges over repeated refreshes
+        for (int i = 0; i < 64; ++i) pool.get(i)->parent = (i * 17) % 64;
+        for (int iteration = 0; iteration < 256; ++iteration) pool.refresh_sort_index(by_parent, 16);
+        last = 0;
+        ordered = true;
+        pool.for_each_sorted([&](local_transform_component & t) { if (t.parent < last) ordered = false; last = t.parent; });
+        REQUIRE(ordered);
+
+        // The index mirrors membership through removals
+        for (int i = 0; i < 32; ++i) pool.destroy(i);
+        size_t visited = 0;
+        pool.for_each_sorted([&](local_transform_component &) { ++visited; });
+        REQUIRE(visited == pool.size());
+    }
+
+    TEST_CASE("polymer_component_pool bulk destroy and shrink")
+    {
+        polymer_component_pool<local_transform_component> pool(16);
+
+        size_t check = 0;
+        for (int i = 1; i <= 256; ++i)
+        {
+            auto obj = pool.emplace(i);
+            obj->parent = i;
+            if (i > 128) check += i; // survivors
+        }
+
+        std::vector<entity> doomed;
+        for (int i = 1; i <= 128; ++i) doomed.push_back(i);
+        doomed.push_back(9999); // unknown keys are ignored
+
+        REQUIRE(pool.destroy_bulk(doomed.data(), doomed.size()) == 128);
+        REQUIRE(static_cast<int>(pool.size()) == 128);
+
+        size_t sum = 0;
+        pool.for_each([&](local_transform_component & t) { sum += t.parent; });
+        REQUIRE(sum == check);
+
+        pool.shrink_to_fit();
+        REQUIRE(static_cast<int>(pool.size()) == 128);
+        REQUIRE(pool.contains(200));
+        REQUIRE(!pool.contains(64));
+    }
+
     /////////////////////////////////
     //   Identifier System Tests   //
     /////////////////////////////////
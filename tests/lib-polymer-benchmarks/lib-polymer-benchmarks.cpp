@@ -0,0 +1,291 @@
+/*
+ * File: tests/lib-polymer-benchmarks/lib-polymer-benchmarks.cpp
+ * Micro-benchmarks for the hot lib-polymer primitives: radix_sort, the bounded queue
+ * family, octree create/update/cull, simplex noise, quickhull, and the geometry.hpp
+ * kernels. Run the binary and compare the printed medians, or pass an output path as
+ * the first argument to write a JSON summary for run-over-run comparison:
+ *
+ *     lib-polymer-benchmarks [results.json]
+ */
+
+#include "lib-polymer.hpp"
+#include "micro-benchmark.hpp"
+
+using namespace polymer;
+
+//////////////////////
+//   radix sort     //
+//////////////////////
+
+void bench_radix_sort(std::vector<benchmark_result> & results)
+{
+    const size_t N = 1 << 16;
+    uniform_random_gen gen(0xBADC0FFEull);
+
+    std::vector<uint32_t> sourceKeys(N);
+    for (auto & k : sourceKeys) k = gen.random_uint(0xffffffffu >> 1);
+    std::vector<float> sourceFloats(N);
+    for (auto & f : sourceFloats) f = gen.random_float(-1000.f, 1000.f);
+
+    radix_sort sorter;
+    std::vector<uint32_t> keys(N);
+    std::vector<float> floats(N);
+
+    results.push_back(run_benchmark("radix_sort/uint32/64k", [&]()
+    {
+        keys = sourceKeys;
+        sorter.sort(keys.data(), keys.size());
+        do_not_optimize(keys[N / 2]);
+    }, double(N)));
+
+    results.push_back(run_benchmark("radix_sort/float/64k", [&]()
+    {
+        floats = sourceFloats;
+        sorter.sort(floats.data(), floats.size());
+        do_not_optimize(floats[N / 2]);
+    }, double(N)));
+
+    std::vector<uint32_t> indices(N);
+    results.push_back(run_benchmark("radix_sort/indices/64k", [&]()
+    {
+        for (uint32_t i = 0; i < N; ++i) indices[i] = i;
+        sorter.sort_indices(sourceKeys.data(), indices.data(), N);
+        do_not_optimize(indices[N / 2]);
+    }, double(N)));
+}
+
+//////////////////
+//   queues     //
+//////////////////
+
+void bench_queues(std::vector<benchmark_result> & results)
+{
+    const size_t batch = 512;
+    std::vector<uint64_t> scratch(batch);
+    for (size_t i = 0; i < batch; ++i) scratch[i] = i;
+
+    // Single-threaded pumps isolate per-op synchronization cost from scheduling noise
+    {
+        spsc_queue_bounded<uint64_t> q(1024);
+        results.push_back(run_benchmark("queue/spsc/produce+consume x512", [&]()
+        {
+            for (size_t i = 0; i < batch; ++i) q.produce(scratch[i]);
+            uint64_t out, sum = 0;
+            while (q.consume(out)) sum += out;
+            do_not_optimize(sum);
+        }, double(batch)));
+
+        results.push_back(run_benchmark("queue/spsc/bulk x512", [&]()
+        {
+            size_t wrote = 0;
+            while (wrote < batch) wrote += q.produce_bulk(scratch.data() + wrote, batch - wrote);
+            uint64_t out[128];
+            uint64_t sum = 0;
+            size_t got;
+            while ((got = q.consume_bulk(out, 128)) != 0) for (size_t i = 0; i < got; ++i) sum += out[i];
+            do_not_optimize(sum);
+        }, double(batch)));
+    }
+
+    {
+        mpmc_queue_bounded<uint64_t> q(1024);
+        results.push_back(run_benchmark("queue/mpmc/produce+consume x512", [&]()
+        {
+            for (size_t i = 0; i < batch; ++i) q.mp_produce(scratch[i]);
+            uint64_t out, sum = 0;
+            while (q.consume(out)) sum += out;
+            do_not_optimize(sum);
+        }, double(batch)));
+
+        results.push_back(run_benchmark("queue/mpmc/bulk x512", [&]()
+        {
+            size_t wrote = 0;
+            while (wrote < batch) wrote += q.mp_produce_bulk(scratch.data() + wrote, batch - wrote);
+            uint64_t out[128];
+            uint64_t sum = 0;
+            size_t got;
+            while ((got = q.consume_bulk(out, 128)) != 0) for (size_t i = 0; i < got; ++i) sum += out[i];
+            do_not_optimize(sum);
+        }, double(batch)));
+    }
+}
+
+//////////////////
+//   octree     //
+//////////////////
+
+void bench_octree(std::vector<benchmark_result> & results)
+{
+    const size_t N = 4096;
+    uniform_random_gen gen(0x0C7EEEull);
+
+    struct payload { uint32_t id; };
+    std::vector<payload> objects(N);
+    std::vector<aabb_3d> bounds;
+    bounds.reserve(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        objects[i].id = uint32_t(i);
+        const float3 c(gen.random_float(-100.f, 100.f), gen.random_float(-100.f, 100.f), gen.random_float(-100.f, 100.f));
+        const float r = gen.random_float(0.25f, 2.f);
+        bounds.push_back({ c - float3(r), c + float3(r) });
+    }
+
+    results.push_back(run_benchmark("octree/create 4k", [&]()
+    {
+        octree<payload> tree(8, { { -128, -128, -128 }, { +128, +128, +128 } });
+        tree.looseness = 2.f;
+        std::vector<node_container<payload>> nodes;
+        nodes.reserve(N);
+        for (size_t i = 0; i < N; ++i)
+        {
+            nodes.emplace_back(objects[i], bounds[i]);
+            tree.create(nodes.back());
+        }
+        do_not_optimize(tree.root->occupancy);
+    }, double(N)));
+
+    // Persistent tree for update + cull so those benchmarks exclude construction
+    octree<payload> tree(8, { { -128, -128, -128 }, { +128, +128, +128 } });
+    tree.looseness = 2.f;
+    std::vector<node_container<payload>> nodes;
+    nodes.reserve(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        nodes.emplace_back(objects[i], bounds[i]);
+        tree.create(nodes.back());
+    }
+
+    results.push_back(run_benchmark("octree/update 4k (small jitter)", [&]()
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            const float3 jitter(gen.random_float(-0.05f, 0.05f), gen.random_float(-0.05f, 0.05f), gen.random_float(-0.05f, 0.05f));
+            nodes[i].worldspaceBounds = { nodes[i].worldspaceBounds.min() + jitter, nodes[i].worldspaceBounds.max() + jitter };
+            tree.update(nodes[i]);
+        }
+        do_not_optimize(tree.root->occupancy);
+    }, double(N)));
+
+    const float4x4 proj = make_projection_matrix(to_radians(75.f), 16.f / 9.f, 0.1f, 250.f);
+    const float4x4 view = transform(quatf(0, 0, 0, 1), float3(0, 0, 120)).view_matrix();
+    const frustum cullingFrustum(proj * view);
+
+    std::vector<octant<payload> *> visible;
+    results.push_back(run_benchmark("octree/cull 4k", [&]()
+    {
+        visible.clear();
+        tree.cull(cullingFrustum, visible, nullptr, false);
+        do_not_optimize(visible.size());
+    }, double(N)));
+}
+
+/////////////////////////
+//   simplex noise     //
+/////////////////////////
+
+void bench_simplex_noise(std::vector<benchmark_result> & results)
+{
+    const int dim = 128;
+
+    results.push_back(run_benchmark("simplex/noise2d 128x128", [&]()
+    {
+        float sum = 0.f;
+        for (int y = 0; y < dim; ++y)
+            for (int x = 0; x < dim; ++x)
+                sum += noise::noise(float2(x * 0.05f, y * 0.05f));
+        do_not_optimize(sum);
+    }, double(dim * dim)));
+
+    results.push_back(run_benchmark("simplex/noise3d 128x128", [&]()
+    {
+        float sum = 0.f;
+        for (int y = 0; y < dim; ++y)
+            for (int x = 0; x < dim; ++x)
+                sum += noise::noise(float3(x * 0.05f, y * 0.05f, 0.5f));
+        do_not_optimize(sum);
+    }, double(dim * dim)));
+}
+
+///////////////////////
+//   quick hull      //
+///////////////////////
+
+void bench_quick_hull(std::vector<benchmark_result> & results)
+{
+    const size_t N = 8192;
+    uniform_random_gen gen(0x9E3779B9ull);
+
+    std::vector<float3> pointCloud(N);
+    for (auto & p : pointCloud)
+    {
+        // points in a thick shell so the hull has interesting structure
+        const float theta = gen.random_float_sphere();
+        const float z = gen.random_float(-1.f, 1.f);
+        const float r = std::sqrt(std::max(0.f, 1.f - z * z)) * gen.random_float(0.75f, 1.f);
+        p = float3(r * std::cos(theta), r * std::sin(theta), z) * 10.f;
+    }
+
+    results.push_back(run_benchmark("quickhull/8k shell", [&]()
+    {
+        quickhull::quick_hull hull(pointCloud);
+        auto result = hull.compute(true, false, 0.001f);
+        do_not_optimize(result.getIndexBuffer().size());
+    }, double(N)));
+}
+
+////////////////////////////
+//   geometry kernels     //
+////////////////////////////
+
+void bench_geometry(std::vector<benchmark_result> & results)
+{
+    geometry sphere = make_icosasphere(4);
+    const size_t vertexCount = sphere.vertices.size();
+
+    results.push_back(run_benchmark("geometry/compute_normals icosasphere(4)", [&]()
+    {
+        compute_normals(sphere, true);
+        do_not_optimize(sphere.normals[vertexCount / 2]);
+    }, double(vertexCount)));
+
+    results.push_back(run_benchmark("geometry/compute_tangents icosasphere(4)", [&]()
+    {
+        compute_tangents(sphere);
+        do_not_optimize(sphere.tangents[vertexCount / 2]);
+    }, double(vertexCount)));
+
+    results.push_back(run_benchmark("geometry/weld_vertices supershape", [&]()
+    {
+        geometry shape = make_supershape_3d(48, 1.f, 1.f, 1.f, 1.f);
+        weld_vertices(shape);
+        do_not_optimize(shape.vertices.size());
+    }, double(48 * 48)));
+
+    const transform xform(quatf(0, 0, 0, 1), float3(1, 2, 3));
+    geometry transformed = sphere;
+    results.push_back(run_benchmark("geometry/compute_bounds icosasphere(4)", [&]()
+    {
+        const aabb_3d bounds = compute_bounds(transformed);
+        do_not_optimize(bounds);
+    }, double(vertexCount)));
+}
+
+int main(int argc, char * argv[])
+{
+    const std::string outputPath = argc > 1 ? argv[1] : "lib-polymer-benchmarks.json";
+
+    std::vector<benchmark_result> results;
+
+    bench_radix_sort(results);
+    bench_queues(results);
+    bench_octree(results);
+    bench_simplex_noise(results);
+    bench_quick_hull(results);
+    bench_geometry(results);
+
+    if (write_benchmark_json(results, outputPath)) std::printf("\nwrote %s (%d benchmarks)\n", outputPath.c_str(), int(results.size()));
+    else std::printf("\ncould not write %s\n", outputPath.c_str());
+
+    return 0;
+}
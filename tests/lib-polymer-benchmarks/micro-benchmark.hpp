@@ -0,0 +1,169 @@
+/*
+ * File: tests/lib-polymer-benchmarks/micro-benchmark.hpp
+ * A minimal timed-sample micro-benchmark harness. Each benchmark is a callable that
+ * performs one unit of work; the harness calibrates an iteration count so a sample
+ * takes a measurable amount of wall time, collects repeated samples, and summarizes
+ * them (median/mean/stddev/min/max). Results can be serialized to a JSON array for
+ * run-over-run comparison in CI or by hand.
+ */
+
+#pragma once
+
+#ifndef polymer_micro_benchmark_hpp
+#define polymer_micro_benchmark_hpp
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace polymer
+{
+    // Prevents the optimizer from deleting a computed value (and the work producing it)
+    template<typename T>
+    inline void do_not_optimize(const T & value)
+    {
+#if defined(_MSC_VER)
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char *>(&value);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    struct benchmark_result
+    {
+        std::string name;
+        uint32_t iterations_per_sample{ 0 };
+        double items_per_invocation{ 0.0 };  // optional; enables throughput reporting
+        std::vector<double> sample_ms;       // milliseconds per single invocation, one entry per sample
+        double median_ms{ 0.0 };
+        double mean_ms{ 0.0 };
+        double stddev_ms{ 0.0 };
+        double min_ms{ 0.0 };
+        double max_ms{ 0.0 };
+    };
+
+    namespace detail
+    {
+        inline double now_ms()
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+        }
+
+        inline void summarize(benchmark_result & r)
+        {
+            std::vector<double> sorted = r.sample_ms;
+            std::sort(sorted.begin(), sorted.end());
+            const size_t n = sorted.size();
+
+            r.min_ms = sorted.front();
+            r.max_ms = sorted.back();
+            r.median_ms = (n & 1) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) * 0.5;
+
+            double sum = 0.0;
+            for (double s : sorted) sum += s;
+            r.mean_ms = sum / n;
+
+            double variance = 0.0;
+            for (double s : sorted) variance += (s - r.mean_ms) * (s - r.mean_ms);
+            r.stddev_ms = n > 1 ? std::sqrt(variance / (n - 1)) : 0.0;
+        }
+    }
+
+    // Runs `fn` repeatedly and returns summarized timings. `items_per_invocation` is
+    // used only for throughput reporting (e.g. keys sorted or points hulled per call).
+    template<typename F>
+    inline benchmark_result run_benchmark(const std::string & name, F && fn,
+        const double items_per_invocation = 0.0,
+        const uint32_t num_samples = 16,
+        const double target_sample_ms = 25.0)
+    {
+        benchmark_result r;
+        r.name = name;
+        r.items_per_invocation = items_per_invocation;
+
+        fn(); // warmup (first-touch allocations, icache)
+
+        // Calibrate: double the iteration count until one sample takes long enough to time reliably
+        uint32_t iterations = 1;
+        while (true)
+        {
+            const double t0 = detail::now_ms();
+            for (uint32_t i = 0; i < iterations; ++i) fn();
+            const double elapsed = detail::now_ms() - t0;
+            if (elapsed >= target_sample_ms || iterations >= (1u << 24)) break;
+            iterations *= 2;
+        }
+        r.iterations_per_sample = iterations;
+
+        for (uint32_t s = 0; s < num_samples; ++s)
+        {
+            const double t0 = detail::now_ms();
+            for (uint32_t i = 0; i < iterations; ++i) fn();
+            const double elapsed = detail::now_ms() - t0;
+            r.sample_ms.push_back(elapsed / iterations);
+        }
+
+        detail::summarize(r);
+
+        if (items_per_invocation > 0.0)
+        {
+            std::printf("%-48s median %10.4f ms    mean %10.4f ms (+/- %8.4f)    %10.2f Mitems/s\n",
+                r.name.c_str(), r.median_ms, r.mean_ms, r.stddev_ms,
+                (items_per_invocation / (r.median_ms * 1e-3)) * 1e-6);
+        }
+        else
+        {
+            std::printf("%-48s median %10.4f ms    mean %10.4f ms (+/- %8.4f)\n",
+                r.name.c_str(), r.median_ms, r.mean_ms, r.stddev_ms);
+        }
+
+        return r;
+    }
+
+    // Writes every result as one object in a JSON array - stable field names so runs
+    // can be diffed or charted without caring which benchmarks were present.
+    inline bool write_benchmark_json(const std::vector<benchmark_result> & results, const std::string & path)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) return false;
+
+        file << "[\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const benchmark_result & r = results[i];
+            file << "  {\n";
+            file << "    \"name\": \"" << r.name << "\",\n";
+            file << "    \"iterations_per_sample\": " << r.iterations_per_sample << ",\n";
+            file << "    \"items_per_invocation\": " << r.items_per_invocation << ",\n";
+            file << "    \"median_ms\": " << r.median_ms << ",\n";
+            file << "    \"mean_ms\": " << r.mean_ms << ",\n";
+            file << "    \"stddev_ms\": " << r.stddev_ms << ",\n";
+            file << "    \"min_ms\": " << r.min_ms << ",\n";
+            file << "    \"max_ms\": " << r.max_ms << ",\n";
+            file << "    \"samples_ms\": [";
+            for (size_t s = 0; s < r.sample_ms.size(); ++s)
+            {
+                file << r.sample_ms[s];
+                if (s + 1 < r.sample_ms.size()) file << ", ";
+            }
+            file << "]\n";
+            file << "  }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "]\n";
+        return true;
+    }
+
+} // end namespace polymer
+
+#endif // end polymer_micro_benchmark_hpp